@@ -21,12 +21,9 @@
 #define FIREBOLT_RIALTO_COMMON_TIMER_H_
 
 #include "ITimer.h"
+#include "TimerService.h"
 
-#include <atomic>
-#include <condition_variable>
 #include <memory>
-#include <mutex>
-#include <thread>
 
 namespace firebolt::rialto::common
 {
@@ -43,12 +40,16 @@ public:
 
     std::unique_ptr<ITimer> createTimer(const std::chrono::milliseconds &timeout, const std::function<void()> &callback,
                                         TimerType timerType = TimerType::ONE_SHOT) const override;
+    TimerStats getStats() const override;
 };
 
+/**
+ * @brief ITimer scheduled on the timer service of the process.
+ */
 class Timer : public ITimer
 {
 public:
-    Timer(const std::chrono::milliseconds &timeout, const std::function<void()> &callback,
+    Timer(TimerService &service, const std::chrono::milliseconds &timeout, const std::function<void()> &callback,
           TimerType timerType = TimerType::ONE_SHOT);
     ~Timer();
     Timer(const Timer &) = delete;
@@ -60,12 +61,8 @@ public:
     bool isActive() const override;
 
 private:
-    std::atomic<bool> m_active;
-    std::chrono::milliseconds m_timeout;
-    std::function<void()> m_callback;
-    mutable std::mutex m_mutex;
-    std::thread m_thread;
-    std::condition_variable m_cv;
+    TimerService &m_service;
+    std::shared_ptr<TimerService::TimerState> m_state;
 };
 } // namespace firebolt::rialto::common
 
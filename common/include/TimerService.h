@@ -0,0 +1,122 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_COMMON_TIMER_SERVICE_H_
+#define FIREBOLT_RIALTO_COMMON_TIMER_SERVICE_H_
+
+#include "ITimer.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace firebolt::rialto::common
+{
+/**
+ * @brief Runs the timers of the process on a single thread.
+ *
+ * The timers are ordered by deadline and a timerfd is armed for the first one, so timers cost no thread of their
+ * own and expire with the resolution of the monotonic clock. The callbacks are called on the service thread one
+ * at a time, so they should only hand work over to another thread.
+ */
+class TimerService
+{
+public:
+    /**
+     * @brief The state of a timer, shared between its ITimer and the service.
+     */
+    struct TimerState
+    {
+        TimerState(const std::chrono::milliseconds &timeout, const std::function<void()> &callback, TimerType type)
+            : kTimeout{timeout}, kCallback{callback}, kType{type}
+        {
+        }
+
+        const std::chrono::steady_clock::duration kTimeout;
+        const std::function<void()> kCallback;
+        const TimerType kType;
+        std::atomic<bool> active{true};
+
+        // guarded by the service mutex
+        std::chrono::steady_clock::time_point deadline;
+        uint64_t id{0};
+    };
+
+    /**
+     * @brief Gets the timer service of the process, starting its thread on first use.
+     *
+     * @retval the service, or null if its timerfd could not be created.
+     */
+    static TimerService *instance();
+
+    /**
+     * @brief Schedules the timer to expire after its timeout.
+     *
+     * @param[in] timer : The timer to schedule.
+     */
+    void schedule(const std::shared_ptr<TimerState> &timer);
+
+    /**
+     * @brief Cancels the timer.
+     *
+     * If the callback of the timer is running on another thread, waits for it to return. Called from the callback
+     * itself it returns straight away.
+     *
+     * @param[in] timer : The timer to cancel.
+     */
+    void cancel(const std::shared_ptr<TimerState> &timer);
+
+    /**
+     * @brief Gets the counters of the timers of the process.
+     *
+     * @retval the timer counters.
+     */
+    TimerStats getStats() const;
+
+private:
+    explicit TimerService(int timerFd);
+    ~TimerService() = default;
+
+    void run();
+    void updateTimerFdNoLock();
+    void deactivate(TimerState &timer);
+
+private:
+    const int m_kTimerFd;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_callbackDone;
+    std::map<std::pair<std::chrono::steady_clock::time_point, uint64_t>, std::shared_ptr<TimerState>> m_timers;
+    std::shared_ptr<TimerState> m_runningTimer;
+    uint64_t m_nextId{0};
+    std::thread m_thread;
+
+    std::atomic<uint64_t> m_activeTimers{0};
+    std::atomic<uint64_t> m_createdTimers{0};
+    std::atomic<uint64_t> m_expiredTimers{0};
+    std::atomic<uint64_t> m_maxLatenessUs{0};
+};
+} // namespace firebolt::rialto::common
+
+#endif // FIREBOLT_RIALTO_COMMON_TIMER_SERVICE_H_
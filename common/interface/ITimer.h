@@ -21,6 +21,7 @@
 #define FIREBOLT_RIALTO_COMMON_I_TIMER_H_
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 
@@ -34,6 +35,17 @@ enum class TimerType
     PERIODIC
 };
 
+/**
+ * @brief Counters of the timers of the process.
+ */
+struct TimerStats
+{
+    uint64_t activeTimers = 0;  // timers that are scheduled or running their callback
+    uint64_t createdTimers = 0; // total number of timers created
+    uint64_t expiredTimers = 0; // total number of callbacks called
+    uint64_t maxLatenessUs = 0; // the longest time a callback has been called after its deadline
+};
+
 /**
  * @brief ITimerFactory factory class, returns a concrete implementation of ITimer
  */
@@ -62,6 +74,13 @@ public:
     virtual std::unique_ptr<ITimer> createTimer(const std::chrono::milliseconds &timeout,
                                                 const std::function<void()> &callback,
                                                 TimerType timerType = TimerType::ONE_SHOT) const = 0;
+
+    /**
+     * @brief Gets the counters of the timers of the process.
+     *
+     * @retval the timer counters.
+     */
+    virtual TimerStats getStats() const = 0;
 };
 
 class ITimer
@@ -48,36 +48,31 @@ std::shared_ptr<ITimerFactory> ITimerFactory::getFactory()
 std::unique_ptr<ITimer> TimerFactory::createTimer(const std::chrono::milliseconds &timeout,
                                                   const std::function<void()> &callback, TimerType timerType) const
 {
-    return std::make_unique<Timer>(timeout, callback, timerType);
+    TimerService *service = TimerService::instance();
+    if (!service)
+    {
+        return nullptr;
+    }
+
+    return std::make_unique<Timer>(*service, timeout, callback, timerType);
 }
 
-Timer::Timer(const std::chrono::milliseconds &timeout, const std::function<void()> &callback, TimerType timerType)
-    : m_active{true}, m_timeout{timeout}, m_callback{callback}
+TimerStats TimerFactory::getStats() const
 {
-    m_thread = std::thread(
-        [this, timerType]()
-        {
-            do
-            {
-                bool shouldExecuteCallback = false;
-                {
-                    std::unique_lock<std::mutex> lock{m_mutex};
-                    if (!m_cv.wait_for(lock, m_timeout, [this]() { return !m_active; }))
-                    {
-                        if (m_active && m_callback)
-                        {
-                            shouldExecuteCallback = true;
-                        }
-                    }
-                }
+    TimerService *service = TimerService::instance();
+    if (!service)
+    {
+        return TimerStats{};
+    }
+
+    return service->getStats();
+}
 
-                if (shouldExecuteCallback)
-                {
-                    m_callback();
-                }
-            } while (timerType == TimerType::PERIODIC && m_active);
-            m_active = false;
-        });
+Timer::Timer(TimerService &service, const std::chrono::milliseconds &timeout, const std::function<void()> &callback,
+             TimerType timerType)
+    : m_service{service}, m_state{std::make_shared<TimerService::TimerState>(timeout, callback, timerType)}
+{
+    m_service.schedule(m_state);
 }
 
 Timer::~Timer()
@@ -87,26 +82,11 @@ Timer::~Timer()
 
 void Timer::cancel()
 {
-    m_active = false;
-    m_cv.notify_one();
-
-    if (std::this_thread::get_id() == m_thread.get_id())
-    {
-        if (m_thread.joinable())
-        {
-            m_thread.detach();
-        }
-        return;
-    }
-
-    if (m_thread.joinable())
-    {
-        m_thread.join();
-    }
+    m_service.cancel(m_state);
 }
 
 bool Timer::isActive() const
 {
-    return m_active;
+    return m_state->active;
 }
 } // namespace firebolt::rialto::common
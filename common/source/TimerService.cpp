@@ -0,0 +1,189 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TimerService.h"
+#include "RialtoCommonLogging.h"
+
+#include <pthread.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <exception>
+
+namespace firebolt::rialto::common
+{
+TimerService *TimerService::instance()
+{
+    // the service is never destroyed, so timers may be cancelled from static destructors; its thread sleeps in
+    // read() when there are no timers
+    static TimerService *service = []() -> TimerService *
+    {
+        int timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+        if (timerFd < 0)
+        {
+            RIALTO_COMMON_LOG_SYS_ERROR(errno, "Failed to create the timerfd");
+            return nullptr;
+        }
+
+        try
+        {
+            return new TimerService{timerFd};
+        }
+        catch (const std::exception &e)
+        {
+            RIALTO_COMMON_LOG_ERROR("Failed to create the timer service, reason: %s", e.what());
+            close(timerFd);
+            return nullptr;
+        }
+    }();
+
+    return service;
+}
+
+TimerService::TimerService(int timerFd) : m_kTimerFd{timerFd}
+{
+    m_thread = std::thread(&TimerService::run, this);
+}
+
+void TimerService::schedule(const std::shared_ptr<TimerState> &timer)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    timer->deadline = std::chrono::steady_clock::now() + timer->kTimeout;
+    timer->id = m_nextId++;
+    m_timers.emplace(std::make_pair(timer->deadline, timer->id), timer);
+    ++m_createdTimers;
+    ++m_activeTimers;
+
+    if (m_timers.begin()->second == timer)
+    {
+        updateTimerFdNoLock();
+    }
+}
+
+void TimerService::cancel(const std::shared_ptr<TimerState> &timer)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    deactivate(*timer);
+
+    // the timerfd is left armed, if it was for this timer the service thread wakes up to find nothing has expired
+    m_timers.erase(std::make_pair(timer->deadline, timer->id));
+
+    if (std::this_thread::get_id() != m_thread.get_id())
+    {
+        m_callbackDone.wait(lock, [this, &timer]() { return m_runningTimer != timer; });
+    }
+}
+
+TimerStats TimerService::getStats() const
+{
+    TimerStats stats;
+    stats.activeTimers = m_activeTimers;
+    stats.createdTimers = m_createdTimers;
+    stats.expiredTimers = m_expiredTimers;
+    stats.maxLatenessUs = m_maxLatenessUs;
+    return stats;
+}
+
+void TimerService::run()
+{
+    pthread_setname_np(pthread_self(), "rialto-timers");
+
+    while (true)
+    {
+        uint64_t expirations;
+        if (TEMP_FAILURE_RETRY(read(m_kTimerFd, &expirations, sizeof(expirations))) < 0)
+        {
+            RIALTO_COMMON_LOG_SYS_ERROR(errno, "Failed to read the timerfd");
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock{m_mutex};
+        auto now = std::chrono::steady_clock::now();
+        while (!m_timers.empty() && m_timers.begin()->first.first <= now)
+        {
+            std::shared_ptr<TimerState> timer = std::move(m_timers.begin()->second);
+            m_timers.erase(m_timers.begin());
+            m_runningTimer = timer;
+            lock.unlock();
+
+            const uint64_t kLatenessUs =
+                std::chrono::duration_cast<std::chrono::microseconds>(now - timer->deadline).count();
+            uint64_t maxLatenessUs = m_maxLatenessUs;
+            while (kLatenessUs > maxLatenessUs && !m_maxLatenessUs.compare_exchange_weak(maxLatenessUs, kLatenessUs))
+            {
+            }
+            ++m_expiredTimers;
+
+            if (timer->kCallback)
+            {
+                timer->kCallback();
+            }
+
+            lock.lock();
+            m_runningTimer.reset();
+            now = std::chrono::steady_clock::now();
+            if (timer->kType == TimerType::PERIODIC && timer->active)
+            {
+                // periods are counted from the first deadline so they don't drift, the ones missed are skipped
+                timer->deadline += timer->kTimeout;
+                if (timer->deadline <= now && timer->kTimeout.count() > 0)
+                {
+                    timer->deadline += ((now - timer->deadline) / timer->kTimeout + 1) * timer->kTimeout;
+                }
+                timer->id = m_nextId++;
+                m_timers.emplace(std::make_pair(timer->deadline, timer->id), timer);
+            }
+            else
+            {
+                deactivate(*timer);
+            }
+            m_callbackDone.notify_all();
+        }
+
+        updateTimerFdNoLock();
+    }
+}
+
+void TimerService::updateTimerFdNoLock()
+{
+    if (m_timers.empty())
+    {
+        return;
+    }
+
+    const auto kDeadline = m_timers.begin()->first.first.time_since_epoch();
+    const auto kSeconds = std::chrono::duration_cast<std::chrono::seconds>(kDeadline);
+    itimerspec spec{};
+    spec.it_value.tv_sec = kSeconds.count();
+    spec.it_value.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(kDeadline - kSeconds).count();
+    if (timerfd_settime(m_kTimerFd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0)
+    {
+        RIALTO_COMMON_LOG_SYS_ERROR(errno, "Failed to arm the timerfd");
+    }
+}
+
+void TimerService::deactivate(TimerState &timer)
+{
+    if (timer.active.exchange(false))
+    {
+        --m_activeTimers;
+    }
+}
+} // namespace firebolt::rialto::common
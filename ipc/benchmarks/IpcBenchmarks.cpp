@@ -0,0 +1,521 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "example.pb.h"
+#include <IIpcChannel.h>
+#include <IIpcController.h>
+#include <IIpcControllerFactory.h>
+#include <IIpcServer.h>
+#include <IIpcServerFactory.h>
+#include <RialtoLogging.h>
+#include <algorithm>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using firebolt::rialto::ipc::IChannel;
+using firebolt::rialto::ipc::IChannelFactory;
+using firebolt::rialto::ipc::IClient;
+using firebolt::rialto::ipc::IControllerFactory;
+using firebolt::rialto::ipc::IServer;
+using firebolt::rialto::ipc::IServerFactory;
+
+namespace
+{
+constexpr int kWarmUpCalls{100};
+constexpr std::uint64_t kEventWindow{32};
+
+/**
+ * @brief The service of ipc/examples, echoes the text and the fd of each request back.
+ */
+class EchoService : public ::example::ExampleService
+{
+public:
+    void exampleEcho(google::protobuf::RpcController *controller, const ::example::RequestEcho *request,
+                     ::example::ResponseEcho *response, google::protobuf::Closure *done) override
+    {
+        response->set_text(request->text());
+        done->Run();
+    }
+
+    void exampleWithFd(google::protobuf::RpcController *controller, const ::example::RequestWithFd *request,
+                       ::example::ResponseWithFd *response, google::protobuf::Closure *done) override
+    {
+        // the request fd stays open until the call has been dispatched, so it can be sent straight back
+        response->set_fd(request->fd());
+        done->Run();
+    }
+};
+
+/**
+ * @brief A server on its own thread, with clients connected to it over socket pairs.
+ */
+class IpcFixture
+{
+public:
+    explicit IpcFixture(size_t numClients) : m_server{IServerFactory::createFactory()->create()}
+    {
+        // only report errors, logging would dominate the measurement
+        firebolt::rialto::logging::setLogLevels(RIALTO_COMPONENT_IPC, RIALTO_DEBUG_LEVEL(RIALTO_DEBUG_LEVEL_FATAL |
+                                                                                         RIALTO_DEBUG_LEVEL_ERROR));
+
+        for (size_t i = 0; m_server && i < numClients; ++i)
+        {
+            int socks[2] = {-1, -1};
+            if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0, socks) < 0)
+            {
+                std::perror("socketpair failed");
+                break;
+            }
+            std::shared_ptr<IClient> client = m_server->addClient(socks[0]);
+            if (!client)
+            {
+                close(socks[1]);
+                break;
+            }
+            client->exportService(std::make_shared<EchoService>());
+
+            std::shared_ptr<IChannel> channel = IChannelFactory::createFactory()->createChannel(socks[1]);
+            if (!channel)
+            {
+                break;
+            }
+            m_clients.push_back(client);
+            m_channels.push_back(channel);
+        }
+
+        m_serverThread = std::thread(
+            [this]()
+            {
+                while (m_running && m_server && m_server->process())
+                {
+                    m_server->wait(10);
+                }
+            });
+    }
+
+    ~IpcFixture()
+    {
+        for (const auto &channel : m_channels)
+        {
+            channel->disconnect();
+        }
+        m_running = false;
+        m_serverThread.join();
+    }
+
+    bool isValid(size_t numClients) const { return m_channels.size() == numClients; }
+
+    const std::vector<std::shared_ptr<IClient>> &clients() const { return m_clients; }
+    const std::vector<std::shared_ptr<IChannel>> &channels() const { return m_channels; }
+
+private:
+    std::shared_ptr<IServer> m_server;
+    std::vector<std::shared_ptr<IClient>> m_clients;
+    std::vector<std::shared_ptr<IChannel>> m_channels;
+    std::atomic<bool> m_running{true};
+    std::thread m_serverThread;
+};
+
+void onComplete(bool *done)
+{
+    *done = true;
+}
+
+/**
+ * @brief Completion of a call that is waited for on a different thread to the one processing the channel.
+ */
+struct Completion
+{
+    std::mutex lock;
+    std::condition_variable completed;
+    bool done{false};
+};
+
+void onCallComplete(Completion *completion)
+{
+    std::lock_guard<std::mutex> locker(completion->lock);
+    completion->done = true;
+    completion->completed.notify_one();
+}
+
+/**
+ * @brief Makes a call and processes the channel on the calling thread until it completes.
+ *
+ * @retval the round trip time in microseconds, or a negative value if the call failed.
+ */
+template <typename Request, typename Response>
+double timedCall(IChannel &channel, IControllerFactory &controllerFactory,
+                 void (::example::ExampleService::Stub::*method)(google::protobuf::RpcController *, const Request *,
+                                                                 Response *, google::protobuf::Closure *),
+                 const Request &request, Response &response)
+{
+    ::example::ExampleService::Stub stub(&channel);
+    auto controller = controllerFactory.create();
+    bool done{false};
+
+    const auto kStart{std::chrono::steady_clock::now()};
+    (stub.*method)(controller.get(), &request, &response, google::protobuf::NewCallback(onComplete, &done));
+    while (channel.process() && !done)
+    {
+        channel.wait(-1);
+    }
+    const std::chrono::duration<double, std::micro> kElapsed{std::chrono::steady_clock::now() - kStart};
+
+    return (done && !controller->Failed()) ? kElapsed.count() : -1.0;
+}
+
+void reportPercentiles(benchmark::State &state, std::vector<double> &latencies)
+{
+    if (latencies.empty())
+    {
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    const auto kPercentile = [&latencies](double p)
+    { return latencies[std::min(latencies.size() - 1, static_cast<size_t>(p * latencies.size()))]; };
+
+    state.counters["p50_us"] = kPercentile(0.5);
+    state.counters["p90_us"] = kPercentile(0.9);
+    state.counters["p99_us"] = kPercentile(0.99);
+    state.counters["max_us"] = latencies.back();
+}
+
+/**
+ * @brief Round trip latency of echo calls with the given payload size.
+ */
+void echoLatency(benchmark::State &state, size_t payloadBytes, bool useSharedMemory)
+{
+    IpcFixture fixture{1};
+    if (!fixture.isValid(1))
+    {
+        state.SkipWithError("Failed to connect the client");
+        return;
+    }
+    IChannel &channel = *fixture.channels().front();
+    if (useSharedMemory && !channel.enableSharedMemoryTransport())
+    {
+        state.SkipWithError("Failed to enable the shared memory transport");
+        return;
+    }
+    auto controllerFactory = IControllerFactory::createFactory();
+
+    // the reply to a first small call tells the client the server accepts messages sent out of band, until then
+    // larger calls are limited to what can be sent inline
+    ::example::RequestEcho request;
+    request.set_text("");
+    ::example::ResponseEcho handshakeResponse;
+    if (timedCall(channel, *controllerFactory, &::example::ExampleService::Stub::exampleEcho, request,
+                  handshakeResponse) < 0.0)
+    {
+        state.SkipWithError("The echo call failed");
+        return;
+    }
+    request.set_text(std::string(payloadBytes, 'x'));
+
+    for (int i = 0; i < kWarmUpCalls; ++i)
+    {
+        ::example::ResponseEcho response;
+        if (timedCall(channel, *controllerFactory, &::example::ExampleService::Stub::exampleEcho, request, response) <
+            0.0)
+        {
+            state.SkipWithError("The echo call failed");
+            return;
+        }
+    }
+
+    std::vector<double> latencies;
+    for (auto _ : state)
+    {
+        ::example::ResponseEcho response;
+        const double kLatency{timedCall(channel, *controllerFactory, &::example::ExampleService::Stub::exampleEcho,
+                                        request, response)};
+        if (kLatency < 0.0 || response.text().size() != payloadBytes)
+        {
+            state.SkipWithError("The echo call failed");
+            break;
+        }
+        latencies.push_back(kLatency);
+    }
+
+    state.SetBytesProcessed(state.iterations() * payloadBytes);
+    reportPercentiles(state, latencies);
+}
+
+/**
+ * @brief Round trip latency of calls that pass an fd to the server and get one back, the difference to the 16 byte
+ *        echo is the cost of passing the fds.
+ */
+void fdPassing(benchmark::State &state)
+{
+    IpcFixture fixture{1};
+    if (!fixture.isValid(1))
+    {
+        state.SkipWithError("Failed to connect the client");
+        return;
+    }
+    IChannel &channel = *fixture.channels().front();
+    auto controllerFactory = IControllerFactory::createFactory();
+
+    const int kFd{eventfd(0, EFD_CLOEXEC)};
+    if (kFd < 0)
+    {
+        state.SkipWithError("Failed to create the eventfd");
+        return;
+    }
+    ::example::RequestWithFd request;
+    request.set_text(std::string(16, 'x'));
+    request.set_fd(kFd);
+
+    const auto kCall = [&]()
+    {
+        ::example::ResponseWithFd response;
+        const double kLatency{timedCall(channel, *controllerFactory, &::example::ExampleService::Stub::exampleWithFd,
+                                        request, response)};
+        return (kLatency < 0.0 || !response.has_fd() || close(response.fd()) != 0) ? -1.0 : kLatency;
+    };
+
+    std::vector<double> latencies;
+    bool isWarmedUp{true};
+    for (int i = 0; i < kWarmUpCalls && isWarmedUp; ++i)
+    {
+        isWarmedUp = kCall() >= 0.0;
+    }
+    for (auto _ : state)
+    {
+        const double kLatency{isWarmedUp ? kCall() : -1.0};
+        if (kLatency < 0.0)
+        {
+            state.SkipWithError("The call with an fd failed");
+            break;
+        }
+        latencies.push_back(kLatency);
+    }
+    close(kFd);
+
+    reportPercentiles(state, latencies);
+}
+
+/**
+ * @brief Rate at which the server delivers an event to each of the given number of clients.
+ *
+ * Each client processes its channel on its own thread. The server drops events that don't fit in the socket, so after
+ * every kEventWindow events the clients are given time to catch up.
+ */
+void eventFanOut(benchmark::State &state)
+{
+    const size_t kNumClients{static_cast<size_t>(state.range(0))};
+    IpcFixture fixture{kNumClients};
+    if (!fixture.isValid(kNumClients))
+    {
+        state.SkipWithError("Failed to connect the clients");
+        return;
+    }
+
+    std::vector<std::atomic<std::uint64_t>> received(kNumClients);
+    std::atomic<bool> running{true};
+    std::vector<std::thread> clientThreads;
+    for (size_t i = 0; i < kNumClients; ++i)
+    {
+        std::shared_ptr<IChannel> channel = fixture.channels()[i];
+        std::atomic<std::uint64_t> &counter = received[i];
+        channel->subscribe<::example::SomeEvent>([&counter](const std::shared_ptr<::example::SomeEvent> &)
+                                                 { counter.fetch_add(1, std::memory_order_release); });
+        clientThreads.emplace_back(
+            [channel, &running]()
+            {
+                while (running && channel->process())
+                {
+                    channel->wait(10);
+                }
+            });
+    }
+
+    auto event = std::make_shared<::example::SomeEvent>();
+    event->set_id(1);
+    event->set_text(std::string(64, 'x'));
+
+    // waits for all the clients to receive the events sent, false if events were lost
+    const auto kWaitForClients = [&received](std::uint64_t sent)
+    {
+        const auto kDeadline{std::chrono::steady_clock::now() + std::chrono::seconds(5)};
+        for (const auto &counter : received)
+        {
+            while (counter.load(std::memory_order_acquire) < sent)
+            {
+                if (std::chrono::steady_clock::now() > kDeadline)
+                {
+                    return false;
+                }
+                std::this_thread::yield();
+            }
+        }
+        return true;
+    };
+
+    std::uint64_t sent{0};
+    for (auto _ : state)
+    {
+        bool failed{false};
+        for (const auto &client : fixture.clients())
+        {
+            failed = failed || !client->sendEvent(event);
+        }
+        ++sent;
+        if (failed || (sent % kEventWindow == 0 && !kWaitForClients(sent)))
+        {
+            state.SkipWithError("Events were lost");
+            break;
+        }
+    }
+    if (!kWaitForClients(sent))
+    {
+        state.SkipWithError("Events were lost");
+    }
+
+    running = false;
+    for (auto &thread : clientThreads)
+    {
+        thread.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * kNumClients);
+}
+
+/**
+ * @brief The channel shared by the callers, processed by its own thread as the client library does.
+ */
+struct SharedChannel
+{
+    SharedChannel() : fixture{1}
+    {
+        if (fixture.isValid(1))
+        {
+            channel = fixture.channels().front();
+            processThread = std::thread(
+                [this]()
+                {
+                    while (running && channel->process())
+                    {
+                        channel->wait(10);
+                    }
+                });
+        }
+    }
+
+    ~SharedChannel()
+    {
+        running = false;
+        if (processThread.joinable())
+        {
+            processThread.join();
+        }
+    }
+
+    IpcFixture fixture;
+    std::shared_ptr<IChannel> channel;
+    std::atomic<bool> running{true};
+    std::thread processThread;
+};
+
+std::unique_ptr<SharedChannel> gSharedChannel;
+
+/**
+ * @brief Throughput of several threads making echo calls on a single channel.
+ *
+ * Each benchmark thread is a caller, which blocks until its call completes.
+ */
+void concurrentCallers(benchmark::State &state)
+{
+    if (state.thread_index() == 0)
+    {
+        gSharedChannel = std::make_unique<SharedChannel>();
+    }
+    auto controllerFactory = IControllerFactory::createFactory();
+    ::example::RequestEcho request;
+    request.set_text(std::string(64, 'x'));
+
+    // the channel is only there once all the threads have entered the loop, every thread sees the same one so they
+    // all stop on a bad one
+    std::unique_ptr<::example::ExampleService::Stub> stub;
+    bool failed{false};
+    for (auto _ : state)
+    {
+        if (failed)
+        {
+            continue;
+        }
+        if (!gSharedChannel->channel)
+        {
+            state.SkipWithError("Failed to connect the client");
+            break;
+        }
+        if (!stub)
+        {
+            stub = std::make_unique<::example::ExampleService::Stub>(gSharedChannel->channel.get());
+        }
+
+        ::example::ResponseEcho response;
+        auto controller = controllerFactory->create();
+        Completion completion;
+        stub->exampleEcho(controller.get(), &request, &response,
+                          google::protobuf::NewCallback(onCallComplete, &completion));
+
+        std::unique_lock<std::mutex> locker(completion.lock);
+        if (!completion.completed.wait_for(locker, std::chrono::seconds(5),
+                                           [&completion]() { return completion.done; }) ||
+            controller->Failed())
+        {
+            // the other threads are still in the loop, so this one carries on without calling
+            state.SkipWithError("The echo call failed");
+            failed = true;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    stub.reset();
+    if (state.thread_index() == 0)
+    {
+        gSharedChannel.reset();
+    }
+}
+} // namespace
+
+BENCHMARK_CAPTURE(echoLatency, 16B, 16, false)->Name("ipc/echo/16B")->UseRealTime();
+BENCHMARK_CAPTURE(echoLatency, 256B, 256, false)->Name("ipc/echo/256B")->UseRealTime();
+BENCHMARK_CAPTURE(echoLatency, 4kB, 4096, false)->Name("ipc/echo/4kB")->UseRealTime();
+BENCHMARK_CAPTURE(echoLatency, 32kB, 32 * 1024, false)->Name("ipc/echo/32kB")->UseRealTime();
+BENCHMARK_CAPTURE(echoLatency, 128kB, 128 * 1024, false)->Name("ipc/echo/128kB")->UseRealTime();
+BENCHMARK_CAPTURE(echoLatency, 1MB, 1024 * 1024, false)->Name("ipc/echo/1MB")->UseRealTime();
+BENCHMARK_CAPTURE(echoLatency, 16B, 16, true)->Name("ipc/echo_shm/16B")->UseRealTime();
+BENCHMARK_CAPTURE(echoLatency, 4kB, 4096, true)->Name("ipc/echo_shm/4kB")->UseRealTime();
+BENCHMARK(fdPassing)->Name("ipc/fd/16B")->UseRealTime();
+BENCHMARK(eventFanOut)->Name("ipc/events")->ArgName("clients")->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+BENCHMARK(concurrentCallers)->Name("ipc/concurrent")->Threads(1)->Threads(4)->Threads(16)->UseRealTime();
@@ -160,11 +160,62 @@ public:
      */
     virtual bool unsubscribe(int eventTag) = 0;
 
+    /**
+     * @brief Requests that the shared memory transport is used on the channel.
+     *
+     * Once the server accepts, messages without file descriptors are exchanged through a pair of
+     * rings in shared memory rather than the socket, which is still used for messages carrying fds
+     * and to track the connection.  Servers that don't support it just ignore the request and the
+     * channel carries on using the socket.
+     *
+     *  \threadsafe
+     *
+     * @retval true if the request was sent to the server.
+     */
+    virtual bool enableSharedMemoryTransport() = 0;
+
 private:
     virtual int subscribeImpl(const std::string &eventName, const google::protobuf::Descriptor *descriptor,
                               std::function<void(const std::shared_ptr<google::protobuf::Message> &msg)> &&handler) = 0;
 };
 
+/**
+ * @brief Closure that calls a function once and then deletes itself.
+ *
+ * Used for non-blocking method calls, the function is called from the thread that processes the
+ * channel when the reply arrives, or from the calling thread if the call fails to be sent.
+ */
+class CallbackClosure final : public google::protobuf::Closure
+{
+public:
+    explicit CallbackClosure(std::function<void()> &&callback) : m_callback{std::move(callback)} {}
+
+    void Run() override
+    {
+        std::function<void()> callback{std::move(m_callback)};
+        delete this;
+        if (callback)
+            callback();
+    }
+
+private:
+    ~CallbackClosure() override = default;
+
+    std::function<void()> m_callback;
+};
+
+/**
+ * @brief Creates a self deleting closure to be passed to the RPC stubs for a non-blocking call.
+ *
+ * @param[in] callback  : The function to call when the method call has completed.
+ *
+ * @retval the closure, owned by the channel once passed to a method call.
+ */
+inline google::protobuf::Closure *createCallbackClosure(std::function<void()> &&callback)
+{
+    return new CallbackClosure(std::move(callback));
+}
+
 } // namespace firebolt::rialto::ipc
 
 #endif // FIREBOLT_RIALTO_IPC_I_IPC_CHANNEL_H_
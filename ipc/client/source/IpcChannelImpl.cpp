@@ -21,6 +21,7 @@
 #include <cinttypes>
 #include <cstdarg>
 #include <memory>
+#include <thread>
 #include <utility>
 
 #include <fcntl.h>
@@ -34,6 +35,7 @@
 
 #include "IpcChannelImpl.h"
 #include "IpcLogging.h"
+#include "OutOfBandPayload.h"
 #include "rialtoipc.pb.h"
 
 #if !defined(SCM_MAX_FD)
@@ -42,8 +44,13 @@
 
 namespace
 {
-constexpr size_t kMaxMessageSize{128 * 1024};
+constexpr size_t kMaxInlineMessageSize{firebolt::rialto::ipc::OutOfBandPayload::kMaxInlineMessageSize};
+constexpr size_t kRecvBatchSize{8};
+constexpr size_t kRecvCtrlSize{CMSG_SPACE(SCM_MAX_FD * sizeof(int))};
+constexpr uint32_t kMaxEventIds{4096};
 const std::chrono::milliseconds kDefaultIpcTimeout{3000};
+constexpr std::chrono::nanoseconds kMinShmSpin{1000};
+constexpr std::chrono::nanoseconds kMaxShmSpin{50000};
 
 std::chrono::milliseconds getIpcTimeout()
 {
@@ -115,8 +122,10 @@ std::shared_ptr<IChannel> ChannelFactory::createChannel(const std::string &socke
 }
 
 ChannelImpl::ChannelImpl(int sock)
-    : m_sock(-1), m_epollFd(-1), m_timerFd(-1), m_eventFd(-1), m_serialCounter(1), m_timeout(getIpcTimeout()),
-      m_eventTagCounter(1)
+    : m_sock(-1), m_epollFd(-1), m_timerFd(-1), m_eventFd(-1),
+      m_recvDataBuf(new uint8_t[kRecvBatchSize * kMaxInlineMessageSize]),
+      m_recvDataBufMessageSize(kMaxInlineMessageSize), m_recvMessageSize(kMaxInlineMessageSize),
+      m_recvCtrlBuf(kRecvBatchSize * kRecvCtrlSize), m_serialCounter(1), m_timeout(getIpcTimeout()), m_eventTagCounter(1), m_shmSpinNs(kMinShmSpin.count())
 {
     if (!attachSocket(sock))
     {
@@ -132,11 +141,18 @@ ChannelImpl::ChannelImpl(int sock)
         termChannel();
         throw std::runtime_error("Channel not connected");
     }
+    if (!sendConnectionSetup())
+    {
+        termChannel();
+        throw std::runtime_error("Failed to send the connection setup");
+    }
 }
 
 ChannelImpl::ChannelImpl(const std::string &socketPath)
-    : m_sock(-1), m_epollFd(-1), m_timerFd(-1), m_eventFd(-1), m_serialCounter(1), m_timeout(getIpcTimeout()),
-      m_eventTagCounter(1)
+    : m_sock(-1), m_epollFd(-1), m_timerFd(-1), m_eventFd(-1),
+      m_recvDataBuf(new uint8_t[kRecvBatchSize * kMaxInlineMessageSize]),
+      m_recvDataBufMessageSize(kMaxInlineMessageSize), m_recvMessageSize(kMaxInlineMessageSize),
+      m_recvCtrlBuf(kRecvBatchSize * kRecvCtrlSize), m_serialCounter(1), m_timeout(getIpcTimeout()), m_eventTagCounter(1), m_shmSpinNs(kMinShmSpin.count())
 {
     if (!createConnectedSocket(socketPath))
     {
@@ -152,6 +168,11 @@ ChannelImpl::ChannelImpl(const std::string &socketPath)
         termChannel();
         throw std::runtime_error("Channel not connected");
     }
+    if (!sendConnectionSetup())
+    {
+        termChannel();
+        throw std::runtime_error("Failed to send the connection setup");
+    }
 }
 
 ChannelImpl::~ChannelImpl()
@@ -291,13 +312,23 @@ void ChannelImpl::termChannel()
     if ((m_eventFd >= 0) && (close(m_eventFd) != 0))
         RIALTO_IPC_LOG_SYS_ERROR(errno, "closing event fd failed");
 
-    // if any method calls are still outstanding then complete them with errors now
+    // if any method calls are still outstanding then complete them with errors now, calls expecting a reply that
+    // are still waiting for the connection setup are in m_methodCalls as well
     for (auto &entry : m_methodCalls)
     {
         completeWithError(&entry.second, "Channel destructed");
     }
+    for (auto &awaitingCall : m_callsAwaitingSetup)
+    {
+        if (awaitingCall.noReplyExpected)
+        {
+            completeWithError(&awaitingCall.methodCall, "Channel destructed");
+        }
+    }
 
     m_methodCalls.clear();
+    m_deadlines.clear();
+    m_callsAwaitingSetup.clear();
 }
 
 void ChannelImpl::disconnect()
@@ -379,6 +410,12 @@ bool ChannelImpl::wait(int timeoutMSecs)
         return false;
     }
 
+    // with the shared memory transport messages can be picked up without blocking, so spin for a little while first
+    if ((timeoutMSecs != 0) && spinForShmMessage())
+    {
+        return isConnected();
+    }
+
     // wait for any event (with timeout)
     struct pollfd fds[2];
     fds[0].fd = m_epollFd;
@@ -399,8 +436,8 @@ bool ChannelImpl::process()
     if (!isConnected())
         return false;
 
-    struct epoll_event events[3];
-    int rc = TEMP_FAILURE_RETRY(epoll_wait(m_epollFd, events, 3, 0));
+    struct epoll_event events[4];
+    int rc = TEMP_FAILURE_RETRY(epoll_wait(m_epollFd, events, 4, 0));
     if (rc < 0)
     {
         RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_wait failed");
@@ -411,7 +448,8 @@ bool ChannelImpl::process()
     {
         HaveSocketEvent = 0x1,
         HaveTimeoutEvent = 0x2,
-        HaveWakeEvent = 0x4
+        HaveWakeEvent = 0x4,
+        HaveShmEvent = 0x8
     };
     unsigned eventsMask = 0;
     for (int i = 0; i < rc; i++)
@@ -422,6 +460,17 @@ bool ChannelImpl::process()
             eventsMask |= HaveTimeoutEvent;
         else if (events[i].data.fd == m_eventFd)
             eventsMask |= HaveWakeEvent;
+        else if (events[i].data.fd == m_shmDoorbellFd)
+            eventsMask |= HaveShmEvent;
+    }
+
+    // the ring may have been written to without the doorbell being rung (if we were spinning) so always check it
+    if (m_shmRxEnabled)
+    {
+        std::lock_guard<std::mutex> bufLocker(m_recvBufLock);
+        if (eventsMask & HaveShmEvent)
+            m_shmRxTransport->clearDoorbell();
+        processShmMessages();
     }
 
     if ((eventsMask & HaveSocketEvent) && !processSocketEvent())
@@ -431,6 +480,7 @@ bool ChannelImpl::process()
             std::lock_guard<std::mutex> locker(m_lock);
             callsToDelete = m_methodCalls;
             m_methodCalls.clear();
+            m_deadlines.clear();
         }
 
         for (auto &entry : callsToDelete)
@@ -469,32 +519,46 @@ bool ChannelImpl::unsubscribe(int eventTag)
 /*!
     \internal
 
+    Reads all the messages waiting on the socket, up to kRecvBatchSize at a
+    time with a single recvmmsg() call, and processes them in order.
 
  */
 bool ChannelImpl::processSocketEvent()
 {
-    static std::mutex bufLock;
-    std::lock_guard<std::mutex> bufLocker(bufLock);
+    // the receive buffers are owned by the channel, so only concurrent processing of the same channel is serialised
+    std::lock_guard<std::mutex> bufLocker(m_recvBufLock);
+    uint8_t *ctrlBuf = m_recvCtrlBuf.data();
 
-    static std::vector<uint8_t> dataBuf(kMaxMessageSize);
-    static std::vector<uint8_t> ctrlBuf(CMSG_SPACE(SCM_MAX_FD * sizeof(int)));
+    struct mmsghdr msgs[kRecvBatchSize];
+    struct iovec ios[kRecvBatchSize];
 
     // read all messages from the client socket, we break out if the socket is closed
     // or EWOULDBLOCK is returned on a read (ie. no more messages to read)
     while (true)
     {
-        struct msghdr msg = {nullptr};
-        struct iovec io = {.iov_base = dataBuf.data(), .iov_len = dataBuf.size()};
+        // the connection setup reply, processed in the last batch, may have changed the size of message to expect
+        if (m_recvDataBufMessageSize != m_recvMessageSize)
+        {
+            m_recvDataBuf.reset(new uint8_t[kRecvBatchSize * m_recvMessageSize]);
+            m_recvDataBufMessageSize = m_recvMessageSize;
+        }
+        uint8_t *dataBuf = m_recvDataBuf.get();
 
-        bzero(&msg, sizeof(msg));
-        msg.msg_iov = &io;
-        msg.msg_iovlen = 1;
-        msg.msg_control = ctrlBuf.data();
-        msg.msg_controllen = ctrlBuf.size();
+        bzero(msgs, sizeof(msgs));
+        for (size_t i = 0; i < kRecvBatchSize; i++)
+        {
+            ios[i].iov_base = dataBuf + (i * m_recvDataBufMessageSize);
+            ios[i].iov_len = m_recvDataBufMessageSize;
 
-        // read one message
-        ssize_t rd = TEMP_FAILURE_RETRY(recvmsg(m_sock, &msg, MSG_CMSG_CLOEXEC));
-        if (rd < 0)
+            msgs[i].msg_hdr.msg_iov = &ios[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_control = ctrlBuf + (i * kRecvCtrlSize);
+            msgs[i].msg_hdr.msg_controllen = kRecvCtrlSize;
+        }
+
+        // read as many messages as are waiting, up to the size of the batch
+        int rc = TEMP_FAILURE_RETRY(recvmmsg(m_sock, msgs, kRecvBatchSize, MSG_CMSG_CLOEXEC, nullptr));
+        if (rc < 0)
         {
             if (errno != EWOULDBLOCK)
             {
@@ -507,38 +571,57 @@ bool ChannelImpl::processSocketEvent()
 
             break;
         }
-        else if (rd == 0)
-        {
-            // server closed connection, and we've read all data
-            RIALTO_IPC_LOG_INFO("socket remote end closed, disconnecting channel");
 
-            std::lock_guard<std::mutex> locker(m_lock);
-            disconnectNoLock();
-            return false;
-        }
-        else if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
+        for (int i = 0; i < rc; i++)
         {
-            RIALTO_IPC_LOG_WARN("received truncated message from server, discarding");
+            struct msghdr &msg = msgs[i].msg_hdr;
+            const size_t kLength = msgs[i].msg_len;
 
-            // make sure to close all the fds, otherwise we'll leak them, this
-            // will read the fds and return in a vector, which will then be
-            // destroyed, closing all the fds
-            readMessageFds(&msg, 16);
-        }
-        else
-        {
-            // if there is control data then assume fd(s) have been passed
-            std::vector<FileDescriptor> fds;
-            if (msg.msg_controllen > 0)
+            if (kLength == 0)
+            {
+                // server closed connection, and we've read all data
+                RIALTO_IPC_LOG_INFO("socket remote end closed, disconnecting channel");
+
+                std::lock_guard<std::mutex> locker(m_lock);
+                disconnectNoLock();
+                return false;
+            }
+
+            // any messages the server put on the shared memory rings before sending this one must go first
+            processShmMessages();
+            m_socketRecvCount++;
+
+            if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
             {
-                fds = readMessageFds(&msg, 32);
+                RIALTO_IPC_LOG_WARN("received truncated message from server, discarding");
+
+                // make sure to close all the fds, otherwise we'll leak them, this
+                // will read the fds and return in a vector, which will then be
+                // destroyed, closing all the fds
+                readMessageFds(&msg, 16);
             }
+            else
+            {
+                // if there is control data then assume fd(s) have been passed
+                std::vector<FileDescriptor> fds;
+                if (msg.msg_controllen > 0)
+                {
+                    fds = readMessageFds(&msg, 32);
+                }
 
-            // process the message from the server
-            processServerMessage(dataBuf.data(), rd, &fds);
+                // process the message from the server
+                processServerMessage(reinterpret_cast<uint8_t *>(msg.msg_iov->iov_base), kLength, &fds);
+            }
         }
+
+        // a short batch means the socket has been drained
+        if (static_cast<size_t>(rc) < kRecvBatchSize)
+            break;
     }
 
+    // and then any sent after the last socket message
+    processShmMessages();
+
     return true;
 }
 
@@ -569,27 +652,19 @@ void ChannelImpl::processTimeoutEvent()
         // check if any method call has now expired
         std::unique_lock<std::mutex> locker(m_lock);
 
-        // remove the method calls that have expired
+        // the timer has fired so is no longer armed
+        m_timerDeadline = std::chrono::steady_clock::time_point::max();
+
+        // remove the method calls that have expired, they are at the front of the deadlines
         const auto kNow = std::chrono::steady_clock::now();
-        auto it = m_methodCalls.begin();
-        while (it != m_methodCalls.end())
+        while (!m_deadlines.empty() && (kNow >= m_deadlines.begin()->first))
         {
-            if (kNow >= it->second.timeoutDeadline)
-            {
-                timedOuts.emplace_back(it->second);
-                it = m_methodCalls.erase(it);
-            }
-            else
-            {
-                ++it;
-            }
+            auto it = m_methodCalls.find(m_deadlines.begin()->second);
+            timedOuts.emplace_back(takeMethodCallNoLock(it));
         }
 
-        // if we still have method calls available, then re-calculate the timer for the next timeout
-        if (!m_methodCalls.empty())
-        {
-            updateTimeoutTimer();
-        }
+        // if we still have method calls available, then re-arm the timer for the next timeout
+        updateTimeoutTimer();
     }
 
     for (auto &call : timedOuts)
@@ -619,49 +694,171 @@ void ChannelImpl::processWakeEvent()
 /*!
     \internal
 
-    Updates the timerfd to the time of the next method call timeout.  If method
-    calls are pending then the timer is disabled.
+    Processes the messages on the shared memory receive ring that the server
+    sent before its next, not yet received, socket message.  Once done the
+    server is told we're waiting so it rings the doorbell for the next message.
 
-    This should be called whenever a new method is called or a method has
-    completed.
-
-    \note Must be called while holding the m_lock mutex.
+    \note Must be called while holding the m_recvBufLock mutex.
 
  */
-void ChannelImpl::updateTimeoutTimer()
+void ChannelImpl::processShmMessages()
 {
-    struct itimerspec ts = {{0}};
+    if (!m_shmRxTransport)
+        return;
 
-    // if no method calls then just disarm the timer
-    if (!m_methodCalls.empty())
+    std::vector<FileDescriptor> noFds;
+    do
     {
-        // otherwise, find the next soonest timeout
-        std::chrono::steady_clock::time_point nextTimeout = std::chrono::steady_clock::time_point::max();
-        auto nextTimeoutCall =
-            std::min_element(m_methodCalls.begin(), m_methodCalls.end(), [](const auto &elem, const auto &currentMin)
-                             { return elem.second.timeoutDeadline < currentMin.second.timeoutDeadline; });
-        if (nextTimeoutCall != m_methodCalls.end())
+        uint64_t tag;
+        const uint8_t *data;
+        size_t dataLen;
+        while (m_shmRxTransport->peek(&tag, &data, &dataLen) && (tag <= m_socketRecvCount))
         {
-            nextTimeout = nextTimeoutCall->second.timeoutDeadline;
+            processServerMessage(data, dataLen, &noFds);
+            m_shmRxTransport->consume();
         }
+    } while (m_shmRxTransport->prepareToWait() && hasDeliverableShmMessage());
+}
 
-        // set the timerfd to the next duration
-        const std::chrono::microseconds kDuration =
-            std::chrono::duration_cast<std::chrono::microseconds>(nextTimeout - std::chrono::steady_clock::now());
-        if (kDuration <= std::chrono::microseconds::zero())
-        {
-            ts.it_value.tv_nsec = 1000;
-        }
-        else
-        {
-            ts.it_value.tv_sec = static_cast<time_t>(std::chrono::duration_cast<std::chrono::seconds>(kDuration).count());
-            ts.it_value.tv_nsec = static_cast<int32_t>((kDuration.count() % 1000000) * 1000);
-        }
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Returns \c true if the next message on the receive ring can be processed
+    now, ie. we've already received all the socket messages sent before it.
+
+    \note Must be called while holding the m_recvBufLock mutex.
+
+ */
+bool ChannelImpl::hasDeliverableShmMessage()
+{
+    uint64_t tag;
+    const uint8_t *data;
+    size_t dataLen;
+    return m_shmRxTransport->peek(&tag, &data, &dataLen) && (tag <= m_socketRecvCount);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Called from wait() before blocking, busy polls the shared memory receive
+    ring for a short time.  The time spent spinning grows while spinning
+    picks up messages and shrinks while it doesn't, there is no spinning at all
+    on single core systems.
+
+    Returns \c true if a message arrived.
+
+ */
+bool ChannelImpl::spinForShmMessage()
+{
+    static const bool kIsMultiCore = (std::thread::hardware_concurrency() > 1);
+    if (!kIsMultiCore || !m_shmRxEnabled)
+        return false;
+
+    const std::shared_ptr<ShmTransport> &kTransport = m_shmRxTransport;
+    if (kTransport->hasData())
+        return true;
+
+    // stop the server ringing the doorbell while we're spinning
+    kTransport->cancelWait();
+
+    const int64_t kSpinNs = m_shmSpinNs;
+    const auto kDeadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(kSpinNs);
+    bool received = false;
+    do
+    {
+        received = kTransport->hasData();
+    } while (!received && (std::chrono::steady_clock::now() < kDeadline));
 
-        RIALTO_IPC_LOG_DEBUG("next timeout in %" PRId64 "us - %ld.%09lds", kDuration.count(), ts.it_value.tv_sec,
-                             ts.it_value.tv_nsec);
+    if (received)
+    {
+        m_shmSpinNs = std::min(kSpinNs * 2, kMaxShmSpin.count());
+        return true;
     }
 
+    m_shmSpinNs = std::max(kSpinNs / 2, kMinShmSpin.count());
+
+    // re-arm the doorbell, if a message arrived in the meantime then there is no need to block
+    return kTransport->prepareToWait();
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Adds a method call to the outstanding calls, and to the deadlines ordered
+    by time, re-arming the timerfd if the call is the first to expire.
+
+    \note Must be called while holding the m_lock mutex.
+
+ */
+void ChannelImpl::addMethodCallNoLock(uint64_t serialId, const MethodCall &methodCall)
+{
+    m_methodCalls.emplace(serialId, methodCall);
+    m_deadlines.emplace(methodCall.timeoutDeadline, serialId);
+
+    updateTimeoutTimer();
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Removes the method call at \a it from the outstanding calls and returns it.
+    Cancelling its deadline is a lookup, the timerfd is left armed and if it
+    fires before the next deadline processTimeoutEvent() simply re-arms it.
+
+    \note Must be called while holding the m_lock mutex.
+
+ */
+ChannelImpl::MethodCall ChannelImpl::takeMethodCallNoLock(std::map<uint64_t, MethodCall>::iterator it)
+{
+    MethodCall methodCall = it->second;
+    m_deadlines.erase(std::make_pair(methodCall.timeoutDeadline, it->first));
+    m_methodCalls.erase(it);
+
+    return methodCall;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Arms the timerfd for the first deadline of the outstanding method calls, if
+    it isn't already armed for the same or an earlier time.  So with calls that
+    complete in order the timerfd is only written when the armed deadline has
+    passed, and not on every call and reply.
+
+    \note Must be called while holding the m_lock mutex.
+
+ */
+void ChannelImpl::updateTimeoutTimer()
+{
+    if (m_deadlines.empty() || (m_deadlines.begin()->first >= m_timerDeadline))
+    {
+        return;
+    }
+
+    m_timerDeadline = m_deadlines.begin()->first;
+
+    // set the timerfd to the next duration
+    struct itimerspec ts = {{0}};
+    const std::chrono::microseconds kDuration =
+        std::chrono::duration_cast<std::chrono::microseconds>(m_timerDeadline - std::chrono::steady_clock::now());
+    if (kDuration <= std::chrono::microseconds::zero())
+    {
+        ts.it_value.tv_nsec = 1000;
+    }
+    else
+    {
+        ts.it_value.tv_sec = static_cast<time_t>(std::chrono::duration_cast<std::chrono::seconds>(kDuration).count());
+        ts.it_value.tv_nsec = static_cast<int32_t>((kDuration.count() % 1000000) * 1000);
+    }
+
+    RIALTO_IPC_LOG_DEBUG("next timeout in %" PRId64 "us - %ld.%09lds", kDuration.count(), ts.it_value.tv_sec,
+                         ts.it_value.tv_nsec);
+
     // write the timeout value
     if (timerfd_settime(m_timerFd, 0, &ts, nullptr) != 0)
     {
@@ -674,8 +871,8 @@ void ChannelImpl::updateTimeoutTimer()
     \internal
 
     Processes a single message from the server, it may be a method call response
-    or an event.
-
+    or an event.  A message sent out of band is parsed from the memfd attached
+    as the last of the \a fds.
 
  */
 void ChannelImpl::processServerMessage(const uint8_t *data, size_t dataLen, std::vector<FileDescriptor> *fds)
@@ -688,6 +885,24 @@ void ChannelImpl::processServerMessage(const uint8_t *data, size_t dataLen, std:
         return;
     }
 
+    if (message.has_out_of_band())
+    {
+        if (fds->empty())
+        {
+            RIALTO_IPC_LOG_ERROR("out of band message from server without a payload");
+            return;
+        }
+
+        std::unique_ptr<OutOfBandPayload> payload = OutOfBandPayload::map(fds->back(), message.out_of_band().size());
+        fds->pop_back();
+        if (!payload || !message.ParseFromArray(payload->data(), static_cast<int>(payload->size())) ||
+            message.has_out_of_band())
+        {
+            RIALTO_IPC_LOG_ERROR("invalid out of band message from server");
+            return;
+        }
+    }
+
     // check if an event or a reply to a request
     if (message.has_reply())
     {
@@ -701,6 +916,10 @@ void ChannelImpl::processServerMessage(const uint8_t *data, size_t dataLen, std:
     {
         processEventFromServer(message.event(), fds);
     }
+    else if (message.has_shm_transport_ready())
+    {
+        processShmTransportReady(message.shm_transport_ready());
+    }
     else
     {
         RIALTO_IPC_LOG_ERROR("message from server is missing reply or event type");
@@ -720,6 +939,13 @@ void ChannelImpl::processReplyFromServer(const transport::MethodCallReply &reply
     MethodCall methodCall;
     const uint64_t kSerialId = reply.reply_id();
 
+    // m_connectionSetupSerialId is only written in the constructor
+    if (kSerialId == m_connectionSetupSerialId)
+    {
+        processConnectionSetupReply(reply.accept_method_ids(), reply.accept_out_of_band());
+        return;
+    }
+
     {
         std::lock_guard<std::mutex> locker(m_lock);
 
@@ -730,10 +956,13 @@ void ChannelImpl::processReplyFromServer(const transport::MethodCallReply &reply
             return;
         }
 
-        methodCall = it->second;
-        m_methodCalls.erase(it);
+        methodCall = takeMethodCallNoLock(it);
+    }
 
-        updateTimeoutTimer();
+    // the server has bound the names sent with this call to the method id
+    if (m_serverAcceptsMethodIds && methodCall.unboundMethod)
+    {
+        setMethodIdAnnounced(methodCall.unboundMethod);
     }
 
     if (!methodCall.response->ParseFromString(reply.reply_message()))
@@ -748,8 +977,12 @@ void ChannelImpl::processReplyFromServer(const transport::MethodCallReply &reply
     }
     else if (methodCall.closure)
     {
-        RIALTO_IPC_LOG_DEBUG("reply{ serial %" PRIu64 " } - %s { %s }", kSerialId,
-                             methodCall.response->GetTypeName().c_str(), methodCall.response->ShortDebugString().c_str());
+        if (RIALTO_IPC_IS_DEBUG_LOGGED())
+        {
+            RIALTO_IPC_LOG_DEBUG("reply{ serial %" PRIu64 " } - %s { %s }", kSerialId,
+                                 methodCall.response->GetTypeName().c_str(),
+                                 methodCall.response->ShortDebugString().c_str());
+        }
 
         complete(&methodCall);
     }
@@ -768,6 +1001,15 @@ void ChannelImpl::processErrorFromServer(const transport::MethodCallError &error
     MethodCall methodCall;
     const uint64_t kSerialId = error.reply_id();
 
+    // servers that predate the connection setup call reject it as a call to an unknown service
+    if (kSerialId == m_connectionSetupSerialId)
+    {
+        RIALTO_IPC_LOG_INFO("server doesn't support the connection setup (%s), using the original protocol",
+                            error.error_reason().c_str());
+        processConnectionSetupReply(false, false);
+        return;
+    }
+
     {
         std::unique_lock<std::mutex> locker(m_lock);
 
@@ -780,11 +1022,7 @@ void ChannelImpl::processErrorFromServer(const transport::MethodCallError &error
         }
 
         // take the method call and remove from the map of outstanding calls
-        methodCall = it->second;
-        m_methodCalls.erase(it);
-
-        // update the timeout timer now a method call has been processed
-        updateTimeoutTimer();
+        methodCall = takeMethodCallNoLock(it);
     }
 
     RIALTO_IPC_LOG_DEBUG("error{ serial %" PRIu64 " } - %s", kSerialId, error.error_reason().c_str());
@@ -793,6 +1031,89 @@ void ChannelImpl::processErrorFromServer(const transport::MethodCallError &error
     completeWithError(&methodCall, error.error_reason());
 }
 
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Handles the server's answer to the connection setup call, \a acceptMethodIds
+    and \a acceptOutOfBand are the optional features it supports.  The calls
+    made while waiting for it are now built for what the server accepts and
+    sent in the order they were made.
+
+    \note Must be called while holding the m_recvBufLock mutex.
+
+ */
+void ChannelImpl::processConnectionSetupReply(bool acceptMethodIds, bool acceptOutOfBand)
+{
+    RIALTO_IPC_LOG_DEBUG("connection setup, method ids %s, out of band %s", acceptMethodIds ? "accepted" : "refused",
+                         acceptOutOfBand ? "accepted" : "refused");
+
+    m_serverAcceptsMethodIds = acceptMethodIds;
+    m_serverAcceptsOutOfBand = acceptOutOfBand;
+
+    // a server that sends larger messages out of band sends nothing bigger than the threshold inline from now on
+    m_recvMessageSize = OutOfBandPayload::maxInlineSize(acceptOutOfBand);
+
+    std::vector<MethodCall> failedCalls;
+    std::vector<MethodCall> sentCalls;
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+
+        if (m_connectionSetUp)
+        {
+            RIALTO_IPC_LOG_WARN("duplicate reply to the connection setup");
+            return;
+        }
+        m_connectionSetUp = true;
+
+        for (AwaitingSetupCall &awaitingCall : m_callsAwaitingSetup)
+        {
+            // calls expecting a reply may have timed out while waiting
+            auto it = m_methodCalls.find(awaitingCall.serialId);
+            if (!awaitingCall.noReplyExpected && (it == m_methodCalls.end()))
+            {
+                continue;
+            }
+
+            std::vector<int> fds;
+            for (const FileDescriptor &fd : awaitingCall.fds)
+            {
+                fds.push_back(fd.fd());
+            }
+
+            std::string errorMessage;
+            FileDescriptor payloadFd;
+            std::shared_ptr<uint8_t> msgBuf = buildCallMessage(&awaitingCall.message, fds, &payloadFd, &errorMessage);
+            const auto *kHeader = reinterpret_cast<const msghdr *>(msgBuf.get());
+            const bool kSent = (m_sock >= 0) && msgBuf && sendMessageNoLock(kHeader, kHeader->msg_iov->iov_len);
+
+            if (awaitingCall.noReplyExpected)
+            {
+                if (kSent && awaitingCall.methodCall.unboundMethod)
+                {
+                    setMethodIdAnnounced(awaitingCall.methodCall.unboundMethod);
+                }
+                (kSent ? sentCalls : failedCalls).push_back(awaitingCall.methodCall);
+            }
+            else if (!kSent)
+            {
+                failedCalls.push_back(takeMethodCallNoLock(it));
+            }
+        }
+
+        m_callsAwaitingSetup.clear();
+    }
+
+    for (MethodCall &methodCall : failedCalls)
+    {
+        completeWithError(&methodCall, "Failed to send message");
+    }
+    for (MethodCall &methodCall : sentCalls)
+    {
+        complete(&methodCall);
+    }
+}
+
 // -----------------------------------------------------------------------------
 /*!
     \internal
@@ -803,10 +1124,35 @@ void ChannelImpl::processEventFromServer(const transport::EventFromServer &event
 {
     RIALTO_IPC_LOG_DEBUG("processing event from server");
 
-    const std::string &kEventName = event.event_name();
-
     std::lock_guard<std::mutex> locker(m_eventsLock);
 
+    // resolve the event name, events after the first of each type are only sent with an id
+    const std::string *eventName = &event.event_name();
+    if (event.has_event_id())
+    {
+        const uint32_t kEventId = event.event_id();
+        if (event.has_event_name())
+        {
+            if (kEventId < kMaxEventIds)
+            {
+                if (kEventId >= m_eventNames.size())
+                    m_eventNames.resize(kEventId + 1);
+                m_eventNames[kEventId] = event.event_name();
+            }
+        }
+        else if ((kEventId >= m_eventNames.size()) || m_eventNames[kEventId].empty())
+        {
+            RIALTO_IPC_LOG_ERROR("received unknown event id %u", kEventId);
+            return;
+        }
+        else
+        {
+            eventName = &m_eventNames[kEventId];
+        }
+    }
+
+    const std::string &kEventName = *eventName;
+
     auto range = m_eventHandlers.equal_range(kEventName);
     if (range.first == range.second)
     {
@@ -841,8 +1187,11 @@ void ChannelImpl::processEventFromServer(const transport::EventFromServer &event
     }
     else
     {
-        RIALTO_IPC_LOG_DEBUG("event{ %s } - %s { %s }", kEventName.c_str(), message->GetTypeName().c_str(),
-                             message->ShortDebugString().c_str());
+        if (RIALTO_IPC_IS_DEBUG_LOGGED())
+        {
+            RIALTO_IPC_LOG_DEBUG("event{ %s } - %s { %s }", kEventName.c_str(), message->GetTypeName().c_str(),
+                                 message->ShortDebugString().c_str());
+        }
 
         for (auto it = range.first; it != range.second; ++it)
         {
@@ -851,6 +1200,56 @@ void ChannelImpl::processEventFromServer(const transport::EventFromServer &event
     }
 }
 
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Processes the server's reply to the shared memory transport setup message.
+    If accepted then the server may put any message it sends after this one on
+    the shared memory ring, and we can start doing the same.
+
+    \note Must be called while holding the m_recvBufLock mutex.
+
+ */
+void ChannelImpl::processShmTransportReady(const transport::SharedMemoryTransportReady &ready)
+{
+    std::shared_ptr<ShmTransport> shmTransport;
+    {
+        std::lock_guard<std::mutex> locker(m_lock);
+
+        shmTransport = m_shmTransport;
+        if (!ready.accepted())
+            m_shmTransport.reset();
+        else if (shmTransport)
+            m_shmTxEnabled = true;
+    }
+
+    if (!shmTransport || m_shmRxTransport)
+    {
+        RIALTO_IPC_LOG_ERROR("unexpected shared memory transport reply from server");
+        return;
+    }
+    if (!ready.accepted())
+    {
+        RIALTO_IPC_LOG_WARN("server declined the shared memory transport, using the socket");
+        return;
+    }
+
+    epoll_event doorbellEvent = {.events = EPOLLIN, .data = {.fd = shmTransport->rxDoorbellFd()}};
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, shmTransport->rxDoorbellFd(), &doorbellEvent) != 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_ctl failed to add shared memory doorbell");
+    }
+
+    // the server counts its socket messages from this one
+    m_socketRecvCount = 0;
+    m_shmRxTransport = std::move(shmTransport);
+    m_shmDoorbellFd = m_shmRxTransport->rxDoorbellFd();
+    m_shmRxEnabled = true;
+
+    RIALTO_IPC_LOG_INFO("using shared memory transport");
+}
+
 // -----------------------------------------------------------------------------
 /*!
     \internal
@@ -1081,8 +1480,8 @@ void ChannelImpl::CallMethod(const google::protobuf::MethodDescriptor *method, /
                              google::protobuf::RpcController *controller, const google::protobuf::Message *request,
                              google::protobuf::Message *response, google::protobuf::Closure *done)
 {
-    MethodCall methodCall{std::chrono::steady_clock::now() + m_timeout,
-                          dynamic_cast<ClientControllerImpl *>(controller), response, done};
+    MethodCall methodCall{std::chrono::steady_clock::time_point(), dynamic_cast<ClientControllerImpl *>(controller),
+                          response, done};
 
     //
     const uint64_t kSerialId = m_serialCounter++;
@@ -1091,72 +1490,73 @@ void ChannelImpl::CallMethod(const google::protobuf::MethodDescriptor *method, /
     transport::MessageToServer message;
     transport::MethodCall *call = message.mutable_call();
     call->set_serial_id(kSerialId);
-    call->set_service_name(method->service()->full_name());
-    call->set_method_name(method->name());
+
+    // once the server has seen the names bound to the id, and told us it understands ids, only send the id
+    bool sendNames = true;
+    {
+        std::lock_guard<std::mutex> locker(m_methodIdsLock);
+        auto it = m_methodIds.find(method);
+        if (it == m_methodIds.end())
+        {
+            const MethodId kMethodId{static_cast<uint32_t>(m_methodIds.size()), false, getMethodTimeout(method)};
+            it = m_methodIds.emplace(method, kMethodId).first;
+        }
+        call->set_method_id(it->second.id);
+        methodCall.timeoutDeadline = std::chrono::steady_clock::now() + it->second.timeout;
+        sendNames = !it->second.announced || !m_serverAcceptsMethodIds;
+    }
+    if (sendNames)
+    {
+        call->set_service_name(method->service()->full_name());
+        call->set_method_name(method->name());
+        methodCall.unboundMethod = method;
+    }
 
     // copy in the actual message data
     std::string reqString = request->SerializeAsString();
     call->set_request_message(std::move(reqString));
 
-    const size_t kRequiredDataLen = message.ByteSizeLong();
-    if (kRequiredDataLen > kMaxMessageSize)
-    {
-        RIALTO_IPC_LOG_ERROR("method call to big to send (%zu, max %zu", kRequiredDataLen, kMaxMessageSize);
-        completeWithError(&methodCall, "Method call to big");
-        return;
-    }
-
     // extract the fds from the message
-    const std::vector<int> kFds = getMessageFds(*request);
-    const size_t kRequiredCtrlLen = kFds.empty() ? 0 : CMSG_SPACE(sizeof(int) * kFds.size());
-
-    // build the socket message to send
-    auto msgBuf =
-        m_sendBufPool.allocateShared<uint8_t>(sizeof(msghdr) + sizeof(iovec) + kRequiredCtrlLen + kRequiredDataLen);
-
-    auto *header = reinterpret_cast<msghdr *>(msgBuf.get());
-    bzero(header, sizeof(msghdr));
-
-    auto *ctrl = reinterpret_cast<uint8_t *>(msgBuf.get() + sizeof(msghdr));
-    header->msg_control = ctrl;
-    header->msg_controllen = kRequiredCtrlLen;
+    std::vector<int> fds = getMessageFds(*request);
 
-    auto *iov = reinterpret_cast<iovec *>(msgBuf.get() + sizeof(msghdr) + kRequiredCtrlLen);
-    header->msg_iov = iov;
-    header->msg_iovlen = 1;
-
-    auto *data = reinterpret_cast<uint8_t *>(msgBuf.get() + sizeof(msghdr) + kRequiredCtrlLen + sizeof(iovec));
-    iov->iov_base = data;
-    iov->iov_len = kRequiredDataLen;
-
-    // copy in the data
-    message.SerializeWithCachedSizesToArray(data);
+    // check if the method is expecting a reply
+    const bool kNoReplyExpected = method->options().HasExtension(::firebolt::rialto::ipc::no_reply) &&
+                                  method->options().GetExtension(::firebolt::rialto::ipc::no_reply);
 
-    // next check if the request is sending any fd's
-    if (!kFds.empty())
+    // until the server has answered the connection setup we don't know how big a message it takes inline, so the
+    // call is held, in order with any others, and sent once it has, see processConnectionSetupReply()
     {
-        struct cmsghdr *cmsg = CMSG_FIRSTHDR(header);
-        if (!cmsg)
+        std::lock_guard<std::mutex> locker(m_lock);
+
+        if ((m_sock >= 0) && !m_connectionSetUp)
         {
-            RIALTO_IPC_LOG_ERROR("odd, failed to get the first cmsg header");
-            completeWithError(&methodCall, "Internal error");
+            AwaitingSetupCall awaitingCall{kSerialId, std::move(message), {}, kNoReplyExpected, methodCall};
+            for (int fd : fds)
+            {
+                awaitingCall.fds.emplace_back(fd);
+            }
+            if (!kNoReplyExpected)
+            {
+                addMethodCallNoLock(kSerialId, methodCall);
+            }
+            m_callsAwaitingSetup.emplace_back(std::move(awaitingCall));
             return;
         }
+    }
 
-        cmsg->cmsg_level = SOL_SOCKET;
-        cmsg->cmsg_type = SCM_RIGHTS;
-        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * kFds.size());
-        memcpy(CMSG_DATA(cmsg), kFds.data(), sizeof(int) * kFds.size());
-        header->msg_controllen = cmsg->cmsg_len;
+    std::string errorMessage;
+    FileDescriptor payloadFd;
+    std::shared_ptr<uint8_t> msgBuf = buildCallMessage(&message, fds, &payloadFd, &errorMessage);
+    if (!msgBuf)
+    {
+        completeWithError(&methodCall, std::move(errorMessage));
+        return;
     }
 
-    // check if the method is expecting a reply
-    const bool kNoReplyExpected = method->options().HasExtension(::firebolt::rialto::ipc::no_reply) &&
-                                  method->options().GetExtension(::firebolt::rialto::ipc::no_reply);
+    const auto *kHeader = reinterpret_cast<const msghdr *>(msgBuf.get());
 
     // finally, send the message
     google::protobuf::Closure *doneClosure = nullptr;
-    std::string errorMessage; // Capture error state
     {
         std::unique_lock<std::mutex> locker(m_lock);
 
@@ -1164,17 +1564,27 @@ void ChannelImpl::CallMethod(const google::protobuf::MethodDescriptor *method, /
         {
             errorMessage = "Not connected";
         }
-        else if (sendmsg(m_sock, header, MSG_NOSIGNAL) != static_cast<ssize_t>(kRequiredDataLen))
+        else if (!sendMessageNoLock(kHeader, kHeader->msg_iov->iov_len))
         {
             errorMessage = "Failed to send message";
         }
         else
         {
-            RIALTO_IPC_LOG_DEBUG("call{ serial %" PRIu64 " } - %s.%s { %s }", kSerialId, call->service_name().c_str(),
-                                 call->method_name().c_str(), request->ShortDebugString().c_str());
+            if (RIALTO_IPC_IS_DEBUG_LOGGED())
+            {
+                RIALTO_IPC_LOG_DEBUG("call{ serial %" PRIu64 " } - %s { %s }", kSerialId, method->full_name().c_str(),
+                                     request->ShortDebugString().c_str());
+            }
 
             if (kNoReplyExpected)
             {
+                // there is no reply to confirm the binding, however the names are now on the socket ahead
+                // of any later call so those can be sent with just the id
+                if (methodCall.unboundMethod)
+                {
+                    setMethodIdAnnounced(methodCall.unboundMethod);
+                }
+
                 // no reply from server is expected, however if the caller supplied
                 // a closure (it shouldn't) we should still call it now to indicate
                 // the method call has been made
@@ -1182,11 +1592,8 @@ void ChannelImpl::CallMethod(const google::protobuf::MethodDescriptor *method, /
             }
             else
             {
-                // add the message to the queue so we pick-up the reply
-                m_methodCalls.emplace(kSerialId, methodCall);
-
-                // update the single timeout timer
-                updateTimeoutTimer();
+                // add the message to the queue so we pick-up the reply, or time it out
+                addMethodCallNoLock(kSerialId, methodCall);
             }
         }
     }
@@ -1206,6 +1613,265 @@ void ChannelImpl::CallMethod(const google::protobuf::MethodDescriptor *method, /
     }
 }
 
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Builds the socket message for the call in \a message, with the \a fds of the
+    request attached.  If the server takes messages out of band and the call is
+    too big to send inline it is moved to a memfd returned in \a payloadFd, which
+    must be kept open until the message is sent.
+
+    The msghdr is at the start of the returned buffer, on failure null is
+    returned and \a error says why.
+
+ */
+std::shared_ptr<uint8_t> ChannelImpl::buildCallMessage(transport::MessageToServer *message,
+                                                       const std::vector<int> &fds, FileDescriptor *payloadFd,
+                                                       std::string *error) const
+{
+    // servers that haven't said they can receive messages out of band get everything inline
+    const bool kOutOfBandAccepted = m_serverAcceptsOutOfBand;
+    const size_t kMessageLen = message->ByteSizeLong();
+    if (kMessageLen > OutOfBandPayload::maxMessageSize(kOutOfBandAccepted))
+    {
+        RIALTO_IPC_LOG_ERROR("method call to big to send (%zu, max %zu", kMessageLen,
+                             OutOfBandPayload::maxMessageSize(kOutOfBandAccepted));
+        *error = "Method call to big";
+        return nullptr;
+    }
+
+    // a message too big to send inline is written to a memfd, which is sent after the message's own fds
+    std::vector<int> allFds = fds;
+    if (kMessageLen > OutOfBandPayload::maxInlineSize(kOutOfBandAccepted))
+    {
+        *payloadFd = OutOfBandPayload::create(kMessageLen, [message](uint8_t *payload)
+                                              { message->SerializeWithCachedSizesToArray(payload); });
+        if (!payloadFd->isValid())
+        {
+            *error = "Failed to create out of band payload";
+            return nullptr;
+        }
+
+        message->Clear();
+        message->mutable_out_of_band()->set_size(kMessageLen);
+        allFds.push_back(payloadFd->fd());
+    }
+
+    const size_t kRequiredDataLen = payloadFd->isValid() ? message->ByteSizeLong() : kMessageLen;
+    const size_t kRequiredCtrlLen = allFds.empty() ? 0 : CMSG_SPACE(sizeof(int) * allFds.size());
+
+    // build the socket message to send
+    auto msgBuf = SlabAllocator::instance().allocateShared<uint8_t>(sizeof(msghdr) + sizeof(iovec) + kRequiredCtrlLen +
+                                                                    kRequiredDataLen);
+
+    auto *header = reinterpret_cast<msghdr *>(msgBuf.get());
+    bzero(header, sizeof(msghdr));
+
+    auto *ctrl = reinterpret_cast<uint8_t *>(msgBuf.get() + sizeof(msghdr));
+    header->msg_control = ctrl;
+    header->msg_controllen = kRequiredCtrlLen;
+
+    auto *iov = reinterpret_cast<iovec *>(msgBuf.get() + sizeof(msghdr) + kRequiredCtrlLen);
+    header->msg_iov = iov;
+    header->msg_iovlen = 1;
+
+    auto *data = reinterpret_cast<uint8_t *>(msgBuf.get() + sizeof(msghdr) + kRequiredCtrlLen + sizeof(iovec));
+    iov->iov_base = data;
+    iov->iov_len = kRequiredDataLen;
+
+    // copy in the data
+    message->SerializeWithCachedSizesToArray(data);
+
+    // next check if the request is sending any fd's
+    if (!allFds.empty())
+    {
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(header);
+        if (!cmsg)
+        {
+            RIALTO_IPC_LOG_ERROR("odd, failed to get the first cmsg header");
+            *error = "Internal error";
+            return nullptr;
+        }
+
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * allFds.size());
+        memcpy(CMSG_DATA(cmsg), allFds.data(), sizeof(int) * allFds.size());
+        header->msg_controllen = cmsg->cmsg_len;
+    }
+
+    return msgBuf;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Sends a message to the server.  If the shared memory transport is enabled
+    and the message carries no fds then it is put on the shared memory ring,
+    tagged with the number of socket messages sent so far so the server can
+    process it in the right order relative to those.  If the ring is full, or
+    the message is too big for it, the socket is used.
+
+    \note Must be called while holding the m_lock mutex.
+
+ */
+bool ChannelImpl::sendMessageNoLock(const struct msghdr *header, size_t dataLen)
+{
+    if (m_shmTxEnabled && (header->msg_controllen == 0) &&
+        m_shmTransport->send(m_socketSendCount, header->msg_iov->iov_base, dataLen))
+    {
+        return true;
+    }
+
+    if (sendmsg(m_sock, header, MSG_NOSIGNAL) != static_cast<ssize_t>(dataLen))
+    {
+        return false;
+    }
+
+    m_socketSendCount++;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Sends the connection setup call, a call with no service or method, which
+    the server answers with the optional features it supports.  Calls made
+    before the answer arrives are held until it does, see
+    processConnectionSetupReply().
+
+ */
+bool ChannelImpl::sendConnectionSetup()
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+
+    m_connectionSetupSerialId = m_serialCounter++;
+
+    transport::MessageToServer message;
+    transport::MethodCall *call = message.mutable_call();
+    call->set_serial_id(m_connectionSetupSerialId);
+    call->set_accept_event_ids(true);
+    call->set_accept_out_of_band(true);
+    std::string data = message.SerializeAsString();
+
+    struct iovec iov = {.iov_base = data.data(), .iov_len = data.size()};
+    struct msghdr header = {nullptr};
+    header.msg_iov = &iov;
+    header.msg_iovlen = 1;
+
+    if (!sendMessageNoLock(&header, data.size()))
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send the connection setup");
+        return false;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \threadsafe
+
+    Creates the shared memory transport and sends the setup message to the
+    server.  The channel continues to only use the socket until the server
+    replies, see processShmTransportReady().
+
+ */
+bool ChannelImpl::enableSharedMemoryTransport()
+{
+    std::lock_guard<std::mutex> locker(m_lock);
+
+    if (m_sock < 0)
+    {
+        RIALTO_IPC_LOG_ERROR("not connected");
+        return false;
+    }
+    if (m_shmTransport)
+    {
+        return true;
+    }
+
+    std::shared_ptr<ShmTransport> shmTransport = ShmTransport::create();
+    if (!shmTransport)
+    {
+        RIALTO_IPC_LOG_ERROR("failed to create the shared memory transport");
+        return false;
+    }
+
+    transport::MessageToServer message;
+    message.mutable_shm_transport_setup()->set_ring_capacity(static_cast<uint32_t>(shmTransport->ringCapacity()));
+    std::string data = message.SerializeAsString();
+
+    // the memfd and the two doorbells are passed with the message
+    const int kFds[3] = {shmTransport->memFd(), shmTransport->txDoorbellFd(), shmTransport->rxDoorbellFd()};
+    uint8_t ctrl[CMSG_SPACE(sizeof(kFds))] = {0};
+
+    struct iovec iov = {.iov_base = data.data(), .iov_len = data.size()};
+    struct msghdr header = {nullptr};
+    header.msg_iov = &iov;
+    header.msg_iovlen = 1;
+    header.msg_control = ctrl;
+    header.msg_controllen = sizeof(ctrl);
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&header);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(kFds));
+    memcpy(CMSG_DATA(cmsg), kFds, sizeof(kFds));
+
+    if (sendmsg(m_sock, &header, MSG_NOSIGNAL) != static_cast<ssize_t>(data.size()))
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send shared memory transport setup");
+        return false;
+    }
+
+    // the server counts our socket messages from the one after the setup message
+    m_shmTransport = std::move(shmTransport);
+    m_socketSendCount = 0;
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \threadsafe
+
+    Marks the \a method as bound on the server, subsequent calls to it are sent
+    with just the method id rather than the service and method names.
+
+ */
+void ChannelImpl::setMethodIdAnnounced(const google::protobuf::MethodDescriptor *method)
+{
+    std::lock_guard<std::mutex> locker(m_methodIdsLock);
+    auto it = m_methodIds.find(method);
+    if (it != m_methodIds.end())
+    {
+        it->second.announced = true;
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Returns the timeout of calls to \a method, set with the timeout_ms option
+    in its proto definition, otherwise the timeout of the channel.
+
+ */
+std::chrono::milliseconds ChannelImpl::getMethodTimeout(const google::protobuf::MethodDescriptor *method) const
+{
+    if (method->options().HasExtension(::firebolt::rialto::ipc::timeout_ms))
+    {
+        return std::chrono::milliseconds{method->options().GetExtension(::firebolt::rialto::ipc::timeout_ms)};
+    }
+
+    return m_timeout;
+}
+
 int ChannelImpl::subscribeImpl(const std::string &kEventName, const google::protobuf::Descriptor *descriptor,
                                EventHandler &&handler)
 {
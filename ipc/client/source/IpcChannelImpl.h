@@ -23,7 +23,8 @@
 #include "FileDescriptor.h"
 #include "IIpcChannel.h"
 #include "IpcClientControllerImpl.h"
-#include "SimpleBufferPool.h"
+#include "ShmTransport.h"
+#include "SlabAllocator.h"
 
 #include "rialtoipc-transport.pb.h"
 #include <google/protobuf/service.h>
@@ -34,7 +35,9 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <sys/socket.h>
@@ -65,6 +68,7 @@ public:
     bool wait(int timeoutMSecs) override;
     bool process() override;
     bool unsubscribe(int eventTag) override;
+    bool enableSharedMemoryTransport() override;
 
     void CallMethod(const google::protobuf::MethodDescriptor *method, google::protobuf::RpcController *controller,
                     const google::protobuf::Message *request, google::protobuf::Message *response,
@@ -81,6 +85,15 @@ private:
     bool processSocketEvent();
     void processTimeoutEvent();
     void processWakeEvent();
+    void processShmMessages();
+    bool hasDeliverableShmMessage();
+    bool spinForShmMessage();
+
+    bool sendMessageNoLock(const struct msghdr *header, size_t dataLen);
+    bool sendConnectionSetup();
+    std::shared_ptr<uint8_t> buildCallMessage(::firebolt::rialto::ipc::transport::MessageToServer *message,
+                                              const std::vector<int> &fds, FileDescriptor *payloadFd,
+                                              std::string *error) const;
 
     void processServerMessage(const uint8_t *data, size_t len, std::vector<FileDescriptor> *fds);
     void processReplyFromServer(const ::firebolt::rialto::ipc::transport::MethodCallReply &reply,
@@ -88,6 +101,8 @@ private:
     void processErrorFromServer(const ::firebolt::rialto::ipc::transport::MethodCallError &error);
     void processEventFromServer(const ::firebolt::rialto::ipc::transport::EventFromServer &event,
                                 std::vector<FileDescriptor> *fds);
+    void processShmTransportReady(const ::firebolt::rialto::ipc::transport::SharedMemoryTransportReady &ready);
+    void processConnectionSetupReply(bool acceptMethodIds, bool acceptOutOfBand);
 
     bool createConnectedSocket(const std::string &socketPath);
     bool attachSocket(int sockFd);
@@ -106,9 +121,15 @@ private:
         ClientControllerImpl *controller = nullptr;
         google::protobuf::Message *response = nullptr;
         google::protobuf::Closure *closure = nullptr;
+        const google::protobuf::MethodDescriptor *unboundMethod = nullptr;
     };
 
+    void addMethodCallNoLock(uint64_t serialId, const MethodCall &methodCall);
+    MethodCall takeMethodCallNoLock(std::map<uint64_t, MethodCall>::iterator it);
     void updateTimeoutTimer();
+    std::chrono::milliseconds getMethodTimeout(const google::protobuf::MethodDescriptor *method) const;
+
+    void setMethodIdAnnounced(const google::protobuf::MethodDescriptor *method);
 
     static void complete(MethodCall *call);
     static void completeWithError(MethodCall *call, std::string reason);
@@ -119,7 +140,14 @@ private:
     int m_timerFd;
     int m_eventFd;
 
-    SimpleBufferPool m_sendBufPool;
+    // each of the batch of receive buffers holds the largest message the server sends inline, which is the old
+    // inline limit until the connection setup is answered.  m_recvMessageSize is what the setup agreed and
+    // m_recvDataBufMessageSize what the buffers are currently sized for, they are resized between batches
+    std::mutex m_recvBufLock;
+    std::unique_ptr<uint8_t[]> m_recvDataBuf;
+    size_t m_recvDataBufMessageSize;
+    size_t m_recvMessageSize;
+    std::vector<uint8_t> m_recvCtrlBuf;
 
     mutable std::mutex m_lock;
     std::atomic<uint64_t> m_serialCounter;
@@ -128,6 +156,38 @@ private:
 
     std::map<uint64_t, MethodCall> m_methodCalls;
 
+    // the outstanding method calls ordered by deadline, the timerfd is armed for m_timerDeadline which may be earlier
+    // than the first deadline if that call has since completed
+    std::set<std::pair<std::chrono::steady_clock::time_point, uint64_t>> m_deadlines;
+    std::chrono::steady_clock::time_point m_timerDeadline = std::chrono::steady_clock::time_point::max();
+
+    struct MethodId
+    {
+        uint32_t id;
+        bool announced;
+        std::chrono::milliseconds timeout;
+    };
+
+    // calls made before the server has answered the connection setup call are held in order and sent once it
+    // has, so that they are sized for what it accepts.  Guarded by m_lock
+    struct AwaitingSetupCall
+    {
+        uint64_t serialId;
+        ::firebolt::rialto::ipc::transport::MessageToServer message;
+        std::vector<FileDescriptor> fds;
+        bool noReplyExpected;
+        MethodCall methodCall;
+    };
+
+    uint64_t m_connectionSetupSerialId = 0;
+    bool m_connectionSetUp = false;
+    std::vector<AwaitingSetupCall> m_callsAwaitingSetup;
+
+    std::mutex m_methodIdsLock;
+    std::atomic<bool> m_serverAcceptsMethodIds{false};
+    std::atomic<bool> m_serverAcceptsOutOfBand{false};
+    std::map<const google::protobuf::MethodDescriptor *, MethodId> m_methodIds;
+
     std::mutex m_eventsLock;
 
     int m_eventTagCounter;
@@ -140,6 +200,24 @@ private:
     };
 
     std::multimap<std::string, Event> m_eventHandlers;
+
+    // event names indexed by the server assigned event id
+    std::vector<std::string> m_eventNames;
+
+    // shared memory transport, the send side is protected by m_lock and the receive side by m_recvBufLock.
+    // Messages on the rings are tagged with the number of socket messages the sender had sent at the time,
+    // the receiver only processes a ring message once it has seen that many socket messages
+    std::shared_ptr<ShmTransport> m_shmTransport;
+    bool m_shmTxEnabled = false;
+    uint64_t m_socketSendCount = 0;
+
+    std::shared_ptr<ShmTransport> m_shmRxTransport;
+    std::atomic<bool> m_shmRxEnabled{false};
+    std::atomic<int> m_shmDoorbellFd{-1};
+    uint64_t m_socketRecvCount = 0;
+
+    // how long wait() spins on the receive ring before blocking, adapted to how often spinning succeeds
+    std::atomic<int64_t> m_shmSpinNs;
 };
 
 } // namespace firebolt::rialto::ipc
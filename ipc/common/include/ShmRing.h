@@ -0,0 +1,97 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_IPC_SHM_RING_H_
+#define FIREBOLT_RIALTO_IPC_SHM_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// -----------------------------------------------------------------------------
+/*!
+    \class ShmRing
+    \brief Lock-free single-producer / single-consumer ring of variable length
+    records, laid out in a block of (possibly shared) memory.
+
+    The ring doesn't own the memory, it is just a view onto a region of
+    ShmRing::regionSize() bytes that is typically mapped in two processes.  One
+    side must only ever write to the ring and the other only ever read from it.
+
+    Each record carries a 64-bit tag alongside the payload, the ring itself
+    doesn't interpret it.  Records are never split, if a record doesn't fit in
+    the space up to the end of the buffer a padding record is inserted and the
+    record is written at the start.
+
+    The ring also holds a 'consumer waiting' flag the consumer sets before it
+    blocks, the producer should signal the consumer (typically via an eventfd)
+    if the flag was set when it publishes a record.
+
+    Because the peer has write access to the shared indices, all values read
+    from the shared header are sanity checked before use.
+
+    It backs the IPC shared memory transport, one ring per direction carries
+    the serialised messages that would otherwise be written to the socket.
+*/
+
+namespace firebolt::rialto::ipc
+{
+class ShmRing
+{
+public:
+    ShmRing() = default;
+    ~ShmRing() = default;
+    ShmRing(const ShmRing &) = delete;
+    ShmRing &operator=(const ShmRing &) = delete;
+
+    static size_t regionSize(size_t capacity);
+
+    bool init(void *region, size_t capacity);
+    bool attach(void *region, size_t capacity);
+
+    size_t maxRecordSize() const;
+
+    // producer side
+    bool write(uint64_t tag, const void *data, size_t length);
+    bool write(uint64_t tag, const void *header, size_t headerLength, const void *data, size_t length);
+    bool clearConsumerWaiting();
+
+    // consumer side
+    bool peek(uint64_t *tag, const uint8_t **data, size_t *length);
+    void consume();
+    bool empty() const;
+    bool setConsumerWaiting(bool waiting);
+
+private:
+    struct Header;
+    struct Record;
+
+    static size_t recordSize(size_t length);
+
+    Header *m_header = nullptr;
+    uint8_t *m_buffer = nullptr;
+    uint64_t m_capacity = 0;
+
+    // size of the record returned by the last peek(), only used by the consumer
+    uint64_t m_peekedSize = 0;
+};
+
+} // namespace firebolt::rialto::ipc
+
+#endif // FIREBOLT_RIALTO_IPC_SHM_RING_H_
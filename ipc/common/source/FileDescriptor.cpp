@@ -48,6 +48,11 @@ FileDescriptor::FileDescriptor(const FileDescriptor &other) : m_fd(-1)
     }
 }
 
+FileDescriptor::FileDescriptor(FileDescriptor &&other) noexcept : m_fd(other.m_fd)
+{
+    other.m_fd = -1;
+}
+
 FileDescriptor &FileDescriptor::operator=(FileDescriptor &&other) noexcept
 {
     if ((m_fd >= 0) && (::close(m_fd) != 0))
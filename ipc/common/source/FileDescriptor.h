@@ -44,6 +44,7 @@ public:
     FileDescriptor();
     explicit FileDescriptor(int fd);
     FileDescriptor(const FileDescriptor &other);
+    FileDescriptor(FileDescriptor &&other) noexcept;
     FileDescriptor &operator=(FileDescriptor &&other) noexcept;
     FileDescriptor &operator=(const FileDescriptor &other);
     ~FileDescriptor();
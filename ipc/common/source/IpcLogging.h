@@ -37,6 +37,15 @@ extern "C"
 #define RIALTO_IPC_LOG_INFO(fmt, args...) RIALTO_LOG_INFO(RIALTO_COMPONENT_IPC, fmt, ##args)
 #define RIALTO_IPC_LOG_DEBUG(fmt, args...) RIALTO_LOG_DEBUG(RIALTO_COMPONENT_IPC, fmt, ##args)
 
+// true if IPC debug logs are output, so that building message dumps which would be dropped can be skipped
+#ifdef RIALTO_LOG_DEBUG_ENABLED
+#define RIALTO_IPC_IS_DEBUG_LOGGED()                                                                                   \
+    ((firebolt::rialto::logging::getLogLevels(RIALTO_COMPONENT_IPC) &                                                  \
+      (RIALTO_DEBUG_LEVEL_DEBUG | RIALTO_DEBUG_LEVEL_EXTERNAL)) != 0)
+#else
+#define RIALTO_IPC_IS_DEBUG_LOGGED() (false)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,174 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <syscall.h>
+#include <unistd.h>
+
+#include "IpcLogging.h"
+#include "OutOfBandPayload.h"
+
+#if !defined(SYS_memfd_create)
+#if defined(__NR_memfd_create)
+#define SYS_memfd_create __NR_memfd_create
+#elif defined(__arm__)
+#define SYS_memfd_create 385
+#endif
+#endif
+
+#if !defined(MFD_CLOEXEC)
+#define MFD_CLOEXEC 0x0001U
+#endif
+
+#if !defined(MFD_ALLOW_SEALING)
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+
+#if !defined(F_ADD_SEALS)
+#if !defined(F_LINUX_SPECIFIC_BASE)
+#define F_LINUX_SPECIFIC_BASE 1024
+#endif
+#define F_ADD_SEALS (F_LINUX_SPECIFIC_BASE + 9)
+#define F_GET_SEALS (F_LINUX_SPECIFIC_BASE + 10)
+
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#define F_SEAL_WRITE 0x0008
+#endif
+
+namespace
+{
+constexpr int kRequiredSeals{F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE};
+} // namespace
+
+namespace firebolt::rialto::ipc
+{
+OutOfBandPayload::~OutOfBandPayload()
+{
+    if (munmap(const_cast<uint8_t *>(m_mapping), m_size) != 0)
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to unmap out of band payload");
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \static
+
+    Creates a memfd of \a size bytes, calls \a writer to fill it and then seals
+    it.  The writer is given a mapping of the memfd, so the message can be
+    serialised straight into it.
+
+    Returns an invalid FileDescriptor on failure.
+
+ */
+FileDescriptor OutOfBandPayload::create(size_t size, const std::function<void(uint8_t *data)> &writer)
+{
+    if ((size == 0) || (size > kMaxPayloadSize))
+    {
+        RIALTO_IPC_LOG_ERROR("invalid out of band payload size %zu", size);
+        return FileDescriptor();
+    }
+
+    const int kFd = static_cast<int>(syscall(SYS_memfd_create, "rialto-ipc-payload", MFD_CLOEXEC | MFD_ALLOW_SEALING));
+    if (kFd < 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to create memfd for out of band payload");
+        return FileDescriptor();
+    }
+
+    FileDescriptor memFd(kFd);
+    if (close(kFd) != 0)
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to close fd");
+
+    if (ftruncate(memFd.fd(), static_cast<off_t>(size)) != 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to size memfd for out of band payload");
+        return FileDescriptor();
+    }
+
+    void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, memFd.fd(), 0);
+    if (mapping == MAP_FAILED)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to map out of band payload");
+        return FileDescriptor();
+    }
+
+    writer(reinterpret_cast<uint8_t *>(mapping));
+
+    // the write seal can only be added once there are no writable mappings
+    if (munmap(mapping, size) != 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to unmap out of band payload");
+        return FileDescriptor();
+    }
+    if (fcntl(memFd.fd(), F_ADD_SEALS, kRequiredSeals | F_SEAL_SEAL) != 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to seal out of band payload");
+        return FileDescriptor();
+    }
+
+    return memFd;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \static
+
+    Maps a payload received from the peer.  The memfd is not trusted, it must
+    be sealed against writes and resizing, so it can't change while it is
+    parsed, and hold at least \a size bytes.
+
+ */
+std::unique_ptr<OutOfBandPayload> OutOfBandPayload::map(const FileDescriptor &memFd, size_t size)
+{
+    if ((size == 0) || (size > kMaxPayloadSize))
+    {
+        RIALTO_IPC_LOG_ERROR("invalid out of band payload size %zu", size);
+        return nullptr;
+    }
+
+    const int kSeals = fcntl(memFd.fd(), F_GET_SEALS);
+    if ((kSeals < 0) || ((kSeals & kRequiredSeals) != kRequiredSeals))
+    {
+        RIALTO_IPC_LOG_ERROR("out of band payload is not sealed");
+        return nullptr;
+    }
+
+    struct stat details = {};
+    if ((fstat(memFd.fd(), &details) != 0) || (static_cast<size_t>(details.st_size) < size))
+    {
+        RIALTO_IPC_LOG_ERROR("out of band payload is too small");
+        return nullptr;
+    }
+
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, memFd.fd(), 0);
+    if (mapping == MAP_FAILED)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to map out of band payload");
+        return nullptr;
+    }
+
+    return std::unique_ptr<OutOfBandPayload>(new OutOfBandPayload(reinterpret_cast<const uint8_t *>(mapping), size));
+}
+
+} // namespace firebolt::rialto::ipc
@@ -0,0 +1,84 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_IPC_OUT_OF_BAND_PAYLOAD_H_
+#define FIREBOLT_RIALTO_IPC_OUT_OF_BAND_PAYLOAD_H_
+
+#include "FileDescriptor.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+// -----------------------------------------------------------------------------
+/*!
+    \class OutOfBandPayload
+    \brief A message too big to send inline on the socket, held in a sealed
+    memfd that is passed to the peer instead.
+
+    The sender writes the message into a new memfd and seals it against any
+    further writes or resizing before sending it, so the receiver can map it
+    read-only and parse it in place without the sender being able to change
+    it underneath.
+
+    Only peers that have advertised support are sent messages out of band,
+    in which case messages over kOutOfBandThreshold are.  Older peers are sent
+    messages up to kMaxInlineMessageSize inline as before, so that is what the
+    receive buffers need to hold.
+*/
+
+namespace firebolt::rialto::ipc
+{
+class OutOfBandPayload
+{
+public:
+    ~OutOfBandPayload();
+    OutOfBandPayload(const OutOfBandPayload &) = delete;
+    OutOfBandPayload &operator=(const OutOfBandPayload &) = delete;
+
+    static constexpr size_t kMaxInlineMessageSize{128 * 1024};
+    static constexpr size_t kOutOfBandThreshold{64 * 1024};
+    static constexpr size_t kMaxPayloadSize{16 * 1024 * 1024};
+
+    static constexpr size_t maxMessageSize(bool peerAcceptsOutOfBand)
+    {
+        return peerAcceptsOutOfBand ? kMaxPayloadSize : kMaxInlineMessageSize;
+    }
+    static constexpr size_t maxInlineSize(bool peerAcceptsOutOfBand)
+    {
+        return peerAcceptsOutOfBand ? kOutOfBandThreshold : kMaxInlineMessageSize;
+    }
+
+    static FileDescriptor create(size_t size, const std::function<void(uint8_t *data)> &writer);
+    static std::unique_ptr<OutOfBandPayload> map(const FileDescriptor &memFd, size_t size);
+
+    const uint8_t *data() const { return m_mapping; }
+    size_t size() const { return m_size; }
+
+private:
+    OutOfBandPayload(const uint8_t *mapping, size_t size) : m_mapping(mapping), m_size(size) {}
+
+    const uint8_t *const m_mapping;
+    const size_t m_size;
+};
+
+} // namespace firebolt::rialto::ipc
+
+#endif // FIREBOLT_RIALTO_IPC_OUT_OF_BAND_PAYLOAD_H_
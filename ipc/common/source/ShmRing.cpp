@@ -0,0 +1,325 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <new>
+
+#include "IpcLogging.h"
+#include "ShmRing.h"
+
+namespace
+{
+constexpr uint32_t kRingMagic{0x52495247}; // 'RIRG'
+constexpr uint32_t kRecordPadding{0x1};
+constexpr size_t kRecordAlignment{16};
+constexpr size_t kMinCapacity{1024};
+} // namespace
+
+namespace firebolt::rialto::ipc
+{
+// the head and tail are on separate cache lines so the producer and consumer don't contend
+struct ShmRing::Header
+{
+    uint32_t magic;
+    uint32_t capacity;
+    alignas(64) std::atomic<uint64_t> head;
+    alignas(64) std::atomic<uint64_t> tail;
+    alignas(64) std::atomic<uint32_t> consumerWaiting;
+};
+
+struct ShmRing::Record
+{
+    uint32_t length;
+    uint32_t flags;
+    uint64_t tag;
+};
+
+size_t ShmRing::regionSize(size_t capacity)
+{
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared ring requires lock-free 64-bit atomics");
+    static_assert(sizeof(Header) == 256, "unexpected ring header size");
+    static_assert(sizeof(Record) == kRecordAlignment, "unexpected ring record size");
+
+    return sizeof(Header) + capacity;
+}
+
+size_t ShmRing::recordSize(size_t length)
+{
+    return (sizeof(Record) + length + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Initialises an empty ring in \a region, which must be at least
+    regionSize(\a capacity) bytes.  The \a capacity must be a power of two.
+
+    The consumer waiting flag starts set, so the first record written is always
+    signalled.
+
+ */
+bool ShmRing::init(void *region, size_t capacity)
+{
+    if ((capacity < kMinCapacity) || ((capacity & (capacity - 1)) != 0) || (capacity > UINT32_MAX))
+    {
+        RIALTO_IPC_LOG_ERROR("invalid ring capacity %zu", capacity);
+        return false;
+    }
+
+    Header *header = new (region) Header;
+    header->magic = kRingMagic;
+    header->capacity = static_cast<uint32_t>(capacity);
+    header->head.store(0, std::memory_order_relaxed);
+    header->tail.store(0, std::memory_order_relaxed);
+    header->consumerWaiting.store(1, std::memory_order_release);
+
+    return attach(region, capacity);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Attaches to a ring previously initialised with init(), possibly by another
+    process.  The \a capacity must match the value the ring was created with.
+
+ */
+bool ShmRing::attach(void *region, size_t capacity)
+{
+    Header *header = reinterpret_cast<Header *>(region);
+    if ((capacity < kMinCapacity) || ((capacity & (capacity - 1)) != 0) || (header->magic != kRingMagic) ||
+        (header->capacity != capacity))
+    {
+        RIALTO_IPC_LOG_ERROR("shared ring header doesn't match, expected capacity %zu", capacity);
+        return false;
+    }
+
+    m_header = header;
+    m_buffer = reinterpret_cast<uint8_t *>(region) + sizeof(Header);
+    m_capacity = capacity;
+    m_peekedSize = 0;
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Returns the largest payload that can be written in a single record, larger
+    messages must be sent another way.
+
+ */
+size_t ShmRing::maxRecordSize() const
+{
+    return (m_capacity / 4) - sizeof(Record);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Copies \a length bytes of \a data into the ring as a single record tagged
+    with \a tag.  Returns \c false if there is currently no room in the ring or
+    the record is too big, in which case nothing is written.
+
+    Must only be called by the producer.
+
+ */
+bool ShmRing::write(uint64_t tag, const void *data, size_t length)
+{
+    return write(tag, nullptr, 0, data, length);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \overload
+
+    Writes \a headerLength bytes of \a header followed by \a length bytes of
+    \a data as a single record, so that a caller can prepend its own header to
+    a payload without assembling both in a temporary buffer first.
+
+ */
+bool ShmRing::write(uint64_t tag, const void *header, size_t headerLength, const void *data, size_t length)
+{
+    if (!m_header || (length > maxRecordSize()) || (headerLength > maxRecordSize() - length))
+        return false;
+
+    const uint64_t kSize = recordSize(headerLength + length);
+
+    // only the producer moves the head, the tail may be moved concurrently by the consumer
+    uint64_t head = m_header->head.load(std::memory_order_relaxed);
+    const uint64_t kTail = m_header->tail.load(std::memory_order_acquire);
+    if ((kTail > head) || ((head - kTail) > m_capacity))
+    {
+        RIALTO_IPC_LOG_ERROR("shared ring indices corrupt");
+        return false;
+    }
+
+    uint64_t offset = head & (m_capacity - 1);
+    const uint64_t kToEnd = m_capacity - offset;
+    const uint64_t kRequired = (kToEnd < kSize) ? (kToEnd + kSize) : kSize;
+    if ((head - kTail) + kRequired > m_capacity)
+        return false;
+
+    // records are never split across the end of the buffer, fill the remainder with a padding record
+    if (kToEnd < kSize)
+    {
+        Record *padding = reinterpret_cast<Record *>(m_buffer + offset);
+        padding->length = static_cast<uint32_t>(kToEnd - sizeof(Record));
+        padding->flags = kRecordPadding;
+        padding->tag = 0;
+
+        head += kToEnd;
+        offset = 0;
+    }
+
+    Record *record = reinterpret_cast<Record *>(m_buffer + offset);
+    record->length = static_cast<uint32_t>(headerLength + length);
+    record->flags = 0;
+    record->tag = tag;
+    if (headerLength)
+        memcpy(m_buffer + offset + sizeof(Record), header, headerLength);
+    if (length)
+        memcpy(m_buffer + offset + sizeof(Record) + headerLength, data, length);
+
+    // publish the record
+    m_header->head.store(head + kSize, std::memory_order_release);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Clears the consumer waiting flag, returning \c true if it was set, ie. the
+    consumer should be woken up.  Called by the producer after write().
+
+ */
+bool ShmRing::clearConsumerWaiting()
+{
+    if (!m_header)
+        return false;
+
+    // pairs with the fence in setConsumerWaiting(), either we see the flag or the consumer sees the new head
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_header->consumerWaiting.load(std::memory_order_relaxed) == 0)
+        return false;
+
+    return (m_header->consumerWaiting.exchange(0, std::memory_order_acq_rel) != 0);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Gets the next record in the ring without removing it.  Returns \c false if
+    the ring is empty.  The returned \a data pointer is only valid until
+    consume() is called.
+
+    Must only be called by the consumer.
+
+ */
+bool ShmRing::peek(uint64_t *tag, const uint8_t **data, size_t *length)
+{
+    if (!m_header)
+        return false;
+
+    uint64_t tail = m_header->tail.load(std::memory_order_relaxed);
+    const uint64_t kHead = m_header->head.load(std::memory_order_acquire);
+
+    while (tail != kHead)
+    {
+        if ((kHead < tail) || ((kHead - tail) > m_capacity))
+        {
+            RIALTO_IPC_LOG_ERROR("shared ring indices corrupt");
+            return false;
+        }
+
+        const uint64_t kOffset = tail & (m_capacity - 1);
+        const uint64_t kToEnd = m_capacity - kOffset;
+        const Record *kRecord = reinterpret_cast<const Record *>(m_buffer + kOffset);
+
+        // copy the fields out of shared memory so they can't change after validation
+        const uint32_t kLength = kRecord->length;
+        const uint32_t kFlags = kRecord->flags;
+        if ((kToEnd < sizeof(Record)) || (kLength > (kToEnd - sizeof(Record))) ||
+            (recordSize(kLength) > (kHead - tail)))
+        {
+            RIALTO_IPC_LOG_ERROR("invalid record in shared ring");
+            return false;
+        }
+
+        if (kFlags & kRecordPadding)
+        {
+            tail += kToEnd;
+            m_header->tail.store(tail, std::memory_order_release);
+            continue;
+        }
+
+        *tag = kRecord->tag;
+        *data = m_buffer + kOffset + sizeof(Record);
+        *length = kLength;
+        m_peekedSize = recordSize(kLength);
+        return true;
+    }
+
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Removes the record last returned by peek() from the ring.
+
+ */
+void ShmRing::consume()
+{
+    if (!m_header || (m_peekedSize == 0))
+        return;
+
+    const uint64_t kTail = m_header->tail.load(std::memory_order_relaxed);
+    m_header->tail.store(kTail + m_peekedSize, std::memory_order_release);
+    m_peekedSize = 0;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Returns \c true if there are no records in the ring.
+
+ */
+bool ShmRing::empty() const
+{
+    if (!m_header)
+        return true;
+
+    return (m_header->tail.load(std::memory_order_relaxed) == m_header->head.load(std::memory_order_acquire));
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Sets or clears the consumer waiting flag.  When setting the flag the ring is
+    re-checked afterwards and \c true returned if it is no longer empty, in
+    which case the caller should not block as the producer may not have seen
+    the flag.
+
+ */
+bool ShmRing::setConsumerWaiting(bool waiting)
+{
+    if (!m_header)
+        return false;
+
+    m_header->consumerWaiting.store(waiting ? 1 : 0, std::memory_order_relaxed);
+    if (!waiting)
+        return false;
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return !empty();
+}
+
+} // namespace firebolt::rialto::ipc
@@ -0,0 +1,291 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <syscall.h>
+#include <unistd.h>
+
+#include "IpcLogging.h"
+#include "ShmTransport.h"
+
+#if !defined(SYS_memfd_create)
+#if defined(__NR_memfd_create)
+#define SYS_memfd_create __NR_memfd_create
+#elif defined(__arm__)
+#define SYS_memfd_create 385
+#endif
+#endif
+
+#if !defined(MFD_CLOEXEC)
+#define MFD_CLOEXEC 0x0001U
+#endif
+
+#if !defined(MFD_ALLOW_SEALING)
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+
+#if !defined(F_ADD_SEALS)
+#if !defined(F_LINUX_SPECIFIC_BASE)
+#define F_LINUX_SPECIFIC_BASE 1024
+#endif
+#define F_ADD_SEALS (F_LINUX_SPECIFIC_BASE + 9)
+#define F_GET_SEALS (F_LINUX_SPECIFIC_BASE + 10)
+
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#endif
+
+namespace
+{
+/**
+ * @brief Takes ownership of a newly created fd, returning it wrapped in a FileDescriptor.
+ */
+firebolt::rialto::ipc::FileDescriptor adoptFd(int fd)
+{
+    firebolt::rialto::ipc::FileDescriptor fileDescriptor(fd);
+    if ((fd >= 0) && (close(fd) != 0))
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to close fd");
+    return fileDescriptor;
+}
+} // namespace
+
+namespace firebolt::rialto::ipc
+{
+ShmTransport::~ShmTransport()
+{
+    if (m_mapping && (munmap(m_mapping, m_mappingSize) != 0))
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to unmap shared transport");
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \static
+
+    Creates a new transport with two rings of \a ringCapacity bytes.  The memfd
+    is sealed against resizing before it is returned, so it is safe for the peer
+    to map it.
+
+ */
+std::unique_ptr<ShmTransport> ShmTransport::create(size_t ringCapacity)
+{
+    std::unique_ptr<ShmTransport> transport(new ShmTransport());
+
+    transport->m_memFd =
+        adoptFd(static_cast<int>(syscall(SYS_memfd_create, "rialto-ipc-transport", MFD_CLOEXEC | MFD_ALLOW_SEALING)));
+    if (!transport->m_memFd.isValid())
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to create memfd for shared transport");
+        return nullptr;
+    }
+
+    const size_t kSize = 2 * ShmRing::regionSize(ringCapacity);
+    if (ftruncate(transport->m_memFd.fd(), static_cast<off_t>(kSize)) != 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to size memfd for shared transport");
+        return nullptr;
+    }
+    if (fcntl(transport->m_memFd.fd(), F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to seal memfd for shared transport");
+        return nullptr;
+    }
+
+    transport->m_txDoorbell = adoptFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+    transport->m_rxDoorbell = adoptFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+    if (!transport->m_txDoorbell.isValid() || !transport->m_rxDoorbell.isValid())
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to create doorbells for shared transport");
+        return nullptr;
+    }
+
+    if (!transport->map(ringCapacity, true))
+        return nullptr;
+
+    return transport;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \static
+
+    Attaches to a transport created by the peer.  The doorbells are named from
+    the point of view of the creator, ie. \a creatorTxDoorbell is rung when the
+    creator writes to its ring, so it is the one the attached side waits on.
+
+    The memfd is not trusted, it must be sealed against shrinking and be big
+    enough for the rings.
+
+ */
+std::unique_ptr<ShmTransport> ShmTransport::attach(const FileDescriptor &memFd,
+                                                   const FileDescriptor &creatorTxDoorbell,
+                                                   const FileDescriptor &creatorRxDoorbell, size_t ringCapacity)
+{
+    if ((ringCapacity == 0) || (ringCapacity > kMaxRingCapacity))
+    {
+        RIALTO_IPC_LOG_ERROR("invalid shared transport ring capacity %zu", ringCapacity);
+        return nullptr;
+    }
+
+    const int kSeals = fcntl(memFd.fd(), F_GET_SEALS);
+    if ((kSeals < 0) || !(kSeals & F_SEAL_SHRINK))
+    {
+        RIALTO_IPC_LOG_ERROR("shared transport memfd is not sealed");
+        return nullptr;
+    }
+
+    struct stat details = {};
+    if ((fstat(memFd.fd(), &details) != 0) ||
+        (static_cast<size_t>(details.st_size) < 2 * ShmRing::regionSize(ringCapacity)))
+    {
+        RIALTO_IPC_LOG_ERROR("shared transport memfd is too small");
+        return nullptr;
+    }
+
+    std::unique_ptr<ShmTransport> transport(new ShmTransport());
+    transport->m_memFd = memFd;
+    transport->m_txDoorbell = creatorRxDoorbell;
+    transport->m_rxDoorbell = creatorTxDoorbell;
+    if (!transport->m_memFd.isValid() || !transport->m_txDoorbell.isValid() || !transport->m_rxDoorbell.isValid())
+    {
+        RIALTO_IPC_LOG_ERROR("invalid fds for shared transport");
+        return nullptr;
+    }
+
+    if (!transport->map(ringCapacity, false))
+        return nullptr;
+
+    return transport;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Maps the memfd and either initialises or attaches to the two rings in it.
+
+ */
+bool ShmTransport::map(size_t ringCapacity, bool create)
+{
+    const size_t kRegionSize = ShmRing::regionSize(ringCapacity);
+
+    m_mappingSize = 2 * kRegionSize;
+    m_mapping = mmap(nullptr, m_mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_memFd.fd(), 0);
+    if (m_mapping == MAP_FAILED)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to map shared transport");
+        m_mapping = nullptr;
+        return false;
+    }
+
+    m_ringCapacity = ringCapacity;
+
+    uint8_t *first = reinterpret_cast<uint8_t *>(m_mapping);
+    uint8_t *second = first + kRegionSize;
+    if (create)
+    {
+        return m_txRing.init(first, ringCapacity) && m_rxRing.init(second, ringCapacity);
+    }
+
+    return m_txRing.attach(second, ringCapacity) && m_rxRing.attach(first, ringCapacity);
+}
+
+size_t ShmTransport::maxMessageSize() const
+{
+    return m_txRing.maxRecordSize();
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Writes a message to the transmit ring and rings the peer's doorbell if it
+    is waiting.  Returns \c false if the message doesn't fit in the ring, in
+    which case it should be sent on the socket instead.
+
+ */
+bool ShmTransport::send(uint64_t tag, const void *data, size_t length)
+{
+    if (!m_txRing.write(tag, data, length))
+        return false;
+
+    if (m_txRing.clearConsumerWaiting())
+    {
+        uint64_t value = 1;
+        if (TEMP_FAILURE_RETRY(::write(m_txDoorbell.fd(), &value, sizeof(value))) != sizeof(value))
+        {
+            RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to ring shared transport doorbell");
+        }
+    }
+
+    return true;
+}
+
+bool ShmTransport::peek(uint64_t *tag, const uint8_t **data, size_t *length)
+{
+    return m_rxRing.peek(tag, data, length);
+}
+
+void ShmTransport::consume()
+{
+    m_rxRing.consume();
+}
+
+bool ShmTransport::hasData() const
+{
+    return !m_rxRing.empty();
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Tells the peer we're about to block on the receive doorbell.  Returns
+    \c true if a message arrived in the meantime, in which case the caller
+    should process it rather than block.
+
+ */
+bool ShmTransport::prepareToWait()
+{
+    return m_rxRing.setConsumerWaiting(true);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Tells the peer we're actively polling the receive ring, so there is no need
+    for it to ring the doorbell.
+
+ */
+void ShmTransport::cancelWait()
+{
+    m_rxRing.setConsumerWaiting(false);
+}
+
+void ShmTransport::clearDoorbell()
+{
+    uint64_t ignore;
+    if ((TEMP_FAILURE_RETRY(::read(m_rxDoorbell.fd(), &ignore, sizeof(ignore))) != sizeof(ignore)) &&
+        (errno != EAGAIN))
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to clear shared transport doorbell");
+    }
+}
+
+} // namespace firebolt::rialto::ipc
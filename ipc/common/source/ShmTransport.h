@@ -0,0 +1,100 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_IPC_SHM_TRANSPORT_H_
+#define FIREBOLT_RIALTO_IPC_SHM_TRANSPORT_H_
+
+#include "FileDescriptor.h"
+#include "ShmRing.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// -----------------------------------------------------------------------------
+/*!
+    \class ShmTransport
+    \brief A pair of ShmRing objects in a sealed memfd, one for each direction,
+    plus an eventfd 'doorbell' for each ring.
+
+    One side (the client) creates the transport and passes the memfd and the two
+    eventfds to the peer over the socket, the peer then attaches to them.  The
+    creator writes to the first ring and reads from the second, the attached
+    side does the opposite.
+
+    A doorbell is only rung if the consumer has flagged it is about to block, so
+    while both sides are busy messages are exchanged without any syscalls.
+
+    The transport knows nothing about the framing of the messages, the tag
+    stored with each record is used by the channel and server to keep the order
+    of messages sent on the rings and on the socket.
+*/
+
+namespace firebolt::rialto::ipc
+{
+class ShmTransport
+{
+public:
+    ~ShmTransport();
+    ShmTransport(const ShmTransport &) = delete;
+    ShmTransport &operator=(const ShmTransport &) = delete;
+
+    static constexpr size_t kDefaultRingCapacity{256 * 1024};
+    static constexpr size_t kMaxRingCapacity{4 * 1024 * 1024};
+
+    static std::unique_ptr<ShmTransport> create(size_t ringCapacity = kDefaultRingCapacity);
+    static std::unique_ptr<ShmTransport> attach(const FileDescriptor &memFd, const FileDescriptor &creatorTxDoorbell,
+                                                const FileDescriptor &creatorRxDoorbell, size_t ringCapacity);
+
+    int memFd() const { return m_memFd.fd(); }
+    int txDoorbellFd() const { return m_txDoorbell.fd(); }
+    int rxDoorbellFd() const { return m_rxDoorbell.fd(); }
+    size_t ringCapacity() const { return m_ringCapacity; }
+
+    size_t maxMessageSize() const;
+    bool send(uint64_t tag, const void *data, size_t length);
+
+    bool peek(uint64_t *tag, const uint8_t **data, size_t *length);
+    void consume();
+    bool hasData() const;
+
+    bool prepareToWait();
+    void cancelWait();
+    void clearDoorbell();
+
+private:
+    ShmTransport() = default;
+
+    bool map(size_t ringCapacity, bool create);
+
+    FileDescriptor m_memFd;
+    FileDescriptor m_txDoorbell;
+    FileDescriptor m_rxDoorbell;
+
+    void *m_mapping = nullptr;
+    size_t m_mappingSize = 0;
+    size_t m_ringCapacity = 0;
+
+    ShmRing m_txRing;
+    ShmRing m_rxRing;
+};
+
+} // namespace firebolt::rialto::ipc
+
+#endif // FIREBOLT_RIALTO_IPC_SHM_TRANSPORT_H_
@@ -0,0 +1,421 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include "IpcLogging.h"
+#include "SlabAllocator.h"
+
+namespace
+{
+constexpr uint32_t kBlockMagic{0x534c4142}; // 'SLAB'
+constexpr uint32_t kHeapSizeClass{UINT32_MAX};
+constexpr unsigned kMinBlockShift{6};
+constexpr size_t kSlabAlignment{64};
+
+// the most blocks of a size class each thread may hold on to, at most 32 or 256KB worth
+constexpr size_t kMaxThreadCacheBytes{256 * 1024};
+constexpr uint32_t kMaxThreadCacheBlocks{32};
+
+// the usage counters are updated by each thread in batches
+constexpr int64_t kStatsBatchBytes{64 * 1024};
+constexpr uint32_t kStatsBatchAllocations{64};
+
+constexpr size_t blockSize(unsigned sizeClass)
+{
+    return size_t(1) << (kMinBlockShift + sizeClass);
+}
+
+// set once the calling thread's cache has been destroyed, any blocks it frees after that go straight to the free lists
+thread_local bool t_threadCacheDestroyed = false;
+} // namespace
+
+namespace firebolt::rialto::ipc
+{
+// stored at the start of every block, the pointer returned to the caller follows it
+struct SlabAllocator::BlockHeader
+{
+    std::atomic<uint32_t> next; // index + 1 of the next free block, only valid while the block is free
+    uint32_t index;
+    uint32_t sizeClass;
+    uint32_t magic;
+};
+
+// blocks freed by a thread are kept on a short list for it to reuse, and flushed to the shared free lists when the
+// list is full or the thread exits. The list is linked through the first bytes after the block headers
+struct SlabAllocator::ThreadCache
+{
+    BlockHeader *head[kNumSizeClasses] = {};
+    uint32_t count[kNumSizeClasses] = {};
+
+    int64_t inUseDelta = 0;
+    uint32_t pendingAllocations = 0;
+
+    ~ThreadCache()
+    {
+        t_threadCacheDestroyed = true;
+
+        SlabAllocator &allocator = SlabAllocator::instance();
+        allocator.flushStats(inUseDelta, pendingAllocations);
+        for (unsigned i = 0; i < kNumSizeClasses; i++)
+        {
+            while (head[i])
+            {
+                BlockHeader *block = head[i];
+                head[i] = nextOf(block);
+                allocator.pushFreeBlock(block);
+            }
+        }
+    }
+
+    static BlockHeader *&nextOf(BlockHeader *block) { return *reinterpret_cast<BlockHeader **>(block + 1); }
+
+    static uint32_t maxBlocks(unsigned sizeClass)
+    {
+        return static_cast<uint32_t>(
+            std::max<size_t>(1, std::min<size_t>(kMaxThreadCacheBlocks, kMaxThreadCacheBytes / blockSize(sizeClass))));
+    }
+};
+
+SlabAllocator::ThreadCache *SlabAllocator::threadCache()
+{
+    if (t_threadCacheDestroyed)
+        return nullptr;
+
+    static thread_local ThreadCache cache;
+    return &cache;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \static
+
+    Returns the process wide allocator.  It's never destroyed, so buffers may
+    be freed safely by objects destroyed at exit.
+
+ */
+SlabAllocator &SlabAllocator::instance()
+{
+    static_assert(sizeof(BlockHeader) == 16, "unexpected block header size");
+    static_assert(blockSize(kNumSizeClasses - 1) == kMaxBlockSize, "size classes don't match the max block size");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "slab free lists require lock-free 64-bit atomics");
+
+    static SlabAllocator *allocator = new SlabAllocator();
+    return *allocator;
+}
+
+SlabAllocator::Stats SlabAllocator::getStats() const
+{
+    Stats stats;
+    stats.bytesInUse = static_cast<size_t>(std::max<int64_t>(0, m_bytesInUse.load(std::memory_order_relaxed)));
+    stats.highWaterBytes = static_cast<size_t>(m_highWaterBytes.load(std::memory_order_relaxed));
+    stats.slabBytes = m_slabBytes.load(std::memory_order_relaxed);
+    stats.allocations = m_allocations.load(std::memory_order_relaxed);
+    stats.heapAllocations = m_heapAllocations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Allocates a buffer of at least \a bytes, trying the calling thread's cache,
+    then the shared free list and then a new slab.
+
+ */
+void *SlabAllocator::allocateImpl(size_t bytes)
+{
+    const size_t kRequired = bytes + sizeof(BlockHeader);
+    if (kRequired > kMaxBlockSize)
+        return allocateFromHeap(bytes);
+
+    // round up to the next power of two
+    const unsigned kBits = static_cast<unsigned>(sizeof(unsigned long) * 8) - __builtin_clzl(kRequired - 1);
+    const unsigned kSizeClass = (kBits > kMinBlockShift) ? (kBits - kMinBlockShift) : 0;
+
+    BlockHeader *block = nullptr;
+
+    ThreadCache *cache = threadCache();
+    if (cache && cache->head[kSizeClass])
+    {
+        block = cache->head[kSizeClass];
+        cache->head[kSizeClass] = ThreadCache::nextOf(block);
+        cache->count[kSizeClass]--;
+    }
+    else
+    {
+        block = popFreeBlock(kSizeClass);
+        if (!block)
+            block = addSlab(kSizeClass);
+        if (!block)
+            return allocateFromHeap(bytes);
+    }
+
+    updateStats(cache, static_cast<int64_t>(blockSize(kSizeClass)));
+    return block + 1;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Fallback for buffers too big for the slabs, the buffer still gets a header
+    so deallocate() knows to return it to the heap.
+
+ */
+void *SlabAllocator::allocateFromHeap(size_t bytes)
+{
+    BlockHeader *block = reinterpret_cast<BlockHeader *>(malloc(sizeof(BlockHeader) + bytes));
+    if (!block)
+        return nullptr;
+
+    block->next.store(0, std::memory_order_relaxed);
+    block->index = static_cast<uint32_t>(std::min<size_t>(bytes, UINT32_MAX));
+    block->sizeClass = kHeapSizeClass;
+    block->magic = kBlockMagic;
+
+    m_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    updateStats(threadCache(), static_cast<int64_t>(bytes));
+    return block + 1;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    Frees a buffer returned by allocate() or allocateShared().  Safe to call
+    from any thread.
+
+ */
+void SlabAllocator::deallocate(void *p)
+{
+    if (!p)
+        return;
+
+    BlockHeader *block = reinterpret_cast<BlockHeader *>(p) - 1;
+    if (block->magic != kBlockMagic)
+    {
+        RIALTO_IPC_LOG_FATAL("trying to free an unknown buffer from the slab allocator!");
+        return;
+    }
+
+    ThreadCache *cache = threadCache();
+
+    const uint32_t kSizeClass = block->sizeClass;
+    if (kSizeClass == kHeapSizeClass)
+    {
+        updateStats(cache, -static_cast<int64_t>(block->index));
+        free(block);
+        return;
+    }
+    if (kSizeClass >= kNumSizeClasses)
+    {
+        RIALTO_IPC_LOG_FATAL("corrupt block header in the slab allocator!");
+        return;
+    }
+
+    updateStats(cache, -static_cast<int64_t>(blockSize(kSizeClass)));
+
+    if (cache && (cache->count[kSizeClass] < ThreadCache::maxBlocks(kSizeClass)))
+    {
+        ThreadCache::nextOf(block) = cache->head[kSizeClass];
+        cache->head[kSizeClass] = block;
+        cache->count[kSizeClass]++;
+    }
+    else
+    {
+        pushFreeBlock(block);
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Returns the block with the given index + 1, or \c nullptr for 0.  Slabs are
+    never freed, so this is safe to call with a stale index.
+
+ */
+SlabAllocator::BlockHeader *SlabAllocator::blockAt(unsigned sizeClass, uint32_t index) const
+{
+    if (index == 0)
+        return nullptr;
+
+    const size_t kBlockSize = blockSize(sizeClass);
+    const size_t kBlocksPerSlab = std::max(kSlabSize, kBlockSize) / kBlockSize;
+    const uint32_t kSlab = static_cast<uint32_t>((index - 1) / kBlocksPerSlab);
+    if (kSlab >= kMaxSlabsPerClass)
+        return nullptr;
+
+    uint8_t *slab = m_sizeClasses[sizeClass].slabs[kSlab].load(std::memory_order_acquire);
+    if (!slab)
+        return nullptr;
+
+    return reinterpret_cast<BlockHeader *>(slab + ((index - 1) % kBlocksPerSlab) * kBlockSize);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Pops a block from the shared free list of the size class.
+
+ */
+SlabAllocator::BlockHeader *SlabAllocator::popFreeBlock(unsigned sizeClass)
+{
+    std::atomic<uint64_t> &freeHead = m_sizeClasses[sizeClass].freeHead;
+
+    uint64_t head = freeHead.load(std::memory_order_acquire);
+    while ((head & UINT32_MAX) != 0)
+    {
+        BlockHeader *block = blockAt(sizeClass, static_cast<uint32_t>(head));
+        if (!block)
+        {
+            RIALTO_IPC_LOG_FATAL("corrupt free list in the slab allocator!");
+            return nullptr;
+        }
+
+        // the block may be popped and reused by another thread meanwhile, in which case next is garbage but the tag
+        // will have changed so the exchange fails
+        const uint64_t kNext = block->next.load(std::memory_order_relaxed);
+        const uint64_t kNewHead = (((head >> 32) + 1) << 32) | kNext;
+        if (freeHead.compare_exchange_weak(head, kNewHead, std::memory_order_acquire, std::memory_order_acquire))
+            return block;
+    }
+
+    return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Pushes a block onto the shared free list of its size class.
+
+ */
+void SlabAllocator::pushFreeBlock(BlockHeader *block)
+{
+    std::atomic<uint64_t> &freeHead = m_sizeClasses[block->sizeClass].freeHead;
+
+    uint64_t head = freeHead.load(std::memory_order_relaxed);
+    uint64_t newHead;
+    do
+    {
+        block->next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        newHead = (((head >> 32) + 1) << 32) | (block->index + 1);
+    } while (!freeHead.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Adds a slab to the size class, returning its first block and putting the
+    rest on the free list.  Returns \c nullptr if the class has run out of
+    slabs.
+
+ */
+SlabAllocator::BlockHeader *SlabAllocator::addSlab(unsigned sizeClass)
+{
+    SizeClass &details = m_sizeClasses[sizeClass];
+    std::lock_guard<std::mutex> locker(details.slabsLock);
+
+    // another thread may have added a slab while we waited for the lock
+    BlockHeader *block = popFreeBlock(sizeClass);
+    if (block)
+        return block;
+
+    const uint32_t kSlab = details.numSlabs.load(std::memory_order_relaxed);
+    if (kSlab >= kMaxSlabsPerClass)
+        return nullptr;
+
+    const size_t kBlockSize = blockSize(sizeClass);
+    const size_t kSlabBytes = std::max(kSlabSize, kBlockSize);
+    const size_t kBlocksPerSlab = kSlabBytes / kBlockSize;
+
+    void *slab = nullptr;
+    if (posix_memalign(&slab, kSlabAlignment, kSlabBytes) != 0)
+    {
+        RIALTO_IPC_LOG_ERROR("failed to allocate a %zu byte slab", kSlabBytes);
+        return nullptr;
+    }
+
+    uint8_t *base = reinterpret_cast<uint8_t *>(slab);
+    for (size_t i = 0; i < kBlocksPerSlab; i++)
+    {
+        BlockHeader *header = new (base + i * kBlockSize) BlockHeader;
+        header->next.store(0, std::memory_order_relaxed);
+        header->index = static_cast<uint32_t>(kSlab * kBlocksPerSlab + i);
+        header->sizeClass = sizeClass;
+        header->magic = kBlockMagic;
+    }
+
+    // publish the slab before any of its blocks can be seen on the free list
+    details.slabs[kSlab].store(base, std::memory_order_release);
+    details.numSlabs.store(kSlab + 1, std::memory_order_relaxed);
+    m_slabBytes.fetch_add(kSlabBytes, std::memory_order_relaxed);
+
+    for (size_t i = 1; i < kBlocksPerSlab; i++)
+        pushFreeBlock(reinterpret_cast<BlockHeader *>(base + i * kBlockSize));
+
+    return reinterpret_cast<BlockHeader *>(base);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Adds \a bytes, negative for a free, to the usage counters.  The change is
+    held in the calling thread's cache until a batch has built up.
+
+ */
+void SlabAllocator::updateStats(ThreadCache *cache, int64_t bytes)
+{
+    if (!cache)
+    {
+        flushStats(bytes, (bytes > 0) ? 1 : 0);
+        return;
+    }
+
+    cache->inUseDelta += bytes;
+    if (bytes > 0)
+        cache->pendingAllocations++;
+
+    if ((cache->pendingAllocations >= kStatsBatchAllocations) || (cache->inUseDelta >= kStatsBatchBytes) ||
+        (cache->inUseDelta <= -kStatsBatchBytes))
+    {
+        flushStats(cache->inUseDelta, cache->pendingAllocations);
+        cache->inUseDelta = 0;
+        cache->pendingAllocations = 0;
+    }
+}
+
+void SlabAllocator::flushStats(int64_t bytes, uint32_t allocations)
+{
+    m_allocations.fetch_add(allocations, std::memory_order_relaxed);
+
+    const int64_t kInUse = m_bytesInUse.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    int64_t highWater = m_highWaterBytes.load(std::memory_order_relaxed);
+    while ((kInUse > highWater) &&
+           !m_highWaterBytes.compare_exchange_weak(highWater, kInUse, std::memory_order_relaxed))
+    {
+    }
+}
+
+} // namespace firebolt::rialto::ipc
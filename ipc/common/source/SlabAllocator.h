@@ -0,0 +1,150 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_IPC_SLAB_ALLOCATOR_H_
+#define FIREBOLT_RIALTO_IPC_SLAB_ALLOCATOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// -----------------------------------------------------------------------------
+/*!
+    \class SlabAllocator
+    \brief Allocator for the buffers used to build IPC messages.
+
+    Requests are rounded up to a power of two size class, from 64 bytes up to
+    256KB, and served from slabs carved into blocks of that size.  Anything
+    bigger, or once the slabs of a class are exhausted, comes from the heap.
+
+    Freed blocks go to a small cache owned by the freeing thread, and from
+    there to a lock-free free list per size class, so in the steady state
+    neither allocating nor freeing takes a lock.  Blocks may be freed by a
+    different thread to the one that allocated them.
+
+    There is a single allocator per process, slabs are never returned to the
+    heap.
+*/
+
+namespace firebolt::rialto::ipc
+{
+class SlabAllocator
+{
+public:
+    SlabAllocator(const SlabAllocator &) = delete;
+    SlabAllocator &operator=(const SlabAllocator &) = delete;
+
+    static SlabAllocator &instance();
+
+    static constexpr size_t kMinBlockSize{64};
+    static constexpr size_t kMaxBlockSize{256 * 1024};
+
+    // the usage counters are updated by each thread in batches, so may lag by up to 64KB or 64 allocations per thread
+    struct Stats
+    {
+        size_t bytesInUse = 0;        // sum of the size classes of the buffers currently allocated
+        size_t highWaterBytes = 0;    // the largest value bytesInUse has reached
+        size_t slabBytes = 0;         // memory reserved for slabs
+        uint64_t allocations = 0;     // total number of buffers allocated
+        uint64_t heapAllocations = 0; // number of those that had to come from the heap
+    };
+
+    Stats getStats() const;
+
+    template <class T = uint8_t> T *allocate(size_t count)
+    {
+        return reinterpret_cast<T *>(allocateImpl(count * sizeof(T)));
+    }
+
+    template <class T = uint8_t> std::shared_ptr<T> allocateShared(size_t count)
+    {
+        // the control block is allocated from the slabs too
+        return std::shared_ptr<T>(allocate<T>(count), [this](T *p) { deallocate(p); }, StlAllocator<T>());
+    }
+
+    void deallocate(void *p);
+
+    /**
+     * @brief Minimal standard allocator on top of the process allocator.
+     */
+    template <class T> struct StlAllocator
+    {
+        using value_type = T;
+
+        StlAllocator() = default;
+        template <class U> explicit StlAllocator(const StlAllocator<U> &) {}
+
+        T *allocate(size_t n) { return SlabAllocator::instance().allocate<T>(n); }
+        void deallocate(T *p, size_t) { SlabAllocator::instance().deallocate(p); }
+
+        template <class U> bool operator==(const StlAllocator<U> &) const { return true; }
+        template <class U> bool operator!=(const StlAllocator<U> &) const { return false; }
+    };
+
+private:
+    SlabAllocator() = default;
+
+    struct BlockHeader;
+    struct SizeClass;
+    struct ThreadCache;
+
+    static constexpr unsigned kNumSizeClasses{13};
+    static constexpr size_t kSlabSize{64 * 1024};
+    static constexpr unsigned kMaxSlabsPerClass{1024};
+
+    static ThreadCache *threadCache();
+
+    void *allocateImpl(size_t bytes);
+    void *allocateFromHeap(size_t bytes);
+
+    BlockHeader *blockAt(unsigned sizeClass, uint32_t index) const;
+    BlockHeader *popFreeBlock(unsigned sizeClass);
+    void pushFreeBlock(BlockHeader *block);
+    BlockHeader *addSlab(unsigned sizeClass);
+
+    void updateStats(ThreadCache *cache, int64_t bytes);
+    void flushStats(int64_t bytes, uint32_t allocations);
+
+private:
+    struct SizeClass
+    {
+        // index + 1 of the first free block in the low 32 bits, and a tag incremented on every change in the
+        // high 32 bits so that a stale head can't be swapped back in
+        std::atomic<uint64_t> freeHead{0};
+
+        std::mutex slabsLock;
+        std::atomic<uint32_t> numSlabs{0};
+        std::atomic<uint8_t *> slabs[kMaxSlabsPerClass] = {};
+    };
+
+    SizeClass m_sizeClasses[kNumSizeClasses];
+
+    // may be briefly negative as the threads update them in batches
+    std::atomic<int64_t> m_bytesInUse{0};
+    std::atomic<int64_t> m_highWaterBytes{0};
+    std::atomic<size_t> m_slabBytes{0};
+    std::atomic<uint64_t> m_allocations{0};
+    std::atomic<uint64_t> m_heapAllocations{0};
+};
+
+} // namespace firebolt::rialto::ipc
+
+#endif // FIREBOLT_RIALTO_IPC_SLAB_ALLOCATOR_H_
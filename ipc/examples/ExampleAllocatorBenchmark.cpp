@@ -0,0 +1,160 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SimpleBufferPool.h"
+#include "SlabAllocator.h"
+
+#include <RialtoLogging.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Microbenchmark of the allocators used for IPC message buffers, compares malloc, the SimpleBufferPool that used to
+// be used and the SlabAllocator that replaced it.  Each thread allocates buffers of typical message sizes and frees
+// them a few allocations later, as happens when messages are queued before being sent.
+//
+// usage: ExampleAllocatorBenchmark [allocations per thread] [threads]
+
+using firebolt::rialto::ipc::SlabAllocator;
+
+namespace
+{
+constexpr size_t kSizes[] = {96, 180, 512, 64, 2048, 256, 9000, 128, 1024, 40000, 300, 4096};
+constexpr size_t kNumSizes = sizeof(kSizes) / sizeof(kSizes[0]);
+constexpr size_t kWindow = 4;
+
+struct Malloc
+{
+    void *allocate(size_t bytes) { return malloc(bytes); }
+    void deallocate(void *p) { free(p); }
+    std::shared_ptr<uint8_t> allocateShared(size_t bytes)
+    {
+        return std::shared_ptr<uint8_t>(reinterpret_cast<uint8_t *>(malloc(bytes)), free);
+    }
+};
+
+struct Pool
+{
+    SimpleBufferPool pool;
+
+    void *allocate(size_t bytes) { return pool.allocate(bytes); }
+    void deallocate(void *p) { pool.deallocate(p); }
+    std::shared_ptr<uint8_t> allocateShared(size_t bytes) { return pool.allocateShared<uint8_t>(bytes); }
+};
+
+struct Slab
+{
+    void *allocate(size_t bytes) { return SlabAllocator::instance().allocate(bytes); }
+    void deallocate(void *p) { SlabAllocator::instance().deallocate(p); }
+    std::shared_ptr<uint8_t> allocateShared(size_t bytes)
+    {
+        return SlabAllocator::instance().allocateShared<uint8_t>(bytes);
+    }
+};
+
+template <class Allocator> void runRaw(Allocator &allocator, unsigned numAllocations)
+{
+    void *window[kWindow] = {};
+    for (unsigned i = 0; i < numAllocations; i++)
+    {
+        void *&slot = window[i % kWindow];
+        allocator.deallocate(slot);
+        slot = allocator.allocate(kSizes[i % kNumSizes]);
+
+        // touch the buffer as the message would be written to it
+        *reinterpret_cast<volatile uint8_t *>(slot) = 0;
+    }
+    for (void *p : window)
+        allocator.deallocate(p);
+}
+
+template <class Allocator> void runShared(Allocator &allocator, unsigned numAllocations)
+{
+    std::shared_ptr<uint8_t> window[kWindow];
+    for (unsigned i = 0; i < numAllocations; i++)
+    {
+        std::shared_ptr<uint8_t> &slot = window[i % kWindow];
+        slot = allocator.allocateShared(kSizes[i % kNumSizes]);
+        *reinterpret_cast<volatile uint8_t *>(slot.get()) = 0;
+    }
+}
+
+// Returns the average time of an allocate / deallocate pair in nanoseconds
+template <class Allocator> double measure(bool shared, unsigned numAllocations, unsigned numThreads)
+{
+    Allocator allocator;
+
+    // warm up so the slabs and pools are populated
+    runRaw(allocator, 1000);
+
+    const auto kStart = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < numThreads; i++)
+    {
+        threads.emplace_back(
+            [&allocator, shared, numAllocations]()
+            {
+                if (shared)
+                    runShared(allocator, numAllocations);
+                else
+                    runRaw(allocator, numAllocations);
+            });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    const std::chrono::duration<double, std::nano> kElapsed = std::chrono::steady_clock::now() - kStart;
+    return kElapsed.count() / (static_cast<double>(numAllocations) * numThreads);
+}
+
+void report(const char *name, bool shared, unsigned numAllocations, unsigned numThreads)
+{
+    printf("%-20s %10.1f %10.1f %10.1f\n", name, measure<Malloc>(shared, numAllocations, numThreads),
+           measure<Pool>(shared, numAllocations, numThreads), measure<Slab>(shared, numAllocations, numThreads));
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    // the pool logs nothing useful here, only report errors
+    firebolt::rialto::logging::setLogLevels(RIALTO_COMPONENT_IPC,
+                                            RIALTO_DEBUG_LEVEL(RIALTO_DEBUG_LEVEL_FATAL | RIALTO_DEBUG_LEVEL_ERROR));
+
+    const unsigned kNumAllocations = (argc > 1) ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 1000000;
+    const unsigned kNumThreads = (argc > 2) ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 4;
+
+    printf("average time of an allocation and free (ns), %u allocations per thread\n", kNumAllocations);
+    printf("%-20s %10s %10s %10s\n", "", "malloc", "pool", "slab");
+    report("1 thread", false, kNumAllocations, 1);
+    report("1 thread shared", true, kNumAllocations, 1);
+    report("threads", false, kNumAllocations, kNumThreads);
+    report("threads shared", true, kNumAllocations, kNumThreads);
+
+    const SlabAllocator::Stats kStats = SlabAllocator::instance().getStats();
+    printf("\nslab allocator: %zu bytes of slabs, high water %zu bytes, %llu of %llu allocations from the heap\n",
+           kStats.slabBytes, kStats.highWaterBytes, static_cast<unsigned long long>(kStats.heapAllocations),
+           static_cast<unsigned long long>(kStats.allocations));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,207 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <IIpcChannel.h>
+#include <IIpcController.h>
+#include <IIpcControllerFactory.h>
+#include <IIpcServer.h>
+#include <IIpcServerFactory.h>
+#include <RialtoLogging.h>
+
+#include "example.pb.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Stress example that runs several client channels in parallel, each one on its own thread and talking to its own
+// server over a socket pair. It reports the total call rate for an increasing number of channels, which shows
+// whether the channels are able to process their replies in parallel.
+//
+// usage: ExampleMultiChannelStress [max channels] [calls per channel] [reply size in bytes]
+
+class MyExampleService : public ::example::ExampleService
+{
+public:
+    explicit MyExampleService(size_t replySize) : m_reply(replySize, 'x') {}
+
+    void exampleEcho(google::protobuf::RpcController *controller, const ::example::RequestEcho *request,
+                     ::example::ResponseEcho *response, google::protobuf::Closure *done) override
+    {
+        response->set_text(m_reply);
+        done->Run();
+    }
+
+private:
+    const std::string m_reply;
+};
+
+// Callback called when the RPC call completes with either a valid result or error
+static void onComplete(bool *done)
+{
+    *done = true;
+}
+
+// Makes the given number of echo calls on the channel, returns the number of failed calls
+static unsigned runClient(int sock, unsigned numCalls)
+{
+    auto factory = firebolt::rialto::ipc::IChannelFactory::createFactory();
+    auto channel = factory->createChannel(sock);
+    if (!channel)
+    {
+        fprintf(stderr, "Failed to connect to socket fd '%d'\n", sock);
+        return numCalls;
+    }
+
+    ::example::ExampleService::Stub stub(channel.get());
+    auto controllerFactory = firebolt::rialto::ipc::IControllerFactory::createFactory();
+
+    unsigned failures = 0;
+    for (unsigned i = 0; i < numCalls; ++i)
+    {
+        ::example::RequestEcho request;
+        ::example::ResponseEcho response;
+        request.set_text("ping");
+
+        auto controller = controllerFactory->create();
+        bool done = false;
+        stub.exampleEcho(controller.get(), &request, &response, google::protobuf::NewCallback(onComplete, &done));
+
+        while (channel->process() && !done)
+        {
+            channel->wait(-1);
+        }
+
+        if (!done || controller->Failed())
+        {
+            ++failures;
+        }
+    }
+
+    channel->disconnect();
+    return failures;
+}
+
+// Runs the given number of channels in parallel, returns the total number of calls per second
+static double runChannels(unsigned numChannels, unsigned numCalls, size_t replySize)
+{
+    auto serverFactory = ::firebolt::rialto::ipc::IServerFactory::createFactory();
+
+    std::vector<std::shared_ptr<::firebolt::rialto::ipc::IServer>> servers;
+    std::vector<int> clientSocks;
+    for (unsigned i = 0; i < numChannels; ++i)
+    {
+        int socks[2] = {-1, -1};
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0, socks) < 0)
+        {
+            fprintf(stderr, "socketpair failed - %s\n", strerror(errno));
+            return 0.0;
+        }
+
+        auto server = serverFactory->create();
+        auto client = server->addClient(socks[0]);
+        if (!client)
+        {
+            close(socks[1]);
+            return 0.0;
+        }
+        client->exportService(std::make_shared<MyExampleService>(replySize));
+
+        servers.push_back(server);
+        clientSocks.push_back(socks[1]);
+    }
+
+    // each server is processed on its own thread, so that the clients are the only shared resource
+    std::atomic<bool> running{true};
+    std::vector<std::thread> serverThreads;
+    for (const auto &server : servers)
+    {
+        serverThreads.emplace_back(
+            [&running, server]()
+            {
+                while (running && server->process())
+                {
+                    server->wait(10);
+                }
+            });
+    }
+
+    std::atomic<unsigned> failures{0};
+    const auto kStart = std::chrono::steady_clock::now();
+    std::vector<std::thread> clientThreads;
+    for (int sock : clientSocks)
+    {
+        clientThreads.emplace_back([&failures, sock, numCalls]() { failures += runClient(sock, numCalls); });
+    }
+    for (auto &thread : clientThreads)
+    {
+        thread.join();
+    }
+    const std::chrono::duration<double> kElapsed = std::chrono::steady_clock::now() - kStart;
+
+    running = false;
+    for (auto &thread : serverThreads)
+    {
+        thread.join();
+    }
+
+    if (failures > 0)
+    {
+        fprintf(stderr, "%u calls failed\n", failures.load());
+    }
+
+    return (numChannels * numCalls) / kElapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    // verify that the version of the library that we linked against is
+    // compatible with the version of the headers we compiled against.
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    // only report errors, logging would dominate the measurement
+    firebolt::rialto::logging::setLogLevels(RIALTO_COMPONENT_IPC,
+                                            RIALTO_DEBUG_LEVEL(RIALTO_DEBUG_LEVEL_FATAL | RIALTO_DEBUG_LEVEL_ERROR));
+
+    const unsigned kMaxChannels = (argc > 1) ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 8;
+    const unsigned kNumCalls = (argc > 2) ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 10000;
+    const size_t kReplySize = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 64 * 1024;
+
+    printf("%8s %14s %14s\n", "channels", "calls/s", "calls/s/chan");
+    double singleChannelRate = 0.0;
+    for (unsigned numChannels = 1; numChannels <= kMaxChannels; numChannels *= 2)
+    {
+        const double kRate = runChannels(numChannels, kNumCalls, kReplySize);
+        if (numChannels == 1)
+        {
+            singleChannelRate = kRate;
+        }
+        printf("%8u %14.0f %14.0f (scaling x%.2f)\n", numChannels, kRate, kRate / numChannels,
+               singleChannelRate > 0.0 ? kRate / singleChannelRate : 0.0);
+    }
+
+    return EXIT_SUCCESS;
+}
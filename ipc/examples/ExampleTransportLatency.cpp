@@ -0,0 +1,181 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <IIpcChannel.h>
+#include <IIpcController.h>
+#include <IIpcControllerFactory.h>
+#include <IIpcServer.h>
+#include <IIpcServerFactory.h>
+#include <RialtoLogging.h>
+
+#include "example.pb.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Latency example that measures the round trip time of an echo call over the socket and over the shared memory
+// transport. The server is run on its own thread and talks to a single client over a socket pair.
+//
+// usage: ExampleTransportLatency [calls] [message size in bytes]
+
+class MyExampleService : public ::example::ExampleService
+{
+public:
+    void exampleEcho(google::protobuf::RpcController *controller, const ::example::RequestEcho *request,
+                     ::example::ResponseEcho *response, google::protobuf::Closure *done) override
+    {
+        response->set_text(request->text());
+        done->Run();
+    }
+};
+
+// Callback called when the RPC call completes with either a valid result or error
+static void onComplete(bool *done)
+{
+    *done = true;
+}
+
+// Makes the given number of echo calls and returns the round trip time of each one in microseconds
+static std::vector<double> measure(bool useSharedMemory, unsigned numCalls, size_t messageSize)
+{
+    int socks[2] = {-1, -1};
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0, socks) < 0)
+    {
+        fprintf(stderr, "socketpair failed - %s\n", strerror(errno));
+        return {};
+    }
+
+    auto server = ::firebolt::rialto::ipc::IServerFactory::createFactory()->create();
+    auto client = server->addClient(socks[0]);
+    if (!client)
+    {
+        close(socks[1]);
+        return {};
+    }
+    client->exportService(std::make_shared<MyExampleService>());
+
+    std::atomic<bool> running{true};
+    std::thread serverThread(
+        [&running, server]()
+        {
+            while (running && server->process())
+            {
+                server->wait(10);
+            }
+        });
+
+    std::vector<double> latencies;
+    auto channel = ::firebolt::rialto::ipc::IChannelFactory::createFactory()->createChannel(socks[1]);
+    if (channel && (!useSharedMemory || channel->enableSharedMemoryTransport()))
+    {
+        ::example::ExampleService::Stub stub(channel.get());
+        auto controllerFactory = firebolt::rialto::ipc::IControllerFactory::createFactory();
+
+        ::example::RequestEcho request;
+        request.set_text(std::string(messageSize, 'x'));
+
+        // the first calls negotiate the transport and the method ids, so aren't measured
+        const unsigned kWarmUpCalls = 100;
+        latencies.reserve(numCalls);
+        for (unsigned i = 0; i < kWarmUpCalls + numCalls; ++i)
+        {
+            ::example::ResponseEcho response;
+            auto controller = controllerFactory->create();
+            bool done = false;
+
+            const auto kStart = std::chrono::steady_clock::now();
+            stub.exampleEcho(controller.get(), &request, &response, google::protobuf::NewCallback(onComplete, &done));
+            while (channel->process() && !done)
+            {
+                channel->wait(-1);
+            }
+            const std::chrono::duration<double, std::micro> kElapsed = std::chrono::steady_clock::now() - kStart;
+
+            if (!done || controller->Failed())
+            {
+                fprintf(stderr, "call failed\n");
+                break;
+            }
+            if (i >= kWarmUpCalls)
+            {
+                latencies.push_back(kElapsed.count());
+            }
+        }
+
+        channel->disconnect();
+    }
+
+    running = false;
+    serverThread.join();
+
+    return latencies;
+}
+
+static void report(const char *name, std::vector<double> latencies)
+{
+    if (latencies.empty())
+    {
+        printf("%-14s failed\n", name);
+        return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    double total = 0.0;
+    for (double latency : latencies)
+    {
+        total += latency;
+    }
+
+    const auto kPercentile = [&latencies](double p)
+    { return latencies[std::min(latencies.size() - 1, static_cast<size_t>(p * latencies.size()))]; };
+
+    printf("%-14s %10.1f %10.1f %10.1f %10.1f %10.1f\n", name, latencies.front(), kPercentile(0.5),
+           kPercentile(0.99), latencies.back(), total / latencies.size());
+}
+
+int main(int argc, char *argv[])
+{
+    // verify that the version of the library that we linked against is
+    // compatible with the version of the headers we compiled against.
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    // only report errors, logging would dominate the measurement
+    firebolt::rialto::logging::setLogLevels(RIALTO_COMPONENT_IPC,
+                                            RIALTO_DEBUG_LEVEL(RIALTO_DEBUG_LEVEL_FATAL | RIALTO_DEBUG_LEVEL_ERROR));
+
+    const unsigned kNumCalls = (argc > 1) ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 10000;
+    const size_t kMessageSize = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 64;
+
+    printf("round trip latency of %u calls with %zu byte messages (us)\n", kNumCalls, kMessageSize);
+    printf("%-14s %10s %10s %10s %10s %10s\n", "transport", "min", "median", "p99", "max", "mean");
+    report("socket", measure(false, kNumCalls, kMessageSize));
+    report("shared memory", measure(true, kNumCalls, kMessageSize));
+
+    return EXIT_SUCCESS;
+}
@@ -23,6 +23,7 @@
 #include <google/protobuf/message.h>
 #include <google/protobuf/service.h>
 
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
@@ -127,6 +128,15 @@ public:
     virtual bool isConnected() const = 0;
 };
 
+/**
+ * @brief Counters describing the work done by the server's method call dispatch.
+ */
+struct ServerStats
+{
+    uint64_t calls = 0;      /**< The number of method calls dispatched to services. */
+    uint64_t poolMisses = 0; /**< The number of times the arena, call pool or reply buffers had to grow. */
+};
+
 /**
  * @brief The server object.
  *
@@ -224,6 +234,21 @@ public:
      * @retval false if there was an error, true otherwise
      */
     virtual bool process() = 0;
+
+    /**
+     * @brief Gets the method call dispatch counters.
+     *
+     * \threadsafe
+     *
+     * Requests and responses are allocated from per event loop arenas and recycled objects, so once
+     * warmed up the dispatch of a call shouldn't need to grow them; the poolMisses counter can be used
+     * to check that.  It is not a count of heap allocations, anything else allocated on the heap isn't
+     * counted, for example by protobuf while parsing a message that outgrows the arena block, by the
+     * event queues, by the client objects or by the service handlers.
+     *
+     * @retval the counters.
+     */
+    virtual ServerStats getStats() const = 0;
 };
 
 } // namespace firebolt::rialto::ipc
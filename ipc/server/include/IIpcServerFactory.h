@@ -45,6 +45,21 @@ public:
      * @retval the server instance or null on error.
      */
     virtual std::shared_ptr<IServer> create() = 0;
+
+    /**
+     * @brief Create a IServer object that serves its clients from worker threads.
+     *
+     * Each worker thread runs its own event loop and new clients are given to the loop
+     * serving the fewest clients, so a busy client doesn't hold up the others.  The
+     * listening sockets are still served by process(), which must be called as before.
+     * The messages of a client are always processed in order on the same thread, but the
+     * exported services and callbacks may be called from any of the worker threads.
+     *
+     * @param[in] numWorkerLoops  : The number of worker threads, 0 serves the clients from process().
+     *
+     * @retval the server instance or null on error.
+     */
+    virtual std::shared_ptr<IServer> create(unsigned numWorkerLoops) = 0;
 };
 
 } // namespace firebolt::rialto::ipc
@@ -21,6 +21,14 @@
 #include "IpcServerImpl.h"
 #include <memory>
 
+namespace
+{
+/**
+ * @brief Upper bound on the method ids a client may bind, stops a misbehaving client growing the table.
+ */
+constexpr uint32_t kMaxMethodIds{4096};
+} // namespace
+
 namespace firebolt::rialto::ipc
 {
 ClientImpl::ClientImpl(const std::shared_ptr<ServerImpl> &server, uint64_t clientId, const struct ucred &creds)
@@ -62,7 +70,7 @@ bool ClientImpl::sendEvent(const std::shared_ptr<google::protobuf::Message> &mes
 {
     auto server = m_kServer.lock();
     if (server)
-        return server->sendEvent(m_kClientId, message);
+        return server->sendEvent(*this, message);
     else
         return false;
 }
@@ -76,4 +84,60 @@ bool ClientImpl::isConnected() const
         return false;
 }
 
+bool ClientImpl::bindMethod(uint32_t methodId, const Method &method)
+{
+    if (methodId >= kMaxMethodIds)
+        return false;
+
+    if (methodId >= m_methods.size())
+        m_methods.resize(methodId + 1);
+
+    m_methods[methodId] = method;
+    return true;
+}
+
+const ClientImpl::Method *ClientImpl::findMethod(uint32_t methodId) const
+{
+    if ((methodId >= m_methods.size()) || !m_methods[methodId].descriptor)
+        return nullptr;
+
+    return &m_methods[methodId];
+}
+
+void ClientImpl::setAcceptEventIds()
+{
+    std::lock_guard<std::mutex> locker(m_eventIdsLock);
+    m_acceptEventIds = true;
+}
+
+void ClientImpl::setAcceptOutOfBand()
+{
+    m_acceptOutOfBand = true;
+}
+
+bool ClientImpl::acceptsOutOfBand() const
+{
+    return m_acceptOutOfBand;
+}
+
+bool ClientImpl::getEventId(const google::protobuf::Descriptor *descriptor, uint32_t *eventId, bool *announced)
+{
+    std::lock_guard<std::mutex> locker(m_eventIdsLock);
+    if (!m_acceptEventIds)
+        return false;
+
+    auto it = m_eventIds.try_emplace(descriptor, EventId{static_cast<uint32_t>(m_eventIds.size()), false}).first;
+    *eventId = it->second.id;
+    *announced = it->second.announced;
+    return true;
+}
+
+void ClientImpl::setEventIdAnnounced(const google::protobuf::Descriptor *descriptor)
+{
+    std::lock_guard<std::mutex> locker(m_eventIdsLock);
+    auto it = m_eventIds.find(descriptor);
+    if (it != m_eventIds.end())
+        it->second.announced = true;
+}
+
 } // namespace firebolt::rialto::ipc
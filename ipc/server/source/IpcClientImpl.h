@@ -21,12 +21,16 @@
 #define FIREBOLT_RIALTO_IPC_IPC_CLIENT_IMPL_H_
 
 #include "IIpcServer.h"
+#include "ShmTransport.h"
 
 #include <sys/socket.h>
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace firebolt::rialto::ipc
 {
@@ -55,12 +59,46 @@ protected:
     friend class ServerImpl;
     inline uint64_t id() const { return m_kClientId; }
 
+    struct Method
+    {
+        std::shared_ptr<google::protobuf::Service> service;
+        const google::protobuf::MethodDescriptor *descriptor = nullptr;
+    };
+
+    bool bindMethod(uint32_t methodId, const Method &method);
+    const Method *findMethod(uint32_t methodId) const;
+
+    void setAcceptEventIds();
+    void setAcceptOutOfBand();
+    bool acceptsOutOfBand() const;
+    bool getEventId(const google::protobuf::Descriptor *descriptor, uint32_t *eventId, bool *announced);
+    void setEventIdAnnounced(const google::protobuf::Descriptor *descriptor);
+
 private:
     const std::weak_ptr<ServerImpl> m_kServer;
     const uint64_t m_kClientId{};
     const struct ucred m_kCredentials;
 
     std::map<std::string, std::shared_ptr<google::protobuf::Service>> m_services;
+
+    // only accessed from the server event loop, indexed by the client assigned method id
+    std::vector<Method> m_methods;
+
+    struct EventId
+    {
+        uint32_t id;
+        bool announced;
+    };
+
+    std::mutex m_eventIdsLock;
+    bool m_acceptEventIds = false;
+    std::map<const google::protobuf::Descriptor *, EventId> m_eventIds;
+
+    std::atomic<bool> m_acceptOutOfBand{false};
+
+    // receive side of the shared memory transport, only accessed from the server event loop
+    std::shared_ptr<ShmTransport> m_shmTransport;
+    uint64_t m_socketRecvCount = 0;
 };
 
 } // namespace firebolt::rialto::ipc
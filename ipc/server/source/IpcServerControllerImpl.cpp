@@ -25,9 +25,12 @@
 
 namespace firebolt::rialto::ipc
 {
-ServerControllerImpl::ServerControllerImpl(std::shared_ptr<ClientImpl> client, uint64_t serialId)
-    : m_kClient(std::move(client)), m_kSerialId(serialId)
+void ServerControllerImpl::reset(std::shared_ptr<ClientImpl> client, uint64_t serialId)
 {
+    m_client = std::move(client);
+    m_serialId = serialId;
+    m_failed = false;
+    m_failureReason.clear();
 }
 
 void ServerControllerImpl::SetFailed(const std::string &reason) // NOLINT(build/function_format)
@@ -50,7 +53,7 @@ void ServerControllerImpl::NotifyOnCancel(google::protobuf::Closure *callback) /
 
 std::shared_ptr<IClient> ServerControllerImpl::getClient() const
 {
-    return m_kClient;
+    return m_client;
 }
 
 } // namespace firebolt::rialto::ipc
@@ -69,11 +69,13 @@ public:
 
 protected:
     friend class ServerImpl;
-    ServerControllerImpl(std::shared_ptr<ClientImpl> client, uint64_t serialId);
+    ServerControllerImpl() = default;
 
-    const std::shared_ptr<ClientImpl> m_kClient;
-    const uint64_t m_serialId{};
-    const uint64_t m_kSerialId;
+    void reset(std::shared_ptr<ClientImpl> client, uint64_t serialId);
+
+    // not const as the server recycles controllers between calls
+    std::shared_ptr<ClientImpl> m_client;
+    uint64_t m_serialId = 0;
 
     bool m_failed = false;
     std::string m_failureReason;
@@ -25,7 +25,9 @@
 
 #include "rialtoipc.pb.h"
 
+#include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/service.h>
+#include <google/protobuf/wire_format_lite.h>
 
 #include <algorithm>
 #include <cinttypes>
@@ -47,10 +49,35 @@
 #define WAKE_EVENT_ID uint64_t(0)
 #define FIRST_LISTENING_SOCKET_ID uint64_t(1)
 #define FIRST_CLIENT_ID uint64_t(10000)
+#define SHM_DOORBELL_ID_FLAG (uint64_t(1) << 63)
+
+namespace
+{
+constexpr unsigned kMaxWorkerLoops{16};
+
+// the number of worker loops for servers created without an explicit number, by default the clients
+// are served by the main loop
+unsigned getIpcServerWorkerLoops()
+{
+    const char *kWorkerLoops = getenv("RIALTO_IPC_SERVER_WORKER_LOOPS");
+    unsigned workerLoops = 0;
+    if (kWorkerLoops)
+    {
+        try
+        {
+            workerLoops = static_cast<unsigned>(std::min<unsigned long>(std::stoul(kWorkerLoops), kMaxWorkerLoops));
+        }
+        catch (const std::exception &e)
+        {
+            RIALTO_IPC_LOG_ERROR("Ipc server worker loops invalid, ignoring: %s", kWorkerLoops);
+        }
+    }
+    return workerLoops;
+}
+} // namespace
 
 namespace firebolt::rialto::ipc
 {
-const size_t ServerImpl::m_kMaxMessageLen = (128 * 1024);
 
 std::shared_ptr<IServerFactory> IServerFactory::createFactory()
 {
@@ -69,44 +96,58 @@ std::shared_ptr<IServerFactory> IServerFactory::createFactory()
 
 std::shared_ptr<IServer> ServerFactory::create()
 {
-    return std::make_shared<ServerImpl>();
+    return create(getIpcServerWorkerLoops());
 }
 
-ServerImpl::ServerImpl()
-    : m_pollFd(-1), m_wakeEventFd(-1), m_socketIdCounter(FIRST_LISTENING_SOCKET_ID), m_clientIdCounter(FIRST_CLIENT_ID),
-      m_recvDataBuf{0}, m_recvCtrlBuf{0}
+std::shared_ptr<IServer> ServerFactory::create(unsigned numWorkerLoops)
 {
-    // create the eventfd use to wake the poll loop
-    m_wakeEventFd = eventfd(0, EFD_CLOEXEC);
-    if (m_wakeEventFd < 0)
-    {
-        RIALTO_IPC_LOG_SYS_ERROR(errno, "eventfd failed");
-        return;
-    }
+    auto server = std::make_shared<ServerImpl>(numWorkerLoops);
+    server->startWorkerLoops();
+    return server;
+}
 
-    // create epoll loop
-    m_pollFd = epoll_create1(EPOLL_CLOEXEC);
-    if (m_pollFd < 0)
+ServerImpl::ServerImpl(unsigned numWorkerLoops)
+    : m_socketIdCounter(FIRST_LISTENING_SOCKET_ID), m_clientIdCounter(FIRST_CLIENT_ID),
+      m_callCount(0), m_poolMissCount(0)
+{
+    if (!initEventLoop(&m_mainLoop))
     {
-        RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_create1 failed");
         return;
     }
 
-    // add the wake event to epoll
-    epoll_event event = {.events = EPOLLIN, .data = {.u64 = WAKE_EVENT_ID}};
-    if (epoll_ctl(m_pollFd, EPOLL_CTL_ADD, m_wakeEventFd, &event) != 0)
+    for (unsigned i = 0; i < numWorkerLoops; i++)
     {
-        RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_ctl failed to add eventfd");
+        auto loop = std::make_shared<EventLoop>();
+        if (!initEventLoop(loop.get()))
+        {
+            termEventLoop(loop.get());
+            break;
+        }
+
+        m_workerLoops.emplace_back(std::move(loop));
     }
 }
 
 ServerImpl::~ServerImpl()
 {
-    if ((m_pollFd >= 0) && (close(m_pollFd) != 0))
-        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to close epoll");
+    // stop the worker loops, the last reference to the server may be dropped on a worker thread, in which case
+    // that thread only touches its own loop once the destructor has returned
+    for (const auto &loop : m_workerLoops)
+    {
+        loop->running = false;
+        wakeEventLoop(*loop);
+    }
+    for (const auto &loop : m_workerLoops)
+    {
+        if (loop->thread.get_id() == std::this_thread::get_id())
+            loop->thread.detach();
+        else if (loop->thread.joinable())
+            loop->thread.join();
 
-    if ((m_wakeEventFd >= 0) && (close(m_wakeEventFd) != 0))
-        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to close eventfd");
+        termEventLoop(loop.get());
+    }
+
+    termEventLoop(&m_mainLoop);
 
     for (const auto &entry : m_sockets)
     {
@@ -268,7 +309,7 @@ bool ServerImpl::addSocket(const std::string &socketPath,
 
     // add the socket to epoll
     epoll_event event = {.events = EPOLLIN, .data = {.u64 = kSocketId}};
-    if (epoll_ctl(m_pollFd, EPOLL_CTL_ADD, socket.sockFd, &event) != 0)
+    if (epoll_ctl(m_mainLoop.pollFd, EPOLL_CTL_ADD, socket.sockFd, &event) != 0)
     {
         RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_ctl failed to add listening socket");
 
@@ -316,7 +357,7 @@ bool ServerImpl::addSocket(int fd, const std::function<void(const std::shared_pt
 
     // add the socket to epoll
     epoll_event event = {.events = EPOLLIN, .data = {.u64 = kSocketId}};
-    if (epoll_ctl(m_pollFd, EPOLL_CTL_ADD, socket.sockFd, &event) != 0)
+    if (epoll_ctl(m_mainLoop.pollFd, EPOLL_CTL_ADD, socket.sockFd, &event) != 0)
     {
         RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_ctl failed to add listening socket");
         return false;
@@ -394,43 +435,192 @@ std::shared_ptr<IClient> ServerImpl::addClient(int socketFd,
 
 int ServerImpl::fd() const
 {
-    return m_pollFd;
+    return m_mainLoop.pollFd;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \static
+
+    Creates the epoll instance for an event loop and the eventfd used to wake it.
+
+ */
+bool ServerImpl::initEventLoop(EventLoop *loop)
+{
+    // create the eventfd use to wake the poll loop
+    loop->wakeEventFd = eventfd(0, EFD_CLOEXEC);
+    if (loop->wakeEventFd < 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "eventfd failed");
+        return false;
+    }
+
+    // create epoll loop
+    loop->pollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->pollFd < 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_create1 failed");
+        return false;
+    }
+
+    // add the wake event to epoll
+    epoll_event event = {.events = EPOLLIN, .data = {.u64 = WAKE_EVENT_ID}};
+    if (epoll_ctl(loop->pollFd, EPOLL_CTL_ADD, loop->wakeEventFd, &event) != 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_ctl failed to add eventfd");
+        return false;
+    }
+
+    return true;
+}
+
+void ServerImpl::termEventLoop(EventLoop *loop)
+{
+    if ((loop->pollFd >= 0) && (close(loop->pollFd) != 0))
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to close epoll");
+
+    if ((loop->wakeEventFd >= 0) && (close(loop->wakeEventFd) != 0))
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to close eventfd");
+
+    loop->pollFd = -1;
+    loop->wakeEventFd = -1;
 }
 
 // -----------------------------------------------------------------------------
 /*!
     \internal
+    \static
 
     Writes to the eventfd to wake the event loop.  Typically called when requesting
-    it to shutdown or external code has requested that a client be disconnected.
+    it to shutdown, external code has requested that a client be disconnected or
+    an event has been queued for a client.
 
  */
-void ServerImpl::wakeEventLoop() const
+void ServerImpl::wakeEventLoop(const EventLoop &loop)
 {
-    if (m_wakeEventFd < 0)
+    if (loop.wakeEventFd < 0)
     {
         RIALTO_IPC_LOG_ERROR("invalid wake event fd");
     }
     else
     {
         uint64_t value = 1;
-        if (TEMP_FAILURE_RETRY(::write(m_wakeEventFd, &value, sizeof(value))) != sizeof(value))
+        if (TEMP_FAILURE_RETRY(::write(loop.wakeEventFd, &value, sizeof(value))) != sizeof(value))
         {
             RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to write to the event fd");
         }
     }
 }
 
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Selects the event loop to serve a new client, ie. the worker loop serving
+    the fewest clients or the main loop if there are no worker loops.
+
+    \note Must be called while holding the m_clientsLock mutex.
+
+ */
+ServerImpl::EventLoop *ServerImpl::selectEventLoopNoLock()
+{
+    if (m_workerLoops.empty())
+    {
+        return &m_mainLoop;
+    }
+
+    auto it = std::min_element(m_workerLoops.begin(), m_workerLoops.end(),
+                               [](const std::shared_ptr<EventLoop> &a, const std::shared_ptr<EventLoop> &b)
+                               { return a->numClients < b->numClients; });
+    return it->get();
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Returns the event loop serving the client, or the main loop if the client
+    has already been removed.
+
+    \note Must be called while holding the m_clientsLock mutex.
+
+ */
+ServerImpl::EventLoop &ServerImpl::clientEventLoopNoLock(uint64_t clientId)
+{
+    auto it = m_clients.find(clientId);
+    if ((it == m_clients.end()) || !it->second.loop)
+    {
+        return m_mainLoop;
+    }
+
+    return *it->second.loop;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Starts a thread for each of the worker loops, this is called by the factory
+    once the server is owned by a shared_ptr as the threads only hold a weak
+    reference to the server.
+
+ */
+void ServerImpl::startWorkerLoops()
+{
+    for (const auto &loop : m_workerLoops)
+    {
+        loop->thread = std::thread(&ServerImpl::workerLoopThread, weak_from_this(), loop);
+    }
+
+    if (!m_workerLoops.empty())
+    {
+        RIALTO_IPC_LOG_INFO("serving clients from %zu worker loops", m_workerLoops.size());
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    The thread function of a worker loop, which processes the events of the
+    clients assigned to it until the server is destroyed.
+
+    A strong reference to the server is only held while processing events, so
+    the server can't be destroyed while waiting on the epoll.  If the last
+    reference is dropped on this thread then the server is destroyed when
+    \a server goes out of scope, after which only \a loop may be touched.
+
+ */
+void ServerImpl::workerLoopThread(std::weak_ptr<ServerImpl> weakServer, std::shared_ptr<EventLoop> loop)
+{
+    const int kMaxEvents = 32;
+    struct epoll_event events[kMaxEvents];
+
+    while (loop->running)
+    {
+        int numEvents = waitEventLoop(*loop, events, kMaxEvents, -1);
+        if (numEvents < 0)
+            break;
+
+        std::shared_ptr<ServerImpl> server = weakServer.lock();
+        if (!server)
+            break;
+
+        server->processEvents(*loop, events, numEvents);
+    }
+}
+
 bool ServerImpl::wait(int timeoutMSecs)
 {
-    if (m_pollFd < 0)
+    if (m_mainLoop.pollFd < 0)
     {
         return false;
     }
 
     // wait for any event (with timeout)
     struct pollfd fds[2];
-    fds[0].fd = m_pollFd;
+    fds[0].fd = m_mainLoop.pollFd;
     fds[0].events = POLLIN;
 
     int rc = TEMP_FAILURE_RETRY(poll(fds, 1, timeoutMSecs));
@@ -445,25 +635,81 @@ bool ServerImpl::wait(int timeoutMSecs)
 
 bool ServerImpl::process()
 {
-    if (m_pollFd < 0)
-    {
-        RIALTO_IPC_LOG_ERROR("missing epoll");
-        return false;
-    }
+    return processEventLoop(m_mainLoop, 0);
+}
+
+ServerStats ServerImpl::getStats() const
+{
+    ServerStats stats;
+    stats.calls = m_callCount;
+    stats.poolMisses = m_poolMissCount;
+    return stats;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Waits up to \a timeoutMSecs for events on the epoll of \a loop and then
+    processes them, followed by sending any queued events and cleaning up any
+    condemned clients served by the loop.
 
+ */
+bool ServerImpl::processEventLoop(EventLoop &loop, int timeoutMSecs)
+{
     // read up to 32 events
     const int kMaxEvents = 32;
     struct epoll_event events[kMaxEvents];
 
-    int rc = TEMP_FAILURE_RETRY(epoll_wait(m_pollFd, events, kMaxEvents, 0));
+    int rc = waitEventLoop(loop, events, kMaxEvents, timeoutMSecs);
     if (rc < 0)
     {
-        RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_wait failed");
         return false;
     }
 
+    processEvents(loop, events, rc);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Waits up to \a timeoutMSecs for at most \a maxEvents events on the epoll of
+    \a loop, returning the number of events or -1 on failure.
+
+ */
+int ServerImpl::waitEventLoop(const EventLoop &loop, struct epoll_event *events, int maxEvents, int timeoutMSecs)
+{
+    if (loop.pollFd < 0)
+    {
+        RIALTO_IPC_LOG_ERROR("missing epoll");
+        return -1;
+    }
+
+    int rc = TEMP_FAILURE_RETRY(epoll_wait(loop.pollFd, events, maxEvents, timeoutMSecs));
+    if (rc < 0)
+    {
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_wait failed");
+        return -1;
+    }
+
+    return rc;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Processes the \a numEvents events read from the epoll of \a loop, followed
+    by sending any queued events and cleaning up any condemned clients served by
+    the loop.
+
+ */
+void ServerImpl::processEvents(EventLoop &loop, const struct epoll_event *events, int numEvents)
+{
     // process the events (maybe 0 if timed out)
-    for (int i = 0; i < rc; i++)
+    for (int i = 0; i < numEvents; i++)
     {
         const struct epoll_event &kEvent = events[i];
 
@@ -471,12 +717,18 @@ bool ServerImpl::process()
         if (kEvent.data.u64 == WAKE_EVENT_ID)
         {
             uint64_t ignore;
-            if (TEMP_FAILURE_RETRY(::read(m_wakeEventFd, &ignore, sizeof(ignore))) != sizeof(ignore))
+            if (TEMP_FAILURE_RETRY(::read(loop.wakeEventFd, &ignore, sizeof(ignore))) != sizeof(ignore))
             {
                 RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to read wake eventfd");
             }
         }
 
+        // check for a client's shared memory transport doorbell
+        else if (kEvent.data.u64 & SHM_DOORBELL_ID_FLAG)
+        {
+            processClientDoorbell(loop, kEvent.data.u64 & ~SHM_DOORBELL_ID_FLAG);
+        }
+
         // check for events on the listening socket
         else if (kEvent.data.u64 < FIRST_CLIENT_ID)
         {
@@ -489,61 +741,93 @@ bool ServerImpl::process()
         // otherwise, the event must have come from a socket
         else
         {
-            processClientSocket(kEvent.data.u64, kEvent.events);
+            processClientSocket(loop, kEvent.data.u64, kEvent.events);
         }
     }
 
-    // if we have client sockets that are condemned then we need to shut down
-    // and close them as well as remove from epoll
+    // send any events queued while processing, or by other threads
+    flushEvents(loop);
+
+    cleanupCondemnedClients(loop);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    If we have client sockets served by \a loop that are condemned then we need
+    to shut down and close them as well as remove from epoll.
+
+ */
+void ServerImpl::cleanupCondemnedClients(EventLoop &loop)
+{
     std::unique_lock<std::mutex> locker(m_clientsLock);
-    if (!m_condemnedClients.empty())
+    if (m_condemnedClients.empty())
     {
-        // take a copy of the set so we can process without the lock held
-        std::set<uint64_t> theCondemned;
-        m_condemnedClients.swap(theCondemned);
+        return;
+    }
 
-        for (uint64_t clientId : theCondemned)
+    // take the clients served by this loop so we can process without the lock held
+    std::set<uint64_t> theCondemned;
+    for (auto it = m_condemnedClients.begin(); it != m_condemnedClients.end();)
+    {
+        if (&clientEventLoopNoLock(*it) == &loop)
         {
-            auto it = m_clients.find(clientId);
-            if (it == m_clients.end())
-            {
-                RIALTO_IPC_LOG_ERROR("failed to find condemned client");
-                continue;
-            }
-
-            ClientDetails details = it->second;
+            theCondemned.insert(*it);
+            it = m_condemnedClients.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
 
-            // remove from the list of clients
-            m_clients.erase(it);
+    for (uint64_t clientId : theCondemned)
+    {
+        auto it = m_clients.find(clientId);
+        if (it == m_clients.end())
+        {
+            RIALTO_IPC_LOG_ERROR("failed to find condemned client");
+            continue;
+        }
 
-            // drop the lock while closing the connection and removing from epoll
-            locker.unlock();
+        ClientDetails details = it->second;
 
-            // remove the socket from epoll and close it
-            if (details.sock >= 0)
-            {
-                if (epoll_ctl(m_pollFd, EPOLL_CTL_DEL, details.sock, nullptr) != 0)
-                    RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to remove socket from epoll");
+        // remove from the list of clients
+        m_clients.erase(it);
+        loop.numClients--;
+        loop.clientsWithEvents.erase(clientId);
 
-                if (shutdown(details.sock, SHUT_RDWR) != 0)
-                    RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to shutdown socket");
-                if (close(details.sock) != 0)
-                    RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to close socket");
-            }
+        // drop the lock while closing the connection and removing from epoll
+        locker.unlock();
 
-            // let the installed handler know a client has disconnected
-            if (details.disconnectedCb)
-                details.disconnectedCb(details.client);
+        if (details.shmTransport &&
+            (epoll_ctl(loop.pollFd, EPOLL_CTL_DEL, details.shmTransport->rxDoorbellFd(), nullptr) != 0))
+            RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to remove shared memory doorbell from epoll");
 
-            // ensure client object is destructed without the client lock held
-            details.client.reset();
+        // remove the socket from epoll and close it, the socket may not have been added if the client
+        // was disconnected from the connected callback
+        if (details.sock >= 0)
+        {
+            if ((epoll_ctl(loop.pollFd, EPOLL_CTL_DEL, details.sock, nullptr) != 0) && (errno != ENOENT))
+                RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to remove socket from epoll");
 
-            // re-take the lock for the next client
-            locker.lock();
+            if (shutdown(details.sock, SHUT_RDWR) != 0)
+                RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to shutdown socket");
+            if (close(details.sock) != 0)
+                RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to close socket");
         }
-    }
 
-    return true;
+        // let the installed handler know a client has disconnected
+        if (details.disconnectedCb)
+            details.disconnectedCb(details.client);
+
+        // ensure client object is destructed without the client lock held
+        details.client.reset();
+
+        // re-take the lock for the next client
+        locker.lock();
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -554,11 +838,18 @@ bool ServerImpl::process()
     when a new connection is accepted on a listening socket, or when a client
     fd is added via ServerImpl::addClient(...).
 
+    The client is given to the event loop with the fewest clients.  If set, the
+    \a connectedCb is called before the socket is added to the loop, so the
+    handler can export its services before any message from the client is
+    processed on another thread.
+
     Returns a nullptr if failed to add the socket.
 
  */
-std::shared_ptr<ClientImpl> ServerImpl::addClientSocket(int socketFd, const std::string &listeningSocketPath,
-                                                        std::function<void(const std::shared_ptr<IClient> &)> disconnectedCb)
+std::shared_ptr<ClientImpl>
+ServerImpl::addClientSocket(int socketFd, const std::string &listeningSocketPath,
+                            std::function<void(const std::shared_ptr<IClient> &)> disconnectedCb,
+                            const std::function<void(const std::shared_ptr<IClient> &)> &connectedCb)
 {
     // get the client credentials
     struct ucred clientCreds = {0};
@@ -574,14 +865,6 @@ std::shared_ptr<ClientImpl> ServerImpl::addClientSocket(int socketFd, const std:
     // create a new unique client id for the connection
     const uint64_t kClientId = m_clientIdCounter++;
 
-    // add the new socket to the poll loop
-    epoll_event event = {.events = EPOLLIN, .data = {.u64 = kClientId}};
-    if (epoll_ctl(m_pollFd, EPOLL_CTL_ADD, socketFd, &event) != 0)
-    {
-        RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_ctl failed to add client socket");
-        return nullptr;
-    }
-
     // create initial client object for the socket
     auto client = std::make_shared<ClientImpl>(shared_from_this(), kClientId, clientCreds);
 
@@ -592,13 +875,44 @@ std::shared_ptr<ClientImpl> ServerImpl::addClientSocket(int socketFd, const std:
     clientDetails.client = client;
 
     // add to the set of clients
+    EventLoop *loop;
     {
         std::lock_guard<std::mutex> locker(m_clientsLock);
+        loop = selectEventLoopNoLock();
+        loop->numClients++;
+        clientDetails.loop = loop;
         m_clients.emplace(kClientId, clientDetails);
     }
 
     RIALTO_IPC_LOG_INFO("new client connected - giving id %" PRIu64, kClientId);
 
+    // notify the handler that a new connection has been made
+    if (connectedCb)
+    {
+        connectedCb(client);
+    }
+
+    // add the new socket to the poll loop, unless the client has already been cleaned up
+    {
+        std::lock_guard<std::mutex> locker(m_clientsLock);
+        if (m_clients.count(kClientId) == 0)
+        {
+            return client;
+        }
+
+        epoll_event event = {.events = EPOLLIN, .data = {.u64 = kClientId}};
+        if (epoll_ctl(loop->pollFd, EPOLL_CTL_ADD, socketFd, &event) == 0)
+        {
+            return client;
+        }
+
+        RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_ctl failed to add client socket");
+        m_condemnedClients.insert(kClientId);
+    }
+
+    // the socket is owned by the client now, so it is closed when the loop removes the condemned client
+    wakeEventLoop(*loop);
+
     return client;
 }
 
@@ -650,19 +964,11 @@ void ServerImpl::processNewConnection(uint64_t socketId)
         disconnectedCb = kSocket.disconnectedCb;
     }
 
-    // attempt to add the socket to the client list
-    auto client = addClientSocket(clientSock, sockPath, std::move(disconnectedCb));
+    // attempt to add the socket to the client list, this notifies the handler that a new connection has been made
+    auto client = addClientSocket(clientSock, sockPath, std::move(disconnectedCb), connectedCb);
     if (!client)
     {
         close(clientSock);
-        return;
-    }
-
-    // notify the handler that a new connection has been made
-    if (connectedCb)
-    {
-        // tell the handler we have a new client
-        connectedCb(client);
     }
 }
 
@@ -739,7 +1045,7 @@ static std::vector<FileDescriptor> readMessageFds(const struct msghdr *msg, size
     Processes an event from a client socket.
 
  */
-void ServerImpl::processClientSocket(uint64_t clientId, unsigned events)
+void ServerImpl::processClientSocket(EventLoop &loop, uint64_t clientId, unsigned events)
 {
     int sockFd;
     std::shared_ptr<ClientImpl> clientObj;
@@ -784,14 +1090,30 @@ void ServerImpl::processClientSocket(uint64_t clientId, unsigned events)
         // or EWOULDBLOCK is returned on a read (ie. no more messages to read)
         while (true)
         {
+            // clients that haven't done the connection setup may send messages up to the old inline limit, which
+            // don't fit the loop's buffer, so their messages are peeked at to get the size first
+            uint8_t *dataBuf = loop.recvDataBuf;
+            size_t dataBufSize = sizeof(loop.recvDataBuf);
+            std::unique_ptr<uint8_t[]> legacyDataBuf;
+            if (!clientObj->acceptsOutOfBand())
+            {
+                ssize_t len = TEMP_FAILURE_RETRY(recv(sockFd, nullptr, 0, MSG_PEEK | MSG_TRUNC));
+                if (len > static_cast<ssize_t>(dataBufSize))
+                {
+                    dataBufSize = OutOfBandPayload::kMaxInlineMessageSize;
+                    legacyDataBuf.reset(new uint8_t[dataBufSize]);
+                    dataBuf = legacyDataBuf.get();
+                }
+            }
+
             struct msghdr msg = {nullptr};
-            struct iovec io = {.iov_base = m_recvDataBuf, .iov_len = sizeof(m_recvDataBuf)};
+            struct iovec io = {.iov_base = dataBuf, .iov_len = dataBufSize};
 
             bzero(&msg, sizeof(msg));
             msg.msg_iov = &io;
             msg.msg_iovlen = 1;
-            msg.msg_control = m_recvCtrlBuf;
-            msg.msg_controllen = sizeof(m_recvCtrlBuf);
+            msg.msg_control = loop.recvCtrlBuf;
+            msg.msg_controllen = sizeof(loop.recvCtrlBuf);
 
             // read one message
             ssize_t rd = TEMP_FAILURE_RETRY(recvmsg(sockFd, &msg, MSG_CMSG_CLOEXEC));
@@ -813,26 +1135,33 @@ void ServerImpl::processClientSocket(uint64_t clientId, unsigned events)
 
                 break;
             }
-            else if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
-            {
-                RIALTO_IPC_LOG_WARN("received message from client %" PRIu64 " truncated, discarding", clientId);
-
-                // make sure to close all the fds, otherwise we'll leak them
-                readMessageFds(&msg, 16);
-            }
             else
             {
+                // any messages the client put on the shared memory ring before sending this one must go first
+                processClientShmMessages(loop, clientObj);
+                clientObj->m_socketRecvCount++;
+
+                if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
+                {
+                    RIALTO_IPC_LOG_WARN("received message from client %" PRIu64 " truncated, discarding", clientId);
+
+                    // make sure to close all the fds, otherwise we'll leak them
+                    readMessageFds(&msg, 16);
+                }
                 // if there is control data then assume fd(s) have been passed
-                if (msg.msg_controllen > 0)
+                else if (msg.msg_controllen > 0)
                 {
-                    processClientMessage(clientObj, m_recvDataBuf, rd, readMessageFds(&msg, 16));
+                    processClientMessage(loop, clientObj, dataBuf, rd, readMessageFds(&msg, 32));
                 }
                 else
                 {
-                    processClientMessage(clientObj, m_recvDataBuf, rd);
+                    processClientMessage(loop, clientObj, dataBuf, rd);
                 }
             }
         }
+
+        // and then any sent after the last socket message
+        processClientShmMessages(loop, clientObj);
     }
 }
 
@@ -840,7 +1169,66 @@ void ServerImpl::processClientSocket(uint64_t clientId, unsigned events)
 /*!
     \internal
 
-    Places the received file descriptors into the request message.
+    Called when the client has rung the doorbell of its shared memory transport
+    to say there are messages on the ring.
+
+ */
+void ServerImpl::processClientDoorbell(EventLoop &loop, uint64_t clientId)
+{
+    std::shared_ptr<ClientImpl> clientObj;
+    {
+        std::lock_guard<std::mutex> locker(m_clientsLock);
+
+        auto it = m_clients.find(clientId);
+        if ((it == m_clients.end()) || (m_condemnedClients.count(clientId) != 0))
+        {
+            return;
+        }
+
+        clientObj = it->second.client;
+    }
+
+    if (clientObj->m_shmTransport)
+    {
+        clientObj->m_shmTransport->clearDoorbell();
+        processClientShmMessages(loop, clientObj);
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Processes the messages on the client's shared memory ring that were sent
+    before its next, not yet received, socket message.  Once done the client is
+    told we're waiting so it rings the doorbell for the next message.
+
+ */
+void ServerImpl::processClientShmMessages(EventLoop &loop, const std::shared_ptr<ClientImpl> &client)
+{
+    const std::shared_ptr<ShmTransport> &kTransport = client->m_shmTransport;
+    if (!kTransport)
+        return;
+
+    uint64_t tag;
+    const uint8_t *data;
+    size_t dataLen;
+    do
+    {
+        while (kTransport->peek(&tag, &data, &dataLen) && (tag <= client->m_socketRecvCount))
+        {
+            processClientMessage(loop, client, data, dataLen);
+            kTransport->consume();
+        }
+    } while (kTransport->prepareToWait() && kTransport->peek(&tag, &data, &dataLen) &&
+             (tag <= client->m_socketRecvCount));
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Places the received file descriptors into the request message.
 
     It works by iterating over the fields in the message, finding ones that are
     marked as 'field_is_fd' and then replacing the received integer value with
@@ -898,31 +1286,73 @@ static bool addRequestFileDescriptors(google::protobuf::Message *request, const
 /*!
     \internal
 
-    Processes a message received on a client socket.
+    Processes a message received on a client socket or shared memory ring.
+
+    The message, and the request of a method call in it, are parsed into an
+    arena that starts with the block reserved in \a loop, so only messages too
+    big for that block need the heap.  The arena is freed once the message has
+    been dispatched, a service that completes the call later must not hold on
+    to the request.
+
+    A message sent out of band is parsed from the memfd attached as the last of
+    the \a fds.
 
  */
-void ServerImpl::processClientMessage(const std::shared_ptr<ClientImpl> &client, const uint8_t *data, size_t dataLen,
-                                      const std::vector<FileDescriptor> &fds)
+void ServerImpl::processClientMessage(EventLoop &loop, const std::shared_ptr<ClientImpl> &client, const uint8_t *data,
+                                      size_t dataLen, std::vector<FileDescriptor> fds)
 {
     RIALTO_IPC_LOG_DEBUG("processing client message of size %zu bytes (%zu fds) from client %" PRId64, dataLen,
                          fds.size(), client->id());
 
+    google::protobuf::ArenaOptions arenaOptions;
+    arenaOptions.initial_block = reinterpret_cast<char *>(loop.arenaBlock);
+    arenaOptions.initial_block_size = sizeof(loop.arenaBlock);
+    google::protobuf::Arena arena(arenaOptions);
+
     // parse the message
-    transport::MessageToServer message;
-    if (!message.ParseFromArray(data, static_cast<int>(dataLen)))
+    auto *message = google::protobuf::Arena::CreateMessage<transport::MessageToServer>(&arena);
+    if (!message->ParseFromArray(data, static_cast<int>(dataLen)))
     {
         RIALTO_IPC_LOG_ERROR("invalid request");
         return;
     }
 
-    if (message.has_call())
+    std::unique_ptr<OutOfBandPayload> payload;
+    if (message->has_out_of_band())
+    {
+        if (fds.empty())
+        {
+            RIALTO_IPC_LOG_ERROR("out of band message from client without a payload");
+            return;
+        }
+
+        payload = OutOfBandPayload::map(fds.back(), message->out_of_band().size());
+        fds.pop_back();
+        if (!payload || !message->ParseFromArray(payload->data(), static_cast<int>(payload->size())) ||
+            message->has_out_of_band())
+        {
+            RIALTO_IPC_LOG_ERROR("invalid out of band message from client");
+            return;
+        }
+    }
+
+    if (message->has_call())
     {
-        processMethodCall(client, message.call(), fds);
+        processMethodCall(&arena, client, message->call(), fds);
+    }
+    else if (message->has_shm_transport_setup())
+    {
+        processShmTransportSetup(client, message->shm_transport_setup(), fds);
     }
     else
     {
         RIALTO_IPC_LOG_WARN("received unknown message type from client");
     }
+
+    if (arena.SpaceAllocated() > sizeof(loop.arenaBlock))
+    {
+        m_poolMissCount++;
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -932,38 +1362,71 @@ void ServerImpl::processClientMessage(const std::shared_ptr<ClientImpl> &client,
     Processes a method call requst from a client.
 
  */
-void ServerImpl::processMethodCall(const std::shared_ptr<ClientImpl> &client, const transport::MethodCall &call,
-                                   const std::vector<FileDescriptor> &fds)
+void ServerImpl::processMethodCall(google::protobuf::Arena *arena, const std::shared_ptr<ClientImpl> &client,
+                                   const transport::MethodCall &call, const std::vector<FileDescriptor> &fds)
 {
-    // try and find the service with the given name
-    const std::string &kServiceName = call.service_name();
-    auto it = client->m_services.find(kServiceName);
-    if (it == client->m_services.end())
+    if (!call.has_service_name() && !call.has_method_id())
     {
-        RIALTO_IPC_LOG_ERROR("unknown service request '%s'", kServiceName.c_str());
-
-        sendErrorReply(client, call.serial_id(), "Unknown service '%s'", kServiceName.c_str());
+        processConnectionSetup(client, call);
         return;
     }
 
-    std::shared_ptr<google::protobuf::Service> service = it->second;
+    std::shared_ptr<google::protobuf::Service> service;
+    const google::protobuf::MethodDescriptor *kMethod = nullptr;
 
-    // try and find the method
-    const std::string &kMethodName = call.method_name();
-    const google::protobuf::MethodDescriptor *kMethod = service->GetDescriptor()->FindMethodByName(kMethodName);
-    if (!kMethod)
+    if (!call.has_service_name() && call.has_method_id())
     {
-        RIALTO_IPC_LOG_ERROR("no method with name '%s'", kMethodName.c_str());
+        // fast path, the method was bound to the id by an earlier call
+        const ClientImpl::Method *kBound = client->findMethod(call.method_id());
+        if (!kBound)
+        {
+            RIALTO_IPC_LOG_ERROR("unknown method id %u", call.method_id());
 
-        sendErrorReply(client, call.serial_id(), "Unknown method '%s'", kMethodName.c_str());
-        return;
+            sendErrorReply(client, call.serial_id(), "Unknown method id %u", call.method_id());
+            return;
+        }
+
+        service = kBound->service;
+        kMethod = kBound->descriptor;
+    }
+    else
+    {
+        // try and find the service with the given name
+        const std::string &kServiceName = call.service_name();
+        auto it = client->m_services.find(kServiceName);
+        if (it == client->m_services.end())
+        {
+            RIALTO_IPC_LOG_ERROR("unknown service request '%s'", kServiceName.c_str());
+
+            sendErrorReply(client, call.serial_id(), "Unknown service '%s'", kServiceName.c_str());
+            return;
+        }
+
+        service = it->second;
+
+        // try and find the method
+        const std::string &kMethodName = call.method_name();
+        kMethod = service->GetDescriptor()->FindMethodByName(kMethodName);
+        if (!kMethod)
+        {
+            RIALTO_IPC_LOG_ERROR("no method with name '%s'", kMethodName.c_str());
+
+            sendErrorReply(client, call.serial_id(), "Unknown method '%s'", kMethodName.c_str());
+            return;
+        }
+
+        // bind the id so subsequent calls can skip the name lookups
+        if (call.has_method_id() && !client->bindMethod(call.method_id(), ClientImpl::Method{service, kMethod}))
+        {
+            RIALTO_IPC_LOG_WARN("failed to bind method id %u to '%s'", call.method_id(), kMethod->full_name().c_str());
+        }
     }
 
     // check if the method is expecting a reply
     const bool kNoReply = kMethod->options().HasExtension(no_reply) && kMethod->options().GetExtension(no_reply);
 
-    // parse the request data
-    google::protobuf::Message *requestMessage = service->GetRequestPrototype(kMethod).New();
+    // parse the request data, the request is owned by the arena
+    google::protobuf::Message *requestMessage = service->GetRequestPrototype(kMethod).New(arena);
     if (!requestMessage->ParseFromString(call.request_message()))
     {
         RIALTO_IPC_LOG_ERROR("failed to parse method from array");
@@ -974,33 +1437,199 @@ void ServerImpl::processMethodCall(const std::shared_ptr<ClientImpl> &client, co
     }
     else
     {
-        RIALTO_IPC_LOG_DEBUG("call{ serial %" PRIu64 " } - %s.%s { %s }", call.serial_id(), kServiceName.c_str(),
-                             kMethodName.c_str(), requestMessage->ShortDebugString().c_str());
+        if (RIALTO_IPC_IS_DEBUG_LOGGED())
+        {
+            RIALTO_IPC_LOG_DEBUG("call{ serial %" PRIu64 " } - %s { %s }", call.serial_id(),
+                                 kMethod->full_name().c_str(), requestMessage->ShortDebugString().c_str());
+        }
 
-        auto *controller = new ServerControllerImpl(client, call.serial_id());
+        m_callCount++;
 
         if (kNoReply)
         {
             // we should not send a reply for this call, so call the code to handle the
-            // request, but no need to pass a controller, response or closure object
+            // request, but no need to pass a response or closure object
+            PendingCall *pendingCall = acquireCall(client, call.serial_id(), nullptr);
+
             static google::protobuf::internal::FunctionClosure0 nullClosure(&google::protobuf::DoNothing, false);
-            service->CallMethod(kMethod, controller, requestMessage, nullptr, &nullClosure);
+            service->CallMethod(kMethod, pendingCall->controller.get(), requestMessage, nullptr, &nullClosure);
 
-            delete controller;
+            releaseCall(pendingCall);
         }
         else
         {
-            // create a response
-            google::protobuf::Message *responseMessage = service->GetResponsePrototype(kMethod).New();
+            // get a recycled controller and response, the pending call is also the closure that sends the reply
+            PendingCall *pendingCall = acquireCall(client, call.serial_id(), &service->GetResponsePrototype(kMethod));
 
             // this is finally where we call the service implementation to process the request
-            service->CallMethod(kMethod, controller, requestMessage, responseMessage,
-                                google::protobuf::NewCallback(this, &ServerImpl::handleResponse, controller,
-                                                              responseMessage));
+            service->CallMethod(kMethod, pendingCall->controller.get(), requestMessage, pendingCall->response.get(),
+                                pendingCall);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Processes the connection setup call, which the client sends as its first
+    message to say what it supports.  The reply says what we support, from then
+    on larger messages are sent out of band in both directions.
+
+    The out of band flag is set while holding the clients lock so any event
+    queued after the reply was built knowing the client's inline limit, see
+    sendEvent().
+
+ */
+void ServerImpl::processConnectionSetup(const std::shared_ptr<ClientImpl> &client, const transport::MethodCall &call)
+{
+    RIALTO_IPC_LOG_DEBUG("connection setup from client %" PRIu64 " - event ids %d, out of band %d", client->id(),
+                         call.accept_event_ids(), call.accept_out_of_band());
+
+    if (call.accept_event_ids())
+    {
+        client->setAcceptEventIds();
+    }
+    if (call.accept_out_of_band())
+    {
+        std::lock_guard<std::mutex> locker(m_clientsLock);
+        client->setAcceptOutOfBand();
+    }
+
+    transport::MessageFromServer message;
+    transport::MethodCallReply *reply = message.mutable_reply();
+    reply->set_reply_id(call.serial_id());
+    reply->set_accept_method_ids(true);
+    reply->set_accept_out_of_band(true);
+
+    std::string data = message.SerializeAsString();
+    struct iovec iov = {.iov_base = data.data(), .iov_len = data.size()};
+    struct msghdr header = {nullptr};
+    header.msg_iov = &iov;
+    header.msg_iovlen = 1;
+
+    sendReply(client->id(), &header);
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Processes a request from the client to use the shared memory transport,
+    the memfd and the two doorbell eventfds are passed with the request.  The
+    client is always told whether the transport was accepted, any message sent
+    after that reply may then go on the shared memory ring.
+
+ */
+void ServerImpl::processShmTransportSetup(const std::shared_ptr<ClientImpl> &client,
+                                          const transport::SharedMemoryTransportSetup &setup,
+                                          const std::vector<FileDescriptor> &fds)
+{
+    std::shared_ptr<ShmTransport> shmTransport;
+    if (client->m_shmTransport)
+    {
+        RIALTO_IPC_LOG_ERROR("client %" PRIu64 " already has a shared memory transport", client->id());
+    }
+    else if (fds.size() != 3)
+    {
+        RIALTO_IPC_LOG_ERROR("shared memory transport setup has %zu fds, expected 3", fds.size());
+    }
+    else
+    {
+        shmTransport = ShmTransport::attach(fds[0], fds[1], fds[2], setup.ring_capacity());
+    }
+
+    if (shmTransport)
+    {
+        // the doorbell is added to the loop serving the client, which is the one processing this message
+        int pollFd;
+        {
+            std::lock_guard<std::mutex> locker(m_clientsLock);
+            pollFd = clientEventLoopNoLock(client->id()).pollFd;
+        }
+
+        epoll_event event = {.events = EPOLLIN, .data = {.u64 = client->id() | SHM_DOORBELL_ID_FLAG}};
+        if (epoll_ctl(pollFd, EPOLL_CTL_ADD, shmTransport->rxDoorbellFd(), &event) != 0)
+        {
+            RIALTO_IPC_LOG_SYS_ERROR(errno, "epoll_ctl failed to add shared memory doorbell");
+            shmTransport.reset();
         }
     }
 
-    delete requestMessage;
+    transport::MessageFromServer message;
+    message.mutable_shm_transport_ready()->set_accepted(shmTransport != nullptr);
+    std::string data = message.SerializeAsString();
+
+    struct iovec iov = {.iov_base = data.data(), .iov_len = data.size()};
+    struct msghdr header = {nullptr};
+    header.msg_iov = &iov;
+    header.msg_iovlen = 1;
+
+    {
+        std::lock_guard<std::mutex> locker(m_clientsLock);
+
+        auto it = m_clients.find(client->id());
+        if ((it == m_clients.end()) || (it->second.sock < 0))
+        {
+            RIALTO_IPC_LOG_WARN("socket closed before shared memory transport reply could be sent");
+            return;
+        }
+
+        // events queued before the reply must be sent on the socket, the client isn't reading the ring yet
+        flushEventsNoLock(it->second);
+        if (TEMP_FAILURE_RETRY(sendmsg(it->second.sock, &header, MSG_NOSIGNAL)) != static_cast<ssize_t>(data.size()))
+        {
+            RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send shared memory transport reply");
+            return;
+        }
+
+        // the client counts our socket messages from the one after the reply
+        if (shmTransport)
+        {
+            it->second.shmTransport = shmTransport;
+            it->second.socketSendCount = 0;
+        }
+    }
+
+    if (shmTransport)
+    {
+        // and we count its socket messages from the one after the setup request
+        client->m_shmTransport = std::move(shmTransport);
+        client->m_socketRecvCount = 0;
+
+        RIALTO_IPC_LOG_INFO("client %" PRIu64 " is using shared memory transport", client->id());
+    }
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \static
+
+    Sends a message to a client.  If the client has enabled the shared memory
+    transport and the message carries no fds then it is put on the shared
+    memory ring, tagged with the number of socket messages sent so far so the
+    client can process it in the right order relative to those.  If the ring is
+    full, or the message is too big for it, the socket is used.
+
+    \note Must be called while holding the m_clientsLock mutex.
+
+ */
+bool ServerImpl::sendToClientNoLock(ClientDetails &details, const msghdr *msg, size_t dataLen)
+{
+    if (details.shmTransport && (msg->msg_controllen == 0) &&
+        details.shmTransport->send(details.socketSendCount, msg->msg_iov->iov_base, dataLen))
+    {
+        return true;
+    }
+
+    if (TEMP_FAILURE_RETRY(sendmsg(details.sock, msg, MSG_NOSIGNAL)) != static_cast<ssize_t>(dataLen))
+    {
+        return false;
+    }
+
+    details.socketSendCount++;
+    return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -1008,10 +1637,11 @@ void ServerImpl::processMethodCall(const std::shared_ptr<ClientImpl> &client, co
     \internal
     \threadsafe
 
-    Sends a message to the given client if still connected.
+    Sends a message to the given client if still connected.  Any events queued
+    for the client are sent first, so the client sees them before the reply.
 
  */
-void ServerImpl::sendReply(uint64_t clientId, const std::shared_ptr<msghdr> &msg)
+void ServerImpl::sendReply(uint64_t clientId, const msghdr *msg)
 {
     // now take the lock (so the socket is not closed beneath us) and send the reply
     std::lock_guard<std::mutex> locker(m_clientsLock);
@@ -1029,10 +1659,13 @@ void ServerImpl::sendReply(uint64_t clientId, const std::shared_ptr<msghdr> &msg
     {
         RIALTO_IPC_LOG_WARN("invalid msg to send on socket, ignoring");
     }
-    else if (TEMP_FAILURE_RETRY(sendmsg(it->second.sock, msg.get(), MSG_NOSIGNAL)) !=
-             static_cast<ssize_t>(msg->msg_iov->iov_len))
+    else
     {
-        RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send the complete error reply message");
+        flushEventsNoLock(it->second);
+        if (!sendToClientNoLock(it->second, msg, msg->msg_iov->iov_len))
+        {
+            RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send the complete error reply message");
+        }
     }
 }
 
@@ -1056,7 +1689,100 @@ void ServerImpl::sendErrorReply(const std::shared_ptr<ClientImpl> &client, uint6
     auto msg = populateErrorReply(client, serialId, reason);
 
     // and send it
-    sendReply(client->id(), msg);
+    sendReply(client->id(), msg.get());
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \threadsafe
+
+    Gets a recycled pending call for a call from \a client, along with a
+    cleared response of the type of \a responsePrototype if not null.  Any
+    objects that have to be created are counted as heap allocations.
+
+ */
+ServerImpl::PendingCall *ServerImpl::acquireCall(const std::shared_ptr<ClientImpl> &client, uint64_t serialId,
+                                                 const google::protobuf::Message *responsePrototype)
+{
+    std::unique_ptr<PendingCall> pendingCall;
+    std::unique_ptr<google::protobuf::Message> response;
+    {
+        std::lock_guard<std::mutex> locker(m_freeCallsLock);
+
+        if (!m_freeCalls.empty())
+        {
+            pendingCall = std::move(m_freeCalls.back());
+            m_freeCalls.pop_back();
+        }
+
+        if (responsePrototype)
+        {
+            auto it = m_freeResponses.find(responsePrototype->GetDescriptor());
+            if ((it != m_freeResponses.end()) && !it->second.empty())
+            {
+                response = std::move(it->second.back());
+                it->second.pop_back();
+            }
+        }
+    }
+
+    if (!pendingCall)
+    {
+        pendingCall = std::make_unique<PendingCall>(this);
+        pendingCall->controller.reset(new ServerControllerImpl());
+        m_poolMissCount++;
+    }
+    if (responsePrototype && !response)
+    {
+        response.reset(responsePrototype->New());
+        m_poolMissCount++;
+    }
+
+    pendingCall->controller->reset(client, serialId);
+    pendingCall->response = std::move(response);
+
+    return pendingCall.release();
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \threadsafe
+
+    Returns \a pendingCall and its response to the free lists, or frees them if
+    the lists are already full.
+
+ */
+void ServerImpl::releaseCall(PendingCall *pendingCall)
+{
+    constexpr size_t kMaxFreeObjects = 32;
+
+    std::unique_ptr<PendingCall> call(pendingCall);
+    std::unique_ptr<google::protobuf::Message> response = std::move(call->response);
+
+    // drop the reference on the client and clear the response outside of the lock
+    call->controller->reset(nullptr, 0);
+    call->payloadFd.clear();
+    if (response)
+    {
+        response->Clear();
+    }
+
+    std::lock_guard<std::mutex> locker(m_freeCallsLock);
+
+    if (response)
+    {
+        auto &freeResponses = m_freeResponses[response->GetDescriptor()];
+        if (freeResponses.size() < kMaxFreeObjects)
+        {
+            freeResponses.emplace_back(std::move(response));
+        }
+    }
+    if (m_freeCalls.size() < kMaxFreeObjects)
+    {
+        m_freeCalls.emplace_back(std::move(call));
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -1069,33 +1795,45 @@ void ServerImpl::sendErrorReply(const std::shared_ptr<ClientImpl> &client, uint6
     implementation decided to off-load the request to a processing thread.
 
  */
-void ServerImpl::handleResponse(ServerControllerImpl *controller, google::protobuf::Message *response)
+void ServerImpl::handleResponse(PendingCall *pendingCall)
 {
-    if (!controller || !controller->m_kClient)
+    const ServerControllerImpl *kController = pendingCall->controller.get();
+    if (!kController->m_client)
     {
-        RIALTO_IPC_LOG_ERROR("missing controller or attached client");
+        RIALTO_IPC_LOG_ERROR("missing attached client");
+        releaseCall(pendingCall);
         return;
     }
 
-    const std::shared_ptr<const ClientImpl> kClient = controller->m_kClient;
-    const uint64_t kClientId = kClient->id();
+    const uint64_t kClientId = kController->m_client->id();
 
-    std::shared_ptr<msghdr> message;
-    if (!controller->m_failed)
+    if (!kController->m_failed)
     {
-        message = populateReply(kClient, controller->m_kSerialId, response);
+        // the reply is built in the pending call's buffer, so is sent before the call is recycled
+        msghdr header;
+        iovec iov;
+        if (populateReply(pendingCall, &header, &iov))
+        {
+            sendReply(kClientId, &header);
+        }
+        else
+        {
+            // reply is too big, replace with a generic error
+            sendReply(kClientId,
+                      populateErrorReply(kController->m_client, kController->m_serialId,
+                                         "Internal error - reply message to large")
+                          .get());
+        }
     }
     else
     {
-        message = populateErrorReply(kClient, controller->m_kSerialId, controller->m_failureReason);
+        sendReply(kClientId,
+                  populateErrorReply(kController->m_client, kController->m_serialId, kController->m_failureReason)
+                      .get());
     }
 
     // no longer need the controller or the response objects
-    delete response;
-    delete controller;
-
-    // send the reply message to the given client
-    sendReply(kClientId, message);
+    releaseCall(pendingCall);
 }
 
 // -----------------------------------------------------------------------------
@@ -1150,89 +1888,196 @@ static std::vector<int> getResponseFileDescriptors(google::protobuf::Message *re
 // -----------------------------------------------------------------------------
 /*!
     \internal
-    \static
 
-    Populates tha socket message buffer with the reply data for the RPC request.
+    Gets the key used to coalesce the \a event message, ie. the type name plus
+    the values of the fields marked as 'coalesce_key'.  An empty string is
+    returned if the message type isn't marked as 'coalesce', or has a key field
+    of a type that can't be used.
 
  */
-std::shared_ptr<msghdr> ServerImpl::populateReply(const std::shared_ptr<const ClientImpl> &client, uint64_t serialId,
-                                                  google::protobuf::Message *response)
+static std::string getCoalesceKey(const google::protobuf::Message &event)
 {
-    // create the base reply
-    transport::MessageFromServer message;
-    transport::MethodCallReply *reply = message.mutable_reply();
-    if (!reply)
+    const google::protobuf::Descriptor *kDescriptor = event.GetDescriptor();
+    if (!kDescriptor->options().HasExtension(coalesce) || !kDescriptor->options().GetExtension(coalesce))
     {
-        RIALTO_IPC_LOG_ERROR("failed to create mutable reply object");
-        return nullptr;
+        return {};
     }
 
-    // convert the message response to a data string
-    std::string respString = response->SerializeAsString();
+    const google::protobuf::Reflection *kReflection = event.GetReflection();
+    std::string key = kDescriptor->full_name();
 
-    // wrap in a transport response and send that
-    reply->set_reply_id(serialId);
-    reply->set_reply_message(std::move(respString));
+    const int n = kDescriptor->field_count();
+    for (int i = 0; i < n; i++)
+    {
+        auto fieldDescriptor = kDescriptor->field(i);
+        if (!fieldDescriptor->options().HasExtension(coalesce_key) ||
+            !fieldDescriptor->options().GetExtension(coalesce_key))
+        {
+            continue;
+        }
+
+        key += '/';
+        switch (fieldDescriptor->cpp_type())
+        {
+        case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+            key += std::to_string(kReflection->GetInt32(event, fieldDescriptor));
+            break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+            key += std::to_string(kReflection->GetInt64(event, fieldDescriptor));
+            break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+            key += std::to_string(kReflection->GetUInt32(event, fieldDescriptor));
+            break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+            key += std::to_string(kReflection->GetUInt64(event, fieldDescriptor));
+            break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_ENUM:
+            key += std::to_string(kReflection->GetEnumValue(event, fieldDescriptor));
+            break;
+        case google::protobuf::FieldDescriptor::CPPTYPE_STRING:
+            key += kReflection->GetString(event, fieldDescriptor);
+            break;
+        default:
+            RIALTO_IPC_LOG_ERROR("field '%s' can't be used as a coalesce key", fieldDescriptor->name().c_str());
+            return {};
+        }
+    }
+
+    return key;
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Populates the socket message \a header with the reply data for the RPC
+    request, the data and any fds are stored in the pending call's buffer.
+
+    The MethodCallReply wrapper is encoded by hand so that the response can be
+    serialised straight into the buffer, rather than into a string that is
+    then copied into a transport::MessageFromServer and serialised again.  A
+    reply too big to send inline is serialised straight into a memfd instead,
+    which is sent after the response's own fds.
+
+    Returns \c false if the reply is too big to send.
+
+ */
+bool ServerImpl::populateReply(PendingCall *pendingCall, msghdr *header, iovec *iov)
+{
+    using google::protobuf::internal::WireFormatLite;
+    using google::protobuf::io::CodedOutputStream;
+
+    google::protobuf::Message *response = pendingCall->response.get();
+    const uint64_t kSerialId = pendingCall->controller->m_serialId;
 
-    // next need to check if the response message has any file descriptors in
-    // it that need to be attached
-    const std::vector<int> kFds = getResponseFileDescriptors(response);
-    const size_t kRequiredCtrlLen = kFds.empty() ? 0 : CMSG_SPACE(sizeof(int) * kFds.size());
+    // need to check if the response message has any file descriptors in it that need to be attached, this
+    // must be done first as the fields are set to -1 in the data
+    std::vector<int> fds = getResponseFileDescriptors(response);
 
     // calculate the size of the reply
-    const size_t kRequiredDataLen = message.ByteSizeLong();
-    if (kRequiredDataLen > m_kMaxMessageLen)
+    const size_t kResponseLen = response->ByteSizeLong();
+    const size_t kReplyLen =
+        WireFormatLite::TagSize(transport::MethodCallReply::kReplyIdFieldNumber, WireFormatLite::TYPE_UINT64) +
+        CodedOutputStream::VarintSize64(kSerialId) +
+        WireFormatLite::TagSize(transport::MethodCallReply::kReplyMessageFieldNumber, WireFormatLite::TYPE_BYTES) +
+        CodedOutputStream::VarintSize64(kResponseLen) + kResponseLen;
+    const size_t kMessageLen =
+        WireFormatLite::TagSize(transport::MessageFromServer::kReplyFieldNumber, WireFormatLite::TYPE_MESSAGE) +
+        CodedOutputStream::VarintSize64(kReplyLen) + kReplyLen;
+    // clients that haven't said they can receive messages out of band get everything inline
+    const bool kOutOfBandAccepted = pendingCall->controller->m_client->acceptsOutOfBand();
+    if (kMessageLen > OutOfBandPayload::maxMessageSize(kOutOfBandAccepted))
+    {
+        RIALTO_IPC_LOG_ERROR("reply exceeds maximum message limit (%zu, max %zu)", kMessageLen,
+                             OutOfBandPayload::maxMessageSize(kOutOfBandAccepted));
+        return false;
+    }
+
+    const auto kWriteReply = [&](uint8_t *data)
     {
-        RIALTO_IPC_LOG_ERROR("reply exceeds maximum message limit (%zu, max %zu)", kRequiredDataLen, m_kMaxMessageLen);
+        data = WireFormatLite::WriteTagToArray(transport::MessageFromServer::kReplyFieldNumber,
+                                               WireFormatLite::WIRETYPE_LENGTH_DELIMITED, data);
+        data = CodedOutputStream::WriteVarint64ToArray(kReplyLen, data);
+        data = WireFormatLite::WriteUInt64ToArray(transport::MethodCallReply::kReplyIdFieldNumber, kSerialId, data);
+        data = WireFormatLite::WriteTagToArray(transport::MethodCallReply::kReplyMessageFieldNumber,
+                                               WireFormatLite::WIRETYPE_LENGTH_DELIMITED, data);
+        data = CodedOutputStream::WriteVarint64ToArray(kResponseLen, data);
+        response->SerializeWithCachedSizesToArray(data);
+    };
 
-        // error message is too big, replace with a generic error
-        return populateErrorReply(client, serialId, "Internal error - reply message to large");
+    // a large reply goes in a memfd and the socket message just says so
+    transport::MessageFromServer outOfBandMessage;
+    if (kMessageLen > OutOfBandPayload::maxInlineSize(kOutOfBandAccepted))
+    {
+        pendingCall->payloadFd = OutOfBandPayload::create(kMessageLen, kWriteReply);
+        if (!pendingCall->payloadFd.isValid())
+        {
+            return false;
+        }
+
+        outOfBandMessage.mutable_out_of_band()->set_size(kMessageLen);
+        fds.push_back(pendingCall->payloadFd.fd());
     }
 
-    // build the socket message to send
-    auto msgBuf =
-        m_sendBufPool.allocateShared<uint8_t>(sizeof(msghdr) + sizeof(iovec) + kRequiredCtrlLen + kRequiredDataLen);
+    const bool kOutOfBand = pendingCall->payloadFd.isValid();
+    const size_t kRequiredDataLen = kOutOfBand ? outOfBandMessage.ByteSizeLong() : kMessageLen;
+    const size_t kRequiredCtrlLen = fds.empty() ? 0 : CMSG_SPACE(sizeof(int) * fds.size());
 
-    auto *header = reinterpret_cast<msghdr *>(msgBuf.get());
-    bzero(header, sizeof(msghdr));
+    // the buffer keeps its size between calls
+    std::vector<uint8_t> &buffer = pendingCall->replyBuf;
+    if (buffer.size() < (kRequiredCtrlLen + kRequiredDataLen))
+    {
+        if (buffer.capacity() < (kRequiredCtrlLen + kRequiredDataLen))
+        {
+            m_poolMissCount++;
+        }
+        buffer.resize(kRequiredCtrlLen + kRequiredDataLen);
+    }
 
-    auto *ctrl = reinterpret_cast<uint8_t *>(msgBuf.get() + sizeof(msghdr));
-    header->msg_control = ctrl;
+    // build the socket message to send
+    bzero(header, sizeof(msghdr));
+    header->msg_control = kRequiredCtrlLen ? buffer.data() : nullptr;
     header->msg_controllen = kRequiredCtrlLen;
-
-    auto *iov = reinterpret_cast<iovec *>(msgBuf.get() + sizeof(msghdr) + kRequiredCtrlLen);
     header->msg_iov = iov;
     header->msg_iovlen = 1;
 
-    auto *data = reinterpret_cast<uint8_t *>(msgBuf.get() + sizeof(msghdr) + kRequiredCtrlLen + sizeof(iovec));
+    uint8_t *data = buffer.data() + kRequiredCtrlLen;
     iov->iov_base = data;
     iov->iov_len = kRequiredDataLen;
 
     // copy in the data
-    message.SerializeWithCachedSizesToArray(data);
+    if (kOutOfBand)
+    {
+        outOfBandMessage.SerializeWithCachedSizesToArray(data);
+    }
+    else
+    {
+        kWriteReply(data);
+    }
 
     // add the fds
-    if (!kFds.empty())
+    if (!fds.empty())
     {
         struct cmsghdr *cmsg = CMSG_FIRSTHDR(header);
         if (!cmsg)
         {
             RIALTO_IPC_LOG_ERROR("odd, failed to get the first cmsg header");
-            return nullptr;
+            return false;
         }
 
         cmsg->cmsg_level = SOL_SOCKET;
         cmsg->cmsg_type = SCM_RIGHTS;
-        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * kFds.size());
-        memcpy(CMSG_DATA(cmsg), kFds.data(), sizeof(int) * kFds.size());
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+        memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
         header->msg_controllen = cmsg->cmsg_len;
     }
 
-    RIALTO_IPC_LOG_DEBUG("reply{ serial %" PRIu64 " } - { %s }", serialId, response->ShortDebugString().c_str());
+    if (RIALTO_IPC_IS_DEBUG_LOGGED())
+    {
+        RIALTO_IPC_LOG_DEBUG("reply{ serial %" PRIu64 " } - { %s }", kSerialId, response->ShortDebugString().c_str());
+    }
 
-    // std::reinterpret_pointer_cast is only implemented in C++17 and newer, so for
-    // now do it manually
-    return std::shared_ptr<msghdr>(msgBuf, reinterpret_cast<msghdr *>(msgBuf.get()));
+    return true;
 }
 
 // -----------------------------------------------------------------------------
@@ -1253,7 +2098,7 @@ std::shared_ptr<msghdr> ServerImpl::populateErrorReply(const std::shared_ptr<con
 
     // check the message will fit
     size_t replySize = message.ByteSizeLong();
-    if (replySize > m_kMaxMessageLen)
+    if (replySize > OutOfBandPayload::maxInlineSize(client->acceptsOutOfBand()))
     {
         RIALTO_IPC_LOG_ERROR("error reply exceeds max message size");
 
@@ -1265,7 +2110,7 @@ std::shared_ptr<msghdr> ServerImpl::populateErrorReply(const std::shared_ptr<con
     RIALTO_IPC_LOG_DEBUG("error{ serial %" PRIu64 " } - \"%s\"", serialId, reason.c_str());
 
     // construct the message to send on the socket
-    auto msgBuf = m_sendBufPool.allocateShared<uint8_t>(sizeof(msghdr) + sizeof(iovec) + replySize);
+    auto msgBuf = SlabAllocator::instance().allocateShared<uint8_t>(sizeof(msghdr) + sizeof(iovec) + replySize);
 
     auto *header = reinterpret_cast<msghdr *>(msgBuf.get());
     bzero(header, sizeof(msghdr));
@@ -1311,12 +2156,11 @@ bool ServerImpl::isClientConnected(uint64_t clientId) const
  */
 void ServerImpl::disconnectClient(uint64_t clientId)
 {
-    {
-        std::lock_guard<std::mutex> locker(m_clientsLock);
-        m_condemnedClients.insert(clientId);
-    }
+    std::lock_guard<std::mutex> locker(m_clientsLock);
+    m_condemnedClients.insert(clientId);
 
-    wakeEventLoop();
+    // the loops are only destroyed with the server, so it's safe to wake the loop with the lock held
+    wakeEventLoop(clientEventLoopNoLock(clientId));
 }
 
 // -----------------------------------------------------------------------------
@@ -1327,14 +2171,18 @@ void ServerImpl::disconnectClient(uint64_t clientId)
 
     This may be called from any thread, or from within the rpc message handler.
 
-    The \a clientId is the client to send the event to.
+    The \a client is the client to send the event to, if it has advertised support
+    for event ids then the event name is only sent with the first event of each type.
+
+    The event is queued and sent by the event loop, which is woken if needed.
+    Events marked as 'coalesce' replace any queued event of the same type and
+    key, so a client that is slow to read only gets the latest state.
 
  */
-bool ServerImpl::sendEvent(uint64_t clientId, const std::shared_ptr<google::protobuf::Message> &eventMessage)
+bool ServerImpl::sendEvent(ClientImpl &client, const std::shared_ptr<google::protobuf::Message> &eventMessage)
 {
     // gets the file descriptors from the event message
-    const std::vector<int> kFds = getResponseFileDescriptors(eventMessage.get());
-    const size_t kRequiredCtrlLen = kFds.empty() ? 0 : CMSG_SPACE(sizeof(int) * kFds.size());
+    std::vector<int> fds = getResponseFileDescriptors(eventMessage.get());
 
     // create the base reply
     transport::MessageFromServer message;
@@ -1345,7 +2193,19 @@ bool ServerImpl::sendEvent(uint64_t clientId, const std::shared_ptr<google::prot
         return false;
     }
 
-    event->set_event_name(eventMessage->GetTypeName());
+    // if the client understands event ids then only the first event of each type needs to carry the name
+    const google::protobuf::Descriptor *kEventDescriptor = eventMessage->GetDescriptor();
+    uint32_t eventId = 0;
+    bool announced = false;
+    const bool kUseEventId = client.getEventId(kEventDescriptor, &eventId, &announced);
+    if (kUseEventId)
+    {
+        event->set_event_id(eventId);
+    }
+    if (!kUseEventId || !announced)
+    {
+        event->set_event_name(eventMessage->GetTypeName());
+    }
 
     // convert the event to a data string
     std::string respString = eventMessage->SerializeAsString();
@@ -1354,17 +2214,37 @@ bool ServerImpl::sendEvent(uint64_t clientId, const std::shared_ptr<google::prot
     event->set_message(std::move(respString));
 
     // check the reply will fit
+    const bool kOutOfBandAccepted = client.acceptsOutOfBand();
     size_t requiredDataLen = message.ByteSizeLong();
-    if (requiredDataLen > m_kMaxMessageLen)
+    if (requiredDataLen > OutOfBandPayload::maxMessageSize(kOutOfBandAccepted))
     {
         RIALTO_IPC_LOG_ERROR("event message to big to fit in buffer (size %zu, max size %zu)", requiredDataLen,
-                             m_kMaxMessageLen);
+                             OutOfBandPayload::maxMessageSize(kOutOfBandAccepted));
         return false;
     }
 
+    // a large event goes in a memfd and the socket message just says so
+    FileDescriptor payloadFd;
+    if (requiredDataLen > OutOfBandPayload::maxInlineSize(kOutOfBandAccepted))
+    {
+        payloadFd = OutOfBandPayload::create(requiredDataLen, [&message](uint8_t *data)
+                                             { message.SerializeWithCachedSizesToArray(data); });
+        if (!payloadFd.isValid())
+        {
+            return false;
+        }
+
+        message.Clear();
+        message.mutable_out_of_band()->set_size(requiredDataLen);
+        requiredDataLen = message.ByteSizeLong();
+        fds.push_back(payloadFd.fd());
+    }
+
+    const size_t kRequiredCtrlLen = fds.empty() ? 0 : CMSG_SPACE(sizeof(int) * fds.size());
+
     // build the socket message to send
-    auto msgBuf =
-        m_sendBufPool.allocateShared<uint8_t>(sizeof(msghdr) + sizeof(iovec) + kRequiredCtrlLen + requiredDataLen);
+    auto msgBuf = SlabAllocator::instance().allocateShared<uint8_t>(sizeof(msghdr) + sizeof(iovec) + kRequiredCtrlLen +
+                                                                    requiredDataLen);
 
     auto *header = reinterpret_cast<msghdr *>(msgBuf.get());
     bzero(header, sizeof(msghdr));
@@ -1385,7 +2265,7 @@ bool ServerImpl::sendEvent(uint64_t clientId, const std::shared_ptr<google::prot
     message.SerializeWithCachedSizesToArray(data);
 
     // add the fds
-    if (!kFds.empty())
+    if (!fds.empty())
     {
         struct cmsghdr *cmsg = CMSG_FIRSTHDR(header);
         if (!cmsg)
@@ -1396,32 +2276,206 @@ bool ServerImpl::sendEvent(uint64_t clientId, const std::shared_ptr<google::prot
 
         cmsg->cmsg_level = SOL_SOCKET;
         cmsg->cmsg_type = SCM_RIGHTS;
-        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * kFds.size());
-        memcpy(CMSG_DATA(cmsg), kFds.data(), sizeof(int) * kFds.size());
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fds.size());
+        memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fds.size());
         header->msg_controllen = cmsg->cmsg_len;
     }
 
-    // finally, take the lock (so the socket is not closed beneath us) and send the reply
+    // the header is stored at the start of the buffer
+    std::shared_ptr<msghdr> msg(msgBuf, header);
+    QueuedEvent queuedEvent{msg, getCoalesceKey(*eventMessage),
+                            (kUseEventId && !announced) ? kEventDescriptor : nullptr, std::move(payloadFd)};
+
+    // finally, take the lock (so the socket is not closed beneath us) and queue the event for the event loop
+    bool rebuild = false;
+    bool wake = false;
+    EventLoop *loop = nullptr;
     {
-        std::unique_lock<std::mutex> locker(m_clientsLock);
+        std::lock_guard<std::mutex> locker(m_clientsLock);
 
-        auto it = m_clients.find(clientId);
+        auto it = m_clients.find(client.id());
         if (it == m_clients.end() || it->second.sock < 0)
         {
             RIALTO_IPC_LOG_WARN("socket closed before event could be sent");
             return false;
         }
-        else if (TEMP_FAILURE_RETRY(sendmsg(it->second.sock, header, MSG_NOSIGNAL)) !=
-                 static_cast<ssize_t>(requiredDataLen))
+
+        // the client may have done the connection setup since the event was built, in which case it may have
+        // been told the smaller inline limit already and the event must be rebuilt to go out of band
+        if (!kOutOfBandAccepted && !queuedEvent.payloadFd.isValid() &&
+            (requiredDataLen > OutOfBandPayload::maxInlineSize(true)) && client.acceptsOutOfBand())
         {
-            RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send the complete event message");
-            return false;
+            rebuild = true;
         }
+        else
+        {
+            std::deque<QueuedEvent> &eventQueue = it->second.eventQueue;
+
+            // drop any queued event that this one supersedes
+            if (!queuedEvent.coalesceKey.empty())
+            {
+                auto superseded = std::find_if(eventQueue.begin(), eventQueue.end(),
+                                               [&queuedEvent](const QueuedEvent &e)
+                                               { return e.coalesceKey == queuedEvent.coalesceKey; });
+                if (superseded != eventQueue.end())
+                {
+                    RIALTO_IPC_LOG_DEBUG("coalescing event %s", eventMessage->GetTypeName().c_str());
+                    eventQueue.erase(superseded);
+                }
+            }
+
+            if (eventQueue.empty())
+            {
+                loop = it->second.loop;
+                wake = loop->clientsWithEvents.empty();
+                loop->clientsWithEvents.insert(client.id());
+            }
+            eventQueue.emplace_back(std::move(queuedEvent));
+        }
+    }
+
+    if (rebuild)
+    {
+        return sendEvent(client, eventMessage);
+    }
+
+    if (wake)
+    {
+        wakeEventLoop(*loop);
     }
 
-    RIALTO_IPC_LOG_DEBUG("event{ %s } - { %s }", eventMessage->GetTypeName().c_str(),
-                         eventMessage->ShortDebugString().c_str());
+    if (RIALTO_IPC_IS_DEBUG_LOGGED())
+    {
+        RIALTO_IPC_LOG_DEBUG("event{ %s } - { %s }", eventMessage->GetTypeName().c_str(),
+                             eventMessage->ShortDebugString().c_str());
+    }
 
     return true;
 }
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+
+    Sends the queued events of the clients served by \a loop, called from the
+    event loop after processing the epoll events.
+
+ */
+void ServerImpl::flushEvents(EventLoop &loop)
+{
+    std::lock_guard<std::mutex> locker(m_clientsLock);
+
+    for (uint64_t clientId : loop.clientsWithEvents)
+    {
+        auto it = m_clients.find(clientId);
+        if ((it != m_clients.end()) && (m_condemnedClients.count(clientId) == 0))
+        {
+            flushEventsNoLock(it->second);
+        }
+    }
+
+    loop.clientsWithEvents.clear();
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \static
+
+    Sends all the events queued for a client.  Events that can go on the
+    shared memory ring are written there, the rest are batched up and sent
+    on the socket with a single sendmmsg() call.  The order of events is
+    preserved across the two transports as the batch is always sent before
+    writing to the ring.
+
+    \note Must be called while holding the m_clientsLock mutex.
+
+ */
+void ServerImpl::flushEventsNoLock(ClientDetails &details)
+{
+    std::vector<QueuedEvent> batch;
+    batch.reserve(details.eventQueue.size());
+
+    for (QueuedEvent &queuedEvent : details.eventQueue)
+    {
+        const msghdr *kMsg = queuedEvent.msg.get();
+        if (details.shmTransport && (kMsg->msg_controllen == 0) &&
+            (kMsg->msg_iov->iov_len <= details.shmTransport->maxMessageSize()))
+        {
+            sendEventBatchNoLock(details, &batch);
+            if (!sendToClientNoLock(details, kMsg, kMsg->msg_iov->iov_len))
+            {
+                RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send the complete event message");
+            }
+            else if (queuedEvent.announcedEvent)
+            {
+                details.client->setEventIdAnnounced(queuedEvent.announcedEvent);
+            }
+        }
+        else
+        {
+            batch.emplace_back(std::move(queuedEvent));
+        }
+    }
+
+    sendEventBatchNoLock(details, &batch);
+    details.eventQueue.clear();
+}
+
+// -----------------------------------------------------------------------------
+/*!
+    \internal
+    \static
+
+    Sends the events in  batch on the client socket and clears it.
+
+    Only once a named event is on the socket is its id marked as announced,
+    any event sent after that is then guaranteed to arrive after the client has
+    seen the name.
+
+    \note Must be called while holding the m_clientsLock mutex.
+
+ */
+void ServerImpl::sendEventBatchNoLock(ClientDetails &details, std::vector<QueuedEvent> *batch)
+{
+    if (batch->empty())
+        return;
+
+    std::vector<mmsghdr> msgs(batch->size());
+    for (size_t i = 0; i < batch->size(); i++)
+    {
+        msgs[i].msg_hdr = *(*batch)[i].msg;
+        msgs[i].msg_len = 0;
+    }
+
+    size_t sent = 0;
+    while (sent < msgs.size())
+    {
+        int rc = TEMP_FAILURE_RETRY(sendmmsg(details.sock, &msgs[sent], msgs.size() - sent, MSG_NOSIGNAL));
+        if (rc <= 0)
+        {
+            RIALTO_IPC_LOG_SYS_ERROR(errno, "failed to send %zu event messages", msgs.size() - sent);
+            break;
+        }
+
+        for (size_t i = sent; i < (sent + rc); i++)
+        {
+            if (msgs[i].msg_len != msgs[i].msg_hdr.msg_iov->iov_len)
+            {
+                RIALTO_IPC_LOG_ERROR("failed to send the complete event message");
+                continue;
+            }
+
+            details.socketSendCount++;
+            if ((*batch)[i].announcedEvent)
+            {
+                details.client->setEventIdAnnounced((*batch)[i].announcedEvent);
+            }
+        }
+
+        sent += rc;
+    }
+
+    batch->clear();
+}
 } // namespace firebolt::rialto::ipc
@@ -24,13 +24,19 @@
 #include "IIpcServer.h"
 #include "IIpcServerFactory.h"
 #include "IpcServerControllerImpl.h"
-#include "SimpleBufferPool.h"
+#include "OutOfBandPayload.h"
+#include "ShmTransport.h"
+#include "SlabAllocator.h"
 
 #include "rialtoipc-transport.pb.h"
 
+#include <google/protobuf/arena.h>
+
+#include <sys/epoll.h>
 #include <sys/socket.h>
 
 #include <atomic>
+#include <deque>
 #include <list>
 #include <map>
 #include <memory>
@@ -55,14 +61,17 @@ public:
     ~ServerFactory() override = default;
 
     std::shared_ptr<IServer> create() override;
+    std::shared_ptr<IServer> create(unsigned numWorkerLoops) override;
 };
 
 class ServerImpl final : public ::firebolt::rialto::ipc::IServer, public std::enable_shared_from_this<ServerImpl>
 {
 public:
-    explicit ServerImpl();
+    explicit ServerImpl(unsigned numWorkerLoops = 0);
     ~ServerImpl() final;
 
+    void startWorkerLoops();
+
 public:
     bool addSocket(const std::string &socketPath,
                    const std::function<void(const std::shared_ptr<IClient> &)> &clientConnectedCb,
@@ -76,10 +85,11 @@ public:
     int fd() const override;
     bool wait(int timeoutMSecs) override;
     bool process() override;
+    ServerStats getStats() const override;
 
 protected:
     friend class ClientImpl;
-    bool sendEvent(uint64_t clientId, const std::shared_ptr<google::protobuf::Message> &message);
+    bool sendEvent(ClientImpl &client, const std::shared_ptr<google::protobuf::Message> &message);
     bool isClientConnected(uint64_t clientId) const;
     void disconnectClient(uint64_t clientId);
 
@@ -88,37 +98,89 @@ private:
     static bool getSocketLock(Socket *socket);
     static void closeListeningSocket(Socket *socket);
 
-    void wakeEventLoop() const;
+    struct EventLoop;
+    static bool initEventLoop(EventLoop *loop);
+    static void termEventLoop(EventLoop *loop);
+    static void wakeEventLoop(const EventLoop &loop);
+    EventLoop *selectEventLoopNoLock();
+    EventLoop &clientEventLoopNoLock(uint64_t clientId);
+    static void workerLoopThread(std::weak_ptr<ServerImpl> weakServer, std::shared_ptr<EventLoop> loop);
+    bool processEventLoop(EventLoop &loop, int timeoutMSecs);
+    static int waitEventLoop(const EventLoop &loop, struct epoll_event *events, int maxEvents, int timeoutMSecs);
+    void processEvents(EventLoop &loop, const struct epoll_event *events, int numEvents);
+    void cleanupCondemnedClients(EventLoop &loop);
 
     void processNewConnection(uint64_t socketId);
 
-    void processClientSocket(uint64_t clientId, unsigned events);
-    void processClientMessage(const std::shared_ptr<ClientImpl> &client, const uint8_t *data, size_t dataLen,
-                              const std::vector<FileDescriptor> &fds = {});
+    void processClientSocket(EventLoop &loop, uint64_t clientId, unsigned events);
+    void processClientDoorbell(EventLoop &loop, uint64_t clientId);
+    void processClientShmMessages(EventLoop &loop, const std::shared_ptr<ClientImpl> &client);
+    void processClientMessage(EventLoop &loop, const std::shared_ptr<ClientImpl> &client, const uint8_t *data,
+                              size_t dataLen, std::vector<FileDescriptor> fds = {});
+
+    void processMethodCall(google::protobuf::Arena *arena, const std::shared_ptr<ClientImpl> &client,
+                           const transport::MethodCall &call, const std::vector<FileDescriptor> &fds);
+    void processConnectionSetup(const std::shared_ptr<ClientImpl> &client, const transport::MethodCall &call);
+    void processShmTransportSetup(const std::shared_ptr<ClientImpl> &client,
+                                  const transport::SharedMemoryTransportSetup &setup,
+                                  const std::vector<FileDescriptor> &fds);
 
-    void processMethodCall(const std::shared_ptr<ClientImpl> &client, const transport::MethodCall &call,
-                           const std::vector<FileDescriptor> &fds);
+    std::shared_ptr<ClientImpl>
+    addClientSocket(int socketFd, const std::string &listeningSocketPath,
+                    std::function<void(const std::shared_ptr<IClient> &)> disconnectedCb,
+                    const std::function<void(const std::shared_ptr<IClient> &)> &connectedCb = nullptr);
 
-    std::shared_ptr<ClientImpl> addClientSocket(int socketFd, const std::string &listeningSocketPath,
-                                                std::function<void(const std::shared_ptr<IClient> &)> disconnectedCb);
+    struct ClientDetails;
+    static bool sendToClientNoLock(ClientDetails &details, const msghdr *msg, size_t dataLen);
 
-    void sendReply(uint64_t clientId, const std::shared_ptr<msghdr> &msg);
+    struct QueuedEvent;
+    void flushEvents(EventLoop &loop);
+    static void flushEventsNoLock(ClientDetails &details);
+    static void sendEventBatchNoLock(ClientDetails &details, std::vector<QueuedEvent> *batch);
+
+    void sendReply(uint64_t clientId, const msghdr *msg);
 
     void sendErrorReply(const std::shared_ptr<ClientImpl> &client, uint64_t serialId, const char *format, ...)
         __attribute__((format(printf, 4, 5)));
 
-    void handleResponse(ServerControllerImpl *controller, google::protobuf::Message *response);
+    struct PendingCall;
+    PendingCall *acquireCall(const std::shared_ptr<ClientImpl> &client, uint64_t serialId,
+                             const google::protobuf::Message *responsePrototype);
+    void releaseCall(PendingCall *pendingCall);
+
+    void handleResponse(PendingCall *pendingCall);
 
-    std::shared_ptr<msghdr> populateReply(const std::shared_ptr<const ClientImpl> &client, uint64_t serialId,
-                                          google::protobuf::Message *response);
+    bool populateReply(PendingCall *pendingCall, msghdr *header, iovec *iov);
     std::shared_ptr<msghdr> populateErrorReply(const std::shared_ptr<const ClientImpl> &client, uint64_t serialId,
                                                const std::string &reason);
 
 private:
-    static const size_t m_kMaxMessageLen;
+    // an epoll loop, the main loop is run by the owner of the server through process() and serves the
+    // listening sockets, clients are served by the main loop or shared between the worker loops
+    struct EventLoop
+    {
+        int pollFd = -1;
+        int wakeEventFd = -1;
+        std::thread thread;
+
+        // cleared when the server is destroyed, the worker thread may outlive the server
+        std::atomic<bool> running{true};
+
+        // protected by m_clientsLock
+        size_t numClients = 0;
+        std::set<uint64_t> clientsWithEvents;
+
+        // clients that did the connection setup send larger messages out of band, see processClientSocket() for
+        // the ones that didn't
+        uint8_t recvDataBuf[OutOfBandPayload::kOutOfBandThreshold];
+        uint8_t recvCtrlBuf[SCM_MAX_FD * sizeof(int)];
+
+        // initial block of the arena the received messages are parsed into
+        alignas(16) uint8_t arenaBlock[32 * 1024];
+    };
 
-    int m_pollFd;
-    int m_wakeEventFd;
+    EventLoop m_mainLoop;
+    std::vector<std::shared_ptr<EventLoop>> m_workerLoops;
 
     std::atomic<uint64_t> m_socketIdCounter;
     std::atomic<uint64_t> m_clientIdCounter;
@@ -137,11 +199,34 @@ private:
     std::mutex m_socketsLock;
     std::map<uint64_t, Socket> m_sockets;
 
+    struct QueuedEvent
+    {
+        std::shared_ptr<msghdr> msg;
+
+        // set for events that may be replaced by a newer one with the same key
+        std::string coalesceKey;
+
+        // set if this event carries the name of its event id, which is then announced once sent
+        const google::protobuf::Descriptor *announcedEvent = nullptr;
+
+        // the memfd holding the event if it is too big to send inline
+        FileDescriptor payloadFd;
+    };
+
     struct ClientDetails
     {
         int sock = -1;
         std::shared_ptr<ClientImpl> client;
         std::function<void(const std::shared_ptr<IClient> &)> disconnectedCb;
+        EventLoop *loop = nullptr;
+
+        // send side of the shared memory transport, messages on it are tagged with the number of
+        // socket messages sent so the client can keep them in order
+        std::shared_ptr<ShmTransport> shmTransport;
+        uint64_t socketSendCount = 0;
+
+        // events waiting to be sent by the event loop
+        std::deque<QueuedEvent> eventQueue;
     };
 
     mutable std::mutex m_clientsLock;
@@ -149,10 +234,27 @@ private:
     std::map<uint64_t, ClientDetails> m_clients;
     std::set<uint64_t> m_condemnedClients;
 
-    uint8_t m_recvDataBuf[128 * 1024];
-    uint8_t m_recvCtrlBuf[SCM_MAX_FD * sizeof(int)];
+    // a method call waiting for the service to complete it, recycled once the reply is sent along with the
+    // response message so that once warmed up dispatching a call doesn't need the heap
+    struct PendingCall final : public google::protobuf::Closure
+    {
+        explicit PendingCall(ServerImpl *owner) : server(owner) {}
+        void Run() override { server->handleResponse(this); }
+
+        ServerImpl *const server;
+        std::unique_ptr<ServerControllerImpl> controller;
+        std::unique_ptr<google::protobuf::Message> response;
+        std::vector<uint8_t> replyBuf;
+        FileDescriptor payloadFd;
+    };
+
+    std::mutex m_freeCallsLock;
+    std::vector<std::unique_ptr<PendingCall>> m_freeCalls;
+    std::map<const google::protobuf::Descriptor *, std::vector<std::unique_ptr<google::protobuf::Message>>>
+        m_freeResponses;
 
-    SimpleBufferPool m_sendBufPool;
+    std::atomic<uint64_t> m_callCount;
+    std::atomic<uint64_t> m_poolMissCount; // not a heap allocation count, see IServer::getStats()
 };
 
 } // namespace firebolt::rialto::ipc
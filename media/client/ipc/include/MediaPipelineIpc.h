@@ -87,10 +87,19 @@ public:
 
     bool haveData(MediaSourceStatus status, uint32_t numFrames, uint32_t requestId) override;
 
+    bool haveDataMulti(const std::vector<HaveDataInfo> &haveDataInfos, std::vector<bool> &results) override;
+
+    bool haveDataAsync(MediaSourceStatus status, uint32_t numFrames, uint32_t requestId,
+                       std::function<void(bool success)> &&callback) override;
+
     bool setPosition(int64_t position) override;
 
     bool getPosition(int64_t &position) override;
 
+    bool setPositionAsync(int64_t position, std::function<void(bool success)> &&callback) override;
+
+    bool getPositionAsync(std::function<void(bool success, int64_t position)> &&callback) override;
+
     bool setImmediateOutput(int32_t sourceId, bool immediateOutput) override;
 
     bool setReportDecodeErrors(int32_t sourceId, bool reportDecodeErrors) override;
@@ -101,6 +110,8 @@ public:
 
     bool getStats(int32_t sourceId, uint64_t &renderedFrames, uint64_t &droppedFrames) override;
 
+    bool enableStreamingMode(int32_t sourceId, int &doorbellFd, uint32_t &ringOffset, uint32_t &ringCapacity) override;
+
     bool setPlaybackRate(double rate) override;
 
     bool renderFrame() override;
@@ -168,6 +179,11 @@ private:
     // initialise m_sessionId to -1 which is an invalid session_id
     std::atomic<int> m_sessionId{-1};
 
+    /**
+     * @brief Whether the server knows haveDataMulti, cleared the first time it says it doesn't.
+     */
+    std::atomic<bool> m_isHaveDataMultiSupported{true};
+
     /**
      * @brief Thread for handling media player events from the server.
      */
@@ -308,6 +324,11 @@ private:
      */
     bool buildAttachSourceRequest(firebolt::rialto::AttachSourceRequest &request,
                                   const std::unique_ptr<IMediaPipeline::MediaSource> &source) const;
+
+    /**
+     * @brief Sends each of the requests with haveData, for servers that don't know haveDataMulti.
+     */
+    bool haveDataEach(const std::vector<HaveDataInfo> &haveDataInfos, std::vector<bool> &results);
 };
 
 }; // namespace firebolt::rialto::client
@@ -22,8 +22,10 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "IMediaPipeline.h"
 #include "IMediaPipelineIpcClient.h"
@@ -157,6 +159,32 @@ public:
      */
     virtual bool haveData(MediaSourceStatus status, uint32_t numFrames, uint32_t requestId) = 0;
 
+    /**
+     * @brief Notify server that the data of several requests has been written to the shared memory.
+     *
+     * Servers that don't support haveDataMulti are sent each request with haveData.
+     *
+     * @param[in]  haveDataInfos : The status, number of frames and request id of each request.
+     * @param[out] results       : Whether each request succeeded, in the order of haveDataInfos.
+     *
+     * @retval true if the requests were sent, false if none could be.
+     */
+    virtual bool haveDataMulti(const std::vector<HaveDataInfo> &haveDataInfos, std::vector<bool> &results) = 0;
+
+    /**
+     * @brief Notify server that the data has been written to the shared memory, without waiting for the reply.
+     *
+     * The callback is called from the ipc thread once the server has replied.
+     *
+     * @param[in] status    : The status.
+     * @param[in] requestId : The Need data request id.
+     * @param[in] callback  : Called with the result of the request.
+     *
+     * @retval true if the request was sent, the callback is not called otherwise.
+     */
+    virtual bool haveDataAsync(MediaSourceStatus status, uint32_t numFrames, uint32_t requestId,
+                               std::function<void(bool success)> &&callback) = 0;
+
     /**
      * @brief Request new playback position.
      *
@@ -177,6 +205,25 @@ public:
      */
     virtual bool getPosition(int64_t &position) = 0;
 
+    /**
+     * @brief Request new playback position, without waiting for the reply.
+     *
+     * @param[in] position : The playback position in nanoseconds.
+     * @param[in] callback : Called from the ipc thread with the result of the request.
+     *
+     * @retval true if the request was sent, the callback is not called otherwise.
+     */
+    virtual bool setPositionAsync(int64_t position, std::function<void(bool success)> &&callback) = 0;
+
+    /**
+     * @brief Get the playback position in nanoseconds, without waiting for the reply.
+     *
+     * @param[in] callback : Called from the ipc thread with the result and the playback position.
+     *
+     * @retval true if the request was sent, the callback is not called otherwise.
+     */
+    virtual bool getPositionAsync(std::function<void(bool success, int64_t position)> &&callback) = 0;
+
     /**
      * @brief Sets the "Immediate Output" property for this source.
      *
@@ -238,6 +285,19 @@ public:
      */
     virtual bool getStats(int32_t sourceId, uint64_t &renderedFrames, uint64_t &droppedFrames) = 0;
 
+    /**
+     * @brief Switches a source to streaming mode.
+     *
+     * @param[in]  sourceId     : The source id. Value should be set to the MediaSource.id returned after attachSource()
+     * @param[out] doorbellFd   : The eventfd to ring when the server waits for data, to be closed by the caller.
+     * @param[out] ringOffset   : The offset of the ring from the start of the shared memory.
+     * @param[out] ringCapacity : The capacity of the ring.
+     *
+     * @retval true on success.
+     */
+    virtual bool enableStreamingMode(int32_t sourceId, int &doorbellFd, uint32_t &ringOffset,
+                                     uint32_t &ringCapacity) = 0;
+
     /**
      * @brief Request new playback rate.
      *
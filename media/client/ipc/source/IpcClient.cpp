@@ -19,6 +19,8 @@
 
 #include "IpcClient.h"
 #include "RialtoClientLogging.h"
+#include <cstdlib>
+#include <cstring>
 #include <utility>
 
 namespace firebolt::rialto::client
@@ -103,6 +105,13 @@ bool IpcClient::connect()
         return false;
     }
 
+    // the shared memory transport is opt-in, if the server doesn't support it the socket is used for everything
+    const char *kShmTransport = getenv("RIALTO_IPC_SHM_TRANSPORT");
+    if (kShmTransport && (strcmp(kShmTransport, "1") == 0) && !m_ipcChannel->enableSharedMemoryTransport())
+    {
+        RIALTO_CLIENT_LOG_WARN("Failed to enable the shared memory ipc transport, using the socket");
+    }
+
     // spin up the thread that runs the IPC event loop
     m_ipcThread = std::thread(&IpcClient::processIpcThread, this);
     if (!m_ipcThread.joinable())
@@ -21,8 +21,15 @@
 #include "RialtoCommonIpc.h"
 #include "mediapipelinemodule.pb.h"
 #include <IMediaPipeline.h>
+#include <string>
 #include <unordered_map>
 
+namespace
+{
+// the start of the error the ipc server replies with for a method the service doesn't have
+constexpr char kUnknownMethodError[]{"Unknown method"};
+} // namespace
+
 namespace firebolt::rialto::client
 {
 std::weak_ptr<IMediaPipelineIpcFactory> MediaPipelineIpcFactory::m_factory;
@@ -481,6 +488,109 @@ bool MediaPipelineIpc::haveData(MediaSourceStatus status, uint32_t numFrames, ui
     return true;
 }
 
+bool MediaPipelineIpc::haveDataMulti(const std::vector<HaveDataInfo> &haveDataInfos, std::vector<bool> &results)
+{
+    if (!m_isHaveDataMultiSupported)
+    {
+        return haveDataEach(haveDataInfos, results);
+    }
+
+    if (!reattachChannelIfRequired())
+    {
+        RIALTO_CLIENT_LOG_ERROR("Reattachment of the ipc channel failed, ipc disconnected");
+        return false;
+    }
+
+    firebolt::rialto::HaveDataMultiRequest request;
+
+    request.set_session_id(m_sessionId);
+    for (const HaveDataInfo &kInfo : haveDataInfos)
+    {
+        firebolt::rialto::HaveDataMultiRequest_HaveData *data = request.add_data();
+        data->set_status(convertHaveDataRequestMediaSourceStatus(kInfo.status));
+        data->set_num_frames(kInfo.numFrames);
+        data->set_request_id(kInfo.requestId);
+    }
+
+    firebolt::rialto::HaveDataMultiResponse response;
+    auto ipcController = m_ipc.createRpcController();
+    auto blockingClosure = m_ipc.createBlockingClosure();
+    m_mediaPipelineStub->haveDataMulti(ipcController.get(), &request, &response, blockingClosure.get());
+
+    // wait for the call to complete
+    blockingClosure->wait();
+
+    // check the result
+    if (ipcController->Failed())
+    {
+        // the ipc server rejects methods a service doesn't have before calling it, so nothing has been processed
+        const std::string kErrorText{ipcController->ErrorText()};
+        if (kErrorText.rfind(kUnknownMethodError, 0) == 0)
+        {
+            RIALTO_CLIENT_LOG_WARN("Server doesn't support have data multi, sending each request");
+            m_isHaveDataMultiSupported = false;
+            return haveDataEach(haveDataInfos, results);
+        }
+        RIALTO_CLIENT_LOG_ERROR("failed to have data multi due to '%s'", kErrorText.c_str());
+        return false;
+    }
+    if (static_cast<size_t>(response.succeeded_size()) != haveDataInfos.size())
+    {
+        RIALTO_CLIENT_LOG_ERROR("have data multi returned %d results for %zu requests", response.succeeded_size(),
+                                haveDataInfos.size());
+        return false;
+    }
+
+    results.assign(response.succeeded().begin(), response.succeeded().end());
+    return true;
+}
+
+bool MediaPipelineIpc::haveDataEach(const std::vector<HaveDataInfo> &haveDataInfos, std::vector<bool> &results)
+{
+    results.clear();
+    results.reserve(haveDataInfos.size());
+    for (const HaveDataInfo &kInfo : haveDataInfos)
+    {
+        results.push_back(haveData(kInfo.status, kInfo.numFrames, kInfo.requestId));
+    }
+    return true;
+}
+
+bool MediaPipelineIpc::haveDataAsync(MediaSourceStatus status, uint32_t numFrames, uint32_t requestId,
+                                     std::function<void(bool success)> &&callback)
+{
+    if (!reattachChannelIfRequired())
+    {
+        RIALTO_CLIENT_LOG_ERROR("Reattachment of the ipc channel failed, ipc disconnected");
+        return false;
+    }
+
+    firebolt::rialto::HaveDataRequest request;
+
+    request.set_session_id(m_sessionId);
+    request.set_status(convertHaveDataRequestMediaSourceStatus(status));
+    request.set_num_frames(numFrames);
+    request.set_request_id(requestId);
+
+    // the controller and response must outlive this call, so are owned by the completion closure
+    auto response = std::make_shared<firebolt::rialto::HaveDataResponse>();
+    auto ipcController = m_ipc.createRpcController();
+    google::protobuf::Closure *closure = ipc::createCallbackClosure(
+        [ipcController, response, callback = std::move(callback)]()
+        {
+            if (ipcController->Failed())
+            {
+                RIALTO_CLIENT_LOG_ERROR("failed to have data due to '%s'", ipcController->ErrorText().c_str());
+                callback(false);
+                return;
+            }
+            callback(true);
+        });
+    m_mediaPipelineStub->haveData(ipcController.get(), &request, response.get(), closure);
+
+    return true;
+}
+
 bool MediaPipelineIpc::setPosition(int64_t position)
 {
     if (!reattachChannelIfRequired())
@@ -543,6 +653,67 @@ bool MediaPipelineIpc::getPosition(int64_t &position)
     return true;
 }
 
+bool MediaPipelineIpc::setPositionAsync(int64_t position, std::function<void(bool success)> &&callback)
+{
+    if (!reattachChannelIfRequired())
+    {
+        RIALTO_CLIENT_LOG_ERROR("Reattachment of the ipc channel failed, ipc disconnected");
+        return false;
+    }
+
+    firebolt::rialto::SetPositionRequest request;
+
+    request.set_session_id(m_sessionId);
+    request.set_position(position);
+
+    auto response = std::make_shared<firebolt::rialto::SetPositionResponse>();
+    auto ipcController = m_ipc.createRpcController();
+    google::protobuf::Closure *closure = ipc::createCallbackClosure(
+        [ipcController, response, callback = std::move(callback)]()
+        {
+            if (ipcController->Failed())
+            {
+                RIALTO_CLIENT_LOG_ERROR("failed to set position due to '%s'", ipcController->ErrorText().c_str());
+                callback(false);
+                return;
+            }
+            callback(true);
+        });
+    m_mediaPipelineStub->setPosition(ipcController.get(), &request, response.get(), closure);
+
+    return true;
+}
+
+bool MediaPipelineIpc::getPositionAsync(std::function<void(bool success, int64_t position)> &&callback)
+{
+    if (!reattachChannelIfRequired())
+    {
+        RIALTO_CLIENT_LOG_ERROR("Reattachment of the ipc channel failed, ipc disconnected");
+        return false;
+    }
+
+    firebolt::rialto::GetPositionRequest request;
+
+    request.set_session_id(m_sessionId);
+
+    auto response = std::make_shared<firebolt::rialto::GetPositionResponse>();
+    auto ipcController = m_ipc.createRpcController();
+    google::protobuf::Closure *closure = ipc::createCallbackClosure(
+        [ipcController, response, callback = std::move(callback)]()
+        {
+            if (ipcController->Failed())
+            {
+                RIALTO_CLIENT_LOG_ERROR("failed to get position due to '%s'", ipcController->ErrorText().c_str());
+                callback(false, 0);
+                return;
+            }
+            callback(true, response->position());
+        });
+    m_mediaPipelineStub->getPosition(ipcController.get(), &request, response.get(), closure);
+
+    return true;
+}
+
 bool MediaPipelineIpc::getDuration(int64_t &duration)
 {
     if (!reattachChannelIfRequired())
@@ -741,6 +912,41 @@ bool MediaPipelineIpc::getStats(int32_t sourceId, uint64_t &renderedFrames, uint
     return true;
 }
 
+bool MediaPipelineIpc::enableStreamingMode(int32_t sourceId, int &doorbellFd, uint32_t &ringOffset,
+                                           uint32_t &ringCapacity)
+{
+    if (!reattachChannelIfRequired())
+    {
+        RIALTO_CLIENT_LOG_ERROR("Reattachment of the ipc channel failed, ipc disconnected");
+        return false;
+    }
+
+    firebolt::rialto::EnableStreamingModeRequest request;
+
+    request.set_session_id(m_sessionId);
+    request.set_source_id(sourceId);
+
+    firebolt::rialto::EnableStreamingModeResponse response;
+    auto ipcController = m_ipc.createRpcController();
+    auto blockingClosure = m_ipc.createBlockingClosure();
+    m_mediaPipelineStub->enableStreamingMode(ipcController.get(), &request, &response, blockingClosure.get());
+
+    // wait for the call to complete
+    blockingClosure->wait();
+
+    // check the result
+    if (ipcController->Failed())
+    {
+        RIALTO_CLIENT_LOG_ERROR("failed to enable streaming mode due to '%s'", ipcController->ErrorText().c_str());
+        return false;
+    }
+
+    doorbellFd = response.doorbell_fd();
+    ringOffset = response.ring_offset();
+    ringCapacity = response.ring_capacity();
+    return true;
+}
+
 bool MediaPipelineIpc::setPlaybackRate(double rate)
 {
     if (!reattachChannelIfRequired())
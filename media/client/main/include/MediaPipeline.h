@@ -26,6 +26,7 @@
 #include "IMediaFrameWriter.h"
 #include "IMediaPipeline.h"
 #include "IMediaPipelineIpc.h"
+#include "ShmRing.h"
 #include <atomic>
 #include <condition_variable>
 #include <map>
@@ -130,6 +131,10 @@ public:
 
     bool getPosition(int64_t &position) override;
 
+    bool setPositionAsync(int64_t position, std::function<void(bool success)> callback) override;
+
+    bool getPositionAsync(std::function<void(bool success, int64_t position)> callback) override;
+
     bool setImmediateOutput(int32_t sourceId, bool immediateOutput) override;
 
     bool setReportDecodeErrors(int32_t sourceId, bool reportDecodeErrors) override;
@@ -143,6 +148,13 @@ public:
 
     bool haveData(MediaSourceStatus status, uint32_t needDataRequestId) override;
 
+    bool haveDataAsync(MediaSourceStatus status, uint32_t needDataRequestId,
+                       std::function<void(bool success)> callback) override;
+
+    bool enableStreamingMode(int32_t sourceId) override;
+
+    bool setStreamingEos(int32_t sourceId) override;
+
     AddSegmentStatus addSegment(uint32_t needDataRequestId, const std::unique_ptr<MediaSegment> &mediaSegment) override;
 
     std::weak_ptr<IMediaPipelineClient> getClient() override;
@@ -228,6 +240,20 @@ protected:
         std::unique_ptr<common::IMediaFrameWriter> frameWriter; /**< The frame writer used to add segments. */
     };
 
+    /**
+     * @brief The writer side of the ring of a source in streaming mode.
+     */
+    struct StreamingSource
+    {
+        ~StreamingSource();
+
+        std::shared_ptr<ISharedMemoryHandle> shmHandle; /**< Keeps the shared memory with the ring mapped. */
+        ipc::ShmRing ring;                              /**< The ring read by the server. */
+        int doorbellFd{-1};                             /**< The eventfd which wakes the server up, owned. */
+        uint64_t generation{0};                         /**< The flush generation of the written records. */
+        std::vector<uint8_t> metadata;                  /**< The storage of the serialised frame metadata. */
+    };
+
     /**
      * @brief The media player client.
      */
@@ -255,6 +281,13 @@ protected:
      */
     ApplicationState m_currentAppState;
 
+    /**
+     * @brief The sources in streaming mode. Protected by m_needDataRequestMapMutex
+     * Key: sourceId
+     * Value: StreamingSource
+     */
+    std::map<int32_t, std::unique_ptr<StreamingSource>> m_streamingSources;
+
     /**
      * @brief The need data request map mutex.
      */
@@ -300,6 +333,36 @@ protected:
      */
     AttachedSources m_attachedSources;
 
+    /**
+     * @brief A blocking have data request waiting for its ipc call.
+     */
+    struct PendingHaveData
+    {
+        HaveDataInfo info; /**< The request sent to the server. */
+        bool isDone;       /**< Whether the ipc call of the request has completed. */
+        bool result;       /**< The result of the ipc call, once done. */
+    };
+
+    /**
+     * @brief The pending have data mutex.
+     */
+    std::mutex m_haveDataMutex;
+
+    /**
+     * @brief Notified when a have data ipc call completes.
+     */
+    std::condition_variable m_haveDataCond;
+
+    /**
+     * @brief The blocking have data requests queued while another one was being sent. Protected by m_haveDataMutex
+     */
+    std::vector<std::shared_ptr<PendingHaveData>> m_pendingHaveData;
+
+    /**
+     * @brief Whether a blocking have data ipc call is in progress. Protected by m_haveDataMutex
+     */
+    bool m_isSendingHaveData;
+
     /**
      * @brief Sets the new internal MediaPipeline state based on the NetworkState.
      *
@@ -314,24 +377,49 @@ protected:
      */
     void updateState(PlaybackState state);
 
+    /**
+     * @brief Checks the state and handles a have data request.
+     *
+     * @param[in] status  : The status
+     * @param[in] needDataRequestId : Need data request id
+     * @param[in] callback : If set the request is non-blocking and the callback is called with the result.
+     *
+     * @retval true on success, or if the request was made when non-blocking.
+     */
+    bool haveDataInternal(MediaSourceStatus status, uint32_t needDataRequestId,
+                          std::function<void(bool success)> &&callback);
+
     /**
      * @brief Handles a have data request.
      *
      * @param[in] status  : The status
      * @param[in] needDataRequestId : Need data request id
+     * @param[in] callback : If set the request is non-blocking and the callback is called with the result.
      *
-     * @retval true on success.
+     * @retval true on success, or if the request was made when non-blocking.
+     */
+    bool handleHaveData(MediaSourceStatus status, uint32_t needDataRequestId,
+                        std::function<void(bool success)> &&callback);
+
+    /**
+     * @brief Checks the state and handles a set position request.
+     *
+     * @param[in] position : The playback position in nanoseconds.
+     * @param[in] callback : If set the request is non-blocking and the callback is called with the result.
+     *
+     * @retval true on success, or if the request was made when non-blocking.
      */
-    bool handleHaveData(MediaSourceStatus status, uint32_t needDataRequestId);
+    bool setPositionInternal(int64_t position, std::function<void(bool success)> &&callback);
 
     /**
      * @brief Handles a set position request.
      *
      * @param[in] position : The playback position in nanoseconds.
+     * @param[in] callback : If set the request is non-blocking and the callback is called with the result.
      *
-     * @retval true on success.
+     * @retval true on success, or if the request was made when non-blocking.
      */
-    bool handleSetPosition(int64_t position);
+    bool handleSetPosition(int64_t position, std::function<void(bool success)> &&callback);
 
     /**
      * @brief Discards the need data request with id.
@@ -339,6 +427,48 @@ protected:
      * @param[in] needDataRequestId : Need data request id
      */
     void discardNeedDataRequest(uint32_t needDataRequestId);
+
+    /**
+     * @brief Adds a segment of a source in streaming mode to its ring.
+     *
+     * Must be called with m_needDataRequestMapMutex locked.
+     *
+     * @param[in] streamingSource : The source in streaming mode.
+     * @param[in] mediaSegment    : The segment.
+     *
+     * @retval status of adding segment, NO_SPACE if the ring is full.
+     */
+    AddSegmentStatus addSegmentToRing(StreamingSource &streamingSource,
+                                      const std::unique_ptr<MediaSegment> &mediaSegment);
+
+    /**
+     * @brief Writes a record to the ring of a source in streaming mode and wakes the server up if it waits for it.
+     *
+     * Must be called with m_needDataRequestMapMutex locked.
+     *
+     * @param[in] streamingSource : The source in streaming mode.
+     * @param[in] tag             : The tag of the record.
+     * @param[in] header          : The serialised metadata, stored in front of the media data.
+     * @param[in] headerLength    : The length of the serialised metadata.
+     * @param[in] data            : The media data.
+     * @param[in] length          : The length of the media data.
+     *
+     * @retval true on success, false if the ring is full.
+     */
+    bool writeToRing(StreamingSource &streamingSource, uint64_t tag, const void *header, size_t headerLength,
+                     const void *data, size_t length);
+
+    /**
+     * @brief Sends a blocking have data request to the server.
+     *
+     * The requests of the sources that arrive while another one is being sent are queued, and sent together in a
+     * single haveDataMulti call once it completes.
+     *
+     * @param[in] info : The have data request.
+     *
+     * @retval true on success.
+     */
+    bool sendHaveData(const HaveDataInfo &info);
 };
 
 }; // namespace firebolt::rialto::client
@@ -64,6 +64,16 @@ public:
 
     bool getPosition(int64_t &position) override { return m_mediaPipeline->getPosition(position); }
 
+    bool setPositionAsync(int64_t position, std::function<void(bool success)> callback) override
+    {
+        return m_mediaPipeline->setPositionAsync(position, std::move(callback));
+    }
+
+    bool getPositionAsync(std::function<void(bool success, int64_t position)> callback) override
+    {
+        return m_mediaPipeline->getPositionAsync(std::move(callback));
+    }
+
     bool setImmediateOutput(int32_t sourceId, bool immediateOutput)
     {
         return m_mediaPipeline->setImmediateOutput(sourceId, immediateOutput);
@@ -96,6 +106,16 @@ public:
         return m_mediaPipeline->haveData(status, needDataRequestId);
     }
 
+    bool haveDataAsync(MediaSourceStatus status, uint32_t needDataRequestId,
+                       std::function<void(bool success)> callback) override
+    {
+        return m_mediaPipeline->haveDataAsync(status, needDataRequestId, std::move(callback));
+    }
+
+    bool enableStreamingMode(int32_t sourceId) override { return m_mediaPipeline->enableStreamingMode(sourceId); }
+
+    bool setStreamingEos(int32_t sourceId) override { return m_mediaPipeline->setStreamingEos(sourceId); }
+
     AddSegmentStatus addSegment(uint32_t needDataRequestId, const std::unique_ptr<MediaSegment> &mediaSegment) override
     {
         return m_mediaPipeline->addSegment(needDataRequestId, mediaSegment);
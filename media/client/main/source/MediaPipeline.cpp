@@ -20,6 +20,8 @@
 #include <inttypes.h>
 #include <stdexcept>
 #include <stdint.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 #include "KeyIdMap.h"
 #include "MediaPipeline.h"
@@ -184,7 +186,8 @@ MediaPipeline::MediaPipeline(std::weak_ptr<IMediaPipelineClient> client, const V
                              const std::shared_ptr<common::IMediaFrameWriterFactory> &mediaFrameWriterFactory,
                              IClientController &clientController)
     : m_mediaPipelineClient(client), m_clientController{clientController}, m_currentAppState{ApplicationState::UNKNOWN},
-      m_mediaFrameWriterFactory(mediaFrameWriterFactory), m_currentState(State::IDLE), m_attachingSource(false)
+      m_mediaFrameWriterFactory(mediaFrameWriterFactory), m_currentState(State::IDLE), m_attachingSource(false),
+      m_isSendingHaveData(false)
 {
     RIALTO_CLIENT_LOG_DEBUG("entry:");
 
@@ -196,6 +199,14 @@ MediaPipeline::MediaPipeline(std::weak_ptr<IMediaPipelineClient> client, const V
     }
 }
 
+MediaPipeline::StreamingSource::~StreamingSource()
+{
+    if (doorbellFd >= 0)
+    {
+        close(doorbellFd);
+    }
+}
+
 MediaPipeline::~MediaPipeline()
 {
     RIALTO_CLIENT_LOG_DEBUG("entry:");
@@ -242,6 +253,10 @@ bool MediaPipeline::removeSource(int32_t id)
 {
     RIALTO_CLIENT_LOG_DEBUG("entry:");
     m_attachedSources.remove(id);
+    {
+        std::lock_guard<std::mutex> lock{m_needDataRequestMapMutex};
+        m_streamingSources.erase(id);
+    }
     return m_mediaPipelineIpc->removeSource(id);
 }
 
@@ -283,6 +298,20 @@ bool MediaPipeline::setPlaybackRate(double rate)
 }
 
 bool MediaPipeline::setPosition(int64_t position)
+{
+    return setPositionInternal(position, nullptr);
+}
+
+bool MediaPipeline::setPositionAsync(int64_t position, std::function<void(bool success)> callback)
+{
+    if (!callback)
+    {
+        callback = [](bool) {};
+    }
+    return setPositionInternal(position, std::move(callback));
+}
+
+bool MediaPipeline::setPositionInternal(int64_t position, std::function<void(bool success)> &&callback)
 {
     switch (m_currentState)
     {
@@ -291,7 +320,7 @@ bool MediaPipeline::setPosition(int64_t position)
     case State::SEEKING:
     case State::END_OF_STREAM:
     {
-        return handleSetPosition(position);
+        return handleSetPosition(position, std::move(callback));
     }
     case State::IDLE:
     case State::FAILURE:
@@ -308,6 +337,15 @@ bool MediaPipeline::getPosition(int64_t &position)
     return m_mediaPipelineIpc->getPosition(position);
 }
 
+bool MediaPipeline::getPositionAsync(std::function<void(bool success, int64_t position)> callback)
+{
+    if (!callback)
+    {
+        callback = [](bool, int64_t) {};
+    }
+    return m_mediaPipelineIpc->getPositionAsync(std::move(callback));
+}
+
 bool MediaPipeline::setImmediateOutput(int32_t sourceId, bool immediateOutput)
 {
     return m_mediaPipelineIpc->setImmediateOutput(sourceId, immediateOutput);
@@ -333,13 +371,17 @@ bool MediaPipeline::getStats(int32_t sourceId, uint64_t &renderedFrames, uint64_
     return m_mediaPipelineIpc->getStats(sourceId, renderedFrames, droppedFrames);
 }
 
-bool MediaPipeline::handleSetPosition(int64_t position)
+bool MediaPipeline::handleSetPosition(int64_t position, std::function<void(bool success)> &&callback)
 {
     // needData requests no longer valid
     {
         std::lock_guard<std::mutex> lock{m_needDataRequestMapMutex};
         m_needDataRequestMap.clear();
     }
+    if (callback)
+    {
+        return m_mediaPipelineIpc->setPositionAsync(position, std::move(callback));
+    }
     return m_mediaPipelineIpc->setPosition(position);
 }
 
@@ -354,17 +396,39 @@ bool MediaPipeline::haveData(MediaSourceStatus status, uint32_t needDataRequestI
 {
     RIALTO_CLIENT_LOG_DEBUG("entry:");
 
+    return haveDataInternal(status, needDataRequestId, nullptr);
+}
+
+bool MediaPipeline::haveDataAsync(MediaSourceStatus status, uint32_t needDataRequestId,
+                                  std::function<void(bool success)> callback)
+{
+    RIALTO_CLIENT_LOG_DEBUG("entry:");
+
+    if (!callback)
+    {
+        callback = [](bool) {};
+    }
+    return haveDataInternal(status, needDataRequestId, std::move(callback));
+}
+
+bool MediaPipeline::haveDataInternal(MediaSourceStatus status, uint32_t needDataRequestId,
+                                     std::function<void(bool success)> &&callback)
+{
     switch (m_currentState)
     {
     case State::BUFFERING:
     case State::PLAYING:
     {
-        return handleHaveData(status, needDataRequestId);
+        return handleHaveData(status, needDataRequestId, std::move(callback));
     }
     case State::SEEKING:
     {
         RIALTO_CLIENT_LOG_INFO("HaveData received while seeking, discarding NeedData request %u", needDataRequestId);
         discardNeedDataRequest(needDataRequestId);
+        if (callback)
+        {
+            callback(true);
+        }
         return true;
     }
     case State::IDLE:
@@ -380,7 +444,8 @@ bool MediaPipeline::haveData(MediaSourceStatus status, uint32_t needDataRequestI
     }
 }
 
-bool MediaPipeline::handleHaveData(MediaSourceStatus status, uint32_t needDataRequestId)
+bool MediaPipeline::handleHaveData(MediaSourceStatus status, uint32_t needDataRequestId,
+                                   std::function<void(bool success)> &&callback)
 {
     RIALTO_CLIENT_LOG_DEBUG("entry:");
 
@@ -396,6 +461,10 @@ bool MediaPipeline::handleHaveData(MediaSourceStatus status, uint32_t needDataRe
         {
             // Return success here as the data written is just ignored
             RIALTO_CLIENT_LOG_WARN("Could not find need data request, with id %u", needDataRequestId);
+            if (callback)
+            {
+                callback(true);
+            }
             return true;
         }
 
@@ -406,35 +475,190 @@ bool MediaPipeline::handleHaveData(MediaSourceStatus status, uint32_t needDataRe
     {
         RIALTO_CLIENT_LOG_WARN("Source %d is flushing. Ignoring need data request, with id %u",
                                needDataRequest->sourceId, needDataRequestId);
+        if (callback)
+        {
+            callback(true);
+        }
         return true;
     }
 
     uint32_t numFrames = needDataRequest->frameWriter ? needDataRequest->frameWriter->getNumFrames() : 0;
-    return m_mediaPipelineIpc->haveData(status, numFrames, needDataRequestId);
+    if (callback)
+    {
+        return m_mediaPipelineIpc->haveDataAsync(status, numFrames, needDataRequestId, std::move(callback));
+    }
+    return sendHaveData(HaveDataInfo{status, numFrames, needDataRequestId});
 }
 
-AddSegmentStatus MediaPipeline::addSegment(uint32_t needDataRequestId, const std::unique_ptr<MediaSegment> &mediaSegment)
+bool MediaPipeline::sendHaveData(const HaveDataInfo &info)
+{
+    std::unique_lock<std::mutex> lock{m_haveDataMutex};
+    auto pendingHaveData = std::make_shared<PendingHaveData>(PendingHaveData{info, false, false});
+    m_pendingHaveData.push_back(pendingHaveData);
+    m_haveDataCond.wait(lock, [&]() { return pendingHaveData->isDone || !m_isSendingHaveData; });
+    if (pendingHaveData->isDone)
+    {
+        return pendingHaveData->result;
+    }
+
+    // Send all the requests queued since the last call, including this one
+    std::vector<std::shared_ptr<PendingHaveData>> batch;
+    batch.swap(m_pendingHaveData);
+    m_isSendingHaveData = true;
+    lock.unlock();
+
+    std::vector<bool> results;
+    if (1 == batch.size())
+    {
+        results.push_back(m_mediaPipelineIpc->haveData(info.status, info.numFrames, info.requestId));
+    }
+    else
+    {
+        std::vector<HaveDataInfo> haveDataInfos;
+        haveDataInfos.reserve(batch.size());
+        for (const auto &pending : batch)
+        {
+            haveDataInfos.push_back(pending->info);
+        }
+        RIALTO_CLIENT_LOG_DEBUG("Sending %zu have data requests together", haveDataInfos.size());
+        if (!m_mediaPipelineIpc->haveDataMulti(haveDataInfos, results))
+        {
+            results.assign(batch.size(), false);
+        }
+    }
+
+    lock.lock();
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        batch[i]->isDone = true;
+        batch[i]->result = results[i];
+    }
+    m_isSendingHaveData = false;
+    m_haveDataCond.notify_all();
+    return pendingHaveData->result;
+}
+
+bool MediaPipeline::enableStreamingMode(int32_t sourceId)
 {
     RIALTO_CLIENT_LOG_DEBUG("entry:");
 
-    if (nullptr == mediaSegment || nullptr == mediaSegment->getData())
+    if (MediaSourceType::UNKNOWN == m_attachedSources.getType(sourceId))
     {
-        return AddSegmentStatus::ERROR;
+        RIALTO_CLIENT_LOG_ERROR("Source %d is not attached", sourceId);
+        return false;
+    }
+
+    std::shared_ptr<ISharedMemoryHandle> shmHandle;
+    {
+        std::lock_guard<std::mutex> lock{m_needDataRequestMapMutex};
+        if (ApplicationState::RUNNING != m_currentAppState)
+        {
+            RIALTO_CLIENT_LOG_ERROR("Streaming mode can only be enabled in state RUNNING");
+            return false;
+        }
+        if (m_streamingSources.find(sourceId) != m_streamingSources.end())
+        {
+            RIALTO_CLIENT_LOG_ERROR("Source %d is already in streaming mode", sourceId);
+            return false;
+        }
+        shmHandle = m_clientController.getSharedMemoryHandle();
+        if (nullptr == shmHandle || nullptr == shmHandle->getShm())
+        {
+            RIALTO_CLIENT_LOG_ERROR("Shared buffer no longer valid");
+            return false;
+        }
+
+        // The server drops the outstanding need data requests of the source
+        for (auto it = m_needDataRequestMap.begin(); it != m_needDataRequestMap.end();)
+        {
+            if (it->second->sourceId == sourceId)
+            {
+                it = m_needDataRequestMap.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
     }
 
+    // The ipc call is made without the lock, as the need data notifications are handled on the ipc thread
+    auto streamingSource = std::make_unique<StreamingSource>();
+    uint32_t ringOffset{0};
+    uint32_t ringCapacity{0};
+    if (!m_mediaPipelineIpc->enableStreamingMode(sourceId, streamingSource->doorbellFd, ringOffset, ringCapacity))
+    {
+        return false;
+    }
+    if (!streamingSource->ring.attach(shmHandle->getShm() + ringOffset, ringCapacity))
+    {
+        RIALTO_CLIENT_LOG_ERROR("Failed to attach the ring of source %d", sourceId);
+        return false;
+    }
+    streamingSource->shmHandle = std::move(shmHandle);
+
     std::lock_guard<std::mutex> lock{m_needDataRequestMapMutex};
-    auto needDataRequestIt = m_needDataRequestMap.find(needDataRequestId);
-    if (needDataRequestIt == m_needDataRequestMap.end())
+    m_streamingSources[sourceId] = std::move(streamingSource);
+    return true;
+}
+
+bool MediaPipeline::setStreamingEos(int32_t sourceId)
+{
+    RIALTO_CLIENT_LOG_DEBUG("entry:");
+
+    std::lock_guard<std::mutex> lock{m_needDataRequestMapMutex};
+    auto streamingSourceIt = m_streamingSources.find(sourceId);
+    if (streamingSourceIt == m_streamingSources.end())
     {
-        RIALTO_CLIENT_LOG_ERROR("Could not find need data request, with id %u", needDataRequestId);
+        RIALTO_CLIENT_LOG_ERROR("Source %d is not in streaming mode", sourceId);
+        return false;
+    }
+    StreamingSource &streamingSource{*streamingSourceIt->second};
+    return writeToRing(streamingSource, streamingSource.generation | common::SHM_RING_END_OF_STREAM_TAG, nullptr, 0,
+                       nullptr, 0);
+}
+
+bool MediaPipeline::writeToRing(StreamingSource &streamingSource, uint64_t tag, const void *header,
+                                size_t headerLength, const void *data, size_t length)
+{
+    if (!streamingSource.ring.write(tag, header, headerLength, data, length))
+    {
+        return false;
+    }
+    if (streamingSource.ring.clearConsumerWaiting() && eventfd_write(streamingSource.doorbellFd, 1) < 0)
+    {
+        RIALTO_CLIENT_LOG_SYS_ERROR(errno, "Failed to ring the doorbell");
+    }
+    return true;
+}
+
+AddSegmentStatus MediaPipeline::addSegmentToRing(StreamingSource &streamingSource,
+                                                 const std::unique_ptr<MediaSegment> &mediaSegment)
+{
+    if (!m_mediaFrameWriterFactory->serializeStreamingMetadata(mediaSegment, streamingSource.metadata))
+    {
+        RIALTO_CLIENT_LOG_ERROR("Failed to serialise the metadata");
+        return AddSegmentStatus::ERROR;
+    }
+    if (streamingSource.metadata.size() + mediaSegment->getDataLength() > streamingSource.ring.maxRecordSize())
+    {
+        RIALTO_CLIENT_LOG_ERROR("Segment of %u bytes does not fit in the ring", mediaSegment->getDataLength());
         return AddSegmentStatus::ERROR;
     }
+    if (!writeToRing(streamingSource, streamingSource.generation, streamingSource.metadata.data(),
+                     streamingSource.metadata.size(), mediaSegment->getData(), mediaSegment->getDataLength()))
+    {
+        return AddSegmentStatus::NO_SPACE;
+    }
+    return AddSegmentStatus::OK;
+}
 
-    std::shared_ptr<NeedDataRequest> needDataRequest = needDataRequestIt->second;
-    std::shared_ptr<ISharedMemoryHandle> shmHandle = m_clientController.getSharedMemoryHandle();
-    if (nullptr == shmHandle || nullptr == shmHandle->getShm())
+AddSegmentStatus MediaPipeline::addSegment(uint32_t needDataRequestId, const std::unique_ptr<MediaSegment> &mediaSegment)
+{
+    RIALTO_CLIENT_LOG_DEBUG("entry:");
+
+    if (nullptr == mediaSegment || nullptr == mediaSegment->getData())
     {
-        RIALTO_CLIENT_LOG_ERROR("Shared buffer no longer valid");
         return AddSegmentStatus::ERROR;
     }
 
@@ -450,6 +674,28 @@ AddSegmentStatus MediaPipeline::addSegment(uint32_t needDataRequestId, const std
         }
     }
 
+    std::lock_guard<std::mutex> lock{m_needDataRequestMapMutex};
+    auto streamingSourceIt = m_streamingSources.find(mediaSegment->getId());
+    if (streamingSourceIt != m_streamingSources.end())
+    {
+        return addSegmentToRing(*streamingSourceIt->second, mediaSegment);
+    }
+
+    auto needDataRequestIt = m_needDataRequestMap.find(needDataRequestId);
+    if (needDataRequestIt == m_needDataRequestMap.end())
+    {
+        RIALTO_CLIENT_LOG_ERROR("Could not find need data request, with id %u", needDataRequestId);
+        return AddSegmentStatus::ERROR;
+    }
+
+    std::shared_ptr<NeedDataRequest> needDataRequest = needDataRequestIt->second;
+    std::shared_ptr<ISharedMemoryHandle> shmHandle = m_clientController.getSharedMemoryHandle();
+    if (nullptr == shmHandle || nullptr == shmHandle->getShm())
+    {
+        RIALTO_CLIENT_LOG_ERROR("Shared buffer no longer valid");
+        return AddSegmentStatus::ERROR;
+    }
+
     if (!needDataRequest->frameWriter)
     {
         if (firebolt::rialto::MediaSourceType::UNKNOWN != mediaSegment->getType())
@@ -566,6 +812,13 @@ bool MediaPipeline::flush(int32_t sourceId, bool resetTime, bool &async)
 
     // Clear all need datas for flushed source
     std::lock_guard<std::mutex> lock{m_needDataRequestMapMutex};
+    auto streamingSourceIt = m_streamingSources.find(sourceId);
+    if (streamingSourceIt != m_streamingSources.end())
+    {
+        // The server drops the records written before the flush
+        StreamingSource &streamingSource{*streamingSourceIt->second};
+        streamingSource.generation = (streamingSource.generation + 1) & common::SHM_RING_GENERATION_MASK;
+    }
     for (auto it = m_needDataRequestMap.begin(); it != m_needDataRequestMap.end();)
     {
         if (it->second->sourceId == sourceId)
@@ -863,6 +1116,7 @@ void MediaPipeline::notifyApplicationState(ApplicationState state)
     {
         // If shared memory in use, wait for it to finish before returning
         m_needDataRequestMap.clear();
+        m_streamingSources.clear();
     }
 }
 
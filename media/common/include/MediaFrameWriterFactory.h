@@ -34,6 +34,8 @@ public:
     MediaFrameWriterFactory();
     std::unique_ptr<IMediaFrameWriter> createFrameWriter(uint8_t *shmBuffer,
                                                          const std::shared_ptr<MediaPlayerShmInfo> &shminfo) override;
+    bool serializeStreamingMetadata(const std::unique_ptr<IMediaPipeline::MediaSegment> &data,
+                                    std::vector<uint8_t> &metadata) override;
 
 private:
     int m_metadataVersion;
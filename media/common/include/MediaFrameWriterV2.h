@@ -63,6 +63,19 @@ public:
      */
     uint32_t getNumFrames() override { return m_numFrames; }
 
+    /**
+     * @brief Serialises the metadata of a frame, preceded by its size, as it is stored in front of the media data.
+     *
+     * Used by the writer of a source in streaming mode, which appends the media data to it in a ring record.
+     *
+     * @param[in]  data     : Media Segment data.
+     * @param[out] metadata : The metadata size and metadata. The storage is reused between frames.
+     *
+     * @retval true on success.
+     */
+    static bool serializeMetadata(const std::unique_ptr<IMediaPipeline::MediaSegment> &data,
+                                  std::vector<uint8_t> &metadata);
+
 private:
     /**
      * @brief Builds metadata proto object
@@ -73,7 +86,21 @@ private:
      *
      * @retval MediaSegmentMetadata proto object
      */
-    MediaSegmentMetadata buildMetadata(const std::unique_ptr<IMediaPipeline::MediaSegment> &data) const;
+    static MediaSegmentMetadata buildMetadata(const std::unique_ptr<IMediaPipeline::MediaSegment> &data);
+
+    /**
+     * @brief Reads the generation published by the server in the region header.
+     *
+     * @param[in] shmInfo   : The information for populating the shared memory.
+     *
+     * @retval true if the server published a region header.
+     */
+    bool readPublishedGeneration(const std::shared_ptr<MediaPlayerShmInfo> &shmInfo);
+
+    /**
+     * @brief Commits the number of frames and valid bytes written for the published generation.
+     */
+    void commitRegionHeader();
 
 private:
     /**
@@ -105,6 +132,21 @@ private:
      * @brief Number of frames written.
      */
     uint32_t m_numFrames;
+
+    /**
+     * @brief The offset of the metadata region.
+     */
+    const uint32_t m_kMetadataOffset;
+
+    /**
+     * @brief Whether the server published a region header, so the region does not have to be zeroed.
+     */
+    bool m_isRegionHeaderPublished;
+
+    /**
+     * @brief The generation published by the server.
+     */
+    uint32_t m_generation;
 };
 } // namespace firebolt::rialto::common
 
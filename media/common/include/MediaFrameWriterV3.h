@@ -0,0 +1,150 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_COMMON_MEDIA_FRAME_WRITERV3_H_
+#define FIREBOLT_RIALTO_COMMON_MEDIA_FRAME_WRITERV3_H_
+
+#include "ByteWriter.h"
+#include "IMediaFrameWriter.h"
+#include "ShmCommon.h"
+#include <memory>
+
+namespace firebolt::rialto::common
+{
+/**
+ * @brief The definition of the MediaFrameWriterV3.
+ *
+ * Writes every frame as a fixed layout MediaFrameHeaderV3, followed by a tail with the variable length fields and
+ * the media data, so that no metadata has to be serialised or parsed per frame.
+ */
+class MediaFrameWriterV3 : public IMediaFrameWriter
+{
+public:
+    /**
+     * @brief The constructor.
+     *
+     * @param[in] shmBuffer     : The shared buffer pointer.
+     * @param[in] shmInfo       : The information for populating the shared memory.
+     */
+    MediaFrameWriterV3(uint8_t *shmBuffer, const std::shared_ptr<MediaPlayerShmInfo> &shmInfo);
+
+    /**
+     * @brief Virtual destructor.
+     */
+    virtual ~MediaFrameWriterV3() = default;
+
+    /**
+     * @brief Write the frame data.
+     *
+     * @param[in] data  : Media Segment data.
+     *
+     * @retval true on success.
+     */
+    AddSegmentStatus writeFrame(const std::unique_ptr<IMediaPipeline::MediaSegment> &data) override;
+
+    /**
+     * @brief Gets number of written frames
+     *
+     * @retval number of written frames
+     */
+    uint32_t getNumFrames() override { return m_numFrames; }
+
+private:
+    /**
+     * @brief Builds the frame header
+     *
+     * @param[in] data  : Media Segment data.
+     *
+     * @warning Method may throw!
+     *
+     * @retval the frame header
+     */
+    MediaFrameHeaderV3 buildHeader(const std::unique_ptr<IMediaPipeline::MediaSegment> &data) const;
+
+    /**
+     * @brief Writes the variable length fields of the frame.
+     *
+     * @param[in] data  : Media Segment data.
+     * @param[in] offset : The offset of the tail.
+     */
+    void writeTail(const std::unique_ptr<IMediaPipeline::MediaSegment> &data, size_t offset) const;
+
+    /**
+     * @brief Reads the generation published by the server in the region header.
+     *
+     * @param[in] shmInfo   : The information for populating the shared memory.
+     *
+     * @retval true if the server published a region header.
+     */
+    bool readPublishedGeneration(const std::shared_ptr<MediaPlayerShmInfo> &shmInfo);
+
+    /**
+     * @brief Commits the number of frames and valid bytes written for the published generation.
+     */
+    void commitRegionHeader();
+
+private:
+    /**
+     * @brief ByteWriter object.
+     */
+    ByteWriter m_byteWriter;
+
+    /**
+     * @brief Pointer to the shared memory buffer.
+     */
+    uint8_t *m_shmBuffer;
+
+    /**
+     * @brief The maximum amout of data that can be written.
+     */
+    const uint32_t m_kMaxBytes;
+
+    /**
+     * @brief The amount of bytes written to the media data region, including headers, tails and padding.
+     */
+    uint32_t m_bytesWritten;
+
+    /**
+     * @brief The offset of the shared memory to write the data.
+     */
+    uint32_t m_dataOffset;
+
+    /**
+     * @brief Number of frames written.
+     */
+    uint32_t m_numFrames;
+
+    /**
+     * @brief The offset of the metadata region.
+     */
+    const uint32_t m_kMetadataOffset;
+
+    /**
+     * @brief Whether the server published a region header, so the region does not have to be zeroed.
+     */
+    bool m_isRegionHeaderPublished;
+
+    /**
+     * @brief The generation published by the server.
+     */
+    uint32_t m_generation;
+};
+} // namespace firebolt::rialto::common
+
+#endif // FIREBOLT_RIALTO_COMMON_MEDIA_FRAME_WRITERV3_H_
@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "IMediaPipeline.h"
 #include <MediaCommon.h>
@@ -59,6 +60,19 @@ public:
      */
     virtual std::unique_ptr<IMediaFrameWriter> createFrameWriter(uint8_t *shmBuffer,
                                                                  const std::shared_ptr<MediaPlayerShmInfo> &shminfo) = 0;
+
+    /**
+     * @brief Serialises the V2 metadata of a frame, preceded by its size, for the ring of a source in streaming mode.
+     *
+     * The record in the ring holds the serialised metadata directly followed by the media data.
+     *
+     * @param[in]  data     : Media Segment data.
+     * @param[out] metadata : The metadata size and metadata. The storage is reused between frames.
+     *
+     * @retval true on success.
+     */
+    virtual bool serializeStreamingMetadata(const std::unique_ptr<IMediaPipeline::MediaSegment> &data,
+                                            std::vector<uint8_t> &metadata) = 0;
 };
 
 /**
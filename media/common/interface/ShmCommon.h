@@ -20,6 +20,7 @@
 #ifndef FIREBOLT_RIALTO_COMMON_SHM_COMMON_H_
 #define FIREBOLT_RIALTO_COMMON_SHM_COMMON_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace firebolt::rialto::common
@@ -38,6 +39,118 @@ const uint32_t MAX_EXTRA_DATA_SIZE = 32U;
  * @brief Metadata v1 size per frame in bytes.
  */
 const uint32_t METADATA_V1_SIZE_PER_FRAME_BYTES = 104U;
+
+/**
+ * @brief Header of a V2 or V3 metadata region, stored directly after the version.
+ *
+ * Instead of zeroing the whole region before every NeedMediaData, the server publishes a new generation
+ * in the header. The writer commits the generation, the number of frames and the number of valid media
+ * bytes after every frame, and the reader never looks past the committed length. The server also advertises the
+ * latest metadata version it can read, so that the writer can pick it without an IPC round trip.
+ */
+struct ShmRegionHeader
+{
+    uint32_t magic;               /**< SHM_REGION_HEADER_MAGIC when the header was published by the server. */
+    uint32_t generation;          /**< The generation published by the server. */
+    uint32_t committedGeneration; /**< The generation for which the writer committed the data. */
+    uint32_t validLength;         /**< The number of valid bytes in the media data region. */
+    uint32_t numFrames;           /**< The number of frames in the media data region. */
+    uint32_t metadataVersion;     /**< SHM_REGION_METADATA_VERSION_TAG | the latest metadata version of the server. */
+};
+
+const uint32_t SHM_REGION_HEADER_MAGIC = 0x52484452U; // "RHDR"
+
+const uint32_t SHM_REGION_HEADER_OFFSET = VERSION_SIZE_BYTES;
+
+const uint32_t SHM_REGION_HEADER_SIZE_BYTES = 24U;
+
+/**
+ * @brief Tag in the upper half of ShmRegionHeader::metadataVersion.
+ *
+ * Servers which do not advertise their metadata version leave whatever was stored in the region before, so the
+ * field is only trusted when the tag matches. Otherwise the writer assumes that the server supports V2.
+ */
+const uint32_t SHM_REGION_METADATA_VERSION_TAG = 0x4d560000U; // "MV"
+
+const uint32_t SHM_REGION_METADATA_VERSION_TAG_MASK = 0xFFFF0000U;
+
+static_assert(sizeof(ShmRegionHeader) == SHM_REGION_HEADER_SIZE_BYTES, "Unexpected size of ShmRegionHeader");
+
+/**
+ * @brief Fixed layout header of a V3 frame, stored in the media data region directly before the frame.
+ *
+ * The header is followed by the tail, which holds the variable length fields in this order: subsample pairs
+ * (numSubSamples pairs of 32 bit clear and encrypted byte counts), key id, init vector, extra data and codec data.
+ * The tail is padded to MEDIA_FRAME_V3_ALIGNMENT and followed by the media data, which is padded as well, so that
+ * every header starts at the same alignment as the media data region.
+ *
+ * The layout is plain old data with no implicit padding; any change to it requires a new metadata version.
+ */
+struct MediaFrameHeaderV3
+{
+    uint32_t headerSize;          /**< sizeof(MediaFrameHeaderV3), the tail starts headerSize bytes after it. */
+    uint32_t flags;               /**< Bitmask of MEDIA_FRAME_V3_FLAG_* values. */
+    int64_t timePosition;         /**< The timestamp in nanoseconds. */
+    int64_t sampleDuration;       /**< The duration in nanoseconds. */
+    uint64_t displayOffset;       /**< The display offset, valid with MEDIA_FRAME_V3_FLAG_HAS_DISPLAY_OFFSET. */
+    uint64_t clippingStart;       /**< The amount of audio to clip from the start of the frame, audio only. */
+    uint64_t clippingEnd;         /**< The amount of audio to clip from the end of the frame, audio only. */
+    uint32_t streamId;            /**< The id of the source. */
+    uint32_t dataLength;          /**< The number of media bytes, excluding padding. */
+    uint32_t tailLength;          /**< The number of tail bytes, excluding padding. */
+    int32_t sampleRate;           /**< The sample rate, audio only. */
+    int32_t channelsNum;          /**< The number of channels, audio only. */
+    int32_t width;                /**< The width, video only. */
+    int32_t height;               /**< The height, video only. */
+    int32_t frameRateNumerator;   /**< The frame rate numerator, video only. */
+    int32_t frameRateDenominator; /**< The frame rate denominator, video only. */
+    int32_t mediaKeySessionId;    /**< The media key session, valid with MEDIA_FRAME_V3_FLAG_ENCRYPTED. */
+    uint32_t initWithLast15;      /**< Whether to initialise the decryption with the last 15 bytes. */
+    uint32_t crypt;               /**< The crypt byte block, valid with MEDIA_FRAME_V3_FLAG_HAS_ENCRYPTION_PATTERN. */
+    uint32_t skip;                /**< The skip byte block, valid with MEDIA_FRAME_V3_FLAG_HAS_ENCRYPTION_PATTERN. */
+    uint32_t codecDataLength;     /**< The number of codec data bytes in the tail. */
+    uint16_t keyIdLength;         /**< The number of key id bytes in the tail. */
+    uint16_t initVectorLength;    /**< The number of init vector bytes in the tail. */
+    uint16_t extraDataLength;     /**< The number of extra data bytes in the tail. */
+    uint16_t numSubSamples;       /**< The number of subsample pairs in the tail. */
+    uint8_t segmentAlignment;     /**< The SegmentAlignment value. */
+    uint8_t cipherMode;           /**< The CipherMode value. */
+    uint8_t codecDataType;        /**< The CodecDataType value, valid with MEDIA_FRAME_V3_FLAG_HAS_CODEC_DATA. */
+    uint8_t sourceType;           /**< The MediaSourceType value. */
+    uint8_t reserved[4];          /**< Reserved, written as zero. */
+};
+
+const uint32_t MEDIA_FRAME_V3_HEADER_SIZE_BYTES = 120U;
+
+const uint32_t MEDIA_FRAME_V3_ALIGNMENT = 8U;
+
+const uint32_t MEDIA_FRAME_V3_SUBSAMPLE_SIZE_BYTES = 8U;
+
+const uint32_t MEDIA_FRAME_V3_FLAG_ENCRYPTED = 0x1U;
+
+const uint32_t MEDIA_FRAME_V3_FLAG_HAS_DISPLAY_OFFSET = 0x2U;
+
+const uint32_t MEDIA_FRAME_V3_FLAG_HAS_CODEC_DATA = 0x4U;
+
+const uint32_t MEDIA_FRAME_V3_FLAG_HAS_ENCRYPTION_PATTERN = 0x8U;
+
+static_assert(sizeof(MediaFrameHeaderV3) == MEDIA_FRAME_V3_HEADER_SIZE_BYTES, "Unexpected size of MediaFrameHeaderV3");
+static_assert(offsetof(MediaFrameHeaderV3, timePosition) == 8U, "Unexpected layout of MediaFrameHeaderV3");
+static_assert(offsetof(MediaFrameHeaderV3, streamId) == 48U, "Unexpected layout of MediaFrameHeaderV3");
+static_assert(offsetof(MediaFrameHeaderV3, keyIdLength) == 104U, "Unexpected layout of MediaFrameHeaderV3");
+static_assert(offsetof(MediaFrameHeaderV3, segmentAlignment) == 112U, "Unexpected layout of MediaFrameHeaderV3");
+static_assert(MEDIA_FRAME_V3_HEADER_SIZE_BYTES % MEDIA_FRAME_V3_ALIGNMENT == 0U,
+              "MediaFrameHeaderV3 must keep the alignment of the tail");
+
+/**
+ * @brief Tag bit of a record in the ring of a source in streaming mode, which marks the end of stream.
+ *
+ * Every other record holds a single V2 frame (metadata size, metadata and media data). The remaining bits of the
+ * tag hold the flush generation of the writer, records of an older generation are dropped by the reader.
+ */
+const uint64_t SHM_RING_END_OF_STREAM_TAG = 0x8000000000000000ULL;
+
+const uint64_t SHM_RING_GENERATION_MASK = ~SHM_RING_END_OF_STREAM_TAG;
 }; // namespace firebolt::rialto::common
 
 #endif // FIREBOLT_RIALTO_COMMON_SHM_COMMON_H_
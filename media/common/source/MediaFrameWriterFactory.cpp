@@ -20,15 +20,40 @@
 #include "MediaFrameWriterFactory.h"
 #include "MediaFrameWriterV1.h"
 #include "MediaFrameWriterV2.h"
+#include "MediaFrameWriterV3.h"
 #include "RialtoCommonLogging.h"
+#include "ShmCommon.h"
 #include <algorithm>
+#include <cstring>
 #include <string>
 #include <unistd.h>
 
 namespace
 {
-constexpr int kLatestMetadataVersion{2};
+constexpr int kLatestMetadataVersion{3};
+constexpr int kDefaultServerMetadataVersion{2};
 const char *kMetadataEnvVariableName{"RIALTO_METADATA_VERSION"};
+
+/**
+ * @brief Gets the latest metadata version advertised by the server in the region header.
+ */
+int getServerMetadataVersion(const uint8_t *shmBuffer,
+                             const std::shared_ptr<firebolt::rialto::MediaPlayerShmInfo> &shmInfo)
+{
+    using namespace firebolt::rialto::common;
+    if (!shmBuffer || shmInfo->maxMetadataBytes < SHM_REGION_HEADER_OFFSET + SHM_REGION_HEADER_SIZE_BYTES)
+    {
+        return kDefaultServerMetadataVersion;
+    }
+    ShmRegionHeader header;
+    std::memcpy(&header, shmBuffer + shmInfo->metadataOffset + SHM_REGION_HEADER_OFFSET, sizeof(header));
+    if (SHM_REGION_HEADER_MAGIC != header.magic ||
+        SHM_REGION_METADATA_VERSION_TAG != (header.metadataVersion & SHM_REGION_METADATA_VERSION_TAG_MASK))
+    {
+        return kDefaultServerMetadataVersion;
+    }
+    return static_cast<int>(header.metadataVersion & ~SHM_REGION_METADATA_VERSION_TAG_MASK);
+}
 } // namespace
 
 namespace firebolt::rialto::common
@@ -73,6 +98,10 @@ try
     {
         return std::make_unique<MediaFrameWriterV1>(shmBuffer, shmInfo);
     }
+    if (3 <= m_metadataVersion && 3 <= getServerMetadataVersion(shmBuffer, shmInfo))
+    {
+        return std::make_unique<MediaFrameWriterV3>(shmBuffer, shmInfo);
+    }
     return std::make_unique<MediaFrameWriterV2>(shmBuffer, shmInfo);
 }
 catch (const std::exception &e)
@@ -80,4 +109,10 @@ catch (const std::exception &e)
     RIALTO_COMMON_LOG_ERROR("Failed to create the frame writer, reason: %s", e.what());
     return nullptr;
 }
+
+bool MediaFrameWriterFactory::serializeStreamingMetadata(const std::unique_ptr<IMediaPipeline::MediaSegment> &data,
+                                                         std::vector<uint8_t> &metadata)
+{
+    return MediaFrameWriterV2::serializeMetadata(data, metadata);
+}
 } // namespace firebolt::rialto::common
@@ -19,6 +19,9 @@
 
 #include "MediaFrameWriterV2.h"
 #include "RialtoCommonLogging.h"
+#include "ShmCommon.h"
+#include <cstddef>
+#include <cstring>
 
 namespace
 {
@@ -97,16 +100,21 @@ namespace firebolt::rialto::common
 {
 MediaFrameWriterV2::MediaFrameWriterV2(uint8_t *shmBuffer, const std::shared_ptr<MediaPlayerShmInfo> &shmInfo)
     : m_shmBuffer(shmBuffer), m_kMaxBytes(shmInfo->maxMediaBytes), m_bytesWritten(0U),
-      m_dataOffset(shmInfo->mediaDataOffset), m_numFrames{0}
+      m_dataOffset(shmInfo->mediaDataOffset), m_numFrames{0}, m_kMetadataOffset(shmInfo->metadataOffset),
+      m_isRegionHeaderPublished{false}, m_generation{0}
 {
     RIALTO_COMMON_LOG_INFO("We are using a writer for Metadata V2");
 
-    // Zero memory
-    m_byteWriter.fillBytes(m_shmBuffer, shmInfo->metadataOffset, 0, shmInfo->maxMetadataBytes);
-    m_byteWriter.fillBytes(m_shmBuffer, m_dataOffset, 0, m_kMaxBytes);
+    if (!readPublishedGeneration(shmInfo))
+    {
+        // Server does not publish region generations, zero memory
+        m_byteWriter.fillBytes(m_shmBuffer, m_kMetadataOffset, 0, shmInfo->maxMetadataBytes);
+        m_byteWriter.fillBytes(m_shmBuffer, m_dataOffset, 0, m_kMaxBytes);
+    }
 
     // Set metadata version
-    m_byteWriter.writeUint32(m_shmBuffer, shmInfo->metadataOffset, kMetadataVersion);
+    m_byteWriter.writeUint32(m_shmBuffer, m_kMetadataOffset, kMetadataVersion);
+    commitRegionHeader();
 }
 
 AddSegmentStatus MediaFrameWriterV2::writeFrame(const std::unique_ptr<IMediaPipeline::MediaSegment> &data)
@@ -114,7 +122,7 @@ try
 {
     auto metadata{buildMetadata(data)};
     size_t metadataSize{metadata.ByteSizeLong()};
-    if (m_bytesWritten + sizeof(metadataSize) + metadataSize + data->getDataLength() > m_kMaxBytes)
+    if (m_bytesWritten + sizeof(uint32_t) + metadataSize + data->getDataLength() > m_kMaxBytes)
     {
         RIALTO_COMMON_LOG_ERROR("Not enough memory available to write MediaSegment");
         return AddSegmentStatus::NO_SPACE;
@@ -130,8 +138,9 @@ try
     m_dataOffset = m_byteWriter.writeBytes(m_shmBuffer, m_dataOffset, data->getData(), data->getDataLength());
 
     // Track the amount of bytes written
-    m_bytesWritten += sizeof(metadataSize) + metadataSize + data->getDataLength();
+    m_bytesWritten += sizeof(uint32_t) + metadataSize + data->getDataLength();
     ++m_numFrames;
+    commitRegionHeader();
 
     return AddSegmentStatus::OK;
 }
@@ -141,7 +150,57 @@ catch (std::exception &e)
     return AddSegmentStatus::ERROR;
 }
 
-MediaSegmentMetadata MediaFrameWriterV2::buildMetadata(const std::unique_ptr<IMediaPipeline::MediaSegment> &data) const
+bool MediaFrameWriterV2::serializeMetadata(const std::unique_ptr<IMediaPipeline::MediaSegment> &data,
+                                           std::vector<uint8_t> &metadata)
+try
+{
+    auto segmentMetadata{buildMetadata(data)};
+    size_t metadataSize{segmentMetadata.ByteSizeLong()};
+    metadata.resize(sizeof(uint32_t) + metadataSize);
+    ByteWriter{}.writeUint32(metadata.data(), 0, static_cast<uint32_t>(metadataSize));
+    if (!segmentMetadata.SerializeToArray(metadata.data() + sizeof(uint32_t), metadataSize))
+    {
+        RIALTO_COMMON_LOG_ERROR("Failed to write type specific metadata - protobuf serialization failed.");
+        return false;
+    }
+    return true;
+}
+catch (std::exception &e)
+{
+    RIALTO_COMMON_LOG_ERROR("Failed to write type specific metadata - exception occured");
+    return false;
+}
+
+bool MediaFrameWriterV2::readPublishedGeneration(const std::shared_ptr<MediaPlayerShmInfo> &shmInfo)
+{
+    if (shmInfo->maxMetadataBytes < SHM_REGION_HEADER_OFFSET + SHM_REGION_HEADER_SIZE_BYTES)
+    {
+        return false;
+    }
+    ShmRegionHeader header;
+    std::memcpy(&header, m_shmBuffer + m_kMetadataOffset + SHM_REGION_HEADER_OFFSET, sizeof(header));
+    if (SHM_REGION_HEADER_MAGIC != header.magic)
+    {
+        return false;
+    }
+    m_isRegionHeaderPublished = true;
+    m_generation = header.generation;
+    return true;
+}
+
+void MediaFrameWriterV2::commitRegionHeader()
+{
+    if (!m_isRegionHeaderPublished)
+    {
+        return;
+    }
+    size_t offset{m_kMetadataOffset + SHM_REGION_HEADER_OFFSET + offsetof(ShmRegionHeader, committedGeneration)};
+    offset = m_byteWriter.writeUint32(m_shmBuffer, offset, m_generation);
+    offset = m_byteWriter.writeUint32(m_shmBuffer, offset, m_bytesWritten);
+    m_byteWriter.writeUint32(m_shmBuffer, offset, m_numFrames);
+}
+
+MediaSegmentMetadata MediaFrameWriterV2::buildMetadata(const std::unique_ptr<IMediaPipeline::MediaSegment> &data)
 {
     MediaSegmentMetadata metadata;
     metadata.set_length(data->getDataLength());
@@ -0,0 +1,225 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MediaFrameWriterV3.h"
+#include "RialtoCommonLogging.h"
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+/**
+ * @brief The version of metadata this object shall write.
+ */
+constexpr uint32_t kMetadataVersion = 3U;
+
+/**
+ * @brief Rounds the size up to the alignment of the V3 frames.
+ */
+uint64_t alignFrameSize(uint64_t size)
+{
+    return (size + firebolt::rialto::common::MEDIA_FRAME_V3_ALIGNMENT - 1) &
+           ~static_cast<uint64_t>(firebolt::rialto::common::MEDIA_FRAME_V3_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Converts the length of a variable length field, which has to fit in the header.
+ */
+template <typename T> T convertFieldLength(size_t length, const char *fieldName)
+{
+    if (length > std::numeric_limits<T>::max())
+    {
+        RIALTO_COMMON_LOG_ERROR("Failed to write frame header - %s is too long: %zu", fieldName, length);
+        throw std::exception();
+    }
+    return static_cast<T>(length);
+}
+} // namespace
+
+namespace firebolt::rialto::common
+{
+MediaFrameWriterV3::MediaFrameWriterV3(uint8_t *shmBuffer, const std::shared_ptr<MediaPlayerShmInfo> &shmInfo)
+    : m_shmBuffer(shmBuffer), m_kMaxBytes(shmInfo->maxMediaBytes), m_bytesWritten(0U),
+      m_dataOffset(shmInfo->mediaDataOffset), m_numFrames{0}, m_kMetadataOffset(shmInfo->metadataOffset),
+      m_isRegionHeaderPublished{false}, m_generation{0}
+{
+    RIALTO_COMMON_LOG_INFO("We are using a writer for Metadata V3");
+
+    if (!readPublishedGeneration(shmInfo))
+    {
+        // Server does not publish region generations, zero memory
+        m_byteWriter.fillBytes(m_shmBuffer, m_kMetadataOffset, 0, shmInfo->maxMetadataBytes);
+        m_byteWriter.fillBytes(m_shmBuffer, m_dataOffset, 0, m_kMaxBytes);
+    }
+
+    // Set metadata version
+    m_byteWriter.writeUint32(m_shmBuffer, m_kMetadataOffset, kMetadataVersion);
+    commitRegionHeader();
+}
+
+AddSegmentStatus MediaFrameWriterV3::writeFrame(const std::unique_ptr<IMediaPipeline::MediaSegment> &data)
+try
+{
+    const MediaFrameHeaderV3 kHeader{buildHeader(data)};
+    const uint64_t kTailOffset{kHeader.headerSize};
+    const uint64_t kMediaDataOffset{kTailOffset + alignFrameSize(kHeader.tailLength)};
+    const uint64_t kFrameSize{kMediaDataOffset + alignFrameSize(kHeader.dataLength)};
+    if (m_bytesWritten + kFrameSize > m_kMaxBytes)
+    {
+        RIALTO_COMMON_LOG_ERROR("Not enough memory available to write MediaSegment");
+        return AddSegmentStatus::NO_SPACE;
+    }
+    std::memcpy(m_shmBuffer + m_dataOffset, &kHeader, sizeof(kHeader));
+    writeTail(data, m_dataOffset + kTailOffset);
+    m_byteWriter.writeBytes(m_shmBuffer, m_dataOffset + kMediaDataOffset, data->getData(), data->getDataLength());
+
+    // Track the amount of bytes written
+    m_dataOffset += static_cast<uint32_t>(kFrameSize);
+    m_bytesWritten += static_cast<uint32_t>(kFrameSize);
+    ++m_numFrames;
+    commitRegionHeader();
+
+    return AddSegmentStatus::OK;
+}
+catch (std::exception &e)
+{
+    RIALTO_COMMON_LOG_ERROR("Failed to write type specific metadata - exception occured");
+    return AddSegmentStatus::ERROR;
+}
+
+bool MediaFrameWriterV3::readPublishedGeneration(const std::shared_ptr<MediaPlayerShmInfo> &shmInfo)
+{
+    if (shmInfo->maxMetadataBytes < SHM_REGION_HEADER_OFFSET + SHM_REGION_HEADER_SIZE_BYTES)
+    {
+        return false;
+    }
+    ShmRegionHeader header;
+    std::memcpy(&header, m_shmBuffer + m_kMetadataOffset + SHM_REGION_HEADER_OFFSET, sizeof(header));
+    if (SHM_REGION_HEADER_MAGIC != header.magic)
+    {
+        return false;
+    }
+    m_isRegionHeaderPublished = true;
+    m_generation = header.generation;
+    return true;
+}
+
+void MediaFrameWriterV3::commitRegionHeader()
+{
+    if (!m_isRegionHeaderPublished)
+    {
+        return;
+    }
+    size_t offset{m_kMetadataOffset + SHM_REGION_HEADER_OFFSET + offsetof(ShmRegionHeader, committedGeneration)};
+    offset = m_byteWriter.writeUint32(m_shmBuffer, offset, m_generation);
+    offset = m_byteWriter.writeUint32(m_shmBuffer, offset, m_bytesWritten);
+    m_byteWriter.writeUint32(m_shmBuffer, offset, m_numFrames);
+}
+
+MediaFrameHeaderV3 MediaFrameWriterV3::buildHeader(const std::unique_ptr<IMediaPipeline::MediaSegment> &data) const
+{
+    MediaFrameHeaderV3 header{};
+    header.headerSize = sizeof(MediaFrameHeaderV3);
+    header.timePosition = data->getTimeStamp();
+    header.sampleDuration = data->getDuration();
+    header.streamId = static_cast<uint32_t>(data->getId());
+    header.dataLength = data->getDataLength();
+    header.sourceType = static_cast<uint8_t>(data->getType());
+    header.segmentAlignment = static_cast<uint8_t>(data->getSegmentAlignment());
+    if (data->getDisplayOffset())
+    {
+        header.flags |= MEDIA_FRAME_V3_FLAG_HAS_DISPLAY_OFFSET;
+        header.displayOffset = data->getDisplayOffset().value();
+    }
+    if (MediaSourceType::AUDIO == data->getType())
+    {
+        IMediaPipeline::MediaSegmentAudio &audioSegment = dynamic_cast<IMediaPipeline::MediaSegmentAudio &>(*data);
+        header.sampleRate = audioSegment.getSampleRate();
+        header.channelsNum = audioSegment.getNumberOfChannels();
+        header.clippingStart = audioSegment.getClippingStart();
+        header.clippingEnd = audioSegment.getClippingEnd();
+    }
+    else if (MediaSourceType::VIDEO == data->getType())
+    {
+        IMediaPipeline::MediaSegmentVideo &videoSegment = dynamic_cast<IMediaPipeline::MediaSegmentVideo &>(*data);
+        header.width = videoSegment.getWidth();
+        header.height = videoSegment.getHeight();
+        header.frameRateNumerator = videoSegment.getFrameRate().numerator;
+        header.frameRateDenominator = videoSegment.getFrameRate().denominator;
+    }
+    else if (MediaSourceType::SUBTITLE != data->getType())
+    {
+        RIALTO_COMMON_LOG_ERROR("Failed to write type specific metadata - media source type unsupported");
+        throw std::exception();
+    }
+
+    header.extraDataLength = convertFieldLength<uint16_t>(data->getExtraData().size(), "extra data");
+    if (data->getCodecData())
+    {
+        header.flags |= MEDIA_FRAME_V3_FLAG_HAS_CODEC_DATA;
+        header.codecDataLength = convertFieldLength<uint32_t>(data->getCodecData()->data.size(), "codec data");
+        header.codecDataType = static_cast<uint8_t>(data->getCodecData()->type);
+    }
+    if (data->isEncrypted())
+    {
+        header.flags |= MEDIA_FRAME_V3_FLAG_ENCRYPTED;
+        header.mediaKeySessionId = data->getMediaKeySessionId();
+        header.keyIdLength = convertFieldLength<uint16_t>(data->getKeyId().size(), "key id");
+        header.initVectorLength = convertFieldLength<uint16_t>(data->getInitVector().size(), "init vector");
+        header.numSubSamples = convertFieldLength<uint16_t>(data->getSubSamples().size(), "subsamples");
+        header.initWithLast15 = data->getInitWithLast15();
+        header.cipherMode = static_cast<uint8_t>(data->getCipherMode());
+        if (data->getEncryptionPattern(header.crypt, header.skip))
+        {
+            header.flags |= MEDIA_FRAME_V3_FLAG_HAS_ENCRYPTION_PATTERN;
+        }
+    }
+    header.tailLength = convertFieldLength<uint32_t>(header.numSubSamples * MEDIA_FRAME_V3_SUBSAMPLE_SIZE_BYTES +
+                                                         static_cast<uint64_t>(header.keyIdLength) +
+                                                         header.initVectorLength + header.extraDataLength +
+                                                         header.codecDataLength,
+                                                     "tail");
+    return header;
+}
+
+void MediaFrameWriterV3::writeTail(const std::unique_ptr<IMediaPipeline::MediaSegment> &data, size_t offset) const
+{
+    if (data->isEncrypted())
+    {
+        for (const auto &subSample : data->getSubSamples())
+        {
+            const uint32_t kSubSample[]{static_cast<uint32_t>(subSample.numClearBytes),
+                                        static_cast<uint32_t>(subSample.numEncryptedBytes)};
+            std::memcpy(m_shmBuffer + offset, kSubSample, sizeof(kSubSample));
+            offset += sizeof(kSubSample);
+        }
+        offset = m_byteWriter.writeBytes(m_shmBuffer, offset, data->getKeyId().data(), data->getKeyId().size());
+        offset = m_byteWriter.writeBytes(m_shmBuffer, offset, data->getInitVector().data(),
+                                         data->getInitVector().size());
+    }
+    offset = m_byteWriter.writeBytes(m_shmBuffer, offset, data->getExtraData().data(), data->getExtraData().size());
+    if (data->getCodecData())
+    {
+        m_byteWriter.writeBytes(m_shmBuffer, offset, data->getCodecData()->data.data(),
+                                data->getCodecData()->data.size());
+    }
+}
+} // namespace firebolt::rialto::common
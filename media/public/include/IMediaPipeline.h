@@ -31,6 +31,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -1203,6 +1204,46 @@ public:
      */
     virtual bool getPosition(int64_t &position) = 0;
 
+    /**
+     * @brief Non-blocking version of setPosition().
+     *
+     * Returns once the request has been sent, the callback is called with the result
+     * once the request has completed, which may be from another thread or before this
+     * method returns. The default implementation calls setPosition().
+     *
+     * @param[in] position : The playback position in nanoseconds.
+     * @param[in] callback : Called with the result of the request.
+     *
+     * @retval true if the request was made, the callback is not called otherwise.
+     */
+    virtual bool setPositionAsync(int64_t position, std::function<void(bool success)> callback)
+    {
+        const bool kResult = setPosition(position);
+        if (callback)
+            callback(kResult);
+        return true;
+    }
+
+    /**
+     * @brief Non-blocking version of getPosition().
+     *
+     * Returns once the request has been sent, the callback is called with the result
+     * and playback position once the request has completed, which may be from another
+     * thread or before this method returns. The default implementation calls getPosition().
+     *
+     * @param[in] callback : Called with the result of the request and the position in nanoseconds.
+     *
+     * @retval true if the request was made, the callback is not called otherwise.
+     */
+    virtual bool getPositionAsync(std::function<void(bool success, int64_t position)> callback)
+    {
+        int64_t position{0};
+        const bool kResult = getPosition(position);
+        if (callback)
+            callback(kResult, position);
+        return true;
+    }
+
     /**
      * @brief Get stats for this source.
      *
@@ -1296,6 +1337,59 @@ public:
      */
     virtual bool haveData(MediaSourceStatus status, uint32_t needDataRequestId) = 0;
 
+    /**
+     * @brief Non-blocking version of haveData().
+     *
+     * Returns once the request has been sent so that a single thread can keep feeding
+     * several sources without waiting for a server round trip on each. The callback is
+     * called with the result once the request has completed, which may be from another
+     * thread or before this method returns. The default implementation calls haveData().
+     *
+     * @param[in] status : The status
+     * @param[in] needDataRequestId : Need data request id
+     * @param[in] callback : Called with the result of the request.
+     *
+     * @retval true if the request was made, the callback is not called otherwise.
+     */
+    virtual bool haveDataAsync(MediaSourceStatus status, uint32_t needDataRequestId,
+                               std::function<void(bool success)> callback)
+    {
+        const bool kResult = haveData(status, needDataRequestId);
+        if (callback)
+            callback(kResult);
+        return true;
+    }
+
+    /**
+     * @brief Switches the source to the streaming mode.
+     *
+     * In the streaming mode the source is not fed through notifyNeedMediaData() and haveData() anymore.
+     * Every segment passed to addSegment() is written to a ring in the shared memory and Rialto reads it
+     * continuously, so the needDataRequestId passed to addSegment() is ignored. If the ring is full,
+     * addSegment() returns NO_SPACE and the client should retry later. The mode lasts until the source is removed.
+     *
+     * The mode can only be enabled after allSourcesAttached() and while no data of the source is being
+     * processed, the pending need data requests of the source are dropped.
+     * The default implementation does not support the streaming mode.
+     *
+     * @param[in] sourceId : The source id. Value should be set to the MediaSource.id returned after attachSource()
+     *
+     * @retval true on success.
+     */
+    virtual bool enableStreamingMode(int32_t sourceId) { return false; }
+
+    /**
+     * @brief Notifies Rialto of the end of stream of a source in the streaming mode.
+     *
+     * Replaces haveData() with MediaSourceStatus::EOS for the source. It is queued behind the segments
+     * added before it. The default implementation does not support the streaming mode.
+     *
+     * @param[in] sourceId : The source id. Value should be set to the MediaSource.id returned after attachSource()
+     *
+     * @retval true on success, false if the source is not in the streaming mode or the ring is full.
+     */
+    virtual bool setStreamingEos(int32_t sourceId) { return false; }
+
     /**
      * @brief Adds a single segment to Rialto in response to notifyNeedData()
      *
@@ -1309,6 +1403,9 @@ public:
      * is received for the source and immediately call haveData() to trigger Rialto
      * to start processing the segments already added.
      *
+     * For a source in the streaming mode (see enableStreamingMode()) the segment is written to the
+     * ring of the source and the needDataRequestId is ignored.
+     *
      * @param[in] needDataRequestId : The status
      * @param[in] mediaSegment : The data returned.
      *
@@ -273,6 +273,16 @@ struct MediaPlayerShmInfo
     uint32_t maxMediaBytes;    /**< The maximum amount of mediadata that can be written. */
 };
 
+/**
+ * @brief The data written to the shared memory in response to one NeedMediaData request.
+ */
+struct HaveDataInfo
+{
+    MediaSourceStatus status; /**< The status of the media source. */
+    uint32_t numFrames;       /**< The number of frames written. */
+    uint32_t requestId;       /**< The id of the NeedMediaData request. */
+};
+
 /**
  * @brief The information provided in a QOS update.
  */
@@ -26,6 +26,9 @@
 #include "IRdkGstreamerUtilsWrapper.h"
 #include "ITimer.h"
 #include "MediaCommon.h"
+#include "MediaSegmentBatch.h"
+#include <array>
+#include <atomic>
 #include <gst/gst.h>
 #include <list>
 #include <map>
@@ -319,6 +322,18 @@ struct GenericPlayerContext
      * @brief Current position of the stream in nanoseconds.
      */
     std::atomic<int64_t> streamPosition{-1};
+
+    /**
+     * @brief Timestamp of the last buffer pushed to the appsrc, indexed by MediaSourceType, -1 if unknown.
+     *        Written on the worker thread and read on the main thread in getQueuedDuration().
+     */
+    std::array<std::atomic<int64_t>, 4> lastPushedTimestamps{-1, -1, -1, -1};
+
+    /**
+     * @brief The segments read from the shared memory for the current NeedMediaData request.
+     *        Reused between requests, so it must only be used by the worker thread.
+     */
+    MediaSegmentBatch segmentBatch;
 };
 } // namespace firebolt::rialto::server
 
@@ -116,7 +116,10 @@ public:
     void pause() override;
     void stop() override;
     void attachSamples(const IMediaPipeline::MediaSegmentVector &mediaSegments) override;
-    void attachSamples(const std::shared_ptr<IDataReader> &dataReader) override;
+    void attachSamples(const std::shared_ptr<IDataReader> &dataReader,
+                       const std::shared_ptr<IShmBlockTracker> &shmBlockTracker) override;
+    void attachSamples(const std::vector<ShmSamples> &shmSamples) override;
+    void drainShmRing(const std::shared_ptr<IShmRingReader> &shmRingReader) override;
     void setPosition(std::int64_t position) override;
     void setVideoGeometry(int x, int y, int width, int height) override;
     void setEos(const firebolt::rialto::MediaSourceType &type) override;
@@ -127,6 +130,7 @@ public:
     bool setReportDecodeErrors(const MediaSourceType &mediaSourceType, bool reportDecodeErrors) override;
     bool getImmediateOutput(const MediaSourceType &mediaSourceType, bool &immediateOutput) override;
     bool getQueuedFrames(uint32_t &queuedFrames) override;
+    bool getQueuedDuration(const MediaSourceType &mediaSourceType, std::int64_t &queuedDuration) override;
     bool getStats(const MediaSourceType &mediaSourceType, uint64_t &renderedFrames, uint64_t &droppedFrames) override;
     void setVolume(double targetVolume, uint32_t volumeDuration, firebolt::rialto::EaseType easeType) override;
     bool getVolume(double &volume) override;
@@ -176,7 +180,8 @@ private:
     bool setUseBuffering() override;
     void notifyNeedMediaData(const MediaSourceType mediaSource) override;
     void notifyNeedMediaDataWithDelay(const MediaSourceType mediaSource) override;
-    GstBuffer *createBuffer(const IMediaPipeline::MediaSegment &mediaSegment) const override;
+    GstBuffer *createBuffer(const MediaSegmentView &mediaSegment,
+                            const std::shared_ptr<IShmBlockTracker> &shmBlockTracker) const override;
     void attachData(const firebolt::rialto::MediaSourceType mediaType) override;
     void updateAudioCaps(int32_t rate, int32_t channels, const std::shared_ptr<CodecData> &codecData) override;
     void updateVideoCaps(int32_t width, int32_t height, Fraction frameRate,
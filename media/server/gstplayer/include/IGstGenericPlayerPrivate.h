@@ -22,6 +22,8 @@
 
 #include "GstPlayerTypes.h"
 #include "IMediaPipeline.h"
+#include "IShmBlockTracker.h"
+#include "MediaSegmentBatch.h"
 
 #include <gst/app/gstappsrc.h>
 #include <gst/gst.h>
@@ -185,8 +187,13 @@ public:
     /**
      * @brief Constructs a new buffer with data from media segment. Does not perform decryption.
      *        Called by the worker thread.
+     *
+     * @param[in] mediaSegment    : The view of the media segment.
+     * @param[in] shmBlockTracker : If set, clear data stored in shared memory is wrapped instead of copied,
+     *                              as long as the tracker lends the block.
      */
-    virtual GstBuffer *createBuffer(const IMediaPipeline::MediaSegment &mediaSegment) const = 0;
+    virtual GstBuffer *createBuffer(const MediaSegmentView &mediaSegment,
+                                    const std::shared_ptr<IShmBlockTracker> &shmBlockTracker) const = 0;
 
     virtual void attachData(const firebolt::rialto::MediaSourceType mediaType) = 0;
 
@@ -21,11 +21,37 @@
 #define FIREBOLT_RIALTO_SERVER_I_WORKER_THREAD_H_
 
 #include "IPlayerTask.h"
+#include <cstdint>
 #include <memory>
 
 namespace firebolt::rialto::server
 {
 class IWorkerThread;
+
+/**
+ * @brief Keys of the idempotent tasks, of which only one needs to be pending at a time.
+ */
+enum class CoalescingKey
+{
+    REPORT_POSITION,
+    CHECK_AUDIO_UNDERFLOW,
+    NOTIFY_PLAYBACK_INFO,
+    NUM_OF_KEYS
+};
+
+/**
+ * @brief Counters of the task queue of a worker thread.
+ */
+struct WorkerThreadStats
+{
+    uint64_t queueDepth = 0;     // tasks waiting in the queue
+    uint64_t maxQueueDepth = 0;  // the largest value queueDepth has reached
+    uint64_t executedTasks = 0;  // total number of tasks taken from the queue
+    uint64_t coalescedTasks = 0; // tasks dropped because an identical one was still pending
+    uint64_t totalLatencyUs = 0; // sum of the time the executed tasks waited in the queue
+    uint64_t maxLatencyUs = 0;   // the longest time a task waited in the queue
+};
+
 class IWorkerThreadFactory
 {
 public:
@@ -59,6 +85,23 @@ public:
      * @brief Queues a task in the task queue.
      */
     virtual void enqueueTask(std::unique_ptr<IPlayerTask> &&task) = 0;
+
+    /**
+     * @brief Queues an idempotent task in the task queue, unless a task with the same key is already pending.
+     *
+     * A task that is executing is no longer pending, so the task queued while it runs sees the latest state.
+     *
+     * @param[in] key  : The key of the task.
+     * @param[in] task : The task to queue.
+     */
+    virtual void enqueueCoalescedTask(CoalescingKey key, std::unique_ptr<IPlayerTask> &&task) = 0;
+
+    /**
+     * @brief Gets the counters of the task queue.
+     *
+     * @retval the task queue counters.
+     */
+    virtual WorkerThreadStats getStats() const = 0;
 };
 } // namespace firebolt::rialto::server
 
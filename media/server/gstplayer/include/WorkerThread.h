@@ -22,10 +22,13 @@
 
 #include "IWorkerThread.h"
 #include "tasks/IPlayerTask.h"
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
 #include <thread>
 
 namespace firebolt::rialto::server
@@ -45,8 +48,33 @@ public:
     void stop() override;
     void join() override;
     void enqueueTask(std::unique_ptr<IPlayerTask> &&task) override;
+    void enqueueCoalescedTask(CoalescingKey key, std::unique_ptr<IPlayerTask> &&task) override;
+    WorkerThreadStats getStats() const override;
 
 private:
+    /**
+     * @brief A task in the task queue.
+     */
+    struct Node
+    {
+        std::atomic<Node *> next{nullptr};
+        std::unique_ptr<IPlayerTask> task;
+        std::optional<CoalescingKey> key;
+        std::chrono::steady_clock::time_point enqueueTime;
+    };
+
+    /**
+     * @brief Adds a task to the back of the task queue and wakes the worker thread, if it's waiting.
+     */
+    void push(std::unique_ptr<IPlayerTask> &&task, std::optional<CoalescingKey> key);
+
+    /**
+     * @brief Takes the task at the front of the task queue.
+     *
+     * @retval the task or null if the queue is empty.
+     */
+    std::unique_ptr<IPlayerTask> pop();
+
     /**
      * @brief For handling new tasks in the worker thread.
      */
@@ -71,7 +99,25 @@ private:
     std::thread m_taskThread{};
 
     /**
-     * @brief Mutex to protect the task handling.
+     * @brief The last task of the queue, where the producers add tasks.
+     *
+     * The queue is a lock-free multiple producer single consumer linked list. It always holds a node whose task
+     * has already been taken, so the producers never see it empty.
+     */
+    std::atomic<Node *> m_head;
+
+    /**
+     * @brief The node before the first task of the queue, only used by the worker thread.
+     */
+    Node *m_tail;
+
+    /**
+     * @brief Flag set while the worker thread waits for a task.
+     */
+    std::atomic<bool> m_isWaiting{false};
+
+    /**
+     * @brief Mutex for the worker thread to wait for tasks.
      */
     std::mutex m_taskMutex{};
 
@@ -81,9 +127,16 @@ private:
     std::condition_variable m_taskCV{};
 
     /**
-     * @brief Queue to store new tasks.
+     * @brief Flags set while a task of each coalescing key is pending.
      */
-    std::queue<std::unique_ptr<IPlayerTask>> m_taskQueue{};
+    std::array<std::atomic<bool>, static_cast<size_t>(CoalescingKey::NUM_OF_KEYS)> m_isKeyPending{};
+
+    std::atomic<uint64_t> m_queueDepth{0};
+    std::atomic<uint64_t> m_maxQueueDepth{0};
+    std::atomic<uint64_t> m_executedTasks{0};
+    std::atomic<uint64_t> m_coalescedTasks{0};
+    std::atomic<uint64_t> m_totalLatencyUs{0};
+    std::atomic<uint64_t> m_maxLatencyUs{0};
 };
 } // namespace firebolt::rialto::server
 
@@ -24,10 +24,13 @@
 #include "GstPlayerTypes.h"
 #include "IDataReader.h"
 #include "IFlushWatcher.h"
+#include "IGstGenericPlayer.h"
 #include "IGstGenericPlayerPrivate.h"
 #include "IHeartbeatHandler.h"
 #include "IMediaPipeline.h"
 #include "IPlayerTask.h"
+#include "IShmBlockTracker.h"
+#include "IShmRingReader.h"
 #include "MediaCommon.h"
 #include <cstdint>
 #include <gst/app/gstappsrc.h>
@@ -167,15 +170,43 @@ public:
     /**
      * @brief Creates a ReadShmDataAndAttachSamples task.
      *
-     * @param[in] context       : The GstGenericPlayer context
-     * @param[in] player        : The GstGenericPlayer instance
-     * @param[in] dataReader    : The shared memory data reader
+     * @param[in] context         : The GstGenericPlayer context
+     * @param[in] player          : The GstGenericPlayer instance
+     * @param[in] dataReader      : The shared memory data reader
+     * @param[in] shmBlockTracker : The tracker of shm blocks passed to gstreamer without copying (optional)
+     *
+     * @retval the new ReadShmDataAndAttachSamples task instance.
+     */
+    virtual std::unique_ptr<IPlayerTask>
+    createReadShmDataAndAttachSamples(GenericPlayerContext &context, IGstGenericPlayerPrivate &player,
+                                      const std::shared_ptr<IDataReader> &dataReader,
+                                      const std::shared_ptr<IShmBlockTracker> &shmBlockTracker) const = 0;
+
+    /**
+     * @brief Creates a ReadShmDataAndAttachSamples task for the samples of several requests.
+     *
+     * @param[in] context    : The GstGenericPlayer context
+     * @param[in] player     : The GstGenericPlayer instance
+     * @param[in] shmSamples : The samples of each request
      *
      * @retval the new ReadShmDataAndAttachSamples task instance.
      */
     virtual std::unique_ptr<IPlayerTask>
     createReadShmDataAndAttachSamples(GenericPlayerContext &context, IGstGenericPlayerPrivate &player,
-                                      const std::shared_ptr<IDataReader> &dataReader) const = 0;
+                                      const std::vector<IGstGenericPlayer::ShmSamples> &shmSamples) const = 0;
+
+    /**
+     * @brief Creates a ReadShmRingAndAttachSamples task.
+     *
+     * @param[in] context       : The GstGenericPlayer context
+     * @param[in] player        : The GstGenericPlayer instance
+     * @param[in] shmRingReader : The reader of the ring of a source in streaming mode
+     *
+     * @retval the new ReadShmRingAndAttachSamples task instance.
+     */
+    virtual std::unique_ptr<IPlayerTask>
+    createReadShmRingAndAttachSamples(GenericPlayerContext &context, IGstGenericPlayerPrivate &player,
+                                      const std::shared_ptr<IShmRingReader> &shmRingReader) const = 0;
 
     /**
      * @brief Creates a Remove Source task.
@@ -201,6 +232,15 @@ public:
     virtual std::unique_ptr<IPlayerTask> createReportPosition(GenericPlayerContext &context,
                                                               IGstGenericPlayerPrivate &player) const = 0;
 
+    /**
+     * @brief Creates a NotifyPlaybackInfo task.
+     *
+     * @param[in] player        : The GstGenericPlayer instance
+     *
+     * @retval the new NotifyPlaybackInfo task instance.
+     */
+    virtual std::unique_ptr<IPlayerTask> createNotifyPlaybackInfo(IGstGenericPlayerPrivate &player) const = 0;
+
     /**
      * @brief Creates a CheckAudioUnderflow task.
      *
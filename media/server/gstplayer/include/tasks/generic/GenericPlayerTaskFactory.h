@@ -64,11 +64,19 @@ public:
     std::unique_ptr<IPlayerTask> createPlay(IGstGenericPlayerPrivate &player) const override;
     std::unique_ptr<IPlayerTask>
     createReadShmDataAndAttachSamples(GenericPlayerContext &context, IGstGenericPlayerPrivate &player,
-                                      const std::shared_ptr<IDataReader> &dataReader) const override;
+                                      const std::shared_ptr<IDataReader> &dataReader,
+                                      const std::shared_ptr<IShmBlockTracker> &shmBlockTracker) const override;
+    std::unique_ptr<IPlayerTask>
+    createReadShmDataAndAttachSamples(GenericPlayerContext &context, IGstGenericPlayerPrivate &player,
+                                      const std::vector<IGstGenericPlayer::ShmSamples> &shmSamples) const override;
+    std::unique_ptr<IPlayerTask>
+    createReadShmRingAndAttachSamples(GenericPlayerContext &context, IGstGenericPlayerPrivate &player,
+                                      const std::shared_ptr<IShmRingReader> &shmRingReader) const override;
     std::unique_ptr<IPlayerTask> createRemoveSource(GenericPlayerContext &context, IGstGenericPlayerPrivate &player,
                                                     const firebolt::rialto::MediaSourceType &type) const override;
     std::unique_ptr<IPlayerTask> createReportPosition(GenericPlayerContext &context,
                                                       IGstGenericPlayerPrivate &player) const override;
+    std::unique_ptr<IPlayerTask> createNotifyPlaybackInfo(IGstGenericPlayerPrivate &player) const override;
     std::unique_ptr<IPlayerTask> createCheckAudioUnderflow(GenericPlayerContext &context,
                                                            IGstGenericPlayerPrivate &player) const override;
     std::unique_ptr<IPlayerTask> createSetPlaybackRate(GenericPlayerContext &context, double rate) const override;
@@ -22,10 +22,13 @@
 
 #include "GenericPlayerContext.h"
 #include "IDataReader.h"
+#include "IGstGenericPlayer.h"
 #include "IGstGenericPlayerPrivate.h"
 #include "IGstWrapper.h"
 #include "IPlayerTask.h"
+#include "IShmBlockTracker.h"
 #include <memory>
+#include <vector>
 
 namespace firebolt::rialto::server::tasks::generic
 {
@@ -34,16 +37,22 @@ class ReadShmDataAndAttachSamples : public IPlayerTask
 public:
     ReadShmDataAndAttachSamples(GenericPlayerContext &context,
                                 const std::shared_ptr<firebolt::rialto::wrappers::IGstWrapper> &gstWrapper,
-                                IGstGenericPlayerPrivate &player, const std::shared_ptr<IDataReader> &dataReader);
+                                IGstGenericPlayerPrivate &player, const std::shared_ptr<IDataReader> &dataReader,
+                                const std::shared_ptr<IShmBlockTracker> &shmBlockTracker);
+    ReadShmDataAndAttachSamples(GenericPlayerContext &context,
+                                const std::shared_ptr<firebolt::rialto::wrappers::IGstWrapper> &gstWrapper,
+                                IGstGenericPlayerPrivate &player,
+                                const std::vector<IGstGenericPlayer::ShmSamples> &shmSamples);
     ~ReadShmDataAndAttachSamples() override;
     void execute() const override;
 
 private:
+    void readAndAttachSamples(IGstGenericPlayer::ShmSamples &shmSamples) const;
     void attachData(const firebolt::rialto::MediaSourceType mediaType, GstBuffer *buffer) const;
     GenericPlayerContext &m_context;
     std::shared_ptr<firebolt::rialto::wrappers::IGstWrapper> m_gstWrapper;
     IGstGenericPlayerPrivate &m_player;
-    std::shared_ptr<IDataReader> m_dataReader;
+    mutable std::vector<IGstGenericPlayer::ShmSamples> m_shmSamples;
 };
 } // namespace firebolt::rialto::server::tasks::generic
 
@@ -24,6 +24,7 @@
 #include <memory>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 #include "IDataReader.h"
 #include "IDecryptionService.h"
@@ -31,6 +32,8 @@
 #include "IHeartbeatHandler.h"
 #include "IMediaPipeline.h"
 #include "IRdkGstreamerUtilsWrapper.h"
+#include "IShmBlockTracker.h"
+#include "IShmRingReader.h"
 
 namespace firebolt::rialto::server
 {
@@ -81,6 +84,15 @@ public:
     IGstGenericPlayer(IGstGenericPlayer &&) = delete;
     IGstGenericPlayer &operator=(IGstGenericPlayer &&) = delete;
 
+    /**
+     * @brief Samples written to the shared memory in response to one NeedMediaData request.
+     */
+    struct ShmSamples
+    {
+        std::shared_ptr<IDataReader> dataReader;           /**< The shared memory data reader */
+        std::shared_ptr<IShmBlockTracker> shmBlockTracker; /**< The tracker of lent shm blocks, or nullptr */
+    };
+
     /**
      * @brief Attaches a source to gstreamer.
      *
@@ -172,8 +184,33 @@ public:
      *
      * This method is considered to be asynchronous and MUST NOT block
      * but should request to attach new sample and then return.
+     *
+     * @param[in] dataReader      : The shared memory data reader.
+     * @param[in] shmBlockTracker : The tracker of shm blocks passed to gstreamer without copying, or nullptr
+     *                              if the data must be copied out of shared memory.
+     */
+    virtual void attachSamples(const std::shared_ptr<IDataReader> &dataReader,
+                               const std::shared_ptr<IShmBlockTracker> &shmBlockTracker) = 0;
+
+    /**
+     * @brief Attaches new samples of several requests at once
+     *
+     * This method is considered to be asynchronous and MUST NOT block
+     * but should request to attach new sample and then return.
+     *
+     * @param[in] shmSamples : The samples of each request, read in order by a single task.
      */
-    virtual void attachSamples(const std::shared_ptr<IDataReader> &dataReader) = 0;
+    virtual void attachSamples(const std::vector<ShmSamples> &shmSamples) = 0;
+
+    /**
+     * @brief Attaches the samples written by the client to the ring of a source in streaming mode
+     *
+     * This method is considered to be asynchronous and MUST NOT block
+     * but should request to drain the ring and then return. The ring is read for as long as gstreamer needs data.
+     *
+     * @param[in] shmRingReader : The reader of the ring.
+     */
+    virtual void drainShmRing(const std::shared_ptr<IShmRingReader> &shmRingReader) = 0;
 
     /**
      * @brief Set the playback position in nanoseconds.
@@ -233,6 +270,16 @@ public:
      */
     virtual bool getQueuedFrames(uint32_t &queuedFrames) = 0;
 
+    /**
+     * @brief Gets the duration of the data pushed to the pipeline for this source, that has not been played yet.
+     *
+     * @param[in]  mediaSourceType : The media source type
+     * @param[out] queuedDuration  : The queued duration in nanoseconds
+     *
+     * @retval true on success, false if nothing has been pushed since the last flush or the position is unknown.
+     */
+    virtual bool getQueuedDuration(const MediaSourceType &mediaSourceType, std::int64_t &queuedDuration) = 0;
+
     /**
      * @brief Gets the "Immediate Output" property for this source.
      *
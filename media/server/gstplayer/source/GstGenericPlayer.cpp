@@ -54,6 +54,21 @@ bool operator==(const firebolt::rialto::server::SegmentData &lhs, const firebolt
     return (lhs.position == rhs.position) && (lhs.resetTime == rhs.resetTime) && (lhs.appliedRate == rhs.appliedRate) &&
            (lhs.stopPosition == rhs.stopPosition);
 }
+/**
+ * @brief Keeps the shm block lent to gstreamer until the wrapping memory is freed.
+ */
+struct ShmBlockLease
+{
+    std::shared_ptr<firebolt::rialto::server::IShmBlockTracker> tracker;
+    const std::uint8_t *data;
+};
+
+void releaseShmBlock(gpointer userData)
+{
+    ShmBlockLease *lease = static_cast<ShmBlockLease *>(userData);
+    lease->tracker->release(lease->data);
+    delete lease;
+}
 } // namespace
 
 namespace firebolt::rialto::server
@@ -438,11 +453,29 @@ void GstGenericPlayer::attachSamples(const IMediaPipeline::MediaSegmentVector &m
     }
 }
 
-void GstGenericPlayer::attachSamples(const std::shared_ptr<IDataReader> &dataReader)
+void GstGenericPlayer::attachSamples(const std::shared_ptr<IDataReader> &dataReader,
+                                     const std::shared_ptr<IShmBlockTracker> &shmBlockTracker)
 {
     if (m_workerThread)
     {
-        m_workerThread->enqueueTask(m_taskFactory->createReadShmDataAndAttachSamples(m_context, *this, dataReader));
+        m_workerThread->enqueueTask(
+            m_taskFactory->createReadShmDataAndAttachSamples(m_context, *this, dataReader, shmBlockTracker));
+    }
+}
+
+void GstGenericPlayer::attachSamples(const std::vector<ShmSamples> &shmSamples)
+{
+    if (m_workerThread && !shmSamples.empty())
+    {
+        m_workerThread->enqueueTask(m_taskFactory->createReadShmDataAndAttachSamples(m_context, *this, shmSamples));
+    }
+}
+
+void GstGenericPlayer::drainShmRing(const std::shared_ptr<IShmRingReader> &shmRingReader)
+{
+    if (m_workerThread && shmRingReader)
+    {
+        m_workerThread->enqueueTask(m_taskFactory->createReadShmRingAndAttachSamples(m_context, *this, shmRingReader));
     }
 }
 
@@ -450,6 +483,10 @@ void GstGenericPlayer::setPosition(std::int64_t position)
 {
     if (m_workerThread)
     {
+        for (auto &lastPushedTimestamp : m_context.lastPushedTimestamps)
+        {
+            lastPushedTimestamp = -1;
+        }
         m_workerThread->enqueueTask(m_taskFactory->createSetPosition(m_context, *this, position));
     }
 }
@@ -1218,6 +1255,19 @@ bool GstGenericPlayer::getQueuedFrames(uint32_t &queuedFrames)
     return returnValue;
 }
 
+bool GstGenericPlayer::getQueuedDuration(const MediaSourceType &mediaSourceType, std::int64_t &queuedDuration)
+{
+    // The position reported with the last playback info is used, as querying the pipeline for each request is costly
+    const int64_t kLastPushedTimestamp{m_context.lastPushedTimestamps[static_cast<size_t>(mediaSourceType)]};
+    const int64_t kPosition{m_context.streamPosition};
+    if (kLastPushedTimestamp < 0 || kPosition < 0)
+    {
+        return false;
+    }
+    queuedDuration = std::max<int64_t>(kLastPushedTimestamp - kPosition, 0);
+    return true;
+}
+
 bool GstGenericPlayer::getImmediateOutput(const MediaSourceType &mediaSourceType, bool &immediateOutputRef)
 {
     bool returnValue{false};
@@ -1283,49 +1333,59 @@ bool GstGenericPlayer::getStats(const MediaSourceType &mediaSourceType, uint64_t
     return returnValue;
 }
 
-GstBuffer *GstGenericPlayer::createBuffer(const IMediaPipeline::MediaSegment &mediaSegment) const
+GstBuffer *GstGenericPlayer::createBuffer(const MediaSegmentView &mediaSegment,
+                                          const std::shared_ptr<IShmBlockTracker> &shmBlockTracker) const
 {
-    GstBuffer *gstBuffer = m_gstWrapper->gstBufferNewAllocate(nullptr, mediaSegment.getDataLength(), nullptr);
-    m_gstWrapper->gstBufferFill(gstBuffer, 0, mediaSegment.getData(), mediaSegment.getDataLength());
+    GstBuffer *gstBuffer{nullptr};
+    // Encrypted data is decrypted in place, so it is always copied to keep the clear data out of shared memory
+    if (shmBlockTracker && !mediaSegment.isEncrypted &&
+        shmBlockTracker->lend(mediaSegment.data.data, mediaSegment.data.size))
+    {
+        std::uint8_t *data = const_cast<std::uint8_t *>(mediaSegment.data.data);
+        gstBuffer = m_gstWrapper->gstBufferNewWrappedFull(GST_MEMORY_FLAG_READONLY, data, mediaSegment.data.size, 0,
+                                                          mediaSegment.data.size,
+                                                          new ShmBlockLease{shmBlockTracker, data}, releaseShmBlock);
+    }
+    else
+    {
+        gstBuffer = m_gstWrapper->gstBufferNewAllocate(nullptr, mediaSegment.data.size, nullptr);
+        m_gstWrapper->gstBufferFill(gstBuffer, 0, mediaSegment.data.data, mediaSegment.data.size);
+    }
 
-    if (mediaSegment.isEncrypted())
+    if (mediaSegment.isEncrypted)
     {
-        GstBuffer *keyId = m_gstWrapper->gstBufferNewAllocate(nullptr, mediaSegment.getKeyId().size(), nullptr);
-        m_gstWrapper->gstBufferFill(keyId, 0, mediaSegment.getKeyId().data(), mediaSegment.getKeyId().size());
+        GstBuffer *keyId = m_gstWrapper->gstBufferNewAllocate(nullptr, mediaSegment.keyId.size, nullptr);
+        m_gstWrapper->gstBufferFill(keyId, 0, mediaSegment.keyId.data, mediaSegment.keyId.size);
 
-        GstBuffer *initVector = m_gstWrapper->gstBufferNewAllocate(nullptr, mediaSegment.getInitVector().size(), nullptr);
-        m_gstWrapper->gstBufferFill(initVector, 0, mediaSegment.getInitVector().data(),
-                                    mediaSegment.getInitVector().size());
+        GstBuffer *initVector = m_gstWrapper->gstBufferNewAllocate(nullptr, mediaSegment.initVector.size, nullptr);
+        m_gstWrapper->gstBufferFill(initVector, 0, mediaSegment.initVector.data, mediaSegment.initVector.size);
         GstBuffer *subsamples{nullptr};
-        if (!mediaSegment.getSubSamples().empty())
+        if (!mediaSegment.subSamples.empty())
         {
-            auto subsamplesRawSize = mediaSegment.getSubSamples().size() * (sizeof(guint16) + sizeof(guint32));
+            auto subsamplesRawSize = mediaSegment.subSamples.size() * (sizeof(guint16) + sizeof(guint32));
             guint8 *subsamplesRaw = static_cast<guint8 *>(m_glibWrapper->gMalloc(subsamplesRawSize));
             GstByteWriter writer;
             m_gstWrapper->gstByteWriterInitWithData(&writer, subsamplesRaw, subsamplesRawSize, FALSE);
 
-            for (const auto &subSample : mediaSegment.getSubSamples())
+            for (std::size_t i = 0; i < mediaSegment.subSamples.size(); ++i)
             {
-                m_gstWrapper->gstByteWriterPutUint16Be(&writer, subSample.numClearBytes);
-                m_gstWrapper->gstByteWriterPutUint32Be(&writer, subSample.numEncryptedBytes);
+                const SubSamplePair kSubSample{mediaSegment.subSamples[i]};
+                m_gstWrapper->gstByteWriterPutUint16Be(&writer, kSubSample.numClearBytes);
+                m_gstWrapper->gstByteWriterPutUint32Be(&writer, kSubSample.numEncryptedBytes);
             }
             subsamples = m_gstWrapper->gstBufferNewWrapped(subsamplesRaw, subsamplesRawSize);
         }
 
-        uint32_t crypt = 0;
-        uint32_t skip = 0;
-        bool encryptionPatternSet = mediaSegment.getEncryptionPattern(crypt, skip);
-
-        GstRialtoProtectionData data = {mediaSegment.getMediaKeySessionId(),
-                                        static_cast<uint32_t>(mediaSegment.getSubSamples().size()),
-                                        mediaSegment.getInitWithLast15(),
+        GstRialtoProtectionData data = {mediaSegment.mediaKeySessionId,
+                                        static_cast<uint32_t>(mediaSegment.subSamples.size()),
+                                        mediaSegment.initWithLast15,
                                         keyId,
                                         initVector,
                                         subsamples,
-                                        mediaSegment.getCipherMode(),
-                                        crypt,
-                                        skip,
-                                        encryptionPatternSet,
+                                        mediaSegment.cipherMode,
+                                        mediaSegment.crypt,
+                                        mediaSegment.skip,
+                                        mediaSegment.encryptionPatternSet,
                                         m_context.decryptionService};
 
         if (!m_protectionMetadataWrapper->addProtectionMetadata(gstBuffer, data))
@@ -1346,8 +1406,8 @@ GstBuffer *GstGenericPlayer::createBuffer(const IMediaPipeline::MediaSegment &me
         }
     }
 
-    GST_BUFFER_TIMESTAMP(gstBuffer) = mediaSegment.getTimeStamp();
-    GST_BUFFER_DURATION(gstBuffer) = mediaSegment.getDuration();
+    GST_BUFFER_TIMESTAMP(gstBuffer) = mediaSegment.timeStamp;
+    GST_BUFFER_DURATION(gstBuffer) = mediaSegment.duration;
     return gstBuffer;
 }
 
@@ -1417,6 +1477,12 @@ void GstGenericPlayer::attachData(const firebolt::rialto::MediaSourceType mediaT
             m_context.lastAudioSampleTimestamps = static_cast<int64_t>(GST_BUFFER_PTS(streamInfo.buffers.back()));
         }
 
+        if (GST_BUFFER_PTS_IS_VALID(streamInfo.buffers.back()))
+        {
+            m_context.lastPushedTimestamps[static_cast<size_t>(mediaType)] =
+                static_cast<int64_t>(GST_BUFFER_PTS(streamInfo.buffers.back()));
+        }
+
         for (GstBuffer *buffer : streamInfo.buffers)
         {
             m_gstWrapper->gstAppSrcPushBuffer(GST_APP_SRC(streamInfo.appSrc), buffer);
@@ -2441,8 +2507,10 @@ void GstGenericPlayer::startPositionReportingAndCheckAudioUnderflowTimer()
         {
             if (m_workerThread)
             {
-                m_workerThread->enqueueTask(m_taskFactory->createReportPosition(m_context, *this));
-                m_workerThread->enqueueTask(m_taskFactory->createCheckAudioUnderflow(m_context, *this));
+                m_workerThread->enqueueCoalescedTask(CoalescingKey::REPORT_POSITION,
+                                                     m_taskFactory->createReportPosition(m_context, *this));
+                m_workerThread->enqueueCoalescedTask(CoalescingKey::CHECK_AUDIO_UNDERFLOW,
+                                                     m_taskFactory->createCheckAudioUnderflow(m_context, *this));
             }
         },
         firebolt::rialto::common::TimerType::PERIODIC);
@@ -2467,9 +2535,18 @@ void GstGenericPlayer::startNotifyPlaybackInfoTimer()
 
     notifyPlaybackInfo();
 
-    const auto kNotifyPlaybackInfo = [this]() { notifyPlaybackInfo(); };
-    m_playbackInfoTimer = m_timerFactory->createTimer(kPlaybackInfoTimerMs, kNotifyPlaybackInfo,
-                                                      firebolt::rialto::common::TimerType::PERIODIC);
+    // the query is done on the worker thread, a tick coalesces with one still queued behind slower tasks
+    m_playbackInfoTimer = m_timerFactory->createTimer(
+        kPlaybackInfoTimerMs,
+        [this]()
+        {
+            if (m_workerThread)
+            {
+                m_workerThread->enqueueCoalescedTask(CoalescingKey::NOTIFY_PLAYBACK_INFO,
+                                                     m_taskFactory->createNotifyPlaybackInfo(*this));
+            }
+        },
+        firebolt::rialto::common::TimerType::PERIODIC);
 }
 
 void GstGenericPlayer::stopNotifyPlaybackInfoTimer()
@@ -2790,6 +2867,7 @@ void GstGenericPlayer::flush(const MediaSourceType &mediaSourceType, bool resetT
     {
         async = isAsync(mediaSourceType);
         m_flushWatcher->setFlushing(mediaSourceType, async);
+        m_context.lastPushedTimestamps[static_cast<size_t>(mediaSourceType)] = -1;
         m_workerThread->enqueueTask(m_taskFactory->createFlush(m_context, *this, mediaSourceType, resetTime, async));
     }
 }
@@ -19,10 +19,19 @@
 
 #include "WorkerThread.h"
 #include "RialtoServerLogging.h"
+#include <cinttypes>
 
 namespace
 {
 
+void updateMax(std::atomic<uint64_t> &max, uint64_t value)
+{
+    uint64_t current = max;
+    while (value > current && !max.compare_exchange_weak(current, value))
+    {
+    }
+}
+
 class FunctionTask : public firebolt::rialto::server::IPlayerTask
 {
 public:
@@ -54,7 +63,7 @@ std::unique_ptr<IWorkerThread> WorkerThreadFactory::createWorkerThread() const
     return workerThread;
 }
 
-WorkerThread::WorkerThread()
+WorkerThread::WorkerThread() : m_head{new Node}, m_tail{m_head.load()}
 {
     RIALTO_SERVER_LOG_INFO("Worker thread is starting");
     m_taskThread = std::thread(&WorkerThread::taskHandler, this);
@@ -64,6 +73,11 @@ WorkerThread::~WorkerThread()
 {
     stop();
     join();
+
+    while (pop())
+    {
+    }
+    delete m_tail;
 }
 
 void WorkerThread::stop()
@@ -86,12 +100,38 @@ void WorkerThread::enqueueTask(std::unique_ptr<IPlayerTask> &&task)
 {
     if (task)
     {
-        std::unique_lock<std::mutex> lock(m_taskMutex);
-        m_taskQueue.push(std::move(task));
-        m_taskCV.notify_one();
+        push(std::move(task), std::nullopt);
     }
 }
 
+void WorkerThread::enqueueCoalescedTask(CoalescingKey key, std::unique_ptr<IPlayerTask> &&task)
+{
+    if (!task)
+    {
+        return;
+    }
+
+    // the pending task hasn't started yet, so it will see the same state this one would
+    if (m_isKeyPending[static_cast<size_t>(key)].exchange(true))
+    {
+        ++m_coalescedTasks;
+        return;
+    }
+    push(std::move(task), key);
+}
+
+WorkerThreadStats WorkerThread::getStats() const
+{
+    WorkerThreadStats stats;
+    stats.queueDepth = m_queueDepth;
+    stats.maxQueueDepth = m_maxQueueDepth;
+    stats.executedTasks = m_executedTasks;
+    stats.coalescedTasks = m_coalescedTasks;
+    stats.totalLatencyUs = m_totalLatencyUs;
+    stats.maxLatencyUs = m_maxLatencyUs;
+    return stats;
+}
+
 void WorkerThread::taskHandler()
 {
     while (m_isTaskThreadActive)
@@ -99,17 +139,74 @@ void WorkerThread::taskHandler()
         std::unique_ptr<IPlayerTask> task = waitForTask();
         task->execute();
     }
+
+    RIALTO_SERVER_LOG_INFO("Worker thread stopped, executed %" PRIu64 " tasks, coalesced %" PRIu64
+                           ", max queue depth %" PRIu64 ", max latency %" PRIu64 "us",
+                           m_executedTasks.load(), m_coalescedTasks.load(), m_maxQueueDepth.load(),
+                           m_maxLatencyUs.load());
 }
 
 std::unique_ptr<IPlayerTask> WorkerThread::waitForTask()
 {
-    std::unique_lock<std::mutex> lock(m_taskMutex);
-    if (m_taskQueue.empty())
+    std::unique_ptr<IPlayerTask> task = pop();
+    while (!task)
     {
-        m_taskCV.wait(lock, [this] { return !m_taskQueue.empty(); });
+        // a producer that doesn't see m_isWaiting set has linked its task before pop() looks for it
+        std::unique_lock<std::mutex> lock(m_taskMutex);
+        m_isWaiting = true;
+        task = pop();
+        if (!task)
+        {
+            m_taskCV.wait(lock);
+        }
+        m_isWaiting = false;
     }
-    std::unique_ptr<IPlayerTask> task = std::move(m_taskQueue.front());
-    m_taskQueue.pop();
     return task;
 }
+
+void WorkerThread::push(std::unique_ptr<IPlayerTask> &&task, std::optional<CoalescingKey> key)
+{
+    Node *node = new Node;
+    node->task = std::move(task);
+    node->key = key;
+    node->enqueueTime = std::chrono::steady_clock::now();
+    updateMax(m_maxQueueDepth, ++m_queueDepth);
+
+    // the task is only reachable by the worker thread once linked to the previous one
+    Node *previous = m_head.exchange(node, std::memory_order_acq_rel);
+    previous->next = node;
+
+    if (m_isWaiting)
+    {
+        std::unique_lock<std::mutex> lock(m_taskMutex);
+        m_taskCV.notify_one();
+    }
+}
+
+std::unique_ptr<IPlayerTask> WorkerThread::pop()
+{
+    Node *next = m_tail->next;
+    if (!next)
+    {
+        return nullptr;
+    }
+
+    // the node of the task taken becomes the one before the first task
+    delete m_tail;
+    m_tail = next;
+    --m_queueDepth;
+    if (next->key)
+    {
+        m_isKeyPending[static_cast<size_t>(*next->key)] = false;
+    }
+
+    const uint64_t kLatencyUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - next->enqueueTime)
+            .count();
+    m_totalLatencyUs += kLatencyUs;
+    updateMax(m_maxLatencyUs, kLatencyUs);
+    ++m_executedTasks;
+
+    return std::move(next->task);
+}
 } // namespace firebolt::rialto::server
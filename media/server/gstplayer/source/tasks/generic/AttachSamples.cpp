@@ -20,6 +20,7 @@
 #include "tasks/generic/AttachSamples.h"
 #include "GenericPlayerContext.h"
 #include "IGstGenericPlayerPrivate.h"
+#include "MediaSegmentBatch.h"
 #include "RialtoServerLogging.h"
 #include "TypeConverters.h"
 #include <utility>
@@ -34,7 +35,7 @@ AttachSamples::AttachSamples(GenericPlayerContext &context,
     RIALTO_SERVER_LOG_DEBUG("Constructing AttachSamples");
     for (const auto &mediaSegment : mediaSegments)
     {
-        GstBuffer *gstBuffer = m_player.createBuffer(*mediaSegment);
+        GstBuffer *gstBuffer = m_player.createBuffer(makeMediaSegmentView(*mediaSegment), nullptr);
         if (mediaSegment->getType() == firebolt::rialto::MediaSourceType::VIDEO)
         {
             try
@@ -29,11 +29,13 @@
 #include "tasks/generic/Flush.h"
 #include "tasks/generic/HandleBusMessage.h"
 #include "tasks/generic/NeedData.h"
+#include "tasks/generic/NotifyPlaybackInfo.h"
 #include "tasks/generic/Pause.h"
 #include "tasks/generic/Ping.h"
 #include "tasks/generic/Play.h"
 #include "tasks/generic/ProcessAudioGap.h"
 #include "tasks/generic/ReadShmDataAndAttachSamples.h"
+#include "tasks/generic/ReadShmRingAndAttachSamples.h"
 #include "tasks/generic/RemoveSource.h"
 #include "tasks/generic/RenderFrame.h"
 #include "tasks/generic/ReportPosition.h"
@@ -144,9 +146,25 @@ std::unique_ptr<IPlayerTask> GenericPlayerTaskFactory::createPlay(IGstGenericPla
 }
 
 std::unique_ptr<IPlayerTask> GenericPlayerTaskFactory::createReadShmDataAndAttachSamples(
-    GenericPlayerContext &context, IGstGenericPlayerPrivate &player, const std::shared_ptr<IDataReader> &dataReader) const
+    GenericPlayerContext &context, IGstGenericPlayerPrivate &player, const std::shared_ptr<IDataReader> &dataReader,
+    const std::shared_ptr<IShmBlockTracker> &shmBlockTracker) const
 {
-    return std::make_unique<tasks::generic::ReadShmDataAndAttachSamples>(context, m_gstWrapper, player, dataReader);
+    return std::make_unique<tasks::generic::ReadShmDataAndAttachSamples>(context, m_gstWrapper, player, dataReader,
+                                                                         shmBlockTracker);
+}
+
+std::unique_ptr<IPlayerTask> GenericPlayerTaskFactory::createReadShmDataAndAttachSamples(
+    GenericPlayerContext &context, IGstGenericPlayerPrivate &player,
+    const std::vector<IGstGenericPlayer::ShmSamples> &shmSamples) const
+{
+    return std::make_unique<tasks::generic::ReadShmDataAndAttachSamples>(context, m_gstWrapper, player, shmSamples);
+}
+
+std::unique_ptr<IPlayerTask> GenericPlayerTaskFactory::createReadShmRingAndAttachSamples(
+    GenericPlayerContext &context, IGstGenericPlayerPrivate &player,
+    const std::shared_ptr<IShmRingReader> &shmRingReader) const
+{
+    return std::make_unique<tasks::generic::ReadShmRingAndAttachSamples>(context, m_gstWrapper, player, shmRingReader);
 }
 
 std::unique_ptr<IPlayerTask>
@@ -162,6 +180,11 @@ std::unique_ptr<IPlayerTask> GenericPlayerTaskFactory::createReportPosition(Gene
     return std::make_unique<tasks::generic::ReportPosition>(context, m_client, m_gstWrapper, player);
 }
 
+std::unique_ptr<IPlayerTask> GenericPlayerTaskFactory::createNotifyPlaybackInfo(IGstGenericPlayerPrivate &player) const
+{
+    return std::make_unique<tasks::generic::NotifyPlaybackInfo>(player);
+}
+
 std::unique_ptr<IPlayerTask> GenericPlayerTaskFactory::createCheckAudioUnderflow(GenericPlayerContext &context,
                                                                                  IGstGenericPlayerPrivate &player) const
 {
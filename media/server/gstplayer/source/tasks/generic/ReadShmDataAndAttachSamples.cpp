@@ -22,6 +22,7 @@
 #include "IDataReader.h"
 #include "IGstGenericPlayerPrivate.h"
 #include "IMediaPipeline.h"
+#include "MediaSegmentBatch.h"
 #include "RialtoServerLogging.h"
 #include "TypeConverters.h"
 
@@ -34,12 +35,21 @@ namespace firebolt::rialto::server::tasks::generic
 {
 ReadShmDataAndAttachSamples::ReadShmDataAndAttachSamples(
     GenericPlayerContext &context, const std::shared_ptr<firebolt::rialto::wrappers::IGstWrapper> &gstWrapper,
-    IGstGenericPlayerPrivate &player, const std::shared_ptr<IDataReader> &dataReader)
-    : m_context{context}, m_gstWrapper{gstWrapper}, m_player{player}, m_dataReader{dataReader}
+    IGstGenericPlayerPrivate &player, const std::shared_ptr<IDataReader> &dataReader,
+    const std::shared_ptr<IShmBlockTracker> &shmBlockTracker)
+    : m_context{context}, m_gstWrapper{gstWrapper}, m_player{player}, m_shmSamples{{dataReader, shmBlockTracker}}
 {
     RIALTO_SERVER_LOG_DEBUG("Constructing ReadShmDataAndAttachSamples");
 }
 
+ReadShmDataAndAttachSamples::ReadShmDataAndAttachSamples(
+    GenericPlayerContext &context, const std::shared_ptr<firebolt::rialto::wrappers::IGstWrapper> &gstWrapper,
+    IGstGenericPlayerPrivate &player, const std::vector<IGstGenericPlayer::ShmSamples> &shmSamples)
+    : m_context{context}, m_gstWrapper{gstWrapper}, m_player{player}, m_shmSamples{shmSamples}
+{
+    RIALTO_SERVER_LOG_DEBUG("Constructing ReadShmDataAndAttachSamples for %zu requests", m_shmSamples.size());
+}
+
 ReadShmDataAndAttachSamples::~ReadShmDataAndAttachSamples()
 {
     RIALTO_SERVER_LOG_DEBUG("ReadShmDataAndAttachSamples finished");
@@ -48,73 +58,70 @@ ReadShmDataAndAttachSamples::~ReadShmDataAndAttachSamples()
 void ReadShmDataAndAttachSamples::execute() const
 {
     RIALTO_SERVER_LOG_DEBUG("Executing ReadShmDataAndAttachSamples");
-    // Read media segments from shared memory
-    IMediaPipeline::MediaSegmentVector mediaSegments = m_dataReader->readData();
+    for (IGstGenericPlayer::ShmSamples &shmSamples : m_shmSamples)
+    {
+        readAndAttachSamples(shmSamples);
+    }
+}
+
+void ReadShmDataAndAttachSamples::readAndAttachSamples(IGstGenericPlayer::ShmSamples &shmSamples) const
+{
+    // Read media segments from shared memory. The batch is only used by the worker thread and keeps its storage
+    // between requests.
+    MediaSegmentBatch &mediaSegments{m_context.segmentBatch};
+    mediaSegments.clear();
+    shmSamples.dataReader->readSegments(mediaSegments);
 
-    for (const auto &mediaSegment : mediaSegments)
+    for (const MediaSegmentView &mediaSegment : mediaSegments)
     {
-        if (mediaSegment->getType() == firebolt::rialto::MediaSourceType::UNKNOWN)
+        if (mediaSegment.type == firebolt::rialto::MediaSourceType::UNKNOWN)
         {
             RIALTO_SERVER_LOG_WARN("Unknown media segment type");
             continue;
         }
 
-        GstBuffer *gstBuffer = m_player.createBuffer(*mediaSegment);
-        if (mediaSegment->getType() == firebolt::rialto::MediaSourceType::VIDEO)
+        GstBuffer *gstBuffer = m_player.createBuffer(mediaSegment, shmSamples.shmBlockTracker);
+        if (mediaSegment.type == firebolt::rialto::MediaSourceType::VIDEO)
         {
-            try
-            {
-                IMediaPipeline::MediaSegmentVideo &videoSegment =
-                    dynamic_cast<IMediaPipeline::MediaSegmentVideo &>(*mediaSegment);
-                m_player.updateVideoCaps(videoSegment.getWidth(), videoSegment.getHeight(), videoSegment.getFrameRate(),
-                                         videoSegment.getCodecData());
-            }
-            catch (const std::exception &e)
-            {
-                RIALTO_SERVER_LOG_ERROR("Failed to get the video segment, reason: %s", e.what());
-            }
+            m_player.updateVideoCaps(mediaSegment.width, mediaSegment.height, mediaSegment.frameRate,
+                                     mediaSegment.codecData);
         }
-        else if (mediaSegment->getType() == firebolt::rialto::MediaSourceType::AUDIO)
+        else if (mediaSegment.type == firebolt::rialto::MediaSourceType::AUDIO)
         {
-            try
-            {
-                IMediaPipeline::MediaSegmentAudio &audioSegment =
-                    dynamic_cast<IMediaPipeline::MediaSegmentAudio &>(*mediaSegment);
-                m_player.updateAudioCaps(audioSegment.getSampleRate(), audioSegment.getNumberOfChannels(),
-                                         audioSegment.getCodecData());
-                m_player.addAudioClippingToBuffer(gstBuffer, audioSegment.getClippingStart(),
-                                                  audioSegment.getClippingEnd());
-            }
-            catch (const std::exception &e)
-            {
-                RIALTO_SERVER_LOG_ERROR("Failed to get the audio segment, reason: %s", e.what());
-            }
+            m_player.updateAudioCaps(mediaSegment.sampleRate, mediaSegment.numberOfChannels, mediaSegment.codecData);
+            m_player.addAudioClippingToBuffer(gstBuffer, mediaSegment.clippingStart, mediaSegment.clippingEnd);
         }
-        else if (mediaSegment->getType() == firebolt::rialto::MediaSourceType::SUBTITLE)
+        else if (mediaSegment.type == firebolt::rialto::MediaSourceType::SUBTITLE)
         {
-            if (mediaSegment->getDisplayOffset())
+            if (mediaSegment.displayOffset)
             {
-                GST_BUFFER_OFFSET(gstBuffer) = mediaSegment->getDisplayOffset().value();
+                GST_BUFFER_OFFSET(gstBuffer) = mediaSegment.displayOffset.value();
             }
         }
 
-        attachData(mediaSegment->getType(), gstBuffer);
+        attachData(mediaSegment.type, gstBuffer);
     }
-    // All segments in vector have the same type
+    // All segments in the batch have the same type
     if (!mediaSegments.empty())
     {
-        const auto kMediaType{mediaSegments.front()->getType()};
-        const auto kFirstTimestamp{mediaSegments.front()->getTimeStamp()};
-        const auto kLastTimestamp{mediaSegments.back()->getTimeStamp()};
+        const auto kMediaType{mediaSegments.front().type};
+        const auto kFirstTimestamp{mediaSegments.front().timeStamp};
+        const auto kLastTimestamp{mediaSegments.back().timeStamp};
+        const auto kNumSegments{mediaSegments.size()};
+        const bool kIsBufferFull{shmSamples.dataReader->isBufferFull()};
+        // The views may point into shared memory, which is handed back to the client by the notification below
+        mediaSegments.clear();
+        // Releasing the reader frees its need data slot, so it can be requested again
+        shmSamples.dataReader.reset();
         RIALTO_SERVER_LOG_DEBUG("%s data received. First ts: %" GST_TIME_FORMAT " last ts: %" GST_TIME_FORMAT,
                                 common::convertMediaSourceType(kMediaType), GST_TIME_ARGS(kFirstTimestamp),
                                 GST_TIME_ARGS(kLastTimestamp));
-        if (!m_dataReader->isBufferFull() && m_context.streamPosition.load() != -1 &&
+        if (!kIsBufferFull && m_context.streamPosition.load() != -1 &&
             kLastTimestamp >= m_context.streamPosition.load() + kDelayThreshold)
         {
             RIALTO_SERVER_LOG_DEBUG("Received %zu segments, current pos: %" GST_TIME_FORMAT
                                     " last received ts: %" GST_TIME_FORMAT ", scheduling NeedMediaData with delay",
-                                    mediaSegments.size(), GST_TIME_ARGS(m_context.streamPosition.load()),
+                                    kNumSegments, GST_TIME_ARGS(m_context.streamPosition.load()),
                                     GST_TIME_ARGS(kLastTimestamp));
             m_player.notifyNeedMediaDataWithDelay(kMediaType);
             return;
@@ -0,0 +1,139 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "tasks/generic/ReadShmRingAndAttachSamples.h"
+#include "GenericPlayerContext.h"
+#include "IGstGenericPlayerPrivate.h"
+#include "RialtoServerLogging.h"
+#include "TypeConverters.h"
+#include "tasks/generic/Eos.h"
+
+namespace
+{
+/**
+ * @brief The maximum number of frames attached by a single task, so that the other tasks of the worker thread, like
+ *        EnoughData, are not delayed by a client which keeps the ring full.
+ */
+constexpr unsigned kMaxFramesPerTask{32};
+} // namespace
+
+namespace firebolt::rialto::server::tasks::generic
+{
+ReadShmRingAndAttachSamples::ReadShmRingAndAttachSamples(
+    GenericPlayerContext &context, const std::shared_ptr<firebolt::rialto::wrappers::IGstWrapper> &gstWrapper,
+    IGstGenericPlayerPrivate &player, const std::shared_ptr<IShmRingReader> &shmRingReader)
+    : m_context{context}, m_gstWrapper{gstWrapper}, m_player{player}, m_shmRingReader{shmRingReader}
+{
+    RIALTO_SERVER_LOG_DEBUG("Constructing ReadShmRingAndAttachSamples");
+}
+
+ReadShmRingAndAttachSamples::~ReadShmRingAndAttachSamples()
+{
+    RIALTO_SERVER_LOG_DEBUG("ReadShmRingAndAttachSamples finished");
+}
+
+void ReadShmRingAndAttachSamples::execute() const
+{
+    RIALTO_SERVER_LOG_DEBUG("Executing ReadShmRingAndAttachSamples");
+    const MediaSourceType kMediaType{m_shmRingReader->getType()};
+    auto elem = m_context.streamInfo.find(kMediaType);
+    if (elem == m_context.streamInfo.end())
+    {
+        RIALTO_SERVER_LOG_WARN("Could not find stream info for %s", common::convertMediaSourceType(kMediaType));
+        return;
+    }
+
+    // The batch is only used by the worker thread and keeps its storage between frames.
+    MediaSegmentBatch &mediaSegments{m_context.segmentBatch};
+    unsigned numFrames{0};
+    while (elem->second.isDataNeeded)
+    {
+        if (numFrames == kMaxFramesPerTask)
+        {
+            // The ring is drained again by the next task, queued after the ones that are already waiting
+            m_player.notifyNeedMediaData(kMediaType);
+            return;
+        }
+        mediaSegments.clear();
+        const IShmRingReader::Status kStatus{m_shmRingReader->read(mediaSegments)};
+        if (IShmRingReader::Status::EMPTY == kStatus)
+        {
+            if (m_shmRingReader->waitForDoorbell())
+            {
+                continue;
+            }
+            // The client rings the doorbell when it writes the next record
+            break;
+        }
+        if (IShmRingReader::Status::END_OF_STREAM == kStatus)
+        {
+            m_shmRingReader->consume();
+            Eos task{m_context, m_player, m_gstWrapper, kMediaType};
+            task.execute();
+            break;
+        }
+        for (const MediaSegmentView &mediaSegment : mediaSegments)
+        {
+            attachSegment(mediaSegment);
+        }
+        // The views point into the ring, which is handed back to the client by consume()
+        mediaSegments.clear();
+        m_shmRingReader->consume();
+        ++numFrames;
+    }
+    RIALTO_SERVER_LOG_DEBUG("%u %s frames attached from the ring", numFrames,
+                            common::convertMediaSourceType(kMediaType));
+}
+
+void ReadShmRingAndAttachSamples::attachSegment(const MediaSegmentView &mediaSegment) const
+{
+    // Without a block tracker, the data is copied out of the ring
+    GstBuffer *gstBuffer = m_player.createBuffer(mediaSegment, nullptr);
+    if (mediaSegment.type == firebolt::rialto::MediaSourceType::VIDEO)
+    {
+        m_player.updateVideoCaps(mediaSegment.width, mediaSegment.height, mediaSegment.frameRate,
+                                 mediaSegment.codecData);
+    }
+    else if (mediaSegment.type == firebolt::rialto::MediaSourceType::AUDIO)
+    {
+        m_player.updateAudioCaps(mediaSegment.sampleRate, mediaSegment.numberOfChannels, mediaSegment.codecData);
+        m_player.addAudioClippingToBuffer(gstBuffer, mediaSegment.clippingStart, mediaSegment.clippingEnd);
+    }
+    else if (mediaSegment.type == firebolt::rialto::MediaSourceType::SUBTITLE)
+    {
+        if (mediaSegment.displayOffset)
+        {
+            GST_BUFFER_OFFSET(gstBuffer) = mediaSegment.displayOffset.value();
+        }
+    }
+
+    auto elem = m_context.streamInfo.find(mediaSegment.type);
+    if (elem != m_context.streamInfo.end())
+    {
+        elem->second.buffers.push_back(gstBuffer);
+        m_player.attachData(mediaSegment.type);
+    }
+    else
+    {
+        RIALTO_SERVER_LOG_WARN("Could not find stream info for %s", common::convertMediaSourceType(mediaSegment.type));
+        m_gstWrapper->gstBufferUnref(gstBuffer);
+    }
+}
+} // namespace firebolt::rialto::server::tasks::generic
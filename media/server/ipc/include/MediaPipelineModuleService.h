@@ -78,6 +78,13 @@ public:
                      ::firebolt::rialto::SetPositionResponse *response, ::google::protobuf::Closure *done) override;
     void haveData(::google::protobuf::RpcController *controller, const ::firebolt::rialto::HaveDataRequest *request,
                   ::firebolt::rialto::HaveDataResponse *response, ::google::protobuf::Closure *done) override;
+    void haveDataMulti(::google::protobuf::RpcController *controller,
+                       const ::firebolt::rialto::HaveDataMultiRequest *request,
+                       ::firebolt::rialto::HaveDataMultiResponse *response, ::google::protobuf::Closure *done) override;
+    void enableStreamingMode(::google::protobuf::RpcController *controller,
+                             const ::firebolt::rialto::EnableStreamingModeRequest *request,
+                             ::firebolt::rialto::EnableStreamingModeResponse *response,
+                             ::google::protobuf::Closure *done) override;
     void setPlaybackRate(::google::protobuf::RpcController *controller,
                          const ::firebolt::rialto::SetPlaybackRateRequest *request,
                          ::firebolt::rialto::SetPlaybackRateResponse *response,
@@ -636,6 +636,56 @@ void MediaPipelineModuleService::haveData(::google::protobuf::RpcController *con
     done->Run();
 }
 
+void MediaPipelineModuleService::haveDataMulti(::google::protobuf::RpcController *controller,
+                                               const ::firebolt::rialto::HaveDataMultiRequest *request,
+                                               ::firebolt::rialto::HaveDataMultiResponse *response,
+                                               ::google::protobuf::Closure *done)
+{
+    RIALTO_SERVER_LOG_DEBUG("entry:");
+    std::vector<HaveDataInfo> haveDataInfos;
+    haveDataInfos.reserve(request->data_size());
+    for (const auto &kData : request->data())
+    {
+        haveDataInfos.push_back(HaveDataInfo{convertMediaSourceStatus(kData.status()), kData.num_frames(),
+                                             kData.request_id()});
+    }
+    std::vector<bool> results;
+    if (!m_mediaPipelineService.haveDataMulti(request->session_id(), haveDataInfos, results))
+    {
+        RIALTO_SERVER_LOG_ERROR("Have data multi failed");
+        controller->SetFailed("Operation failed");
+    }
+    for (bool result : results)
+    {
+        response->add_succeeded(result);
+    }
+    done->Run();
+}
+
+void MediaPipelineModuleService::enableStreamingMode(::google::protobuf::RpcController *controller,
+                                                     const ::firebolt::rialto::EnableStreamingModeRequest *request,
+                                                     ::firebolt::rialto::EnableStreamingModeResponse *response,
+                                                     ::google::protobuf::Closure *done)
+{
+    RIALTO_SERVER_LOG_DEBUG("entry:");
+    int doorbellFd{-1};
+    std::uint32_t ringOffset{0};
+    std::uint32_t ringCapacity{0};
+    if (!m_mediaPipelineService.enableStreamingMode(request->session_id(), request->source_id(), doorbellFd,
+                                                    ringOffset, ringCapacity))
+    {
+        RIALTO_SERVER_LOG_ERROR("Enable streaming mode failed");
+        controller->SetFailed("Operation failed");
+    }
+    else
+    {
+        response->set_doorbell_fd(doorbellFd);
+        response->set_ring_offset(ringOffset);
+        response->set_ring_capacity(ringCapacity);
+    }
+    done->Run();
+}
+
 void MediaPipelineModuleService::setPlaybackRate(::google::protobuf::RpcController *controller,
                                                  const ::firebolt::rialto::SetPlaybackRateRequest *request,
                                                  ::firebolt::rialto::SetPlaybackRateResponse *response,
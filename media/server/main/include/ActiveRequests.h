@@ -74,6 +74,7 @@ public:
     void erase(std::uint32_t requestId) override;
     void erase(const MediaSourceType &mediaSourceType) override;
     void clear() override;
+    bool isEmpty() const override;
     AddSegmentStatus addSegment(std::uint32_t requestId,
                                 const std::unique_ptr<IMediaPipeline::MediaSegment> &segment) override;
     const IMediaPipeline::MediaSegmentVector &getSegments(std::uint32_t requestId) const override;
@@ -31,8 +31,8 @@ public:
     DataReaderFactory() = default;
     ~DataReaderFactory() override = default;
     std::shared_ptr<IDataReader> createDataReader(const MediaSourceType &mediaSourceType, std::uint8_t *buffer,
-                                                  std::uint32_t dataOffset, std::uint32_t numFrames,
-                                                  bool isBufferFull) const override;
+                                                  std::uint32_t dataOffset, std::uint32_t mediaDataOffset,
+                                                  std::uint32_t numFrames, bool isBufferFull) const override;
 };
 } // namespace firebolt::rialto::server
 
@@ -60,7 +60,10 @@ public:
     ~DataReaderV1() override = default;
 
     IMediaPipeline::MediaSegmentVector readData() const override;
+    void readSegments(MediaSegmentBatch &batch) const override;
     bool isBufferFull() const override;
+    std::uint32_t getMetadataVersion() const override;
+    std::uint32_t getDataLength() const override;
 
 private:
     std::vector<MetadataV1> readMetadata() const;
@@ -30,17 +30,21 @@ class DataReaderV2 : public IDataReader
 {
 public:
     DataReaderV2(const MediaSourceType &mediaSourceType, std::uint8_t *buffer, std::uint32_t dataOffset,
-                 std::uint32_t numFrames, bool isBufferFull);
+                 std::uint32_t numFrames, std::uint32_t dataLength, bool isBufferFull);
     ~DataReaderV2() override = default;
 
     IMediaPipeline::MediaSegmentVector readData() const override;
+    void readSegments(MediaSegmentBatch &batch) const override;
     bool isBufferFull() const override;
+    std::uint32_t getMetadataVersion() const override;
+    std::uint32_t getDataLength() const override;
 
 private:
     MediaSourceType m_mediaSourceType;
     std::uint8_t *m_buffer;
     std::uint32_t m_dataOffset;
     std::uint32_t m_numFrames;
+    std::uint32_t m_dataLength;
     bool m_isBufferFull;
 };
 } // namespace firebolt::rialto::server
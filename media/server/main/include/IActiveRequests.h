@@ -45,6 +45,7 @@ public:
     virtual void erase(std::uint32_t requestId) = 0;
     virtual void erase(const MediaSourceType &mediaSourceType) = 0;
     virtual void clear() = 0;
+    virtual bool isEmpty() const = 0;
     virtual AddSegmentStatus addSegment(std::uint32_t requestId,
                                         const std::unique_ptr<IMediaPipeline::MediaSegment> &segment) = 0;
     virtual const IMediaPipeline::MediaSegmentVector &getSegments(std::uint32_t requestId) const = 0;
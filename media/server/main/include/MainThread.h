@@ -27,9 +27,9 @@
 #include <map>
 #include <memory>
 #include <mutex>
-#include <set>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace firebolt::rialto::server
 {
@@ -57,12 +57,22 @@ protected:
 };
 
 /**
- * @brief The definition of the MediaKeys.
+ * @brief The definition of the MainThread.
+ *
+ * Tasks are run on a small pool of threads. Each registered client has a strand, a queue of its tasks that are run
+ * one at a time and in order, so a client never sees its tasks overlap. Clients on different strands are independent
+ * and may run at the same time on different threads.
  */
 class MainThread : public IMainThread
 {
 public:
-    MainThread();
+    /**
+     * @brief The constructor.
+     *
+     * @param[in] numThreads : The number of threads running the strands, 0 to use RIALTO_MAIN_THREAD_POOL_SIZE or
+     *                         the default.
+     */
+    explicit MainThread(unsigned numThreads = 0);
     virtual ~MainThread();
 
     int32_t registerClient() override;
@@ -86,16 +96,40 @@ private:
     };
 
     /**
-     * @brief Starts a loop that listens for enqueued tasks.
+     * @brief The queue of tasks of one or more clients, that are run in order.
+     */
+    struct Strand
+    {
+        std::deque<std::shared_ptr<TaskInfo>> tasks; /**< The tasks waiting to run. */
+        bool isScheduled{false};                     /**< Whether the strand is in the ready queue or running. */
+    };
+
+    /**
+     * @brief Runs strands from the ready queue until the main thread is shut down.
+     */
+    void workerThreadLoop();
+
+    /**
+     * @brief Queues a task on the strand of its client.
+     *
+     * @param[in] taskInfo : The task.
+     * @param[in] priority : Whether the task goes ahead of the others on the strand.
      */
-    void mainThreadLoop();
+    void enqueue(const std::shared_ptr<TaskInfo> &taskInfo, bool priority);
 
     /**
-     * @brief Waits for tasks to enter the queue and returns the next task.
+     * @brief Queues a task and waits for it to finish.
      *
-     * @retval The next task in the queue.
+     * @param[in] clientId : The id of the registered client.
+     * @param[in] task     : Task to queue.
+     * @param[in] priority : Whether the task goes ahead of the others on the strand.
+     */
+    void enqueueAndWait(uint32_t clientId, const Task &task, bool priority);
+
+    /**
+     * @brief The strand the calling thread is running a task of, if any.
      */
-    const std::shared_ptr<TaskInfo> waitForTask();
+    static const Strand *&currentStrand();
 
     /**
      * @brief Whether the main thread is running.
@@ -103,24 +137,24 @@ private:
     bool m_isMainThreadRunning;
 
     /**
-     * @brief The main thread.
+     * @brief The threads running the strands.
      */
-    std::thread m_thread;
+    std::vector<std::thread> m_threads;
 
     /**
-     * @brief A mutex protecting access to the task queue.
+     * @brief A mutex protecting the strands, the ready queue and the registered clients.
      */
     std::mutex m_taskQueueMutex;
 
     /**
-     * @brief A condition variable used to notify of tasks entering the task queue.
+     * @brief A condition variable used to notify of strands entering the ready queue.
      */
     std::condition_variable m_taskQueueCv;
 
     /**
-     * @brief The queue of tasks and there infomation.
+     * @brief The strands that have tasks to run and are not running.
      */
-    std::deque<std::shared_ptr<TaskInfo>> m_taskQueue;
+    std::deque<std::shared_ptr<Strand>> m_readyStrands;
 
     /**
      * @brief The main thread objects client id, for registering new clients.
@@ -133,9 +167,9 @@ private:
     std::atomic<uint32_t> m_nextClientId;
 
     /**
-     * @brief Clients registered on this thread.
+     * @brief Clients registered on this thread, and their strands.
      */
-    std::set<uint32_t> m_registeredClients;
+    std::map<uint32_t, std::shared_ptr<Strand>> m_registeredClients;
 };
 } // namespace firebolt::rialto::server
 
@@ -183,6 +183,12 @@ private:
      */
     std::mutex m_ocdmErrorMutex;
 
+    /**
+     * @brief Serialises the calls to the ocdm session, decrypt() and selectKeyId() are called from the decryptor
+     *        threads rather than the main thread.
+     */
+    std::recursive_mutex m_ocdmSessionMutex;
+
     /**
      * @brief Drm header to be set once the session is constructed
      */
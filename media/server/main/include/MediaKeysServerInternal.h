@@ -26,6 +26,7 @@
 #include "IOcdmSystem.h"
 #include <map>
 #include <memory>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -138,6 +139,11 @@ private:
      */
     std::map<int32_t, std::unique_ptr<IMediaKeySession>> m_mediaKeySessions;
 
+    /**
+     * @brief Held exclusively by the main thread to add and remove sessions, and shared by decrypt() and selectKeyId().
+     */
+    std::shared_mutex m_mediaKeySessionsMutex;
+
     /**
      * @brief KeySystem type of the MediaKeysServerInternal.
      */
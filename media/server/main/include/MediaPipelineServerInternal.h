@@ -27,11 +27,19 @@
 #include "IMediaPipelineServerInternal.h"
 #include "ITimer.h"
 #include "NeedDataDelayCalculator.h"
+#include "NeedDataSizeCalculator.h"
+#include "NeedDataSlots.h"
+#include "SessionServerCommon.h"
+#include "ShmBlockTracker.h"
+#include "ShmRegionSizeCalculator.h"
+#include "ShmRingReader.h"
 #include <map>
 #include <memory>
+#include <optional>
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace firebolt::rialto::server
@@ -69,15 +77,16 @@ public:
     /**
      * @brief The constructor.
      *
-     * @param[in] client            : The Rialto media player client.
-     * @param[in] videoRequirements : The video decoder requirements for the MediaPipeline session.
-     * @param[in] gstPlayerFactory  : The gstreamer player factory.
-     * @param[in] sessionId         : The session id
-     * @param[in] shmBuffer         : The shared memory buffer
-     * @param[in] mainThreadFactory : The main thread factory.
-     * @param[in] dataReaderFactory : The data reader factory
-     * @param[in] activeRequests    : The active requests
-     * @param[in] decryptionService : The decryption service
+     * @param[in] client             : The Rialto media player client.
+     * @param[in] videoRequirements  : The video decoder requirements for the MediaPipeline session.
+     * @param[in] gstPlayerFactory   : The gstreamer player factory.
+     * @param[in] sessionId          : The session id
+     * @param[in] shmBuffer          : The shared memory buffer
+     * @param[in] mainThreadFactory  : The main thread factory.
+     * @param[in] dataReaderFactory  : The data reader factory
+     * @param[in] activeRequests     : The active requests
+     * @param[in] decryptionService  : The decryption service
+     * @param[in] sharedMemoryConfig : The options of the shared memory usage
      */
     MediaPipelineServerInternal(const std::shared_ptr<IMediaPipelineClient> &client,
                                 const VideoRequirements &videoRequirements,
@@ -86,7 +95,9 @@ public:
                                 const std::shared_ptr<IMainThreadFactory> &mainThreadFactory,
                                 const std::shared_ptr<common::ITimerFactory> &timerFactory,
                                 std::unique_ptr<IDataReaderFactory> &&dataReaderFactory,
-                                std::unique_ptr<IActiveRequests> &&activeRequests, IDecryptionService &decryptionService);
+                                std::unique_ptr<IActiveRequests> &&activeRequests,
+                                IDecryptionService &decryptionService,
+                                const common::SharedMemoryConfig &sharedMemoryConfig);
 
     /**
      * @brief Virtual destructor.
@@ -129,6 +140,10 @@ public:
 
     bool haveData(MediaSourceStatus status, uint32_t numFrames, uint32_t needDataRequestId) override;
 
+    bool haveDataMulti(const std::vector<HaveDataInfo> &haveDataInfos, std::vector<bool> &results) override;
+
+    bool enableStreamingRing(int32_t sourceId, ISharedMemoryBuffer::StreamingRing &ring) override;
+
     void ping(std::unique_ptr<IHeartbeatHandler> &&heartbeatHandler) override;
 
     bool renderFrame() override;
@@ -319,6 +334,51 @@ protected:
      */
     NeedDataDelayCalculator m_needDataDelayCalculator;
 
+    /**
+     * @brief Object to choose the number of frames and bytes requested in each NeedMediaData
+     */
+    NeedDataSizeCalculator m_needDataSizeCalculator;
+
+    /**
+     * @brief Object used to choose the sizes of the shm regions from the attached sources
+     */
+    ShmRegionSizeCalculator m_shmRegionSizeCalculator;
+
+    /**
+     * @brief The sizes last requested for the shm partition
+     */
+    ISharedMemoryBuffer::PartitionSizes m_shmPartitionSizes{};
+
+    /**
+     * @brief The readers of the media data passed to gstreamer. A reader expires once the worker thread has read it.
+     */
+    std::vector<std::weak_ptr<IDataReader>> m_attachedDataReaders;
+
+    /**
+     * @brief Flag used to check if media data can be passed from shm to gstreamer without copying
+     */
+    bool m_isShmZeroCopyEnabled;
+
+    /**
+     * @brief Number of NeedMediaData requests which may be outstanding for one source
+     */
+    std::uint32_t m_numNeedDataSlots;
+
+    /**
+     * @brief Map of trackers of the shm blocks lent to gstreamer for each media type and need data slot
+     */
+    std::map<std::pair<MediaSourceType, std::uint32_t>, std::shared_ptr<ShmBlockTracker>> m_shmBlockTrackers;
+
+    /**
+     * @brief Map of the need data slots of each media type, used when more than one request may be outstanding
+     */
+    std::map<MediaSourceType, NeedDataSlots> m_needDataSlots;
+
+    /**
+     * @brief Map of the readers of the rings of the sources in streaming mode
+     */
+    std::map<MediaSourceType, std::shared_ptr<ShmRingReader>> m_shmRingReaders;
+
     /**
      * @brief Load internally, only to be called on the main thread.
      *
@@ -498,6 +558,37 @@ protected:
      */
     bool haveDataInternal(MediaSourceStatus status, uint32_t numFrames, uint32_t needDataRequestId);
 
+    /**
+     * @brief Have data of several requests internally, only to be called on the main thread.
+     *
+     * @param[in]  haveDataInfos : The status, number of frames and request id of each request
+     * @param[out] results       : Whether each request succeeded, in the order of haveDataInfos
+     *
+     * @retval true if the requests were processed.
+     */
+    bool haveDataMultiInternal(const std::vector<HaveDataInfo> &haveDataInfos, std::vector<bool> &results);
+
+    /**
+     * @brief Prepares the samples of one have data request, only to be called on the main thread.
+     *
+     * @param[in]  status            : The status
+     * @param[in]  numFrames         : The number of frames written.
+     * @param[in]  needDataRequestId : Need data request id
+     * @param[out] shmSamples        : The samples to attach are appended here.
+     * @param[out] eosSources        : The source is appended here, if it reached the end of stream.
+     *
+     * @retval true on success.
+     */
+    bool readHaveData(MediaSourceStatus status, uint32_t numFrames, uint32_t needDataRequestId,
+                      std::vector<IGstGenericPlayer::ShmSamples> &shmSamples, std::vector<MediaSourceType> &eosSources);
+
+    /**
+     * @brief Sets the end of stream of the sources, only to be called on the main thread.
+     *
+     * @param[in] eosSources : The sources, which reached the end of stream.
+     */
+    void setEosForSources(const std::vector<MediaSourceType> &eosSources);
+
     /**
      * @brief Add segment internally, only to be called on the main thread.
      *
@@ -649,6 +740,23 @@ protected:
      */
     void pingInternal(std::unique_ptr<IHeartbeatHandler> &&heartbeatHandler);
 
+    /**
+     * @brief Switches a source to streaming mode, only to be called on the main thread.
+     *
+     * @param[in]  sourceId : The source id.
+     * @param[out] ring     : The ring and its doorbell.
+     *
+     * @retval true on success.
+     */
+    bool enableStreamingRingInternal(int32_t sourceId, ISharedMemoryBuffer::StreamingRing &ring);
+
+    /**
+     * @brief Stops the streaming mode of a source, if it is enabled, only to be called on the main thread.
+     *
+     * @param[in] mediaSourceType : The media source type.
+     */
+    void disableStreamingRing(MediaSourceType mediaSourceType);
+
     /**
      * @brief Flushes a source.
      *
@@ -766,6 +874,51 @@ protected:
      * @retval NeedMediaData timeout
      */
     std::chrono::milliseconds getNeedMediaDataTimeout(MediaSourceType mediaSourceType);
+
+    /**
+     * @brief Gets the tracker of the shm blocks lent to gstreamer, creating it on first use
+     *
+     * @param[in] mediaSourceType : The media source type.
+     * @param[in] slotIndex       : The need data slot, whose media data area is tracked.
+     *
+     * @retval the tracker or nullptr, if media data has to be copied out of shm
+     */
+    std::shared_ptr<ShmBlockTracker> getShmBlockTracker(MediaSourceType mediaSourceType, std::uint32_t slotIndex = 0);
+
+    /**
+     * @brief Gets the need data slots of the source, creating them on first use
+     *
+     * @param[in] mediaSourceType : The media source type.
+     *
+     * @retval the slots or nullptr, if only one request may be outstanding
+     */
+    NeedDataSlots *getNeedDataSlots(MediaSourceType mediaSourceType);
+
+    /**
+     * @brief Resizes the shm partition for the attached sources, only to be called on the main thread.
+     *
+     * The regions may be moved, so must only be called when no media data is outstanding.
+     */
+    void resizeShmPartition();
+
+    /**
+     * @brief Resizes the shm partition, if the sources changed since it was last sized and no media data is
+     *        outstanding, only to be called on the main thread.
+     */
+    void resizeShmPartitionIfNeeded();
+
+    /**
+     * @brief Sends the NeedMediaData event, only to be called on the main thread.
+     *
+     * @param[in]  mediaSourceType : The media source type.
+     * @param[in]  sourceId        : The source id.
+     * @param[in]  slotIndex       : The need data slot to request, if slots are used.
+     * @param[out] requestId       : The id of the sent request.
+     *
+     * @retval true on success.
+     */
+    bool sendNeedMediaData(MediaSourceType mediaSourceType, std::int32_t sourceId,
+                           std::optional<std::uint32_t> slotIndex, std::uint32_t &requestId);
 };
 
 }; // namespace firebolt::rialto::server
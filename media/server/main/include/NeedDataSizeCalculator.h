@@ -0,0 +1,148 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_SERVER_NEED_DATA_SIZE_CALCULATOR_H_
+#define FIREBOLT_RIALTO_SERVER_NEED_DATA_SIZE_CALCULATOR_H_
+
+#include "MediaCommon.h"
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace firebolt::rialto::server
+{
+/**
+ * @brief The size of a single NeedMediaData request.
+ */
+struct NeedDataSize
+{
+    std::uint32_t frameCount;    /**< The number of frames requested */
+    std::uint32_t maxMediaBytes; /**< The number of bytes the client may write */
+};
+
+/**
+ * @brief The inputs and the last decision of the calculator for a single source.
+ */
+struct NeedDataSizeStats
+{
+    std::uint32_t frameCount{0};                /**< The frame count of the last request */
+    std::uint32_t maxMediaBytes{0};             /**< The byte budget of the last request */
+    std::uint32_t averageFrameBytes{0};         /**< The average size of the frames written, 0 if unknown */
+    std::optional<std::int64_t> queuedDuration; /**< The duration of the data queued in the pipeline in ns */
+    double playbackRate{1.0};                   /**< The playback rate used for the last request */
+    std::uint64_t numRequests{0};               /**< The number of requests sized */
+};
+
+/**
+ * @brief Chooses the number of frames and bytes to request in each NeedMediaData.
+ *
+ * As long as nothing is known about the stream, the fixed kMaxFrames/kPrerollNumFrames counts are used.
+ * Once the size of the frames written by the client is known, the frame count is chosen so that a request
+ * fills the available shared memory, up to the number of frames the client's metadata format can describe.
+ * The count is reduced while the pipeline has more data queued than it needs at the current playback rate.
+ * The byte budget is the observed frame size, with some headroom, times the frame count, capped at the available
+ * bytes. When the client cannot write a single frame within the budget, the next request may use all the
+ * available bytes.
+ */
+class NeedDataSizeCalculator
+{
+public:
+    NeedDataSizeCalculator() = default;
+    ~NeedDataSizeCalculator() = default;
+
+    /**
+     * @brief Chooses the size of the next request and records it in the stats.
+     *
+     * @param[in] mediaSourceType : The source type of the request.
+     * @param[in] isPrerolling    : Whether the pipeline is prerolling.
+     * @param[in] availableBytes  : The number of bytes of shared memory the client can write to.
+     *
+     * @retval the size of the request.
+     */
+    NeedDataSize calculateNeedDataSize(MediaSourceType mediaSourceType, bool isPrerolling,
+                                       std::uint32_t availableBytes);
+
+    /**
+     * @brief Records the data written by the client for a request.
+     *
+     * @param[in] mediaSourceType : The source type of the request.
+     * @param[in] numFrames       : The number of frames written.
+     * @param[in] numBytes        : The number of bytes written, 0 if unknown.
+     * @param[in] metadataVersion : The metadata version used by the client.
+     */
+    void onDataReceived(MediaSourceType mediaSourceType, std::uint32_t numFrames, std::uint32_t numBytes,
+                        std::uint32_t metadataVersion);
+
+    /**
+     * @brief Records that the client could not write any frame within the byte budget of a request.
+     *
+     * @param[in] mediaSourceType : The source type of the request.
+     */
+    void onNoSpaceForSamples(MediaSourceType mediaSourceType);
+
+    /**
+     * @brief Sets the duration of the data that has been queued in the pipeline, but not played yet.
+     *
+     * @param[in] mediaSourceType : The source type.
+     * @param[in] queuedDuration  : The duration in nanoseconds, or nullopt if unknown.
+     */
+    void setQueuedDuration(MediaSourceType mediaSourceType, std::optional<std::int64_t> queuedDuration);
+
+    /**
+     * @brief Sets the playback rate of the pipeline.
+     *
+     * @param[in] rate : The playback rate.
+     */
+    void setPlaybackRate(double rate);
+
+    /**
+     * @brief Forgets the queued duration of the source, for example after a flush.
+     *
+     * @param[in] mediaSourceType : The source type.
+     */
+    void resetQueuedDuration(MediaSourceType mediaSourceType);
+
+    /**
+     * @brief Forgets the queued duration of all the sources, for example after a seek.
+     */
+    void resetQueuedDuration();
+
+    /**
+     * @brief Gets the inputs and the last decision for the source.
+     *
+     * @param[in] mediaSourceType : The source type.
+     *
+     * @retval the stats.
+     */
+    NeedDataSizeStats getStats(MediaSourceType mediaSourceType) const;
+
+private:
+    struct SourceState
+    {
+        NeedDataSizeStats stats;
+        std::uint32_t maxFrames{0};
+        bool isBudgetTooSmall{false};
+    };
+
+    std::map<MediaSourceType, SourceState> m_sources;
+    double m_playbackRate{1.0};
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_NEED_DATA_SIZE_CALCULATOR_H_
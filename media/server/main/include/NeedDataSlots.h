@@ -0,0 +1,138 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_SERVER_NEED_DATA_SLOTS_H_
+#define FIREBOLT_RIALTO_SERVER_NEED_DATA_SLOTS_H_
+
+#include "IActiveRequests.h"
+#include "IDataReader.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace firebolt::rialto::server
+{
+/**
+ * @brief The maximum number of slots the shm region of a source can be split into.
+ */
+constexpr unsigned kMaxNeedDataSlots{4};
+
+/**
+ * @brief Splits the shm region of a source into slots, which can be requested by separate NeedMediaData.
+ *
+ * Each slot has its own metadata and media data, so the client can fill one slot while the server is still reading
+ * another. A slot can be requested again once its request is no longer active and its data reader has been released.
+ * A single slot is always reused, like the whole region is without slots.
+ */
+class NeedDataSlots
+{
+public:
+    /**
+     * @brief A part of the region.
+     */
+    struct Slot
+    {
+        std::uint32_t offset; /**< The offset of the slot from the start of the region */
+        std::uint32_t length; /**< The length of the slot, including its metadata */
+    };
+
+    /**
+     * @brief The constructor.
+     *
+     * @param[in] regionLength : The length of the region of the source.
+     * @param[in] numSlots     : The requested number of slots. Fewer are used, if the region is too small.
+     */
+    NeedDataSlots(std::uint32_t regionLength, std::uint32_t numSlots);
+    ~NeedDataSlots() = default;
+
+    /**
+     * @brief Gets the number of slots.
+     *
+     * @retval the number of slots.
+     */
+    std::uint32_t size() const;
+
+    /**
+     * @brief Gets a slot.
+     *
+     * @param[in] slotIndex : The index of the slot.
+     *
+     * @retval the slot.
+     */
+    const Slot &getSlot(std::uint32_t slotIndex) const;
+
+    /**
+     * @brief Gets the slots that can be requested.
+     *
+     * @param[in] activeRequests : The active NeedMediaData requests.
+     *
+     * @retval the indexes of the free slots.
+     */
+    std::vector<std::uint32_t> getFreeSlots(const IActiveRequests &activeRequests) const;
+
+    /**
+     * @brief Checks if any slot has been requested and not received yet.
+     *
+     * @param[in] activeRequests : The active NeedMediaData requests.
+     *
+     * @retval true if a request is outstanding.
+     */
+    bool hasOutstandingRequest(const IActiveRequests &activeRequests) const;
+
+    /**
+     * @brief Records the request sent for the slot.
+     *
+     * @param[in] slotIndex : The index of the slot.
+     * @param[in] requestId : The id of the NeedMediaData request.
+     */
+    void setRequestId(std::uint32_t slotIndex, std::uint32_t requestId);
+
+    /**
+     * @brief Finds the slot of a request.
+     *
+     * @param[in] requestId : The id of the NeedMediaData request.
+     *
+     * @retval the index of the slot or nullopt, if the request was not sent for a slot.
+     */
+    std::optional<std::uint32_t> findSlot(std::uint32_t requestId) const;
+
+    /**
+     * @brief Records the reader of the data received for the slot. The slot is in use until the reader is released.
+     *
+     * @param[in] slotIndex  : The index of the slot.
+     * @param[in] dataReader : The data reader.
+     */
+    void setDataReader(std::uint32_t slotIndex, const std::shared_ptr<IDataReader> &dataReader);
+
+private:
+    struct SlotState
+    {
+        Slot slot;
+        std::optional<std::uint32_t> requestId;
+        std::weak_ptr<IDataReader> dataReader;
+    };
+
+    bool isRequestOutstanding(const SlotState &slotState, const IActiveRequests &activeRequests) const;
+
+    std::vector<SlotState> m_slots;
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_NEED_DATA_SLOTS_H_
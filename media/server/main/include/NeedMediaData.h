@@ -24,6 +24,9 @@
 #include "IMediaPipelineClient.h"
 #include "ISharedMemoryBuffer.h"
 #include "MediaCommon.h"
+#include "NeedDataSizeCalculator.h"
+#include "NeedDataSlots.h"
+#include "ShmBlockTracker.h"
 #include <cstdint>
 #include <memory>
 
@@ -34,10 +37,14 @@ class NeedMediaData
 public:
     NeedMediaData(std::weak_ptr<IMediaPipelineClient> client, IActiveRequests &activeRequests,
                   const ISharedMemoryBuffer &shmBuffer, int sessionId, MediaSourceType mediaSourceType,
-                  std::int32_t sourceId, PlaybackState currentPlaybackState);
+                  std::int32_t sourceId, PlaybackState currentPlaybackState,
+                  ShmBlockTracker *shmBlockTracker = nullptr,
+                  NeedDataSizeCalculator *needDataSizeCalculator = nullptr,
+                  const NeedDataSlots::Slot *slot = nullptr);
     ~NeedMediaData() = default;
 
     bool send() const;
+    bool send(std::uint32_t &requestId) const;
 
 private:
     std::weak_ptr<IMediaPipelineClient> m_client;
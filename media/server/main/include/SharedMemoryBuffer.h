@@ -22,7 +22,12 @@
 
 #include "ISharedMemoryBuffer.h"
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace firebolt::rialto::server
@@ -47,8 +52,16 @@ public:
 
     bool mapPartition(MediaPlaybackType playbackType, int id) override;
     bool unmapPartition(MediaPlaybackType playbackType, int id) override;
+    bool resizePartition(MediaPlaybackType playbackType, int id, const PartitionSizes &sizes) override;
+    std::vector<PartitionUsage> getPartitionUsage(MediaPlaybackType playbackType) const override;
 
     bool clearData(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType) const override;
+    bool clearData(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType,
+                   std::uint32_t offset) const override;
+
+    bool enableStreamingMode(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType,
+                             std::function<void()> &&doorbellCallback, StreamingRing &ring) override;
+    bool disableStreamingMode(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType) override;
 
     std::uint32_t getDataOffset(MediaPlaybackType playbackType, int id,
                                 const MediaSourceType &mediaSourceType) const override;
@@ -67,20 +80,50 @@ public:
         std::uint32_t dataBufferAudioLen;
         std::uint32_t dataBufferVideoLen;
         std::uint32_t dataBufferSubtitleLen;
+        std::uint32_t dataOffset{0};
     };
 
 private:
+    /**
+     * @brief The doorbell of a media region in streaming mode.
+     */
+    struct Doorbell
+    {
+        int fd;
+        std::function<void()> callback;
+    };
+
+    bool createDataBuffer(unsigned int memfdFlags);
     size_t calculateBufferSize() const;
+    bool findFreeGenericBlock(std::uint32_t size, int excludedId, std::uint32_t &offset) const;
+    std::uint32_t getFreeGenericBytes(int excludedId) const;
+    std::uint32_t getUsedBytes(const std::uint8_t *regionData, std::uint32_t regionLen) const;
     bool getDataPtrForPartition(MediaPlaybackType playbackType, int id, std::uint8_t **ptr) const;
     const std::vector<Partition> *getPlaybackTypePartition(MediaPlaybackType playbackType) const;
     std::vector<Partition> *getPlaybackTypePartition(MediaPlaybackType playbackType);
+    bool isStreaming(int id, const MediaSourceType &mediaSourceType) const;
+    void closeDoorbells(int id);
+    bool startDoorbellThread();
+    void stopDoorbellThread();
+    void doorbellThreadLoop();
+    void wakeDoorbellThread() const;
 
 private:
+    // The sessions map, resize and look up their partitions from their own strands of the main thread.
+    // Recursive as the public methods use each other.
+    mutable std::recursive_mutex m_partitionsMutex;
     std::vector<Partition> m_genericPartitions;
     std::vector<Partition> m_webAudioPartitions;
+    std::uint32_t m_genericPoolLen;
     std::uint32_t m_dataBufferLen;
     int m_dataBufferFd;
     std::uint8_t *m_dataBuffer;
+    // The doorbell callbacks are called with the mutex held, so that none is running after the doorbell is closed
+    mutable std::mutex m_doorbellMutex;
+    std::map<std::pair<int, MediaSourceType>, Doorbell> m_doorbells;
+    int m_doorbellWakeFd;
+    bool m_isDoorbellThreadRunning;
+    std::thread m_doorbellThread;
 };
 } // namespace firebolt::rialto::server
 
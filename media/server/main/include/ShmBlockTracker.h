@@ -0,0 +1,110 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_SERVER_SHM_BLOCK_TRACKER_H_
+#define FIREBOLT_RIALTO_SERVER_SHM_BLOCK_TRACKER_H_
+
+#include "IShmBlockTracker.h"
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+namespace firebolt::rialto::server
+{
+class ShmBlockTracker : public IShmBlockTracker
+{
+public:
+    /**
+     * @brief The part of the media data area that can be written by the client.
+     */
+    struct WriteWindow
+    {
+        std::uint32_t offset; /**< The offset from the start of the media data area */
+        std::uint32_t length; /**< The number of bytes available */
+    };
+
+    /**
+     * @brief The constructor.
+     *
+     * @param[in] mediaData     : The start of the media data area of the region.
+     * @param[in] mediaDataLen  : The size of the media data area of the region.
+     */
+    ShmBlockTracker(const std::uint8_t *mediaData, std::uint32_t mediaDataLen);
+    ~ShmBlockTracker() override = default;
+
+    bool lend(const std::uint8_t *data, std::uint32_t size) override;
+    void release(const std::uint8_t *data) override;
+
+    /**
+     * @brief Selects the largest part of the media data area that is not lent to gstreamer.
+     *
+     * The selected window is kept until the next call, so that the data written by the client can be found.
+     *
+     * @retval the window the client can write to.
+     */
+    WriteWindow reserveWriteWindow();
+
+    /**
+     * @brief Gets the window selected by the last reserveWriteWindow() call.
+     *
+     * @retval the current write window.
+     */
+    WriteWindow getWriteWindow() const;
+
+    /**
+     * @brief Checks if gstreamer still holds any block of the media data area.
+     *
+     * @retval true if a block is lent.
+     */
+    bool hasLentBlocks() const;
+
+private:
+    /**
+     * @brief The start of the media data area.
+     */
+    const std::uint8_t *m_kMediaData;
+
+    /**
+     * @brief The size of the media data area.
+     */
+    const std::uint32_t m_kMediaDataLen;
+
+    /**
+     * @brief Mutex protecting the lent blocks, as they are released from the gstreamer streaming threads.
+     */
+    mutable std::mutex m_mutex;
+
+    /**
+     * @brief The lent blocks, ordered by their offset from the start of the media data area.
+     */
+    std::map<std::uint32_t, std::uint32_t> m_lentBlocks;
+
+    /**
+     * @brief The number of bytes currently lent.
+     */
+    std::uint32_t m_lentBytes;
+
+    /**
+     * @brief The window selected for the client.
+     */
+    WriteWindow m_writeWindow;
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_SHM_BLOCK_TRACKER_H_
@@ -0,0 +1,57 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_SERVER_SHM_REGION_SIZE_CALCULATOR_H_
+#define FIREBOLT_RIALTO_SERVER_SHM_REGION_SIZE_CALCULATOR_H_
+
+#include "IMediaPipeline.h"
+#include "ISharedMemoryBuffer.h"
+#include "MediaCommon.h"
+#include <cstdint>
+#include <map>
+
+namespace firebolt::rialto::server
+{
+/**
+ * @brief Chooses the sizes of the shm regions of a playback from the caps of its attached sources.
+ *
+ * The caps do not carry a bitrate, so the codec, the resolution and the number of audio channels are used
+ * as the hints.
+ */
+class ShmRegionSizeCalculator
+{
+public:
+    ShmRegionSizeCalculator() = default;
+    ~ShmRegionSizeCalculator() = default;
+
+    void addSource(const IMediaPipeline::MediaSource &source);
+    /**
+     * @brief Grows the video region for the resolution of a video segment, as adaptive streams change resolution
+     *        without switching the source. The region is never shrunk here, so it does not follow every switch down.
+     */
+    void addVideoResolution(std::int32_t width, std::int32_t height);
+    void removeSource(MediaSourceType mediaSourceType);
+    ISharedMemoryBuffer::PartitionSizes getPartitionSizes() const;
+
+private:
+    std::map<MediaSourceType, std::uint32_t> m_regionSizes;
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_SHM_REGION_SIZE_CALCULATOR_H_
@@ -0,0 +1,89 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef FIREBOLT_RIALTO_SERVER_SHM_RING_READER_H_
+#define FIREBOLT_RIALTO_SERVER_SHM_RING_READER_H_
+
+#include "IShmRingReader.h"
+#include "ShmRing.h"
+#include <atomic>
+#include <cstdint>
+
+namespace firebolt::rialto::server
+{
+/**
+ * @brief Reads the V2 frames, which a client writes to the ring of a source in streaming mode.
+ */
+class ShmRingReader : public IShmRingReader
+{
+public:
+    /**
+     * @brief The constructor.
+     *
+     * @param[in] mediaSourceType : The type of the source, which writes to the ring.
+     * @param[in] ring            : The start of the ring, formatted by the shared memory buffer.
+     * @param[in] capacity        : The capacity of the ring.
+     *
+     * @throws std::runtime_error if the memory does not hold a ring.
+     */
+    ShmRingReader(const MediaSourceType &mediaSourceType, std::uint8_t *ring, std::uint32_t capacity);
+    ~ShmRingReader() override = default;
+
+    MediaSourceType getType() const override;
+    Status read(MediaSegmentBatch &batch) override;
+    void consume() override;
+    bool waitForDoorbell() override;
+
+    /**
+     * @brief Starts or finishes a flush of the source.
+     *
+     * Nothing is read while the source is flushed. The records written by the client before the flush are dropped,
+     * as they belong to an older generation.
+     *
+     * Can be called from any thread.
+     *
+     * @param[in] isFlushing : Whether the flush starts.
+     */
+    void setFlushing(bool isFlushing);
+
+private:
+    /**
+     * @brief The type of the source.
+     */
+    const MediaSourceType m_kMediaSourceType;
+
+    /**
+     * @brief The consumer side of the ring.
+     */
+    ipc::ShmRing m_ring;
+
+    /**
+     * @brief The flush generation of the records that are read.
+     */
+    std::atomic<std::uint64_t> m_generation{0};
+
+    /**
+     * @brief Whether the source is being flushed.
+     */
+    std::atomic<bool> m_isFlushing{false};
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_SHM_RING_READER_H_
@@ -27,13 +27,15 @@ namespace firebolt::rialto::server
 {
 constexpr std::uint32_t kPrerollNumFrames{3};
 constexpr std::uint32_t kMaxFrames{24};
+// Metadata V2 and V3 store the frame metadata in the media data region, so more frames can be requested
+constexpr std::uint32_t kMaxFramesWithInlineMetadata{96};
 constexpr std::uint32_t getMaxMetadataBytes()
 {
     // The Rialto Server must size the metadata regions to be at least the following size:
     // 4 bytes version + max_frames_to_request * (maximum metadata struct size for stream type &
     //                                            supported metadata format versions)
 
-    // Metadata V2 contains version only, so maximum metadata size is size of MetadataV1
+    // Metadata V2 and V3 contain the version and the region header only, so maximum metadata size is size of MetadataV1
     std::uint32_t maxMetadataStructSize = common::METADATA_V1_SIZE_PER_FRAME_BYTES;
     return common::VERSION_SIZE_BYTES + kMaxFrames * maxMetadataStructSize;
 }
@@ -21,6 +21,8 @@
 #define FIREBOLT_RIALTO_SERVER_I_DATA_READER_H_
 
 #include "IMediaPipeline.h"
+#include "MediaSegmentBatch.h"
+#include <cstdint>
 
 namespace firebolt::rialto::server
 {
@@ -29,7 +31,10 @@ class IDataReader
 public:
     virtual ~IDataReader() = default;
     virtual IMediaPipeline::MediaSegmentVector readData() const = 0;
+    virtual void readSegments(MediaSegmentBatch &batch) const = 0;
     virtual bool isBufferFull() const = 0;
+    virtual std::uint32_t getMetadataVersion() const = 0;
+    virtual std::uint32_t getDataLength() const = 0;
 };
 } // namespace firebolt::rialto::server
 
@@ -71,7 +71,9 @@ public:
     /**
      * @brief Register a client on the main thread.
      *
-     * Required by clients who want to enqueue tasks on the main thread.
+     * Required by clients who want to enqueue tasks on the main thread. The tasks of a client run in order and never
+     * at the same time, but may run alongside the tasks of other clients. A client registered from within a task
+     * shares the ordering of that task's client, as an object created by another usually shares its state.
      *
      * @retval The registered client id.
      */
@@ -80,8 +82,8 @@ public:
     /**
      * @brief Unregister a client on the main thread.
      *
-     * Should be called on the main thread.
-     * After been called the client will no longer be able to enqueue tasks.
+     * Should be called from a task of the client.
+     * After been called the client will no longer be able to enqueue tasks, and its queued tasks are dropped.
      *
      * @param[in]  clientId : The id of the registered client.
      */
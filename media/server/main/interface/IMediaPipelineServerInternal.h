@@ -99,6 +99,34 @@ public:
      */
     virtual bool haveData(MediaSourceStatus status, uint32_t numFrames, uint32_t needDataRequestId) = 0;
 
+    /**
+     * @brief Returns data requested by several notifyNeedMediaData() calls at once.
+     *
+     * This is a server only implementation. The samples of all requests are attached
+     * to gstreamer by a single task.
+     *
+     * @param[in]  haveDataInfos : The status, number of frames and request id of each request
+     * @param[out] results       : Whether each request succeeded, in the order of haveDataInfos
+     *
+     * @retval true if the requests were processed, false if none could be.
+     */
+    virtual bool haveDataMulti(const std::vector<HaveDataInfo> &haveDataInfos, std::vector<bool> &results) = 0;
+
+    /**
+     * @brief Switches a source to streaming mode.
+     *
+     * This is a server only implementation. The media region of the source is formatted as a ring, which the client
+     * writes frames to as soon as there is space. The worker thread drains the ring whenever gstreamer needs data
+     * or the client rings the doorbell, and no NeedMediaData is sent for the source anymore.
+     * Fails while media data of the source is outstanding.
+     *
+     * @param[in]  sourceId : The source id. Value should be set to the MediaSource.id returned after attachSource()
+     * @param[out] ring     : The ring and its doorbell.
+     *
+     * @retval true on success.
+     */
+    virtual bool enableStreamingRing(int32_t sourceId, ISharedMemoryBuffer::StreamingRing &ring) = 0;
+
     /**
      * @brief Checks if MediaPipeline threads are not deadlocked
      *
@@ -21,7 +21,9 @@
 #define FIREBOLT_RIALTO_SERVER_I_SHARED_MEMORY_BUFFER_H_
 
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "MediaCommon.h"
 
@@ -59,6 +61,36 @@ public:
         WEB_AUDIO
     };
 
+    /**
+     * @brief The sizes of the media regions of a partition.
+     */
+    struct PartitionSizes
+    {
+        std::uint32_t videoLen;    /**< The size of the video region, 0 if there is no video. */
+        std::uint32_t audioLen;    /**< The size of the audio region, 0 if there is no audio. */
+        std::uint32_t subtitleLen; /**< The size of the subtitle region, 0 if there are no subtitles. */
+    };
+
+    /**
+     * @brief The memory reserved and used by a mapped partition.
+     */
+    struct PartitionUsage
+    {
+        int id;                      /**< The id of the partition. */
+        std::uint32_t reservedBytes; /**< The number of bytes reserved for all the media regions. */
+        std::uint32_t usedBytes;     /**< The number of bytes currently holding data written by the client. */
+    };
+
+    /**
+     * @brief The ring of a media region in streaming mode.
+     */
+    struct StreamingRing
+    {
+        int doorbellFd;         /**< The eventfd the client writes to, when the consumer waits for data. */
+        std::uint32_t offset;   /**< The offset of the ring from the start of the shared memory. */
+        std::uint32_t capacity; /**< The capacity of the ring, which the client attaches with. */
+    };
+
     /**
      * @brief Maps the partition for playback.
      *
@@ -79,9 +111,35 @@ public:
      */
     virtual bool unmapPartition(MediaPlaybackType playbackType, int id) = 0;
 
+    /**
+     * @brief Changes the sizes of the media regions of a mapped partition.
+     *
+     * Must only be called when no media data is outstanding for the partition, as its regions may be moved.
+     * The partition keeps its previous sizes, if the new ones do not fit into the free memory.
+     *
+     * @param[in] playbackType  : The type of playback partition. Only GENERIC partitions can be resized.
+     * @param[in] id            : The id for the partition of playbackType.
+     * @param[in] sizes         : The new sizes of the media regions.
+     *
+     * @retval true on success.
+     */
+    virtual bool resizePartition(MediaPlaybackType playbackType, int id, const PartitionSizes &sizes) = 0;
+
+    /**
+     * @brief Gets the memory reserved and used by each mapped partition.
+     *
+     * @param[in] playbackType  : The type of playback partition.
+     *
+     * @retval the usage of the mapped partitions.
+     */
+    virtual std::vector<PartitionUsage> getPartitionUsage(MediaPlaybackType playbackType) const = 0;
+
     /**
      * @brief Clears the data in the specified partition.
      *
+     * Media regions of generic playbacks are invalidated by publishing a new generation in the region header,
+     * rather than by zeroing the whole region.
+     *
      * @param[in] playbackType      : The type of playback partition.
      * @param[in] id                : The id for the partition of playbackType.
      * @param[in] mediaSourceType   : The type of media source partition.
@@ -90,6 +148,53 @@ public:
      */
     virtual bool clearData(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType) const = 0;
 
+    /**
+     * @brief Clears the data in a part of the media region of a generic playback, which is requested separately.
+     *
+     * A new generation is published in the header at the start of the part.
+     *
+     * @param[in] playbackType      : The type of playback partition.
+     * @param[in] id                : The id for the partition of playbackType.
+     * @param[in] mediaSourceType   : The type of media source partition.
+     * @param[in] offset            : The offset of the part from the start of the media region.
+     *
+     * @retval true on success.
+     */
+    virtual bool clearData(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType,
+                           std::uint32_t offset) const = 0;
+
+    /**
+     * @brief Formats the media region of a generic playback as a single producer / single consumer ring.
+     *
+     * In streaming mode the client writes frames into the ring as soon as there is space, instead of waiting for
+     * NeedMediaData. The region is not cleared while it is in streaming mode.
+     *
+     * @param[in]  playbackType      : The type of playback partition. Only GENERIC partitions can be streamed.
+     * @param[in]  id                : The id for the partition of playbackType.
+     * @param[in]  mediaSourceType   : The type of media source partition.
+     * @param[in]  doorbellCallback  : Called from the doorbell thread, when the client rings the doorbell. It must not
+     *                                 use the buffer.
+     * @param[out] ring              : The ring and its doorbell.
+     *
+     * @retval true on success.
+     */
+    virtual bool enableStreamingMode(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType,
+                                     std::function<void()> &&doorbellCallback, StreamingRing &ring) = 0;
+
+    /**
+     * @brief Stops using the media region as a ring and closes its doorbell.
+     *
+     * The doorbell callback is not called anymore, once this returns.
+     *
+     * @param[in] playbackType      : The type of playback partition.
+     * @param[in] id                : The id for the partition of playbackType.
+     * @param[in] mediaSourceType   : The type of media source partition.
+     *
+     * @retval true on success.
+     */
+    virtual bool disableStreamingMode(MediaPlaybackType playbackType, int id,
+                                      const MediaSourceType &mediaSourceType) = 0;
+
     /**
      * @brief Gets the offset of the specified data partition.
      *
@@ -0,0 +1,68 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_SERVER_I_SHM_BLOCK_TRACKER_H_
+#define FIREBOLT_RIALTO_SERVER_I_SHM_BLOCK_TRACKER_H_
+
+#include <cstdint>
+
+/**
+ * @file IShmBlockTracker.h
+ *
+ * The definition of the IShmBlockTracker interface.
+ *
+ * This interface defines the tracking of shared memory blocks that are lent to gstreamer without copying,
+ * so that they are not handed back to the client until downstream elements release them.
+ *
+ */
+
+namespace firebolt::rialto::server
+{
+class IShmBlockTracker
+{
+public:
+    IShmBlockTracker() = default;
+    IShmBlockTracker(const IShmBlockTracker &) = delete;
+    IShmBlockTracker(IShmBlockTracker &&) = delete;
+    IShmBlockTracker &operator=(const IShmBlockTracker &) = delete;
+    IShmBlockTracker &operator=(IShmBlockTracker &&) = delete;
+    virtual ~IShmBlockTracker() = default;
+
+    /**
+     * @brief Lends the block of shared memory to gstreamer.
+     *
+     * @param[in] data : The start of the block.
+     * @param[in] size : The size of the block.
+     *
+     * @retval true if the block can be used without copying, false if it has to be copied.
+     */
+    virtual bool lend(const std::uint8_t *data, std::uint32_t size) = 0;
+
+    /**
+     * @brief Returns the block of shared memory lent to gstreamer.
+     *
+     * Can be called from any thread.
+     *
+     * @param[in] data : The start of the block.
+     */
+    virtual void release(const std::uint8_t *data) = 0;
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_I_SHM_BLOCK_TRACKER_H_
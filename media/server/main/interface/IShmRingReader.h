@@ -0,0 +1,91 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef FIREBOLT_RIALTO_SERVER_I_SHM_RING_READER_H_
+#define FIREBOLT_RIALTO_SERVER_I_SHM_RING_READER_H_
+
+#include "MediaCommon.h"
+#include "MediaSegmentBatch.h"
+
+/**
+ * @file IShmRingReader.h
+ *
+ * The definition of the IShmRingReader interface.
+ *
+ * This interface defines the reading of the frames a client writes to the ring of a source in streaming mode.
+ * The reader is only used by the gstreamer worker thread.
+ *
+ */
+
+namespace firebolt::rialto::server
+{
+class IShmRingReader
+{
+public:
+    /**
+     * @brief The result of reading the ring.
+     */
+    enum class Status
+    {
+        EMPTY,        /**< There is no frame to read. */
+        FRAME,        /**< A frame was read. */
+        END_OF_STREAM /**< The client has written all the frames of the source. */
+    };
+
+    IShmRingReader() = default;
+    IShmRingReader(const IShmRingReader &) = delete;
+    IShmRingReader(IShmRingReader &&) = delete;
+    IShmRingReader &operator=(const IShmRingReader &) = delete;
+    IShmRingReader &operator=(IShmRingReader &&) = delete;
+    virtual ~IShmRingReader() = default;
+
+    /**
+     * @brief Gets the type of the source, which writes to the ring.
+     *
+     * @retval the media source type.
+     */
+    virtual MediaSourceType getType() const = 0;
+
+    /**
+     * @brief Reads the next record of the ring, without removing it.
+     *
+     * The views added to the batch point into the ring, so they are only valid until consume() is called.
+     *
+     * @param[out] batch : The batch the frame is added to.
+     *
+     * @retval the status of the ring.
+     */
+    virtual Status read(MediaSegmentBatch &batch) = 0;
+
+    /**
+     * @brief Removes the record last read from the ring, so that the client can reuse its space.
+     */
+    virtual void consume() = 0;
+
+    /**
+     * @brief Asks the client to ring the doorbell, when it writes the next record.
+     *
+     * @retval true if there is something to read already, in which case the doorbell may not be rung.
+     */
+    virtual bool waitForDoorbell() = 0;
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_I_SHM_RING_READER_H_
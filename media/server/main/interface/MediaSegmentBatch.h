@@ -0,0 +1,232 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_SERVER_MEDIA_SEGMENT_BATCH_H_
+#define FIREBOLT_RIALTO_SERVER_MEDIA_SEGMENT_BATCH_H_
+
+#include "IMediaPipeline.h"
+#include "MediaCommon.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <vector>
+
+/**
+ * @file MediaSegmentBatch.h
+ *
+ * The definition of the media segment views and of the batch that stores them.
+ *
+ * A view describes a single frame without owning any of its bytes, so that a frame read from the shared
+ * memory can be handed to gstreamer without allocating a MediaSegment for it. The batch is reused for
+ * every NeedMediaData cycle, so once it has grown to the size of the largest request, reading a request
+ * does not touch the heap.
+ *
+ */
+
+namespace firebolt::rialto::server
+{
+/**
+ * @brief A non owning view of a range of bytes.
+ */
+struct ByteSpan
+{
+    const std::uint8_t *data{nullptr}; /**< The first byte of the range */
+    std::size_t size{0};               /**< The number of bytes in the range */
+
+    bool empty() const { return size == 0; }
+};
+
+/**
+ * @brief A non owning view of the subsamples of an encrypted frame.
+ *
+ * The subsamples are either the SubSamplePairs of a MediaSegment or the packed pairs of native uint32 values
+ * written by the metadata V3 frame writer.
+ */
+class SubSampleSpan
+{
+public:
+    SubSampleSpan() = default;
+
+    /**
+     * @brief Creates a view of the subsamples stored in a MediaSegment.
+     *
+     * @param[in] subSamples : The subsamples. Must outlive the view.
+     */
+    explicit SubSampleSpan(const std::vector<SubSamplePair> &subSamples)
+        : m_pairs{subSamples.data()}, m_size{subSamples.size()}
+    {
+    }
+
+    /**
+     * @brief Creates a view of packed uint32 (clear, encrypted) pairs.
+     *
+     * @param[in] packed : The first pair. Does not have to be aligned.
+     * @param[in] size   : The number of pairs.
+     */
+    SubSampleSpan(const std::uint8_t *packed, std::size_t size) : m_packed{packed}, m_size{size} {}
+
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    SubSamplePair operator[](std::size_t index) const
+    {
+        if (m_pairs)
+        {
+            return m_pairs[index];
+        }
+        std::uint32_t pair[2];
+        std::memcpy(pair, m_packed + index * sizeof(pair), sizeof(pair));
+        return SubSamplePair{pair[0], pair[1]};
+    }
+
+private:
+    const SubSamplePair *m_pairs{nullptr};
+    const std::uint8_t *m_packed{nullptr};
+    std::size_t m_size{0};
+};
+
+/**
+ * @brief A lightweight description of a single media frame.
+ *
+ * The byte ranges point either into the shared memory region of the request or into a MediaSegment kept alive
+ * by the batch, so a view is only valid until the batch is cleared or the shared memory is handed back to the client.
+ */
+struct MediaSegmentView
+{
+    MediaSourceType type{MediaSourceType::UNKNOWN};
+    int32_t sourceId{0};
+    int64_t timeStamp{0};
+    int64_t duration{0};
+    ByteSpan data;
+    SegmentAlignment segmentAlignment{SegmentAlignment::UNDEFINED};
+    std::optional<uint64_t> displayOffset;
+    ByteSpan extraData;
+    std::shared_ptr<CodecData> codecData;
+
+    // Audio only
+    int32_t sampleRate{0};
+    int32_t numberOfChannels{0};
+    uint64_t clippingStart{0};
+    uint64_t clippingEnd{0};
+
+    // Video only
+    int32_t width{kUndefinedSize};
+    int32_t height{kUndefinedSize};
+    Fraction frameRate{kUndefinedSize, kUndefinedSize};
+
+    // Encrypted frames only
+    bool isEncrypted{false};
+    int32_t mediaKeySessionId{0};
+    ByteSpan keyId;
+    ByteSpan initVector;
+    uint32_t initWithLast15{0};
+    CipherMode cipherMode{CipherMode::UNKNOWN};
+    bool encryptionPatternSet{false};
+    uint32_t crypt{0};
+    uint32_t skip{0};
+    SubSampleSpan subSamples;
+};
+
+/**
+ * @brief Creates a view of a MediaSegment.
+ *
+ * @param[in] segment : The segment. Must outlive the view.
+ *
+ * @retval the view.
+ */
+MediaSegmentView makeMediaSegmentView(const IMediaPipeline::MediaSegment &segment);
+
+/**
+ * @brief The frames read for a single NeedMediaData request.
+ *
+ * Clearing the batch keeps the storage of the views, so a batch should be reused across requests.
+ */
+class MediaSegmentBatch
+{
+public:
+    using const_iterator = std::vector<MediaSegmentView>::const_iterator;
+
+    MediaSegmentBatch() = default;
+    MediaSegmentBatch(const MediaSegmentBatch &) = delete;
+    MediaSegmentBatch &operator=(const MediaSegmentBatch &) = delete;
+    ~MediaSegmentBatch() = default;
+
+    /**
+     * @brief Drops all the frames, keeping the allocated storage.
+     */
+    void clear();
+
+    /**
+     * @brief Appends an empty view to the batch.
+     *
+     * @retval the view to fill in. Valid until the next call to addSegment or clear.
+     */
+    MediaSegmentView &addSegment();
+
+    /**
+     * @brief Appends views of the segments to the batch, which keeps the segments alive until it is cleared.
+     *
+     * Used by the readers that still create a MediaSegment for every frame.
+     *
+     * @param[in] segments : The segments.
+     */
+    void addSegments(IMediaPipeline::MediaSegmentVector &&segments);
+
+    /**
+     * @brief Gets the codec data for the frame of the given source type.
+     *
+     * Codec data rarely changes between frames, so the previous instance is returned as long as the bytes match.
+     *
+     * @param[in] sourceType : The source type of the frame.
+     * @param[in] type       : The codec data type.
+     * @param[in] bytes      : The codec data.
+     *
+     * @retval the codec data.
+     */
+    const std::shared_ptr<CodecData> &getCodecData(MediaSourceType sourceType, CodecDataType type, ByteSpan bytes);
+
+    bool empty() const { return m_views.empty(); }
+    std::size_t size() const { return m_views.size(); }
+    const MediaSegmentView &front() const { return m_views.front(); }
+    const MediaSegmentView &back() const { return m_views.back(); }
+    const_iterator begin() const { return m_views.begin(); }
+    const_iterator end() const { return m_views.end(); }
+
+private:
+    /**
+     * @brief The views of the frames in the batch.
+     */
+    std::vector<MediaSegmentView> m_views;
+
+    /**
+     * @brief The segments referred to by the views, if the reader created any.
+     */
+    IMediaPipeline::MediaSegmentVector m_ownedSegments;
+
+    /**
+     * @brief The last codec data of each source type.
+     */
+    std::array<std::shared_ptr<CodecData>, static_cast<std::size_t>(MediaSourceType::SUBTITLE) + 1> m_codecData;
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_MEDIA_SEGMENT_BATCH_H_
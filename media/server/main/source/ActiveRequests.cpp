@@ -122,6 +122,12 @@ void ActiveRequests::clear()
     m_requestMap.clear();
 }
 
+bool ActiveRequests::isEmpty() const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return m_requestMap.empty();
+}
+
 AddSegmentStatus ActiveRequests::addSegment(std::uint32_t requestId,
                                             const std::unique_ptr<IMediaPipeline::MediaSegment> &segment)
 {
@@ -20,8 +20,14 @@
 #include "DataReaderFactory.h"
 #include "DataReaderV1.h"
 #include "DataReaderV2.h"
+#include "DataReaderV3.h"
+#include "RialtoServerLogging.h"
 #include "ShmCommon.h"
 #include "ShmUtils.h"
+#include "TypeConverters.h"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
 
 namespace
 {
@@ -36,21 +42,54 @@ namespace firebolt::rialto::server
 {
 std::shared_ptr<IDataReader> DataReaderFactory::createDataReader(const MediaSourceType &mediaSourceType,
                                                                  std::uint8_t *buffer, std::uint32_t dataOffset,
-                                                                 std::uint32_t numFrames, bool isBufferFull) const
+                                                                 std::uint32_t mediaDataOffset, std::uint32_t numFrames,
+                                                                 bool isBufferFull) const
 {
     // Version is always first 4 bytes of data
     std::uint8_t *metadata = buffer + dataOffset;
     std::uint32_t version = readLEUint32(metadata);
     if (1 == version)
     {
+        // Never read more metadata than fits in the metadata region
+        constexpr std::uint32_t kMaxV1Frames{(getMaxMetadataBytes() - common::VERSION_SIZE_BYTES) /
+                                             common::METADATA_V1_SIZE_PER_FRAME_BYTES};
         std::uint32_t metadataOffsetWithoutVersion = dataOffset + common::VERSION_SIZE_BYTES;
-        return std::make_shared<DataReaderV1>(mediaSourceType, buffer, metadataOffsetWithoutVersion, numFrames,
-                                              isBufferFull);
+        return std::make_shared<DataReaderV1>(mediaSourceType, buffer, metadataOffsetWithoutVersion,
+                                              std::min(numFrames, kMaxV1Frames), isBufferFull);
     }
-    if (2 == version)
+    if (2 == version || 3 == version)
     {
-        std::uint32_t v2DataOffset = dataOffset + getMaxMetadataBytes();
-        return std::make_shared<DataReaderV2>(mediaSourceType, buffer, v2DataOffset, numFrames, isBufferFull);
+        std::uint32_t dataLength{std::numeric_limits<std::uint32_t>::max()};
+        std::uint8_t *header = metadata + common::SHM_REGION_HEADER_OFFSET;
+        if (common::SHM_REGION_HEADER_MAGIC == readLEUint32(header + offsetof(common::ShmRegionHeader, magic)))
+        {
+            // Only trust data committed by the writer for the currently published generation
+            const std::uint32_t kGeneration{readLEUint32(header + offsetof(common::ShmRegionHeader, generation))};
+            const std::uint32_t kCommittedGeneration{
+                readLEUint32(header + offsetof(common::ShmRegionHeader, committedGeneration))};
+            const std::uint32_t kCommittedFrames{readLEUint32(header + offsetof(common::ShmRegionHeader, numFrames))};
+            dataLength = readLEUint32(header + offsetof(common::ShmRegionHeader, validLength));
+            if (kGeneration != kCommittedGeneration)
+            {
+                RIALTO_SERVER_LOG_WARN("Discarding %s data written for stale generation %u, current generation: %u",
+                                       common::convertMediaSourceType(mediaSourceType), kCommittedGeneration,
+                                       kGeneration);
+                numFrames = 0;
+            }
+            else if (kCommittedFrames < numFrames)
+            {
+                RIALTO_SERVER_LOG_WARN("Only %u of %u %s frames have been committed", kCommittedFrames, numFrames,
+                                       common::convertMediaSourceType(mediaSourceType));
+                numFrames = kCommittedFrames;
+            }
+        }
+        if (3 == version)
+        {
+            return std::make_shared<DataReaderV3>(mediaSourceType, buffer, mediaDataOffset, numFrames, dataLength,
+                                                  isBufferFull);
+        }
+        return std::make_shared<DataReaderV2>(mediaSourceType, buffer, mediaDataOffset, numFrames, dataLength,
+                                              isBufferFull);
     }
     return nullptr;
 }
@@ -54,11 +54,27 @@ IMediaPipeline::MediaSegmentVector DataReaderV1::readData() const
     return mediaSegments;
 }
 
+void DataReaderV1::readSegments(MediaSegmentBatch &batch) const
+{
+    batch.addSegments(readData());
+}
+
 bool DataReaderV1::isBufferFull() const
 {
     return m_isBufferFull;
 }
 
+std::uint32_t DataReaderV1::getMetadataVersion() const
+{
+    return 1;
+}
+
+std::uint32_t DataReaderV1::getDataLength() const
+{
+    // The lengths are only stored in the metadata of each frame
+    return 0;
+}
+
 std::vector<DataReaderV1::MetadataV1> DataReaderV1::readMetadata() const
 {
     std::vector<DataReaderV1::MetadataV1> result;
@@ -22,6 +22,7 @@
 #include "ShmCommon.h"
 #include "TypeConverters.h"
 #include "metadata.pb.h"
+#include <limits>
 
 namespace
 {
@@ -203,9 +204,9 @@ createSegment(const firebolt::rialto::MediaSegmentMetadata &metadata, const fire
 namespace firebolt::rialto::server
 {
 DataReaderV2::DataReaderV2(const MediaSourceType &mediaSourceType, std::uint8_t *buffer, std::uint32_t dataOffset,
-                           std::uint32_t numFrames, bool isBufferFull)
+                           std::uint32_t numFrames, std::uint32_t dataLength, bool isBufferFull)
     : m_mediaSourceType{mediaSourceType}, m_buffer{buffer}, m_dataOffset{dataOffset}, m_numFrames{numFrames},
-      m_isBufferFull{isBufferFull}
+      m_dataLength{dataLength}, m_isBufferFull{isBufferFull}
 {
     RIALTO_SERVER_LOG_DEBUG("Detected Metadata in Version 2. Media source type: %s",
                             common::convertMediaSourceType(m_mediaSourceType));
@@ -215,10 +216,22 @@ IMediaPipeline::MediaSegmentVector DataReaderV2::readData() const
 {
     IMediaPipeline::MediaSegmentVector mediaSegments;
     uint8_t *currentReadPosition{m_buffer + m_dataOffset};
+    std::uint32_t bytesLeft{m_dataLength};
     for (auto i = 0U; i < m_numFrames; ++i)
     {
+        if (bytesLeft < sizeof(uint32_t))
+        {
+            RIALTO_SERVER_LOG_ERROR("Metadata size exceeds the valid data length!");
+            return IMediaPipeline::MediaSegmentVector{};
+        }
         std::uint32_t *metadataSize{reinterpret_cast<uint32_t *>(currentReadPosition)};
         currentReadPosition += sizeof(uint32_t);
+        bytesLeft -= sizeof(uint32_t);
+        if (bytesLeft < *metadataSize)
+        {
+            RIALTO_SERVER_LOG_ERROR("Metadata exceeds the valid data length!");
+            return IMediaPipeline::MediaSegmentVector{};
+        }
         MediaSegmentMetadata metadata;
         if (!metadata.ParseFromArray(currentReadPosition, *metadataSize))
         {
@@ -232,15 +245,38 @@ IMediaPipeline::MediaSegmentVector DataReaderV2::readData() const
             return IMediaPipeline::MediaSegmentVector{};
         }
         currentReadPosition += *metadataSize;
+        bytesLeft -= *metadataSize;
+        if (bytesLeft < metadata.length())
+        {
+            RIALTO_SERVER_LOG_ERROR("Segment data exceeds the valid data length!");
+            return IMediaPipeline::MediaSegmentVector{};
+        }
         newSegment->setData(metadata.length(), currentReadPosition);
         currentReadPosition += metadata.length();
+        bytesLeft -= metadata.length();
         mediaSegments.emplace_back(std::move(newSegment));
     }
     return mediaSegments;
 }
 
+void DataReaderV2::readSegments(MediaSegmentBatch &batch) const
+{
+    batch.addSegments(readData());
+}
+
 bool DataReaderV2::isBufferFull() const
 {
     return m_isBufferFull;
 }
+
+std::uint32_t DataReaderV2::getMetadataVersion() const
+{
+    return 2;
+}
+
+std::uint32_t DataReaderV2::getDataLength() const
+{
+    // Without a region header the length of the data is not known
+    return std::numeric_limits<std::uint32_t>::max() == m_dataLength ? 0 : m_dataLength;
+}
 } // namespace firebolt::rialto::server
@@ -0,0 +1,340 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataReaderV3.h"
+#include "RialtoServerLogging.h"
+#include "ShmCommon.h"
+#include "TypeConverters.h"
+#include <cstring>
+#include <limits>
+
+namespace
+{
+std::uint64_t alignFrameSize(std::uint64_t size)
+{
+    return (size + firebolt::rialto::common::MEDIA_FRAME_V3_ALIGNMENT - 1) &
+           ~static_cast<std::uint64_t>(firebolt::rialto::common::MEDIA_FRAME_V3_ALIGNMENT - 1);
+}
+
+bool isValidHeader(const firebolt::rialto::common::MediaFrameHeaderV3 &header)
+{
+    if (header.headerSize < sizeof(firebolt::rialto::common::MediaFrameHeaderV3) ||
+        header.headerSize % firebolt::rialto::common::MEDIA_FRAME_V3_ALIGNMENT != 0)
+    {
+        RIALTO_SERVER_LOG_ERROR("Invalid frame header size: %u", header.headerSize);
+        return false;
+    }
+    const std::uint64_t kExpectedTailLength{static_cast<std::uint64_t>(header.numSubSamples) *
+                                                firebolt::rialto::common::MEDIA_FRAME_V3_SUBSAMPLE_SIZE_BYTES +
+                                            header.keyIdLength + header.initVectorLength + header.extraDataLength +
+                                            header.codecDataLength};
+    if (kExpectedTailLength != header.tailLength)
+    {
+        RIALTO_SERVER_LOG_ERROR("Frame tail length %u does not match its fields", header.tailLength);
+        return false;
+    }
+    if (header.segmentAlignment > static_cast<std::uint8_t>(firebolt::rialto::SegmentAlignment::AU) ||
+        header.cipherMode > static_cast<std::uint8_t>(firebolt::rialto::CipherMode::CBCS) ||
+        header.codecDataType > static_cast<std::uint8_t>(firebolt::rialto::CodecDataType::STRING))
+    {
+        RIALTO_SERVER_LOG_ERROR("Unknown enumeration value in frame header");
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment>
+createSegment(const firebolt::rialto::common::MediaFrameHeaderV3 &header, const std::uint8_t *tail,
+              const firebolt::rialto::MediaSourceType &type)
+{
+    if (static_cast<std::uint8_t>(type) != header.sourceType)
+    {
+        RIALTO_SERVER_LOG_ERROR("Frame of type %u read from the %s region", header.sourceType,
+                                firebolt::rialto::common::convertMediaSourceType(type));
+        return nullptr;
+    }
+
+    // Create segment
+    std::unique_ptr<firebolt::rialto::IMediaPipeline::MediaSegment> segment;
+    if (type == firebolt::rialto::MediaSourceType::AUDIO)
+    {
+        segment = std::make_unique<firebolt::rialto::IMediaPipeline::MediaSegmentAudio>(header.streamId,
+                                                                                        header.timePosition,
+                                                                                        header.sampleDuration,
+                                                                                        header.sampleRate,
+                                                                                        header.channelsNum,
+                                                                                        header.clippingStart,
+                                                                                        header.clippingEnd);
+    }
+    else if (type == firebolt::rialto::MediaSourceType::VIDEO)
+    {
+        const firebolt::rialto::Fraction kFrameRate{header.frameRateNumerator, header.frameRateDenominator};
+        segment = std::make_unique<firebolt::rialto::IMediaPipeline::MediaSegmentVideo>(header.streamId,
+                                                                                        header.timePosition,
+                                                                                        header.sampleDuration,
+                                                                                        header.width, header.height,
+                                                                                        kFrameRate);
+    }
+    else if (type == firebolt::rialto::MediaSourceType::SUBTITLE)
+    {
+        segment =
+            std::make_unique<firebolt::rialto::IMediaPipeline::MediaSegment>(header.streamId,
+                                                                             firebolt::rialto::MediaSourceType::SUBTITLE,
+                                                                             header.timePosition,
+                                                                             header.sampleDuration);
+    }
+    else
+    {
+        RIALTO_SERVER_LOG_ERROR("Unknown segment type");
+        return nullptr;
+    }
+
+    // Read optional data
+    segment->setSegmentAlignment(static_cast<firebolt::rialto::SegmentAlignment>(header.segmentAlignment));
+    if (header.flags & firebolt::rialto::common::MEDIA_FRAME_V3_FLAG_HAS_DISPLAY_OFFSET)
+    {
+        segment->setDisplayOffset(header.displayOffset);
+    }
+
+    // Read the tail in the order in which it was written
+    if (header.flags & firebolt::rialto::common::MEDIA_FRAME_V3_FLAG_ENCRYPTED)
+    {
+        segment->setEncrypted(true);
+        segment->setMediaKeySessionId(header.mediaKeySessionId);
+        segment->setInitWithLast15(header.initWithLast15);
+        segment->setCipherMode(static_cast<firebolt::rialto::CipherMode>(header.cipherMode));
+        if (header.flags & firebolt::rialto::common::MEDIA_FRAME_V3_FLAG_HAS_ENCRYPTION_PATTERN)
+        {
+            segment->setEncryptionPattern(header.crypt, header.skip);
+        }
+        for (std::uint16_t i = 0; i < header.numSubSamples; ++i)
+        {
+            std::uint32_t subSample[2];
+            std::memcpy(subSample, tail, sizeof(subSample));
+            tail += sizeof(subSample);
+            segment->addSubSample(subSample[0], subSample[1]);
+        }
+        segment->setKeyId(std::vector<std::uint8_t>(tail, tail + header.keyIdLength));
+        tail += header.keyIdLength;
+        segment->setInitVector(std::vector<std::uint8_t>(tail, tail + header.initVectorLength));
+        tail += header.initVectorLength;
+    }
+    else
+    {
+        segment->setEncrypted(false);
+    }
+    if (header.extraDataLength > 0)
+    {
+        segment->setExtraData(std::vector<std::uint8_t>(tail, tail + header.extraDataLength));
+        tail += header.extraDataLength;
+    }
+    if (header.flags & firebolt::rialto::common::MEDIA_FRAME_V3_FLAG_HAS_CODEC_DATA)
+    {
+        auto codecData = std::make_shared<firebolt::rialto::CodecData>();
+        codecData->type = static_cast<firebolt::rialto::CodecDataType>(header.codecDataType);
+        codecData->data = std::vector<std::uint8_t>(tail, tail + header.codecDataLength);
+        segment->setCodecData(codecData);
+    }
+    return segment;
+}
+
+bool fillView(const firebolt::rialto::common::MediaFrameHeaderV3 &header, const std::uint8_t *tail,
+              const firebolt::rialto::MediaSourceType &type, firebolt::rialto::server::MediaSegmentBatch &batch,
+              firebolt::rialto::server::MediaSegmentView &view)
+{
+    if (static_cast<std::uint8_t>(type) != header.sourceType)
+    {
+        RIALTO_SERVER_LOG_ERROR("Frame of type %u read from the %s region", header.sourceType,
+                                firebolt::rialto::common::convertMediaSourceType(type));
+        return false;
+    }
+    if (type != firebolt::rialto::MediaSourceType::AUDIO && type != firebolt::rialto::MediaSourceType::VIDEO &&
+        type != firebolt::rialto::MediaSourceType::SUBTITLE)
+    {
+        RIALTO_SERVER_LOG_ERROR("Unknown segment type");
+        return false;
+    }
+
+    view.type = type;
+    view.sourceId = header.streamId;
+    view.timeStamp = header.timePosition;
+    view.duration = header.sampleDuration;
+    if (type == firebolt::rialto::MediaSourceType::AUDIO)
+    {
+        view.sampleRate = header.sampleRate;
+        view.numberOfChannels = header.channelsNum;
+        view.clippingStart = header.clippingStart;
+        view.clippingEnd = header.clippingEnd;
+    }
+    else if (type == firebolt::rialto::MediaSourceType::VIDEO)
+    {
+        view.width = header.width;
+        view.height = header.height;
+        view.frameRate = firebolt::rialto::Fraction{header.frameRateNumerator, header.frameRateDenominator};
+    }
+    view.segmentAlignment = static_cast<firebolt::rialto::SegmentAlignment>(header.segmentAlignment);
+    if (header.flags & firebolt::rialto::common::MEDIA_FRAME_V3_FLAG_HAS_DISPLAY_OFFSET)
+    {
+        view.displayOffset = header.displayOffset;
+    }
+
+    // The tail is referenced in place, in the order in which it was written
+    if (header.flags & firebolt::rialto::common::MEDIA_FRAME_V3_FLAG_ENCRYPTED)
+    {
+        view.isEncrypted = true;
+        view.mediaKeySessionId = header.mediaKeySessionId;
+        view.initWithLast15 = header.initWithLast15;
+        view.cipherMode = static_cast<firebolt::rialto::CipherMode>(header.cipherMode);
+        if (header.flags & firebolt::rialto::common::MEDIA_FRAME_V3_FLAG_HAS_ENCRYPTION_PATTERN)
+        {
+            view.encryptionPatternSet = true;
+            view.crypt = header.crypt;
+            view.skip = header.skip;
+        }
+        view.subSamples = firebolt::rialto::server::SubSampleSpan{tail, header.numSubSamples};
+        tail += static_cast<std::size_t>(header.numSubSamples) *
+                firebolt::rialto::common::MEDIA_FRAME_V3_SUBSAMPLE_SIZE_BYTES;
+        view.keyId = firebolt::rialto::server::ByteSpan{tail, header.keyIdLength};
+        tail += header.keyIdLength;
+        view.initVector = firebolt::rialto::server::ByteSpan{tail, header.initVectorLength};
+        tail += header.initVectorLength;
+    }
+    if (header.extraDataLength > 0)
+    {
+        view.extraData = firebolt::rialto::server::ByteSpan{tail, header.extraDataLength};
+        tail += header.extraDataLength;
+    }
+    if (header.flags & firebolt::rialto::common::MEDIA_FRAME_V3_FLAG_HAS_CODEC_DATA)
+    {
+        view.codecData = batch.getCodecData(type, static_cast<firebolt::rialto::CodecDataType>(header.codecDataType),
+                                            firebolt::rialto::server::ByteSpan{tail, header.codecDataLength});
+    }
+    return true;
+}
+
+/**
+ * @brief Walks the frames of the region, calling onFrame(header, tail, data) for each of them.
+ *
+ * @retval false if the region is malformed or onFrame failed.
+ */
+template <typename OnFrame>
+bool forEachFrame(const std::uint8_t *currentReadPosition, std::uint32_t numFrames, std::uint64_t bytesLeft,
+                  OnFrame &&onFrame)
+{
+    for (auto i = 0U; i < numFrames; ++i)
+    {
+        firebolt::rialto::common::MediaFrameHeaderV3 header;
+        if (bytesLeft < sizeof(header))
+        {
+            RIALTO_SERVER_LOG_ERROR("Frame header exceeds the valid data length!");
+            return false;
+        }
+        // The media data region does not have to be aligned for the header, so it is copied out
+        std::memcpy(&header, currentReadPosition, sizeof(header));
+        if (!isValidHeader(header))
+        {
+            RIALTO_SERVER_LOG_ERROR("Frame header parsing failed!");
+            return false;
+        }
+        const std::uint64_t kMediaDataOffset{header.headerSize + alignFrameSize(header.tailLength)};
+        const std::uint64_t kFrameSize{kMediaDataOffset + alignFrameSize(header.dataLength)};
+        if (bytesLeft < kFrameSize)
+        {
+            RIALTO_SERVER_LOG_ERROR("Segment data exceeds the valid data length!");
+            return false;
+        }
+        if (!onFrame(header, currentReadPosition + header.headerSize, currentReadPosition + kMediaDataOffset))
+        {
+            RIALTO_SERVER_LOG_ERROR("Segment parsing failed!");
+            return false;
+        }
+        currentReadPosition += kFrameSize;
+        bytesLeft -= kFrameSize;
+    }
+    return true;
+}
+} // namespace
+
+namespace firebolt::rialto::server
+{
+DataReaderV3::DataReaderV3(const MediaSourceType &mediaSourceType, std::uint8_t *buffer, std::uint32_t dataOffset,
+                           std::uint32_t numFrames, std::uint32_t dataLength, bool isBufferFull)
+    : m_mediaSourceType{mediaSourceType}, m_buffer{buffer}, m_dataOffset{dataOffset}, m_numFrames{numFrames},
+      m_dataLength{dataLength}, m_isBufferFull{isBufferFull}
+{
+    RIALTO_SERVER_LOG_DEBUG("Detected Metadata in Version 3. Media source type: %s",
+                            common::convertMediaSourceType(m_mediaSourceType));
+}
+
+IMediaPipeline::MediaSegmentVector DataReaderV3::readData() const
+{
+    IMediaPipeline::MediaSegmentVector mediaSegments;
+    mediaSegments.reserve(m_numFrames);
+    const bool kResult{forEachFrame(m_buffer + m_dataOffset, m_numFrames, m_dataLength,
+                                    [&](const common::MediaFrameHeaderV3 &header, const std::uint8_t *tail,
+                                        const std::uint8_t *data)
+                                    {
+                                        auto newSegment{createSegment(header, tail, m_mediaSourceType)};
+                                        if (!newSegment)
+                                        {
+                                            return false;
+                                        }
+                                        newSegment->setData(header.dataLength, data);
+                                        mediaSegments.emplace_back(std::move(newSegment));
+                                        return true;
+                                    })};
+    if (!kResult)
+    {
+        return IMediaPipeline::MediaSegmentVector{};
+    }
+    return mediaSegments;
+}
+
+void DataReaderV3::readSegments(MediaSegmentBatch &batch) const
+{
+    const bool kResult{forEachFrame(m_buffer + m_dataOffset, m_numFrames, m_dataLength,
+                                    [&](const common::MediaFrameHeaderV3 &header, const std::uint8_t *tail,
+                                        const std::uint8_t *data)
+                                    {
+                                        MediaSegmentView &view{batch.addSegment()};
+                                        view.data = ByteSpan{data, header.dataLength};
+                                        return fillView(header, tail, m_mediaSourceType, batch, view);
+                                    })};
+    if (!kResult)
+    {
+        batch.clear();
+    }
+}
+
+bool DataReaderV3::isBufferFull() const
+{
+    return m_isBufferFull;
+}
+
+std::uint32_t DataReaderV3::getMetadataVersion() const
+{
+    return 3;
+}
+
+std::uint32_t DataReaderV3::getDataLength() const
+{
+    // Without a region header the length of the data is not known
+    return std::numeric_limits<std::uint32_t>::max() == m_dataLength ? 0 : m_dataLength;
+}
+} // namespace firebolt::rialto::server
@@ -19,10 +19,33 @@
 
 #include "MainThread.h"
 #include "RialtoServerLogging.h"
+#include <algorithm>
+#include <cstdlib>
 #include <string>
 #include <utility>
 #include <vector>
 
+namespace
+{
+unsigned getNumThreads()
+{
+    constexpr unsigned long kDefaultNumThreads{4};
+    constexpr unsigned long kMaxNumThreads{16};
+    const char *kValue = std::getenv("RIALTO_MAIN_THREAD_POOL_SIZE");
+    if (!kValue)
+    {
+        return kDefaultNumThreads;
+    }
+    char *end{nullptr};
+    const auto kNumThreads{std::strtoul(kValue, &end, 10)};
+    if (end == kValue || kNumThreads == 0)
+    {
+        return kDefaultNumThreads;
+    }
+    return static_cast<unsigned>(std::min(kNumThreads, kMaxNumThreads));
+}
+} // namespace
+
 namespace firebolt::rialto::server
 {
 std::weak_ptr<IMainThread> MainThreadFactory::m_mainThread;
@@ -65,31 +88,69 @@ std::shared_ptr<IMainThread> MainThreadFactory::getMainThread() const
     return mainThread;
 }
 
-MainThread::MainThread() : m_isMainThreadRunning{true}, m_mainThreadClientId{0}, m_nextClientId{1}
+MainThread::MainThread(unsigned numThreads)
+    : m_isMainThreadRunning{true}, m_mainThreadClientId{0}, m_nextClientId{1}
 {
     RIALTO_SERVER_LOG_DEBUG("MainThread is constructed");
-    m_thread = std::thread(std::bind(&MainThread::mainThreadLoop, this));
 
     // Register itself
-    m_registeredClients.insert(m_mainThreadClientId);
+    m_registeredClients.emplace(m_mainThreadClientId, std::make_shared<Strand>());
+
+    if (0 == numThreads)
+    {
+        numThreads = getNumThreads();
+    }
+    for (unsigned i = 0; i < numThreads; ++i)
+    {
+        m_threads.emplace_back(&MainThread::workerThreadLoop, this);
+    }
 }
 
 MainThread::~MainThread()
 {
     RIALTO_SERVER_LOG_DEBUG("MainThread is destructed");
-    auto shutdownTask = [this]() { m_isMainThreadRunning = false; };
-    enqueueTask(m_mainThreadClientId, shutdownTask);
-    m_thread.join();
+    {
+        std::unique_lock<std::mutex> lock(m_taskQueueMutex);
+        m_isMainThreadRunning = false;
+    }
+    m_taskQueueCv.notify_all();
+    for (std::thread &thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+const MainThread::Strand *&MainThread::currentStrand()
+{
+    static thread_local const Strand *strand{nullptr};
+    return strand;
 }
 
-void MainThread::mainThreadLoop()
+void MainThread::workerThreadLoop()
 {
-    while (m_isMainThreadRunning)
+    std::unique_lock<std::mutex> lock(m_taskQueueMutex);
+    while (true)
     {
-        const std::shared_ptr<TaskInfo> kTaskInfo = waitForTask();
-        if (m_registeredClients.find(kTaskInfo->clientId) != m_registeredClients.end())
+        // The queued tasks are still run once the main thread is shutting down
+        m_taskQueueCv.wait(lock, [this] { return !m_readyStrands.empty() || !m_isMainThreadRunning; });
+        if (m_readyStrands.empty())
+        {
+            return;
+        }
+
+        // Only one task of a strand is run at a time, so the strands take turns on the threads
+        std::shared_ptr<Strand> strand = std::move(m_readyStrands.front());
+        m_readyStrands.pop_front();
+        const std::shared_ptr<TaskInfo> kTaskInfo = std::move(strand->tasks.front());
+        strand->tasks.pop_front();
+        const bool kIsRegistered = m_registeredClients.find(kTaskInfo->clientId) != m_registeredClients.end();
+        lock.unlock();
+
+        if (kIsRegistered)
         {
+            currentStrand() = strand.get();
             kTaskInfo->task();
+            currentStrand() = nullptr;
         }
         else
         {
@@ -102,31 +163,40 @@ void MainThread::mainThreadLoop()
             kTaskInfo->done = true;
             kTaskInfo->cv->notify_one();
         }
-    }
-}
 
-const std::shared_ptr<MainThread::TaskInfo> MainThread::waitForTask()
-{
-    std::unique_lock<std::mutex> lock(m_taskQueueMutex);
-    if (m_taskQueue.empty())
-    {
-        m_taskQueueCv.wait(lock, [this] { return !m_taskQueue.empty(); });
+        lock.lock();
+        if (strand->tasks.empty())
+        {
+            strand->isScheduled = false;
+        }
+        else
+        {
+            m_readyStrands.push_back(std::move(strand));
+            m_taskQueueCv.notify_one();
+        }
     }
-    auto taskInfo = std::move(m_taskQueue.front());
-    m_taskQueue.pop_front();
-    return taskInfo;
 }
 
 int32_t MainThread::registerClient()
 {
     uint32_t clientId = m_nextClientId++;
 
-    auto task = [&, clientId]()
+    RIALTO_SERVER_LOG_INFO("Registering client '%u'", clientId);
+    std::unique_lock<std::mutex> lock(m_taskQueueMutex);
+
+    // A client registered from a task joins the strand of that task
+    std::shared_ptr<Strand> strand;
+    const Strand *kCurrentStrand = currentStrand();
+    if (kCurrentStrand)
     {
-        RIALTO_SERVER_LOG_INFO("Registering client '%u'", clientId);
-        m_registeredClients.insert(clientId);
-    };
-    enqueueTask(m_mainThreadClientId, task);
+        auto it = std::find_if(m_registeredClients.begin(), m_registeredClients.end(),
+                               [kCurrentStrand](const auto &client) { return client.second.get() == kCurrentStrand; });
+        if (it != m_registeredClients.end())
+        {
+            strand = it->second;
+        }
+    }
+    m_registeredClients.emplace(clientId, strand ? strand : std::make_shared<Strand>());
 
     return clientId;
 }
@@ -134,42 +204,72 @@ int32_t MainThread::registerClient()
 void MainThread::unregisterClient(uint32_t clientId)
 {
     RIALTO_SERVER_LOG_INFO("Unregistering client '%u'", clientId);
+    std::unique_lock<std::mutex> lock(m_taskQueueMutex);
     m_registeredClients.erase(clientId);
 }
 
-void MainThread::enqueueTask(uint32_t clientId, const Task &task)
+void MainThread::enqueue(const std::shared_ptr<TaskInfo> &taskInfo, bool priority)
 {
-    std::shared_ptr<TaskInfo> newTask = std::make_shared<TaskInfo>();
-    newTask->clientId = clientId;
-    newTask->task = task;
     {
         std::unique_lock<std::mutex> lock(m_taskQueueMutex);
-        m_taskQueue.push_back(std::move(newTask));
+        auto it = m_registeredClients.find(taskInfo->clientId);
+        if (it == m_registeredClients.end())
+        {
+            lock.unlock();
+            RIALTO_SERVER_LOG_WARN("Task ignored, client '%d' not registered", taskInfo->clientId);
+            if (nullptr != taskInfo->cv)
+            {
+                std::unique_lock<std::mutex> lockTask(*(taskInfo->mutex));
+                taskInfo->done = true;
+            }
+            return;
+        }
+
+        const std::shared_ptr<Strand> &kStrand = it->second;
+        if (priority)
+        {
+            kStrand->tasks.push_front(taskInfo);
+        }
+        else
+        {
+            kStrand->tasks.push_back(taskInfo);
+        }
+        if (kStrand->isScheduled)
+        {
+            return;
+        }
+        kStrand->isScheduled = true;
+        if (priority)
+        {
+            m_readyStrands.push_front(kStrand);
+        }
+        else
+        {
+            m_readyStrands.push_back(kStrand);
+        }
     }
     m_taskQueueCv.notify_one();
 }
 
-void MainThread::enqueueTaskAndWait(uint32_t clientId, const Task &task)
+void MainThread::enqueueTask(uint32_t clientId, const Task &task)
 {
     std::shared_ptr<TaskInfo> newTask = std::make_shared<TaskInfo>();
     newTask->clientId = clientId;
     newTask->task = task;
-    newTask->mutex = std::make_unique<std::mutex>();
-    newTask->cv = std::make_unique<std::condition_variable>();
-
-    {
-        std::unique_lock<std::mutex> lockTask(*(newTask->mutex));
-        {
-            std::unique_lock<std::mutex> lockQueue(m_taskQueueMutex);
-            m_taskQueue.push_back(newTask);
-        }
-        m_taskQueueCv.notify_one();
+    enqueue(newTask, false);
+}
 
-        newTask->cv->wait(lockTask, [&] { return newTask->done; });
-    }
+void MainThread::enqueueTaskAndWait(uint32_t clientId, const Task &task)
+{
+    enqueueAndWait(clientId, task, false);
 }
 
 void MainThread::enqueuePriorityTaskAndWait(uint32_t clientId, const Task &task)
+{
+    enqueueAndWait(clientId, task, true);
+}
+
+void MainThread::enqueueAndWait(uint32_t clientId, const Task &task, bool priority)
 {
     std::shared_ptr<TaskInfo> newTask = std::make_shared<TaskInfo>();
     newTask->clientId = clientId;
@@ -177,15 +277,9 @@ void MainThread::enqueuePriorityTaskAndWait(uint32_t clientId, const Task &task)
     newTask->mutex = std::make_unique<std::mutex>();
     newTask->cv = std::make_unique<std::condition_variable>();
 
-    {
-        std::unique_lock<std::mutex> lockTask(*(newTask->mutex));
-        {
-            std::unique_lock<std::mutex> lockQueue(m_taskQueueMutex);
-            m_taskQueue.push_front(newTask);
-        }
-        m_taskQueueCv.notify_one();
+    enqueue(newTask, priority);
 
-        newTask->cv->wait(lockTask, [&] { return newTask->done; });
-    }
+    std::unique_lock<std::mutex> lockTask(*(newTask->mutex));
+    newTask->cv->wait(lockTask, [&] { return newTask->done; });
 }
 } // namespace firebolt::rialto::server
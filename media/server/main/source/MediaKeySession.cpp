@@ -90,6 +90,8 @@ MediaKeySession::~MediaKeySession()
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
+    std::lock_guard<std::recursive_mutex> lock{m_ocdmSessionMutex};
+
     if (m_isSessionConstructed)
     {
         if (!m_isSessionClosed)
@@ -112,6 +114,8 @@ MediaKeyErrorStatus MediaKeySession::generateRequest(InitDataType initDataType,
                                                      const LimitedDurationLicense &ldlState)
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
+
+    std::lock_guard<std::recursive_mutex> lock{m_ocdmSessionMutex};
     if (LimitedDurationLicense::NOT_SPECIFIED != ldlState)
     {
         m_extendedInterfaceInUse = true;
@@ -167,6 +171,7 @@ void MediaKeySession::getChallenge(const LimitedDurationLicense &ldlState)
     RIALTO_SERVER_LOG_DEBUG("entry:");
     auto task = [&]()
     {
+        std::lock_guard<std::recursive_mutex> lock{m_ocdmSessionMutex};
         const bool kIsLdl{LimitedDurationLicense::ENABLED == ldlState};
         uint32_t challengeSize = 0;
         MediaKeyErrorStatus status = m_ocdmSession->getChallengeData(kIsLdl, nullptr, &challengeSize);
@@ -192,6 +197,8 @@ void MediaKeySession::getChallenge(const LimitedDurationLicense &ldlState)
 
 MediaKeyErrorStatus MediaKeySession::loadSession()
 {
+    std::lock_guard<std::recursive_mutex> lock{m_ocdmSessionMutex};
+
     initOcdmErrorChecking();
 
     MediaKeyErrorStatus status = m_ocdmSession->load();
@@ -210,6 +217,8 @@ MediaKeyErrorStatus MediaKeySession::loadSession()
 
 MediaKeyErrorStatus MediaKeySession::updateSession(const std::vector<uint8_t> &responseData)
 {
+    std::lock_guard<std::recursive_mutex> lock{m_ocdmSessionMutex};
+
     initOcdmErrorChecking();
 
     MediaKeyErrorStatus status;
@@ -242,6 +251,8 @@ MediaKeyErrorStatus MediaKeySession::decrypt(GstBuffer *encrypted, GstCaps *caps
 {
     constexpr uint32_t kHdcpOutputProtectionFailure{4427};
 
+    std::lock_guard<std::recursive_mutex> lock{m_ocdmSessionMutex};
+
     initOcdmErrorChecking();
 
     MediaKeyErrorStatus status = m_ocdmSession->decryptBuffer(encrypted, caps);
@@ -281,6 +292,8 @@ MediaKeyErrorStatus MediaKeySession::decrypt(GstBuffer *encrypted, GstCaps *caps
 
 MediaKeyErrorStatus MediaKeySession::closeKeySession()
 {
+    std::lock_guard<std::recursive_mutex> lock{m_ocdmSessionMutex};
+
     initOcdmErrorChecking();
 
     MediaKeyErrorStatus status;
@@ -318,6 +331,8 @@ MediaKeyErrorStatus MediaKeySession::closeKeySession()
 
 MediaKeyErrorStatus MediaKeySession::removeKeySession()
 {
+    std::lock_guard<std::recursive_mutex> lock{m_ocdmSessionMutex};
+
     initOcdmErrorChecking();
 
     MediaKeyErrorStatus status = m_ocdmSession->remove();
@@ -336,6 +351,8 @@ MediaKeyErrorStatus MediaKeySession::removeKeySession()
 
 MediaKeyErrorStatus MediaKeySession::getCdmKeySessionId(std::string &cdmKeySessionId)
 {
+    std::lock_guard<std::recursive_mutex> lock{m_ocdmSessionMutex};
+
     initOcdmErrorChecking();
 
     MediaKeyErrorStatus status = m_ocdmSession->getCdmKeySessionId(cdmKeySessionId);
@@ -354,6 +371,8 @@ MediaKeyErrorStatus MediaKeySession::getCdmKeySessionId(std::string &cdmKeySessi
 
 bool MediaKeySession::containsKey(const std::vector<uint8_t> &keyId)
 {
+    std::lock_guard<std::recursive_mutex> lock{m_ocdmSessionMutex};
+
     uint32_t result = m_ocdmSession->hasKeyId(keyId.data(), keyId.size());
 
     return static_cast<bool>(result);
@@ -361,6 +380,8 @@ bool MediaKeySession::containsKey(const std::vector<uint8_t> &keyId)
 
 MediaKeyErrorStatus MediaKeySession::setDrmHeader(const std::vector<uint8_t> &requestData)
 {
+    std::lock_guard<std::recursive_mutex> lock{m_ocdmSessionMutex};
+
     initOcdmErrorChecking();
 
     if (!m_isSessionConstructed)
@@ -387,6 +408,8 @@ MediaKeyErrorStatus MediaKeySession::setDrmHeader(const std::vector<uint8_t> &re
 
 MediaKeyErrorStatus MediaKeySession::getLastDrmError(uint32_t &errorCode)
 {
+    std::lock_guard<std::recursive_mutex> lock{m_ocdmSessionMutex};
+
     initOcdmErrorChecking();
 
     MediaKeyErrorStatus status = m_ocdmSession->getLastDrmError(errorCode);
@@ -405,6 +428,8 @@ MediaKeyErrorStatus MediaKeySession::getLastDrmError(uint32_t &errorCode)
 
 MediaKeyErrorStatus MediaKeySession::selectKeyId(const std::vector<uint8_t> &keyId)
 {
+    std::lock_guard<std::recursive_mutex> lock{m_ocdmSessionMutex};
+
     if (m_selectedKeyId == keyId)
     {
         return MediaKeyErrorStatus::OK;
@@ -459,6 +484,7 @@ void MediaKeySession::onKeyUpdated(const uint8_t keyId[], const uint8_t keyIdLen
         std::shared_ptr<IMediaKeysClient> client = m_mediaKeysClient.lock();
         if (client)
         {
+            std::lock_guard<std::recursive_mutex> lock{m_ocdmSessionMutex};
             KeyStatus status = m_ocdmSession->getStatus(&keyIdVec[0], keyIdVec.size());
             m_updatedKeyStatuses.push_back(std::make_pair(keyIdVec, status));
         }
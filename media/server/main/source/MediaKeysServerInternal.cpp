@@ -17,6 +17,7 @@
  * limitations under the License.
  */
 
+#include <mutex>
 #include <stdexcept>
 
 #include "MediaKeysServerInternal.h"
@@ -162,11 +163,9 @@ MediaKeyErrorStatus MediaKeysServerInternal::selectKeyId(int32_t keySessionId, c
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status;
-    auto task = [&]() { status = selectKeyIdInternal(keySessionId, keyId); };
-
-    m_mainThread->enqueueTaskAndWait(m_mainThreadClientId, task);
-    return status;
+    // Called by the decryptor for every buffer, so like decrypt() doesn't go through the main thread
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeySessionsMutex};
+    return selectKeyIdInternal(keySessionId, keyId);
 }
 
 MediaKeyErrorStatus MediaKeysServerInternal::selectKeyIdInternal(int32_t keySessionId, const std::vector<uint8_t> &keyId)
@@ -238,6 +237,7 @@ MediaKeyErrorStatus MediaKeysServerInternal::createKeySessionInternal(KeySession
         return MediaKeyErrorStatus::FAIL;
     }
     keySessionId = keySessionIdTemp;
+    std::unique_lock<std::shared_mutex> lock{m_mediaKeySessionsMutex};
     m_mediaKeySessions.emplace(std::make_pair(keySessionId, std::move(mediaKeySession)));
 
     return MediaKeyErrorStatus::OK;
@@ -548,6 +548,7 @@ MediaKeyErrorStatus MediaKeysServerInternal::releaseKeySessionInternal(int32_t k
         return MediaKeyErrorStatus::BAD_SESSION_ID;
     }
 
+    std::unique_lock<std::shared_mutex> lock{m_mediaKeySessionsMutex};
     m_mediaKeySessions.erase(sessionIter);
     return MediaKeyErrorStatus::OK;
 }
@@ -575,12 +576,11 @@ MediaKeyErrorStatus MediaKeysServerInternal::decrypt(int32_t keySessionId, GstBu
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
-    MediaKeyErrorStatus status{MediaKeyErrorStatus::FAIL};
-
-    auto task = [&]() { status = decryptInternal(keySessionId, encrypted, caps); };
-    m_mainThread->enqueueTaskAndWait(m_mainThreadClientId, task);
-
-    return status;
+    // The sessions are only added and removed on the main thread, so the decryptor threads can look them up under a
+    // shared lock rather than waiting behind licence requests and the other sessions.  The session serialises its own
+    // calls to ocdm.
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeySessionsMutex};
+    return decryptInternal(keySessionId, encrypted, caps);
 }
 
 MediaKeyErrorStatus MediaKeysServerInternal::decryptInternal(int32_t keySessionId, GstBuffer *encrypted, GstCaps *caps)
@@ -18,7 +18,11 @@
  */
 
 #include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cstdlib>
 #include <stdexcept>
+#include <string>
 
 #include "ActiveRequests.h"
 #include "DataReaderFactory.h"
@@ -28,10 +32,14 @@
 #include "MediaPipelineServerInternal.h"
 #include "NeedMediaData.h"
 #include "RialtoServerLogging.h"
+#include "ShmUtils.h"
 #include "TypeConverters.h"
 
 namespace
 {
+// The sizing decisions of a source are logged once per this many NeedMediaData requests
+constexpr std::uint64_t kNeedDataStatsLogInterval{100};
+
 const char *toString(const firebolt::rialto::MediaSourceStatus &status)
 {
     switch (status)
@@ -57,6 +65,53 @@ std::int32_t generateSourceId()
     static std::int32_t sourceId{1};
     return sourceId++;
 }
+
+bool isEnabled(const char *envVar)
+{
+    const char *kValue = std::getenv(envVar);
+    if (!kValue)
+    {
+        return false;
+    }
+    std::string value{kValue};
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value == "1" || value == "true" || value == "yes" || value == "on";
+}
+
+unsigned getNumOfNeedDataSlots()
+{
+    const char *kValue = std::getenv(firebolt::rialto::common::kNumOfNeedDataSlotsEnvVar);
+    if (!kValue)
+    {
+        return 1;
+    }
+    char *end{nullptr};
+    const auto kNumSlots{std::strtoul(kValue, &end, 10)};
+    if (end == kValue || *end != '\0' || kNumSlots == 0)
+    {
+        RIALTO_SERVER_LOG_WARN("Invalid number of need data slots: '%s', using 1", kValue);
+        return 1;
+    }
+    if (kNumSlots > firebolt::rialto::server::kMaxNeedDataSlots)
+    {
+        RIALTO_SERVER_LOG_WARN("Number of need data slots %lu is above the maximum, using %u", kNumSlots,
+                               firebolt::rialto::server::kMaxNeedDataSlots);
+        return firebolt::rialto::server::kMaxNeedDataSlots;
+    }
+    return static_cast<unsigned>(kNumSlots);
+}
+
+/**
+ * @brief Gets the shared memory options, which the server manager passes to the session server in its environment.
+ */
+firebolt::rialto::common::SharedMemoryConfig getSharedMemoryConfig()
+{
+    firebolt::rialto::common::SharedMemoryConfig config;
+    config.zeroCopy = isEnabled(firebolt::rialto::common::kSharedMemoryZeroCopyEnvVar);
+    config.numOfNeedDataSlots = getNumOfNeedDataSlots();
+    return config;
+}
 } // namespace
 
 namespace firebolt::rialto
@@ -120,7 +175,8 @@ std::unique_ptr<server::IMediaPipelineServerInternal> MediaPipelineServerInterna
                                                                   server::IMainThreadFactory::createFactory(),
                                                                   common::ITimerFactory::getFactory(),
                                                                   std::make_unique<DataReaderFactory>(),
-                                                                  std::make_unique<ActiveRequests>(), decryptionService);
+                                                                  std::make_unique<ActiveRequests>(), decryptionService,
+                                                                  getSharedMemoryConfig());
     }
     catch (const std::exception &e)
     {
@@ -135,11 +191,13 @@ MediaPipelineServerInternal::MediaPipelineServerInternal(
     const std::shared_ptr<IGstGenericPlayerFactory> &gstPlayerFactory, int sessionId,
     const std::shared_ptr<ISharedMemoryBuffer> &shmBuffer, const std::shared_ptr<IMainThreadFactory> &mainThreadFactory,
     const std::shared_ptr<common::ITimerFactory> &timerFactory, std::unique_ptr<IDataReaderFactory> &&dataReaderFactory,
-    std::unique_ptr<IActiveRequests> &&activeRequests, IDecryptionService &decryptionService)
+    std::unique_ptr<IActiveRequests> &&activeRequests, IDecryptionService &decryptionService,
+    const common::SharedMemoryConfig &sharedMemoryConfig)
     : m_mediaPipelineClient(client), m_kGstPlayerFactory(gstPlayerFactory), m_kVideoRequirements(videoRequirements),
       m_sessionId{sessionId}, m_shmBuffer{shmBuffer}, m_dataReaderFactory{std::move(dataReaderFactory)},
       m_timerFactory{timerFactory}, m_activeRequests{std::move(activeRequests)}, m_decryptionService{decryptionService},
-      m_currentPlaybackState{PlaybackState::UNKNOWN}, m_wasAllSourcesAttachedCalled{false}
+      m_currentPlaybackState{PlaybackState::UNKNOWN}, m_wasAllSourcesAttachedCalled{false},
+      m_isShmZeroCopyEnabled{sharedMemoryConfig.zeroCopy}, m_numNeedDataSlots{sharedMemoryConfig.numOfNeedDataSlots}
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
 
@@ -183,6 +241,10 @@ MediaPipelineServerInternal::~MediaPipelineServerInternal()
                 timer.second->cancel();
             }
         }
+        while (!m_shmRingReaders.empty())
+        {
+            disableStreamingRing(m_shmRingReaders.begin()->first);
+        }
         if (!m_shmBuffer->unmapPartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId))
         {
             RIALTO_SERVER_LOG_ERROR("Unable to unmap shm partition");
@@ -266,6 +328,7 @@ bool MediaPipelineServerInternal::attachSourceInternal(const std::unique_ptr<Med
         RIALTO_SERVER_LOG_DEBUG("New ID generated for MediaSourceType: %s: %d",
                                 common::convertMediaSourceType(source->getType()), source->getId());
         m_attachedSources.emplace(source->getType(), source->getId());
+        m_shmRegionSizeCalculator.addSource(*source);
     }
     else
     {
@@ -305,9 +368,12 @@ bool MediaPipelineServerInternal::removeSourceInternal(int32_t id)
     MediaSourceType type = sourceIter->first;
 
     m_gstPlayer->removeSource(type);
+    disableStreamingRing(type);
     m_needMediaDataTimers.erase(type);
     m_noAvailableSamplesCounter.erase(type);
     m_isMediaTypeEosMap.erase(type);
+    m_shmRegionSizeCalculator.removeSource(type);
+    m_needDataSlots.erase(type);
 
     m_attachedSources.erase(sourceIter);
     return true;
@@ -338,6 +404,9 @@ bool MediaPipelineServerInternal::allSourcesAttachedInternal()
         return false;
     }
 
+    // No media data has been requested yet, so the shm regions can be sized for the attached sources
+    resizeShmPartition();
+
     m_gstPlayer->allSourcesAttached();
     m_wasAllSourcesAttachedCalled = true;
     return true;
@@ -438,6 +507,7 @@ bool MediaPipelineServerInternal::setPlaybackRateInternal(double rate)
     }
 
     m_gstPlayer->setPlaybackRate(rate);
+    m_needDataSizeCalculator.setPlaybackRate(rate);
     return true;
 }
 
@@ -469,6 +539,7 @@ bool MediaPipelineServerInternal::setPositionInternal(int64_t position)
     }
 
     m_needDataDelayCalculator.resetMediaDataDelay();
+    m_needDataSizeCalculator.resetQueuedDuration();
 
     return true;
 }
@@ -764,6 +835,68 @@ bool MediaPipelineServerInternal::haveDataInternal(MediaSourceStatus status, uin
         RIALTO_SERVER_LOG_ERROR("HaveData failed - Gstreamer player has not been loaded");
         return false;
     }
+    std::vector<IGstGenericPlayer::ShmSamples> shmSamples;
+    std::vector<MediaSourceType> eosSources;
+    const bool kResult{readHaveData(status, numFrames, needDataRequestId, shmSamples, eosSources)};
+    for (const auto &samples : shmSamples)
+    {
+        m_gstPlayer->attachSamples(samples.dataReader, samples.shmBlockTracker);
+    }
+    setEosForSources(eosSources);
+    return kResult;
+}
+
+bool MediaPipelineServerInternal::haveDataMulti(const std::vector<HaveDataInfo> &haveDataInfos,
+                                                std::vector<bool> &results)
+{
+    RIALTO_SERVER_LOG_DEBUG("entry:");
+
+    bool result;
+    auto task = [&]() { result = haveDataMultiInternal(haveDataInfos, results); };
+
+    m_mainThread->enqueueTaskAndWait(m_mainThreadClientId, task);
+    return result;
+}
+
+bool MediaPipelineServerInternal::haveDataMultiInternal(const std::vector<HaveDataInfo> &haveDataInfos,
+                                                        std::vector<bool> &results)
+{
+    if (!m_gstPlayer)
+    {
+        RIALTO_SERVER_LOG_ERROR("HaveData failed - Gstreamer player has not been loaded");
+        return false;
+    }
+    std::vector<IGstGenericPlayer::ShmSamples> shmSamples;
+    std::vector<MediaSourceType> eosSources;
+    results.clear();
+    results.reserve(haveDataInfos.size());
+    for (const HaveDataInfo &kInfo : haveDataInfos)
+    {
+        results.push_back(readHaveData(kInfo.status, kInfo.numFrames, kInfo.requestId, shmSamples, eosSources));
+    }
+    // The samples of all requests are read by one worker thread task
+    if (!shmSamples.empty())
+    {
+        m_gstPlayer->attachSamples(shmSamples);
+    }
+    setEosForSources(eosSources);
+    return true;
+}
+
+void MediaPipelineServerInternal::setEosForSources(const std::vector<MediaSourceType> &eosSources)
+{
+    for (MediaSourceType mediaSourceType : eosSources)
+    {
+        m_gstPlayer->setEos(mediaSourceType);
+        m_isMediaTypeEosMap[mediaSourceType] = true;
+    }
+}
+
+bool MediaPipelineServerInternal::readHaveData(MediaSourceStatus status, uint32_t numFrames,
+                                               uint32_t needDataRequestId,
+                                               std::vector<IGstGenericPlayer::ShmSamples> &shmSamples,
+                                               std::vector<MediaSourceType> &eosSources)
+{
     MediaSourceType mediaSourceType = m_activeRequests->getType(needDataRequestId);
     if (MediaSourceType::UNKNOWN == mediaSourceType)
     {
@@ -772,6 +905,9 @@ bool MediaPipelineServerInternal::haveDataInternal(MediaSourceStatus status, uin
     }
     const std::uint32_t kMaxNumFrames = m_activeRequests->getMaxFrames(needDataRequestId);
     m_activeRequests->erase(needDataRequestId);
+    NeedDataSlots *needDataSlots{getNeedDataSlots(mediaSourceType)};
+    const std::optional<std::uint32_t> kSlotIndex{needDataSlots ? needDataSlots->findSlot(needDataRequestId)
+                                                                 : std::nullopt};
 
     unsigned int &counter = m_noAvailableSamplesCounter[mediaSourceType];
     if (status != MediaSourceStatus::OK && status != MediaSourceStatus::EOS &&
@@ -802,6 +938,16 @@ bool MediaPipelineServerInternal::haveDataInternal(MediaSourceStatus status, uin
         counter = 0;
     }
 
+    if (0 == numFrames && status == MediaSourceStatus::NO_SPACE_FOR_SAMPLES)
+    {
+        // Not even one frame fitted in the byte budget, the next request may use all the free shared memory
+        RIALTO_SERVER_LOG_INFO("%s Data request for needDataRequestId: %u received without frames, no space",
+                               common::convertMediaSourceType(mediaSourceType), needDataRequestId);
+        m_needDataSizeCalculator.onNoSpaceForSamples(mediaSourceType);
+        scheduleNotifyNeedMediaData(mediaSourceType);
+        return true;
+    }
+
     uint8_t *buffer = m_shmBuffer->getBuffer();
     if (!buffer)
     {
@@ -827,8 +973,19 @@ bool MediaPipelineServerInternal::haveDataInternal(MediaSourceStatus status, uin
     {
         const bool kIsBufferFull = kMaxNumFrames == numFrames || status == MediaSourceStatus::NO_SPACE_FOR_SAMPLES ||
                                    status == MediaSourceStatus::EOS;
+        if (kSlotIndex)
+        {
+            regionOffset += needDataSlots->getSlot(kSlotIndex.value()).offset;
+        }
+        std::uint32_t mediaDataOffset = regionOffset + getMaxMetadataBytes();
+        std::shared_ptr<ShmBlockTracker> shmBlockTracker = getShmBlockTracker(mediaSourceType, kSlotIndex.value_or(0));
+        if (shmBlockTracker)
+        {
+            mediaDataOffset += shmBlockTracker->getWriteWindow().offset;
+        }
         std::shared_ptr<IDataReader> dataReader =
-            m_dataReaderFactory->createDataReader(mediaSourceType, buffer, regionOffset, numFrames, kIsBufferFull);
+            m_dataReaderFactory->createDataReader(mediaSourceType, buffer, regionOffset, mediaDataOffset, numFrames,
+                                                  kIsBufferFull);
         if (!dataReader)
         {
             RIALTO_SERVER_LOG_ERROR("Metadata version not supported for %s request id: %u",
@@ -836,12 +993,19 @@ bool MediaPipelineServerInternal::haveDataInternal(MediaSourceStatus status, uin
             notifyPlaybackState(PlaybackState::FAILURE);
             return false;
         }
-        m_gstPlayer->attachSamples(dataReader);
+        m_needDataSizeCalculator.onDataReceived(mediaSourceType, numFrames, dataReader->getDataLength(),
+                                                dataReader->getMetadataVersion());
+        if (kSlotIndex)
+        {
+            // The slot is not requested again until the player has read its data
+            needDataSlots->setDataReader(kSlotIndex.value(), dataReader);
+        }
+        m_attachedDataReaders.push_back(dataReader);
+        shmSamples.push_back(IGstGenericPlayer::ShmSamples{dataReader, shmBlockTracker});
     }
     if (status == MediaSourceStatus::EOS)
     {
-        m_gstPlayer->setEos(mediaSourceType);
-        m_isMediaTypeEosMap[mediaSourceType] = true;
+        eosSources.push_back(mediaSourceType);
     }
 
     return true;
@@ -867,6 +1031,105 @@ void MediaPipelineServerInternal::pingInternal(std::unique_ptr<IHeartbeatHandler
     m_gstPlayer->ping(std::move(heartbeatHandler));
 }
 
+bool MediaPipelineServerInternal::enableStreamingRing(int32_t sourceId, ISharedMemoryBuffer::StreamingRing &ring)
+{
+    RIALTO_SERVER_LOG_DEBUG("entry:");
+
+    bool result;
+    auto task = [&]() { result = enableStreamingRingInternal(sourceId, ring); };
+
+    m_mainThread->enqueueTaskAndWait(m_mainThreadClientId, task);
+    return result;
+}
+
+bool MediaPipelineServerInternal::enableStreamingRingInternal(int32_t sourceId,
+                                                              ISharedMemoryBuffer::StreamingRing &ring)
+{
+    if (!m_gstPlayer || !m_wasAllSourcesAttachedCalled)
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to enable streaming mode - all sources have not been attached");
+        return false;
+    }
+    auto sourceIter = std::find_if(m_attachedSources.begin(), m_attachedSources.end(),
+                                   [sourceId](const auto &src) { return src.second == sourceId; });
+    if (sourceIter == m_attachedSources.end())
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to enable streaming mode - Source with id: %d not found", sourceId);
+        return false;
+    }
+    const MediaSourceType kType{sourceIter->first};
+    if (m_shmRingReaders.find(kType) != m_shmRingReaders.end())
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to enable streaming mode - Source with id: %d is already streaming", sourceId);
+        return false;
+    }
+
+    // The region is formatted as a ring, so the requests of the source are dropped and the worker thread must have
+    // read all the samples attached from it
+    m_activeRequests->erase(kType);
+    m_attachedDataReaders.erase(std::remove_if(m_attachedDataReaders.begin(), m_attachedDataReaders.end(),
+                                               [](const auto &dataReader) { return dataReader.expired(); }),
+                                m_attachedDataReaders.end());
+    if (!m_attachedDataReaders.empty() ||
+        std::any_of(m_shmBlockTrackers.begin(), m_shmBlockTrackers.end(),
+                    [kType](const auto &tracker)
+                    { return tracker.first.first == kType && tracker.second->hasLentBlocks(); }))
+    {
+        RIALTO_SERVER_LOG_WARN("Failed to enable streaming mode for source with id: %d - media data is outstanding",
+                               sourceId);
+        return false;
+    }
+
+    auto doorbellCallback = [this, kType]()
+    {
+        auto task = [this, kType]()
+        {
+            auto readerIt = m_shmRingReaders.find(kType);
+            if (m_gstPlayer && readerIt != m_shmRingReaders.end())
+            {
+                m_gstPlayer->drainShmRing(readerIt->second);
+            }
+        };
+        m_mainThread->enqueueTask(m_mainThreadClientId, task);
+    };
+    if (!m_shmBuffer->enableStreamingMode(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId, kType,
+                                          std::move(doorbellCallback), ring))
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to enable streaming mode for source with id: %d", sourceId);
+        return false;
+    }
+    try
+    {
+        m_shmRingReaders.emplace(kType,
+                                 std::make_shared<ShmRingReader>(kType, m_shmBuffer->getBuffer() + ring.offset,
+                                                                 ring.capacity));
+    }
+    catch (const std::exception &e)
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to enable streaming mode for source with id: %d - %s", sourceId, e.what());
+        m_shmBuffer->disableStreamingMode(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId, kType);
+        return false;
+    }
+
+    m_needMediaDataTimers.erase(kType);
+    m_needDataSlots.erase(kType);
+    for (auto trackerIt = m_shmBlockTrackers.begin(); trackerIt != m_shmBlockTrackers.end();)
+    {
+        trackerIt = (trackerIt->first.first == kType) ? m_shmBlockTrackers.erase(trackerIt) : std::next(trackerIt);
+    }
+    m_gstPlayer->drainShmRing(m_shmRingReaders.at(kType));
+    return true;
+}
+
+void MediaPipelineServerInternal::disableStreamingRing(MediaSourceType mediaSourceType)
+{
+    if (m_shmRingReaders.erase(mediaSourceType) != 0)
+    {
+        m_shmBuffer->disableStreamingMode(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId,
+                                          mediaSourceType);
+    }
+}
+
 bool MediaPipelineServerInternal::renderFrame()
 {
     RIALTO_SERVER_LOG_DEBUG("entry:");
@@ -1228,9 +1491,16 @@ bool MediaPipelineServerInternal::flushInternal(int32_t sourceId, bool resetTime
         return false;
     }
 
+    // Records written before the flush are dropped, until the source is flushed
+    auto readerIt = m_shmRingReaders.find(sourceIter->first);
+    if (readerIt != m_shmRingReaders.end())
+    {
+        readerIt->second->setFlushing(true);
+    }
     m_gstPlayer->flush(sourceIter->first, resetTime, async);
 
     m_needMediaDataTimers.erase(sourceIter->first);
+    m_needDataSizeCalculator.resetQueuedDuration(sourceIter->first);
 
     // Reset Eos on flush
     auto it = m_isMediaTypeEosMap.find(sourceIter->first);
@@ -1431,6 +1701,8 @@ bool MediaPipelineServerInternal::switchSourceInternal(const std::unique_ptr<Med
         return false;
     }
     m_gstPlayer->switchSource(source);
+    // The new caps may need other region sizes, applied once no media data is outstanding
+    m_shmRegionSizeCalculator.addSource(*source);
     return true;
 }
 
@@ -1454,6 +1726,15 @@ AddSegmentStatus MediaPipelineServerInternal::addSegmentInternal(uint32_t needDa
     {
         RIALTO_SERVER_LOG_ERROR("Failed to add segment for request id: %u", needDataRequestId);
     }
+    else if (MediaSourceType::VIDEO == mediaSegment->getType())
+    {
+        // A new resolution changes the caps, and may need a bigger video region
+        const auto *kVideoSegment = dynamic_cast<const IMediaPipeline::MediaSegmentVideo *>(mediaSegment.get());
+        if (kVideoSegment)
+        {
+            m_shmRegionSizeCalculator.addVideoResolution(kVideoSegment->getWidth(), kVideoSegment->getHeight());
+        }
+    }
 
     return status;
 }
@@ -1505,7 +1786,22 @@ bool MediaPipelineServerInternal::notifyNeedMediaData(MediaSourceType mediaSourc
 bool MediaPipelineServerInternal::notifyNeedMediaDataInternal(MediaSourceType mediaSourceType)
 {
     m_needMediaDataTimers.erase(mediaSourceType);
-    m_shmBuffer->clearData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId, mediaSourceType);
+    auto readerIt = m_shmRingReaders.find(mediaSourceType);
+    if (readerIt != m_shmRingReaders.end())
+    {
+        // The client writes to the ring without being asked, so only the ring needs to be drained
+        if (m_gstPlayer)
+        {
+            m_gstPlayer->drainShmRing(readerIt->second);
+        }
+        return false;
+    }
+    resizeShmPartitionIfNeeded();
+    NeedDataSlots *needDataSlots{getNeedDataSlots(mediaSourceType)};
+    if (!needDataSlots)
+    {
+        m_shmBuffer->clearData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId, mediaSourceType);
+    }
     const auto kSourceIter = m_attachedSources.find(mediaSourceType);
 
     if (m_attachedSources.cend() == kSourceIter)
@@ -1520,16 +1816,70 @@ bool MediaPipelineServerInternal::notifyNeedMediaDataInternal(MediaSourceType me
         RIALTO_SERVER_LOG_INFO("EOS, NeedMediaData not needed for %s", common::convertMediaSourceType(mediaSourceType));
         return false;
     }
-    NeedMediaData event{m_mediaPipelineClient, *m_activeRequests,   *m_shmBuffer,          m_sessionId,
-                        mediaSourceType,       kSourceIter->second, m_currentPlaybackState};
-    if (!event.send())
+    std::int64_t queuedDuration{0};
+    if (m_gstPlayer && m_gstPlayer->getQueuedDuration(mediaSourceType, queuedDuration))
+    {
+        m_needDataSizeCalculator.setQueuedDuration(mediaSourceType, queuedDuration);
+    }
+    else
+    {
+        m_needDataSizeCalculator.setQueuedDuration(mediaSourceType, std::nullopt);
+    }
+    if (!needDataSlots)
+    {
+        std::uint32_t requestId{0};
+        return sendNeedMediaData(mediaSourceType, kSourceIter->second, std::nullopt, requestId);
+    }
+
+    // Every free slot is requested, so that the client can fill one while the data of another is being read
+    bool isRequestOutstanding{needDataSlots->hasOutstandingRequest(*m_activeRequests)};
+    for (std::uint32_t slotIndex : needDataSlots->getFreeSlots(*m_activeRequests))
+    {
+        m_shmBuffer->clearData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId, mediaSourceType,
+                               needDataSlots->getSlot(slotIndex).offset);
+        std::uint32_t requestId{0};
+        if (!sendNeedMediaData(mediaSourceType, kSourceIter->second, slotIndex, requestId))
+        {
+            break;
+        }
+        needDataSlots->setRequestId(slotIndex, requestId);
+        isRequestOutstanding = true;
+    }
+    return isRequestOutstanding;
+}
+
+bool MediaPipelineServerInternal::sendNeedMediaData(MediaSourceType mediaSourceType, std::int32_t sourceId,
+                                                    std::optional<std::uint32_t> slotIndex, std::uint32_t &requestId)
+{
+    const NeedDataSlots::Slot *slot{nullptr};
+    if (slotIndex)
+    {
+        slot = &m_needDataSlots.at(mediaSourceType).getSlot(slotIndex.value());
+    }
+    std::shared_ptr<ShmBlockTracker> shmBlockTracker = getShmBlockTracker(mediaSourceType, slotIndex.value_or(0));
+    NeedMediaData event{m_mediaPipelineClient,  *m_activeRequests,     *m_shmBuffer,
+                        m_sessionId,            mediaSourceType,       sourceId,
+                        m_currentPlaybackState, shmBlockTracker.get(), &m_needDataSizeCalculator,
+                        slot};
+    if (!event.send(requestId))
     {
         RIALTO_SERVER_LOG_WARN("NeedMediaData event sending failed for %s",
                                common::convertMediaSourceType(mediaSourceType));
         return false;
     }
 
-    RIALTO_SERVER_LOG_DEBUG("%s NeedMediaData sent.", common::convertMediaSourceType(mediaSourceType));
+    const NeedDataSizeStats kStats{m_needDataSizeCalculator.getStats(mediaSourceType)};
+    RIALTO_SERVER_LOG_DEBUG("%s NeedMediaData sent. Request id: %u, frames: %u, bytes: %u, average frame size: %u",
+                            common::convertMediaSourceType(mediaSourceType), requestId, kStats.frameCount,
+                            kStats.maxMediaBytes, kStats.averageFrameBytes);
+    if (0 == kStats.numRequests % kNeedDataStatsLogInterval)
+    {
+        RIALTO_SERVER_LOG_MIL("%s NeedMediaData sizing after %" PRIu64 " requests: frames: %u, bytes: %u, average "
+                              "frame size: %u, queued duration: %" PRId64 " ns, playback rate: %f",
+                              common::convertMediaSourceType(mediaSourceType), kStats.numRequests, kStats.frameCount,
+                              kStats.maxMediaBytes, kStats.averageFrameBytes, kStats.queuedDuration.value_or(-1),
+                              kStats.playbackRate);
+    }
 
     return true;
 }
@@ -1553,7 +1903,11 @@ bool MediaPipelineServerInternal::notifyNeedMediaDataWithDelay(MediaSourceType m
 bool MediaPipelineServerInternal::notifyNeedMediaDataWithDelayInternal(MediaSourceType mediaSourceType)
 {
     m_needMediaDataTimers.erase(mediaSourceType);
-    m_shmBuffer->clearData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId, mediaSourceType);
+    if (!getNeedDataSlots(mediaSourceType))
+    {
+        // With slots, each one is cleared right before its request is sent
+        m_shmBuffer->clearData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId, mediaSourceType);
+    }
     const auto kSourceIter = m_attachedSources.find(mediaSourceType);
 
     if (m_attachedSources.cend() == kSourceIter)
@@ -1731,6 +2085,15 @@ void MediaPipelineServerInternal::notifySourceFlushed(MediaSourceType mediaSourc
             m_mediaPipelineClient->notifySourceFlushed(kSourceIter->second);
             RIALTO_SERVER_LOG_DEBUG("%s source flushed", common::convertMediaSourceType(mediaSourceType));
         }
+        auto readerIt = m_shmRingReaders.find(mediaSourceType);
+        if (readerIt != m_shmRingReaders.end())
+        {
+            readerIt->second->setFlushing(false);
+            if (m_gstPlayer)
+            {
+                m_gstPlayer->drainShmRing(readerIt->second);
+            }
+        }
         m_needDataDelayCalculator.resetMediaDataDelay(mediaSourceType);
     };
 
@@ -1793,4 +2156,106 @@ std::chrono::milliseconds MediaPipelineServerInternal::getNeedMediaDataTimeout(M
     }
     return m_needDataDelayCalculator.getNeedMediaDataDelay(mediaSourceType);
 }
+
+std::shared_ptr<ShmBlockTracker> MediaPipelineServerInternal::getShmBlockTracker(MediaSourceType mediaSourceType,
+                                                                                 std::uint32_t slotIndex)
+{
+    if (!m_isShmZeroCopyEnabled)
+    {
+        return nullptr;
+    }
+    auto trackerIt = m_shmBlockTrackers.find(std::make_pair(mediaSourceType, slotIndex));
+    if (trackerIt != m_shmBlockTrackers.end())
+    {
+        return trackerIt->second;
+    }
+    std::uint8_t *regionData =
+        m_shmBuffer->getDataPtr(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId, mediaSourceType);
+    std::uint32_t maxDataLen =
+        m_shmBuffer->getMaxDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId, mediaSourceType);
+    auto slotsIt = m_needDataSlots.find(mediaSourceType);
+    if (regionData && slotsIt != m_needDataSlots.end())
+    {
+        // Each slot has its own media data area, which is tracked separately
+        const NeedDataSlots::Slot &kSlot{slotsIt->second.getSlot(slotIndex)};
+        regionData += kSlot.offset;
+        maxDataLen = kSlot.length;
+    }
+    if (!regionData || maxDataLen <= getMaxMetadataBytes())
+    {
+        RIALTO_SERVER_LOG_WARN("Unable to use zero copy for %s - no shm region",
+                               common::convertMediaSourceType(mediaSourceType));
+        return nullptr;
+    }
+    auto tracker =
+        std::make_shared<ShmBlockTracker>(regionData + getMaxMetadataBytes(), maxDataLen - getMaxMetadataBytes());
+    m_shmBlockTrackers.emplace(std::make_pair(mediaSourceType, slotIndex), tracker);
+    return tracker;
+}
+
+NeedDataSlots *MediaPipelineServerInternal::getNeedDataSlots(MediaSourceType mediaSourceType)
+{
+    if (m_numNeedDataSlots <= 1)
+    {
+        return nullptr;
+    }
+    auto slotsIt = m_needDataSlots.find(mediaSourceType);
+    if (slotsIt != m_needDataSlots.end())
+    {
+        return &slotsIt->second;
+    }
+    const std::uint32_t kMaxDataLen =
+        m_shmBuffer->getMaxDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId, mediaSourceType);
+    if (kMaxDataLen <= getMaxMetadataBytes())
+    {
+        return nullptr;
+    }
+    return &m_needDataSlots.emplace(mediaSourceType, NeedDataSlots{kMaxDataLen, m_numNeedDataSlots}).first->second;
+}
+
+void MediaPipelineServerInternal::resizeShmPartition()
+{
+    m_shmPartitionSizes = m_shmRegionSizeCalculator.getPartitionSizes();
+    if (!m_shmBuffer->resizePartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_sessionId,
+                                      m_shmPartitionSizes))
+    {
+        RIALTO_SERVER_LOG_WARN("Unable to resize shm partition - current sizes are kept");
+    }
+    m_shmBlockTrackers.clear();
+    m_needDataSlots.clear();
+}
+
+void MediaPipelineServerInternal::resizeShmPartitionIfNeeded()
+{
+    if (!m_wasAllSourcesAttachedCalled)
+    {
+        return;
+    }
+    const ISharedMemoryBuffer::PartitionSizes kSizes{m_shmRegionSizeCalculator.getPartitionSizes()};
+    if (kSizes.videoLen == m_shmPartitionSizes.videoLen && kSizes.audioLen == m_shmPartitionSizes.audioLen &&
+        kSizes.subtitleLen == m_shmPartitionSizes.subtitleLen)
+    {
+        return;
+    }
+    if (!m_shmRingReaders.empty())
+    {
+        RIALTO_SERVER_LOG_DEBUG("Shm partition resize postponed - a source is in streaming mode");
+        return;
+    }
+    // The regions may move, so wait until the client writes to none of them, the worker thread has read all the
+    // samples attached from them and gstreamer holds no block of them
+    m_attachedDataReaders.erase(std::remove_if(m_attachedDataReaders.begin(), m_attachedDataReaders.end(),
+                                               [](const auto &dataReader) { return dataReader.expired(); }),
+                                m_attachedDataReaders.end());
+    if (!m_activeRequests->isEmpty() || !m_attachedDataReaders.empty() ||
+        std::any_of(m_shmBlockTrackers.begin(), m_shmBlockTrackers.end(),
+                    [](const auto &tracker) { return tracker.second->hasLentBlocks(); }))
+    {
+        RIALTO_SERVER_LOG_DEBUG("Shm partition resize postponed - media data is outstanding");
+        return;
+    }
+    RIALTO_SERVER_LOG_INFO("Resizing shm partition to video: %u, audio: %u, subtitle: %u bytes", kSizes.videoLen,
+                           kSizes.audioLen, kSizes.subtitleLen);
+    resizeShmPartition();
+}
 }; // namespace firebolt::rialto::server
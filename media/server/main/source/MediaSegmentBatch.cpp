@@ -0,0 +1,99 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MediaSegmentBatch.h"
+#include <algorithm>
+#include <utility>
+
+namespace firebolt::rialto::server
+{
+MediaSegmentView makeMediaSegmentView(const IMediaPipeline::MediaSegment &segment)
+{
+    MediaSegmentView view;
+    view.type = segment.getType();
+    view.sourceId = segment.getId();
+    view.timeStamp = segment.getTimeStamp();
+    view.duration = segment.getDuration();
+    view.data = ByteSpan{segment.getData(), segment.getDataLength()};
+    view.segmentAlignment = segment.getSegmentAlignment();
+    view.displayOffset = segment.getDisplayOffset();
+    view.extraData = ByteSpan{segment.getExtraData().data(), segment.getExtraData().size()};
+    view.codecData = segment.getCodecData();
+    if (const auto *audioSegment = dynamic_cast<const IMediaPipeline::MediaSegmentAudio *>(&segment))
+    {
+        view.sampleRate = audioSegment->getSampleRate();
+        view.numberOfChannels = audioSegment->getNumberOfChannels();
+        view.clippingStart = audioSegment->getClippingStart();
+        view.clippingEnd = audioSegment->getClippingEnd();
+    }
+    else if (const auto *videoSegment = dynamic_cast<const IMediaPipeline::MediaSegmentVideo *>(&segment))
+    {
+        view.width = videoSegment->getWidth();
+        view.height = videoSegment->getHeight();
+        view.frameRate = videoSegment->getFrameRate();
+    }
+    view.isEncrypted = segment.isEncrypted();
+    if (view.isEncrypted)
+    {
+        view.mediaKeySessionId = segment.getMediaKeySessionId();
+        view.keyId = ByteSpan{segment.getKeyId().data(), segment.getKeyId().size()};
+        view.initVector = ByteSpan{segment.getInitVector().data(), segment.getInitVector().size()};
+        view.initWithLast15 = segment.getInitWithLast15();
+        view.cipherMode = segment.getCipherMode();
+        view.encryptionPatternSet = segment.getEncryptionPattern(view.crypt, view.skip);
+        view.subSamples = SubSampleSpan{segment.getSubSamples()};
+    }
+    return view;
+}
+
+void MediaSegmentBatch::clear()
+{
+    m_views.clear();
+    m_ownedSegments.clear();
+}
+
+MediaSegmentView &MediaSegmentBatch::addSegment()
+{
+    return m_views.emplace_back();
+}
+
+void MediaSegmentBatch::addSegments(IMediaPipeline::MediaSegmentVector &&segments)
+{
+    for (auto &segment : segments)
+    {
+        m_views.push_back(makeMediaSegmentView(*segment));
+        m_ownedSegments.push_back(std::move(segment));
+    }
+}
+
+const std::shared_ptr<CodecData> &MediaSegmentBatch::getCodecData(MediaSourceType sourceType, CodecDataType type,
+                                                                  ByteSpan bytes)
+{
+    std::shared_ptr<CodecData> &cached{m_codecData.at(static_cast<std::size_t>(sourceType))};
+    if (!cached || cached->type != type ||
+        !std::equal(cached->data.begin(), cached->data.end(), bytes.data, bytes.data + bytes.size))
+    {
+        // The previous instance may still be referenced by the caps, so it is replaced rather than modified
+        cached = std::make_shared<CodecData>();
+        cached->type = type;
+        cached->data.assign(bytes.data, bytes.data + bytes.size);
+    }
+    return cached;
+}
+} // namespace firebolt::rialto::server
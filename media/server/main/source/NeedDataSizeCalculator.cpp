@@ -0,0 +1,129 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NeedDataSizeCalculator.h"
+#include "ShmUtils.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Room left for frames larger than the average, e.g. key frames
+constexpr std::uint64_t kFrameBytesHeadroomPercent{150};
+// Above this much queued data, measured in real time, smaller requests are sent
+constexpr std::int64_t kMaxQueuedDurationNs{2000000000};
+constexpr std::uint32_t kMinMetadataVersionWithInlineMetadata{2};
+} // namespace
+
+namespace firebolt::rialto::server
+{
+NeedDataSize NeedDataSizeCalculator::calculateNeedDataSize(MediaSourceType mediaSourceType, bool isPrerolling,
+                                                           std::uint32_t availableBytes)
+{
+    SourceState &state{m_sources[mediaSourceType]};
+    NeedDataSize size{isPrerolling ? kPrerollNumFrames : kMaxFrames, availableBytes};
+    if (!isPrerolling && state.stats.averageFrameBytes > 0)
+    {
+        const std::uint64_t kBytesPerFrame{state.stats.averageFrameBytes * kFrameBytesHeadroomPercent / 100};
+        const std::uint32_t kMaxFrameCount{std::max(state.maxFrames, kMaxFrames)};
+        const std::uint64_t kFittingFrames{availableBytes / std::max<std::uint64_t>(kBytesPerFrame, 1)};
+        size.frameCount =
+            static_cast<std::uint32_t>(std::clamp<std::uint64_t>(kFittingFrames, kMaxFrames, kMaxFrameCount));
+
+        // The rate is applied, as at 2x the queued data lasts half as long
+        const double kRate{std::fabs(m_playbackRate) > 0.0 ? std::fabs(m_playbackRate) : 1.0};
+        if (state.stats.queuedDuration &&
+            static_cast<double>(state.stats.queuedDuration.value()) / kRate > kMaxQueuedDurationNs)
+        {
+            size.frameCount = std::max(kPrerollNumFrames, size.frameCount / 2);
+        }
+        if (state.isBudgetTooSmall)
+        {
+            // The client could not write a single frame within the last budget, e.g. a key frame
+            state.isBudgetTooSmall = false;
+        }
+        else
+        {
+            size.maxMediaBytes =
+                static_cast<std::uint32_t>(std::min<std::uint64_t>(availableBytes, size.frameCount * kBytesPerFrame));
+        }
+    }
+
+    state.stats.frameCount = size.frameCount;
+    state.stats.maxMediaBytes = size.maxMediaBytes;
+    state.stats.playbackRate = m_playbackRate;
+    ++state.stats.numRequests;
+    return size;
+}
+
+void NeedDataSizeCalculator::onDataReceived(MediaSourceType mediaSourceType, std::uint32_t numFrames,
+                                            std::uint32_t numBytes, std::uint32_t metadataVersion)
+{
+    SourceState &state{m_sources[mediaSourceType]};
+    // Only formats that store the metadata next to the frames can describe more frames than the metadata region
+    state.maxFrames = metadataVersion >= kMinMetadataVersionWithInlineMetadata ? kMaxFramesWithInlineMetadata
+                                                                               : kMaxFrames;
+    if (0 == numFrames || 0 == numBytes)
+    {
+        return;
+    }
+    const std::uint32_t kFrameBytes{numBytes / numFrames};
+    std::uint32_t &average{state.stats.averageFrameBytes};
+    average = (0 == average) ? kFrameBytes : static_cast<std::uint32_t>((3ULL * average + kFrameBytes) / 4);
+}
+
+void NeedDataSizeCalculator::onNoSpaceForSamples(MediaSourceType mediaSourceType)
+{
+    m_sources[mediaSourceType].isBudgetTooSmall = true;
+}
+
+void NeedDataSizeCalculator::setQueuedDuration(MediaSourceType mediaSourceType,
+                                               std::optional<std::int64_t> queuedDuration)
+{
+    m_sources[mediaSourceType].stats.queuedDuration = queuedDuration;
+}
+
+void NeedDataSizeCalculator::setPlaybackRate(double rate)
+{
+    m_playbackRate = rate;
+}
+
+void NeedDataSizeCalculator::resetQueuedDuration(MediaSourceType mediaSourceType)
+{
+    m_sources[mediaSourceType].stats.queuedDuration.reset();
+}
+
+void NeedDataSizeCalculator::resetQueuedDuration()
+{
+    for (auto &source : m_sources)
+    {
+        source.second.stats.queuedDuration.reset();
+    }
+}
+
+NeedDataSizeStats NeedDataSizeCalculator::getStats(MediaSourceType mediaSourceType) const
+{
+    auto it = m_sources.find(mediaSourceType);
+    if (it == m_sources.end())
+    {
+        return NeedDataSizeStats{};
+    }
+    return it->second.stats;
+}
+} // namespace firebolt::rialto::server
@@ -0,0 +1,118 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NeedDataSlots.h"
+#include "ShmUtils.h"
+
+namespace
+{
+constexpr std::uint32_t kSlotAlignment{64};
+// Each slot needs room for a reasonable amount of media data next to its metadata
+constexpr std::uint32_t kMinSlotLength{firebolt::rialto::server::getMaxMetadataBytes() + 64 * 1024};
+} // namespace
+
+namespace firebolt::rialto::server
+{
+NeedDataSlots::NeedDataSlots(std::uint32_t regionLength, std::uint32_t numSlots)
+{
+    while (numSlots > 1 && regionLength / numSlots < kMinSlotLength)
+    {
+        --numSlots;
+    }
+    if (numSlots <= 1)
+    {
+        m_slots.push_back(SlotState{Slot{0, regionLength}, std::nullopt, {}});
+        return;
+    }
+    const std::uint32_t kSlotLength{(regionLength / numSlots) & ~(kSlotAlignment - 1)};
+    for (std::uint32_t i = 0; i < numSlots; ++i)
+    {
+        m_slots.push_back(SlotState{Slot{i * kSlotLength, kSlotLength}, std::nullopt, {}});
+    }
+}
+
+std::uint32_t NeedDataSlots::size() const
+{
+    return static_cast<std::uint32_t>(m_slots.size());
+}
+
+const NeedDataSlots::Slot &NeedDataSlots::getSlot(std::uint32_t slotIndex) const
+{
+    return m_slots.at(slotIndex).slot;
+}
+
+std::vector<std::uint32_t> NeedDataSlots::getFreeSlots(const IActiveRequests &activeRequests) const
+{
+    if (m_slots.size() == 1)
+    {
+        return {0};
+    }
+    std::vector<std::uint32_t> freeSlots;
+    for (std::uint32_t i = 0; i < m_slots.size(); ++i)
+    {
+        if (!isRequestOutstanding(m_slots[i], activeRequests) && m_slots[i].dataReader.expired())
+        {
+            freeSlots.push_back(i);
+        }
+    }
+    return freeSlots;
+}
+
+bool NeedDataSlots::hasOutstandingRequest(const IActiveRequests &activeRequests) const
+{
+    for (const auto &slotState : m_slots)
+    {
+        if (isRequestOutstanding(slotState, activeRequests))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void NeedDataSlots::setRequestId(std::uint32_t slotIndex, std::uint32_t requestId)
+{
+    m_slots.at(slotIndex).requestId = requestId;
+}
+
+std::optional<std::uint32_t> NeedDataSlots::findSlot(std::uint32_t requestId) const
+{
+    for (std::uint32_t i = 0; i < m_slots.size(); ++i)
+    {
+        if (m_slots[i].requestId == requestId)
+        {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+void NeedDataSlots::setDataReader(std::uint32_t slotIndex, const std::shared_ptr<IDataReader> &dataReader)
+{
+    SlotState &slotState{m_slots.at(slotIndex)};
+    slotState.requestId.reset();
+    slotState.dataReader = dataReader;
+}
+
+bool NeedDataSlots::isRequestOutstanding(const SlotState &slotState, const IActiveRequests &activeRequests) const
+{
+    // Requests are invalidated on flush, seek and source removal, so the slot can be requested again then
+    return slotState.requestId && MediaSourceType::UNKNOWN != activeRequests.getType(slotState.requestId.value());
+}
+} // namespace firebolt::rialto::server
@@ -29,7 +29,9 @@ namespace firebolt::rialto::server
 {
 NeedMediaData::NeedMediaData(std::weak_ptr<IMediaPipelineClient> client, IActiveRequests &activeRequests,
                              const ISharedMemoryBuffer &shmBuffer, int sessionId, MediaSourceType mediaSourceType,
-                             std::int32_t sourceId, PlaybackState currentPlaybackState)
+                             std::int32_t sourceId, PlaybackState currentPlaybackState,
+                             ShmBlockTracker *shmBlockTracker, NeedDataSizeCalculator *needDataSizeCalculator,
+                             const NeedDataSlots::Slot *slot)
     : m_client{client}, m_activeRequests{activeRequests}, m_mediaSourceType{mediaSourceType}, m_frameCount{kMaxFrames},
       m_sourceId{sourceId}, m_maxMediaBytes{0}
 {
@@ -54,7 +56,29 @@ NeedMediaData::NeedMediaData(std::weak_ptr<IMediaPipelineClient> client, IActive
             getMaxMetadataBytes();
         auto metadataOffset =
             shmBuffer.getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, sessionId, mediaSourceType);
+        if (slot)
+        {
+            // Only the part of the region assigned to this request is handed to the client
+            metadataOffset += slot->offset;
+            m_maxMediaBytes = slot->length - getMaxMetadataBytes();
+        }
         auto mediadataOffset = metadataOffset + getMaxMetadataBytes();
+        if (shmBlockTracker)
+        {
+            // Blocks lent to gstreamer cannot be overwritten, so only the largest free part is handed to the client
+            const ShmBlockTracker::WriteWindow kWriteWindow{shmBlockTracker->reserveWriteWindow()};
+            mediadataOffset += kWriteWindow.offset;
+            m_maxMediaBytes = kWriteWindow.length;
+        }
+        if (needDataSizeCalculator)
+        {
+            const NeedDataSize kSize{needDataSizeCalculator->calculateNeedDataSize(m_mediaSourceType,
+                                                                                   PlaybackState::PLAYING !=
+                                                                                       currentPlaybackState,
+                                                                                   m_maxMediaBytes)};
+            m_frameCount = kSize.frameCount;
+            m_maxMediaBytes = kSize.maxMediaBytes;
+        }
         m_shmInfo = std::make_shared<MediaPlayerShmInfo>(
             MediaPlayerShmInfo{getMaxMetadataBytes(), metadataOffset, mediadataOffset, m_maxMediaBytes});
         m_isValid = true;
@@ -68,12 +92,18 @@ NeedMediaData::NeedMediaData(std::weak_ptr<IMediaPipelineClient> client, IActive
 }
 
 bool NeedMediaData::send() const
+{
+    std::uint32_t requestId{0};
+    return send(requestId);
+}
+
+bool NeedMediaData::send(std::uint32_t &requestId) const
 {
     auto client = m_client.lock();
     if (client && m_isValid)
     {
-        client->notifyNeedMediaData(m_sourceId, m_frameCount,
-                                    m_activeRequests.insert(m_mediaSourceType, m_maxMediaBytes, m_frameCount), m_shmInfo);
+        requestId = m_activeRequests.insert(m_mediaSourceType, m_maxMediaBytes, m_frameCount);
+        client->notifyNeedMediaData(m_sourceId, m_frameCount, requestId, m_shmInfo);
         return true;
     }
     return false;
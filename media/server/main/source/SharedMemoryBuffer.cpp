@@ -18,17 +18,27 @@
  */
 
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
 #include <cstring>
+#include <iterator>
 #include <numeric>
 #include <stdexcept>
 
 #include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <syscall.h>
 #include <unistd.h>
 
 #include "RialtoServerLogging.h"
+#include "SessionServerCommon.h"
 #include "SharedMemoryBuffer.h"
+#include "ShmCommon.h"
+#include "ShmRing.h"
+#include "ShmUtils.h"
 #include "TypeConverters.h"
 
 #if !defined(SYS_memfd_create)
@@ -47,6 +57,14 @@
 #define MFD_ALLOW_SEALING 0x0002U
 #endif
 
+#if !defined(MFD_HUGETLB)
+#define MFD_HUGETLB 0x0004U
+#endif
+
+#if !defined(MADV_HUGEPAGE)
+#define MADV_HUGEPAGE 14
+#endif
+
 #if !defined(F_ADD_SEALS)
 #if !defined(F_LINUX_SPECIFIC_BASE)
 #define F_LINUX_SPECIFIC_BASE 1024
@@ -68,17 +86,24 @@ constexpr uint32_t kVideoRegionSize = 7 * 1024 * 1024; // 7MB
 constexpr uint32_t kAudioRegionSize = 1 * 1024 * 1024; // 1MB
 constexpr uint32_t kSubtitleRegionSize = 256 * 1024;   // 256kB
 constexpr uint32_t kWebAudioRegionSize = 10 * 1024;    // 10KB
+constexpr uint32_t kGenericPartitionSize = kVideoRegionSize + kAudioRegionSize + kSubtitleRegionSize;
+constexpr uint32_t kRegionAlignment = 64;
+constexpr uint32_t kLatestMetadataVersion = 3;
 
 std::vector<firebolt::rialto::server::SharedMemoryBuffer::Partition>
 calculatePartitionSize(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int num)
 {
     if (firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC == playbackType)
     {
-        // As (for now) resolution of playback (for example HD or UHD) is not known, partitions have the same size.
-        firebolt::rialto::server::SharedMemoryBuffer::Partition singlePlaybackDataBuffer{kNoIdAssigned, kAudioRegionSize,
-                                                                                         kVideoRegionSize,
-                                                                                         kSubtitleRegionSize};
-        return std::vector<firebolt::rialto::server::SharedMemoryBuffer::Partition>(num, singlePlaybackDataBuffer);
+        // Partitions start with the same size, which is enough for any playback. They may be resized, when the
+        // attached sources are known.
+        std::vector<firebolt::rialto::server::SharedMemoryBuffer::Partition> partitions;
+        for (int i = 0; i < num; ++i)
+        {
+            partitions.push_back({kNoIdAssigned, kAudioRegionSize, kVideoRegionSize, kSubtitleRegionSize,
+                                  static_cast<uint32_t>(i) * kGenericPartitionSize});
+        }
+        return partitions;
     }
     else if (firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::WEB_AUDIO == playbackType)
     {
@@ -91,6 +116,85 @@ calculatePartitionSize(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlayb
     }
 }
 
+uint32_t getPartitionLen(const firebolt::rialto::server::SharedMemoryBuffer::Partition &partition)
+{
+    return partition.dataBufferVideoLen + partition.dataBufferAudioLen + partition.dataBufferSubtitleLen;
+}
+
+uint32_t alignRegionSize(uint32_t size)
+{
+    return (size + kRegionAlignment - 1) & ~(kRegionAlignment - 1);
+}
+
+void publishNewGeneration(std::uint8_t *regionData)
+{
+    // Publishing a new generation invalidates everything written to the region so far, so that the media data
+    // does not have to be zeroed before the next NeedMediaData.
+    firebolt::rialto::common::ShmRegionHeader header;
+    std::memcpy(&header, regionData + firebolt::rialto::common::SHM_REGION_HEADER_OFFSET, sizeof(header));
+    std::uint32_t generation{firebolt::rialto::common::SHM_REGION_HEADER_MAGIC == header.magic ? header.generation + 1
+                                                                                                : 1};
+    if (0 == generation)
+    {
+        generation = 1;
+    }
+    header = {firebolt::rialto::common::SHM_REGION_HEADER_MAGIC, generation, 0, 0, 0,
+              firebolt::rialto::common::SHM_REGION_METADATA_VERSION_TAG | kLatestMetadataVersion};
+    std::memset(regionData, 0x00, firebolt::rialto::common::VERSION_SIZE_BYTES);
+    std::memcpy(regionData + firebolt::rialto::common::SHM_REGION_HEADER_OFFSET, &header, sizeof(header));
+}
+
+std::uint32_t getRingCapacity(std::uint32_t regionLen)
+{
+    // The ring needs a power of two capacity, so the region is usually not used completely
+    std::uint32_t capacity{0};
+    for (std::uint32_t candidate = 1;
+         candidate != 0 && firebolt::rialto::ipc::ShmRing::regionSize(candidate) <= regionLen; candidate <<= 1)
+    {
+        capacity = candidate;
+    }
+    return capacity;
+}
+
+/**
+ * @brief The backing of the memory buffer requested by the server manager.
+ */
+struct BufferBacking
+{
+    bool hugePages;
+    bool populate;
+    bool lock;
+};
+
+BufferBacking getRequestedBacking()
+{
+    BufferBacking backing{false, false, false};
+    const char *kPages = std::getenv(firebolt::rialto::common::kSharedMemoryPagesEnvVar);
+    if (kPages)
+    {
+        backing.hugePages = std::string{kPages} == "huge";
+    }
+    const char *kPrefault = std::getenv(firebolt::rialto::common::kSharedMemoryPrefaultEnvVar);
+    if (kPrefault)
+    {
+        const std::string kValue{kPrefault};
+        backing.lock = kValue == "lock";
+        backing.populate = backing.lock || kValue == "populate";
+    }
+    return backing;
+}
+
+void prefaultPages(std::uint8_t *buffer, size_t bufferLen)
+{
+    // The memfd is zero filled, so writing zeros only faults the pages in
+    const long kPageSize{sysconf(_SC_PAGESIZE)};
+    const size_t kStep{kPageSize > 0 ? static_cast<size_t>(kPageSize) : 4096};
+    for (size_t offset = 0; offset < bufferLen; offset += kStep)
+    {
+        reinterpret_cast<volatile std::uint8_t *>(buffer)[offset] = 0;
+    }
+}
+
 const char *toString(const firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType &type)
 {
     switch (type)
@@ -124,40 +228,34 @@ SharedMemoryBufferFactory::createSharedMemoryBuffer(unsigned numOfPlaybacks, uns
 SharedMemoryBuffer::SharedMemoryBuffer(unsigned numOfPlaybacks, unsigned numOfWebAudioPlayers)
     : m_genericPartitions{calculatePartitionSize(MediaPlaybackType::GENERIC, numOfPlaybacks)},
       m_webAudioPartitions{calculatePartitionSize(MediaPlaybackType::WEB_AUDIO, numOfWebAudioPlayers)},
-      m_dataBufferLen{0}, m_dataBufferFd{-1}, m_dataBuffer{nullptr}
+      m_genericPoolLen{numOfPlaybacks * kGenericPartitionSize},
+      m_dataBufferLen{0}, m_dataBufferFd{-1}, m_dataBuffer{nullptr}, m_doorbellWakeFd{-1},
+      m_isDoorbellThreadRunning{false}
 {
-    int fd = syscall(SYS_memfd_create, kMemoryBufferName, MFD_CLOEXEC | MFD_ALLOW_SEALING);
-    if (fd < 0)
-    {
-        RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to create memory buffer");
-    }
-    else
+    const BufferBacking kBacking{getRequestedBacking()};
+    const char *pages{"regular"};
+    if (kBacking.hugePages)
     {
-        const size_t kBufferSize{calculateBufferSize()};
-        if (ftruncate(fd, static_cast<off_t>(kBufferSize)) == -1)
+        if (createDataBuffer(MFD_HUGETLB))
         {
-            RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to resize memfd");
-        }
-        else if (fcntl(fd, F_ADD_SEALS, (F_SEAL_SEAL | F_SEAL_GROW | F_SEAL_SHRINK)) == -1)
-        {
-            RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to seal memfd");
+            pages = "huge (hugetlb)";
         }
         else
         {
-            void *addr = mmap(nullptr, kBufferSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
-            if (addr != MAP_FAILED)
-            {
-                m_dataBufferLen = kBufferSize;
-                m_dataBufferFd = fd;
-                m_dataBuffer = reinterpret_cast<uint8_t *>(addr);
-                RIALTO_SERVER_LOG_INFO("Shared Memory Buffer size: %d, ptr: %p", m_dataBufferLen, m_dataBuffer);
-            }
+            RIALTO_SERVER_LOG_WARN("Huge pages not available, falling back to transparent huge pages");
         }
+    }
 
-        if (m_dataBufferFd == -1)
+    if (m_dataBufferFd == -1 && createDataBuffer(0) && kBacking.hugePages)
+    {
+        // Transparent huge pages are used for shared memory only if the kernel's shmem_enabled setting allows it
+        if (madvise(m_dataBuffer, m_dataBufferLen, MADV_HUGEPAGE) == 0)
         {
-            if (close(fd) != 0)
-                RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to close fd");
+            pages = "transparent huge (advised)";
+        }
+        else
+        {
+            RIALTO_SERVER_LOG_SYS_WARN(errno, "transparent huge pages not available");
         }
     }
 
@@ -166,11 +264,36 @@ SharedMemoryBuffer::SharedMemoryBuffer(unsigned numOfPlaybacks, unsigned numOfWe
         RIALTO_SERVER_LOG_ERROR("Shared Memory Buffer initialization failed");
         throw std::runtime_error("Shared Memory Buffer initialization failed");
     }
+
+    const char *faults{"on demand"};
+    if (kBacking.lock && mlock(m_dataBuffer, m_dataBufferLen) == 0)
+    {
+        faults = "at startup (locked)";
+    }
+    else
+    {
+        if (kBacking.lock)
+        {
+            RIALTO_SERVER_LOG_SYS_WARN(errno, "failed to lock memory buffer, populating it instead");
+        }
+        if (kBacking.populate)
+        {
+            prefaultPages(m_dataBuffer, m_dataBufferLen);
+            faults = "at startup";
+        }
+    }
+    RIALTO_SERVER_LOG_MIL("Shared Memory Buffer uses %s pages, faulted in %s", pages, faults);
 }
 
 SharedMemoryBuffer::~SharedMemoryBuffer()
 {
     RIALTO_SERVER_LOG_INFO("Destroying Shared Memory Buffer");
+    stopDoorbellThread();
+    for (const auto &doorbell : m_doorbells)
+    {
+        if (close(doorbell.second.fd) != 0)
+            RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to close doorbell fd");
+    }
     if (m_dataBufferFd != -1)
     {
         if (munmap(m_dataBuffer, m_dataBufferLen) != 0)
@@ -184,8 +307,54 @@ SharedMemoryBuffer::~SharedMemoryBuffer()
     }
 }
 
+bool SharedMemoryBuffer::createDataBuffer(unsigned int memfdFlags)
+{
+    int fd = syscall(SYS_memfd_create, kMemoryBufferName, MFD_CLOEXEC | MFD_ALLOW_SEALING | memfdFlags);
+    if (fd < 0)
+    {
+        RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to create memory buffer");
+        return false;
+    }
+
+    size_t bufferSize{calculateBufferSize()};
+    struct stat fdStat;
+    if ((memfdFlags & MFD_HUGETLB) && fstat(fd, &fdStat) == 0 && fdStat.st_blksize > 0)
+    {
+        // The size of a hugetlb file must be a multiple of the huge page size
+        const size_t kHugePageSize{static_cast<size_t>(fdStat.st_blksize)};
+        bufferSize = (bufferSize + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(bufferSize)) == -1)
+    {
+        RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to resize memfd");
+    }
+    else if (fcntl(fd, F_ADD_SEALS, (F_SEAL_SEAL | F_SEAL_GROW | F_SEAL_SHRINK)) == -1)
+    {
+        RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to seal memfd");
+    }
+    else
+    {
+        void *addr = mmap(nullptr, bufferSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED)
+        {
+            m_dataBufferLen = bufferSize;
+            m_dataBufferFd = fd;
+            m_dataBuffer = reinterpret_cast<uint8_t *>(addr);
+            RIALTO_SERVER_LOG_INFO("Shared Memory Buffer size: %d, ptr: %p", m_dataBufferLen, m_dataBuffer);
+            return true;
+        }
+        RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to map memfd");
+    }
+
+    if (close(fd) != 0)
+        RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to close fd");
+    return false;
+}
+
 bool SharedMemoryBuffer::mapPartition(MediaPlaybackType playbackType, int id)
 {
+    std::lock_guard<std::recursive_mutex> partitionsLock{m_partitionsMutex};
     std::vector<Partition> *partitions = getPlaybackTypePartition(playbackType);
     if (!partitions)
     {
@@ -206,12 +375,120 @@ bool SharedMemoryBuffer::mapPartition(MediaPlaybackType playbackType, int id)
         RIALTO_SERVER_LOG_ERROR("Failed to map Shm partition for id: %d. No free partition available.", id);
         return false;
     }
+    if (MediaPlaybackType::GENERIC == playbackType)
+    {
+        std::uint32_t offset{0};
+        if (!findFreeGenericBlock(kGenericPartitionSize, kNoIdAssigned, offset))
+        {
+            RIALTO_SERVER_LOG_ERROR("Failed to map Shm partition for id: %d. No free memory available.", id);
+            return false;
+        }
+        *freePartition = {kNoIdAssigned, kAudioRegionSize, kVideoRegionSize, kSubtitleRegionSize, offset};
+    }
     freePartition->id = id;
     return true;
 }
 
+bool SharedMemoryBuffer::resizePartition(MediaPlaybackType playbackType, int id, const PartitionSizes &sizes)
+{
+    std::lock_guard<std::recursive_mutex> partitionsLock{m_partitionsMutex};
+    if (MediaPlaybackType::GENERIC != playbackType)
+    {
+        RIALTO_SERVER_LOG_ERROR("Cannot resize the partition for playback type %s with id: %d", toString(playbackType),
+                                id);
+        return false;
+    }
+    auto partition = std::find_if(m_genericPartitions.begin(), m_genericPartitions.end(),
+                                  [id](const auto &p) { return p.id == id; });
+    if (partition == m_genericPartitions.end())
+    {
+        RIALTO_SERVER_LOG_WARN("Failed to resize Shm partition for id: %d. - partition could not be found", id);
+        return false;
+    }
+    if (isStreaming(id, MediaSourceType::VIDEO) || isStreaming(id, MediaSourceType::AUDIO) ||
+        isStreaming(id, MediaSourceType::SUBTITLE))
+    {
+        RIALTO_SERVER_LOG_WARN("Failed to resize Shm partition for id: %d. - a region is in streaming mode", id);
+        return false;
+    }
+    for (std::uint32_t regionLen : {sizes.videoLen, sizes.audioLen, sizes.subtitleLen})
+    {
+        if (0 != regionLen && regionLen < getMaxMetadataBytes())
+        {
+            RIALTO_SERVER_LOG_ERROR("Failed to resize Shm partition for id: %d. - region of %u bytes is too small", id,
+                                    regionLen);
+            return false;
+        }
+    }
+    const std::uint32_t kVideoLen{alignRegionSize(sizes.videoLen)};
+    const std::uint32_t kAudioLen{alignRegionSize(sizes.audioLen)};
+    const std::uint32_t kSubtitleLen{alignRegionSize(sizes.subtitleLen)};
+    const std::uint32_t kNewLen{kVideoLen + kAudioLen + kSubtitleLen};
+
+    // Each partition that is not mapped yet must still be able to get the default size
+    const auto kNumOfFreePartitions = static_cast<std::uint32_t>(std::count_if(
+        m_genericPartitions.begin(), m_genericPartitions.end(), [](const auto &p) { return p.id == kNoIdAssigned; }));
+    const std::uint32_t kFreeBytes{getFreeGenericBytes(id)};
+    std::uint32_t offset{0};
+    if (kFreeBytes < kNewLen || kFreeBytes - kNewLen < kNumOfFreePartitions * kGenericPartitionSize ||
+        !findFreeGenericBlock(kNewLen, id, offset))
+    {
+        RIALTO_SERVER_LOG_WARN("Failed to resize Shm partition for id: %d to %u bytes. - not enough free memory", id,
+                               kNewLen);
+        return false;
+    }
+
+    // Keep the partition in place if it still fits there, so that the free memory does not get fragmented
+    const std::uint32_t kCurrentOffset{partition->dataOffset};
+    if (std::none_of(m_genericPartitions.begin(), m_genericPartitions.end(),
+                     [&](const auto &p)
+                     {
+                         return p.id != kNoIdAssigned && p.id != id && p.dataOffset < kCurrentOffset + kNewLen &&
+                                kCurrentOffset < p.dataOffset + getPartitionLen(p);
+                     }) &&
+        kCurrentOffset + kNewLen <= m_genericPoolLen)
+    {
+        offset = kCurrentOffset;
+    }
+    *partition = {id, kAudioLen, kVideoLen, kSubtitleLen, offset};
+    RIALTO_SERVER_LOG_INFO("Shm partition for id: %d resized - video: %u, audio: %u, subtitle: %u, offset: %u", id,
+                           kVideoLen, kAudioLen, kSubtitleLen, offset);
+    return true;
+}
+
+std::vector<ISharedMemoryBuffer::PartitionUsage>
+SharedMemoryBuffer::getPartitionUsage(MediaPlaybackType playbackType) const
+{
+    std::lock_guard<std::recursive_mutex> partitionsLock{m_partitionsMutex};
+    std::vector<PartitionUsage> usage;
+    const std::vector<Partition> *kPartitions = getPlaybackTypePartition(playbackType);
+    if (!kPartitions)
+    {
+        return usage;
+    }
+    for (const auto &partition : *kPartitions)
+    {
+        if (kNoIdAssigned == partition.id)
+        {
+            continue;
+        }
+        std::uint32_t usedBytes{0};
+        if (MediaPlaybackType::GENERIC == playbackType)
+        {
+            const std::uint8_t *kPartitionData{m_dataBuffer + partition.dataOffset};
+            usedBytes = getUsedBytes(kPartitionData, partition.dataBufferVideoLen) +
+                        getUsedBytes(kPartitionData + partition.dataBufferVideoLen, partition.dataBufferAudioLen) +
+                        getUsedBytes(kPartitionData + partition.dataBufferVideoLen + partition.dataBufferAudioLen,
+                                     partition.dataBufferSubtitleLen);
+        }
+        usage.push_back({partition.id, getPartitionLen(partition), usedBytes});
+    }
+    return usage;
+}
+
 bool SharedMemoryBuffer::unmapPartition(MediaPlaybackType playbackType, int id)
 {
+    std::lock_guard<std::recursive_mutex> partitionsLock{m_partitionsMutex};
     std::vector<Partition> *partitions = getPlaybackTypePartition(playbackType);
     if (!partitions)
     {
@@ -226,12 +503,17 @@ bool SharedMemoryBuffer::unmapPartition(MediaPlaybackType playbackType, int id)
         RIALTO_SERVER_LOG_WARN("Failed to unmap Shm partition for id: %d. - partition could not be found", id);
         return false;
     }
+    if (MediaPlaybackType::GENERIC == playbackType)
+    {
+        closeDoorbells(id);
+    }
     partition->id = kNoIdAssigned;
     return true;
 }
 
 bool SharedMemoryBuffer::clearData(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType) const
 {
+    std::lock_guard<std::recursive_mutex> partitionsLock{m_partitionsMutex};
     const std::vector<Partition> *kPartitions = getPlaybackTypePartition(playbackType);
     if (!kPartitions)
     {
@@ -258,26 +540,147 @@ bool SharedMemoryBuffer::clearData(MediaPlaybackType playbackType, int id, const
         return false;
     }
 
+    std::uint8_t *regionData = nullptr;
+    std::uint32_t regionLen = 0;
     if (MediaSourceType::VIDEO == mediaSourceType)
     {
-        std::uint8_t *videoData = partitionDataPtr;
-        memset(videoData, 0x00, partition->dataBufferVideoLen);
-        return true;
+        regionData = partitionDataPtr;
+        regionLen = partition->dataBufferVideoLen;
     }
-    if (MediaSourceType::AUDIO == mediaSourceType)
+    else if (MediaSourceType::AUDIO == mediaSourceType)
+    {
+        regionData = partitionDataPtr + partition->dataBufferVideoLen;
+        regionLen = partition->dataBufferAudioLen;
+    }
+    else if (MediaSourceType::SUBTITLE == mediaSourceType)
+    {
+        regionData = partitionDataPtr + partition->dataBufferVideoLen + partition->dataBufferAudioLen;
+        regionLen = partition->dataBufferSubtitleLen;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (MediaPlaybackType::GENERIC == playbackType && isStreaming(id, mediaSourceType))
     {
-        std::uint8_t *audioData = partitionDataPtr + partition->dataBufferVideoLen;
-        memset(audioData, 0x00, partition->dataBufferAudioLen);
+        // The client may be writing to the ring, which is emptied by its reader only
         return true;
     }
-    if (MediaSourceType::SUBTITLE == mediaSourceType)
+    if (MediaPlaybackType::GENERIC == playbackType && regionLen >= getMaxMetadataBytes())
+    {
+        publishNewGeneration(regionData);
+    }
+    else
+    {
+        memset(regionData, 0x00, regionLen);
+    }
+    return true;
+}
+
+bool SharedMemoryBuffer::clearData(MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType,
+                                   std::uint32_t offset) const
+{
+    std::lock_guard<std::recursive_mutex> partitionsLock{m_partitionsMutex};
+    if (0 == offset)
+    {
+        return clearData(playbackType, id, mediaSourceType);
+    }
+    if (MediaPlaybackType::GENERIC != playbackType)
+    {
+        RIALTO_SERVER_LOG_ERROR("Clearing a part of the %s data is not supported for playback type %s",
+                                common::convertMediaSourceType(mediaSourceType), toString(playbackType));
+        return false;
+    }
+    if (isStreaming(id, mediaSourceType))
     {
-        std::uint8_t *subtitleoData = partitionDataPtr + partition->dataBufferVideoLen + partition->dataBufferAudioLen;
-        memset(subtitleoData, 0x00, partition->dataBufferSubtitleLen);
         return true;
     }
+    std::uint8_t *regionData = getDataPtr(playbackType, id, mediaSourceType);
+    const std::uint32_t kRegionLen = getMaxDataLen(playbackType, id, mediaSourceType);
+    if (!regionData || offset >= kRegionLen || kRegionLen - offset < getMaxMetadataBytes())
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to clear %s data at offset %u for playback type %s with id: %d",
+                                common::convertMediaSourceType(mediaSourceType), offset, toString(playbackType), id);
+        return false;
+    }
+    publishNewGeneration(regionData + offset);
+    return true;
+}
 
-    return false;
+bool SharedMemoryBuffer::enableStreamingMode(MediaPlaybackType playbackType, int id,
+                                             const MediaSourceType &mediaSourceType,
+                                             std::function<void()> &&doorbellCallback, StreamingRing &ring)
+{
+    std::lock_guard<std::recursive_mutex> partitionsLock{m_partitionsMutex};
+    if (MediaPlaybackType::GENERIC != playbackType)
+    {
+        RIALTO_SERVER_LOG_ERROR("Streaming mode is not supported for playback type %s", toString(playbackType));
+        return false;
+    }
+    std::uint8_t *regionData = getDataPtr(playbackType, id, mediaSourceType);
+    const std::uint32_t kCapacity{getRingCapacity(getMaxDataLen(playbackType, id, mediaSourceType))};
+    if (!regionData || 0 == kCapacity)
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to enable streaming mode for %s with id: %d - region not found",
+                                common::convertMediaSourceType(mediaSourceType), id);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> doorbellLock{m_doorbellMutex};
+    if (m_doorbells.find(std::make_pair(id, mediaSourceType)) != m_doorbells.end())
+    {
+        RIALTO_SERVER_LOG_ERROR("Streaming mode already enabled for %s with id: %d",
+                                common::convertMediaSourceType(mediaSourceType), id);
+        return false;
+    }
+    if (!startDoorbellThread())
+    {
+        return false;
+    }
+    ipc::ShmRing consumer;
+    if (!consumer.init(regionData, kCapacity))
+    {
+        RIALTO_SERVER_LOG_ERROR("Failed to enable streaming mode for %s with id: %d - ring of %u bytes not created",
+                                common::convertMediaSourceType(mediaSourceType), id, kCapacity);
+        return false;
+    }
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0)
+    {
+        RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to create doorbell");
+        return false;
+    }
+    m_doorbells.emplace(std::make_pair(id, mediaSourceType), Doorbell{fd, std::move(doorbellCallback)});
+    wakeDoorbellThread();
+
+    ring = {fd, static_cast<std::uint32_t>(regionData - m_dataBuffer), kCapacity};
+    RIALTO_SERVER_LOG_INFO("Streaming mode enabled for %s with id: %d, ring capacity: %u",
+                           common::convertMediaSourceType(mediaSourceType), id, kCapacity);
+    return true;
+}
+
+bool SharedMemoryBuffer::disableStreamingMode(MediaPlaybackType playbackType, int id,
+                                              const MediaSourceType &mediaSourceType)
+{
+    std::lock_guard<std::recursive_mutex> partitionsLock{m_partitionsMutex};
+    {
+        std::lock_guard<std::mutex> doorbellLock{m_doorbellMutex};
+        auto doorbellIt = m_doorbells.find(std::make_pair(id, mediaSourceType));
+        if (MediaPlaybackType::GENERIC != playbackType || doorbellIt == m_doorbells.end())
+        {
+            RIALTO_SERVER_LOG_WARN("Streaming mode not enabled for %s with id: %d",
+                                   common::convertMediaSourceType(mediaSourceType), id);
+            return false;
+        }
+        if (close(doorbellIt->second.fd) != 0)
+            RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to close doorbell fd");
+        m_doorbells.erase(doorbellIt);
+        wakeDoorbellThread();
+    }
+
+    // Overwriting the ring header makes the region usable for NeedMediaData requests again
+    return clearData(playbackType, id, mediaSourceType);
 }
 
 std::uint32_t SharedMemoryBuffer::getDataOffset(MediaPlaybackType playbackType, int id,
@@ -295,6 +698,7 @@ std::uint32_t SharedMemoryBuffer::getDataOffset(MediaPlaybackType playbackType,
 std::uint32_t SharedMemoryBuffer::getMaxDataLen(MediaPlaybackType playbackType, int id,
                                                 const MediaSourceType &mediaSourceType) const
 {
+    std::lock_guard<std::recursive_mutex> partitionsLock{m_partitionsMutex};
     const std::vector<Partition> *kPartitions = getPlaybackTypePartition(playbackType);
     if (!kPartitions)
     {
@@ -332,6 +736,7 @@ std::uint32_t SharedMemoryBuffer::getMaxDataLen(MediaPlaybackType playbackType,
 std::uint8_t *SharedMemoryBuffer::getDataPtr(MediaPlaybackType playbackType, int id,
                                              const MediaSourceType &mediaSourceType) const
 {
+    std::lock_guard<std::recursive_mutex> partitionsLock{m_partitionsMutex};
     const std::vector<Partition> *kPartitions = getPlaybackTypePartition(playbackType);
     if (!kPartitions)
     {
@@ -391,29 +796,207 @@ std::uint8_t *SharedMemoryBuffer::getBuffer() const
 
 size_t SharedMemoryBuffer::calculateBufferSize() const
 {
-    size_t genericSum =
-        std::accumulate(m_genericPartitions.begin(), m_genericPartitions.end(), 0, [](size_t sum, const Partition &p)
-                        { return sum + p.dataBufferAudioLen + p.dataBufferVideoLen + p.dataBufferSubtitleLen; });
     size_t webAudioSum = std::accumulate(m_webAudioPartitions.begin(), m_webAudioPartitions.end(), 0,
                                          [](size_t sum, const Partition &p)
                                          { return sum + p.dataBufferAudioLen + p.dataBufferVideoLen; });
-    return genericSum + webAudioSum;
+    return m_genericPoolLen + webAudioSum;
 }
 
-bool SharedMemoryBuffer::getDataPtrForPartition(MediaPlaybackType playbackType, int id, std::uint8_t **ptr) const
+bool SharedMemoryBuffer::findFreeGenericBlock(std::uint32_t size, int excludedId, std::uint32_t &offset) const
 {
-    std::uint8_t *result = m_dataBuffer;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> usedBlocks;
+    for (const auto &partition : m_genericPartitions)
+    {
+        if (partition.id != kNoIdAssigned && partition.id != excludedId && getPartitionLen(partition) > 0)
+        {
+            usedBlocks.emplace_back(partition.dataOffset, getPartitionLen(partition));
+        }
+    }
+    std::sort(usedBlocks.begin(), usedBlocks.end());
 
+    std::uint32_t gapStart{0};
+    for (const auto &block : usedBlocks)
+    {
+        if (block.first >= gapStart && block.first - gapStart >= size)
+        {
+            offset = gapStart;
+            return true;
+        }
+        gapStart = std::max(gapStart, block.first + block.second);
+    }
+    if (m_genericPoolLen >= gapStart && m_genericPoolLen - gapStart >= size)
+    {
+        offset = gapStart;
+        return true;
+    }
+    return false;
+}
+
+std::uint32_t SharedMemoryBuffer::getFreeGenericBytes(int excludedId) const
+{
+    std::uint32_t usedBytes{0};
+    for (const auto &partition : m_genericPartitions)
+    {
+        if (partition.id != kNoIdAssigned && partition.id != excludedId)
+        {
+            usedBytes += getPartitionLen(partition);
+        }
+    }
+    return m_genericPoolLen - usedBytes;
+}
+
+std::uint32_t SharedMemoryBuffer::getUsedBytes(const std::uint8_t *regionData, std::uint32_t regionLen) const
+{
+    if (regionLen >= getMaxMetadataBytes())
+    {
+        common::ShmRegionHeader header;
+        std::memcpy(&header, regionData + common::SHM_REGION_HEADER_OFFSET, sizeof(header));
+        if (common::SHM_REGION_HEADER_MAGIC == header.magic && header.generation == header.committedGeneration)
+        {
+            return std::min(regionLen, getMaxMetadataBytes() + header.validLength);
+        }
+    }
+    return 0;
+}
+
+bool SharedMemoryBuffer::isStreaming(int id, const MediaSourceType &mediaSourceType) const
+{
+    std::lock_guard<std::mutex> doorbellLock{m_doorbellMutex};
+    return m_doorbells.find(std::make_pair(id, mediaSourceType)) != m_doorbells.end();
+}
+
+void SharedMemoryBuffer::closeDoorbells(int id)
+{
+    std::lock_guard<std::mutex> doorbellLock{m_doorbellMutex};
+    for (auto doorbellIt = m_doorbells.begin(); doorbellIt != m_doorbells.end();)
+    {
+        if (doorbellIt->first.first == id)
+        {
+            if (close(doorbellIt->second.fd) != 0)
+                RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to close doorbell fd");
+            doorbellIt = m_doorbells.erase(doorbellIt);
+        }
+        else
+        {
+            ++doorbellIt;
+        }
+    }
+    wakeDoorbellThread();
+}
+
+bool SharedMemoryBuffer::startDoorbellThread()
+{
+    if (m_isDoorbellThreadRunning)
+    {
+        return true;
+    }
+    m_doorbellWakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_doorbellWakeFd < 0)
+    {
+        RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to create doorbell wake fd");
+        return false;
+    }
+    m_isDoorbellThreadRunning = true;
+    m_doorbellThread = std::thread(&SharedMemoryBuffer::doorbellThreadLoop, this);
+    return true;
+}
+
+void SharedMemoryBuffer::stopDoorbellThread()
+{
+    {
+        std::lock_guard<std::mutex> doorbellLock{m_doorbellMutex};
+        if (!m_isDoorbellThreadRunning)
+        {
+            return;
+        }
+        m_isDoorbellThreadRunning = false;
+        wakeDoorbellThread();
+    }
+    if (m_doorbellThread.joinable())
+    {
+        m_doorbellThread.join();
+    }
+    if (close(m_doorbellWakeFd) != 0)
+        RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to close doorbell wake fd");
+    m_doorbellWakeFd = -1;
+}
+
+void SharedMemoryBuffer::doorbellThreadLoop()
+{
+    while (true)
+    {
+        std::vector<pollfd> pollFds;
+        {
+            std::lock_guard<std::mutex> doorbellLock{m_doorbellMutex};
+            if (!m_isDoorbellThreadRunning)
+            {
+                return;
+            }
+            pollFds.push_back({m_doorbellWakeFd, POLLIN, 0});
+            for (const auto &doorbell : m_doorbells)
+            {
+                pollFds.push_back({doorbell.second.fd, POLLIN, 0});
+            }
+        }
+
+        if (poll(pollFds.data(), pollFds.size(), -1) < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            RIALTO_SERVER_LOG_SYS_ERROR(errno, "doorbell poll failed");
+            return;
+        }
+
+        eventfd_t value{0};
+        if (pollFds.front().revents & POLLIN)
+        {
+            eventfd_read(m_doorbellWakeFd, &value);
+        }
+
+        // The doorbells may have been closed while polling, so only the ones that are still enabled are used. A
+        // closed fd number may have been reused by a new doorbell, which then just gets a spurious call.
+        std::lock_guard<std::mutex> doorbellLock{m_doorbellMutex};
+        for (auto pollFdIt = std::next(pollFds.begin()); pollFdIt != pollFds.end(); ++pollFdIt)
+        {
+            if (!(pollFdIt->revents & POLLIN))
+            {
+                continue;
+            }
+            auto doorbellIt = std::find_if(m_doorbells.begin(), m_doorbells.end(),
+                                           [fd = pollFdIt->fd](const auto &doorbell)
+                                           { return doorbell.second.fd == fd; });
+            if (doorbellIt != m_doorbells.end() && eventfd_read(doorbellIt->second.fd, &value) == 0 &&
+                doorbellIt->second.callback)
+            {
+                doorbellIt->second.callback();
+            }
+        }
+    }
+}
+
+void SharedMemoryBuffer::wakeDoorbellThread() const
+{
+    if (m_doorbellWakeFd >= 0 && eventfd_write(m_doorbellWakeFd, 1) != 0)
+    {
+        RIALTO_SERVER_LOG_SYS_ERROR(errno, "failed to wake the doorbell thread");
+    }
+}
+
+bool SharedMemoryBuffer::getDataPtrForPartition(MediaPlaybackType playbackType, int id, std::uint8_t **ptr) const
+{
     for (const auto &partition : m_genericPartitions)
     {
         if ((MediaPlaybackType::GENERIC == playbackType) && (partition.id == id))
         {
-            *ptr = result;
+            *ptr = m_dataBuffer + partition.dataOffset;
             return true;
         }
-        result += (partition.dataBufferVideoLen + partition.dataBufferAudioLen + partition.dataBufferSubtitleLen);
     }
 
+    std::uint8_t *result = m_dataBuffer + m_genericPoolLen;
+
     for (const auto &partition : m_webAudioPartitions)
     {
         if ((MediaPlaybackType::WEB_AUDIO == playbackType) && (partition.id == id))
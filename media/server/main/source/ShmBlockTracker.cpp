@@ -0,0 +1,106 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShmBlockTracker.h"
+#include "RialtoServerLogging.h"
+#include <algorithm>
+
+namespace
+{
+/**
+ * @brief At most 1/kMaxLentFraction of the media data area can be lent to gstreamer. Above that the free space left for
+ *        the client becomes too fragmented and the data is copied instead.
+ */
+constexpr std::uint32_t kMaxLentFraction{2};
+} // namespace
+
+namespace firebolt::rialto::server
+{
+ShmBlockTracker::ShmBlockTracker(const std::uint8_t *mediaData, std::uint32_t mediaDataLen)
+    : m_kMediaData{mediaData}, m_kMediaDataLen{mediaDataLen}, m_lentBytes{0}, m_writeWindow{0, mediaDataLen}
+{
+}
+
+bool ShmBlockTracker::lend(const std::uint8_t *data, std::uint32_t size)
+{
+    if (!data || 0 == size || data < m_kMediaData || data + size > m_kMediaData + m_kMediaDataLen)
+    {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock{m_mutex};
+    if (m_lentBytes + size > m_kMediaDataLen / kMaxLentFraction)
+    {
+        RIALTO_SERVER_LOG_DEBUG("Shm region too fragmented to lend %u bytes, %u bytes already lent", size, m_lentBytes);
+        return false;
+    }
+    const std::uint32_t kOffset = data - m_kMediaData;
+    if (!m_lentBlocks.emplace(kOffset, size).second)
+    {
+        return false;
+    }
+    m_lentBytes += size;
+    return true;
+}
+
+void ShmBlockTracker::release(const std::uint8_t *data)
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    auto block = m_lentBlocks.find(data - m_kMediaData);
+    if (block == m_lentBlocks.end())
+    {
+        RIALTO_SERVER_LOG_WARN("Released shm block was not lent");
+        return;
+    }
+    m_lentBytes -= block->second;
+    m_lentBlocks.erase(block);
+}
+
+ShmBlockTracker::WriteWindow ShmBlockTracker::reserveWriteWindow()
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    WriteWindow largestGap{0, 0};
+    std::uint32_t gapStart{0};
+    for (const auto &[kOffset, kSize] : m_lentBlocks)
+    {
+        if (kOffset > gapStart && kOffset - gapStart > largestGap.length)
+        {
+            largestGap = WriteWindow{gapStart, kOffset - gapStart};
+        }
+        gapStart = std::max(gapStart, kOffset + kSize);
+    }
+    if (m_kMediaDataLen > gapStart && m_kMediaDataLen - gapStart > largestGap.length)
+    {
+        largestGap = WriteWindow{gapStart, m_kMediaDataLen - gapStart};
+    }
+    m_writeWindow = largestGap;
+    return m_writeWindow;
+}
+
+bool ShmBlockTracker::hasLentBlocks() const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return !m_lentBlocks.empty();
+}
+
+ShmBlockTracker::WriteWindow ShmBlockTracker::getWriteWindow() const
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    return m_writeWindow;
+}
+} // namespace firebolt::rialto::server
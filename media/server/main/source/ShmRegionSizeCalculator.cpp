@@ -0,0 +1,127 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShmRegionSizeCalculator.h"
+#include <algorithm>
+#include <string>
+
+namespace
+{
+constexpr std::uint32_t kUhdVideoRegionSize{7 * 1024 * 1024};          // 7MB
+constexpr std::uint32_t kHdVideoRegionSize{4 * 1024 * 1024};           // 4MB
+constexpr std::uint32_t kSdVideoRegionSize{2 * 1024 * 1024};           // 2MB
+constexpr std::uint32_t kMultichannelAudioRegionSize{1 * 1024 * 1024}; // 1MB
+constexpr std::uint32_t kStereoAudioRegionSize{256 * 1024};            // 256kB
+constexpr std::uint32_t kSubtitleRegionSize{256 * 1024};               // 256kB
+constexpr std::int64_t kMaxHdPixels{1920 * 1088};
+constexpr std::int64_t kMaxSdPixels{1024 * 576};
+
+std::uint32_t calculateVideoRegionSize(std::int32_t width, std::int32_t height)
+{
+    if (width <= 0 || height <= 0)
+    {
+        // Resolution is unknown, so the region has to be big enough for UHD
+        return kUhdVideoRegionSize;
+    }
+    const std::int64_t kPixels{static_cast<std::int64_t>(width) * height};
+    if (kPixels > kMaxHdPixels)
+    {
+        return kUhdVideoRegionSize;
+    }
+    if (kPixels > kMaxSdPixels)
+    {
+        return kHdVideoRegionSize;
+    }
+    return kSdVideoRegionSize;
+}
+
+std::uint32_t calculateVideoRegionSize(const firebolt::rialto::IMediaPipeline::MediaSource &source)
+{
+    const auto *kVideoSource = dynamic_cast<const firebolt::rialto::IMediaPipeline::MediaSourceVideo *>(&source);
+    if (!kVideoSource)
+    {
+        return kUhdVideoRegionSize;
+    }
+    return calculateVideoRegionSize(kVideoSource->getWidth(), kVideoSource->getHeight());
+}
+
+std::uint32_t calculateAudioRegionSize(const firebolt::rialto::IMediaPipeline::MediaSource &source)
+{
+    const std::string kMimeType{source.getMimeType()};
+    if (kMimeType == "audio/x-raw" || kMimeType == "audio/b-wav" || kMimeType == "audio/x-eac3" ||
+        kMimeType == "audio/x-flac")
+    {
+        return kMultichannelAudioRegionSize;
+    }
+    const auto *kAudioSource = dynamic_cast<const firebolt::rialto::IMediaPipeline::MediaSourceAudio *>(&source);
+    if (!kAudioSource || firebolt::rialto::kInvalidAudioChannels == kAudioSource->getAudioConfig().numberOfChannels ||
+        kAudioSource->getAudioConfig().numberOfChannels > 2)
+    {
+        return kMultichannelAudioRegionSize;
+    }
+    return kStereoAudioRegionSize;
+}
+} // namespace
+
+namespace firebolt::rialto::server
+{
+void ShmRegionSizeCalculator::addSource(const IMediaPipeline::MediaSource &source)
+{
+    switch (source.getType())
+    {
+    case MediaSourceType::VIDEO:
+        m_regionSizes[MediaSourceType::VIDEO] = calculateVideoRegionSize(source);
+        break;
+    case MediaSourceType::AUDIO:
+        m_regionSizes[MediaSourceType::AUDIO] = calculateAudioRegionSize(source);
+        break;
+    case MediaSourceType::SUBTITLE:
+        m_regionSizes[MediaSourceType::SUBTITLE] = kSubtitleRegionSize;
+        break;
+    default:
+        break;
+    }
+}
+
+void ShmRegionSizeCalculator::addVideoResolution(std::int32_t width, std::int32_t height)
+{
+    auto videoRegionSize = m_regionSizes.find(MediaSourceType::VIDEO);
+    if (videoRegionSize == m_regionSizes.end())
+    {
+        return;
+    }
+    videoRegionSize->second = std::max(videoRegionSize->second, calculateVideoRegionSize(width, height));
+}
+
+void ShmRegionSizeCalculator::removeSource(MediaSourceType mediaSourceType)
+{
+    m_regionSizes.erase(mediaSourceType);
+}
+
+ISharedMemoryBuffer::PartitionSizes ShmRegionSizeCalculator::getPartitionSizes() const
+{
+    auto getRegionSize = [this](MediaSourceType mediaSourceType) -> std::uint32_t
+    {
+        auto it = m_regionSizes.find(mediaSourceType);
+        return it == m_regionSizes.end() ? 0 : it->second;
+    };
+    return {getRegionSize(MediaSourceType::VIDEO), getRegionSize(MediaSourceType::AUDIO),
+            getRegionSize(MediaSourceType::SUBTITLE)};
+}
+} // namespace firebolt::rialto::server
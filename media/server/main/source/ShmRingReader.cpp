@@ -0,0 +1,101 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ShmRingReader.h"
+#include "DataReaderV2.h"
+#include "RialtoServerLogging.h"
+#include "ShmCommon.h"
+#include "TypeConverters.h"
+#include <stdexcept>
+
+namespace firebolt::rialto::server
+{
+ShmRingReader::ShmRingReader(const MediaSourceType &mediaSourceType, std::uint8_t *ring, std::uint32_t capacity)
+    : m_kMediaSourceType{mediaSourceType}
+{
+    if (!ring || !m_ring.attach(ring, capacity))
+    {
+        throw std::runtime_error("Failed to attach the ring");
+    }
+}
+
+MediaSourceType ShmRingReader::getType() const
+{
+    return m_kMediaSourceType;
+}
+
+IShmRingReader::Status ShmRingReader::read(MediaSegmentBatch &batch)
+{
+    if (m_isFlushing)
+    {
+        return Status::EMPTY;
+    }
+    std::uint64_t tag{0};
+    const std::uint8_t *data{nullptr};
+    std::size_t length{0};
+    while (m_ring.peek(&tag, &data, &length))
+    {
+        if ((tag & common::SHM_RING_GENERATION_MASK) != m_generation)
+        {
+            RIALTO_SERVER_LOG_DEBUG("Dropping %s record written before the flush",
+                                    common::convertMediaSourceType(m_kMediaSourceType));
+            m_ring.consume();
+            continue;
+        }
+        if (tag & common::SHM_RING_END_OF_STREAM_TAG)
+        {
+            return Status::END_OF_STREAM;
+        }
+        const std::size_t kNumSegments{batch.size()};
+        DataReaderV2{m_kMediaSourceType, const_cast<std::uint8_t *>(data), 0, 1, static_cast<std::uint32_t>(length),
+                     false}
+            .readSegments(batch);
+        if (batch.size() == kNumSegments)
+        {
+            RIALTO_SERVER_LOG_ERROR("Dropping invalid %s record", common::convertMediaSourceType(m_kMediaSourceType));
+            m_ring.consume();
+            continue;
+        }
+        return Status::FRAME;
+    }
+    return Status::EMPTY;
+}
+
+void ShmRingReader::consume()
+{
+    m_ring.consume();
+}
+
+bool ShmRingReader::waitForDoorbell()
+{
+    // While flushing, the next read happens when gstreamer needs data again after the flush
+    const bool kHasRecords{m_ring.setConsumerWaiting(true)};
+    return kHasRecords && !m_isFlushing;
+}
+
+void ShmRingReader::setFlushing(bool isFlushing)
+{
+    if (isFlushing)
+    {
+        m_generation = (m_generation + 1) & common::SHM_RING_GENERATION_MASK;
+    }
+    m_isFlushing = isFlushing;
+}
+} // namespace firebolt::rialto::server
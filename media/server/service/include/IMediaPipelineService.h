@@ -63,6 +63,10 @@ public:
                                 std::uint32_t height) = 0;
     virtual bool haveData(int sessionId, MediaSourceStatus status, std::uint32_t numFrames,
                           std::uint32_t needDataRequestId) = 0;
+    virtual bool haveDataMulti(int sessionId, const std::vector<HaveDataInfo> &haveDataInfos,
+                               std::vector<bool> &results) = 0;
+    virtual bool enableStreamingMode(int sessionId, int32_t sourceId, int &doorbellFd, std::uint32_t &ringOffset,
+                                     std::uint32_t &ringCapacity) = 0;
     virtual bool renderFrame(int sessionId) = 0;
     virtual bool setVolume(int sessionId, double targetVolume, uint32_t volumeDuration, EaseType easeType) = 0;
     virtual bool getVolume(int sessionId, double &volume) = 0;
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <exception>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -55,7 +56,7 @@ void CdmService::switchToInactive()
     m_isActive = false;
 
     {
-        std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+        std::unique_lock<std::shared_mutex> lock{m_mediaKeysMutex};
         m_mediaKeys.clear();
         m_mediaKeysClients.clear();
         m_sessionInfo.clear();
@@ -73,7 +74,7 @@ bool CdmService::createMediaKeys(int mediaKeysHandle, std::string keySystem)
     }
 
     {
-        std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+        std::unique_lock<std::shared_mutex> lock{m_mediaKeysMutex};
         if (m_mediaKeys.find(mediaKeysHandle) != m_mediaKeys.end())
         {
             RIALTO_SERVER_LOG_ERROR("Media keys handle: %d already exists", mediaKeysHandle);
@@ -97,7 +98,7 @@ bool CdmService::destroyMediaKeys(int mediaKeysHandle)
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to destroy media keys handle: %d", mediaKeysHandle);
 
     {
-        std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+        std::unique_lock<std::shared_mutex> lock{m_mediaKeysMutex};
         auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
         if (mediaKeysIter == m_mediaKeys.end())
         {
@@ -127,7 +128,7 @@ MediaKeyErrorStatus CdmService::createKeySession(int mediaKeysHandle, KeySession
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to create key session: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::unique_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
@@ -144,7 +145,7 @@ MediaKeyErrorStatus CdmService::createKeySession(int mediaKeysHandle, KeySession
             static_cast<void>(removeKeySessionInternal(mediaKeysHandle, keySessionId));
             return MediaKeyErrorStatus::FAIL;
         }
-        m_sessionInfo.emplace(std::make_pair(keySessionId, MediaKeySessionInfo{mediaKeysHandle}));
+        m_sessionInfo.try_emplace(keySessionId, mediaKeysHandle);
         m_mediaKeysClients.emplace(std::make_pair(keySessionId, client));
     }
 
@@ -157,16 +158,17 @@ MediaKeyErrorStatus CdmService::generateRequest(int mediaKeysHandle, int32_t key
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to generate request: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
         RIALTO_SERVER_LOG_ERROR("Media keys handle: %d does not exists", mediaKeysHandle);
         return MediaKeyErrorStatus::FAIL;
     }
-    if (LimitedDurationLicense::NOT_SPECIFIED != ldlState && m_sessionInfo.find(keySessionId) != m_sessionInfo.end())
+    auto sessionInfoIter{m_sessionInfo.find(keySessionId)};
+    if (LimitedDurationLicense::NOT_SPECIFIED != ldlState && sessionInfoIter != m_sessionInfo.end())
     {
-        m_sessionInfo[keySessionId].isExtendedInterfaceUsed = true;
+        sessionInfoIter->second.isExtendedInterfaceUsed = true;
     }
     return mediaKeysIter->second->generateRequest(keySessionId, initDataType, initData, ldlState);
 }
@@ -175,7 +177,7 @@ MediaKeyErrorStatus CdmService::loadSession(int mediaKeysHandle, int32_t keySess
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to load session: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
@@ -190,7 +192,7 @@ MediaKeyErrorStatus CdmService::updateSession(int mediaKeysHandle, int32_t keySe
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to update session: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
@@ -204,7 +206,7 @@ MediaKeyErrorStatus CdmService::closeKeySession(int mediaKeysHandle, int32_t key
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to close key session: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::unique_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysHandleIter{m_sessionInfo.find(keySessionId)};
     if (mediaKeysHandleIter == m_sessionInfo.end())
     {
@@ -224,7 +226,7 @@ MediaKeyErrorStatus CdmService::removeKeySession(int mediaKeysHandle, int32_t ke
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to remove key session: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::unique_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     return removeKeySessionInternal(mediaKeysHandle, keySessionId);
 }
 
@@ -254,7 +256,7 @@ MediaKeyErrorStatus CdmService::getCdmKeySessionId(int mediaKeysHandle, int32_t
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to get cdm key session id: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
@@ -270,7 +272,7 @@ bool CdmService::containsKey(int mediaKeysHandle, int32_t keySessionId, const st
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to check if key is present: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
@@ -286,16 +288,17 @@ MediaKeyErrorStatus CdmService::setDrmHeader(int mediaKeysHandle, int32_t keySes
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to set drm header: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
         RIALTO_SERVER_LOG_ERROR("Media keys handle: %d does not exists", mediaKeysHandle);
         return MediaKeyErrorStatus::FAIL;
     }
-    if (m_sessionInfo.find(keySessionId) != m_sessionInfo.end())
+    auto sessionInfoIter{m_sessionInfo.find(keySessionId)};
+    if (sessionInfoIter != m_sessionInfo.end())
     {
-        m_sessionInfo[keySessionId].isExtendedInterfaceUsed = true;
+        sessionInfoIter->second.isExtendedInterfaceUsed = true;
     }
     return mediaKeysIter->second->setDrmHeader(keySessionId, requestData);
 }
@@ -304,7 +307,7 @@ MediaKeyErrorStatus CdmService::deleteDrmStore(int mediaKeysHandle)
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to delete drm store: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
@@ -318,7 +321,7 @@ MediaKeyErrorStatus CdmService::deleteKeyStore(int mediaKeysHandle)
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to delete key store: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
@@ -333,7 +336,7 @@ MediaKeyErrorStatus CdmService::getDrmStoreHash(int mediaKeysHandle, std::vector
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to get drm store hash: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
@@ -347,7 +350,7 @@ MediaKeyErrorStatus CdmService::getKeyStoreHash(int mediaKeysHandle, std::vector
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to get key store hash: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
@@ -361,7 +364,7 @@ MediaKeyErrorStatus CdmService::getLdlSessionsLimit(int mediaKeysHandle, uint32_
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to get ldl sessions limit: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
@@ -375,7 +378,7 @@ MediaKeyErrorStatus CdmService::getLastDrmError(int mediaKeysHandle, int32_t key
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to get last drm error: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
@@ -389,7 +392,7 @@ MediaKeyErrorStatus CdmService::getDrmTime(int mediaKeysHandle, uint64_t &drmTim
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to get drm time: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
@@ -403,7 +406,7 @@ MediaKeyErrorStatus CdmService::releaseKeySession(int mediaKeysHandle, int32_t k
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to release key session: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::unique_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysHandleIter{m_sessionInfo.find(keySessionId)};
     if (mediaKeysHandleIter == m_sessionInfo.end())
     {
@@ -521,14 +524,14 @@ MediaKeyErrorStatus CdmService::decrypt(int32_t keySessionId, GstBuffer *encrypt
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to decrypt, key session id: %d", keySessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysHandleIter{m_sessionInfo.find(keySessionId)};
     if (mediaKeysHandleIter == m_sessionInfo.end())
     {
         RIALTO_SERVER_LOG_ERROR("Media keys handle for mksId: %d does not exists", keySessionId);
         return MediaKeyErrorStatus::FAIL;
     }
-    return m_mediaKeys[mediaKeysHandleIter->second.mediaKeysHandle]->decrypt(keySessionId, encrypted, caps);
+    return m_mediaKeys.at(mediaKeysHandleIter->second.mediaKeysHandle)->decrypt(keySessionId, encrypted, caps);
 }
 
 bool CdmService::isExtendedInterfaceUsed(int32_t keySessionId)
@@ -536,7 +539,7 @@ bool CdmService::isExtendedInterfaceUsed(int32_t keySessionId)
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to check if extended interface is used, key session id: %d",
                             keySessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysHandleIter{m_sessionInfo.find(keySessionId)};
     if (mediaKeysHandleIter == m_sessionInfo.end())
     {
@@ -550,23 +553,20 @@ MediaKeyErrorStatus CdmService::selectKeyId(int32_t keySessionId, const std::vec
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to select key id, key session id: %d", keySessionId);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysHandleIter{m_sessionInfo.find(keySessionId)};
     if (mediaKeysHandleIter == m_sessionInfo.end())
     {
         RIALTO_SERVER_LOG_ERROR("Media keys handle for mksId: %d does not exists", keySessionId);
         return MediaKeyErrorStatus::FAIL;
     }
-    if (m_sessionInfo.find(keySessionId) != m_sessionInfo.end())
-    {
-        m_sessionInfo[keySessionId].isExtendedInterfaceUsed = true;
-    }
-    return m_mediaKeys[mediaKeysHandleIter->second.mediaKeysHandle]->selectKeyId(keySessionId, keyId);
+    mediaKeysHandleIter->second.isExtendedInterfaceUsed = true;
+    return m_mediaKeys.at(mediaKeysHandleIter->second.mediaKeysHandle)->selectKeyId(keySessionId, keyId);
 }
 
 void CdmService::incrementSessionIdUsageCounter(int32_t keySessionId)
 {
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysHandleIter{m_sessionInfo.find(keySessionId)};
     if (mediaKeysHandleIter == m_sessionInfo.end())
     {
@@ -578,40 +578,57 @@ void CdmService::incrementSessionIdUsageCounter(int32_t keySessionId)
 
 void CdmService::decrementSessionIdUsageCounter(int32_t keySessionId)
 {
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
-    auto mediaKeysHandleIter{m_sessionInfo.find(keySessionId)};
-    if (mediaKeysHandleIter == m_sessionInfo.end())
     {
-        RIALTO_SERVER_LOG_ERROR("Media keys handle for mksId: %d does not exists", keySessionId);
-        return;
+        std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
+        auto mediaKeysHandleIter{m_sessionInfo.find(keySessionId)};
+        if (mediaKeysHandleIter == m_sessionInfo.end())
+        {
+            RIALTO_SERVER_LOG_ERROR("Media keys handle for mksId: %d does not exists", keySessionId);
+            return;
+        }
+        MediaKeySessionInfo &sessionInfo{mediaKeysHandleIter->second};
+        uint32_t refCounter{sessionInfo.refCounter};
+        while (refCounter > 0 && !sessionInfo.refCounter.compare_exchange_weak(refCounter, refCounter - 1))
+        {
+        }
+        if (refCounter > 1 || !(sessionInfo.shouldBeClosed || sessionInfo.shouldBeReleased))
+        {
+            return;
+        }
     }
-    if (mediaKeysHandleIter->second.refCounter > 0)
+
+    finishDeferredOperations(keySessionId);
+}
+
+void CdmService::finishDeferredOperations(int32_t keySessionId)
+{
+    std::unique_lock<std::shared_mutex> lock{m_mediaKeysMutex};
+    auto mediaKeysHandleIter{m_sessionInfo.find(keySessionId)};
+    if (mediaKeysHandleIter == m_sessionInfo.end() || mediaKeysHandleIter->second.refCounter > 0)
     {
-        --mediaKeysHandleIter->second.refCounter;
+        // Released, or used again, while the lock was being upgraded
+        return;
     }
-    if (mediaKeysHandleIter->second.refCounter == 0)
+    if (mediaKeysHandleIter->second.shouldBeClosed)
     {
-        if (mediaKeysHandleIter->second.shouldBeClosed)
+        RIALTO_SERVER_LOG_INFO("Deferred closing of mksId %d", keySessionId);
+        if (MediaKeyErrorStatus::OK !=
+            m_mediaKeys[mediaKeysHandleIter->second.mediaKeysHandle]->closeKeySession(keySessionId))
         {
-            RIALTO_SERVER_LOG_INFO("Deferred closing of mksId %d", keySessionId);
-            if (MediaKeyErrorStatus::OK !=
-                m_mediaKeys[mediaKeysHandleIter->second.mediaKeysHandle]->closeKeySession(keySessionId))
-            {
-                RIALTO_SERVER_LOG_ERROR("Failed to close the key session %d", keySessionId);
-            }
-        }
-        if (mediaKeysHandleIter->second.shouldBeReleased)
-        {
-            RIALTO_SERVER_LOG_INFO("Deferred releasing of mksId %d", keySessionId);
-            m_mediaKeys[mediaKeysHandleIter->second.mediaKeysHandle]->releaseKeySession(keySessionId);
-            m_sessionInfo.erase(keySessionId);
+            RIALTO_SERVER_LOG_ERROR("Failed to close the key session %d", keySessionId);
         }
     }
+    if (mediaKeysHandleIter->second.shouldBeReleased)
+    {
+        RIALTO_SERVER_LOG_INFO("Deferred releasing of mksId %d", keySessionId);
+        m_mediaKeys[mediaKeysHandleIter->second.mediaKeysHandle]->releaseKeySession(keySessionId);
+        m_sessionInfo.erase(keySessionId);
+    }
 }
 
 void CdmService::ping(const std::shared_ptr<IHeartbeatProcedure> &heartbeatProcedure)
 {
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     for (const auto &mediaKeyPair : m_mediaKeys)
     {
         auto &mediaKeys = mediaKeyPair.second;
@@ -623,7 +640,7 @@ MediaKeyErrorStatus CdmService::getMetricSystemData(int mediaKeysHandle, std::ve
 {
     RIALTO_SERVER_LOG_DEBUG("CdmService requested to get metric system data: %d", mediaKeysHandle);
 
-    std::lock_guard<std::mutex> lock{m_mediaKeysMutex};
+    std::shared_lock<std::shared_mutex> lock{m_mediaKeysMutex};
     auto mediaKeysIter = m_mediaKeys.find(mediaKeysHandle);
     if (mediaKeysIter == m_mediaKeys.end())
     {
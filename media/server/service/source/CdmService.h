@@ -27,6 +27,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -34,11 +35,19 @@ namespace firebolt::rialto::server::service
 {
 class CdmService : public ICdmService, public IDecryptionService
 {
+    /**
+     * @brief The state of a key session.
+     *
+     * The decryptor threads update isExtendedInterfaceUsed and refCounter while holding m_mediaKeysMutex shared, the
+     * other fields only change with it held exclusively.
+     */
     struct MediaKeySessionInfo
     {
+        explicit MediaKeySessionInfo(int handle) : mediaKeysHandle{handle} {}
+
         int mediaKeysHandle;
-        bool isExtendedInterfaceUsed{false};
-        uint32_t refCounter{0};
+        std::atomic<bool> isExtendedInterfaceUsed{false};
+        std::atomic<uint32_t> refCounter{0};
         bool shouldBeClosed{false};
         bool shouldBeReleased{false};
     };
@@ -97,9 +106,14 @@ private:
     std::map<int, std::unique_ptr<IMediaKeysServerInternal>> m_mediaKeys;
     std::map<int, std::shared_ptr<IMediaKeysClient>> m_mediaKeysClients;
     std::map<int32_t, MediaKeySessionInfo> m_sessionInfo;
-    std::mutex m_mediaKeysMutex;
+    /**
+     * @brief Held exclusively to add or remove media keys and key sessions, and shared by everything else so that
+     * decryption isn't held up by licence requests or by the other sessions.
+     */
+    std::shared_mutex m_mediaKeysMutex;
 
     MediaKeyErrorStatus removeKeySessionInternal(int mediaKeysHandle, int32_t keySessionId);
+    void finishDeferredOperations(int32_t keySessionId);
 };
 } // namespace firebolt::rialto::server::service
 
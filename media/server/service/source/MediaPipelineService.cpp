@@ -368,6 +368,44 @@ bool MediaPipelineService::haveData(int sessionId, MediaSourceStatus status, std
     return mediaPipelineIter->second->haveData(status, numFrames, needDataRequestId);
 }
 
+bool MediaPipelineService::haveDataMulti(int sessionId, const std::vector<HaveDataInfo> &haveDataInfos,
+                                         std::vector<bool> &results)
+{
+    RIALTO_SERVER_LOG_DEBUG("New data available for %zu requests, session id: %d", haveDataInfos.size(), sessionId);
+
+    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
+    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
+    if (mediaPipelineIter == m_mediaPipelines.end())
+    {
+        RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
+        return false;
+    }
+    return mediaPipelineIter->second->haveDataMulti(haveDataInfos, results);
+}
+
+bool MediaPipelineService::enableStreamingMode(int sessionId, int32_t sourceId, int &doorbellFd,
+                                               std::uint32_t &ringOffset, std::uint32_t &ringCapacity)
+{
+    RIALTO_SERVER_LOG_DEBUG("Enable streaming mode requested, session id: %d, source id: %d", sessionId, sourceId);
+
+    std::lock_guard<std::mutex> lock{m_mediaPipelineMutex};
+    auto mediaPipelineIter = m_mediaPipelines.find(sessionId);
+    if (mediaPipelineIter == m_mediaPipelines.end())
+    {
+        RIALTO_SERVER_LOG_ERROR("Session with id: %d does not exists", sessionId);
+        return false;
+    }
+    ISharedMemoryBuffer::StreamingRing ring{};
+    if (!mediaPipelineIter->second->enableStreamingRing(sourceId, ring))
+    {
+        return false;
+    }
+    doorbellFd = ring.doorbellFd;
+    ringOffset = ring.offset;
+    ringCapacity = ring.capacity;
+    return true;
+}
+
 bool MediaPipelineService::renderFrame(int sessionId)
 {
     RIALTO_SERVER_LOG_DEBUG("Render frame requested, session id: %d", sessionId);
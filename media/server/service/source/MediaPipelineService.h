@@ -75,6 +75,10 @@ public:
                         std::uint32_t height) override;
     bool haveData(int sessionId, MediaSourceStatus status, std::uint32_t numFrames,
                   std::uint32_t needDataRequestId) override;
+    bool haveDataMulti(int sessionId, const std::vector<HaveDataInfo> &haveDataInfos,
+                       std::vector<bool> &results) override;
+    bool enableStreamingMode(int sessionId, int32_t sourceId, int &doorbellFd, std::uint32_t &ringOffset,
+                             std::uint32_t &ringCapacity) override;
     bool renderFrame(int sessionId) override;
     bool setVolume(int sessionId, double targetVolume, uint32_t volumeDuration, EaseType easeType) override;
     bool getVolume(int sessionId, double &volume) override;
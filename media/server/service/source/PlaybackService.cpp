@@ -151,5 +151,15 @@ void PlaybackService::ping(const std::shared_ptr<IHeartbeatProcedure> &heartbeat
 {
     m_mediaPipelineService->ping(heartbeatProcedure);
     m_webAudioPlayerService->ping(heartbeatProcedure);
+
+    auto shmBuffer = m_shmBuffer;
+    if (shmBuffer)
+    {
+        for (const auto &usage : shmBuffer->getPartitionUsage(ISharedMemoryBuffer::MediaPlaybackType::GENERIC))
+        {
+            RIALTO_SERVER_LOG_INFO("Shm partition of session %d: %u bytes reserved, %u bytes used", usage.id,
+                                   usage.reservedBytes, usage.usedBytes);
+        }
+    }
 }
 } // namespace firebolt::rialto::server::service
@@ -49,6 +49,10 @@ public:
     std::optional<unsigned int> getNumOfPreloadedServers() override;
     std::optional<rialto::servermanager::service::LoggingLevels> getLoggingLevels() override;
     std::optional<unsigned int> getNumOfPingsBeforeRecovery() override;
+    std::optional<firebolt::rialto::common::SharedMemoryPages> getSharedMemoryPages() override;
+    std::optional<firebolt::rialto::common::SharedMemoryPrefault> getSharedMemoryPrefault() override;
+    std::optional<bool> getSharedMemoryZeroCopy() override;
+    std::optional<unsigned int> getNumOfNeedDataSlots() override;
 
 private:
     void parseEnvironmentVariables(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root);
@@ -62,6 +66,10 @@ private:
     void parseNumOfPreloadedServers(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root);
     void parseLogLevel(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root);
     void parseNumOfPingsBeforeRecovery(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root);
+    void parseSharedMemoryPages(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root);
+    void parseSharedMemoryPrefault(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root);
+    void parseSharedMemoryZeroCopy(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root);
+    void parseNumOfNeedDataSlots(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root);
 
     std::list<std::string> getListOfStrings(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root,
                                             const std::string &valueName) const;
@@ -69,6 +77,8 @@ private:
                                          const std::string &valueName) const;
     std::optional<unsigned int> getUInt(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root,
                                         const std::string &valueName) const;
+    std::optional<bool> getBool(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root,
+                                const std::string &valueName) const;
 
     std::shared_ptr<firebolt::rialto::wrappers::IJsonCppWrapper> m_jsonWrapper;
     std::shared_ptr<IFileReader> m_fileReader;
@@ -84,6 +94,10 @@ private:
     std::optional<unsigned int> m_numOfPreloadedServers;
     std::optional<rialto::servermanager::service::LoggingLevels> m_loggingLevels;
     std::optional<unsigned int> m_numOfPingsBeforeRecovery;
+    std::optional<firebolt::rialto::common::SharedMemoryPages> m_sharedMemoryPages;
+    std::optional<firebolt::rialto::common::SharedMemoryPrefault> m_sharedMemoryPrefault;
+    std::optional<bool> m_sharedMemoryZeroCopy;
+    std::optional<unsigned int> m_numOfNeedDataSlots;
 };
 
 } // namespace rialto::servermanager::service
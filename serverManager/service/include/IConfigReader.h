@@ -45,6 +45,10 @@ public:
     virtual std::optional<unsigned int> getNumOfPreloadedServers() = 0;
     virtual std::optional<rialto::servermanager::service::LoggingLevels> getLoggingLevels() = 0;
     virtual std::optional<unsigned int> getNumOfPingsBeforeRecovery() = 0;
+    virtual std::optional<firebolt::rialto::common::SharedMemoryPages> getSharedMemoryPages() = 0;
+    virtual std::optional<firebolt::rialto::common::SharedMemoryPrefault> getSharedMemoryPrefault() = 0;
+    virtual std::optional<bool> getSharedMemoryZeroCopy() = 0;
+    virtual std::optional<unsigned int> getNumOfNeedDataSlots() = 0;
 };
 
 } // namespace rialto::servermanager::service
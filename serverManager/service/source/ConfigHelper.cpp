@@ -23,6 +23,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <string>
 
 namespace
 {
@@ -52,6 +53,34 @@ std::list<std::string> convertToList(const std::map<std::string, std::string> &e
     }
     return result;
 }
+
+void addSharedMemoryEnvVariables(const firebolt::rialto::common::SharedMemoryConfig &sharedMemoryConfig,
+                                 std::map<std::string, std::string> &envVariablesMap)
+{
+    // Env variables set explicitly in the config take precedence
+    if (firebolt::rialto::common::SharedMemoryPages::HUGE_PAGES == sharedMemoryConfig.pages)
+    {
+        envVariablesMap.emplace(firebolt::rialto::common::kSharedMemoryPagesEnvVar, "huge");
+    }
+    if (firebolt::rialto::common::SharedMemoryPrefault::POPULATE == sharedMemoryConfig.prefault)
+    {
+        envVariablesMap.emplace(firebolt::rialto::common::kSharedMemoryPrefaultEnvVar, "populate");
+    }
+    else if (firebolt::rialto::common::SharedMemoryPrefault::LOCK == sharedMemoryConfig.prefault)
+    {
+        envVariablesMap.emplace(firebolt::rialto::common::kSharedMemoryPrefaultEnvVar, "lock");
+    }
+    if (sharedMemoryConfig.zeroCopy)
+    {
+        envVariablesMap.emplace(firebolt::rialto::common::kSharedMemoryZeroCopyEnvVar, "true");
+    }
+    if (1 != sharedMemoryConfig.numOfNeedDataSlots)
+    {
+        // The session server validates the value
+        envVariablesMap.emplace(firebolt::rialto::common::kNumOfNeedDataSlotsEnvVar,
+                                std::to_string(sharedMemoryConfig.numOfNeedDataSlots));
+    }
+}
 } // namespace
 
 namespace rialto::servermanager::service
@@ -63,7 +92,8 @@ ConfigHelper::ConfigHelper(std::unique_ptr<IConfigReaderFactory> &&configReaderF
       m_sessionServerStartupTimeout{config.sessionServerStartupTimeout},
       m_healthcheckInterval{config.healthcheckInterval}, m_socketPermissions{config.sessionManagementSocketPermissions},
       m_numOfPreloadedServers{config.numOfPreloadedServers},
-      m_numOfFailedPingsBeforeRecovery{config.numOfFailedPingsBeforeRecovery}, m_loggingLevels{}
+      m_numOfFailedPingsBeforeRecovery{config.numOfFailedPingsBeforeRecovery}, m_loggingLevels{},
+      m_sharedMemoryConfig{config.sharedMemoryConfig}
 {
 #ifdef RIALTO_ENABLE_CONFIG_FILE
     // Read from least to most important file
@@ -76,7 +106,9 @@ ConfigHelper::ConfigHelper(std::unique_ptr<IConfigReaderFactory> &&configReaderF
 
 std::list<std::string> ConfigHelper::getSessionServerEnvVars() const
 {
-    return convertToList(m_sessionServerEnvVars);
+    std::map<std::string, std::string> sessionServerEnvVars{m_sessionServerEnvVars};
+    addSharedMemoryEnvVariables(m_sharedMemoryConfig, sessionServerEnvVars);
+    return convertToList(sessionServerEnvVars);
 }
 
 const std::string &ConfigHelper::getSessionServerPath() const
@@ -114,6 +146,11 @@ const rialto::servermanager::service::LoggingLevels &ConfigHelper::getLoggingLev
     return m_loggingLevels;
 }
 
+const firebolt::rialto::common::SharedMemoryConfig &ConfigHelper::getSharedMemoryConfig() const
+{
+    return m_sharedMemoryConfig;
+}
+
 #ifdef RIALTO_ENABLE_CONFIG_FILE
 void ConfigHelper::readConfigFile(const std::string &filePath)
 {
@@ -169,6 +206,18 @@ void ConfigHelper::readConfigFile(const std::string &filePath)
 
     if (configReader->getLoggingLevels())
         m_loggingLevels = configReader->getLoggingLevels().value();
+
+    if (configReader->getSharedMemoryPages())
+        m_sharedMemoryConfig.pages = configReader->getSharedMemoryPages().value();
+
+    if (configReader->getSharedMemoryPrefault())
+        m_sharedMemoryConfig.prefault = configReader->getSharedMemoryPrefault().value();
+
+    if (configReader->getSharedMemoryZeroCopy())
+        m_sharedMemoryConfig.zeroCopy = configReader->getSharedMemoryZeroCopy().value();
+
+    if (configReader->getNumOfNeedDataSlots())
+        m_sharedMemoryConfig.numOfNeedDataSlots = configReader->getNumOfNeedDataSlots().value();
 }
 
 void ConfigHelper::mergeEnvVariables()
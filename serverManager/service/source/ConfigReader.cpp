@@ -56,6 +56,10 @@ bool ConfigReader::read()
     parseNumOfPreloadedServers(root);
     parseLogLevel(root);
     parseNumOfPingsBeforeRecovery(root);
+    parseSharedMemoryPages(root);
+    parseSharedMemoryPrefault(root);
+    parseSharedMemoryZeroCopy(root);
+    parseNumOfNeedDataSlots(root);
 
     return true;
 }
@@ -162,6 +166,62 @@ void ConfigReader::parseNumOfPingsBeforeRecovery(const std::shared_ptr<firebolt:
     m_numOfPingsBeforeRecovery = getUInt(root, "numOfPingsBeforeRecovery");
 }
 
+void ConfigReader::parseSharedMemoryPages(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root)
+{
+    auto pages{getString(root, "sharedMemoryPages")};
+    if (!pages.has_value())
+    {
+        return;
+    }
+    if ("default" == *pages)
+    {
+        m_sharedMemoryPages = firebolt::rialto::common::SharedMemoryPages::DEFAULT;
+    }
+    else if ("huge" == *pages)
+    {
+        m_sharedMemoryPages = firebolt::rialto::common::SharedMemoryPages::HUGE_PAGES;
+    }
+    else
+    {
+        RIALTO_SERVER_MANAGER_LOG_WARN("Unknown sharedMemoryPages value: %s", pages->c_str());
+    }
+}
+
+void ConfigReader::parseSharedMemoryPrefault(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root)
+{
+    auto prefault{getString(root, "sharedMemoryPrefault")};
+    if (!prefault.has_value())
+    {
+        return;
+    }
+    if ("none" == *prefault)
+    {
+        m_sharedMemoryPrefault = firebolt::rialto::common::SharedMemoryPrefault::NONE;
+    }
+    else if ("populate" == *prefault)
+    {
+        m_sharedMemoryPrefault = firebolt::rialto::common::SharedMemoryPrefault::POPULATE;
+    }
+    else if ("lock" == *prefault)
+    {
+        m_sharedMemoryPrefault = firebolt::rialto::common::SharedMemoryPrefault::LOCK;
+    }
+    else
+    {
+        RIALTO_SERVER_MANAGER_LOG_WARN("Unknown sharedMemoryPrefault value: %s", prefault->c_str());
+    }
+}
+
+void ConfigReader::parseSharedMemoryZeroCopy(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root)
+{
+    m_sharedMemoryZeroCopy = getBool(root, "sharedMemoryZeroCopy");
+}
+
+void ConfigReader::parseNumOfNeedDataSlots(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root)
+{
+    m_numOfNeedDataSlots = getUInt(root, "numOfNeedDataSlots");
+}
+
 std::list<std::string> ConfigReader::getEnvironmentVariables()
 {
     return m_envVars;
@@ -217,6 +277,26 @@ std::optional<unsigned int> ConfigReader::getNumOfPingsBeforeRecovery()
     return m_numOfPingsBeforeRecovery;
 }
 
+std::optional<firebolt::rialto::common::SharedMemoryPages> ConfigReader::getSharedMemoryPages()
+{
+    return m_sharedMemoryPages;
+}
+
+std::optional<firebolt::rialto::common::SharedMemoryPrefault> ConfigReader::getSharedMemoryPrefault()
+{
+    return m_sharedMemoryPrefault;
+}
+
+std::optional<bool> ConfigReader::getSharedMemoryZeroCopy()
+{
+    return m_sharedMemoryZeroCopy;
+}
+
+std::optional<unsigned int> ConfigReader::getNumOfNeedDataSlots()
+{
+    return m_numOfNeedDataSlots;
+}
+
 std::list<std::string>
 ConfigReader::getListOfStrings(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root,
                                const std::string &valueName) const
@@ -258,4 +338,14 @@ std::optional<unsigned int> ConfigReader::getUInt(const std::shared_ptr<firebolt
     return std::nullopt;
 }
 
+std::optional<bool> ConfigReader::getBool(const std::shared_ptr<firebolt::rialto::wrappers::IJsonValueWrapper> &root,
+                                          const std::string &valueName) const
+{
+    if (root->isMember(valueName) && root->at(valueName)->isBool())
+    {
+        return root->at(valueName)->asBool();
+    }
+    return std::nullopt;
+}
+
 } // namespace rialto::servermanager::service
@@ -19,11 +19,21 @@
 
 #include "opencdm/open_cdm.h"
 
+// The handles only need to be distinct and non-null, so that the wrappers and the decryption path above them can be
+// exercised (and benchmarked) against the stub
+struct OpenCDMSystem
+{
+};
+
+struct OpenCDMSession
+{
+};
+
 extern "C"
 {
     OpenCDMSystem *opencdm_create_system(const char keySystem[])
     {
-        return nullptr;
+        return new OpenCDMSystem{};
     }
 
     OpenCDMError opencdm_construct_session(OpenCDMSystem *system, const LicenseType licenseType,
@@ -32,11 +42,13 @@ extern "C"
                                            const uint16_t CDMDataLength, OpenCDMSessionCallbacks *callbacks,
                                            void *userData, OpenCDMSession **session)
     {
+        *session = new OpenCDMSession{};
         return ERROR_NONE;
     }
 
     OpenCDMError opencdm_destruct_system(struct OpenCDMSystem *system)
     {
+        delete system;
         return ERROR_NONE;
     }
 
@@ -78,6 +90,7 @@ extern "C"
 
     OpenCDMError opencdm_destruct_session(struct OpenCDMSession *session)
     {
+        delete session;
         return ERROR_NONE;
     }
 
@@ -22,6 +22,23 @@ extern "C"
 {
     OpenCDMError opencdm_gstreamer_session_decrypt_buffer(struct OpenCDMSession *session, GstBuffer *buffer, GstCaps *caps)
     {
+        if (!session)
+        {
+            return ERROR_INVALID_SESSION;
+        }
+
+        // "Decrypt" the sample in place, so that like a real CDM the cost depends on the size of the sample
+        GstMapInfo map;
+        if (!gst_buffer_map(buffer, &map, GST_MAP_READWRITE))
+        {
+            return ERROR_INVALID_DECRYPT_BUFFER;
+        }
+        for (gsize i = 0; i < map.size; ++i)
+        {
+            map.data[i] ^= 0x5a;
+        }
+        gst_buffer_unmap(buffer, &map);
+
         return ERROR_NONE;
     }
 }
@@ -0,0 +1,217 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CdmService.h"
+#include "IMediaKeysCapabilities.h"
+#include "IMediaKeysServerInternal.h"
+#include <benchmark/benchmark.h>
+#include <gst/gst.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using firebolt::rialto::InitDataType;
+using firebolt::rialto::KeySessionType;
+using firebolt::rialto::LimitedDurationLicense;
+using firebolt::rialto::MediaKeyErrorStatus;
+using firebolt::rialto::server::service::CdmService;
+
+namespace
+{
+constexpr int kMediaKeysHandle{1};
+const std::string kKeySystem{"com.widevine.alpha"};
+const std::vector<std::uint8_t> kInitData{0x00, 0x00, 0x00, 0x20, 0x70, 0x73, 0x73, 0x68};
+const std::vector<std::uint8_t> kLicence{0x08, 0x02, 0x12, 0x10};
+constexpr size_t kVideoSampleSize{64 * 1024};
+constexpr size_t kAudioSampleSize{1024};
+
+bool isGstInitialised()
+{
+    static const bool kIsGstInitialised{gst_init_check(nullptr, nullptr, nullptr) != FALSE};
+    return kIsGstInitialised;
+}
+
+/**
+ * @brief A CdmService with media keys and key sessions on the opencdm stub, which decrypts in place at a cost
+ *        proportional to the sample size.
+ */
+class DecryptFixture
+{
+public:
+    explicit DecryptFixture(unsigned numSessions)
+        : m_cdmService{firebolt::rialto::server::IMediaKeysServerInternalFactory::createFactory(),
+                       firebolt::rialto::IMediaKeysCapabilitiesFactory::createFactory()}
+    {
+        if (!isGstInitialised() || !m_cdmService.switchToActive() ||
+            !m_cdmService.createMediaKeys(kMediaKeysHandle, kKeySystem))
+        {
+            return;
+        }
+        for (unsigned i = 0; i < numSessions; ++i)
+        {
+            int32_t keySessionId{-1};
+            if (MediaKeyErrorStatus::OK != m_cdmService.createKeySession(kMediaKeysHandle, KeySessionType::TEMPORARY,
+                                                                         nullptr, keySessionId) ||
+                MediaKeyErrorStatus::OK != m_cdmService.generateRequest(kMediaKeysHandle, keySessionId,
+                                                                        InitDataType::CENC, kInitData,
+                                                                        LimitedDurationLicense::NOT_SPECIFIED))
+            {
+                return;
+            }
+            m_keySessionIds.push_back(keySessionId);
+        }
+    }
+
+    ~DecryptFixture()
+    {
+        for (int32_t keySessionId : m_keySessionIds)
+        {
+            m_cdmService.releaseKeySession(kMediaKeysHandle, keySessionId);
+        }
+        m_cdmService.destroyMediaKeys(kMediaKeysHandle);
+        m_cdmService.switchToInactive();
+    }
+
+    bool isValid(unsigned numSessions) const { return m_keySessionIds.size() == numSessions; }
+    CdmService &cdmService() { return m_cdmService; }
+    int32_t keySessionId(unsigned index) const { return m_keySessionIds[index]; }
+
+private:
+    CdmService m_cdmService;
+    std::vector<int32_t> m_keySessionIds;
+};
+
+std::unique_ptr<DecryptFixture> gFixture;
+
+/**
+ * @brief Throughput of video streams decrypting at the same time, each with its own key session or all sharing one.
+ *
+ * Each benchmark thread is a stream. Separate sessions decrypt in parallel, a shared session serialises its streams.
+ */
+void throughput(benchmark::State &state)
+{
+    const bool kIsSessionShared{state.range(0) != 0};
+    const unsigned kNumSessions{kIsSessionShared ? 1 : static_cast<unsigned>(state.threads())};
+    if (state.thread_index() == 0)
+    {
+        gFixture = std::make_unique<DecryptFixture>(kNumSessions);
+    }
+    GstBuffer *sample{isGstInitialised() ? gst_buffer_new_allocate(nullptr, kVideoSampleSize, nullptr) : nullptr};
+
+    // the fixture is only there once all the threads have entered the loop, every thread sees the same one so they
+    // all stop on a bad one
+    bool isFailed{false};
+    for (auto _ : state)
+    {
+        if (isFailed)
+        {
+            continue;
+        }
+        if (!sample || !gFixture->isValid(kNumSessions))
+        {
+            state.SkipWithError("Failed to set up the key sessions");
+            break;
+        }
+        const int32_t kKeySessionId{gFixture->keySessionId(kIsSessionShared ? 0 : state.thread_index())};
+        if (MediaKeyErrorStatus::OK != gFixture->cdmService().decrypt(kKeySessionId, sample, nullptr))
+        {
+            // the other threads are still in the loop, so this one carries on without decrypting
+            state.SkipWithError("Failed to decrypt");
+            isFailed = true;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * kVideoSampleSize);
+
+    if (sample)
+    {
+        gst_buffer_unref(sample);
+    }
+    if (state.thread_index() == 0)
+    {
+        gFixture.reset();
+    }
+}
+
+/**
+ * @brief Latency of audio decryption while another session makes licence calls, which go through the main thread.
+ */
+void latencyDuringLicenceCalls(benchmark::State &state)
+{
+    DecryptFixture fixture{2};
+    GstBuffer *sample{isGstInitialised() ? gst_buffer_new_allocate(nullptr, kAudioSampleSize, nullptr) : nullptr};
+    if (!sample || !fixture.isValid(2))
+    {
+        state.SkipWithError("Failed to set up the key sessions");
+        return;
+    }
+
+    std::atomic<bool> isRunning{true};
+    std::thread licenceCalls(
+        [&]()
+        {
+            while (isRunning)
+            {
+                fixture.cdmService().updateSession(kMediaKeysHandle, fixture.keySessionId(1), kLicence);
+            }
+        });
+
+    std::vector<double> latencies;
+    for (auto _ : state)
+    {
+        const auto kStart = std::chrono::steady_clock::now();
+        if (MediaKeyErrorStatus::OK != fixture.cdmService().decrypt(fixture.keySessionId(0), sample, nullptr))
+        {
+            state.SkipWithError("Failed to decrypt");
+            break;
+        }
+        const std::chrono::duration<double, std::micro> kLatency{std::chrono::steady_clock::now() - kStart};
+        latencies.push_back(kLatency.count());
+    }
+    isRunning = false;
+    licenceCalls.join();
+    gst_buffer_unref(sample);
+
+    if (!latencies.empty())
+    {
+        std::sort(latencies.begin(), latencies.end());
+        const auto kPercentile = [&latencies](double p)
+        { return latencies[std::min(latencies.size() - 1, static_cast<size_t>(p * latencies.size()))]; };
+        state.counters["p50_us"] = kPercentile(0.5);
+        state.counters["p99_us"] = kPercentile(0.99);
+        state.counters["max_us"] = latencies.back();
+    }
+}
+} // namespace
+
+BENCHMARK(throughput)
+    ->Name("Decrypt/Throughput/SeparateSessions")
+    ->Arg(0)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->UseRealTime();
+BENCHMARK(throughput)->Name("Decrypt/Throughput/SharedSession")->Arg(1)->Threads(2)->UseRealTime();
+BENCHMARK(latencyDuringLicenceCalls)->Name("Decrypt/Latency/DuringLicenceCalls");
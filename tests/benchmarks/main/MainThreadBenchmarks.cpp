@@ -0,0 +1,141 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MainThread.h"
+#include <algorithm>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using firebolt::rialto::server::MainThread;
+
+namespace
+{
+// A slow call, such as a load() or a licence request, mostly waits on gstreamer or the DRM rather than using the CPU
+constexpr std::chrono::milliseconds kSlowCallDuration{2};
+constexpr unsigned kQuickCallWork{200};
+
+/**
+ * @brief The main thread and the slow session, shared by the benchmark threads which are the quick sessions.
+ */
+struct Contention
+{
+    explicit Contention(unsigned numThreads, int numSessions) : mainThread{numThreads}, latencies(numSessions)
+    {
+        const std::uint32_t kSlowClientId = mainThread.registerClient();
+        slowSession = std::thread(
+            [this, kSlowClientId]()
+            {
+                while (isRunning)
+                {
+                    mainThread.enqueueTaskAndWait(kSlowClientId,
+                                                  []() { std::this_thread::sleep_for(kSlowCallDuration); });
+                }
+            });
+    }
+
+    ~Contention()
+    {
+        isRunning = false;
+        slowSession.join();
+    }
+
+    MainThread mainThread;
+    std::atomic<bool> isRunning{true};
+    std::thread slowSession;
+    std::vector<std::vector<double>> latencies;
+};
+
+std::unique_ptr<Contention> gContention;
+
+/**
+ * @brief Latency of quick calls, like haveData, made by several sessions at once while another session makes slow
+ * calls.
+ *
+ * Each benchmark thread is a session. A pool of one thread behaves as the single main thread did, so every quick call
+ * may wait behind a slow one.
+ */
+void contention(benchmark::State &state)
+{
+    if (state.thread_index() == 0)
+    {
+        gContention = std::make_unique<Contention>(static_cast<unsigned>(state.range(0)), state.threads());
+    }
+
+    // the first iteration waits for the setup of the first thread, so only then are the shared objects there
+    std::uint32_t clientId{0};
+    std::vector<double> *latencies{nullptr};
+    for (auto _ : state)
+    {
+        if (!latencies)
+        {
+            state.PauseTiming();
+            clientId = gContention->mainThread.registerClient();
+            latencies = &gContention->latencies[state.thread_index()];
+            state.ResumeTiming();
+        }
+        const auto kStart = std::chrono::steady_clock::now();
+        gContention->mainThread.enqueueTaskAndWait(clientId,
+                                                   []()
+                                                   {
+                                                       unsigned sum{0};
+                                                       for (unsigned j = 0; j < kQuickCallWork; ++j)
+                                                       {
+                                                           sum += j;
+                                                           benchmark::DoNotOptimize(sum);
+                                                       }
+                                                   });
+        const std::chrono::duration<double, std::micro> kLatency{std::chrono::steady_clock::now() - kStart};
+        latencies->push_back(kLatency.count());
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    // all the threads have left the loop, so their latencies are complete
+    if (state.thread_index() == 0)
+    {
+        std::vector<double> allLatencies;
+        for (const auto &sessionLatencies : gContention->latencies)
+        {
+            allLatencies.insert(allLatencies.end(), sessionLatencies.begin(), sessionLatencies.end());
+        }
+        gContention.reset();
+
+        std::sort(allLatencies.begin(), allLatencies.end());
+        const auto kPercentile = [&allLatencies](double p)
+        { return allLatencies[std::min(allLatencies.size() - 1, static_cast<size_t>(p * allLatencies.size()))]; };
+        state.counters["p50_us"] = kPercentile(0.5);
+        state.counters["p99_us"] = kPercentile(0.99);
+        state.counters["max_us"] = allLatencies.back();
+    }
+}
+} // namespace
+
+BENCHMARK(contention)
+    ->Name("MainThread/Contention")
+    ->ArgName("poolThreads")
+    ->Arg(1)
+    ->Arg(4)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(8)
+    ->UseRealTime();
@@ -0,0 +1,221 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataReaderFactory.h"
+#include "IDataReader.h"
+#include "MediaFrameWriterV1.h"
+#include "MediaFrameWriterV2.h"
+#include "MediaFrameWriterV3.h"
+#include "MediaSegmentBatch.h"
+#include "ShmCommon.h"
+#include "ShmUtils.h"
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using firebolt::rialto::AddSegmentStatus;
+using firebolt::rialto::IMediaPipeline;
+using firebolt::rialto::MediaPlayerShmInfo;
+using firebolt::rialto::common::IMediaFrameWriter;
+
+namespace
+{
+constexpr std::uint32_t kFramesPerRequest{firebolt::rialto::server::kMaxFrames};
+constexpr std::uint32_t kMetadataBytes{firebolt::rialto::server::getMaxMetadataBytes()};
+constexpr std::uint32_t kMediaBytes{256 * 1024};
+constexpr std::uint32_t kVideoFrameBytes{4096};
+constexpr std::uint32_t kNumSubSamples{4};
+const std::vector<std::uint8_t> kKeyId(16, 0xA5);
+const std::vector<std::uint8_t> kInitVector(16, 0x5A);
+constexpr std::uint32_t kAdvertisedMetadataVersion{firebolt::rialto::common::SHM_REGION_METADATA_VERSION_TAG | 3};
+
+enum class Scenario
+{
+    CLEAR_VIDEO,
+    ENCRYPTED_VIDEO
+};
+
+/**
+ * @brief The shm region of a single source, laid out as the server lays out a generic partition.
+ */
+class Region
+{
+public:
+    Region() : m_buffer(kMetadataBytes + kMediaBytes), m_shmInfo{std::make_shared<MediaPlayerShmInfo>()}
+    {
+        m_shmInfo->maxMetadataBytes = kMetadataBytes;
+        m_shmInfo->metadataOffset = 0;
+        m_shmInfo->mediaDataOffset = kMetadataBytes;
+        m_shmInfo->maxMediaBytes = kMediaBytes;
+    }
+
+    void publishNewGeneration()
+    {
+        // Advertise metadata V3, as the server does when it publishes a new generation
+        const firebolt::rialto::common::ShmRegionHeader kHeader{firebolt::rialto::common::SHM_REGION_HEADER_MAGIC,
+                                                                ++m_generation, 0, 0, 0, kAdvertisedMetadataVersion};
+        std::memcpy(m_buffer.data() + firebolt::rialto::common::SHM_REGION_HEADER_OFFSET, &kHeader, sizeof(kHeader));
+    }
+
+    std::uint8_t *data() { return m_buffer.data(); }
+    const std::shared_ptr<MediaPlayerShmInfo> &shmInfo() const { return m_shmInfo; }
+
+private:
+    std::vector<std::uint8_t> m_buffer;
+    std::shared_ptr<MediaPlayerShmInfo> m_shmInfo;
+    std::uint32_t m_generation{0};
+};
+
+std::unique_ptr<IMediaPipeline::MediaSegment> createSegment(Scenario scenario)
+{
+    static const std::vector<std::uint8_t> kMediaData(kVideoFrameBytes, 0x42);
+    auto segment{std::make_unique<IMediaPipeline::MediaSegmentVideo>(1, 4135000000000, 33000000, 1920, 1080,
+                                                                     firebolt::rialto::Fraction{30, 1})};
+    segment->setData(kVideoFrameBytes, kMediaData.data());
+    segment->setSegmentAlignment(firebolt::rialto::SegmentAlignment::AU);
+    if (Scenario::ENCRYPTED_VIDEO == scenario)
+    {
+        segment->setEncrypted(true);
+        segment->setMediaKeySessionId(1);
+        segment->setKeyId(kKeyId);
+        segment->setInitVector(kInitVector);
+        segment->setCipherMode(firebolt::rialto::CipherMode::CBCS);
+        segment->setEncryptionPattern(1, 9);
+        for (std::uint32_t i = 0; i < kNumSubSamples; ++i)
+        {
+            segment->addSubSample(16, kVideoFrameBytes / kNumSubSamples - 16);
+        }
+    }
+    return segment;
+}
+
+template <typename Writer> bool writeRequest(Region &region, Scenario scenario)
+{
+    const auto kSegment{createSegment(scenario)};
+    region.publishNewGeneration();
+    Writer writer{region.data(), region.shmInfo()};
+    for (std::uint32_t i = 0; i < kFramesPerRequest; ++i)
+    {
+        if (AddSegmentStatus::OK != writer.writeFrame(kSegment))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Measures the client side cost of writing one NeedMediaData request worth of frames.
+ */
+template <typename Writer, Scenario kScenario> void encode(benchmark::State &state)
+{
+    Region region;
+    for (auto _ : state)
+    {
+        if (!writeRequest<Writer>(region, kScenario))
+        {
+            state.SkipWithError("Failed to write the frames");
+            break;
+        }
+    }
+    benchmark::DoNotOptimize(region.data()[kMetadataBytes]);
+    state.SetItemsProcessed(state.iterations() * kFramesPerRequest);
+}
+
+/**
+ * @brief Measures the server side cost of reading one HaveData worth of frames, including the segment creation.
+ */
+template <typename Writer, Scenario kScenario> void decode(benchmark::State &state)
+{
+    Region region;
+    if (!writeRequest<Writer>(region, kScenario))
+    {
+        state.SkipWithError("Failed to write the frames");
+        return;
+    }
+    const firebolt::rialto::server::DataReaderFactory kFactory;
+    for (auto _ : state)
+    {
+        auto reader{kFactory.createDataReader(firebolt::rialto::MediaSourceType::VIDEO, region.data(), 0,
+                                              kMetadataBytes, kFramesPerRequest, false)};
+        const auto kSegments{reader->readData()};
+        if (kSegments.size() != kFramesPerRequest)
+        {
+            state.SkipWithError("Failed to read the frames");
+            break;
+        }
+        benchmark::DoNotOptimize(kSegments.back()->getData());
+    }
+    state.SetItemsProcessed(state.iterations() * kFramesPerRequest);
+}
+
+/**
+ * @brief Measures the server side cost of reading one HaveData worth of frames into a batch reused between requests.
+ */
+template <typename Writer, Scenario kScenario> void decodeBatch(benchmark::State &state)
+{
+    Region region;
+    if (!writeRequest<Writer>(region, kScenario))
+    {
+        state.SkipWithError("Failed to write the frames");
+        return;
+    }
+    const firebolt::rialto::server::DataReaderFactory kFactory;
+    firebolt::rialto::server::MediaSegmentBatch batch;
+    for (auto _ : state)
+    {
+        auto reader{kFactory.createDataReader(firebolt::rialto::MediaSourceType::VIDEO, region.data(), 0,
+                                              kMetadataBytes, kFramesPerRequest, false)};
+        batch.clear();
+        reader->readSegments(batch);
+        if (batch.size() != kFramesPerRequest)
+        {
+            state.SkipWithError("Failed to read the frames");
+            break;
+        }
+        benchmark::DoNotOptimize(batch.back().data.data);
+    }
+    state.SetItemsProcessed(state.iterations() * kFramesPerRequest);
+}
+
+using firebolt::rialto::common::MediaFrameWriterV1;
+using firebolt::rialto::common::MediaFrameWriterV2;
+using firebolt::rialto::common::MediaFrameWriterV3;
+
+// Metadata V1 has no room for the encryption fields, so it is only measured for clear frames
+BENCHMARK_TEMPLATE(encode, MediaFrameWriterV1, Scenario::CLEAR_VIDEO)->Name("Metadata/V1/Encode/ClearVideo");
+BENCHMARK_TEMPLATE(encode, MediaFrameWriterV2, Scenario::CLEAR_VIDEO)->Name("Metadata/V2/Encode/ClearVideo");
+BENCHMARK_TEMPLATE(encode, MediaFrameWriterV3, Scenario::CLEAR_VIDEO)->Name("Metadata/V3/Encode/ClearVideo");
+BENCHMARK_TEMPLATE(encode, MediaFrameWriterV2, Scenario::ENCRYPTED_VIDEO)->Name("Metadata/V2/Encode/EncryptedVideo");
+BENCHMARK_TEMPLATE(encode, MediaFrameWriterV3, Scenario::ENCRYPTED_VIDEO)->Name("Metadata/V3/Encode/EncryptedVideo");
+
+BENCHMARK_TEMPLATE(decode, MediaFrameWriterV1, Scenario::CLEAR_VIDEO)->Name("Metadata/V1/Decode/ClearVideo");
+BENCHMARK_TEMPLATE(decode, MediaFrameWriterV2, Scenario::CLEAR_VIDEO)->Name("Metadata/V2/Decode/ClearVideo");
+BENCHMARK_TEMPLATE(decode, MediaFrameWriterV3, Scenario::CLEAR_VIDEO)->Name("Metadata/V3/Decode/ClearVideo");
+BENCHMARK_TEMPLATE(decode, MediaFrameWriterV2, Scenario::ENCRYPTED_VIDEO)->Name("Metadata/V2/Decode/EncryptedVideo");
+BENCHMARK_TEMPLATE(decode, MediaFrameWriterV3, Scenario::ENCRYPTED_VIDEO)->Name("Metadata/V3/Decode/EncryptedVideo");
+
+BENCHMARK_TEMPLATE(decodeBatch, MediaFrameWriterV2, Scenario::ENCRYPTED_VIDEO)
+    ->Name("Metadata/V2/DecodeBatch/EncryptedVideo");
+BENCHMARK_TEMPLATE(decodeBatch, MediaFrameWriterV3, Scenario::CLEAR_VIDEO)->Name("Metadata/V3/DecodeBatch/ClearVideo");
+BENCHMARK_TEMPLATE(decodeBatch, MediaFrameWriterV3, Scenario::ENCRYPTED_VIDEO)
+    ->Name("Metadata/V3/DecodeBatch/EncryptedVideo");
+} // namespace
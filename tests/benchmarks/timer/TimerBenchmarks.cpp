@@ -0,0 +1,106 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ITimer.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using firebolt::rialto::common::ITimer;
+using firebolt::rialto::common::ITimerFactory;
+using firebolt::rialto::common::TimerType;
+
+namespace
+{
+constexpr std::chrono::milliseconds kTimeout{1};
+
+/**
+ * @brief Creates and cancels a timer, as the need data and write data timers are on every push.
+ */
+void createAndCancel(benchmark::State &state)
+{
+    std::shared_ptr<ITimerFactory> factory{ITimerFactory::getFactory()};
+    for (auto _ : state)
+    {
+        std::unique_ptr<ITimer> timer{factory->createTimer(std::chrono::seconds{1}, []() {})};
+        if (!timer)
+        {
+            state.SkipWithError("Failed to create the timer");
+            break;
+        }
+        timer->cancel();
+    }
+}
+
+/**
+ * @brief How late one shot timers expire, while the given number of periodic timers run alongside them as the
+ *        position reporting and playback info timers of the players do.
+ */
+void lateness(benchmark::State &state)
+{
+    std::shared_ptr<ITimerFactory> factory{ITimerFactory::getFactory()};
+    std::vector<std::unique_ptr<ITimer>> periodicTimers;
+    for (std::int64_t i = 0; i < state.range(0); ++i)
+    {
+        periodicTimers.push_back(factory->createTimer(std::chrono::milliseconds{10}, []() {}, TimerType::PERIODIC));
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<double> latenesses;
+    for (auto _ : state)
+    {
+        bool isExpired{false};
+        const auto kDeadline = std::chrono::steady_clock::now() + kTimeout;
+        const auto kCallback = [&]()
+        {
+            const std::chrono::duration<double, std::micro> kLateness{std::chrono::steady_clock::now() - kDeadline};
+            std::unique_lock<std::mutex> lock{mutex};
+            latenesses.push_back(kLateness.count());
+            isExpired = true;
+            cv.notify_one();
+        };
+        std::unique_ptr<ITimer> timer{factory->createTimer(kTimeout, kCallback)};
+        std::unique_lock<std::mutex> lock{mutex};
+        if (!timer || !cv.wait_for(lock, std::chrono::seconds{1}, [&]() { return isExpired; }))
+        {
+            state.SkipWithError("The timer did not expire");
+            break;
+        }
+    }
+
+    if (!latenesses.empty())
+    {
+        std::sort(latenesses.begin(), latenesses.end());
+        const auto kPercentile = [&latenesses](double p)
+        { return latenesses[std::min(latenesses.size() - 1, static_cast<size_t>(p * latenesses.size()))]; };
+        state.counters["p50_us"] = kPercentile(0.5);
+        state.counters["p99_us"] = kPercentile(0.99);
+    }
+}
+} // namespace
+
+BENCHMARK(createAndCancel)->Name("Timer/CreateAndCancel");
+BENCHMARK(lateness)->Name("Timer/Lateness")->ArgName("periodicTimers")->Arg(0)->Arg(50)->UseRealTime();
@@ -0,0 +1,133 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WorkerThread.h"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+
+using firebolt::rialto::server::CoalescingKey;
+using firebolt::rialto::server::IPlayerTask;
+using firebolt::rialto::server::WorkerThread;
+
+namespace
+{
+// Roughly the work of a ReportPosition or CheckAudioUnderflow task, which query the pipeline
+constexpr unsigned kPeriodicTaskWork{2000};
+
+class FunctionTask : public IPlayerTask
+{
+public:
+    explicit FunctionTask(std::function<void()> &&callback) : m_callback{std::move(callback)} {}
+    void execute() const override { m_callback(); }
+
+private:
+    std::function<void()> m_callback;
+};
+
+void periodicTaskWork()
+{
+    unsigned sum{0};
+    for (unsigned i = 0; i < kPeriodicTaskWork; ++i)
+    {
+        sum += i;
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+std::unique_ptr<WorkerThread> gWorkerThread;
+std::atomic<std::uint64_t> gNumExecuted{0};
+
+/**
+ * @brief Throughput of tasks queued by several threads at once, as the gstreamer callbacks of the streams do.
+ *
+ * Each benchmark thread is a producer, the queue is drained after the timed loop.
+ */
+void enqueue(benchmark::State &state)
+{
+    if (state.thread_index() == 0)
+    {
+        gNumExecuted = 0;
+        gWorkerThread = std::make_unique<WorkerThread>();
+    }
+    for (auto _ : state)
+    {
+        gWorkerThread->enqueueTask(std::make_unique<FunctionTask>([]() { ++gNumExecuted; }));
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    // all the threads have left the loop, so all the tasks have been queued
+    if (state.thread_index() == 0)
+    {
+        while (gNumExecuted < static_cast<std::uint64_t>(state.iterations() * state.threads()))
+        {
+            std::this_thread::yield();
+        }
+        state.counters["max_queue_depth"] = gWorkerThread->getStats().maxQueueDepth;
+        gWorkerThread.reset();
+    }
+}
+
+/**
+ * @brief Position report and underflow check ticks queued while the worker thread is held up by a slow task, as
+ *        when a state change blocks it.
+ *
+ * Only one task of each key stays pending, so the worker thread catches up after one of each.
+ */
+void ticksWhileBusy(benchmark::State &state)
+{
+    std::atomic<bool> isBusy{true};
+    WorkerThread workerThread;
+    workerThread.enqueueTask(std::make_unique<FunctionTask>(
+        [&]()
+        {
+            while (isBusy)
+            {
+                std::this_thread::yield();
+            }
+        }));
+    for (auto _ : state)
+    {
+        workerThread.enqueueCoalescedTask(CoalescingKey::REPORT_POSITION,
+                                          std::make_unique<FunctionTask>(periodicTaskWork));
+        workerThread.enqueueCoalescedTask(CoalescingKey::CHECK_AUDIO_UNDERFLOW,
+                                          std::make_unique<FunctionTask>(periodicTaskWork));
+    }
+
+    std::atomic<bool> isCaughtUp{false};
+    workerThread.enqueueTask(std::make_unique<FunctionTask>([&]() { isCaughtUp = true; }));
+
+    const auto kStart = std::chrono::steady_clock::now();
+    isBusy = false;
+    while (!isCaughtUp)
+    {
+        std::this_thread::yield();
+    }
+    const std::chrono::duration<double, std::micro> kCatchUp{std::chrono::steady_clock::now() - kStart};
+    state.counters["catch_up_us"] = kCatchUp.count();
+    state.counters["coalesced"] = workerThread.getStats().coalescedTasks;
+}
+} // namespace
+
+BENCHMARK(enqueue)->Name("WorkerThread/Enqueue")->Threads(1)->Threads(4)->UseRealTime();
+BENCHMARK(ticksWhileBusy)->Name("WorkerThread/PeriodicTicks/WhileBusy");
@@ -217,6 +217,15 @@ MATCHER_P4(haveDataRequestMatcher, sessionId, status, numFrames, requestId, "")
             (kRequest->request_id() == requestId) && (kRequest->num_frames() == numFrames));
 }
 
+MATCHER_P4(haveDataMultiRequestMatcher, sessionId, status, numFrames, requestId, "")
+{
+    const ::firebolt::rialto::HaveDataMultiRequest *kRequest =
+        dynamic_cast<const ::firebolt::rialto::HaveDataMultiRequest *>(arg);
+    return ((kRequest->session_id() == sessionId) && (kRequest->data_size() == 1) &&
+            (kRequest->data(0).status() == status) && (kRequest->data(0).request_id() == requestId) &&
+            (kRequest->data(0).num_frames() == numFrames));
+}
+
 MATCHER_P(stopRequestMatcher, sessionId, "")
 {
     const ::firebolt::rialto::StopRequest *kRequest = dynamic_cast<const ::firebolt::rialto::StopRequest *>(arg);
@@ -393,6 +402,13 @@ MATCHER_P2(getStatsRequestMatcher, sessionId, sourceId, "")
     return (kRequest->session_id() == sessionId) && (kRequest->source_id() == sourceId);
 }
 
+MATCHER_P2(enableStreamingModeRequestMatcher, sessionId, sourceId, "")
+{
+    const ::firebolt::rialto::EnableStreamingModeRequest *kRequest =
+        dynamic_cast<const ::firebolt::rialto::EnableStreamingModeRequest *>(arg);
+    return (kRequest->session_id() == sessionId) && (kRequest->source_id() == sourceId);
+}
+
 MATCHER_P(getSupportedMimeTypesRequestMatcher, sourceType, "")
 {
     const ::firebolt::rialto::GetSupportedMimeTypesRequest *kRequest =
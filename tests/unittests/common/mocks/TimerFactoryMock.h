@@ -34,6 +34,7 @@ public:
                 (const std::chrono::milliseconds &timeout, const std::function<void()> &callback,
                  common::TimerType timerType),
                 (const, override));
+    MOCK_METHOD(common::TimerStats, getStats, (), (const, override));
 };
 } // namespace firebolt::rialto::server
 
@@ -20,12 +20,15 @@
 #include <condition_variable>
 #include <gtest/gtest.h>
 #include <mutex>
+#include <set>
 #include <thread>
+#include <vector>
 
 #include "ITimer.h"
 
 using firebolt::rialto::common::ITimer;
 using firebolt::rialto::common::ITimerFactory;
+using firebolt::rialto::common::TimerStats;
 using firebolt::rialto::common::TimerType;
 
 namespace
@@ -143,3 +146,106 @@ TEST(TimerTests, ShouldCancelPeriodicTimerInCallback)
         EXPECT_EQ(callCounter, 3);
     }
 }
+
+TEST(TimerTests, ShouldExpireTimersInDeadlineOrder)
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<int> expired;
+    std::vector<std::unique_ptr<ITimer>> timers;
+    for (int timeoutMs : {40, 10, 30, 20})
+    {
+        timers.push_back(ITimerFactory::getFactory()->createTimer(std::chrono::milliseconds{timeoutMs},
+                                                                  [&, timeoutMs]()
+                                                                  {
+                                                                      std::unique_lock<std::mutex> lock{mtx};
+                                                                      expired.push_back(timeoutMs);
+                                                                      cv.notify_one();
+                                                                  }));
+    }
+
+    std::unique_lock<std::mutex> lock{mtx};
+    cv.wait_for(lock, kEnoughTimeForTestToComplete, [&] { return expired.size() == timers.size(); });
+    EXPECT_EQ(expired, (std::vector<int>{10, 20, 30, 40}));
+}
+
+TEST(TimerTests, ShouldRunAllTimersOnOneThread)
+{
+    constexpr size_t kNumTimers{20};
+    std::mutex mtx;
+    std::condition_variable cv;
+    size_t callCounter{0};
+    std::set<std::thread::id> threadIds;
+    std::vector<std::unique_ptr<ITimer>> timers;
+    for (size_t i = 0; i < kNumTimers; ++i)
+    {
+        timers.push_back(ITimerFactory::getFactory()->createTimer(std::chrono::milliseconds{10},
+                                                                  [&]()
+                                                                  {
+                                                                      std::unique_lock<std::mutex> lock{mtx};
+                                                                      threadIds.insert(std::this_thread::get_id());
+                                                                      ++callCounter;
+                                                                      cv.notify_one();
+                                                                  }));
+    }
+
+    std::unique_lock<std::mutex> lock{mtx};
+    cv.wait_for(lock, kEnoughTimeForTestToComplete, [&] { return callCounter == kNumTimers; });
+    EXPECT_EQ(callCounter, kNumTimers);
+    EXPECT_EQ(threadIds.size(), 1);
+}
+
+TEST(TimerTests, ShouldWaitForRunningCallbackWhenCancelled)
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool callbackStarted{false};
+    std::atomic_bool callbackFinished{false};
+    const auto kCallback = [&]()
+    {
+        {
+            std::unique_lock<std::mutex> lock{mtx};
+            callbackStarted = true;
+            cv.notify_one();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        callbackFinished = true;
+    };
+    std::unique_ptr<ITimer> timer{ITimerFactory::getFactory()->createTimer(std::chrono::milliseconds{10}, kCallback)};
+    {
+        std::unique_lock<std::mutex> lock{mtx};
+        cv.wait_for(lock, kEnoughTimeForTestToComplete, [&] { return callbackStarted; });
+    }
+    ASSERT_TRUE(callbackStarted);
+    timer->cancel();
+    EXPECT_TRUE(callbackFinished);
+    EXPECT_FALSE(timer->isActive());
+}
+
+TEST(TimerTests, ShouldReportTimerCounts)
+{
+    const TimerStats kInitialStats{ITimerFactory::getFactory()->getStats()};
+    std::atomic_bool callFlag{false};
+    std::unique_ptr<ITimer> oneShotTimer{
+        ITimerFactory::getFactory()->createTimer(std::chrono::milliseconds{10}, [&]() { callFlag = true; })};
+    std::unique_ptr<ITimer> periodicTimer{
+        ITimerFactory::getFactory()->createTimer(std::chrono::seconds{10}, []() {}, TimerType::PERIODIC)};
+
+    TimerStats stats{ITimerFactory::getFactory()->getStats()};
+    EXPECT_EQ(stats.createdTimers, kInitialStats.createdTimers + 2);
+    EXPECT_EQ(stats.activeTimers, kInitialStats.activeTimers + 2);
+
+    for (auto waited = std::chrono::milliseconds{0}; oneShotTimer->isActive() && waited < kEnoughTimeForTestToComplete;
+         waited += std::chrono::milliseconds{5})
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+    EXPECT_TRUE(callFlag);
+    stats = ITimerFactory::getFactory()->getStats();
+    EXPECT_EQ(stats.expiredTimers, kInitialStats.expiredTimers + 1);
+    EXPECT_EQ(stats.activeTimers, kInitialStats.activeTimers + 1);
+
+    periodicTimer->cancel();
+    stats = ITimerFactory::getFactory()->getStats();
+    EXPECT_EQ(stats.activeTimers, kInitialStats.activeTimers);
+}
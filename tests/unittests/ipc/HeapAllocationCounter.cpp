@@ -0,0 +1,88 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HeapAllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+thread_local bool tlCountAllocations{false};
+std::atomic<uint64_t> gAllocations{0};
+
+void *allocate(std::size_t size)
+{
+    if (tlCountAllocations)
+    {
+        gAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void *ptr = malloc((size == 0) ? 1 : size);
+    if (!ptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+} // namespace
+
+namespace HeapAllocationCounter
+{
+void countThisThread()
+{
+    tlCountAllocations = true;
+}
+
+uint64_t count()
+{
+    return gAllocations.load(std::memory_order_relaxed);
+}
+} // namespace HeapAllocationCounter
+
+void *operator new(std::size_t size)
+{
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+    return allocate(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    free(ptr);
+}
@@ -0,0 +1,41 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HEAP_ALLOCATION_COUNTER_H_
+#define HEAP_ALLOCATION_COUNTER_H_
+
+#include <cstdint>
+
+/**
+ * The unit test binary replaces the global operator new, so that the calls made on selected threads can be counted.
+ */
+namespace HeapAllocationCounter
+{
+/**
+ * @brief Starts counting the operator new calls made on the calling thread.
+ */
+void countThisThread();
+
+/**
+ * @brief Returns the number of operator new calls made so far on the counted threads.
+ */
+uint64_t count();
+} // namespace HeapAllocationCounter
+
+#endif // HEAP_ALLOCATION_COUNTER_H_
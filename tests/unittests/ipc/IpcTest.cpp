@@ -18,10 +18,24 @@
  */
 
 #include "ClientStub.h"
+#include "HeapAllocationCounter.h"
+#include "IIpcController.h"
+#include "IIpcControllerFactory.h"
+#include "IIpcServerFactory.h"
 #include "ServerStub.h"
+#include "SlabAllocator.h"
 #include "TestClientMock.h"
 #include "TestModuleMock.h"
+#include "rialtoipc-transport.pb.h"
+#include <condition_variable>
 #include <gtest/gtest.h>
+#include <map>
+#include <mutex>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
 
 using namespace firebolt::rialto;
 using namespace firebolt::rialto::ipc;
@@ -44,6 +58,25 @@ MATCHER_P4(MultiVarRequestMatcher, var1, var2, var3, var4, "")
     return ((arg->var1() == var1) && (arg->var2() == var2) && (arg->var3() == var3) && (arg->var4() == var4));
 }
 
+/**
+ * Service with a haveData shaped method whose handler doesn't allocate, so the allocations of the server dispatch
+ * can be counted.
+ */
+class HaveDataModule : public ::firebolt::rialto::TestModule
+{
+public:
+    void TestHaveData(::google::protobuf::RpcController *controller,
+                      const ::firebolt::rialto::TestHaveDataRequest *request, ::firebolt::rialto::TestNoVar *response,
+                      ::google::protobuf::Closure *done) override
+    {
+        HeapAllocationCounter::countThisThread();
+        m_frames += request->num_frames();
+        done->Run();
+    }
+
+    std::atomic<uint32_t> m_frames{0};
+};
+
 class RialtoIpcTest : public ::testing::Test
 {
 protected:
@@ -96,6 +129,20 @@ TEST_F(RialtoIpcTest, SingleVarRequest)
     EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
 }
 
+/**
+ * Test that IPC can send repeated requests, once the method is bound to an id only the id is sent.
+ */
+TEST_F(RialtoIpcTest, RepeatedSingleVarRequest)
+{
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(m_int), _, _))
+        .Times(3)
+        .WillRepeatedly(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+
+    EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+    EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+    EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+}
+
 /**
  * Test that IPC can send a request and expect a response with a single variable.
  */
@@ -112,6 +159,75 @@ TEST_F(RialtoIpcTest, SingleVarResponse)
     EXPECT_EQ(m_int, retInt);
 }
 
+/**
+ * Test that once warmed up the server dispatches calls without growing its arenas, call pool or reply buffers.
+ */
+TEST_F(RialtoIpcTest, SteadyStateAllocations)
+{
+    constexpr unsigned kWarmUpCalls{3};
+    constexpr unsigned kCalls{10};
+    int32_t retInt = 0;
+
+    EXPECT_CALL(*m_testModuleMock, TestResponseSingleVar(_, _, _, _))
+        .Times(kWarmUpCalls + kCalls)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(m_testModuleMock->getSingleVarResponse(m_int)),
+                              WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn))));
+
+    for (unsigned i = 0; i < kWarmUpCalls; i++)
+    {
+        EXPECT_TRUE(m_clientStub->sendRequestWithSingleVarResponse(retInt));
+    }
+
+    const firebolt::rialto::ipc::ServerStats kBefore = m_serverStub->getStats();
+    for (unsigned i = 0; i < kCalls; i++)
+    {
+        EXPECT_TRUE(m_clientStub->sendRequestWithSingleVarResponse(retInt));
+        EXPECT_EQ(m_int, retInt);
+    }
+    const firebolt::rialto::ipc::ServerStats kAfter = m_serverStub->getStats();
+
+    EXPECT_EQ(kAfter.calls - kBefore.calls, kCalls);
+    EXPECT_EQ(kAfter.poolMisses, kBefore.poolMisses);
+}
+
+/**
+ * Test that once warmed up the server thread doesn't allocate from the heap to dispatch haveData calls.
+ */
+TEST_F(RialtoIpcTest, SteadyStateHaveDataHeapAllocations)
+{
+    constexpr unsigned kWarmUpCalls{3};
+    constexpr unsigned kCalls{100};
+    constexpr uint32_t kNumFrames{24};
+
+    m_clientStub->disconnect();
+    m_clientStub.reset();
+    m_serverStub.reset();
+
+    auto haveDataModule = std::make_shared<HaveDataModule>();
+    m_serverStub = std::make_shared<ServerStub>(haveDataModule);
+    m_serverStub->init();
+    m_clientStub = std::make_shared<ClientStub>(m_testClientMock, m_socketName);
+    m_clientStub->connect();
+
+    for (unsigned i = 0; i < kWarmUpCalls; i++)
+    {
+        EXPECT_TRUE(m_clientStub->sendHaveData(1, kNumFrames, i));
+    }
+
+    const uint64_t kAllocationsBefore = HeapAllocationCounter::count();
+    const uint64_t kSlabHeapAllocationsBefore = SlabAllocator::instance().getStats().heapAllocations;
+    for (unsigned i = 0; i < kCalls; i++)
+    {
+        EXPECT_TRUE(m_clientStub->sendHaveData(1, kNumFrames, kWarmUpCalls + i));
+    }
+    const uint64_t kAllocationsAfter = HeapAllocationCounter::count();
+    const uint64_t kSlabHeapAllocationsAfter = SlabAllocator::instance().getStats().heapAllocations;
+
+    EXPECT_EQ(haveDataModule->m_frames, (kWarmUpCalls + kCalls) * kNumFrames);
+    EXPECT_EQ(kAllocationsAfter - kAllocationsBefore, 0U);
+    EXPECT_EQ(kSlabHeapAllocationsAfter - kSlabHeapAllocationsBefore, 0U);
+}
+
 /**
  * Test that IPC can send a request with a multiple variables.
  */
@@ -170,6 +286,191 @@ TEST_F(RialtoIpcTest, SingleVarEvent)
     m_clientStub->waitForSingleVarEvent(retInt);
 }
 
+/**
+ * Test that IPC client can resolve repeated events that are sent with only the event id.
+ */
+TEST_F(RialtoIpcTest, RepeatedSingleVarEvent)
+{
+    int32_t retInt = 0;
+
+    // the first request advertises to the server that the client accepts event ids, the events are then
+    // dispatched by the client while it is processing the following requests
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(m_int), _, _))
+        .Times(3)
+        .WillRepeatedly(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+
+    EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+    m_serverStub->sendSingleVarEvent(m_int);
+    EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+    m_serverStub->sendSingleVarEvent(m_int + 1);
+    EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+
+    m_clientStub->waitForSingleVarEvent(retInt);
+
+    EXPECT_EQ(m_int + 1, retInt);
+}
+
+/**
+ * Test that IPC can send requests and receive responses over the shared memory transport.
+ */
+TEST_F(RialtoIpcTest, SharedMemoryTransportRequests)
+{
+    int32_t retInt = 0;
+
+    EXPECT_TRUE(m_clientStub->enableSharedMemoryTransport());
+
+    // the transport is negotiated while the first request is in flight, the rest go over shared memory
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(m_int), _, _))
+        .Times(3)
+        .WillRepeatedly(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+    EXPECT_CALL(*m_testModuleMock, TestResponseSingleVar(_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(m_testModuleMock->getSingleVarResponse(m_int)),
+                        WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn))));
+
+    EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+    EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+    EXPECT_TRUE(m_clientStub->sendRequestWithSingleVarResponse(retInt));
+    EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+
+    EXPECT_EQ(m_int, retInt);
+}
+
+/**
+ * Test that IPC client receives events in order over the shared memory transport.
+ */
+TEST_F(RialtoIpcTest, SharedMemoryTransportEvents)
+{
+    int32_t retInt = 0;
+
+    EXPECT_TRUE(m_clientStub->enableSharedMemoryTransport());
+
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(m_int), _, _))
+        .Times(3)
+        .WillRepeatedly(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+
+    EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+    m_serverStub->sendSingleVarEvent(m_int);
+    EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+    m_serverStub->sendSingleVarEvent(m_int + 1);
+    EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+
+    m_clientStub->waitForSingleVarEvent(retInt);
+
+    EXPECT_EQ(m_int + 1, retInt);
+}
+
+/**
+ * Test that a queued event is replaced by a newer event with the same key, and the remaining events are
+ * delivered in order before the reply.
+ */
+TEST_F(RialtoIpcTest, CoalescedEvents)
+{
+    const std::vector<std::pair<int32_t, int32_t>> kExpectedEvents{{2, 1}, {1, 3}};
+
+    // the events are sent from the handler so they are all queued before the event loop can flush them
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(m_int), _, _))
+        .WillOnce(WithArgs<3>(Invoke(
+            [this](::google::protobuf::Closure *done)
+            {
+                m_serverStub->sendCoalescedEvent(1, 1);
+                m_serverStub->sendCoalescedEvent(1, 2);
+                m_serverStub->sendCoalescedEvent(2, 1);
+                m_serverStub->sendCoalescedEvent(1, 3);
+                done->Run();
+            })));
+
+    EXPECT_TRUE(m_clientStub->sendSingleVarRequest(m_int));
+
+    EXPECT_EQ(m_clientStub->getCoalescedEvents(), kExpectedEvents);
+}
+
+/**
+ * Test that a server with worker loops serves requests and events for several clients.
+ */
+TEST_F(RialtoIpcTest, WorkerLoops)
+{
+    constexpr unsigned kNumWorkerLoops{2};
+    constexpr unsigned kNumClients{3};
+    int32_t retInt = 0;
+
+    // replace the server with one that serves the clients from worker threads
+    m_clientStub->disconnect();
+    m_clientStub.reset();
+    m_serverStub = std::make_shared<ServerStub>(m_testModuleMock);
+    m_serverStub->init(kNumWorkerLoops);
+
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, SingleVarRequestMatcher(m_int), _, _))
+        .Times(kNumClients * 2)
+        .WillRepeatedly(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+
+    // the listening socket has a backlog of one, so each client makes a request before the next connects
+    std::vector<std::shared_ptr<ClientStub>> clientStubs;
+    for (unsigned i = 0; i < kNumClients; i++)
+    {
+        clientStubs.emplace_back(std::make_shared<ClientStub>(m_testClientMock, m_socketName));
+        ASSERT_TRUE(clientStubs.back()->connect());
+        EXPECT_TRUE(clientStubs.back()->sendSingleVarRequest(m_int));
+    }
+
+    for (const auto &clientStub : clientStubs)
+    {
+        EXPECT_TRUE(clientStub->sendSingleVarRequest(m_int));
+    }
+
+    // the server stub sends events to the last client to connect
+    m_clientStub = clientStubs.back();
+    clientStubs.pop_back();
+
+    m_clientStub->startMessageThread();
+    m_serverStub->sendSingleVarEvent(m_int);
+    m_clientStub->waitForSingleVarEvent(retInt);
+    EXPECT_EQ(m_int, retInt);
+
+    for (const auto &clientStub : clientStubs)
+    {
+        clientStub->disconnect();
+    }
+}
+
+/**
+ * Test that a server with worker loops can be destroyed by dropping the last reference on a worker thread.
+ */
+TEST_F(RialtoIpcTest, DestroyedOnWorkerLoop)
+{
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds), 0);
+
+    std::shared_ptr<IServer> server = IServerFactory::createFactory()->create(1);
+    ASSERT_NE(server, nullptr);
+    std::weak_ptr<IServer> weakServer = server;
+
+    std::mutex lock;
+    std::condition_variable cond;
+    bool disconnected = false;
+
+    // the disconnected callback is called on the worker thread, which then holds the last reference
+    auto disconnectedCb = [&](const std::shared_ptr<IClient> &)
+    {
+        std::lock_guard<std::mutex> locker(lock);
+        server.reset();
+        disconnected = true;
+        cond.notify_all();
+    };
+    ASSERT_NE(server->addClient(fds[0], disconnectedCb), nullptr);
+    close(fds[0]);
+    close(fds[1]);
+
+    std::unique_lock<std::mutex> locker(lock);
+    ASSERT_TRUE(cond.wait_for(locker, std::chrono::seconds(5), [&]() { return disconnected; }));
+    locker.unlock();
+
+    for (int i = 0; (i < 500) && !weakServer.expired(); i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(weakServer.expired());
+}
+
 /**
  * Test that IPC client can received multiple variable events from the server.
  */
@@ -188,6 +489,169 @@ TEST_F(RialtoIpcTest, MultiVarEvent)
     m_clientStub->waitForMultiVarEvent(retInt, retUint, retEnum, retStr);
 }
 
+/**
+ * Test that requests, responses and events too big to send inline are sent out of band, including the first call made
+ * on a channel.
+ */
+TEST_F(RialtoIpcTest, LargeMessages)
+{
+    const std::string kLargeStr(200 * 1024, 'x');
+
+    // out of band support is agreed when the channel connects, so the very first call can be a large one
+    EXPECT_CALL(*m_testModuleMock,
+                TestRequestMultiVar(_, MultiVarRequestMatcher(m_int, m_uint, m_enum, kLargeStr), _, _))
+        .WillOnce(WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn)));
+    EXPECT_TRUE(m_clientStub->sendMultiVarRequest(m_int, m_uint, m_enum, kLargeStr));
+
+    int32_t retInt = 0;
+    uint32_t retUint = 0;
+    firebolt::rialto::TestMultiVar_TestType retEnum = firebolt::rialto::TestMultiVar_TestType_ENUM2;
+    std::string retStr;
+    EXPECT_CALL(*m_testModuleMock, TestResponseMultiVar(_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(m_testModuleMock->getMultiVarResponse(m_int, m_uint, m_enum, kLargeStr)),
+                        WithArgs<0, 3>(Invoke(&(*m_testModuleMock), &TestModuleMock::defaultReturn))));
+    EXPECT_TRUE(m_clientStub->sendRequestWithMultiVarResponse(retInt, retUint, retEnum, retStr));
+    EXPECT_EQ(kLargeStr, retStr);
+
+    firebolt::rialto::TestEventMultiVar_TestType retEventEnum = firebolt::rialto::TestEventMultiVar_TestType_ENUM2;
+    retStr.clear();
+    m_clientStub->startMessageThread();
+    m_serverStub->sendMultiVarEvent(m_int, m_uint, firebolt::rialto::TestEventMultiVar_TestType_ENUM1, kLargeStr);
+    m_clientStub->waitForMultiVarEvent(retInt, retUint, retEventEnum, retStr);
+    EXPECT_EQ(kLargeStr, retStr);
+}
+
+/**
+ * Test that a channel connected to a server which predates the connection setup call, and so rejects it, still sends
+ * calls up to the original inline limit inline.
+ */
+TEST_F(RialtoIpcTest, LargeMessagesToLegacyServer)
+{
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds), 0);
+    std::shared_ptr<IChannel> channel = IChannelFactory::createFactory()->createChannel(fds[0]);
+    ASSERT_NE(channel, nullptr);
+
+    std::vector<uint8_t> buf(128 * 1024);
+    ssize_t len = recv(fds[1], buf.data(), buf.size(), 0);
+    ASSERT_GT(len, 0);
+    transport::MessageToServer setup;
+    ASSERT_TRUE(setup.ParseFromArray(buf.data(), static_cast<int>(len)));
+    ASSERT_TRUE(setup.has_call());
+    EXPECT_FALSE(setup.call().has_service_name());
+    EXPECT_FALSE(setup.call().has_method_id());
+    EXPECT_TRUE(setup.call().accept_out_of_band());
+
+    // the call is held until the server has answered the setup
+    const std::string kInlineStr(100 * 1024, 'y');
+    TestMultiVar request;
+    request.set_var1(m_int);
+    request.set_var2(m_uint);
+    request.set_var3(m_enum);
+    request.set_var4(kInlineStr);
+    TestNoVar response;
+    auto controller = IControllerFactory::createFactory()->create();
+    TestModule::Stub stub(channel.get());
+    stub.TestRequestMultiVar(controller.get(), &request, &response, nullptr);
+    EXPECT_EQ(recv(fds[1], buf.data(), buf.size(), MSG_DONTWAIT), -1);
+
+    // reject the setup as a server without it does
+    transport::MessageFromServer error;
+    error.mutable_error()->set_reply_id(setup.call().serial_id());
+    error.mutable_error()->set_error_reason("Unknown service ''");
+    const std::string kErrorData = error.SerializeAsString();
+    ASSERT_EQ(send(fds[1], kErrorData.data(), kErrorData.size(), 0), static_cast<ssize_t>(kErrorData.size()));
+    EXPECT_TRUE(channel->wait(1000));
+    EXPECT_TRUE(channel->process());
+
+    len = recv(fds[1], buf.data(), buf.size(), 0);
+    ASSERT_GT(len, 0);
+    transport::MessageToServer call;
+    ASSERT_TRUE(call.ParseFromArray(buf.data(), static_cast<int>(len)));
+    ASSERT_TRUE(call.has_call());
+    EXPECT_EQ(call.call().method_name(), "TestRequestMultiVar");
+    TestMultiVar sentRequest;
+    ASSERT_TRUE(sentRequest.ParseFromString(call.call().request_message()));
+    EXPECT_EQ(sentRequest.var4(), kInlineStr);
+
+    // the call is never answered, so the channel fails it when destroyed, while the controller is still alive
+    channel.reset();
+    close(fds[1]);
+}
+
+/**
+ * Test that channels receiving on their own threads at the same time each get their own responses, whole, both for
+ * messages sent inline and out of band.
+ */
+TEST_F(RialtoIpcTest, ConcurrentChannels)
+{
+    constexpr int32_t kNumChannels{2};
+    constexpr int kNumCalls{20};
+    const std::vector<size_t> kResponseSizes{60 * 1024, 200 * 1024, 16};
+
+    // the server is dispatched on a single thread, so these need no lock
+    std::map<IClient *, int32_t> channelIndices;
+    std::map<IClient *, int> numResponses;
+    const auto kGetClient = [](::google::protobuf::RpcController *controller)
+    { return dynamic_cast<IController *>(controller)->getClient().get(); };
+
+    EXPECT_CALL(*m_testModuleMock, TestRequestSingleVar(_, _, _, _))
+        .Times(kNumChannels)
+        .WillRepeatedly(Invoke(
+            [&](::google::protobuf::RpcController *controller, const firebolt::rialto::TestSingleVar *request,
+                firebolt::rialto::TestNoVar *, ::google::protobuf::Closure *done)
+            {
+                channelIndices[kGetClient(controller)] = request->var1();
+                done->Run();
+            }));
+    EXPECT_CALL(*m_testModuleMock, TestResponseMultiVar(_, _, _, _))
+        .Times(kNumChannels * kNumCalls)
+        .WillRepeatedly(Invoke(
+            [&](::google::protobuf::RpcController *controller, const firebolt::rialto::TestNoVar *,
+                firebolt::rialto::TestMultiVar *response, ::google::protobuf::Closure *done)
+            {
+                IClient *client{kGetClient(controller)};
+                const int32_t kIndex{channelIndices.at(client)};
+                const size_t kSize{kResponseSizes[numResponses[client]++ % kResponseSizes.size()]};
+                *response = m_testModuleMock->getMultiVarResponse(kIndex, kSize, m_enum,
+                                                                  std::string(kSize, static_cast<char>('a' + kIndex)));
+                done->Run();
+            }));
+
+    std::vector<std::shared_ptr<ClientStub>> clientStubs{m_clientStub,
+                                                         std::make_shared<ClientStub>(m_testClientMock, m_socketName)};
+    ASSERT_TRUE(clientStubs[1]->connect());
+
+    std::vector<std::thread> channelThreads;
+    for (int32_t index = 0; index < kNumChannels; ++index)
+    {
+        channelThreads.emplace_back(
+            [&, index]()
+            {
+                const std::shared_ptr<ClientStub> &kClientStub{clientStubs[index]};
+                EXPECT_TRUE(kClientStub->sendSingleVarRequest(index));
+                for (int i = 0; i < kNumCalls; ++i)
+                {
+                    int32_t retInt = -1;
+                    uint32_t retUint = 0;
+                    firebolt::rialto::TestMultiVar_TestType retEnum = firebolt::rialto::TestMultiVar_TestType_ENUM2;
+                    std::string retStr;
+                    const size_t kExpectedSize{kResponseSizes[i % kResponseSizes.size()]};
+                    EXPECT_TRUE(kClientStub->sendRequestWithMultiVarResponse(retInt, retUint, retEnum, retStr));
+                    EXPECT_EQ(retInt, index);
+                    EXPECT_EQ(retUint, kExpectedSize);
+                    EXPECT_EQ(retStr, std::string(kExpectedSize, static_cast<char>('a' + index)));
+                }
+            });
+    }
+    for (std::thread &channelThread : channelThreads)
+    {
+        channelThread.join();
+    }
+
+    clientStubs[1]->disconnect();
+}
+
 /**
  * Test that IPC client returns false when message is timeouted.
  */
@@ -216,6 +680,33 @@ TEST_F(RialtoIpcTest, Timeout)
     m_testModuleMock->failureReturn(controller, done);
 }
 
+/**
+ * Test that a method with its own timeout times out after that, rather than the default timeout of the channel.
+ */
+TEST_F(RialtoIpcTest, MethodTimeout)
+{
+    constexpr bool kExpectMessage{false};
+    ::google::protobuf::RpcController *controller;
+    ::google::protobuf::Closure *done;
+    m_clientStub->startMessageThread(kExpectMessage);
+
+    EXPECT_CALL(*m_testModuleMock, TestRequestShortTimeout(_, SingleVarRequestMatcher(m_int), _, _))
+        .WillOnce(WithArgs<0, 3>(Invoke(
+            [&](auto *c, auto *d)
+            {
+                controller = c;
+                done = d;
+            })));
+
+    const auto kStart = std::chrono::steady_clock::now();
+    EXPECT_FALSE(m_clientStub->sendShortTimeoutRequest(m_int));
+    EXPECT_LT(std::chrono::steady_clock::now() - kStart, std::chrono::seconds(1));
+
+    m_clientStub.reset();
+
+    m_testModuleMock->failureReturn(controller, done);
+}
+
 /**
  * Test that IPC client can process no reply request
  */
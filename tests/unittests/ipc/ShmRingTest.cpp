@@ -0,0 +1,234 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShmRing.h"
+#include "ShmTransport.h"
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <string>
+#include <vector>
+
+using namespace firebolt::rialto::ipc;
+
+namespace
+{
+constexpr size_t kCapacity{1024};
+} // namespace
+
+class ShmRingTest : public ::testing::Test
+{
+protected:
+    std::vector<uint64_t> m_region = std::vector<uint64_t>(ShmRing::regionSize(kCapacity) / sizeof(uint64_t));
+    ShmRing m_producer;
+    ShmRing m_consumer;
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_producer.init(m_region.data(), kCapacity));
+        ASSERT_TRUE(m_consumer.attach(m_region.data(), kCapacity));
+    }
+
+    std::string read(uint64_t &tag)
+    {
+        const uint8_t *data = nullptr;
+        size_t length = 0;
+        if (!m_consumer.peek(&tag, &data, &length))
+            return {};
+
+        std::string message(reinterpret_cast<const char *>(data), length);
+        m_consumer.consume();
+        return message;
+    }
+};
+
+/**
+ * Test that records are read back in order with their tags.
+ */
+TEST_F(ShmRingTest, WriteAndRead)
+{
+    uint64_t tag = 0;
+
+    EXPECT_TRUE(m_consumer.empty());
+    EXPECT_TRUE(m_producer.write(1, "first", 5));
+    EXPECT_TRUE(m_producer.write(2, "second", 6));
+    EXPECT_FALSE(m_consumer.empty());
+
+    EXPECT_EQ(read(tag), "first");
+    EXPECT_EQ(tag, 1u);
+    EXPECT_EQ(read(tag), "second");
+    EXPECT_EQ(tag, 2u);
+    EXPECT_TRUE(m_consumer.empty());
+}
+
+/**
+ * Test that a record is not removed from the ring until it is consumed.
+ */
+TEST_F(ShmRingTest, PeekDoesNotConsume)
+{
+    uint64_t tag = 0;
+    const uint8_t *data = nullptr;
+    size_t length = 0;
+
+    EXPECT_TRUE(m_producer.write(7, "message", 7));
+    EXPECT_TRUE(m_consumer.peek(&tag, &data, &length));
+    EXPECT_TRUE(m_consumer.peek(&tag, &data, &length));
+    EXPECT_EQ(length, 7u);
+
+    m_consumer.consume();
+    EXPECT_FALSE(m_consumer.peek(&tag, &data, &length));
+}
+
+/**
+ * Test that writes fail once the ring is full and succeed again once records are consumed.
+ */
+TEST_F(ShmRingTest, Full)
+{
+    const std::string kMessage(100, 'x');
+    uint64_t tag = 0;
+    unsigned written = 0;
+
+    while (m_producer.write(written, kMessage.data(), kMessage.size()))
+        written++;
+
+    EXPECT_GT(written, 0u);
+    EXPECT_EQ(read(tag), kMessage);
+    EXPECT_TRUE(m_producer.write(written, kMessage.data(), kMessage.size()));
+}
+
+/**
+ * Test that records that don't fit at the end of the buffer wrap around to the start.
+ */
+TEST_F(ShmRingTest, Wrap)
+{
+    const std::string kMessage(200, 'y');
+    uint64_t tag = 0;
+
+    for (uint64_t i = 0; i < 32; i++)
+    {
+        ASSERT_TRUE(m_producer.write(i, kMessage.data(), kMessage.size()));
+        ASSERT_EQ(read(tag), kMessage);
+        ASSERT_EQ(tag, i);
+    }
+    EXPECT_TRUE(m_consumer.empty());
+}
+
+/**
+ * Test that records bigger than the maximum record size are rejected.
+ */
+TEST_F(ShmRingTest, TooBig)
+{
+    const std::string kMessage(m_producer.maxRecordSize() + 1, 'z');
+
+    EXPECT_FALSE(m_producer.write(0, kMessage.data(), kMessage.size()));
+    EXPECT_TRUE(m_producer.write(0, kMessage.data(), kMessage.size() - 1));
+}
+
+/**
+ * Test that a header and a payload are written as a single record, within the same size limit.
+ */
+TEST_F(ShmRingTest, WriteWithHeader)
+{
+    uint64_t tag = 0;
+
+    EXPECT_TRUE(m_producer.write(3, "head", 4, "payload", 7));
+    EXPECT_TRUE(m_producer.write(4, "head", 4, nullptr, 0));
+    EXPECT_EQ(read(tag), "headpayload");
+    EXPECT_EQ(tag, 3u);
+    EXPECT_EQ(read(tag), "head");
+    EXPECT_EQ(tag, 4u);
+
+    const std::string kMessage(m_producer.maxRecordSize() - 3, 'z');
+    EXPECT_FALSE(m_producer.write(0, "head", 4, kMessage.data(), kMessage.size()));
+    EXPECT_TRUE(m_producer.write(0, "hea", 3, kMessage.data(), kMessage.size()));
+}
+
+/**
+ * Test that the producer only sees the consumer waiting flag once after it has been set.
+ */
+TEST_F(ShmRingTest, ConsumerWaiting)
+{
+    // a new ring starts with the consumer waiting
+    EXPECT_TRUE(m_producer.clearConsumerWaiting());
+    EXPECT_FALSE(m_producer.clearConsumerWaiting());
+
+    EXPECT_FALSE(m_consumer.setConsumerWaiting(true));
+    EXPECT_TRUE(m_producer.write(0, "a", 1));
+    EXPECT_TRUE(m_producer.clearConsumerWaiting());
+
+    // setting the flag when there is already data tells the consumer not to block
+    EXPECT_TRUE(m_consumer.setConsumerWaiting(true));
+
+    m_consumer.setConsumerWaiting(false);
+    EXPECT_FALSE(m_producer.clearConsumerWaiting());
+}
+
+/**
+ * Test that attaching with the wrong capacity fails.
+ */
+TEST_F(ShmRingTest, AttachWrongCapacity)
+{
+    ShmRing ring;
+    EXPECT_FALSE(ring.attach(m_region.data(), kCapacity / 2));
+}
+
+/**
+ * Test that messages sent by the creator of a transport are received by the attached side and the doorbell is rung.
+ */
+TEST(ShmTransportTest, CreateAndAttach)
+{
+    std::unique_ptr<ShmTransport> creator = ShmTransport::create(4096);
+    ASSERT_TRUE(creator);
+
+    std::unique_ptr<ShmTransport> attached =
+        ShmTransport::attach(FileDescriptor(creator->memFd()), FileDescriptor(creator->txDoorbellFd()),
+                             FileDescriptor(creator->rxDoorbellFd()), creator->ringCapacity());
+    ASSERT_TRUE(attached);
+
+    EXPECT_TRUE(creator->send(3, "ping", 4));
+
+    struct pollfd fds = {attached->rxDoorbellFd(), POLLIN, 0};
+    EXPECT_EQ(poll(&fds, 1, 0), 1);
+    attached->clearDoorbell();
+
+    uint64_t tag = 0;
+    const uint8_t *data = nullptr;
+    size_t length = 0;
+    ASSERT_TRUE(attached->peek(&tag, &data, &length));
+    EXPECT_EQ(tag, 3u);
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(data), length), "ping");
+    attached->consume();
+
+    // and the other direction
+    EXPECT_TRUE(attached->send(4, "pong", 4));
+    ASSERT_TRUE(creator->peek(&tag, &data, &length));
+    EXPECT_EQ(tag, 4u);
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(data), length), "pong");
+}
+
+/**
+ * Test that attaching fails if the ring capacity doesn't match the memfd.
+ */
+TEST(ShmTransportTest, AttachTooSmall)
+{
+    std::unique_ptr<ShmTransport> creator = ShmTransport::create(4096);
+    ASSERT_TRUE(creator);
+
+    EXPECT_FALSE(ShmTransport::attach(FileDescriptor(creator->memFd()), FileDescriptor(creator->txDoorbellFd()),
+                                      FileDescriptor(creator->rxDoorbellFd()), 8192));
+}
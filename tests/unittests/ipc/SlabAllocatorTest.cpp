@@ -0,0 +1,150 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2022 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SlabAllocator.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace firebolt::rialto::ipc;
+
+class SlabAllocatorTest : public ::testing::Test
+{
+protected:
+    SlabAllocator &m_allocator = SlabAllocator::instance();
+};
+
+/**
+ * Test that buffers of all the size classes are aligned, distinct and writable.
+ */
+TEST_F(SlabAllocatorTest, AllocateSizes)
+{
+    std::vector<uint8_t *> buffers;
+    for (size_t size = 1; size < SlabAllocator::kMaxBlockSize; size = size * 2 + 1)
+    {
+        uint8_t *buffer = m_allocator.allocate(size);
+        ASSERT_NE(buffer, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer) % 16, 0u);
+        memset(buffer, 0xa5, size);
+        buffers.push_back(buffer);
+    }
+
+    EXPECT_EQ(std::set<uint8_t *>(buffers.begin(), buffers.end()).size(), buffers.size());
+
+    for (uint8_t *buffer : buffers)
+        m_allocator.deallocate(buffer);
+}
+
+/**
+ * Test that a freed buffer is reused by the next allocation of the same size class.
+ */
+TEST_F(SlabAllocatorTest, Reuse)
+{
+    uint8_t *first = m_allocator.allocate(100);
+    m_allocator.deallocate(first);
+
+    uint8_t *second = m_allocator.allocate(90);
+    EXPECT_EQ(first, second);
+    m_allocator.deallocate(second);
+}
+
+/**
+ * Test that buffers too big for the slabs come from the heap.
+ */
+TEST_F(SlabAllocatorTest, TooBig)
+{
+    const uint64_t kHeapAllocations = m_allocator.getStats().heapAllocations;
+
+    uint8_t *buffer = m_allocator.allocate(SlabAllocator::kMaxBlockSize);
+    ASSERT_NE(buffer, nullptr);
+    memset(buffer, 0, SlabAllocator::kMaxBlockSize);
+    m_allocator.deallocate(buffer);
+
+    EXPECT_EQ(m_allocator.getStats().heapAllocations, kHeapAllocations + 1);
+}
+
+/**
+ * Test that buffers freed by another thread are reused rather than new slabs being added.
+ */
+TEST_F(SlabAllocatorTest, CrossThreadFree)
+{
+    constexpr size_t kNumBuffers{200};
+    constexpr size_t kSize{1000};
+
+    for (int i = 0; i < 2; i++)
+    {
+        std::vector<uint8_t *> buffers;
+        for (size_t j = 0; j < kNumBuffers; j++)
+            buffers.push_back(m_allocator.allocate(kSize));
+
+        std::thread freeThread(
+            [this, &buffers]()
+            {
+                for (uint8_t *buffer : buffers)
+                    m_allocator.deallocate(buffer);
+            });
+        freeThread.join();
+    }
+
+    const size_t kSlabBytes = m_allocator.getStats().slabBytes;
+
+    std::vector<uint8_t *> buffers;
+    for (size_t j = 0; j < kNumBuffers; j++)
+        buffers.push_back(m_allocator.allocate(kSize));
+    for (uint8_t *buffer : buffers)
+        m_allocator.deallocate(buffer);
+
+    EXPECT_EQ(m_allocator.getStats().slabBytes, kSlabBytes);
+}
+
+/**
+ * Test that the high water mark follows the memory in use.
+ */
+TEST_F(SlabAllocatorTest, HighWater)
+{
+    constexpr size_t kNumBuffers{256};
+    constexpr size_t kBlockSize{4096};
+
+    std::vector<uint8_t *> buffers;
+    for (size_t j = 0; j < kNumBuffers; j++)
+        buffers.push_back(m_allocator.allocate(kBlockSize - 64));
+
+    // the counters are updated in batches of up to 64KB
+    EXPECT_GE(m_allocator.getStats().highWaterBytes, kNumBuffers * kBlockSize - 64 * 1024);
+
+    for (uint8_t *buffer : buffers)
+        m_allocator.deallocate(buffer);
+}
+
+/**
+ * Test that shared buffers, and their control blocks, are returned to the allocator.
+ */
+TEST_F(SlabAllocatorTest, Shared)
+{
+    std::shared_ptr<uint8_t> buffer = m_allocator.allocateShared<uint8_t>(200);
+    ASSERT_TRUE(buffer);
+    memset(buffer.get(), 0, 200);
+    uint8_t *first = buffer.get();
+    buffer.reset();
+
+    buffer = m_allocator.allocateShared<uint8_t>(200);
+    EXPECT_EQ(buffer.get(), first);
+}
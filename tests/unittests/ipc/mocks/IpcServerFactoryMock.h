@@ -33,6 +33,7 @@ public:
     virtual ~ServerFactoryMock() = default;
 
     MOCK_METHOD(std::shared_ptr<IServer>, create, (), (override));
+    MOCK_METHOD(std::shared_ptr<IServer>, create, (unsigned numWorkerLoops), (override));
 };
 } // namespace firebolt::rialto::ipc
 
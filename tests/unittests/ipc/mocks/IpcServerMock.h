@@ -47,6 +47,7 @@ public:
     MOCK_METHOD(int, fd, (), (override, const));
     MOCK_METHOD(bool, wait, (int timeoutMSecs), (override));
     MOCK_METHOD(bool, process, (), (override));
+    MOCK_METHOD(ServerStats, getStats, (), (const, override));
 };
 } // namespace firebolt::rialto::ipc
 
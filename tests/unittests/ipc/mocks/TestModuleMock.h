@@ -44,6 +44,9 @@ public:
     MOCK_METHOD(void, TestRequestSingleVarNoReply,
                 (::google::protobuf::RpcController * controller, const ::firebolt::rialto::TestSingleVarNoReply *request,
                  ::firebolt::rialto::TestNoVar *response, ::google::protobuf::Closure *done));
+    MOCK_METHOD(void, TestRequestShortTimeout,
+                (::google::protobuf::RpcController * controller, const ::firebolt::rialto::TestSingleVar *request,
+                 ::firebolt::rialto::TestNoVar *response, ::google::protobuf::Closure *done));
 
     void defaultReturn(::google::protobuf::RpcController *controller, ::google::protobuf::Closure *done)
     {
@@ -74,6 +74,12 @@ bool ClientStub::connect()
     EXPECT_GE(eventTag, 0);
     m_eventTags.push_back(eventTag);
 
+    eventTag = m_channel->subscribe<firebolt::rialto::TestEventCoalesced>(
+        [this](const std::shared_ptr<firebolt::rialto::TestEventCoalesced> &event)
+        { onTestEventCoalescedReceived(event); });
+    EXPECT_GE(eventTag, 0);
+    m_eventTags.push_back(eventTag);
+
     return true;
 }
 
@@ -89,6 +95,11 @@ void ClientStub::disconnect()
     m_channel->disconnect();
 }
 
+bool ClientStub::enableSharedMemoryTransport()
+{
+    return m_channel->enableSharedMemoryTransport();
+}
+
 bool ClientStub::sendSingleVarRequest(int32_t var1)
 {
     firebolt::rialto::TestSingleVar request;
@@ -138,6 +149,28 @@ bool ClientStub::sendSingleVarRequestWithNoReply(int32_t var1)
     return true;
 }
 
+bool ClientStub::sendShortTimeoutRequest(int32_t var1)
+{
+    firebolt::rialto::TestSingleVar request;
+    firebolt::rialto::TestNoVar response;
+
+    request.set_var1(var1);
+
+    auto controllerFactory = firebolt::rialto::ipc::IControllerFactory::createFactory();
+    auto controller = controllerFactory->create();
+
+    std::atomic_bool done{false};
+    m_testModuleStub->TestRequestShortTimeout(controller.get(), &request, &response,
+                                              google::protobuf::NewCallback(onMessageReceived, &done));
+
+    while (m_channel->process() && !done.load())
+    {
+        m_channel->wait(1);
+    }
+
+    return !controller->Failed();
+}
+
 bool ClientStub::sendMultiVarRequest(int32_t var1, uint32_t var2, firebolt::rialto::TestMultiVar_TestType var3,
                                      std::string var4)
 {
@@ -196,6 +229,36 @@ bool ClientStub::sendRequestWithSingleVarResponse(int32_t &var1)
     return true;
 }
 
+bool ClientStub::sendHaveData(int32_t sessionId, uint32_t numFrames, uint32_t requestId)
+{
+    firebolt::rialto::TestHaveDataRequest request;
+    firebolt::rialto::TestNoVar response;
+
+    request.set_session_id(sessionId);
+    request.set_status(1);
+    request.set_num_frames(numFrames);
+    request.set_request_id(requestId);
+
+    auto controllerFactory = firebolt::rialto::ipc::IControllerFactory::createFactory();
+    auto controller = controllerFactory->create();
+
+    std::atomic_bool done{false};
+    m_testModuleStub->TestHaveData(controller.get(), &request, &response,
+                                   google::protobuf::NewCallback(onMessageReceived, &done));
+
+    while (m_channel->process() && !done.load())
+    {
+        m_channel->wait(1);
+    }
+
+    if (controller->Failed())
+    {
+        return false;
+    }
+
+    return true;
+}
+
 bool ClientStub::sendRequestWithMultiVarResponse(int32_t &var1, uint32_t &var2,
                                                  firebolt::rialto::TestMultiVar_TestType &var3, std::string &var4)
 {
@@ -286,3 +349,8 @@ void ClientStub::onTestEventMultiVarReceived(const std::shared_ptr<firebolt::ria
     m_multiVarEvent = event;
     m_messageReceived.store(true);
 }
+
+void ClientStub::onTestEventCoalescedReceived(const std::shared_ptr<firebolt::rialto::TestEventCoalesced> &event)
+{
+    m_coalescedEvents.emplace_back(event->key(), event->var1());
+}
@@ -28,6 +28,7 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 class ClientStub
@@ -38,11 +39,14 @@ public:
 
     bool connect();
     void disconnect();
+    bool enableSharedMemoryTransport();
 
     bool sendSingleVarRequest(int32_t var1);
     bool sendMultiVarRequest(int32_t var1, uint32_t var2, firebolt::rialto::TestMultiVar_TestType var3, std::string var4);
     bool sendSingleVarRequestWithNoReply(int32_t var1);
+    bool sendShortTimeoutRequest(int32_t var1);
     bool sendRequestWithSingleVarResponse(int32_t &var1);
+    bool sendHaveData(int32_t sessionId, uint32_t numFrames, uint32_t requestId);
     bool sendRequestWithMultiVarResponse(int32_t &var1, uint32_t &var2, firebolt::rialto::TestMultiVar_TestType &var3,
                                          std::string &var4);
 
@@ -50,10 +54,12 @@ public:
     void waitForSingleVarEvent(int32_t &var1);
     void waitForMultiVarEvent(int32_t &var1, uint32_t &var2, firebolt::rialto::TestEventMultiVar_TestType &var3,
                               std::string &var4);
+    std::vector<std::pair<int32_t, int32_t>> getCoalescedEvents() const { return m_coalescedEvents; }
 
 private:
     void onTestEventSingleVarReceived(const std::shared_ptr<firebolt::rialto::TestEventSingleVar> &event);
     void onTestEventMultiVarReceived(const std::shared_ptr<firebolt::rialto::TestEventMultiVar> &event);
+    void onTestEventCoalescedReceived(const std::shared_ptr<firebolt::rialto::TestEventCoalesced> &event);
 
 private:
     std::string m_socketName;
@@ -68,6 +74,7 @@ private:
     std::condition_variable m_startThreadCond;
     std::shared_ptr<firebolt::rialto::TestEventSingleVar> m_singleVarEvent;
     std::shared_ptr<firebolt::rialto::TestEventMultiVar> m_multiVarEvent;
+    std::vector<std::pair<int32_t, int32_t>> m_coalescedEvents;
     std::vector<int> m_eventTags;
 };
 
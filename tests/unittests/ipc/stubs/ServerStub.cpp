@@ -62,12 +62,12 @@ ServerStub::ServerStub()
 
 ServerStub::ServerStub(std::shared_ptr<::firebolt::rialto::TestModule> moduleMock) : m_testMock{moduleMock} {}
 
-void ServerStub::init()
+void ServerStub::init(unsigned numWorkerLoops)
 {
     m_clientConnected = false;
     m_running = true;
     auto factory = ::firebolt::rialto::ipc::IServerFactory::createFactory();
-    m_server = factory->create();
+    m_server = factory->create(numWorkerLoops);
 
     const char *kRialtoPath = getenv("RIALTO_SOCKET_PATH");
     m_server->addSocket(kRialtoPath, std::bind(&ServerStub::clientConnected, this, std::placeholders::_1),
@@ -146,3 +146,25 @@ void ServerStub::sendMultiVarEvent(int32_t var1, uint32_t var2, firebolt::rialto
 
     m_client->sendEvent(event);
 }
+
+void ServerStub::sendCoalescedEvent(int32_t key, int32_t var1)
+{
+    auto event = std::make_shared<firebolt::rialto::TestEventCoalesced>();
+
+    event->set_key(key);
+    event->set_var1(var1);
+
+    if (!m_clientConnected.load())
+    {
+        std::unique_lock<std::mutex> clientConnectedLock(m_clientConnectMutex);
+        std::cv_status status = m_clientConnectCond.wait_for(clientConnectedLock, std::chrono::milliseconds(100));
+        ASSERT_NE(std::cv_status::timeout, status);
+    }
+
+    m_client->sendEvent(event);
+}
+
+::firebolt::rialto::ipc::ServerStats ServerStub::getStats() const
+{
+    return m_server->getStats();
+}
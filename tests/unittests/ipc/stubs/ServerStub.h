@@ -37,7 +37,7 @@ public:
     explicit ServerStub(std::shared_ptr<::firebolt::rialto::TestModule> moduleMock);
     ~ServerStub();
 
-    void init();
+    void init(unsigned numWorkerLoops = 0);
     void initWithFd(int fd);
 
     void clientDisconnected(const std::shared_ptr<::firebolt::rialto::ipc::IClient> &client);
@@ -46,6 +46,9 @@ public:
     void sendSingleVarEvent(int32_t var1);
     void sendMultiVarEvent(int32_t var1, uint32_t var2, firebolt::rialto::TestEventMultiVar_TestType var3,
                            std::string var4);
+    void sendCoalescedEvent(int32_t key, int32_t var1);
+
+    ::firebolt::rialto::ipc::ServerStats getStats() const;
 
 private:
     std::shared_ptr<::firebolt::rialto::ipc::IServer> m_server;
@@ -89,6 +89,23 @@ void IpcModuleBase::expectIpcApiCallFailure()
     EXPECT_CALL(*m_controllerMock, ErrorText()).WillOnce(Return("Failed for some reason...")).RetiresOnSaturation();
 }
 
+void IpcModuleBase::expectAsyncIpcApiCallSuccess()
+{
+    EXPECT_CALL(*m_channelMock, isConnected()).InSequence(m_isConnectedSeq).WillOnce(Return(true)).RetiresOnSaturation();
+
+    EXPECT_CALL(*m_ipcClientMock, createRpcController()).WillOnce(Return(m_controllerMock)).RetiresOnSaturation();
+    EXPECT_CALL(*m_controllerMock, Failed()).WillOnce(Return(false)).RetiresOnSaturation();
+}
+
+void IpcModuleBase::expectAsyncIpcApiCallFailure()
+{
+    EXPECT_CALL(*m_channelMock, isConnected()).InSequence(m_isConnectedSeq).WillOnce(Return(true)).RetiresOnSaturation();
+
+    EXPECT_CALL(*m_ipcClientMock, createRpcController()).WillOnce(Return(m_controllerMock)).RetiresOnSaturation();
+    EXPECT_CALL(*m_controllerMock, Failed()).WillOnce(Return(true)).RetiresOnSaturation();
+    EXPECT_CALL(*m_controllerMock, ErrorText()).WillOnce(Return("Failed for some reason...")).RetiresOnSaturation();
+}
+
 void IpcModuleBase::expectIpcApiCallDisconnected()
 {
     EXPECT_CALL(*m_channelMock, isConnected()).InSequence(m_isConnectedSeq).WillOnce(Return(false)).RetiresOnSaturation();
@@ -67,6 +67,8 @@ protected:
     void expectIpcApiCallReconnected();
     void expectIpcApiCallSuccess();
     void expectIpcApiCallFailure();
+    void expectAsyncIpcApiCallSuccess();
+    void expectAsyncIpcApiCallFailure();
 };
 
 #endif // IPC_MODULE_BASE_H_
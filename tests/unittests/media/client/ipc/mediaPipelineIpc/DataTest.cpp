@@ -19,6 +19,7 @@
 
 #include "MediaPipelineIpcTestBase.h"
 #include "MediaPipelineProtoRequestMatchers.h"
+#include <optional>
 
 MATCHER(IsNull, "")
 {
@@ -157,6 +158,138 @@ TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataFailure)
     EXPECT_EQ(m_mediaPipelineIpc->haveData(MediaSourceStatus::OK, m_numFrames, m_requestId), false);
 }
 
+/**
+ * Test that haveDataAsync returns without waiting and reports success once the call completes.
+ */
+TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataAsyncSuccess)
+{
+    google::protobuf::Closure *done{nullptr};
+    std::optional<bool> result;
+
+    expectAsyncIpcApiCallSuccess();
+
+    EXPECT_CALL(*m_channelMock,
+                CallMethod(methodMatcher("haveData"), m_controllerMock.get(),
+                           haveDataRequestMatcher(m_sessionId, firebolt::rialto::HaveDataRequest_MediaSourceStatus_OK,
+                                                  m_numFrames, m_requestId),
+                           _, _))
+        .WillOnce(Invoke([&](auto, auto, auto, auto, google::protobuf::Closure *closure) { done = closure; }));
+
+    EXPECT_TRUE(m_mediaPipelineIpc->haveDataAsync(MediaSourceStatus::OK, m_numFrames, m_requestId,
+                                                  [&](bool success) { result = success; }));
+    EXPECT_FALSE(result.has_value());
+
+    ASSERT_NE(done, nullptr);
+    done->Run();
+    EXPECT_EQ(result, true);
+}
+
+/**
+ * Test that haveDataAsync reports failure when ipc fails.
+ */
+TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataAsyncFailure)
+{
+    std::optional<bool> result;
+
+    expectAsyncIpcApiCallFailure();
+
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("haveData"), _, _, _, _))
+        .WillOnce(Invoke([&](auto, auto, auto, auto, google::protobuf::Closure *closure) { closure->Run(); }));
+
+    EXPECT_TRUE(m_mediaPipelineIpc->haveDataAsync(MediaSourceStatus::OK, m_numFrames, m_requestId,
+                                                  [&](bool success) { result = success; }));
+    EXPECT_EQ(result, false);
+}
+
+/**
+ * Test that haveDataMulti can be called successfully, and returns the result of each request.
+ */
+TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataMultiSuccess)
+{
+    expectIpcApiCallSuccess();
+
+    const auto kProtoStatus{firebolt::rialto::HaveDataRequest_MediaSourceStatus_EOS};
+    EXPECT_CALL(*m_channelMock,
+                CallMethod(methodMatcher("haveDataMulti"), m_controllerMock.get(),
+                           haveDataMultiRequestMatcher(m_sessionId, kProtoStatus, m_numFrames, m_requestId), _,
+                           m_blockingClosureMock.get()))
+        .WillOnce(Invoke(
+            [&](auto, auto, auto, google::protobuf::Message *response, auto)
+            { dynamic_cast<firebolt::rialto::HaveDataMultiResponse *>(response)->add_succeeded(false); }));
+
+    std::vector<bool> results;
+    EXPECT_EQ(m_mediaPipelineIpc->haveDataMulti({{MediaSourceStatus::EOS, m_numFrames, m_requestId}}, results), true);
+    EXPECT_EQ(results, std::vector<bool>{false});
+}
+
+/**
+ * Test that haveDataMulti fails when ipc fails.
+ */
+TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataMultiFailure)
+{
+    expectIpcApiCallFailure();
+
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("haveDataMulti"), _, _, _, _));
+
+    std::vector<bool> results;
+    EXPECT_EQ(m_mediaPipelineIpc->haveDataMulti({{MediaSourceStatus::OK, m_numFrames, m_requestId}}, results), false);
+}
+
+/**
+ * Test that haveDataMulti fails when the server doesn't return a result for each request.
+ */
+TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataMultiFailureDueToMissingResults)
+{
+    expectIpcApiCallSuccess();
+
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("haveDataMulti"), _, _, _, _));
+
+    std::vector<bool> results;
+    EXPECT_EQ(m_mediaPipelineIpc->haveDataMulti({{MediaSourceStatus::OK, m_numFrames, m_requestId}}, results), false);
+}
+
+/**
+ * Test that haveDataMulti sends each request with haveData to a server that doesn't know haveDataMulti, and doesn't
+ * try haveDataMulti again.
+ */
+TEST_F(RialtoClientMediaPipelineIpcDataTest, HaveDataMultiFallsBackToHaveData)
+{
+    const uint32_t kSecondRequestId{m_requestId + 1};
+
+    // the controller expectations are matched newest first, so the calls are expected in reverse order
+    expectIpcApiCallFailure();
+    EXPECT_CALL(*m_channelMock,
+                CallMethod(methodMatcher("haveData"), _,
+                           haveDataRequestMatcher(m_sessionId, firebolt::rialto::HaveDataRequest_MediaSourceStatus_EOS,
+                                                  0U, kSecondRequestId),
+                           _, _));
+    expectIpcApiCallSuccess();
+    EXPECT_CALL(*m_channelMock,
+                CallMethod(methodMatcher("haveData"), _,
+                           haveDataRequestMatcher(m_sessionId, firebolt::rialto::HaveDataRequest_MediaSourceStatus_OK,
+                                                  m_numFrames, m_requestId),
+                           _, _));
+    EXPECT_CALL(*m_channelMock, isConnected()).InSequence(m_isConnectedSeq).WillOnce(Return(true)).RetiresOnSaturation();
+    EXPECT_CALL(*m_ipcClientMock, createRpcController()).WillOnce(Return(m_controllerMock)).RetiresOnSaturation();
+    EXPECT_CALL(*m_ipcClientMock, createBlockingClosure()).WillOnce(Return(m_blockingClosureMock)).RetiresOnSaturation();
+    EXPECT_CALL(*m_blockingClosureMock, wait()).RetiresOnSaturation();
+    EXPECT_CALL(*m_controllerMock, Failed()).WillOnce(Return(true)).RetiresOnSaturation();
+    EXPECT_CALL(*m_controllerMock, ErrorText()).WillOnce(Return("Unknown method 'haveDataMulti'")).RetiresOnSaturation();
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("haveDataMulti"), _, _, _, _));
+
+    std::vector<bool> results;
+    EXPECT_TRUE(m_mediaPipelineIpc->haveDataMulti({{MediaSourceStatus::OK, m_numFrames, m_requestId},
+                                                   {MediaSourceStatus::EOS, 0U, kSecondRequestId}},
+                                                  results));
+    EXPECT_EQ(results, (std::vector<bool>{true, false}));
+
+    expectIpcApiCallSuccess();
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("haveData"), _, _, _, _));
+
+    EXPECT_TRUE(m_mediaPipelineIpc->haveDataMulti({{MediaSourceStatus::OK, m_numFrames, m_requestId}}, results));
+    EXPECT_EQ(results, std::vector<bool>{true});
+}
+
 /**
  * Test that HaveData fails if the ipc channel disconnected.
  */
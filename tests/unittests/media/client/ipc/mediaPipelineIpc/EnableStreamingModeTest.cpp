@@ -0,0 +1,107 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "MediaPipelineIpcTestBase.h"
+#include "MediaPipelineProtoRequestMatchers.h"
+
+class RialtoClientMediaPipelineIpcEnableStreamingModeTest : public MediaPipelineIpcTestBase
+{
+protected:
+    virtual void SetUp()
+    {
+        MediaPipelineIpcTestBase::SetUp();
+
+        createMediaPipelineIpc();
+    }
+
+    virtual void TearDown()
+    {
+        destroyMediaPipelineIpc();
+
+        MediaPipelineIpcTestBase::TearDown();
+    }
+
+    const int32_t m_kSourceId{1};
+    const int m_kDoorbellFd{23};
+    const uint32_t m_kRingOffset{4096};
+    const uint32_t m_kRingCapacity{8192};
+};
+
+/**
+ * Test that enableStreamingMode can be called successfully and returns the ring.
+ */
+TEST_F(RialtoClientMediaPipelineIpcEnableStreamingModeTest, Success)
+{
+    expectIpcApiCallSuccess();
+
+    EXPECT_CALL(*m_channelMock,
+                CallMethod(methodMatcher("enableStreamingMode"), m_controllerMock.get(),
+                           enableStreamingModeRequestMatcher(m_sessionId, m_kSourceId), _, m_blockingClosureMock.get()))
+        .WillOnce(Invoke(
+            [&](auto, auto, auto, google::protobuf::Message *response, auto)
+            {
+                auto *enableStreamingModeResponse =
+                    dynamic_cast<firebolt::rialto::EnableStreamingModeResponse *>(response);
+                enableStreamingModeResponse->set_doorbell_fd(m_kDoorbellFd);
+                enableStreamingModeResponse->set_ring_offset(m_kRingOffset);
+                enableStreamingModeResponse->set_ring_capacity(m_kRingCapacity);
+            }));
+
+    int doorbellFd{-1};
+    uint32_t ringOffset{0};
+    uint32_t ringCapacity{0};
+    EXPECT_TRUE(m_mediaPipelineIpc->enableStreamingMode(m_kSourceId, doorbellFd, ringOffset, ringCapacity));
+    EXPECT_EQ(doorbellFd, m_kDoorbellFd);
+    EXPECT_EQ(ringOffset, m_kRingOffset);
+    EXPECT_EQ(ringCapacity, m_kRingCapacity);
+}
+
+/**
+ * Test that enableStreamingMode fails if the ipc channel disconnected.
+ */
+TEST_F(RialtoClientMediaPipelineIpcEnableStreamingModeTest, ChannelDisconnected)
+{
+    expectIpcApiCallDisconnected();
+    expectUnsubscribeEvents();
+
+    int doorbellFd{-1};
+    uint32_t ringOffset{0};
+    uint32_t ringCapacity{0};
+    EXPECT_FALSE(m_mediaPipelineIpc->enableStreamingMode(m_kSourceId, doorbellFd, ringOffset, ringCapacity));
+
+    // Reattach channel on destroySession
+    EXPECT_CALL(*m_ipcClientMock, getChannel()).WillOnce(Return(m_channelMock)).RetiresOnSaturation();
+    expectSubscribeEvents();
+}
+
+/**
+ * Test that enableStreamingMode fails when ipc fails.
+ */
+TEST_F(RialtoClientMediaPipelineIpcEnableStreamingModeTest, EnableStreamingModeFailure)
+{
+    expectIpcApiCallFailure();
+
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("enableStreamingMode"), _, _, _, _));
+
+    int doorbellFd{-1};
+    uint32_t ringOffset{0};
+    uint32_t ringCapacity{0};
+    EXPECT_FALSE(m_mediaPipelineIpc->enableStreamingMode(m_kSourceId, doorbellFd, ringOffset, ringCapacity));
+}
@@ -52,6 +52,52 @@ TEST_F(RialtoClientMediaPipelineIpcGetPositionTest, Success)
     EXPECT_TRUE(m_mediaPipelineIpc->getPosition(position));
 }
 
+/**
+ * Test that getPositionAsync passes the position from the response to the callback.
+ */
+TEST_F(RialtoClientMediaPipelineIpcGetPositionTest, AsyncSuccess)
+{
+    constexpr int64_t kPosition{4321};
+    bool result{false};
+    int64_t position{0};
+
+    expectAsyncIpcApiCallSuccess();
+
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("getPosition"), m_controllerMock.get(),
+                                           getPositionRequestMatcher(m_sessionId), _, _))
+        .WillOnce(Invoke(
+            [&](auto, auto, auto, google::protobuf::Message *response, google::protobuf::Closure *closure)
+            {
+                dynamic_cast<firebolt::rialto::GetPositionResponse *>(response)->set_position(kPosition);
+                closure->Run();
+            }));
+
+    EXPECT_TRUE(m_mediaPipelineIpc->getPositionAsync(
+        [&](bool success, int64_t pos)
+        {
+            result = success;
+            position = pos;
+        }));
+    EXPECT_TRUE(result);
+    EXPECT_EQ(position, kPosition);
+}
+
+/**
+ * Test that getPositionAsync reports failure when ipc fails.
+ */
+TEST_F(RialtoClientMediaPipelineIpcGetPositionTest, AsyncFailure)
+{
+    bool result{true};
+
+    expectAsyncIpcApiCallFailure();
+
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("getPosition"), _, _, _, _))
+        .WillOnce(Invoke([&](auto, auto, auto, auto, google::protobuf::Closure *closure) { closure->Run(); }));
+
+    EXPECT_TRUE(m_mediaPipelineIpc->getPositionAsync([&](bool success, int64_t) { result = success; }));
+    EXPECT_FALSE(result);
+}
+
 /**
  * Test that getPosition fails if the ipc channel disconnected.
  */
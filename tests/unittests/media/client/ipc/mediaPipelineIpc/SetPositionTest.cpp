@@ -19,6 +19,7 @@
 
 #include "MediaPipelineIpcTestBase.h"
 #include "MediaPipelineProtoRequestMatchers.h"
+#include <optional>
 
 class RialtoClientMediaPipelineIpcSetPositionTest : public MediaPipelineIpcTestBase
 {
@@ -54,6 +55,38 @@ TEST_F(RialtoClientMediaPipelineIpcSetPositionTest, Success)
     EXPECT_EQ(m_mediaPipelineIpc->setPosition(m_position), true);
 }
 
+/**
+ * Test that setPositionAsync calls the callback with the result once the call completes.
+ */
+TEST_F(RialtoClientMediaPipelineIpcSetPositionTest, AsyncSuccess)
+{
+    std::optional<bool> result;
+
+    expectAsyncIpcApiCallSuccess();
+
+    EXPECT_CALL(*m_channelMock, CallMethod(methodMatcher("setPosition"), m_controllerMock.get(),
+                                           setPositionRequestMatcher(m_sessionId, m_position), _, _))
+        .WillOnce(Invoke([&](auto, auto, auto, auto, google::protobuf::Closure *closure) { closure->Run(); }));
+
+    EXPECT_TRUE(m_mediaPipelineIpc->setPositionAsync(m_position, [&](bool success) { result = success; }));
+    EXPECT_EQ(result, true);
+}
+
+/**
+ * Test that setPositionAsync does not send the request or call the callback if the ipc channel disconnected.
+ */
+TEST_F(RialtoClientMediaPipelineIpcSetPositionTest, AsyncChannelDisconnected)
+{
+    expectIpcApiCallDisconnected();
+    expectUnsubscribeEvents();
+
+    EXPECT_FALSE(m_mediaPipelineIpc->setPositionAsync(m_position, [](bool) { FAIL() << "unexpected callback"; }));
+
+    // Reattach channel on destroySession
+    EXPECT_CALL(*m_ipcClientMock, getChannel()).WillOnce(Return(m_channelMock)).RetiresOnSaturation();
+    expectSubscribeEvents();
+}
+
 /**
  * Test that setPosition fails if the ipc channel disconnected.
  */
@@ -26,12 +26,20 @@
 #include <thread>
 #include <vector>
 
+using ::testing::SizeIs;
+using ::testing::UnorderedElementsAre;
+
 MATCHER_P(ShmInfoMatcher, shmInfo, "")
 {
     return ((arg->maxMetadataBytes == shmInfo->maxMetadataBytes) && (arg->metadataOffset == shmInfo->metadataOffset) &&
             (arg->mediaDataOffset == shmInfo->mediaDataOffset) && (arg->maxMediaBytes == shmInfo->maxMediaBytes));
 }
 
+MATCHER_P3(HaveDataInfoMatcher, status, numFrames, requestId, "")
+{
+    return ((arg.status == status) && (arg.numFrames == numFrames) && (arg.requestId == requestId));
+}
+
 class RialtoClientMediaPipelineDataTest : public MediaPipelineTestBase
 {
 protected:
@@ -375,6 +383,149 @@ TEST_F(RialtoClientMediaPipelineDataTest, HaveDataNoSegments)
     EXPECT_EQ(m_mediaPipeline->haveData(m_status, m_requestId), true);
 }
 
+/**
+ * Test that the have data calls of other sources made while one is being sent are sent together in a haveDataMulti.
+ */
+TEST_F(RialtoClientMediaPipelineDataTest, HaveDataWhileSendingIsBatched)
+{
+    const uint32_t kSecondRequestId{m_requestId + 1};
+    const uint32_t kThirdRequestId{m_requestId + 2};
+    needData(m_sourceId, m_frameCount, m_requestId, m_shmInfo);
+    needData(m_sourceId, m_frameCount, kSecondRequestId, m_shmInfo);
+    needData(m_sourceId, m_frameCount, kThirdRequestId, m_shmInfo);
+
+    std::vector<std::thread> haveDataThreads;
+    EXPECT_CALL(*m_mediaPipelineIpcMock, haveData(m_status, 0, m_requestId))
+        .WillOnce(Invoke(
+            [&](MediaSourceStatus, uint32_t, uint32_t)
+            {
+                for (uint32_t requestId : {kSecondRequestId, kThirdRequestId})
+                {
+                    haveDataThreads.emplace_back([this, requestId]()
+                                                 { EXPECT_TRUE(m_mediaPipeline->haveData(m_status, requestId)); });
+                }
+                // Sleep for 0.1 sec so that the other requests are queued
+                usleep(100000);
+                return true;
+            }));
+    EXPECT_CALL(*m_mediaPipelineIpcMock,
+                haveDataMulti(UnorderedElementsAre(HaveDataInfoMatcher(m_status, 0U, kSecondRequestId),
+                                                   HaveDataInfoMatcher(m_status, 0U, kThirdRequestId)),
+                              _))
+        .WillOnce(DoAll(SetArgReferee<1>(std::vector<bool>{true, true}), Return(true)));
+
+    EXPECT_TRUE(m_mediaPipeline->haveData(m_status, m_requestId));
+    for (std::thread &haveDataThread : haveDataThreads)
+    {
+        haveDataThread.join();
+    }
+}
+
+/**
+ * Test that a failed haveDataMulti fails all the have data calls sent in it.
+ */
+TEST_F(RialtoClientMediaPipelineDataTest, HaveDataBatchFailure)
+{
+    const uint32_t kSecondRequestId{m_requestId + 1};
+    needData(m_sourceId, m_frameCount, m_requestId, m_shmInfo);
+    needData(m_sourceId, m_frameCount, kSecondRequestId, m_shmInfo);
+    needData(m_sourceId, m_frameCount, kSecondRequestId + 1, m_shmInfo);
+
+    std::vector<std::thread> haveDataThreads;
+    EXPECT_CALL(*m_mediaPipelineIpcMock, haveData(m_status, 0, m_requestId))
+        .WillOnce(Invoke(
+            [&](MediaSourceStatus, uint32_t, uint32_t)
+            {
+                for (uint32_t requestId : {kSecondRequestId, kSecondRequestId + 1})
+                {
+                    haveDataThreads.emplace_back([this, requestId]()
+                                                 { EXPECT_FALSE(m_mediaPipeline->haveData(m_status, requestId)); });
+                }
+                // Sleep for 0.1 sec so that the other requests are queued
+                usleep(100000);
+                return true;
+            }));
+    EXPECT_CALL(*m_mediaPipelineIpcMock, haveDataMulti(_, _)).WillOnce(Return(false));
+
+    EXPECT_TRUE(m_mediaPipeline->haveData(m_status, m_requestId));
+    for (std::thread &haveDataThread : haveDataThreads)
+    {
+        haveDataThread.join();
+    }
+}
+
+/**
+ * Test that each have data call sent in a haveDataMulti gets the result of its own request.
+ */
+TEST_F(RialtoClientMediaPipelineDataTest, HaveDataBatchResultOfEachRequest)
+{
+    const uint32_t kSecondRequestId{m_requestId + 1};
+    const uint32_t kThirdRequestId{m_requestId + 2};
+    needData(m_sourceId, m_frameCount, m_requestId, m_shmInfo);
+    needData(m_sourceId, m_frameCount, kSecondRequestId, m_shmInfo);
+    needData(m_sourceId, m_frameCount, kThirdRequestId, m_shmInfo);
+
+    std::vector<std::thread> haveDataThreads;
+    EXPECT_CALL(*m_mediaPipelineIpcMock, haveData(m_status, 0, m_requestId))
+        .WillOnce(Invoke(
+            [&](MediaSourceStatus, uint32_t, uint32_t)
+            {
+                haveDataThreads.emplace_back([this, kSecondRequestId]()
+                                             { EXPECT_FALSE(m_mediaPipeline->haveData(m_status, kSecondRequestId)); });
+                haveDataThreads.emplace_back([this, kThirdRequestId]()
+                                             { EXPECT_TRUE(m_mediaPipeline->haveData(m_status, kThirdRequestId)); });
+                // Sleep for 0.1 sec so that the other requests are queued
+                usleep(100000);
+                return true;
+            }));
+    EXPECT_CALL(*m_mediaPipelineIpcMock, haveDataMulti(SizeIs(2), _))
+        .WillOnce(Invoke(
+            [&](const std::vector<HaveDataInfo> &haveDataInfos, std::vector<bool> &results)
+            {
+                // the requests are queued in the order they arrive, which the threads don't fix
+                for (const HaveDataInfo &kInfo : haveDataInfos)
+                {
+                    results.push_back(kInfo.requestId != kSecondRequestId);
+                }
+                return true;
+            }));
+
+    EXPECT_TRUE(m_mediaPipeline->haveData(m_status, m_requestId));
+    for (std::thread &haveDataThread : haveDataThreads)
+    {
+        haveDataThread.join();
+    }
+}
+
+/**
+ * Test that a non-blocking have data call is forwarded to the ipc with the callback.
+ */
+TEST_F(RialtoClientMediaPipelineDataTest, HaveDataAsyncNoSegments)
+{
+    bool result{false};
+    needDataGeneric();
+
+    EXPECT_CALL(*m_mediaPipelineIpcMock, haveDataAsync(m_status, 0, m_requestId, _))
+        .WillOnce(Invoke(
+            [](MediaSourceStatus, uint32_t, uint32_t, std::function<void(bool)> &&callback)
+            {
+                callback(true);
+                return true;
+            }));
+    EXPECT_TRUE(m_mediaPipeline->haveDataAsync(m_status, m_requestId, [&](bool success) { result = success; }));
+    EXPECT_TRUE(result);
+}
+
+/**
+ * Test that a non-blocking have data call without a paired need data notification completes immediately.
+ */
+TEST_F(RialtoClientMediaPipelineDataTest, HaveDataAsyncNoNeedData)
+{
+    bool result{false};
+    EXPECT_TRUE(m_mediaPipeline->haveDataAsync(m_status, m_requestId, [&](bool success) { result = success; }));
+    EXPECT_TRUE(result);
+}
+
 // /**
 //  * Test that a have data call succeeds when segments are added
 //  */
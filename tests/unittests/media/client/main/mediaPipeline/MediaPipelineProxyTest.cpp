@@ -127,6 +127,16 @@ TEST_F(RialtoClientMediaPipelineProxyTest, TestPassthrough)
 
     /////////////////////////////////////////////
 
+    EXPECT_CALL(*mediaPipelineMock, setPositionAsync(kPosition1, _)).WillOnce(Return(true));
+    EXPECT_TRUE(proxy->setPositionAsync(kPosition1, [](bool) {}));
+
+    /////////////////////////////////////////////
+
+    EXPECT_CALL(*mediaPipelineMock, getPositionAsync(_)).WillOnce(Return(true));
+    EXPECT_TRUE(proxy->getPositionAsync([](bool, int64_t) {}));
+
+    /////////////////////////////////////////////
+
     EXPECT_CALL(*mediaPipelineMock, getPosition(_)).WillOnce(DoAll(SetArgReferee<0>(kPosition2), Return(true)));
     {
         int64_t position;
@@ -198,6 +208,21 @@ TEST_F(RialtoClientMediaPipelineProxyTest, TestPassthrough)
 
     /////////////////////////////////////////////
 
+    EXPECT_CALL(*mediaPipelineMock, haveDataAsync(MediaSourceStatus::OK, kNeedDataRequestId, _)).WillOnce(Return(true));
+    EXPECT_TRUE(proxy->haveDataAsync(MediaSourceStatus::OK, kNeedDataRequestId, [](bool) {}));
+
+    /////////////////////////////////////////////
+
+    EXPECT_CALL(*mediaPipelineMock, enableStreamingMode(kSourceId)).WillOnce(Return(true));
+    EXPECT_TRUE(proxy->enableStreamingMode(kSourceId));
+
+    /////////////////////////////////////////////
+
+    EXPECT_CALL(*mediaPipelineMock, setStreamingEos(kSourceId)).WillOnce(Return(true));
+    EXPECT_TRUE(proxy->setStreamingEos(kSourceId));
+
+    /////////////////////////////////////////////
+
     EXPECT_CALL(*mediaPipelineMock, addSegment(kNeedDataRequestId, _)).WillOnce(Return(AddSegmentStatus::OK));
     EXPECT_EQ(proxy->addSegment(kNeedDataRequestId, kMediaSegment), AddSegmentStatus::OK);
 
@@ -0,0 +1,323 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "MediaPipelineTestBase.h"
+#include "SharedMemoryHandleMock.h"
+#include "ShmRing.h"
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <vector>
+
+using ::testing::ElementsAreArray;
+
+namespace
+{
+constexpr int32_t kSourceId{1};
+constexpr std::uint32_t kRingOffset{64};
+constexpr std::uint32_t kRingCapacity{1024};
+const std::vector<uint8_t> kMetadata{4, 0, 0, 0, 1, 2, 3, 4};
+const std::vector<uint8_t> kData{5, 6, 7};
+} // namespace
+
+class RialtoClientMediaPipelineStreamingModeTest : public MediaPipelineTestBase
+{
+protected:
+    std::vector<uint8_t> m_shm;
+    std::shared_ptr<StrictMock<SharedMemoryHandleMock>> m_sharedMemoryHandleMock;
+    ipc::ShmRing m_ring;
+    int m_doorbellFd{-1};
+
+    virtual void SetUp()
+    {
+        MediaPipelineTestBase::SetUp();
+
+        createMediaPipeline();
+
+        m_shm.resize(kRingOffset + ipc::ShmRing::regionSize(kRingCapacity));
+        ASSERT_TRUE(m_ring.init(m_shm.data() + kRingOffset, kRingCapacity));
+        m_doorbellFd = eventfd(0, EFD_NONBLOCK);
+        ASSERT_GE(m_doorbellFd, 0);
+        m_sharedMemoryHandleMock = std::make_shared<StrictMock<SharedMemoryHandleMock>>();
+        EXPECT_CALL(*m_sharedMemoryHandleMock, getShm()).WillRepeatedly(Return(m_shm.data()));
+
+        attachSource();
+    }
+
+    virtual void TearDown()
+    {
+        destroyMediaPipeline();
+        close(m_doorbellFd);
+
+        MediaPipelineTestBase::TearDown();
+    }
+
+    void attachSource()
+    {
+        std::unique_ptr<IMediaPipeline::MediaSource> mediaSource =
+            std::make_unique<IMediaPipeline::MediaSourceAudio>("audio/mp4");
+        EXPECT_CALL(*m_mediaPipelineIpcMock, attachSource(Ref(mediaSource), _))
+            .WillOnce(DoAll(SetArgReferee<1>(kSourceId), Return(true)));
+        EXPECT_TRUE(m_mediaPipeline->attachSource(mediaSource));
+    }
+
+    void ipcWillEnableStreamingMode(std::uint32_t ringCapacity = kRingCapacity)
+    {
+        EXPECT_CALL(*m_clientControllerMock, getSharedMemoryHandle()).WillOnce(Return(m_sharedMemoryHandleMock));
+        // The pipeline owns the received descriptor
+        EXPECT_CALL(*m_mediaPipelineIpcMock, enableStreamingMode(kSourceId, _, _, _))
+            .WillOnce(DoAll(SetArgReferee<1>(dup(m_doorbellFd)), SetArgReferee<2>(kRingOffset),
+                            SetArgReferee<3>(ringCapacity), Return(true)));
+    }
+
+    void enableStreamingMode()
+    {
+        ipcWillEnableStreamingMode();
+        EXPECT_TRUE(m_mediaPipeline->enableStreamingMode(kSourceId));
+    }
+
+    std::unique_ptr<IMediaPipeline::MediaSegment> createSegment(const std::vector<uint8_t> &data = kData)
+    {
+        auto segment = std::make_unique<IMediaPipeline::MediaSegmentAudio>(kSourceId);
+        segment->setData(data.size(), data.data());
+        return segment;
+    }
+
+    void frameWriterFactoryWillSerializeMetadata()
+    {
+        EXPECT_CALL(*m_mediaFrameWriterFactoryMock, serializeStreamingMetadata(_, _))
+            .WillRepeatedly(DoAll(SetArgReferee<1>(kMetadata), Return(true)));
+    }
+
+    void expectRecord(uint64_t expectedTag, const std::vector<uint8_t> &expectedPayload)
+    {
+        uint64_t tag{0};
+        const uint8_t *data{nullptr};
+        size_t length{0};
+        ASSERT_TRUE(m_ring.peek(&tag, &data, &length));
+        EXPECT_EQ(tag, expectedTag);
+        EXPECT_THAT(std::vector<uint8_t>(data, data + length), ElementsAreArray(expectedPayload));
+        m_ring.consume();
+    }
+
+    bool isDoorbellRung()
+    {
+        eventfd_t value{0};
+        return 0 == eventfd_read(m_doorbellFd, &value);
+    }
+};
+
+/**
+ * Test that a source can be switched to the streaming mode.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, EnableStreamingModeSuccess)
+{
+    enableStreamingMode();
+}
+
+/**
+ * Test that the streaming mode can not be enabled for a source which is not attached.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, EnableStreamingModeUnknownSourceFailure)
+{
+    EXPECT_FALSE(m_mediaPipeline->enableStreamingMode(kSourceId + 1));
+}
+
+/**
+ * Test that the streaming mode can not be enabled when the application is not running.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, EnableStreamingModeNotRunningFailure)
+{
+    m_mediaPipeline->notifyApplicationState(ApplicationState::INACTIVE);
+    EXPECT_FALSE(m_mediaPipeline->enableStreamingMode(kSourceId));
+}
+
+/**
+ * Test that the streaming mode can not be enabled without the shared memory.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, EnableStreamingModeNoShmFailure)
+{
+    EXPECT_CALL(*m_clientControllerMock, getSharedMemoryHandle()).WillOnce(Return(nullptr));
+    EXPECT_FALSE(m_mediaPipeline->enableStreamingMode(kSourceId));
+}
+
+/**
+ * Test that the streaming mode is not enabled if the IPC API fails.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, EnableStreamingModeIpcFailure)
+{
+    EXPECT_CALL(*m_clientControllerMock, getSharedMemoryHandle()).WillOnce(Return(m_sharedMemoryHandleMock));
+    EXPECT_CALL(*m_mediaPipelineIpcMock, enableStreamingMode(kSourceId, _, _, _)).WillOnce(Return(false));
+    EXPECT_FALSE(m_mediaPipeline->enableStreamingMode(kSourceId));
+}
+
+/**
+ * Test that the streaming mode is not enabled if the ring received from the server is invalid.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, EnableStreamingModeInvalidRingFailure)
+{
+    ipcWillEnableStreamingMode(kRingCapacity - 1);
+    EXPECT_FALSE(m_mediaPipeline->enableStreamingMode(kSourceId));
+}
+
+/**
+ * Test that the streaming mode can not be enabled twice for the same source.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, EnableStreamingModeTwiceFailure)
+{
+    enableStreamingMode();
+    EXPECT_FALSE(m_mediaPipeline->enableStreamingMode(kSourceId));
+}
+
+/**
+ * Test that a segment of a source in streaming mode is written to the ring and the waiting server is woken up.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, AddSegmentWritesToRing)
+{
+    enableStreamingMode();
+    frameWriterFactoryWillSerializeMetadata();
+    m_ring.setConsumerWaiting(true);
+
+    EXPECT_EQ(m_mediaPipeline->addSegment(0, createSegment()), AddSegmentStatus::OK);
+
+    std::vector<uint8_t> expectedPayload{kMetadata};
+    expectedPayload.insert(expectedPayload.end(), kData.begin(), kData.end());
+    expectRecord(0, expectedPayload);
+    EXPECT_TRUE(isDoorbellRung());
+}
+
+/**
+ * Test that the doorbell is not rung when the server does not wait for data.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, AddSegmentDoesNotRingDoorbellWhenNotWaiting)
+{
+    enableStreamingMode();
+    frameWriterFactoryWillSerializeMetadata();
+    m_ring.setConsumerWaiting(false);
+
+    EXPECT_EQ(m_mediaPipeline->addSegment(0, createSegment()), AddSegmentStatus::OK);
+    EXPECT_FALSE(isDoorbellRung());
+}
+
+/**
+ * Test that NO_SPACE is returned when the ring is full.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, AddSegmentRingFull)
+{
+    enableStreamingMode();
+    frameWriterFactoryWillSerializeMetadata();
+    const std::vector<uint8_t> kLargeData(m_ring.maxRecordSize() - kMetadata.size(), 1);
+
+    AddSegmentStatus status{AddSegmentStatus::OK};
+    for (int i = 0; i < 8 && AddSegmentStatus::OK == status; ++i)
+    {
+        status = m_mediaPipeline->addSegment(0, createSegment(kLargeData));
+    }
+    EXPECT_EQ(status, AddSegmentStatus::NO_SPACE);
+}
+
+/**
+ * Test that a segment which never fits in the ring is rejected.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, AddSegmentTooLargeFailure)
+{
+    enableStreamingMode();
+    frameWriterFactoryWillSerializeMetadata();
+    const std::vector<uint8_t> kLargeData(m_ring.maxRecordSize(), 1);
+
+    EXPECT_EQ(m_mediaPipeline->addSegment(0, createSegment(kLargeData)), AddSegmentStatus::ERROR);
+    EXPECT_TRUE(m_ring.empty());
+}
+
+/**
+ * Test that a segment is rejected when its metadata can not be serialised.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, AddSegmentSerializationFailure)
+{
+    enableStreamingMode();
+    EXPECT_CALL(*m_mediaFrameWriterFactoryMock, serializeStreamingMetadata(_, _)).WillOnce(Return(false));
+
+    EXPECT_EQ(m_mediaPipeline->addSegment(0, createSegment()), AddSegmentStatus::ERROR);
+    EXPECT_TRUE(m_ring.empty());
+}
+
+/**
+ * Test that the end of stream is written to the ring.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, SetStreamingEosSuccess)
+{
+    enableStreamingMode();
+    m_ring.setConsumerWaiting(true);
+
+    EXPECT_TRUE(m_mediaPipeline->setStreamingEos(kSourceId));
+
+    expectRecord(SHM_RING_END_OF_STREAM_TAG, {});
+    EXPECT_TRUE(isDoorbellRung());
+}
+
+/**
+ * Test that the end of stream can not be set for a source which is not in streaming mode.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, SetStreamingEosNotStreamingFailure)
+{
+    EXPECT_FALSE(m_mediaPipeline->setStreamingEos(kSourceId));
+}
+
+/**
+ * Test that the records written after a flush are tagged with the next generation.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, FlushStartsNextGeneration)
+{
+    bool async{false};
+    enableStreamingMode();
+    frameWriterFactoryWillSerializeMetadata();
+    EXPECT_CALL(*m_mediaPipelineIpcMock, flush(kSourceId, true, _)).WillOnce(Return(true));
+
+    EXPECT_TRUE(m_mediaPipeline->flush(kSourceId, true, async));
+    EXPECT_EQ(m_mediaPipeline->addSegment(0, createSegment()), AddSegmentStatus::OK);
+    EXPECT_TRUE(m_mediaPipeline->setStreamingEos(kSourceId));
+
+    std::vector<uint8_t> expectedPayload{kMetadata};
+    expectedPayload.insert(expectedPayload.end(), kData.begin(), kData.end());
+    expectRecord(1, expectedPayload);
+    expectRecord(SHM_RING_END_OF_STREAM_TAG | 1, {});
+}
+
+/**
+ * Test that the streaming mode ends when the source is removed.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, RemoveSourceDisablesStreamingMode)
+{
+    enableStreamingMode();
+    EXPECT_CALL(*m_mediaPipelineIpcMock, removeSource(kSourceId)).WillOnce(Return(true));
+
+    EXPECT_TRUE(m_mediaPipeline->removeSource(kSourceId));
+    EXPECT_FALSE(m_mediaPipeline->setStreamingEos(kSourceId));
+}
+
+/**
+ * Test that the streaming mode ends when the application is not running anymore.
+ */
+TEST_F(RialtoClientMediaPipelineStreamingModeTest, NotRunningDisablesStreamingMode)
+{
+    enableStreamingMode();
+
+    m_mediaPipeline->notifyApplicationState(ApplicationState::INACTIVE);
+    EXPECT_FALSE(m_mediaPipeline->setStreamingEos(kSourceId));
+}
@@ -44,13 +44,25 @@ public:
     MOCK_METHOD(bool, pause, (), (override));
     MOCK_METHOD(bool, stop, (), (override));
     MOCK_METHOD(bool, haveData, (MediaSourceStatus status, uint32_t numFrames, uint32_t requestId), (override));
+    MOCK_METHOD(bool, haveDataMulti, (const std::vector<HaveDataInfo> &haveDataInfos, std::vector<bool> &results),
+                (override));
     MOCK_METHOD(bool, setPosition, (int64_t position), (override));
     MOCK_METHOD(bool, getPosition, (int64_t & position), (override));
+    MOCK_METHOD(bool, haveDataAsync,
+                (MediaSourceStatus status, uint32_t numFrames, uint32_t requestId,
+                 std::function<void(bool success)> &&callback),
+                (override));
+    MOCK_METHOD(bool, setPositionAsync, (int64_t position, std::function<void(bool success)> &&callback),
+                (override));
+    MOCK_METHOD(bool, getPositionAsync, (std::function<void(bool success, int64_t position)> && callback),
+                (override));
     MOCK_METHOD(bool, setImmediateOutput, (int32_t sourceId, bool immediateOutput), (override));
     MOCK_METHOD(bool, getImmediateOutput, (int32_t sourceId, bool &immediateOutput), (override));
     MOCK_METHOD(bool, setReportDecodeErrors, (int32_t sourceId, bool reportDecodeErrors), (override));
     MOCK_METHOD(bool, getQueuedFrames, (int32_t sourceId, uint32_t &queuedFrames), (override));
     MOCK_METHOD(bool, getStats, (int32_t sourceId, uint64_t &renderedFrames, uint64_t &droppedFrames), (override));
+    MOCK_METHOD(bool, enableStreamingMode,
+                (int32_t sourceId, int &doorbellFd, uint32_t &ringOffset, uint32_t &ringCapacity), (override));
     MOCK_METHOD(bool, setPlaybackRate, (double rate), (override));
     MOCK_METHOD(bool, renderFrame, (), (override));
     MOCK_METHOD(bool, setVolume, (double targetVolume, uint32_t volumeDuration, EaseType easeType), (override));
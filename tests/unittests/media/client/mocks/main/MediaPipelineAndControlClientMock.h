@@ -49,6 +49,8 @@ public:
     MOCK_METHOD(bool, setPosition, (int64_t position), (override));
 
     MOCK_METHOD(bool, getPosition, (int64_t & position), (override));
+    MOCK_METHOD(bool, setPositionAsync, (int64_t position, std::function<void(bool success)> callback), (override));
+    MOCK_METHOD(bool, getPositionAsync, (std::function<void(bool success, int64_t position)> callback), (override));
     MOCK_METHOD(bool, setImmediateOutput, (int32_t sourceId, bool immediateOutput), (override));
     MOCK_METHOD(bool, getImmediateOutput, (int32_t sourceId, bool &immediateOutput), (override));
     MOCK_METHOD(bool, setReportDecodeErrors, (int32_t sourceId, bool reportDecodeErrors), (override));
@@ -58,6 +60,11 @@ public:
     MOCK_METHOD(bool, setVideoWindow, (uint32_t x, uint32_t y, uint32_t width, uint32_t height), (override));
 
     MOCK_METHOD(bool, haveData, (MediaSourceStatus status, uint32_t needDataRequestId), (override));
+    MOCK_METHOD(bool, haveDataAsync,
+                (MediaSourceStatus status, uint32_t needDataRequestId, std::function<void(bool success)> callback),
+                (override));
+    MOCK_METHOD(bool, enableStreamingMode, (int32_t sourceId), (override));
+    MOCK_METHOD(bool, setStreamingEos, (int32_t sourceId), (override));
 
     MOCK_METHOD(AddSegmentStatus, addSegment,
                 (uint32_t needDataRequestId, const std::unique_ptr<MediaSegment> &mediaSegment), (override));
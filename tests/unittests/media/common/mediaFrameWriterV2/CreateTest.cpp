@@ -18,7 +18,9 @@
  */
 
 #include "MediaFrameWriterV2.h"
+#include "ShmCommon.h"
 #include <cstdlib>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <memory>
 
@@ -113,6 +115,45 @@ TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV2Test, Offset)
     EXPECT_EQ(memcmp(zeroedMem, m_shmBuffer + VERSION_SIZE_BYTES + kOffset, kZeroedMemSize), 0);
 }
 
+/**
+ * Test that an MediaFrameWriterV2 does not zero a region for which the server published a generation header and
+ * commits the header instead.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV2Test, CommitRegionHeaderWithoutZeroing)
+{
+    constexpr uint32_t kGeneration{7};
+    constexpr uint32_t kHeaderMetadataBytes{VERSION_SIZE_BYTES + SHM_REGION_HEADER_SIZE_BYTES};
+    constexpr uint8_t kStaleByte{0xAB};
+    uint8_t shmBuffer[kHeaderMetadataBytes + kMaxMediaBytes];
+    memset(shmBuffer, kStaleByte, sizeof(shmBuffer));
+    const ShmRegionHeader kPublishedHeader{SHM_REGION_HEADER_MAGIC, kGeneration, 0, 0, 0};
+    memcpy(shmBuffer + SHM_REGION_HEADER_OFFSET, &kPublishedHeader, sizeof(kPublishedHeader));
+    m_shmInfo->maxMetadataBytes = kHeaderMetadataBytes;
+    m_shmInfo->mediaDataOffset = kHeaderMetadataBytes;
+
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(shmBuffer, m_shmInfo);
+    EXPECT_NE(mediaFrameWriter, nullptr);
+
+    // Version should be set to 2
+    EXPECT_EQ(readLEUint32(shmBuffer), 2U);
+
+    // Header should be committed for the published generation
+    ShmRegionHeader header{};
+    memcpy(&header, shmBuffer + SHM_REGION_HEADER_OFFSET, sizeof(header));
+    EXPECT_EQ(header.magic, SHM_REGION_HEADER_MAGIC);
+    EXPECT_EQ(header.generation, kGeneration);
+    EXPECT_EQ(header.committedGeneration, kGeneration);
+    EXPECT_EQ(header.validLength, 0U);
+    EXPECT_EQ(header.numFrames, 0U);
+
+    // Media data should not be touched
+    for (uint32_t i = 0; i < kMaxMediaBytes; ++i)
+    {
+        EXPECT_EQ(shmBuffer[kHeaderMetadataBytes + i], kStaleByte);
+    }
+}
+
 /**
  * Test that an MediaFrameWriterV2 is created, when wrong version of metadata is set in env variable
  */
@@ -144,3 +185,18 @@ TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV2Test, CreateMediaFrameWriterWhe
     EXPECT_NO_THROW(dynamic_cast<MediaFrameWriterV2 &>(*mediaFrameWriter));
     unsetenv("RIALTO_METADATA_VERSION");
 }
+
+/**
+ * Test that the factory serialises the V2 metadata of a frame for the ring of a source in streaming mode.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV2Test, SerializeStreamingMetadata)
+{
+    uint8_t data[kMaxMediaBytes] = {1, 2, 3, 4};
+    std::unique_ptr<IMediaPipeline::MediaSegment> segment = std::make_unique<IMediaPipeline::MediaSegmentAudio>();
+    segment->setData(kMaxMediaBytes, data);
+    std::vector<uint8_t> metadata;
+
+    EXPECT_TRUE(m_mediaFrameWriterFactory->serializeStreamingMetadata(segment, metadata));
+    ASSERT_GT(metadata.size(), sizeof(uint32_t));
+    EXPECT_EQ(readLEUint32(metadata.data()), metadata.size() - sizeof(uint32_t));
+}
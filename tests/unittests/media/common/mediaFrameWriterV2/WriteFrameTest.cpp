@@ -19,7 +19,9 @@
 
 #include "MediaFrameWriterV2.h"
 #include "MetadataProtoMatchers.h"
+#include "ShmCommon.h"
 #include "metadata.pb.h"
+#include <cstring>
 #include <gtest/gtest.h>
 #include <memory>
 
@@ -337,3 +339,61 @@ TEST_F(RialtoPlayerCommonWriteFrameV2Test, SkipWritingDueToUnknownDataType)
     EXPECT_EQ(AddSegmentStatus::ERROR, mediaFrameWriter.writeFrame(segment));
     EXPECT_EQ(0, mediaFrameWriter.getNumFrames());
 }
+
+/**
+ * Test that an MediaFrameWriterV2 commits the number of frames and valid length to a published region header
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV2Test, CommitRegionHeaderAfterEachFrame)
+{
+    constexpr uint32_t kGeneration{3};
+    constexpr uint32_t kHeaderMetadataBytes{VERSION_SIZE_BYTES + SHM_REGION_HEADER_SIZE_BYTES};
+    const ShmRegionHeader kPublishedHeader{SHM_REGION_HEADER_MAGIC, kGeneration, 0, 0, 0};
+    memcpy(m_shmBuffer + SHM_REGION_HEADER_OFFSET, &kPublishedHeader, sizeof(kPublishedHeader));
+    m_shmInfo->maxMetadataBytes = kHeaderMetadataBytes;
+    m_shmInfo->mediaDataOffset = kHeaderMetadataBytes;
+    m_shmInfo->maxMediaBytes = kMaxBytes - kHeaderMetadataBytes;
+
+    auto segment = createVideoSegment();
+    MediaFrameWriterV2 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+
+    ShmRegionHeader header{};
+    memcpy(&header, m_shmBuffer + SHM_REGION_HEADER_OFFSET, sizeof(header));
+    EXPECT_EQ(header.generation, kGeneration);
+    EXPECT_EQ(header.committedGeneration, kGeneration);
+    EXPECT_EQ(header.numFrames, 2U);
+
+    const uint32_t kFirstMetadataSize{readLEUint32(m_shmBuffer + kHeaderMetadataBytes)};
+    EXPECT_EQ(header.validLength, 2 * (sizeof(uint32_t) + kFirstMetadataSize + kMediaDataLength));
+}
+
+/**
+ * Test that an MediaFrameWriterV2 serialises the metadata of a frame in the layout of a V2 frame
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV2Test, SerializeMetadata)
+{
+    auto segment = createAudioSegment();
+    addEncryptionData(segment);
+    std::vector<uint8_t> serialized;
+    ASSERT_TRUE(MediaFrameWriterV2::serializeMetadata(segment, serialized));
+
+    ASSERT_GE(serialized.size(), sizeof(uint32_t));
+    const uint32_t kMetadataSize{readLEUint32(serialized.data())};
+    EXPECT_EQ(serialized.size(), sizeof(uint32_t) + kMetadataSize);
+    MediaSegmentMetadata metadata;
+    ASSERT_TRUE(metadata.ParseFromArray(serialized.data() + sizeof(uint32_t), kMetadataSize));
+    checkMandatoryMetadata(metadata);
+    checkAudioMetadata(metadata);
+    checkEncryptionMetadataPresent(metadata);
+}
+
+/**
+ * Test that an MediaFrameWriterV2 fails to serialise the metadata of a MediaSegment with unknown media type
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV2Test, FailToSerializeMetadataOfUnknownDataType)
+{
+    auto segment = std::make_unique<IMediaPipeline::MediaSegment>();
+    std::vector<uint8_t> serialized;
+    EXPECT_FALSE(MediaFrameWriterV2::serializeMetadata(segment, serialized));
+}
@@ -0,0 +1,174 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MediaFrameWriterV2.h"
+#include "MediaFrameWriterV3.h"
+#include "ShmCommon.h"
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace firebolt::rialto;
+using namespace firebolt::rialto::common;
+
+namespace
+{
+constexpr uint32_t kMaxMetadataBytes{VERSION_SIZE_BYTES + SHM_REGION_HEADER_SIZE_BYTES};
+constexpr uint32_t kMaxMediaBytes{8};
+constexpr uint32_t kGeneration{5};
+constexpr uint8_t kStaleByte{0xAB};
+} // namespace
+
+class RialtoPlayerCommonCreateMediaFrameWriterV3Test : public ::testing::Test
+{
+protected:
+    std::shared_ptr<IMediaFrameWriterFactory> m_mediaFrameWriterFactory;
+
+    uint8_t m_shmBuffer[kMaxMetadataBytes + kMaxMediaBytes] = {0};
+    std::shared_ptr<MediaPlayerShmInfo> m_shmInfo;
+
+    virtual void SetUp()
+    {
+        m_mediaFrameWriterFactory = IMediaFrameWriterFactory::getFactory();
+
+        // init shm info
+        m_shmInfo = std::make_shared<MediaPlayerShmInfo>();
+        m_shmInfo->maxMetadataBytes = kMaxMetadataBytes;
+        m_shmInfo->metadataOffset = 0;
+        m_shmInfo->mediaDataOffset = kMaxMetadataBytes;
+        m_shmInfo->maxMediaBytes = kMaxMediaBytes;
+
+        memset(m_shmBuffer, kStaleByte, sizeof(m_shmBuffer));
+    }
+
+    virtual void TearDown() { m_mediaFrameWriterFactory.reset(); }
+
+    void publishRegionHeader(uint32_t metadataVersion)
+    {
+        const ShmRegionHeader kPublishedHeader{SHM_REGION_HEADER_MAGIC, kGeneration, 0, 0, 0, metadataVersion};
+        memcpy(m_shmBuffer + SHM_REGION_HEADER_OFFSET, &kPublishedHeader, sizeof(kPublishedHeader));
+    }
+
+    uint32_t readLEUint32(const uint8_t *buffer)
+    {
+        uint32_t value = buffer[3] << 24 | buffer[2] << 16 | buffer[1] << 8 | buffer[0];
+        return value;
+    }
+};
+
+/**
+ * Test that an MediaFrameWriterV3 is created, when the server advertises metadata V3.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CreateMediaFrameWriter)
+{
+    publishRegionHeader(SHM_REGION_METADATA_VERSION_TAG | 3);
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+
+    EXPECT_NE(mediaFrameWriter, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<MediaFrameWriterV3 &>(*mediaFrameWriter));
+}
+
+/**
+ * Test that an MediaFrameWriterV3 writes the version and commits the header without zeroing the media data.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CommitRegionHeaderWithoutZeroing)
+{
+    publishRegionHeader(SHM_REGION_METADATA_VERSION_TAG | 3);
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+    EXPECT_NE(mediaFrameWriter, nullptr);
+
+    // Version should be set to 3
+    EXPECT_EQ(readLEUint32(m_shmBuffer), 3U);
+
+    // Header should be committed for the published generation
+    ShmRegionHeader header{};
+    memcpy(&header, m_shmBuffer + SHM_REGION_HEADER_OFFSET, sizeof(header));
+    EXPECT_EQ(header.generation, kGeneration);
+    EXPECT_EQ(header.committedGeneration, kGeneration);
+    EXPECT_EQ(header.validLength, 0U);
+    EXPECT_EQ(header.numFrames, 0U);
+
+    // Media data should not be touched
+    for (uint32_t i = 0; i < kMaxMediaBytes; ++i)
+    {
+        EXPECT_EQ(m_shmBuffer[kMaxMetadataBytes + i], kStaleByte);
+    }
+}
+
+/**
+ * Test that an MediaFrameWriterV3 writes the version and zeroes the memory, when there is no region header.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CheckSharedBufferDataWithoutRegionHeader)
+{
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+
+    // Version should be set to 3
+    EXPECT_EQ(readLEUint32(m_shmBuffer), 3U);
+
+    // Rest of the data should be zeroed
+    constexpr size_t kZeroedMemSize{kMaxMetadataBytes + kMaxMediaBytes - VERSION_SIZE_BYTES};
+    const uint8_t zeroedMem[kZeroedMemSize] = {0};
+    EXPECT_EQ(memcmp(zeroedMem, m_shmBuffer + VERSION_SIZE_BYTES, kZeroedMemSize), 0);
+}
+
+/**
+ * Test that an MediaFrameWriterV2 is created, when the server advertises metadata V2.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CreateMediaFrameWriterV2WhenServerAdvertisesV2)
+{
+    publishRegionHeader(SHM_REGION_METADATA_VERSION_TAG | 2);
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+
+    EXPECT_NE(mediaFrameWriter, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<MediaFrameWriterV2 &>(*mediaFrameWriter));
+}
+
+/**
+ * Test that an MediaFrameWriterV2 is created, when the server does not advertise its metadata version.
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CreateMediaFrameWriterV2WhenServerDoesNotAdvertiseVersion)
+{
+    publishRegionHeader(0xABAB0003U);
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+
+    EXPECT_NE(mediaFrameWriter, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<MediaFrameWriterV2 &>(*mediaFrameWriter));
+}
+
+/**
+ * Test that an MediaFrameWriterV2 is created, when V2 is set in env variable even if the server supports V3
+ */
+TEST_F(RialtoPlayerCommonCreateMediaFrameWriterV3Test, CreateMediaFrameWriterV2WhenEnvVariableVersionIs2)
+{
+    m_mediaFrameWriterFactory.reset();
+    setenv("RIALTO_METADATA_VERSION", "2", 1);
+    m_mediaFrameWriterFactory = IMediaFrameWriterFactory::getFactory();
+    publishRegionHeader(SHM_REGION_METADATA_VERSION_TAG | 3);
+    std::unique_ptr<IMediaFrameWriter> mediaFrameWriter =
+        m_mediaFrameWriterFactory->createFrameWriter(m_shmBuffer, m_shmInfo);
+
+    EXPECT_NE(mediaFrameWriter, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<MediaFrameWriterV2 &>(*mediaFrameWriter));
+    unsetenv("RIALTO_METADATA_VERSION");
+}
@@ -0,0 +1,295 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MediaFrameWriterV3.h"
+#include "ShmCommon.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace firebolt::rialto;
+using namespace firebolt::rialto::common;
+
+namespace
+{
+constexpr uint32_t kMaxMetaBytes{VERSION_SIZE_BYTES + SHM_REGION_HEADER_SIZE_BYTES};
+constexpr uint32_t kMaxBytes{512};
+constexpr uint8_t kMediaData[]{0xD, 0xE, 0xA, 0xD, 0xB, 0xE, 0xE, 0xF, 0x1};
+constexpr uint32_t kMediaDataLength{9};
+constexpr uint32_t kPaddedMediaDataLength{16};
+constexpr int32_t kSourceId{1};
+constexpr int64_t kTimeStamp{1423435};
+constexpr int64_t kDuration{12324};
+constexpr int32_t kSampleRate{3536};
+constexpr int32_t kNumberOfChannels{3};
+constexpr uint64_t kClippingStart{1024};
+constexpr uint64_t kClippingEnd{2048};
+constexpr int32_t kWidth{1024};
+constexpr int32_t kHeight{768};
+constexpr Fraction kFrameRate{15, 1};
+const std::vector<uint8_t> kExtraData{1, 2, 3, 4};
+const std::vector<uint8_t> kCodecDataVector{4, 3, 2, 1};
+const int32_t kMksId{43};
+const std::vector<uint8_t> kKeyId{9, 2, 6, 2, 0, 1};
+const std::vector<uint8_t> kInitVector{34, 53, 54, 62, 56};
+constexpr size_t kNumClearBytes{2};
+constexpr size_t kNumEncryptedBytes{7};
+constexpr uint32_t kInitWithLast15{1};
+constexpr uint32_t kCrypt{1};
+constexpr uint32_t kSkip{9};
+constexpr uint64_t kDisplayOffset{35};
+constexpr uint32_t kGeneration{3};
+
+uint32_t readLEUint32(const uint8_t *buffer)
+{
+    uint32_t value = buffer[3] << 24 | buffer[2] << 16 | buffer[1] << 8 | buffer[0];
+    return value;
+}
+
+std::unique_ptr<IMediaPipeline::MediaSegment> createAudioSegment()
+{
+    auto segment{std::make_unique<IMediaPipeline::MediaSegmentAudio>(kSourceId, kTimeStamp, kDuration, kSampleRate,
+                                                                     kNumberOfChannels, kClippingStart, kClippingEnd)};
+    segment->setData(kMediaDataLength, kMediaData);
+    return segment;
+}
+
+std::unique_ptr<IMediaPipeline::MediaSegment> createVideoSegment()
+{
+    auto segment{std::make_unique<IMediaPipeline::MediaSegmentVideo>(kSourceId, kTimeStamp, kDuration, kWidth, kHeight,
+                                                                     kFrameRate)};
+    segment->setData(kMediaDataLength, kMediaData);
+    return segment;
+}
+
+void addOptionalData(std::unique_ptr<IMediaPipeline::MediaSegment> &segment)
+{
+    segment->setSegmentAlignment(SegmentAlignment::NAL);
+    segment->setExtraData(kExtraData);
+    segment->setCodecData(std::make_shared<CodecData>(CodecData{kCodecDataVector, CodecDataType::STRING}));
+    segment->setDisplayOffset(kDisplayOffset);
+}
+
+void addEncryptionData(std::unique_ptr<IMediaPipeline::MediaSegment> &segment)
+{
+    segment->setEncrypted(true);
+    segment->setMediaKeySessionId(kMksId);
+    segment->setKeyId(kKeyId);
+    segment->setInitVector(kInitVector);
+    segment->addSubSample(kNumClearBytes, kNumEncryptedBytes);
+    segment->setInitWithLast15(kInitWithLast15);
+    segment->setCipherMode(CipherMode::CBCS);
+    segment->setEncryptionPattern(kCrypt, kSkip);
+}
+
+void checkMandatoryHeader(const MediaFrameHeaderV3 &header)
+{
+    EXPECT_EQ(header.headerSize, MEDIA_FRAME_V3_HEADER_SIZE_BYTES);
+    EXPECT_EQ(header.dataLength, kMediaDataLength);
+    EXPECT_EQ(header.timePosition, kTimeStamp);
+    EXPECT_EQ(header.sampleDuration, kDuration);
+    EXPECT_EQ(header.streamId, kSourceId);
+}
+
+void checkAudioHeader(const MediaFrameHeaderV3 &header)
+{
+    EXPECT_EQ(header.sourceType, static_cast<uint8_t>(MediaSourceType::AUDIO));
+    EXPECT_EQ(header.sampleRate, kSampleRate);
+    EXPECT_EQ(header.channelsNum, kNumberOfChannels);
+    EXPECT_EQ(header.clippingStart, kClippingStart);
+    EXPECT_EQ(header.clippingEnd, kClippingEnd);
+    EXPECT_EQ(header.width, 0);
+    EXPECT_EQ(header.height, 0);
+}
+
+void checkVideoHeader(const MediaFrameHeaderV3 &header)
+{
+    EXPECT_EQ(header.sourceType, static_cast<uint8_t>(MediaSourceType::VIDEO));
+    EXPECT_EQ(header.sampleRate, 0);
+    EXPECT_EQ(header.channelsNum, 0);
+    EXPECT_EQ(header.width, kWidth);
+    EXPECT_EQ(header.height, kHeight);
+    EXPECT_EQ(header.frameRateNumerator, kFrameRate.numerator);
+    EXPECT_EQ(header.frameRateDenominator, kFrameRate.denominator);
+}
+} // namespace
+
+class RialtoPlayerCommonWriteFrameV3Test : public ::testing::Test
+{
+protected:
+    uint8_t m_shmBuffer[kMaxMetaBytes + kMaxBytes] = {0};
+    std::shared_ptr<MediaPlayerShmInfo> m_shmInfo;
+
+    virtual void SetUp()
+    {
+        // init shm info
+        m_shmInfo = std::make_shared<MediaPlayerShmInfo>();
+        m_shmInfo->maxMetadataBytes = kMaxMetaBytes;
+        m_shmInfo->metadataOffset = 0;
+        m_shmInfo->mediaDataOffset = kMaxMetaBytes;
+        m_shmInfo->maxMediaBytes = kMaxBytes;
+    }
+
+    MediaFrameHeaderV3 readHeader(uint32_t frameOffset = 0)
+    {
+        // Version should be set to 3
+        EXPECT_EQ(readLEUint32(m_shmBuffer), 3U);
+
+        MediaFrameHeaderV3 header;
+        memcpy(&header, m_shmBuffer + kMaxMetaBytes + frameOffset, sizeof(header));
+        checkMandatoryHeader(header);
+        return header;
+    }
+
+    const uint8_t *getTail(uint32_t frameOffset = 0)
+    {
+        return m_shmBuffer + kMaxMetaBytes + frameOffset + MEDIA_FRAME_V3_HEADER_SIZE_BYTES;
+    }
+
+    void checkMediaData(const MediaFrameHeaderV3 &header, uint32_t paddedTailLength)
+    {
+        EXPECT_EQ((header.tailLength + MEDIA_FRAME_V3_ALIGNMENT - 1) & ~(MEDIA_FRAME_V3_ALIGNMENT - 1),
+                  paddedTailLength);
+        const uint8_t *readPosition{getTail() + paddedTailLength};
+        EXPECT_EQ(memcmp(readPosition, kMediaData, kMediaDataLength), 0);
+    }
+};
+
+/**
+ * Test that an MediaFrameWriterV3 can write unencrypted audio without optional params
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteUnencryptedAudioWithoutOptionalParams)
+{
+    auto segment = createAudioSegment();
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(1, mediaFrameWriter.getNumFrames());
+    auto header = readHeader();
+    checkAudioHeader(header);
+    EXPECT_EQ(header.flags, 0U);
+    EXPECT_EQ(header.tailLength, 0U);
+    checkMediaData(header, 0);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 can write unencrypted video with optional params in the tail
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteUnencryptedVideoWithOptionalParams)
+{
+    auto segment = createVideoSegment();
+    addOptionalData(segment);
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(1, mediaFrameWriter.getNumFrames());
+    auto header = readHeader();
+    checkVideoHeader(header);
+    EXPECT_EQ(header.flags, MEDIA_FRAME_V3_FLAG_HAS_DISPLAY_OFFSET | MEDIA_FRAME_V3_FLAG_HAS_CODEC_DATA);
+    EXPECT_EQ(header.displayOffset, kDisplayOffset);
+    EXPECT_EQ(header.segmentAlignment, static_cast<uint8_t>(SegmentAlignment::NAL));
+    EXPECT_EQ(header.codecDataType, static_cast<uint8_t>(CodecDataType::STRING));
+    EXPECT_EQ(header.extraDataLength, kExtraData.size());
+    EXPECT_EQ(header.codecDataLength, kCodecDataVector.size());
+    EXPECT_EQ(header.tailLength, kExtraData.size() + kCodecDataVector.size());
+
+    const uint8_t *tail{getTail()};
+    EXPECT_EQ(std::vector<uint8_t>(tail, tail + kExtraData.size()), kExtraData);
+    tail += kExtraData.size();
+    EXPECT_EQ(std::vector<uint8_t>(tail, tail + kCodecDataVector.size()), kCodecDataVector);
+    checkMediaData(header, 8);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 can write encrypted audio with subsamples, key id and iv in the tail
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, WriteEncryptedAudio)
+{
+    auto segment = createAudioSegment();
+    addEncryptionData(segment);
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(1, mediaFrameWriter.getNumFrames());
+    auto header = readHeader();
+    checkAudioHeader(header);
+    EXPECT_EQ(header.flags, MEDIA_FRAME_V3_FLAG_ENCRYPTED | MEDIA_FRAME_V3_FLAG_HAS_ENCRYPTION_PATTERN);
+    EXPECT_EQ(header.mediaKeySessionId, kMksId);
+    EXPECT_EQ(header.initWithLast15, kInitWithLast15);
+    EXPECT_EQ(header.cipherMode, static_cast<uint8_t>(CipherMode::CBCS));
+    EXPECT_EQ(header.crypt, kCrypt);
+    EXPECT_EQ(header.skip, kSkip);
+    EXPECT_EQ(header.numSubSamples, 1U);
+    EXPECT_EQ(header.keyIdLength, kKeyId.size());
+    EXPECT_EQ(header.initVectorLength, kInitVector.size());
+    EXPECT_EQ(header.tailLength, MEDIA_FRAME_V3_SUBSAMPLE_SIZE_BYTES + kKeyId.size() + kInitVector.size());
+
+    const uint8_t *tail{getTail()};
+    EXPECT_EQ(readLEUint32(tail), kNumClearBytes);
+    EXPECT_EQ(readLEUint32(tail + sizeof(uint32_t)), kNumEncryptedBytes);
+    tail += MEDIA_FRAME_V3_SUBSAMPLE_SIZE_BYTES;
+    EXPECT_EQ(std::vector<uint8_t>(tail, tail + kKeyId.size()), kKeyId);
+    tail += kKeyId.size();
+    EXPECT_EQ(std::vector<uint8_t>(tail, tail + kInitVector.size()), kInitVector);
+    checkMediaData(header, 24);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 keeps every frame aligned and commits the padded length to the region header
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, CommitAlignedFramesToRegionHeader)
+{
+    const ShmRegionHeader kPublishedHeader{SHM_REGION_HEADER_MAGIC, kGeneration, 0, 0, 0, 0};
+    memcpy(m_shmBuffer + SHM_REGION_HEADER_OFFSET, &kPublishedHeader, sizeof(kPublishedHeader));
+
+    auto segment = createVideoSegment();
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(AddSegmentStatus::OK, mediaFrameWriter.writeFrame(segment));
+
+    constexpr uint32_t kFrameSize{MEDIA_FRAME_V3_HEADER_SIZE_BYTES + kPaddedMediaDataLength};
+    checkVideoHeader(readHeader(kFrameSize));
+
+    ShmRegionHeader header{};
+    memcpy(&header, m_shmBuffer + SHM_REGION_HEADER_OFFSET, sizeof(header));
+    EXPECT_EQ(header.committedGeneration, kGeneration);
+    EXPECT_EQ(header.numFrames, 2U);
+    EXPECT_EQ(header.validLength, 2 * kFrameSize);
+}
+
+/**
+ * Test that an MediaFrameWriterV3 will return NO_SPACE when the padded frame does not fit
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, SkipWritingDueToNoSpaceAvailable)
+{
+    m_shmInfo->maxMediaBytes = MEDIA_FRAME_V3_HEADER_SIZE_BYTES + kMediaDataLength;
+    auto segment = createVideoSegment();
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::NO_SPACE, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(0, mediaFrameWriter.getNumFrames());
+}
+
+/**
+ * Test that an MediaFrameWriterV3 will return ERROR when MediaSegment has unknown media type
+ */
+TEST_F(RialtoPlayerCommonWriteFrameV3Test, SkipWritingDueToUnknownDataType)
+{
+    auto segment = std::make_unique<IMediaPipeline::MediaSegment>();
+    MediaFrameWriterV3 mediaFrameWriter{m_shmBuffer, m_shmInfo};
+    EXPECT_EQ(AddSegmentStatus::ERROR, mediaFrameWriter.writeFrame(segment));
+    EXPECT_EQ(0, mediaFrameWriter.getNumFrames());
+}
@@ -34,6 +34,9 @@ public:
 
     MOCK_METHOD(std::unique_ptr<IMediaFrameWriter>, createFrameWriter,
                 (uint8_t * shmBuffer, const std::shared_ptr<MediaPlayerShmInfo> &shmInfo), (override));
+    MOCK_METHOD(bool, serializeStreamingMetadata,
+                (const std::unique_ptr<IMediaPipeline::MediaSegment> &data, std::vector<uint8_t> &metadata),
+                (override));
 };
 } // namespace firebolt::rialto::common
 
@@ -22,14 +22,17 @@
 #include "Matchers.h"
 #include "MediaSourceUtil.h"
 #include "PlayerTaskMock.h"
+#include "ShmBlockTrackerMock.h"
 #include "TimerMock.h"
 
 #include <gst/audio/audio.h>
 
 using testing::_;
 using testing::ByMove;
+using testing::DoAll;
 using testing::Invoke;
 using testing::Return;
+using testing::SaveArg;
 using testing::StrEq;
 
 using ::firebolt::rialto::server::testcommon::expectPropertyDoesntExist;
@@ -848,11 +851,47 @@ TEST_F(GstGenericPlayerPrivateTest, shouldCreateClearGstBuffer)
     EXPECT_CALL(*m_gstWrapperMock, gstBufferNewAllocate(nullptr, mediaSegment.getDataLength(), nullptr))
         .WillOnce(Return(&buffer));
     EXPECT_CALL(*m_gstWrapperMock, gstBufferFill(&buffer, 0, mediaSegment.getData(), mediaSegment.getDataLength()));
-    m_sut->createBuffer(mediaSegment);
+    m_sut->createBuffer(makeMediaSegmentView(mediaSegment), nullptr);
     EXPECT_EQ(GST_BUFFER_TIMESTAMP(&buffer), kTimeStamp);
     EXPECT_EQ(GST_BUFFER_DURATION(&buffer), kDuration);
 }
 
+TEST_F(GstGenericPlayerPrivateTest, shouldCreateGstBufferWrappingShmData)
+{
+    GstBuffer buffer{};
+    std::uint8_t shmData[8]{};
+    gpointer userData{nullptr};
+    GDestroyNotify notify{nullptr};
+    auto shmBlockTrackerMock{std::make_shared<StrictMock<ShmBlockTrackerMock>>()};
+    IMediaPipeline::MediaSegmentVideo mediaSegment{kSourceId, kTimeStamp, kDuration, kWidth, kHeight, kFrameRate};
+    mediaSegment.setData(sizeof(shmData), shmData);
+    EXPECT_CALL(*shmBlockTrackerMock, lend(shmData, sizeof(shmData))).WillOnce(Return(true));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewWrappedFull(GST_MEMORY_FLAG_READONLY, shmData, sizeof(shmData), 0,
+                                                           sizeof(shmData), _, _))
+        .WillOnce(DoAll(SaveArg<5>(&userData), SaveArg<6>(&notify), Return(&buffer)));
+    m_sut->createBuffer(makeMediaSegmentView(mediaSegment), shmBlockTrackerMock);
+    EXPECT_EQ(GST_BUFFER_TIMESTAMP(&buffer), kTimeStamp);
+    EXPECT_EQ(GST_BUFFER_DURATION(&buffer), kDuration);
+
+    ASSERT_NE(notify, nullptr);
+    EXPECT_CALL(*shmBlockTrackerMock, release(shmData));
+    notify(userData);
+}
+
+TEST_F(GstGenericPlayerPrivateTest, shouldCopyShmDataWhenBlockCannotBeLent)
+{
+    GstBuffer buffer{};
+    std::uint8_t shmData[8]{};
+    auto shmBlockTrackerMock{std::make_shared<StrictMock<ShmBlockTrackerMock>>()};
+    IMediaPipeline::MediaSegmentVideo mediaSegment{kSourceId, kTimeStamp, kDuration, kWidth, kHeight, kFrameRate};
+    mediaSegment.setData(sizeof(shmData), shmData);
+    EXPECT_CALL(*shmBlockTrackerMock, lend(shmData, sizeof(shmData))).WillOnce(Return(false));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewAllocate(nullptr, sizeof(shmData), nullptr)).WillOnce(Return(&buffer));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferFill(&buffer, 0, shmData, sizeof(shmData)));
+    m_sut->createBuffer(makeMediaSegmentView(mediaSegment), shmBlockTrackerMock);
+    EXPECT_EQ(GST_BUFFER_TIMESTAMP(&buffer), kTimeStamp);
+}
+
 TEST_F(GstGenericPlayerPrivateTest, shouldCreateCENSEncryptedGstBuffer)
 {
     GstBuffer buffer{}, initVectorBuffer{}, keyIdBuffer{}, subSamplesBuffer{};
@@ -896,7 +935,7 @@ TEST_F(GstGenericPlayerPrivateTest, shouldCreateCENSEncryptedGstBuffer)
                                     &m_decryptionServiceMock};
     EXPECT_CALL(*m_gstProtectionMetadataWrapperMock, addProtectionMetadata(&buffer, data)).WillOnce(Return(&meta));
 
-    m_sut->createBuffer(mediaSegment);
+    m_sut->createBuffer(makeMediaSegmentView(mediaSegment), nullptr);
     EXPECT_EQ(GST_BUFFER_TIMESTAMP(&buffer), kTimeStamp);
     EXPECT_EQ(GST_BUFFER_DURATION(&buffer), kDuration);
 }
@@ -944,7 +983,7 @@ TEST_F(GstGenericPlayerPrivateTest, shouldCreateCENCEncryptedGstBuffer)
                                     &m_decryptionServiceMock};
     EXPECT_CALL(*m_gstProtectionMetadataWrapperMock, addProtectionMetadata(&buffer, data)).WillOnce(Return(&meta));
 
-    m_sut->createBuffer(mediaSegment);
+    m_sut->createBuffer(makeMediaSegmentView(mediaSegment), nullptr);
     EXPECT_EQ(GST_BUFFER_TIMESTAMP(&buffer), kTimeStamp);
     EXPECT_EQ(GST_BUFFER_DURATION(&buffer), kDuration);
 }
@@ -994,7 +1033,62 @@ TEST_F(GstGenericPlayerPrivateTest, shouldFailToAddProtectionMetadata)
     EXPECT_CALL(*m_gstWrapperMock, gstBufferUnref(&initVectorBuffer));
     EXPECT_CALL(*m_gstWrapperMock, gstBufferUnref(&subSamplesBuffer));
 
-    m_sut->createBuffer(mediaSegment);
+    m_sut->createBuffer(makeMediaSegmentView(mediaSegment), nullptr);
+    EXPECT_EQ(GST_BUFFER_TIMESTAMP(&buffer), kTimeStamp);
+    EXPECT_EQ(GST_BUFFER_DURATION(&buffer), kDuration);
+}
+
+TEST_F(GstGenericPlayerPrivateTest, shouldCreateEncryptedGstBufferFromPackedSubSamples)
+{
+    GstBuffer buffer{}, initVectorBuffer{}, keyIdBuffer{}, subSamplesBuffer{};
+    guint8 subSamplesData{0};
+    auto subSamplesSize{sizeof(guint16) + sizeof(guint32)};
+    const std::uint32_t kPackedSubSample[2]{kNumClearBytes, kNumEncryptedBytes};
+    std::uint8_t mediaData[8]{};
+    MediaSegmentView mediaSegment;
+    mediaSegment.type = MediaSourceType::VIDEO;
+    mediaSegment.timeStamp = kTimeStamp;
+    mediaSegment.duration = kDuration;
+    mediaSegment.data = ByteSpan{mediaData, sizeof(mediaData)};
+    mediaSegment.isEncrypted = true;
+    mediaSegment.mediaKeySessionId = kMediaKeySessionId;
+    mediaSegment.keyId = ByteSpan{kKeyId.data(), kKeyId.size()};
+    mediaSegment.initVector = ByteSpan{kInitVector.data(), kInitVector.size()};
+    mediaSegment.initWithLast15 = kInitWithLast15;
+    mediaSegment.cipherMode = kCipherMode;
+    mediaSegment.encryptionPatternSet = true;
+    mediaSegment.crypt = kCrypt;
+    mediaSegment.skip = kSkip;
+    mediaSegment.subSamples = SubSampleSpan{reinterpret_cast<const std::uint8_t *>(kPackedSubSample), 1};
+    GstMeta meta;
+    testing::InSequence s;
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewAllocate(nullptr, sizeof(mediaData), nullptr)).WillOnce(Return(&buffer));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferFill(&buffer, 0, mediaData, sizeof(mediaData)));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewAllocate(nullptr, kKeyId.size(), nullptr))
+        .WillOnce(Return(&keyIdBuffer));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferFill(&keyIdBuffer, 0, kKeyId.data(), kKeyId.size()));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewAllocate(nullptr, kInitVector.size(), nullptr))
+        .WillOnce(Return(&initVectorBuffer));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferFill(&initVectorBuffer, 0, kInitVector.data(), kInitVector.size()));
+    EXPECT_CALL(*m_glibWrapperMock, gMalloc(subSamplesSize)).WillOnce(Return(&subSamplesData));
+    EXPECT_CALL(*m_gstWrapperMock, gstByteWriterInitWithData(_, &subSamplesData, subSamplesSize, FALSE));
+    EXPECT_CALL(*m_gstWrapperMock, gstByteWriterPutUint16Be(_, kNumClearBytes));
+    EXPECT_CALL(*m_gstWrapperMock, gstByteWriterPutUint32Be(_, kNumEncryptedBytes));
+    EXPECT_CALL(*m_gstWrapperMock, gstBufferNewWrapped(&subSamplesData, subSamplesSize)).WillOnce(Return(&subSamplesBuffer));
+    GstRialtoProtectionData data = {kMediaKeySessionId,
+                                    1,
+                                    kInitWithLast15,
+                                    &keyIdBuffer,
+                                    &initVectorBuffer,
+                                    &subSamplesBuffer,
+                                    kCipherMode,
+                                    kCrypt,
+                                    kSkip,
+                                    true,
+                                    &m_decryptionServiceMock};
+    EXPECT_CALL(*m_gstProtectionMetadataWrapperMock, addProtectionMetadata(&buffer, data)).WillOnce(Return(&meta));
+
+    m_sut->createBuffer(mediaSegment, nullptr);
     EXPECT_EQ(GST_BUFFER_TIMESTAMP(&buffer), kTimeStamp);
     EXPECT_EQ(GST_BUFFER_DURATION(&buffer), kDuration);
 }
@@ -1289,6 +1383,34 @@ TEST_F(GstGenericPlayerPrivateTest, shouldAttachVideoData)
     m_sut->attachData(firebolt::rialto::MediaSourceType::VIDEO);
 }
 
+TEST_F(GstGenericPlayerPrivateTest, shouldGetQueuedDurationOfAttachedVideoData)
+{
+    constexpr std::int64_t kPosition{1000000000};
+    constexpr std::int64_t kBufferPts{3000000000};
+    GstBuffer buffer{};
+    GST_BUFFER_PTS(&buffer) = kBufferPts;
+    GstAppSrc audioSrc{};
+    GstAppSrc videoSrc{};
+    modifyContext(
+        [&](GenericPlayerContext &context)
+        {
+            context.streamPosition = kPosition;
+            context.streamInfo[firebolt::rialto::MediaSourceType::VIDEO].buffers.emplace_back(&buffer);
+            context.streamInfo[firebolt::rialto::MediaSourceType::VIDEO].isDataNeeded = true;
+            context.streamInfo[firebolt::rialto::MediaSourceType::VIDEO].appSrc = GST_ELEMENT(&videoSrc);
+            context.streamInfo[firebolt::rialto::MediaSourceType::AUDIO].appSrc = GST_ELEMENT(&audioSrc);
+        });
+    std::int64_t queuedDuration{0};
+    IGstGenericPlayer &player{dynamic_cast<GstGenericPlayer &>(*m_sut)};
+    EXPECT_FALSE(player.getQueuedDuration(firebolt::rialto::MediaSourceType::VIDEO, queuedDuration));
+
+    EXPECT_CALL(*m_gstWrapperMock, gstAppSrcPushBuffer(_, &buffer));
+    m_sut->attachData(firebolt::rialto::MediaSourceType::VIDEO);
+    EXPECT_TRUE(player.getQueuedDuration(firebolt::rialto::MediaSourceType::VIDEO, queuedDuration));
+    EXPECT_EQ(queuedDuration, kBufferPts - kPosition);
+    EXPECT_FALSE(player.getQueuedDuration(firebolt::rialto::MediaSourceType::AUDIO, queuedDuration));
+}
+
 TEST_F(GstGenericPlayerPrivateTest, shouldAttachVideoSample)
 {
     constexpr std::int64_t kPosition{124};
@@ -1889,8 +2011,10 @@ TEST_F(GstGenericPlayerPrivateTest, shouldScheduleReportPositionWhenPositionRepo
 
 TEST_F(GstGenericPlayerPrivateTest, shouldSchedulePlaybackInfoWhenPlaybackInfoTimerIsFired)
 {
-    std::unique_ptr<common::ITimer> timerMock = std::make_unique<StrictMock<TimerMock>>();
     willNotifyPlaybackInfo();
+    std::unique_ptr<IPlayerTask> task{std::make_unique<StrictMock<PlayerTaskMock>>()};
+    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*task), execute());
+    EXPECT_CALL(m_taskFactoryMock, createNotifyPlaybackInfo(_)).WillOnce(Return(ByMove(std::move(task))));
     std::unique_ptr<common::ITimer> playbackInfoTimerMock = std::make_unique<StrictMock<TimerMock>>();
     EXPECT_CALL(dynamic_cast<StrictMock<TimerMock> &>(*playbackInfoTimerMock), isActive()).WillOnce(Return(true));
     EXPECT_CALL(dynamic_cast<StrictMock<TimerMock> &>(*playbackInfoTimerMock), cancel());
@@ -1898,7 +2022,6 @@ TEST_F(GstGenericPlayerPrivateTest, shouldSchedulePlaybackInfoWhenPlaybackInfoTi
         .WillOnce(Invoke(
             [&](const std::chrono::milliseconds &timeout, const std::function<void()> &callback, common::TimerType timerType)
             {
-                willNotifyPlaybackInfo();
                 callback();
                 return std::move(playbackInfoTimerMock);
             }));
@@ -25,6 +25,7 @@
 #include "MatchersGenericPlayer.h"
 #include "MediaSourceUtil.h"
 #include "PlayerTaskMock.h"
+#include "ShmRingReaderMock.h"
 #include "TimerMock.h"
 
 using testing::_;
@@ -34,6 +35,7 @@ using testing::Invoke;
 using testing::Ref;
 using testing::Return;
 using testing::SetArgumentPointee;
+using testing::SizeIs;
 using testing::StrEq;
 
 class GstGenericPlayerTest : public GstGenericPlayerTestCommon
@@ -210,10 +212,43 @@ TEST_F(GstGenericPlayerTest, shouldAttachSamplesFromShm)
     std::shared_ptr<IDataReader> dataReader{std::make_shared<DataReaderMock>()};
     std::unique_ptr<IPlayerTask> task{std::make_unique<StrictMock<PlayerTaskMock>>()};
     EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*task), execute());
-    EXPECT_CALL(m_taskFactoryMock, createReadShmDataAndAttachSamples(_, _, dataReader))
+    EXPECT_CALL(m_taskFactoryMock, createReadShmDataAndAttachSamples(_, _, dataReader, nullptr))
         .WillOnce(Return(ByMove(std::move(task))));
 
-    m_sut->attachSamples(dataReader);
+    m_sut->attachSamples(dataReader, nullptr);
+}
+
+TEST_F(GstGenericPlayerTest, shouldAttachSamplesOfSeveralRequestsFromShm)
+{
+    std::shared_ptr<IDataReader> audioDataReader{std::make_shared<DataReaderMock>()};
+    std::shared_ptr<IDataReader> videoDataReader{std::make_shared<DataReaderMock>()};
+    std::unique_ptr<IPlayerTask> task{std::make_unique<StrictMock<PlayerTaskMock>>()};
+    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*task), execute());
+    EXPECT_CALL(m_taskFactoryMock, createReadShmDataAndAttachSamples(_, _, SizeIs(2)))
+        .WillOnce(Return(ByMove(std::move(task))));
+
+    m_sut->attachSamples({{audioDataReader, nullptr}, {videoDataReader, nullptr}});
+}
+
+TEST_F(GstGenericPlayerTest, shouldNotAttachEmptyListOfSamplesFromShm)
+{
+    m_sut->attachSamples(std::vector<IGstGenericPlayer::ShmSamples>{});
+}
+
+TEST_F(GstGenericPlayerTest, shouldDrainShmRing)
+{
+    std::shared_ptr<IShmRingReader> shmRingReader{std::make_shared<StrictMock<ShmRingReaderMock>>()};
+    std::unique_ptr<IPlayerTask> task{std::make_unique<StrictMock<PlayerTaskMock>>()};
+    EXPECT_CALL(dynamic_cast<StrictMock<PlayerTaskMock> &>(*task), execute());
+    EXPECT_CALL(m_taskFactoryMock, createReadShmRingAndAttachSamples(_, _, shmRingReader))
+        .WillOnce(Return(ByMove(std::move(task))));
+
+    m_sut->drainShmRing(shmRingReader);
+}
+
+TEST_F(GstGenericPlayerTest, shouldNotDrainMissingShmRing)
+{
+    m_sut->drainShmRing(nullptr);
 }
 
 TEST_F(GstGenericPlayerTest, shouldSetPlaybackRate)
@@ -33,11 +33,13 @@
 #include "tasks/generic/FinishSetupSource.h"
 #include "tasks/generic/Flush.h"
 #include "tasks/generic/NeedData.h"
+#include "tasks/generic/NotifyPlaybackInfo.h"
 #include "tasks/generic/Pause.h"
 #include "tasks/generic/Ping.h"
 #include "tasks/generic/Play.h"
 #include "tasks/generic/ProcessAudioGap.h"
 #include "tasks/generic/ReadShmDataAndAttachSamples.h"
+#include "tasks/generic/ReadShmRingAndAttachSamples.h"
 #include "tasks/generic/RemoveSource.h"
 #include "tasks/generic/RenderFrame.h"
 #include "tasks/generic/ReportPosition.h"
@@ -65,6 +67,7 @@
 #include "tasks/generic/Underflow.h"
 #include "tasks/generic/UpdatePlaybackGroup.h"
 
+#include <algorithm>
 #include <gst/gst.h>
 #include <memory>
 #include <string>
@@ -157,6 +160,16 @@ firebolt::rialto::IMediaPipeline::MediaSegmentVector buildAudioSamples()
     return dataVec;
 }
 
+firebolt::rialto::IMediaPipeline::MediaSegmentVector buildAudioFrame()
+{
+    firebolt::rialto::IMediaPipeline::MediaSegmentVector dataVec;
+    dataVec.emplace_back(
+        std::make_unique<firebolt::rialto::IMediaPipeline::MediaSegmentAudio>(kAudioSourceId, kItHappenedInThePast,
+                                                                              kDuration, kSampleRate, kNumberOfChannels,
+                                                                              kClippingStart, kClippingEnd));
+    return dataVec;
+}
+
 firebolt::rialto::IMediaPipeline::MediaSegmentVector buildVideoSamples()
 {
     firebolt::rialto::IMediaPipeline::MediaSegmentVector dataVec;
@@ -1534,7 +1547,9 @@ void GenericTasksTestsBase::triggerSetVolumeEaseTypeCubicOut()
 void GenericTasksTestsBase::shouldAttachAllAudioSamples()
 {
     std::shared_ptr<firebolt::rialto::CodecData> kNullCodecData{};
-    EXPECT_CALL(testContext->m_gstPlayer, createBuffer(_)).Times(2).WillRepeatedly(Return(&testContext->m_audioBuffer));
+    EXPECT_CALL(testContext->m_gstPlayer, createBuffer(_, _))
+        .Times(2)
+        .WillRepeatedly(Return(&testContext->m_audioBuffer));
     EXPECT_CALL(testContext->m_gstPlayer, updateAudioCaps(kSampleRate, kNumberOfChannels, kNullCodecData));
     EXPECT_CALL(testContext->m_gstPlayer, updateAudioCaps(kSampleRate, kNumberOfChannels, kCodecDataBuffer));
     EXPECT_CALL(testContext->m_gstPlayer,
@@ -1548,7 +1563,9 @@ void GenericTasksTestsBase::shouldAttachAllAudioSamplesWithDelay()
 {
     testContext->m_context.streamPosition = kItHappenedInThePast - 10;
     std::shared_ptr<firebolt::rialto::CodecData> kNullCodecData{};
-    EXPECT_CALL(testContext->m_gstPlayer, createBuffer(_)).Times(2).WillRepeatedly(Return(&testContext->m_audioBuffer));
+    EXPECT_CALL(testContext->m_gstPlayer, createBuffer(_, _))
+        .Times(2)
+        .WillRepeatedly(Return(&testContext->m_audioBuffer));
     EXPECT_CALL(testContext->m_gstPlayer, updateAudioCaps(kSampleRate, kNumberOfChannels, kNullCodecData));
     EXPECT_CALL(testContext->m_gstPlayer, updateAudioCaps(kSampleRate, kNumberOfChannels, kCodecDataBuffer));
     EXPECT_CALL(testContext->m_gstPlayer,
@@ -1577,7 +1594,9 @@ void GenericTasksTestsBase::triggerAttachSamplesAudio()
 void GenericTasksTestsBase::shouldAttachAllVideoSamples()
 {
     std::shared_ptr<firebolt::rialto::CodecData> kNullCodecData{};
-    EXPECT_CALL(testContext->m_gstPlayer, createBuffer(_)).Times(2).WillRepeatedly(Return(&testContext->m_videoBuffer));
+    EXPECT_CALL(testContext->m_gstPlayer, createBuffer(_, _))
+        .Times(2)
+        .WillRepeatedly(Return(&testContext->m_videoBuffer));
     EXPECT_CALL(testContext->m_gstPlayer, updateVideoCaps(kWidth, kHeight, kFrameRate, kNullCodecData));
     EXPECT_CALL(testContext->m_gstPlayer, updateVideoCaps(kWidth, kHeight, kFrameRate, kCodecDataBuffer));
     EXPECT_CALL(testContext->m_gstPlayer, attachData(MediaSourceType::VIDEO)).Times(2);
@@ -1599,7 +1618,9 @@ void GenericTasksTestsBase::triggerAttachSamplesVideo()
 void GenericTasksTestsBase::shouldAttachAllSubtitleSamples()
 {
     std::shared_ptr<firebolt::rialto::CodecData> kNullCodecData{};
-    EXPECT_CALL(testContext->m_gstPlayer, createBuffer(_)).Times(2).WillRepeatedly(Return(&testContext->m_subtitleBuffer));
+    EXPECT_CALL(testContext->m_gstPlayer, createBuffer(_, _))
+        .Times(2)
+        .WillRepeatedly(Return(&testContext->m_subtitleBuffer));
     EXPECT_CALL(testContext->m_gstPlayer, attachData(MediaSourceType::SUBTITLE)).Times(2);
     EXPECT_CALL(testContext->m_gstPlayer, notifyNeedMediaData(MediaSourceType::SUBTITLE));
 }
@@ -1622,7 +1643,9 @@ void GenericTasksTestsBase::checkSubtitleSamplesAttached()
 void GenericTasksTestsBase::shouldSkipAttachingSubtitleSamples()
 {
     std::shared_ptr<firebolt::rialto::CodecData> kNullCodecData{};
-    EXPECT_CALL(testContext->m_gstPlayer, createBuffer(_)).Times(2).WillRepeatedly(Return(&testContext->m_subtitleBuffer));
+    EXPECT_CALL(testContext->m_gstPlayer, createBuffer(_, _))
+        .Times(2)
+        .WillRepeatedly(Return(&testContext->m_subtitleBuffer));
     EXPECT_CALL(*testContext->m_gstWrapper, gstBufferUnref(&testContext->m_subtitleBuffer)).Times(2);
     EXPECT_CALL(testContext->m_gstPlayer, notifyNeedMediaData(MediaSourceType::SUBTITLE));
 }
@@ -2933,6 +2956,17 @@ void GenericTasksTestsBase::checkContextPaused()
     EXPECT_FALSE(testContext->m_context.isPlaying);
 }
 
+void GenericTasksTestsBase::shouldNotifyPlaybackInfo()
+{
+    EXPECT_CALL(testContext->m_gstPlayer, notifyPlaybackInfo());
+}
+
+void GenericTasksTestsBase::triggerNotifyPlaybackInfo()
+{
+    firebolt::rialto::server::tasks::generic::NotifyPlaybackInfo task{testContext->m_gstPlayer};
+    task.execute();
+}
+
 void GenericTasksTestsBase::shouldReportPosition()
 {
     EXPECT_CALL(testContext->m_gstPlayer, getPosition(NotNullMatcher())).WillOnce(Return(kPosition));
@@ -3368,31 +3402,36 @@ void GenericTasksTestsBase::shouldFlushAudioSrcFailure()
 
 void GenericTasksTestsBase::shouldReadAudioData()
 {
-    EXPECT_CALL(*testContext->m_dataReader, readData()).WillOnce(Invoke([&]() { return buildAudioSamples(); }));
+    EXPECT_CALL(*testContext->m_dataReader, readSegments(_))
+        .WillOnce(Invoke([&](MediaSegmentBatch &batch) { batch.addSegments(buildAudioSamples()); }));
     EXPECT_CALL(*testContext->m_dataReader, isBufferFull()).WillOnce(Return(true));
 }
 
 void GenericTasksTestsBase::shouldReadAudioDataFromShmWithAvailableSpace()
 {
-    EXPECT_CALL(*testContext->m_dataReader, readData()).WillOnce(Invoke([&]() { return buildAudioSamples(); }));
+    EXPECT_CALL(*testContext->m_dataReader, readSegments(_))
+        .WillOnce(Invoke([&](MediaSegmentBatch &batch) { batch.addSegments(buildAudioSamples()); }));
     EXPECT_CALL(*testContext->m_dataReader, isBufferFull()).WillOnce(Return(false));
 }
 
 void GenericTasksTestsBase::shouldReadVideoData()
 {
-    EXPECT_CALL(*testContext->m_dataReader, readData()).WillOnce(Invoke([&]() { return buildVideoSamples(); }));
+    EXPECT_CALL(*testContext->m_dataReader, readSegments(_))
+        .WillOnce(Invoke([&](MediaSegmentBatch &batch) { batch.addSegments(buildVideoSamples()); }));
     EXPECT_CALL(*testContext->m_dataReader, isBufferFull()).WillOnce(Return(true));
 }
 
 void GenericTasksTestsBase::shouldReadSubtitleData()
 {
-    EXPECT_CALL(*testContext->m_dataReader, readData()).WillOnce(Invoke([&]() { return buildSubtitleSamples(); }));
+    EXPECT_CALL(*testContext->m_dataReader, readSegments(_))
+        .WillOnce(Invoke([&](MediaSegmentBatch &batch) { batch.addSegments(buildSubtitleSamples()); }));
     EXPECT_CALL(*testContext->m_dataReader, isBufferFull()).WillOnce(Return(true));
 }
 
 void GenericTasksTestsBase::shouldReadUnknownData()
 {
-    EXPECT_CALL(*testContext->m_dataReader, readData()).WillOnce(Invoke([&]() { return buildUnknownSamples(); }));
+    EXPECT_CALL(*testContext->m_dataReader, readSegments(_))
+        .WillOnce(Invoke([&](MediaSegmentBatch &batch) { batch.addSegments(buildUnknownSamples()); }));
     EXPECT_CALL(*testContext->m_dataReader, isBufferFull()).WillOnce(Return(true));
 }
 
@@ -3406,7 +3445,8 @@ void GenericTasksTestsBase::triggerReadShmDataAndAttachSamplesAudio()
     firebolt::rialto::server::tasks::generic::ReadShmDataAndAttachSamples task{testContext->m_context,
                                                                                testContext->m_gstWrapper,
                                                                                testContext->m_gstPlayer,
-                                                                               testContext->m_dataReader};
+                                                                               testContext->m_dataReader,
+                                                                               nullptr};
     task.execute();
 
     auto audioStreamIt{testContext->m_context.streamInfo.find(firebolt::rialto::MediaSourceType::AUDIO)};
@@ -3419,7 +3459,8 @@ void GenericTasksTestsBase::triggerReadShmDataAndAttachSamplesVideo()
     firebolt::rialto::server::tasks::generic::ReadShmDataAndAttachSamples task{testContext->m_context,
                                                                                testContext->m_gstWrapper,
                                                                                testContext->m_gstPlayer,
-                                                                               testContext->m_dataReader};
+                                                                               testContext->m_dataReader,
+                                                                               nullptr};
     task.execute();
     auto videoStreamIt{testContext->m_context.streamInfo.find(firebolt::rialto::MediaSourceType::VIDEO)};
     ASSERT_NE(testContext->m_context.streamInfo.end(), videoStreamIt);
@@ -3431,10 +3472,75 @@ void GenericTasksTestsBase::triggerReadShmDataAndAttachSamples()
     firebolt::rialto::server::tasks::generic::ReadShmDataAndAttachSamples task{testContext->m_context,
                                                                                testContext->m_gstWrapper,
                                                                                testContext->m_gstPlayer,
-                                                                               testContext->m_dataReader};
+                                                                               testContext->m_dataReader,
+                                                                               nullptr};
     task.execute();
 }
 
+void GenericTasksTestsBase::shouldReadFromRing(const std::vector<IShmRingReader::Status> &statuses)
+{
+    auto nextStatus{std::make_shared<std::size_t>(0)};
+    EXPECT_CALL(*testContext->m_shmRingReader, getType()).WillRepeatedly(Return(MediaSourceType::AUDIO));
+    EXPECT_CALL(*testContext->m_shmRingReader, read(_))
+        .Times(statuses.size())
+        .WillRepeatedly(Invoke(
+            [statuses, nextStatus](MediaSegmentBatch &batch)
+            {
+                const IShmRingReader::Status kStatus{statuses.at((*nextStatus)++)};
+                if (IShmRingReader::Status::FRAME == kStatus)
+                {
+                    batch.addSegments(buildAudioFrame());
+                }
+                return kStatus;
+            }));
+    const auto kNumConsumed{statuses.size() -
+                            std::count(statuses.begin(), statuses.end(), IShmRingReader::Status::EMPTY)};
+    EXPECT_CALL(*testContext->m_shmRingReader, consume()).Times(kNumConsumed);
+}
+
+void GenericTasksTestsBase::shouldWaitForRingDoorbell(const std::vector<bool> &hasRecords)
+{
+    auto nextResult{std::make_shared<std::size_t>(0)};
+    EXPECT_CALL(*testContext->m_shmRingReader, waitForDoorbell())
+        .Times(hasRecords.size())
+        .WillRepeatedly(Invoke([hasRecords, nextResult]() -> bool { return hasRecords.at((*nextResult)++); }));
+}
+
+void GenericTasksTestsBase::shouldAttachAudioFramesFromRing(unsigned numFrames)
+{
+    std::shared_ptr<firebolt::rialto::CodecData> kNullCodecData{};
+    EXPECT_CALL(testContext->m_gstPlayer, createBuffer(_, nullptr))
+        .Times(numFrames)
+        .WillRepeatedly(Return(&testContext->m_audioBuffer));
+    EXPECT_CALL(testContext->m_gstPlayer, updateAudioCaps(kSampleRate, kNumberOfChannels, kNullCodecData))
+        .Times(numFrames);
+    EXPECT_CALL(testContext->m_gstPlayer,
+                addAudioClippingToBuffer(&testContext->m_audioBuffer, kClippingStart, kClippingEnd))
+        .Times(numFrames);
+    EXPECT_CALL(testContext->m_gstPlayer, attachData(MediaSourceType::AUDIO)).Times(numFrames);
+}
+
+void GenericTasksTestsBase::shouldRequestAudioRingDrain()
+{
+    EXPECT_CALL(testContext->m_gstPlayer, notifyNeedMediaData(MediaSourceType::AUDIO));
+}
+
+void GenericTasksTestsBase::triggerReadShmRingAndAttachSamples()
+{
+    firebolt::rialto::server::tasks::generic::ReadShmRingAndAttachSamples task{testContext->m_context,
+                                                                               testContext->m_gstWrapper,
+                                                                               testContext->m_gstPlayer,
+                                                                               testContext->m_shmRingReader};
+    task.execute();
+}
+
+void GenericTasksTestsBase::checkAudioFramesAttached(std::size_t numFrames)
+{
+    auto audioStreamIt{testContext->m_context.streamInfo.find(firebolt::rialto::MediaSourceType::AUDIO)};
+    ASSERT_NE(testContext->m_context.streamInfo.end(), audioStreamIt);
+    EXPECT_EQ(audioStreamIt->second.buffers.size(), numFrames);
+}
+
 void GenericTasksTestsBase::shouldFlushAudio()
 {
     testContext->m_context.firstAudioFrameReceived = true;
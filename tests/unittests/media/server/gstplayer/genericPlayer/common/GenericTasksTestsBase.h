@@ -20,6 +20,7 @@
 #ifndef GENERIC_TASKS_TESTS_BASE_H_
 #define GENERIC_TASKS_TESTS_BASE_H_
 
+#include "IShmRingReader.h"
 #include "MediaCommon.h"
 
 #include <gmock/gmock.h>
@@ -27,6 +28,7 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <vector>
 
 using ::testing::_;
 using ::testing::A;
@@ -353,6 +355,10 @@ protected:
     void triggerPause();
     void checkContextPaused();
 
+    // NotifyPlaybackInfo test methods
+    void shouldNotifyPlaybackInfo();
+    void triggerNotifyPlaybackInfo();
+
     // ReportPosition test methods
     void shouldReportPosition();
     void triggerReportPosition();
@@ -418,6 +424,14 @@ protected:
     void triggerReadShmDataAndAttachSamplesVideo();
     void triggerReadShmDataAndAttachSamples();
 
+    // ReadShmRingAndAttachSamples test methods
+    void shouldReadFromRing(const std::vector<firebolt::rialto::server::IShmRingReader::Status> &statuses);
+    void shouldWaitForRingDoorbell(const std::vector<bool> &hasRecords);
+    void shouldAttachAudioFramesFromRing(unsigned numFrames);
+    void shouldRequestAudioRingDrain();
+    void triggerReadShmRingAndAttachSamples();
+    void checkAudioFramesAttached(std::size_t numFrames);
+
     // RemoveSource test methods
     void shouldInvalidateActiveAudioRequests();
     void shouldUnrefAudioBuffer();
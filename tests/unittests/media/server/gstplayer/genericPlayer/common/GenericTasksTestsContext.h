@@ -31,6 +31,7 @@
 #include "GstTextTrackSinkFactoryMock.h"
 #include "GstWrapperMock.h"
 #include "RdkGstreamerUtilsWrapperMock.h"
+#include "ShmRingReaderMock.h"
 
 #include <memory>
 #include <string>
@@ -60,6 +61,8 @@ public:
         std::make_shared<StrictMock<firebolt::rialto::server::GstSrcMock>>()};
     std::shared_ptr<StrictMock<firebolt::rialto::server::DataReaderMock>> m_dataReader{
         std::make_shared<StrictMock<firebolt::rialto::server::DataReaderMock>>()};
+    std::shared_ptr<StrictMock<firebolt::rialto::server::ShmRingReaderMock>> m_shmRingReader{
+        std::make_shared<StrictMock<firebolt::rialto::server::ShmRingReaderMock>>()};
     std::shared_ptr<firebolt::rialto::server::GstTextTrackSinkFactoryMock> m_gstTextTrackSinkFactoryMock{
         std::make_shared<StrictMock<firebolt::rialto::server::GstTextTrackSinkFactoryMock>>()};
     std::unique_ptr<::testing::NiceMock<firebolt::rialto::server::GstProfilerMock>> m_gstProfilerMock{
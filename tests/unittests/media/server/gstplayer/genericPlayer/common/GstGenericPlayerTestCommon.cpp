@@ -86,6 +86,8 @@ void GstGenericPlayerTestCommon::executeTaskWhenEnqueued()
     // be enqueued)
     EXPECT_CALL(m_workerThreadMock, enqueueTask(_))
         .WillRepeatedly(Invoke([](std::unique_ptr<IPlayerTask> &&task) { task->execute(); }));
+    EXPECT_CALL(m_workerThreadMock, enqueueCoalescedTask(_, _))
+        .WillRepeatedly(Invoke([](CoalescingKey key, std::unique_ptr<IPlayerTask> &&task) { task->execute(); }));
 }
 
 void GstGenericPlayerTestCommon::triggerSetupSource(GstElement *element)
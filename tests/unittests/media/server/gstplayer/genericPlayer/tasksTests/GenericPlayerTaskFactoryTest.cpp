@@ -41,11 +41,13 @@
 #include "tasks/generic/GenericPlayerTaskFactory.h"
 #include "tasks/generic/HandleBusMessage.h"
 #include "tasks/generic/NeedData.h"
+#include "tasks/generic/NotifyPlaybackInfo.h"
 #include "tasks/generic/Pause.h"
 #include "tasks/generic/Ping.h"
 #include "tasks/generic/Play.h"
 #include "tasks/generic/ProcessAudioGap.h"
 #include "tasks/generic/ReadShmDataAndAttachSamples.h"
+#include "tasks/generic/ReadShmRingAndAttachSamples.h"
 #include "tasks/generic/RemoveSource.h"
 #include "tasks/generic/RenderFrame.h"
 #include "tasks/generic/ReportPosition.h"
@@ -181,11 +183,26 @@ TEST_F(GenericPlayerTaskFactoryTest, ShouldCreatePlay)
 
 TEST_F(GenericPlayerTaskFactoryTest, ShouldCreateReadShmDataAndAttachSamples)
 {
-    auto task = m_sut.createReadShmDataAndAttachSamples(m_context, m_gstPlayer, nullptr);
+    auto task = m_sut.createReadShmDataAndAttachSamples(m_context, m_gstPlayer, nullptr, nullptr);
     EXPECT_NE(task, nullptr);
     EXPECT_NO_THROW(dynamic_cast<firebolt::rialto::server::tasks::generic::ReadShmDataAndAttachSamples &>(*task));
 }
 
+TEST_F(GenericPlayerTaskFactoryTest, ShouldCreateReadShmDataAndAttachSamplesForSeveralRequests)
+{
+    const std::vector<IGstGenericPlayer::ShmSamples> kShmSamples{{nullptr, nullptr}, {nullptr, nullptr}};
+    auto task = m_sut.createReadShmDataAndAttachSamples(m_context, m_gstPlayer, kShmSamples);
+    EXPECT_NE(task, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<firebolt::rialto::server::tasks::generic::ReadShmDataAndAttachSamples &>(*task));
+}
+
+TEST_F(GenericPlayerTaskFactoryTest, ShouldCreateReadShmRingAndAttachSamples)
+{
+    auto task = m_sut.createReadShmRingAndAttachSamples(m_context, m_gstPlayer, nullptr);
+    EXPECT_NE(task, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<firebolt::rialto::server::tasks::generic::ReadShmRingAndAttachSamples &>(*task));
+}
+
 TEST_F(GenericPlayerTaskFactoryTest, ShouldCreateRemoveSource)
 {
     auto task = m_sut.createRemoveSource(m_context, m_gstPlayer, firebolt::rialto::MediaSourceType::AUDIO);
@@ -200,6 +217,13 @@ TEST_F(GenericPlayerTaskFactoryTest, ShouldCreateReportPosition)
     EXPECT_NO_THROW(dynamic_cast<firebolt::rialto::server::tasks::generic::ReportPosition &>(*task));
 }
 
+TEST_F(GenericPlayerTaskFactoryTest, ShouldCreateNotifyPlaybackInfo)
+{
+    auto task = m_sut.createNotifyPlaybackInfo(m_gstPlayer);
+    EXPECT_NE(task, nullptr);
+    EXPECT_NO_THROW(dynamic_cast<firebolt::rialto::server::tasks::generic::NotifyPlaybackInfo &>(*task));
+}
+
 TEST_F(GenericPlayerTaskFactoryTest, ShouldCreateCheckAudioUnderflow)
 {
     auto task = m_sut.createCheckAudioUnderflow(m_context, m_gstPlayer);
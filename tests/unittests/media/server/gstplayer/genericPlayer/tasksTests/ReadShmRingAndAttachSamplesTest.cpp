@@ -0,0 +1,88 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "GenericTasksTestsBase.h"
+
+using firebolt::rialto::server::IShmRingReader;
+
+class ReadShmRingAndAttachSamplesTest : public GenericTasksTestsBase
+{
+protected:
+    ReadShmRingAndAttachSamplesTest()
+    {
+        setContextStreamInfo(firebolt::rialto::MediaSourceType::AUDIO);
+        setContextStreamInfo(firebolt::rialto::MediaSourceType::VIDEO);
+    }
+};
+
+TEST_F(ReadShmRingAndAttachSamplesTest, shouldAttachFramesUntilRingIsEmpty)
+{
+    setContextNeedDataAudioOnly();
+    shouldReadFromRing({IShmRingReader::Status::FRAME, IShmRingReader::Status::FRAME, IShmRingReader::Status::EMPTY});
+    shouldWaitForRingDoorbell({false});
+    shouldAttachAudioFramesFromRing(2);
+    triggerReadShmRingAndAttachSamples();
+    checkAudioFramesAttached(2);
+}
+
+TEST_F(ReadShmRingAndAttachSamplesTest, shouldReadFrameWrittenWhileWaitingForDoorbell)
+{
+    setContextNeedDataAudioOnly();
+    shouldReadFromRing({IShmRingReader::Status::EMPTY, IShmRingReader::Status::FRAME, IShmRingReader::Status::EMPTY});
+    shouldWaitForRingDoorbell({true, false});
+    shouldAttachAudioFramesFromRing(1);
+    triggerReadShmRingAndAttachSamples();
+    checkAudioFramesAttached(1);
+}
+
+TEST_F(ReadShmRingAndAttachSamplesTest, shouldNotReadRingWhenDataIsNotNeeded)
+{
+    shouldReadFromRing({});
+    triggerReadShmRingAndAttachSamples();
+    checkAudioFramesAttached(0);
+}
+
+TEST_F(ReadShmRingAndAttachSamplesTest, shouldNotReadRingOfUnknownStream)
+{
+    setContextStreamInfoEmpty();
+    shouldReadFromRing({});
+    triggerReadShmRingAndAttachSamples();
+}
+
+TEST_F(ReadShmRingAndAttachSamplesTest, shouldSetEosWrittenToRing)
+{
+    setContextNeedDataAudioOnly();
+    shouldReadFromRing({IShmRingReader::Status::END_OF_STREAM});
+    shouldCancelUnderflow(firebolt::rialto::MediaSourceType::AUDIO);
+    shouldGstAppSrcEndOfStreamSuccess();
+    triggerReadShmRingAndAttachSamples();
+    shouldSetEos(firebolt::rialto::MediaSourceType::AUDIO);
+}
+
+TEST_F(ReadShmRingAndAttachSamplesTest, shouldRequestNextDrainAfterMaxFrames)
+{
+    constexpr unsigned kMaxFramesPerTask{32};
+    setContextNeedDataAudioOnly();
+    shouldReadFromRing(std::vector<IShmRingReader::Status>(kMaxFramesPerTask, IShmRingReader::Status::FRAME));
+    shouldAttachAudioFramesFromRing(kMaxFramesPerTask);
+    shouldRequestAudioRingDrain();
+    triggerReadShmRingAndAttachSamples();
+    checkAudioFramesAttached(kMaxFramesPerTask);
+}
@@ -20,13 +20,72 @@
 #include "WorkerThread.h"
 #include "PlayerTaskMock.h"
 #include <condition_variable>
+#include <functional>
 #include <gtest/gtest.h>
 #include <mutex>
+#include <thread>
+#include <vector>
 
+using firebolt::rialto::server::CoalescingKey;
+using firebolt::rialto::server::IPlayerTask;
 using firebolt::rialto::server::PlayerTaskMock;
+using firebolt::rialto::server::WorkerThreadStats;
 using testing::Invoke;
 using testing::StrictMock;
 
+namespace
+{
+constexpr std::chrono::milliseconds kTimeout{200};
+
+class TestTask : public IPlayerTask
+{
+public:
+    explicit TestTask(std::function<void()> &&callback) : m_callback{std::move(callback)} {}
+    void execute() const override { m_callback(); }
+
+private:
+    std::function<void()> m_callback;
+};
+
+/**
+ * @brief Holds the worker thread in a task until released, so that the tasks queued meanwhile stay pending.
+ */
+class Gate
+{
+public:
+    std::unique_ptr<IPlayerTask> createTask()
+    {
+        return std::make_unique<TestTask>(
+            [this]()
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_isEntered = true;
+                m_cv.notify_all();
+                m_cv.wait_for(lock, kTimeout, [this]() { return m_isOpen; });
+            });
+    }
+
+    bool waitUntilEntered()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        return m_cv.wait_for(lock, kTimeout, [this]() { return m_isEntered; });
+    }
+
+    void open()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_isOpen = true;
+        m_cv.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_isEntered{false};
+    bool m_isOpen{false};
+};
+} // namespace
+
 TEST(WorkerThreadTest, shouldEnqueueTaskAndExit)
 {
     std::mutex m_taskMutex;
@@ -55,3 +114,121 @@ TEST(WorkerThreadTest, shouldEnqueueTaskAndExit)
 
     // sut.reset();
 }
+
+TEST(WorkerThreadTest, shouldExecuteTasksOfEachProducerInOrder)
+{
+    constexpr unsigned kNumProducers{4};
+    constexpr unsigned kNumTasks{1000};
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::vector<unsigned>> executed(kNumProducers);
+    unsigned numExecuted{0};
+    auto sut = firebolt::rialto::server::WorkerThreadFactory().createWorkerThread();
+
+    std::vector<std::thread> producers;
+    for (unsigned producer = 0; producer < kNumProducers; ++producer)
+    {
+        producers.emplace_back(
+            [&, producer]()
+            {
+                for (unsigned i = 0; i < kNumTasks; ++i)
+                {
+                    sut->enqueueTask(std::make_unique<TestTask>(
+                        [&, producer, i]()
+                        {
+                            std::unique_lock<std::mutex> lock{mutex};
+                            executed[producer].push_back(i);
+                            ++numExecuted;
+                            cv.notify_one();
+                        }));
+                }
+            });
+    }
+    for (std::thread &producer : producers)
+    {
+        producer.join();
+    }
+
+    std::unique_lock<std::mutex> lock{mutex};
+    cv.wait_for(lock, kTimeout, [&]() { return numExecuted == kNumProducers * kNumTasks; });
+    for (const std::vector<unsigned> &tasks : executed)
+    {
+        ASSERT_EQ(tasks.size(), kNumTasks);
+        for (unsigned i = 0; i < kNumTasks; ++i)
+        {
+            EXPECT_EQ(tasks[i], i);
+        }
+    }
+}
+
+TEST(WorkerThreadTest, shouldCoalescePendingTasksWithTheSameKey)
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    unsigned numReportPosition{0};
+    unsigned numCheckAudioUnderflow{0};
+    Gate gate;
+    auto sut = firebolt::rialto::server::WorkerThreadFactory().createWorkerThread();
+    const auto kCountTask = [&](unsigned &counter)
+    {
+        return std::make_unique<TestTask>(
+            [&]()
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                ++counter;
+                cv.notify_one();
+            });
+    };
+
+    sut->enqueueTask(gate.createTask());
+    ASSERT_TRUE(gate.waitUntilEntered());
+    for (int i = 0; i < 3; ++i)
+    {
+        sut->enqueueCoalescedTask(CoalescingKey::REPORT_POSITION, kCountTask(numReportPosition));
+        sut->enqueueCoalescedTask(CoalescingKey::CHECK_AUDIO_UNDERFLOW, kCountTask(numCheckAudioUnderflow));
+    }
+    gate.open();
+
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        cv.wait_for(lock, kTimeout, [&]() { return numReportPosition == 1 && numCheckAudioUnderflow == 1; });
+    }
+    EXPECT_EQ(sut->getStats().coalescedTasks, 4);
+
+    // once the pending task has been executed, the next one is queued again
+    sut->enqueueCoalescedTask(CoalescingKey::REPORT_POSITION, kCountTask(numReportPosition));
+    std::unique_lock<std::mutex> lock{mutex};
+    cv.wait_for(lock, kTimeout, [&]() { return numReportPosition == 2; });
+    EXPECT_EQ(numReportPosition, 2);
+    EXPECT_EQ(numCheckAudioUnderflow, 1);
+}
+
+TEST(WorkerThreadTest, shouldReportQueueDepthAndLatency)
+{
+    constexpr unsigned kNumTasks{3};
+    Gate gate;
+    auto sut = firebolt::rialto::server::WorkerThreadFactory().createWorkerThread();
+
+    sut->enqueueTask(gate.createTask());
+    ASSERT_TRUE(gate.waitUntilEntered());
+    for (unsigned i = 0; i < kNumTasks; ++i)
+    {
+        sut->enqueueTask(std::make_unique<TestTask>([]() {}));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+    WorkerThreadStats stats{sut->getStats()};
+    EXPECT_EQ(stats.queueDepth, kNumTasks);
+    EXPECT_GE(stats.maxQueueDepth, kNumTasks);
+    EXPECT_EQ(stats.executedTasks, 1);
+
+    gate.open();
+    sut->stop();
+    sut->join();
+
+    stats = sut->getStats();
+    EXPECT_EQ(stats.queueDepth, 0);
+    EXPECT_EQ(stats.executedTasks, kNumTasks + 2);
+    EXPECT_GE(stats.maxLatencyUs, 10000);
+    EXPECT_GE(stats.totalLatencyUs, kNumTasks * 10000);
+}
@@ -209,6 +209,30 @@ TEST_F(MediaPipelineModuleServiceTests, shouldFailWhenHaveDataIsReceived)
     sendHaveDataRequestAndReceiveResponse();
 }
 
+TEST_F(MediaPipelineModuleServiceTests, shouldHaveDataMulti)
+{
+    mediaPipelineServiceWillHaveDataMulti();
+    sendHaveDataMultiRequestAndReceiveResponse();
+}
+
+TEST_F(MediaPipelineModuleServiceTests, shouldFailWhenHaveDataMultiIsReceived)
+{
+    mediaPipelineServiceWillFailToHaveDataMulti();
+    sendHaveDataMultiRequestAndReceiveResponseWithoutResultsMatch();
+}
+
+TEST_F(MediaPipelineModuleServiceTests, shouldEnableStreamingMode)
+{
+    mediaPipelineServiceWillEnableStreamingMode();
+    sendEnableStreamingModeRequestAndReceiveResponse();
+}
+
+TEST_F(MediaPipelineModuleServiceTests, shouldFailToEnableStreamingMode)
+{
+    mediaPipelineServiceWillFailToEnableStreamingMode();
+    sendEnableStreamingModeRequestAndReceiveResponseWithoutRingMatch();
+}
+
 TEST_F(MediaPipelineModuleServiceTests, shouldSetPlaybackRate)
 {
     mediaPipelineServiceWillSetPlaybackRate();
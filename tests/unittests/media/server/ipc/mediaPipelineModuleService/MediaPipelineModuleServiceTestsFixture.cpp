@@ -56,6 +56,11 @@ constexpr int64_t kPosition{2000000000};
 constexpr std::uint32_t kRequestId{2};
 const firebolt::rialto::MediaSourceStatus kMediaSourceStatus{firebolt::rialto::MediaSourceStatus::CODEC_CHANGED};
 constexpr std::uint32_t kNumFrames{1};
+constexpr std::uint32_t kSecondRequestId{3};
+constexpr std::uint32_t kSecondNumFrames{0};
+constexpr int kDoorbellFd{21};
+constexpr std::uint32_t kRingOffset{4096};
+constexpr std::uint32_t kRingCapacity{8192};
 constexpr int kX{30};
 constexpr int kY{40};
 constexpr std::int32_t kSourceId{12};
@@ -185,6 +190,13 @@ MATCHER_P6(NeedMediaDataEventMatcher, sessionId, kSourceId, kNeedDataRequestId,
             (kShmInfo->maxMediaBytes == event->shm_info().max_media_bytes()));
 }
 
+MATCHER_P2(HaveDataInfosMatcher, kFirstInfo, kSecondInfo, "")
+{
+    return arg.size() == 2 && arg[0].status == kFirstInfo.status && arg[0].numFrames == kFirstInfo.numFrames &&
+           arg[0].requestId == kFirstInfo.requestId && arg[1].status == kSecondInfo.status &&
+           arg[1].numFrames == kSecondInfo.numFrames && arg[1].requestId == kSecondInfo.requestId;
+}
+
 MATCHER_P(PositionChangeEventMatcher, kPosition, "")
 {
     std::shared_ptr<firebolt::rialto::PositionChangeEvent> event =
@@ -473,6 +485,38 @@ void MediaPipelineModuleServiceTests::mediaPipelineServiceWillFailToHaveData()
         .WillOnce(Return(false));
 }
 
+void MediaPipelineModuleServiceTests::mediaPipelineServiceWillHaveDataMulti()
+{
+    const firebolt::rialto::HaveDataInfo kFirstInfo{kMediaSourceStatus, kNumFrames, kRequestId};
+    const firebolt::rialto::HaveDataInfo kSecondInfo{firebolt::rialto::MediaSourceStatus::EOS, kSecondNumFrames,
+                                                     kSecondRequestId};
+    expectRequestSuccess();
+    EXPECT_CALL(m_mediaPipelineServiceMock,
+                haveDataMulti(kHardcodedSessionId, HaveDataInfosMatcher(kFirstInfo, kSecondInfo), _))
+        .WillOnce(DoAll(SetArgReferee<2>(std::vector<bool>{true, false}), Return(true)));
+}
+
+void MediaPipelineModuleServiceTests::mediaPipelineServiceWillFailToHaveDataMulti()
+{
+    expectRequestFailure();
+    EXPECT_CALL(m_mediaPipelineServiceMock, haveDataMulti(kHardcodedSessionId, _, _)).WillOnce(Return(false));
+}
+
+void MediaPipelineModuleServiceTests::mediaPipelineServiceWillEnableStreamingMode()
+{
+    expectRequestSuccess();
+    EXPECT_CALL(m_mediaPipelineServiceMock, enableStreamingMode(kHardcodedSessionId, kSourceId, _, _, _))
+        .WillOnce(DoAll(SetArgReferee<2>(kDoorbellFd), SetArgReferee<3>(kRingOffset),
+                        SetArgReferee<4>(kRingCapacity), Return(true)));
+}
+
+void MediaPipelineModuleServiceTests::mediaPipelineServiceWillFailToEnableStreamingMode()
+{
+    expectRequestFailure();
+    EXPECT_CALL(m_mediaPipelineServiceMock, enableStreamingMode(kHardcodedSessionId, kSourceId, _, _, _))
+        .WillOnce(Return(false));
+}
+
 void MediaPipelineModuleServiceTests::mediaPipelineServiceWillSetPlaybackRate()
 {
     expectRequestSuccess();
@@ -1313,6 +1357,65 @@ void MediaPipelineModuleServiceTests::sendHaveDataRequestAndReceiveResponse()
     m_service->haveData(m_controllerMock.get(), &request, &response, m_closureMock.get());
 }
 
+void MediaPipelineModuleServiceTests::sendHaveDataMultiRequestAndReceiveResponse()
+{
+    firebolt::rialto::HaveDataMultiResponse response{sendHaveDataMultiRequest()};
+
+    ASSERT_EQ(response.succeeded_size(), 2);
+    EXPECT_TRUE(response.succeeded(0));
+    EXPECT_FALSE(response.succeeded(1));
+}
+
+void MediaPipelineModuleServiceTests::sendHaveDataMultiRequestAndReceiveResponseWithoutResultsMatch()
+{
+    sendHaveDataMultiRequest();
+}
+
+firebolt::rialto::HaveDataMultiResponse MediaPipelineModuleServiceTests::sendHaveDataMultiRequest()
+{
+    firebolt::rialto::HaveDataMultiRequest request;
+    firebolt::rialto::HaveDataMultiResponse response;
+
+    request.set_session_id(kHardcodedSessionId);
+    firebolt::rialto::HaveDataMultiRequest_HaveData *data = request.add_data();
+    data->set_status(convertMediaSourceStatus(kMediaSourceStatus));
+    data->set_num_frames(kNumFrames);
+    data->set_request_id(kRequestId);
+    data = request.add_data();
+    data->set_status(convertMediaSourceStatus(firebolt::rialto::MediaSourceStatus::EOS));
+    data->set_num_frames(kSecondNumFrames);
+    data->set_request_id(kSecondRequestId);
+
+    m_service->haveDataMulti(m_controllerMock.get(), &request, &response, m_closureMock.get());
+    return response;
+}
+
+void MediaPipelineModuleServiceTests::sendEnableStreamingModeRequestAndReceiveResponse()
+{
+    firebolt::rialto::EnableStreamingModeResponse response{sendEnableStreamingModeRequest()};
+
+    EXPECT_EQ(response.doorbell_fd(), kDoorbellFd);
+    EXPECT_EQ(response.ring_offset(), kRingOffset);
+    EXPECT_EQ(response.ring_capacity(), kRingCapacity);
+}
+
+void MediaPipelineModuleServiceTests::sendEnableStreamingModeRequestAndReceiveResponseWithoutRingMatch()
+{
+    sendEnableStreamingModeRequest();
+}
+
+firebolt::rialto::EnableStreamingModeResponse MediaPipelineModuleServiceTests::sendEnableStreamingModeRequest()
+{
+    firebolt::rialto::EnableStreamingModeRequest request;
+    firebolt::rialto::EnableStreamingModeResponse response;
+
+    request.set_session_id(kHardcodedSessionId);
+    request.set_source_id(kSourceId);
+
+    m_service->enableStreamingMode(m_controllerMock.get(), &request, &response, m_closureMock.get());
+    return response;
+}
+
 void MediaPipelineModuleServiceTests::sendSetPlaybackRateRequestAndReceiveResponse()
 {
     firebolt::rialto::SetPlaybackRateRequest request;
@@ -70,6 +70,10 @@ public:
     void mediaPipelineServiceWillFailToSetVideoWindow();
     void mediaPipelineServiceWillHaveData();
     void mediaPipelineServiceWillFailToHaveData();
+    void mediaPipelineServiceWillHaveDataMulti();
+    void mediaPipelineServiceWillFailToHaveDataMulti();
+    void mediaPipelineServiceWillEnableStreamingMode();
+    void mediaPipelineServiceWillFailToEnableStreamingMode();
     void mediaPipelineServiceWillSetPlaybackRate();
     void mediaPipelineServiceWillFailToSetPlaybackRate();
     void mediaPipelineServiceWillGetPosition();
@@ -170,6 +174,10 @@ public:
     void sendGetStatsRequestAndReceiveResponse();
     void sendGetStatsRequestAndReceiveResponseWithoutStatsMatch();
     void sendHaveDataRequestAndReceiveResponse();
+    void sendHaveDataMultiRequestAndReceiveResponse();
+    void sendHaveDataMultiRequestAndReceiveResponseWithoutResultsMatch();
+    void sendEnableStreamingModeRequestAndReceiveResponse();
+    void sendEnableStreamingModeRequestAndReceiveResponseWithoutRingMatch();
     void sendSetPlaybackRateRequestAndReceiveResponse();
     void sendSetVideoWindowRequestAndReceiveResponse();
     void sendSetVolumeRequestAndReceiveResponse();
@@ -222,6 +230,8 @@ private:
 
     void expectRequestSuccess();
     void expectRequestFailure();
+    firebolt::rialto::HaveDataMultiResponse sendHaveDataMultiRequest();
+    firebolt::rialto::EnableStreamingModeResponse sendEnableStreamingModeRequest();
 };
 
 #endif // MEDIA_PIPELINE_MODULE_SERVICE_TESTS_FIXTURE_H_
@@ -160,6 +160,15 @@ TEST_F(ActiveRequestsTests, shouldEraseVideoIds)
     EXPECT_EQ(firebolt::rialto::MediaSourceType::UNKNOWN, m_sut.getType(3));
 }
 
+TEST_F(ActiveRequestsTests, shouldBeEmptyWhenAllRequestsAreErased)
+{
+    EXPECT_TRUE(m_sut.isEmpty());
+    EXPECT_EQ(0, m_sut.insert(firebolt::rialto::MediaSourceType::AUDIO, 100, kMaxFrames));
+    EXPECT_FALSE(m_sut.isEmpty());
+    m_sut.erase(0);
+    EXPECT_TRUE(m_sut.isEmpty());
+}
+
 TEST_F(ActiveRequestsTests, shouldAddAndGetSegments)
 {
     std::vector<uint8_t> data{'T', 'E', 'S', 'T'};
@@ -20,12 +20,35 @@
 #include "DataReaderFactory.h"
 #include "DataReaderV1.h"
 #include "DataReaderV2.h"
+#include "DataReaderV3.h"
+#include "ShmCommon.h"
+#include "ShmUtils.h"
+#include <cstring>
 #include <gtest/gtest.h>
 
+namespace
+{
+constexpr std::uint32_t kSubtitleFrames{1};
+constexpr bool kIsBufferFull{false};
+constexpr std::uint32_t kMediaDataOffset{firebolt::rialto::server::getMaxMetadataBytes()};
+} // namespace
+
 class DataReaderFactoryTests : public testing::Test
 {
 protected:
+    void writeV2RegionHeader(std::uint32_t generation, std::uint32_t committedGeneration, std::uint32_t validLength,
+                             std::uint32_t numFrames)
+    {
+        const std::uint32_t kVersion{2};
+        const firebolt::rialto::common::ShmRegionHeader kHeader{firebolt::rialto::common::SHM_REGION_HEADER_MAGIC,
+                                                                generation, committedGeneration, validLength,
+                                                                numFrames};
+        std::memcpy(m_buffer, &kVersion, sizeof(kVersion));
+        std::memcpy(m_buffer + firebolt::rialto::common::SHM_REGION_HEADER_OFFSET, &kHeader, sizeof(kHeader));
+    }
+
     firebolt::rialto::server::DataReaderFactory m_sut;
+    std::uint8_t m_buffer[firebolt::rialto::server::getMaxMetadataBytes() + 16]{};
 };
 
 TEST_F(DataReaderFactoryTests, shouldFailToCreateDataReaderForUnknownVersion)
@@ -35,7 +58,7 @@ TEST_F(DataReaderFactoryTests, shouldFailToCreateDataReaderForUnknownVersion)
     constexpr bool kIsBufferFull{true};
     std::uint32_t version{23};
     std::uint8_t *data{reinterpret_cast<std::uint8_t *>(&version)};
-    auto reader = m_sut.createDataReader(kMediaSourceType, data, 0, kNumFrames, kIsBufferFull);
+    auto reader = m_sut.createDataReader(kMediaSourceType, data, 0, kMediaDataOffset, kNumFrames, kIsBufferFull);
     ASSERT_EQ(nullptr, reader);
 }
 
@@ -46,7 +69,7 @@ TEST_F(DataReaderFactoryTests, shouldCreateDataReaderV1)
     constexpr bool kIsBufferFull{true};
     std::uint32_t version{1};
     std::uint8_t *data{reinterpret_cast<std::uint8_t *>(&version)};
-    auto reader = m_sut.createDataReader(kMediaSourceType, data, 0, kNumFrames, kIsBufferFull);
+    auto reader = m_sut.createDataReader(kMediaSourceType, data, 0, kMediaDataOffset, kNumFrames, kIsBufferFull);
     ASSERT_NE(nullptr, reader);
     const firebolt::rialto::server::DataReaderV1 *v1Reader =
         dynamic_cast<const firebolt::rialto::server::DataReaderV1 *>(reader.get());
@@ -60,9 +83,69 @@ TEST_F(DataReaderFactoryTests, shouldCreateDataReaderV2)
     constexpr bool kIsBufferFull{true};
     std::uint32_t version{2};
     std::uint8_t *data{reinterpret_cast<std::uint8_t *>(&version)};
-    auto reader = m_sut.createDataReader(kMediaSourceType, data, 0, kNumFrames, kIsBufferFull);
+    auto reader = m_sut.createDataReader(kMediaSourceType, data, 0, kMediaDataOffset, kNumFrames, kIsBufferFull);
     ASSERT_NE(nullptr, reader);
     const firebolt::rialto::server::DataReaderV2 *v2Reader =
         dynamic_cast<const firebolt::rialto::server::DataReaderV2 *>(reader.get());
     ASSERT_NE(nullptr, v2Reader);
 }
+
+TEST_F(DataReaderFactoryTests, shouldCreateDataReaderV3)
+{
+    constexpr auto kMediaSourceType = firebolt::rialto::MediaSourceType::VIDEO;
+    constexpr std::uint32_t kNumFrames{1};
+    constexpr bool kIsBufferFull{true};
+    std::uint32_t version{3};
+    std::uint8_t *data{reinterpret_cast<std::uint8_t *>(&version)};
+    auto reader = m_sut.createDataReader(kMediaSourceType, data, 0, kMediaDataOffset, kNumFrames, kIsBufferFull);
+    ASSERT_NE(nullptr, reader);
+    const firebolt::rialto::server::DataReaderV3 *v3Reader =
+        dynamic_cast<const firebolt::rialto::server::DataReaderV3 *>(reader.get());
+    ASSERT_NE(nullptr, v3Reader);
+}
+
+TEST_F(DataReaderFactoryTests, shouldNotReadV3FramesCommittedForStaleGeneration)
+{
+    constexpr std::uint32_t kGeneration{3};
+    constexpr std::uint32_t kVersion{3};
+    writeV2RegionHeader(kGeneration, kGeneration - 1, firebolt::rialto::common::MEDIA_FRAME_V3_HEADER_SIZE_BYTES,
+                        kSubtitleFrames);
+    std::memcpy(m_buffer, &kVersion, sizeof(kVersion));
+    auto reader = m_sut.createDataReader(firebolt::rialto::MediaSourceType::SUBTITLE, m_buffer, 0, kMediaDataOffset,
+                                         kSubtitleFrames, kIsBufferFull);
+    ASSERT_NE(nullptr, reader);
+    EXPECT_TRUE(reader->readData().empty());
+}
+
+TEST_F(DataReaderFactoryTests, shouldReadFramesCommittedForCurrentGeneration)
+{
+    constexpr std::uint32_t kGeneration{3};
+    constexpr std::uint32_t kValidLength{sizeof(std::uint32_t)};
+    writeV2RegionHeader(kGeneration, kGeneration, kValidLength, kSubtitleFrames);
+    auto reader = m_sut.createDataReader(firebolt::rialto::MediaSourceType::SUBTITLE, m_buffer, 0, kMediaDataOffset,
+                                         kSubtitleFrames, kIsBufferFull);
+    ASSERT_NE(nullptr, reader);
+    EXPECT_EQ(kSubtitleFrames, reader->readData().size());
+}
+
+TEST_F(DataReaderFactoryTests, shouldNotReadFramesCommittedForStaleGeneration)
+{
+    constexpr std::uint32_t kGeneration{3};
+    constexpr std::uint32_t kValidLength{sizeof(std::uint32_t)};
+    writeV2RegionHeader(kGeneration, kGeneration - 1, kValidLength, kSubtitleFrames);
+    auto reader = m_sut.createDataReader(firebolt::rialto::MediaSourceType::SUBTITLE, m_buffer, 0, kMediaDataOffset,
+                                         kSubtitleFrames, kIsBufferFull);
+    ASSERT_NE(nullptr, reader);
+    EXPECT_TRUE(reader->readData().empty());
+}
+
+TEST_F(DataReaderFactoryTests, shouldNotReadMoreFramesThanCommitted)
+{
+    constexpr std::uint32_t kGeneration{3};
+    constexpr std::uint32_t kValidLength{sizeof(std::uint32_t)};
+    writeV2RegionHeader(kGeneration, kGeneration, kValidLength, 0);
+    auto reader = m_sut.createDataReader(firebolt::rialto::MediaSourceType::SUBTITLE, m_buffer, 0, kMediaDataOffset,
+                                         kSubtitleFrames, kIsBufferFull);
+    ASSERT_NE(nullptr, reader);
+    EXPECT_TRUE(reader->readData().empty());
+}
@@ -29,6 +29,7 @@ using firebolt::rialto::SegmentAlignment;
 using firebolt::rialto::common::IMediaFrameWriter;
 using firebolt::rialto::common::IMediaFrameWriterFactory;
 using firebolt::rialto::server::DataReaderV2;
+using firebolt::rialto::server::MediaSegmentBatch;
 
 namespace
 {
@@ -295,9 +296,10 @@ class DataReaderV2Tests : public testing::Test
 protected:
     DataReaderV2Tests() = default;
 
-    std::unique_ptr<IMediaPipeline::MediaSegment> readData(const firebolt::rialto::MediaSourceType &sourceType)
+    std::unique_ptr<IMediaPipeline::MediaSegment> readData(const firebolt::rialto::MediaSourceType &sourceType,
+                                                           std::uint32_t dataLength = kDataSize)
     {
-        m_sut = std::make_unique<DataReaderV2>(sourceType, m_shm, kMetaDataSize, kNumFrames, kIsBufferFull);
+        m_sut = std::make_unique<DataReaderV2>(sourceType, m_shm, kMetaDataSize, kNumFrames, dataLength, kIsBufferFull);
         EXPECT_EQ(m_sut->isBufferFull(), kIsBufferFull);
         auto result = m_sut->readData();
         if (result.size() != 1)
@@ -305,6 +307,12 @@ protected:
         return std::unique_ptr<IMediaPipeline::MediaSegment>(std::move(result.front()));
     }
 
+    void readSegments(const firebolt::rialto::MediaSourceType &sourceType, MediaSegmentBatch &batch)
+    {
+        m_sut = std::make_unique<DataReaderV2>(sourceType, m_shm, kMetaDataSize, kNumFrames, kDataSize, kIsBufferFull);
+        m_sut->readSegments(batch);
+    }
+
     void writeBuffer(const std::unique_ptr<IMediaPipeline::MediaSegment> &segment)
     {
         auto shmInfo =
@@ -446,3 +454,33 @@ TEST_F(DataReaderV2Tests, shouldReadSubtitleData)
     auto resultSegment = readData(kSubtitleMediaSourceType);
     Check(resultSegment).mandatoryDataPresent();
 }
+
+TEST_F(DataReaderV2Tests, shouldReturnEmptyVectorWhenFrameExceedsCommittedDataLength)
+{
+    constexpr std::uint32_t kCommittedDataLength{8};
+    auto inputSegment = Build().basicVideoSegment()();
+    writeBuffer(inputSegment);
+    auto resultSegment = readData(kVideoMediaSourceType, kCommittedDataLength);
+    EXPECT_FALSE(resultSegment);
+}
+
+TEST_F(DataReaderV2Tests, shouldReadEncryptedVideoDataIntoBatch)
+{
+    auto inputSegment = Build().basicVideoSegment().withEncryptionData().withCBCSCipherMode()();
+    writeBuffer(inputSegment);
+    MediaSegmentBatch batch;
+    readSegments(kVideoMediaSourceType, batch);
+    ASSERT_EQ(batch.size(), 1);
+    const auto &view{batch.front()};
+    EXPECT_EQ(view.type, kVideoMediaSourceType);
+    EXPECT_EQ(view.timeStamp, kTimeStamp);
+    EXPECT_EQ(std::vector<uint8_t>(view.data.data, view.data.data + view.data.size), kMediaData);
+    EXPECT_EQ(view.width, kWidth);
+    EXPECT_EQ(view.height, kHeight);
+    EXPECT_TRUE(view.isEncrypted);
+    EXPECT_EQ(std::vector<uint8_t>(view.keyId.data, view.keyId.data + view.keyId.size), kKeyId);
+    ASSERT_EQ(view.subSamples.size(), 1);
+    EXPECT_EQ(view.subSamples[0].numClearBytes, kNumClearBytes);
+    EXPECT_EQ(view.subSamples[0].numEncryptedBytes, kNumEncryptedBytes);
+    EXPECT_EQ(view.cipherMode, CipherMode::CBCS);
+}
@@ -18,8 +18,13 @@
  */
 
 #include "MainThread.h"
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 
 using namespace firebolt::rialto::server;
 
@@ -102,7 +107,8 @@ TEST_F(MainThreadTests, RegisterItself)
  */
 TEST_F(MainThreadTests, MultipleClients)
 {
-    m_mainThread = std::make_shared<MainThread>();
+    // With a single thread the tasks of all the clients run in the order they were queued
+    m_mainThread = std::make_shared<MainThread>(1);
 
     uint32_t clientId1 = m_mainThread->registerClient();
     uint32_t clientId2 = m_mainThread->registerClient();
@@ -159,3 +165,77 @@ TEST_F(MainThreadTests, IgnoreUnregisteredClients)
 
     unregisterClient(clientId2);
 }
+
+/**
+ * Test that the tasks of a client run in order when several threads run the strands.
+ */
+TEST_F(MainThreadTests, ClientTasksRunInOrder)
+{
+    m_mainThread = std::make_shared<MainThread>(4);
+    uint32_t clientId = m_mainThread->registerClient();
+
+    std::vector<int> order;
+    for (int i = 0; i < 100; ++i)
+    {
+        m_mainThread->enqueueTask(clientId, [&order, i]() { order.push_back(i); });
+    }
+    m_mainThread->enqueueTaskAndWait(clientId, []() {});
+
+    ASSERT_EQ(order.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(order[i], i);
+    }
+    unregisterClient(clientId);
+}
+
+/**
+ * Test that a slow task of one client does not hold up the tasks of another.
+ */
+TEST_F(MainThreadTests, IndependentClientsRunConcurrently)
+{
+    m_mainThread = std::make_shared<MainThread>(2);
+    uint32_t clientId1 = m_mainThread->registerClient();
+    uint32_t clientId2 = m_mainThread->registerClient();
+
+    std::promise<void> otherClientRan;
+    std::future<void> otherClientRanFuture = otherClientRan.get_future();
+    std::atomic<bool> wasOtherClientRunConcurrently{false};
+    auto slowTask = [&]()
+    {
+        wasOtherClientRunConcurrently = std::future_status::ready ==
+                                        otherClientRanFuture.wait_for(std::chrono::seconds(5));
+    };
+    m_mainThread->enqueueTask(clientId1, slowTask);
+    m_mainThread->enqueueTaskAndWait(clientId2, [&]() { otherClientRan.set_value(); });
+    m_mainThread->enqueueTaskAndWait(clientId1, []() {});
+
+    EXPECT_TRUE(wasOtherClientRunConcurrently);
+    unregisterClient(clientId1);
+    unregisterClient(clientId2);
+}
+
+/**
+ * Test that a client registered from a task shares the ordering of the task's client.
+ */
+TEST_F(MainThreadTests, ClientRegisteredFromTaskSharesStrand)
+{
+    m_mainThread = std::make_shared<MainThread>(2);
+    uint32_t parentId = m_mainThread->registerClient();
+    uint32_t childId = 0;
+    m_mainThread->enqueueTaskAndWait(parentId, [&]() { childId = m_mainThread->registerClient(); });
+
+    std::atomic<bool> isParentTaskDone{false};
+    std::atomic<bool> wasChildTaskRunAfterParent{false};
+    m_mainThread->enqueueTask(parentId,
+                              [&]()
+                              {
+                                  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                                  isParentTaskDone = true;
+                              });
+    m_mainThread->enqueueTaskAndWait(childId, [&]() { wasChildTaskRunAfterParent = isParentTaskDone.load(); });
+
+    EXPECT_TRUE(wasChildTaskRunAfterParent);
+    unregisterClient(childId);
+    unregisterClient(parentId);
+}
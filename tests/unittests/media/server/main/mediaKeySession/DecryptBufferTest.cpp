@@ -18,6 +18,9 @@
  */
 
 #include "MediaKeySessionTestBase.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 using testing::DoAll;
 using testing::SetArgReferee;
@@ -136,3 +139,42 @@ TEST_F(RialtoServerMediaKeySessionDecryptBufferTest, OnErrorFailure)
 
     EXPECT_EQ(MediaKeyErrorStatus::FAIL, m_mediaKeySession->decrypt(&m_encrypted, &m_caps));
 }
+
+/**
+ * Test that decrypt, which is called from the decryptor threads, waits for any other ocdm call on the session.
+ */
+TEST_F(RialtoServerMediaKeySessionDecryptBufferTest, SerialisedWithUpdateSession)
+{
+    const std::vector<uint8_t> kResponseData{1, 2, 3};
+    std::atomic<bool> isUpdateStarted{false};
+    std::atomic<bool> isUpdating{false};
+
+    createKeySession(kWidevineKeySystem);
+
+    EXPECT_CALL(*m_ocdmSessionMock, update(&kResponseData[0], kResponseData.size()))
+        .WillOnce(Invoke(
+            [&](const uint8_t *, uint32_t)
+            {
+                isUpdating = true;
+                isUpdateStarted = true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                isUpdating = false;
+                return MediaKeyErrorStatus::OK;
+            }));
+    EXPECT_CALL(*m_ocdmSessionMock, decryptBuffer(&m_encrypted, &m_caps))
+        .WillOnce(Invoke(
+            [&](GstBuffer *, GstCaps *)
+            {
+                EXPECT_FALSE(isUpdating);
+                return MediaKeyErrorStatus::OK;
+            }));
+
+    std::thread updateThread{[&]()
+                             { EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeySession->updateSession(kResponseData)); }};
+    while (!isUpdateStarted)
+    {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeySession->decrypt(&m_encrypted, &m_caps));
+    updateThread.join();
+}
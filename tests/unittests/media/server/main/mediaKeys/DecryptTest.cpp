@@ -38,7 +38,6 @@ protected:
  */
 TEST_F(RialtoServerMediaKeysDecryptTest, Success)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_CALL(*m_mediaKeySessionMock, decrypt(&m_encrypted, &m_caps)).WillOnce(Return(MediaKeyErrorStatus::OK));
 
     EXPECT_EQ(MediaKeyErrorStatus::OK, m_mediaKeys->decrypt(m_kKeySessionId, &m_encrypted, &m_caps));
@@ -49,7 +48,6 @@ TEST_F(RialtoServerMediaKeysDecryptTest, Success)
  */
 TEST_F(RialtoServerMediaKeysDecryptTest, SessionDoesNotExistFailure)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_EQ(MediaKeyErrorStatus::BAD_SESSION_ID, m_mediaKeys->decrypt(m_kKeySessionId + 1, &m_encrypted, &m_caps));
 }
 
@@ -58,7 +56,6 @@ TEST_F(RialtoServerMediaKeysDecryptTest, SessionDoesNotExistFailure)
  */
 TEST_F(RialtoServerMediaKeysDecryptTest, DecryptFailure)
 {
-    mainThreadWillEnqueueTaskAndWait();
     EXPECT_CALL(*m_mediaKeySessionMock, decrypt(&m_encrypted, &m_caps)).WillOnce(Return(MediaKeyErrorStatus::INVALID_STATE));
 
     EXPECT_EQ(MediaKeyErrorStatus::INVALID_STATE, m_mediaKeys->decrypt(m_kKeySessionId, &m_encrypted, &m_caps));
@@ -38,7 +38,8 @@ TEST_F(RialtoServerCreateMediaPipelineTest, Create)
             std::make_unique<MediaPipelineServerInternal>(m_mediaPipelineClientMock, m_videoReq, m_gstPlayerFactoryMock,
                                                           m_kSessionId, m_sharedMemoryBufferMock, m_mainThreadFactoryMock,
                                                           m_timerFactoryMock, std::move(m_dataReaderFactory),
-                                                          std::move(m_activeRequests), m_decryptionServiceMock));
+                                                          std::move(m_activeRequests), m_decryptionServiceMock,
+                                                          m_sharedMemoryConfig));
     EXPECT_NE(m_mediaPipeline, nullptr);
 
     EXPECT_CALL(*m_sharedMemoryBufferMock, unmapPartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId))
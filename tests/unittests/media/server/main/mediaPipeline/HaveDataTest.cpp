@@ -18,9 +18,12 @@
  */
 
 #include "MediaPipelineTestBase.h"
+#include "ShmUtils.h"
 
 using ::testing::A;
 using ::testing::ByMove;
+using ::testing::IsNull;
+using ::testing::NotNull;
 using ::testing::Ref;
 using ::testing::ReturnRef;
 using ::testing::Throw;
@@ -34,11 +37,21 @@ protected:
     const std::chrono::milliseconds m_kDefaultNeedMediaDataResendTimeout{15};
     const std::chrono::milliseconds m_kLowLatencyNeedMediaDataResendTimeout{5};
 
-    RialtoServerMediaPipelineHaveDataTest() { createMediaPipeline(); }
+    explicit RialtoServerMediaPipelineHaveDataTest(bool isShmZeroCopyEnabled = false)
+    {
+        m_sharedMemoryConfig.zeroCopy = isShmZeroCopyEnabled;
+        createMediaPipeline();
+    }
 
     ~RialtoServerMediaPipelineHaveDataTest() { destroyMediaPipeline(); }
 };
 
+class RialtoServerMediaPipelineHaveDataZeroCopyTest : public RialtoServerMediaPipelineHaveDataTest
+{
+protected:
+    RialtoServerMediaPipelineHaveDataZeroCopyTest() : RialtoServerMediaPipelineHaveDataTest{true} {}
+};
+
 TEST_F(RialtoServerMediaPipelineHaveDataTest, CommonHaveDataFailureDueToUninitializedPlayer)
 {
     auto status = firebolt::rialto::MediaSourceStatus::OK;
@@ -290,6 +303,7 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessWithR
     EXPECT_CALL(*m_sharedMemoryBufferMock,
                 clearData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
         .WillOnce(Return(true));
+    EXPECT_CALL(*m_gstPlayerMock, getQueuedDuration(mediaSourceType, _)).WillOnce(Return(false));
     EXPECT_CALL(*m_sharedMemoryBufferMock,
                 getMaxDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, mediaSourceType))
         .WillOnce(Return(7 * 1024 * 1024));
@@ -358,7 +372,8 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataFailureDueTo
                                                          firebolt::rialto::MediaSourceType::VIDEO))
         .WillOnce(Return(offset));
     EXPECT_CALL(*m_dataReaderFactoryMock,
-                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kNumFrames, m_kIsBufferFull))
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, offset + getMaxMetadataBytes(),
+                                 m_kNumFrames, m_kIsBufferFull))
         .WillOnce(Return(dataReader));
     EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::FAILURE));
     EXPECT_FALSE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
@@ -382,9 +397,10 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccess)
                                                          firebolt::rialto::MediaSourceType::VIDEO))
         .WillOnce(Return(offset));
     EXPECT_CALL(*m_dataReaderFactoryMock,
-                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kNumFrames, m_kIsBufferFull))
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, offset + getMaxMetadataBytes(),
+                                 m_kNumFrames, m_kIsBufferFull))
         .WillOnce(Return(dataReader));
-    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader));
+    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader, IsNull()));
     EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
 }
 
@@ -406,9 +422,10 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessWithS
                                                          firebolt::rialto::MediaSourceType::VIDEO))
         .WillOnce(Return(offset));
     EXPECT_CALL(*m_dataReaderFactoryMock,
-                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kNumFrames, m_kIsBufferFull))
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, offset + getMaxMetadataBytes(),
+                                 m_kNumFrames, m_kIsBufferFull))
         .WillOnce(Return(dataReader));
-    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader));
+    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader, IsNull()));
     EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
 }
 
@@ -431,10 +448,11 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest,
     EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
                                                          firebolt::rialto::MediaSourceType::VIDEO))
         .WillOnce(Return(offset));
-    EXPECT_CALL(*m_dataReaderFactoryMock, createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset,
-                                                           m_kNumFrames, kBufferIsNotFull))
+    EXPECT_CALL(*m_dataReaderFactoryMock,
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, offset + getMaxMetadataBytes(),
+                                 m_kNumFrames, kBufferIsNotFull))
         .WillOnce(Return(dataReader));
-    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader));
+    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader, IsNull()));
     EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
 }
 
@@ -456,9 +474,10 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataAudioSuccess
                                                          firebolt::rialto::MediaSourceType::AUDIO))
         .WillOnce(Return(offset));
     EXPECT_CALL(*m_dataReaderFactoryMock,
-                createDataReader(firebolt::rialto::MediaSourceType::AUDIO, &data, offset, m_kNumFrames, m_kIsBufferFull))
+                createDataReader(firebolt::rialto::MediaSourceType::AUDIO, &data, offset, offset + getMaxMetadataBytes(),
+                                 m_kNumFrames, m_kIsBufferFull))
         .WillOnce(Return(dataReader));
-    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader));
+    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader, IsNull()));
     EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
 }
 
@@ -480,9 +499,10 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessWithE
                                                          firebolt::rialto::MediaSourceType::VIDEO))
         .WillOnce(Return(offset));
     EXPECT_CALL(*m_dataReaderFactoryMock,
-                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, m_kNumFrames, m_kIsBufferFull))
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, offset + getMaxMetadataBytes(),
+                                 m_kNumFrames, m_kIsBufferFull))
         .WillOnce(Return(dataReader));
-    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader));
+    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader, IsNull()));
     EXPECT_CALL(*m_gstPlayerMock, setEos(firebolt::rialto::MediaSourceType::VIDEO));
     EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
 }
@@ -506,3 +526,138 @@ TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataSuccessEosWi
     EXPECT_CALL(*m_gstPlayerMock, setEos(firebolt::rialto::MediaSourceType::VIDEO));
     EXPECT_TRUE(m_mediaPipeline->haveData(status, 0, m_kNeedDataRequestId));
 }
+
+TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataNoSpaceWithoutFramesSchedulesNeedMediaDataResend)
+{
+    auto status = firebolt::rialto::MediaSourceStatus::NO_SPACE_FOR_SAMPLES;
+    auto mediaSourceType = firebolt::rialto::MediaSourceType::VIDEO;
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+    ASSERT_TRUE(m_activeRequestsMock);
+    EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId)).WillOnce(Return(mediaSourceType));
+    EXPECT_CALL(*m_activeRequestsMock, getMaxFrames(m_kNeedDataRequestId)).WillOnce(Return(m_kNumFrames));
+    EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).Times(0);
+    EXPECT_CALL(*m_timerMock, isActive()).WillOnce(Return(true));
+    EXPECT_CALL(*m_timerMock, cancel());
+    EXPECT_CALL(*m_timerFactoryMock, createTimer(m_kDefaultNeedMediaDataResendTimeout, _, _))
+        .WillOnce(Return(ByMove(std::move(m_timerMock))));
+    EXPECT_TRUE(m_mediaPipeline->haveData(status, 0, m_kNeedDataRequestId));
+}
+
+TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataMultiFailureDueToUninitializedPlayer)
+{
+    mainThreadWillEnqueueTaskAndWait();
+    std::vector<bool> results;
+    EXPECT_FALSE(m_mediaPipeline->haveDataMulti(
+        {{firebolt::rialto::MediaSourceStatus::OK, m_kNumFrames, m_kNeedDataRequestId}}, results));
+}
+
+TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataMultiSuccess)
+{
+    const std::uint32_t kAudioRequestId{m_kNeedDataRequestId + 1};
+    std::uint8_t data{123};
+    int offset = 0;
+    std::shared_ptr<IDataReader> dataReader{std::make_shared<DataReaderMock>()};
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+    ASSERT_TRUE(m_activeRequestsMock);
+    EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
+        .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getMaxFrames(m_kNeedDataRequestId)).WillOnce(Return(m_kNumFrames));
+    EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
+    EXPECT_CALL(*m_activeRequestsMock, getType(kAudioRequestId))
+        .WillOnce(Return(firebolt::rialto::MediaSourceType::AUDIO));
+    EXPECT_CALL(*m_activeRequestsMock, getMaxFrames(kAudioRequestId)).WillOnce(Return(m_kNumFrames));
+    EXPECT_CALL(*m_activeRequestsMock, erase(kAudioRequestId));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillRepeatedly(Return(&data));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                                         firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                                         firebolt::rialto::MediaSourceType::AUDIO))
+        .WillOnce(Return(offset));
+    EXPECT_CALL(*m_dataReaderFactoryMock,
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, offset + getMaxMetadataBytes(),
+                                 m_kNumFrames, m_kIsBufferFull))
+        .WillOnce(Return(dataReader));
+    EXPECT_CALL(*m_gstPlayerMock, attachSamples(A<const std::vector<IGstGenericPlayer::ShmSamples> &>()));
+    EXPECT_CALL(*m_gstPlayerMock, setEos(firebolt::rialto::MediaSourceType::AUDIO));
+    std::vector<bool> results;
+    EXPECT_TRUE(m_mediaPipeline->haveDataMulti({{firebolt::rialto::MediaSourceStatus::OK, m_kNumFrames,
+                                                 m_kNeedDataRequestId},
+                                                {firebolt::rialto::MediaSourceStatus::EOS, 0, kAudioRequestId}},
+                                               results));
+    EXPECT_EQ(results, (std::vector<bool>{true, true}));
+}
+
+TEST_F(RialtoServerMediaPipelineHaveDataTest, ServerInternalHaveDataMultiReportsTheResultOfEachRequest)
+{
+    const std::uint32_t kAudioRequestId{m_kNeedDataRequestId + 1};
+    std::uint8_t data{123};
+    int offset = 0;
+    std::shared_ptr<IDataReader> dataReader;
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+    mainThreadWillEnqueueTask();
+    ASSERT_TRUE(m_activeRequestsMock);
+    EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
+        .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getMaxFrames(m_kNeedDataRequestId)).WillOnce(Return(m_kNumFrames));
+    EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
+    EXPECT_CALL(*m_activeRequestsMock, getType(kAudioRequestId))
+        .WillOnce(Return(firebolt::rialto::MediaSourceType::AUDIO));
+    EXPECT_CALL(*m_activeRequestsMock, getMaxFrames(kAudioRequestId)).WillOnce(Return(m_kNumFrames));
+    EXPECT_CALL(*m_activeRequestsMock, erase(kAudioRequestId));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillRepeatedly(Return(&data));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                                         firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                                         firebolt::rialto::MediaSourceType::AUDIO))
+        .WillOnce(Return(offset));
+    EXPECT_CALL(*m_dataReaderFactoryMock,
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, &data, offset, offset + getMaxMetadataBytes(),
+                                 m_kNumFrames, m_kIsBufferFull))
+        .WillOnce(Return(dataReader));
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifyPlaybackState(PlaybackState::FAILURE));
+    EXPECT_CALL(*m_gstPlayerMock, setEos(firebolt::rialto::MediaSourceType::AUDIO));
+    std::vector<bool> results;
+    EXPECT_TRUE(m_mediaPipeline->haveDataMulti({{firebolt::rialto::MediaSourceStatus::OK, m_kNumFrames,
+                                                 m_kNeedDataRequestId},
+                                                {firebolt::rialto::MediaSourceStatus::EOS, 0, kAudioRequestId}},
+                                               results));
+    EXPECT_EQ(results, (std::vector<bool>{false, true}));
+}
+
+TEST_F(RialtoServerMediaPipelineHaveDataZeroCopyTest, ServerInternalHaveDataLendsShmBlocksToGstreamer)
+{
+    constexpr std::uint32_t kMaxDataLen{getMaxMetadataBytes() + 1024};
+    auto status = firebolt::rialto::MediaSourceStatus::OK;
+    std::vector<std::uint8_t> data(kMaxDataLen);
+    int offset = 0;
+    std::shared_ptr<IDataReader> dataReader{std::make_shared<DataReaderMock>()};
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+    ASSERT_TRUE(m_activeRequestsMock);
+    EXPECT_CALL(*m_activeRequestsMock, getType(m_kNeedDataRequestId))
+        .WillOnce(Return(firebolt::rialto::MediaSourceType::VIDEO));
+    EXPECT_CALL(*m_activeRequestsMock, getMaxFrames(m_kNeedDataRequestId)).WillOnce(Return(m_kNumFrames));
+    EXPECT_CALL(*m_activeRequestsMock, erase(m_kNeedDataRequestId));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(data.data()));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                                         firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(offset));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getDataPtr(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                                      firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(data.data()));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getMaxDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                                         firebolt::rialto::MediaSourceType::VIDEO))
+        .WillOnce(Return(kMaxDataLen));
+    EXPECT_CALL(*m_dataReaderFactoryMock,
+                createDataReader(firebolt::rialto::MediaSourceType::VIDEO, data.data(), offset,
+                                 offset + getMaxMetadataBytes(), m_kNumFrames, m_kIsBufferFull))
+        .WillOnce(Return(dataReader));
+    EXPECT_CALL(*m_gstPlayerMock, attachSamples(dataReader, NotNull()));
+    EXPECT_TRUE(m_mediaPipeline->haveData(status, m_kNumFrames, m_kNeedDataRequestId));
+}
@@ -18,8 +18,13 @@
  */
 
 #include "MediaPipelineTestBase.h"
+#include "ShmUtils.h"
 
+using ::testing::AllOf;
+using ::testing::Field;
+using ::testing::NotNull;
 using ::testing::Ref;
+using ::testing::ReturnPointee;
 
 class RialtoServerMediaPipelineSourceTest : public MediaPipelineTestBase
 {
@@ -176,6 +181,53 @@ TEST_F(RialtoServerMediaPipelineSourceTest, AllSourcesAttachedSuccess)
     loadGstPlayer();
     mainThreadWillEnqueueTaskAndWait();
 
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizePartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, _))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*m_gstPlayerMock, allSourcesAttached());
+    EXPECT_EQ(m_mediaPipeline->allSourcesAttached(), true);
+}
+
+/**
+ * Test that AllSourcesAttached sizes the shm regions for the attached sources.
+ */
+TEST_F(RialtoServerMediaPipelineSourceTest, AllSourcesAttachedResizesShmPartition)
+{
+    std::unique_ptr<IMediaPipeline::MediaSource> audioSource =
+        std::make_unique<IMediaPipeline::MediaSourceAudio>("audio/mp4", true, AudioConfig{2, 48000, {}});
+    std::unique_ptr<IMediaPipeline::MediaSource> videoSource =
+        std::make_unique<IMediaPipeline::MediaSourceVideo>("video/h264", true, 1280, 720);
+
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(audioSource)));
+    EXPECT_EQ(m_mediaPipeline->attachSource(audioSource), true);
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(videoSource)));
+    EXPECT_EQ(m_mediaPipeline->attachSource(videoSource), true);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizePartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                AllOf(Field(&ISharedMemoryBuffer::PartitionSizes::videoLen, 4 * 1024 * 1024),
+                                      Field(&ISharedMemoryBuffer::PartitionSizes::audioLen, 256 * 1024),
+                                      Field(&ISharedMemoryBuffer::PartitionSizes::subtitleLen, 0))))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*m_gstPlayerMock, allSourcesAttached());
+    EXPECT_EQ(m_mediaPipeline->allSourcesAttached(), true);
+}
+
+/**
+ * Test that AllSourcesAttached succeeds when the shm regions cannot be resized.
+ */
+TEST_F(RialtoServerMediaPipelineSourceTest, AllSourcesAttachedSuccessWhenShmPartitionResizeFails)
+{
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizePartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, _))
+        .WillOnce(Return(false));
     EXPECT_CALL(*m_gstPlayerMock, allSourcesAttached());
     EXPECT_EQ(m_mediaPipeline->allSourcesAttached(), true);
 }
@@ -197,6 +249,9 @@ TEST_F(RialtoServerMediaPipelineSourceTest, AllSourcesAttachedCalledTwiceFailure
     loadGstPlayer();
     mainThreadWillEnqueueTaskAndWait();
 
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizePartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, _))
+        .WillOnce(Return(true));
     EXPECT_CALL(*m_gstPlayerMock, allSourcesAttached());
     EXPECT_EQ(m_mediaPipeline->allSourcesAttached(), true);
 
@@ -220,6 +275,136 @@ TEST_F(RialtoServerMediaPipelineSourceTest, SwitchSourceSuccess)
     EXPECT_EQ(m_mediaPipeline->switchSource(mediaSource), true);
 }
 
+/**
+ * Test that the shm partition is resized for the caps of a switched source, once no media data is outstanding.
+ */
+TEST_F(RialtoServerMediaPipelineSourceTest, SwitchSourceResizesShmPartitionWhenNoMediaDataIsOutstanding)
+{
+    std::unique_ptr<IMediaPipeline::MediaSource> stereoSource =
+        std::make_unique<IMediaPipeline::MediaSourceAudio>("audio/mp4", true, AudioConfig{2, 48000, {}});
+    std::unique_ptr<IMediaPipeline::MediaSource> multichannelSource =
+        std::make_unique<IMediaPipeline::MediaSourceAudio>("audio/mp4", true, AudioConfig{6, 48000, {}});
+    constexpr int kNumFrames{3};
+
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(stereoSource)));
+    EXPECT_EQ(m_mediaPipeline->attachSource(stereoSource), true);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizePartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                Field(&ISharedMemoryBuffer::PartitionSizes::audioLen, 256 * 1024)))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*m_gstPlayerMock, allSourcesAttached());
+    EXPECT_EQ(m_mediaPipeline->allSourcesAttached(), true);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, switchSource(Ref(multichannelSource)));
+    EXPECT_EQ(m_mediaPipeline->switchSource(multichannelSource), true);
+
+    expectNotifyNeedData(MediaSourceType::AUDIO, stereoSource->getId(), kNumFrames);
+    EXPECT_CALL(*m_activeRequestsMock, isEmpty()).WillOnce(Return(true));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizePartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                Field(&ISharedMemoryBuffer::PartitionSizes::audioLen, 1024 * 1024)))
+        .WillOnce(Return(true));
+    m_gstPlayerCallback->notifyNeedMediaData(MediaSourceType::AUDIO);
+}
+
+/**
+ * Test that the shm partition is not resized for the caps of a switched source, while media data is outstanding.
+ */
+TEST_F(RialtoServerMediaPipelineSourceTest, SwitchSourcePostponesShmPartitionResizeWhileMediaDataIsOutstanding)
+{
+    std::unique_ptr<IMediaPipeline::MediaSource> stereoSource =
+        std::make_unique<IMediaPipeline::MediaSourceAudio>("audio/mp4", true, AudioConfig{2, 48000, {}});
+    std::unique_ptr<IMediaPipeline::MediaSource> multichannelSource =
+        std::make_unique<IMediaPipeline::MediaSourceAudio>("audio/mp4", true, AudioConfig{6, 48000, {}});
+    constexpr int kNumFrames{3};
+
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(stereoSource)));
+    EXPECT_EQ(m_mediaPipeline->attachSource(stereoSource), true);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizePartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, _))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*m_gstPlayerMock, allSourcesAttached());
+    EXPECT_EQ(m_mediaPipeline->allSourcesAttached(), true);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, switchSource(Ref(multichannelSource)));
+    EXPECT_EQ(m_mediaPipeline->switchSource(multichannelSource), true);
+
+    expectNotifyNeedData(MediaSourceType::AUDIO, stereoSource->getId(), kNumFrames);
+    EXPECT_CALL(*m_activeRequestsMock, isEmpty()).WillOnce(Return(false));
+    m_gstPlayerCallback->notifyNeedMediaData(MediaSourceType::AUDIO);
+}
+
+/**
+ * Test that the shm partition is not resized for the caps of a switched source, until the worker thread has read the
+ * samples attached from it.
+ */
+TEST_F(RialtoServerMediaPipelineSourceTest, SwitchSourcePostponesShmPartitionResizeUntilAttachedSamplesAreRead)
+{
+    std::unique_ptr<IMediaPipeline::MediaSource> stereoSource =
+        std::make_unique<IMediaPipeline::MediaSourceAudio>("audio/mp4", true, AudioConfig{2, 48000, {}});
+    std::unique_ptr<IMediaPipeline::MediaSource> multichannelSource =
+        std::make_unique<IMediaPipeline::MediaSourceAudio>("audio/mp4", true, AudioConfig{6, 48000, {}});
+    constexpr int kNumFrames{3};
+    constexpr std::uint32_t kNeedDataRequestId{0};
+    std::uint8_t data{123};
+    std::shared_ptr<IDataReader> dataReader{std::make_shared<DataReaderMock>()};
+
+    loadGstPlayer();
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, attachSource(Ref(stereoSource)));
+    EXPECT_EQ(m_mediaPipeline->attachSource(stereoSource), true);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizePartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, _))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*m_gstPlayerMock, allSourcesAttached());
+    EXPECT_EQ(m_mediaPipeline->allSourcesAttached(), true);
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, switchSource(Ref(multichannelSource)));
+    EXPECT_EQ(m_mediaPipeline->switchSource(multichannelSource), true);
+
+    // The samples are attached, but the worker thread still holds their reader
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_activeRequestsMock, getType(kNeedDataRequestId)).WillOnce(Return(MediaSourceType::AUDIO));
+    EXPECT_CALL(*m_activeRequestsMock, getMaxFrames(kNeedDataRequestId)).WillOnce(Return(kNumFrames));
+    EXPECT_CALL(*m_activeRequestsMock, erase(kNeedDataRequestId));
+    EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(&data));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                getDataOffset(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, MediaSourceType::AUDIO))
+        .WillOnce(Return(0));
+    EXPECT_CALL(*m_dataReaderFactoryMock, createDataReader(MediaSourceType::AUDIO, &data, 0, getMaxMetadataBytes(),
+                                                           kNumFrames, true))
+        .WillOnce(ReturnPointee(&dataReader));
+    EXPECT_CALL(*m_gstPlayerMock, attachSamples(NotNull(), _));
+    EXPECT_TRUE(m_mediaPipeline->haveData(MediaSourceStatus::OK, kNumFrames, kNeedDataRequestId));
+
+    expectNotifyNeedData(MediaSourceType::AUDIO, stereoSource->getId(), kNumFrames);
+    EXPECT_CALL(*m_activeRequestsMock, isEmpty()).WillOnce(Return(true));
+    m_gstPlayerCallback->notifyNeedMediaData(MediaSourceType::AUDIO);
+
+    // The worker thread has read the samples and released their reader. The expectations hold no copy of it.
+    dataReader.reset();
+    expectNotifyNeedData(MediaSourceType::AUDIO, stereoSource->getId(), kNumFrames);
+    EXPECT_CALL(*m_activeRequestsMock, isEmpty()).WillOnce(Return(true));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                resizePartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId,
+                                Field(&ISharedMemoryBuffer::PartitionSizes::audioLen, 1024 * 1024)))
+        .WillOnce(Return(true));
+    m_gstPlayerCallback->notifyNeedMediaData(MediaSourceType::AUDIO);
+}
+
 /**
  * Test that SwitchSource fails if load has not been called (no gstreamer player).
  */
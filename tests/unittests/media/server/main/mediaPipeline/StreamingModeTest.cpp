@@ -0,0 +1,249 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "MediaPipelineTestBase.h"
+#include "ShmRing.h"
+#include <functional>
+#include <utility>
+#include <vector>
+
+using ::testing::SetArgReferee;
+
+namespace
+{
+constexpr std::uint32_t kRingCapacity{4096};
+constexpr int kDoorbellFd{42};
+} // namespace
+
+class RialtoServerMediaPipelineStreamingModeTest : public MediaPipelineTestBase
+{
+protected:
+    const MediaSourceType m_kType{MediaSourceType::VIDEO};
+    const ISharedMemoryBuffer::StreamingRing m_kRing{kDoorbellFd, 0, kRingCapacity};
+    std::vector<std::uint8_t> m_buffer;
+    std::function<void()> m_doorbellCallback;
+    int32_t m_sourceId{-1};
+    bool m_isStreaming{false};
+
+    RialtoServerMediaPipelineStreamingModeTest()
+        : m_buffer(firebolt::rialto::ipc::ShmRing::regionSize(kRingCapacity), 0)
+    {
+        createMediaPipeline();
+    }
+
+    ~RialtoServerMediaPipelineStreamingModeTest()
+    {
+        if (m_isStreaming)
+        {
+            EXPECT_CALL(*m_sharedMemoryBufferMock,
+                        disableStreamingMode(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, m_kType))
+                .WillOnce(Return(true));
+        }
+        destroyMediaPipeline();
+    }
+
+    void attachAllSources()
+    {
+        loadGstPlayer();
+        m_sourceId = attachSource(m_kType, "video/mp4");
+
+        mainThreadWillEnqueueTaskAndWait();
+        EXPECT_CALL(*m_sharedMemoryBufferMock,
+                    resizePartition(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, _))
+            .WillOnce(Return(true));
+        EXPECT_CALL(*m_gstPlayerMock, allSourcesAttached());
+        EXPECT_TRUE(m_mediaPipeline->allSourcesAttached());
+    }
+
+    void shmBufferWillEnableStreamingMode()
+    {
+        EXPECT_CALL(*m_activeRequestsMock, erase(m_kType));
+        EXPECT_CALL(*m_sharedMemoryBufferMock,
+                    enableStreamingMode(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, m_kType, _, _))
+            .WillOnce(Invoke(
+                [&](auto, auto, auto, std::function<void()> &&doorbellCallback, ISharedMemoryBuffer::StreamingRing &ring)
+                {
+                    m_doorbellCallback = std::move(doorbellCallback);
+                    ring = m_kRing;
+                    return true;
+                }));
+        EXPECT_CALL(*m_sharedMemoryBufferMock, getBuffer()).WillOnce(Return(m_buffer.data()));
+    }
+
+    void enableStreamingRing()
+    {
+        firebolt::rialto::ipc::ShmRing consumer;
+        ASSERT_TRUE(consumer.init(m_buffer.data(), kRingCapacity));
+
+        mainThreadWillEnqueueTaskAndWait();
+        shmBufferWillEnableStreamingMode();
+        EXPECT_CALL(*m_gstPlayerMock, drainShmRing(_));
+
+        ISharedMemoryBuffer::StreamingRing ring{};
+        EXPECT_TRUE(m_mediaPipeline->enableStreamingRing(m_sourceId, ring));
+        EXPECT_EQ(ring.doorbellFd, m_kRing.doorbellFd);
+        EXPECT_EQ(ring.offset, m_kRing.offset);
+        EXPECT_EQ(ring.capacity, m_kRing.capacity);
+        m_isStreaming = true;
+    }
+};
+
+/**
+ * Test that a source can be switched to streaming mode and that its ring is drained straight away.
+ */
+TEST_F(RialtoServerMediaPipelineStreamingModeTest, EnableStreamingRingSuccess)
+{
+    attachAllSources();
+    enableStreamingRing();
+}
+
+/**
+ * Test that streaming mode cannot be enabled before all sources are attached.
+ */
+TEST_F(RialtoServerMediaPipelineStreamingModeTest, EnableStreamingRingBeforeAllSourcesAttachedFailure)
+{
+    loadGstPlayer();
+    m_sourceId = attachSource(m_kType, "video/mp4");
+
+    mainThreadWillEnqueueTaskAndWait();
+    ISharedMemoryBuffer::StreamingRing ring{};
+    EXPECT_FALSE(m_mediaPipeline->enableStreamingRing(m_sourceId, ring));
+}
+
+/**
+ * Test that streaming mode cannot be enabled for an unknown source.
+ */
+TEST_F(RialtoServerMediaPipelineStreamingModeTest, EnableStreamingRingNoSourcePresentFailure)
+{
+    attachAllSources();
+
+    mainThreadWillEnqueueTaskAndWait();
+    ISharedMemoryBuffer::StreamingRing ring{};
+    EXPECT_FALSE(m_mediaPipeline->enableStreamingRing(m_sourceId + 1, ring));
+}
+
+/**
+ * Test that streaming mode cannot be enabled twice for the same source.
+ */
+TEST_F(RialtoServerMediaPipelineStreamingModeTest, EnableStreamingRingTwiceFailure)
+{
+    attachAllSources();
+    enableStreamingRing();
+
+    mainThreadWillEnqueueTaskAndWait();
+    ISharedMemoryBuffer::StreamingRing ring{};
+    EXPECT_FALSE(m_mediaPipeline->enableStreamingRing(m_sourceId, ring));
+}
+
+/**
+ * Test that enabling streaming mode fails, if the shm buffer cannot format the region as a ring.
+ */
+TEST_F(RialtoServerMediaPipelineStreamingModeTest, EnableStreamingRingShmBufferFailure)
+{
+    attachAllSources();
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_activeRequestsMock, erase(m_kType));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                enableStreamingMode(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, m_kType, _, _))
+        .WillOnce(Return(false));
+    ISharedMemoryBuffer::StreamingRing ring{};
+    EXPECT_FALSE(m_mediaPipeline->enableStreamingRing(m_sourceId, ring));
+}
+
+/**
+ * Test that streaming mode is disabled again, if the ring cannot be read.
+ */
+TEST_F(RialtoServerMediaPipelineStreamingModeTest, EnableStreamingRingInvalidRingFailure)
+{
+    attachAllSources();
+
+    // The region is not formatted as a ring
+    mainThreadWillEnqueueTaskAndWait();
+    shmBufferWillEnableStreamingMode();
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                disableStreamingMode(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, m_kType))
+        .WillOnce(Return(true));
+    ISharedMemoryBuffer::StreamingRing ring{};
+    EXPECT_FALSE(m_mediaPipeline->enableStreamingRing(m_sourceId, ring));
+}
+
+/**
+ * Test that the ring is drained, instead of sending NeedMediaData, when gstreamer needs data.
+ */
+TEST_F(RialtoServerMediaPipelineStreamingModeTest, NeedMediaDataDrainsRing)
+{
+    attachAllSources();
+    enableStreamingRing();
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, drainShmRing(_));
+    EXPECT_FALSE(m_gstPlayerCallback->notifyNeedMediaData(m_kType));
+}
+
+/**
+ * Test that the ring is drained, when the client rings the doorbell.
+ */
+TEST_F(RialtoServerMediaPipelineStreamingModeTest, DoorbellDrainsRing)
+{
+    attachAllSources();
+    enableStreamingRing();
+    ASSERT_TRUE(m_doorbellCallback);
+
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(*m_gstPlayerMock, drainShmRing(_));
+    m_doorbellCallback();
+}
+
+/**
+ * Test that the ring is drained again, once the flushed source is flushed.
+ */
+TEST_F(RialtoServerMediaPipelineStreamingModeTest, FlushedSourceDrainsRing)
+{
+    attachAllSources();
+    enableStreamingRing();
+
+    bool async{false};
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, flush(m_kType, true, async));
+    EXPECT_TRUE(m_mediaPipeline->flush(m_sourceId, true, async));
+
+    mainThreadWillEnqueueTask();
+    EXPECT_CALL(*m_mediaPipelineClientMock, notifySourceFlushed(m_sourceId));
+    EXPECT_CALL(*m_gstPlayerMock, drainShmRing(_));
+    m_gstPlayerCallback->notifySourceFlushed(m_kType);
+}
+
+/**
+ * Test that streaming mode is disabled, when the source is removed.
+ */
+TEST_F(RialtoServerMediaPipelineStreamingModeTest, RemoveSourceDisablesStreamingMode)
+{
+    attachAllSources();
+    enableStreamingRing();
+
+    mainThreadWillEnqueueTaskAndWait();
+    EXPECT_CALL(*m_gstPlayerMock, removeSource(m_kType));
+    EXPECT_CALL(*m_sharedMemoryBufferMock,
+                disableStreamingMode(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, m_kType))
+        .WillOnce(Return(true));
+    EXPECT_TRUE(m_mediaPipeline->removeSource(m_sourceId));
+    m_isStreaming = false;
+}
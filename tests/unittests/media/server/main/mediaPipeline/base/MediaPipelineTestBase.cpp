@@ -53,7 +53,8 @@ void MediaPipelineTestBase::createMediaPipeline()
             std::make_unique<MediaPipelineServerInternal>(m_mediaPipelineClientMock, m_videoReq, m_gstPlayerFactoryMock,
                                                           m_kSessionId, m_sharedMemoryBufferMock, m_mainThreadFactoryMock,
                                                           m_timerFactoryMock, std::move(m_dataReaderFactory),
-                                                          std::move(m_activeRequests), m_decryptionServiceMock));
+                                                          std::move(m_activeRequests), m_decryptionServiceMock,
+                                                          m_sharedMemoryConfig));
     EXPECT_NE(m_mediaPipeline, nullptr);
 }
 
@@ -137,6 +138,7 @@ void MediaPipelineTestBase::expectNotifyNeedData(MediaSourceType sourceType, int
     EXPECT_CALL(*m_sharedMemoryBufferMock,
                 clearData(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, sourceType))
         .WillOnce(Return(true));
+    EXPECT_CALL(*m_gstPlayerMock, getQueuedDuration(sourceType, _)).WillOnce(Return(false));
     EXPECT_CALL(*m_sharedMemoryBufferMock,
                 getMaxDataLen(ISharedMemoryBuffer::MediaPlaybackType::GENERIC, m_kSessionId, sourceType))
         .WillOnce(Return(7 * 1024 * 1024));
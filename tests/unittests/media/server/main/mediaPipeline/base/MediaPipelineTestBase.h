@@ -79,6 +79,7 @@ protected:
     std::shared_ptr<StrictMock<TimerFactoryMock>> m_timerFactoryMock;
     std::unique_ptr<StrictMock<TimerMock>> m_timerMock;
     StrictMock<DecryptionServiceMock> m_decryptionServiceMock;
+    firebolt::rialto::common::SharedMemoryConfig m_sharedMemoryConfig;
     IGstGenericPlayerClient *m_gstPlayerCallback;
 
     // Common variables
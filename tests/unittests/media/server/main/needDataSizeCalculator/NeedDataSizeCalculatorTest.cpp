@@ -0,0 +1,208 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NeedDataSizeCalculator.h"
+#include "ShmUtils.h"
+#include <gtest/gtest.h>
+
+using firebolt::rialto::MediaSourceType;
+using firebolt::rialto::server::kMaxFrames;
+using firebolt::rialto::server::kMaxFramesWithInlineMetadata;
+using firebolt::rialto::server::kPrerollNumFrames;
+using firebolt::rialto::server::NeedDataSize;
+using firebolt::rialto::server::NeedDataSizeCalculator;
+using firebolt::rialto::server::NeedDataSizeStats;
+
+namespace
+{
+constexpr std::uint32_t kAvailableBytes{1024 * 1024};
+constexpr std::uint32_t kFrameBytes{1000};
+constexpr std::uint32_t kFrameBytesWithHeadroom{1500};
+constexpr std::uint32_t kMetadataV1{1};
+constexpr std::uint32_t kMetadataV3{3};
+constexpr std::int64_t kShortQueuedDuration{500000000};
+constexpr std::int64_t kLongQueuedDuration{3000000000};
+} // namespace
+
+TEST(NeedDataSizeCalculatorTest, ShouldReturnDefaultSizeWhenNothingIsKnown)
+{
+    NeedDataSizeCalculator calculator;
+    NeedDataSize size{calculator.calculateNeedDataSize(MediaSourceType::VIDEO, false, kAvailableBytes)};
+    EXPECT_EQ(size.frameCount, kMaxFrames);
+    EXPECT_EQ(size.maxMediaBytes, kAvailableBytes);
+
+    size = calculator.calculateNeedDataSize(MediaSourceType::VIDEO, true, kAvailableBytes);
+    EXPECT_EQ(size.frameCount, kPrerollNumFrames);
+    EXPECT_EQ(size.maxMediaBytes, kAvailableBytes);
+}
+
+TEST(NeedDataSizeCalculatorTest, ShouldReturnPrerollSizeWhenFrameSizeIsKnown)
+{
+    NeedDataSizeCalculator calculator;
+    calculator.onDataReceived(MediaSourceType::VIDEO, 10, 10 * kFrameBytes, kMetadataV3);
+    const NeedDataSize kSize{calculator.calculateNeedDataSize(MediaSourceType::VIDEO, true, kAvailableBytes)};
+    EXPECT_EQ(kSize.frameCount, kPrerollNumFrames);
+    EXPECT_EQ(kSize.maxMediaBytes, kAvailableBytes);
+}
+
+TEST(NeedDataSizeCalculatorTest, ShouldRequestMoreFramesWithInlineMetadata)
+{
+    NeedDataSizeCalculator calculator;
+    calculator.onDataReceived(MediaSourceType::AUDIO, 10, 10 * kFrameBytes, kMetadataV3);
+    const NeedDataSize kSize{calculator.calculateNeedDataSize(MediaSourceType::AUDIO, false, kAvailableBytes)};
+    EXPECT_EQ(kSize.frameCount, kMaxFramesWithInlineMetadata);
+    EXPECT_EQ(kSize.maxMediaBytes, kMaxFramesWithInlineMetadata * kFrameBytesWithHeadroom);
+}
+
+TEST(NeedDataSizeCalculatorTest, ShouldNotExceedMaxFramesWithMetadataV1)
+{
+    NeedDataSizeCalculator calculator;
+    calculator.onDataReceived(MediaSourceType::AUDIO, 10, 10 * kFrameBytes, kMetadataV1);
+    const NeedDataSize kSize{calculator.calculateNeedDataSize(MediaSourceType::AUDIO, false, kAvailableBytes)};
+    EXPECT_EQ(kSize.frameCount, kMaxFrames);
+    EXPECT_EQ(kSize.maxMediaBytes, kMaxFrames * kFrameBytesWithHeadroom);
+}
+
+TEST(NeedDataSizeCalculatorTest, ShouldFitFramesInAvailableBytes)
+{
+    NeedDataSizeCalculator calculator;
+    calculator.onDataReceived(MediaSourceType::VIDEO, 1, 10000, kMetadataV3);
+    const NeedDataSize kSize{calculator.calculateNeedDataSize(MediaSourceType::VIDEO, false, 600000)};
+    EXPECT_EQ(kSize.frameCount, 40);
+    EXPECT_EQ(kSize.maxMediaBytes, 600000);
+}
+
+TEST(NeedDataSizeCalculatorTest, ShouldShrinkBudgetForSmallAudioFrames)
+{
+    constexpr std::uint32_t kAudioFrameBytes{200};
+    NeedDataSizeCalculator calculator;
+    NeedDataSize size{calculator.calculateNeedDataSize(MediaSourceType::AUDIO, false, kAvailableBytes)};
+    EXPECT_EQ(size.maxMediaBytes, kAvailableBytes);
+
+    calculator.onDataReceived(MediaSourceType::AUDIO, kMaxFrames, kMaxFrames * kAudioFrameBytes, kMetadataV3);
+    size = calculator.calculateNeedDataSize(MediaSourceType::AUDIO, false, kAvailableBytes);
+    EXPECT_EQ(size.frameCount, kMaxFramesWithInlineMetadata);
+    EXPECT_EQ(size.maxMediaBytes, kMaxFramesWithInlineMetadata * kAudioFrameBytes * 3 / 2);
+    EXPECT_LT(size.maxMediaBytes, kAvailableBytes / 10);
+}
+
+TEST(NeedDataSizeCalculatorTest, ShouldCapBudgetAtAvailableBytes)
+{
+    NeedDataSizeCalculator calculator;
+    calculator.onDataReceived(MediaSourceType::VIDEO, 1, 100000, kMetadataV3);
+    const NeedDataSize kSize{calculator.calculateNeedDataSize(MediaSourceType::VIDEO, false, 1000000)};
+    EXPECT_EQ(kSize.frameCount, kMaxFrames);
+    EXPECT_EQ(kSize.maxMediaBytes, 1000000);
+}
+
+TEST(NeedDataSizeCalculatorTest, ShouldUseAllAvailableBytesAfterFrameDidNotFit)
+{
+    NeedDataSizeCalculator calculator;
+    calculator.onDataReceived(MediaSourceType::VIDEO, 100, 100 * kFrameBytes, kMetadataV3);
+    NeedDataSize size{calculator.calculateNeedDataSize(MediaSourceType::VIDEO, false, kAvailableBytes)};
+    EXPECT_EQ(size.maxMediaBytes, kMaxFramesWithInlineMetadata * kFrameBytesWithHeadroom);
+
+    // A key frame larger than the budget could not be written
+    calculator.onNoSpaceForSamples(MediaSourceType::VIDEO);
+    size = calculator.calculateNeedDataSize(MediaSourceType::VIDEO, false, kAvailableBytes);
+    EXPECT_EQ(size.maxMediaBytes, kAvailableBytes);
+
+    size = calculator.calculateNeedDataSize(MediaSourceType::VIDEO, false, kAvailableBytes);
+    EXPECT_EQ(size.maxMediaBytes, kMaxFramesWithInlineMetadata * kFrameBytesWithHeadroom);
+}
+
+TEST(NeedDataSizeCalculatorTest, ShouldKeepDefaultBudgetWhenBytesAreUnknown)
+{
+    NeedDataSizeCalculator calculator;
+    calculator.onDataReceived(MediaSourceType::VIDEO, 10, 0, kMetadataV1);
+    const NeedDataSize kSize{calculator.calculateNeedDataSize(MediaSourceType::VIDEO, false, kAvailableBytes)};
+    EXPECT_EQ(kSize.frameCount, kMaxFrames);
+    EXPECT_EQ(kSize.maxMediaBytes, kAvailableBytes);
+}
+
+TEST(NeedDataSizeCalculatorTest, ShouldAverageFrameSizes)
+{
+    NeedDataSizeCalculator calculator;
+    calculator.onDataReceived(MediaSourceType::VIDEO, 1, 1000, kMetadataV3);
+    EXPECT_EQ(calculator.getStats(MediaSourceType::VIDEO).averageFrameBytes, 1000);
+    calculator.onDataReceived(MediaSourceType::VIDEO, 1, 5000, kMetadataV3);
+    EXPECT_EQ(calculator.getStats(MediaSourceType::VIDEO).averageFrameBytes, 2000);
+    EXPECT_EQ(calculator.getStats(MediaSourceType::AUDIO).averageFrameBytes, 0);
+}
+
+TEST(NeedDataSizeCalculatorTest, ShouldRequestFewerFramesWhenQueueIsLong)
+{
+    NeedDataSizeCalculator calculator;
+    calculator.onDataReceived(MediaSourceType::VIDEO, 10, 10 * kFrameBytes, kMetadataV3);
+    calculator.setQueuedDuration(MediaSourceType::VIDEO, kShortQueuedDuration);
+    EXPECT_EQ(calculator.calculateNeedDataSize(MediaSourceType::VIDEO, false, kAvailableBytes).frameCount,
+              kMaxFramesWithInlineMetadata);
+
+    calculator.setQueuedDuration(MediaSourceType::VIDEO, kLongQueuedDuration);
+    const NeedDataSize kSize{calculator.calculateNeedDataSize(MediaSourceType::VIDEO, false, kAvailableBytes)};
+    EXPECT_EQ(kSize.frameCount, kMaxFramesWithInlineMetadata / 2);
+    EXPECT_EQ(kSize.maxMediaBytes, kMaxFramesWithInlineMetadata / 2 * kFrameBytesWithHeadroom);
+
+    calculator.resetQueuedDuration(MediaSourceType::VIDEO);
+    EXPECT_EQ(calculator.calculateNeedDataSize(MediaSourceType::VIDEO, false, kAvailableBytes).frameCount,
+              kMaxFramesWithInlineMetadata);
+}
+
+TEST(NeedDataSizeCalculatorTest, ShouldApplyPlaybackRateToQueuedDuration)
+{
+    NeedDataSizeCalculator calculator;
+    calculator.onDataReceived(MediaSourceType::VIDEO, 10, 10 * kFrameBytes, kMetadataV3);
+    calculator.setQueuedDuration(MediaSourceType::VIDEO, kLongQueuedDuration);
+    calculator.setPlaybackRate(2.0);
+    EXPECT_EQ(calculator.calculateNeedDataSize(MediaSourceType::VIDEO, false, kAvailableBytes).frameCount,
+              kMaxFramesWithInlineMetadata);
+
+    calculator.setPlaybackRate(0.5);
+    calculator.setQueuedDuration(MediaSourceType::VIDEO, kShortQueuedDuration * 3);
+    EXPECT_EQ(calculator.calculateNeedDataSize(MediaSourceType::VIDEO, false, kAvailableBytes).frameCount,
+              kMaxFramesWithInlineMetadata / 2);
+}
+
+TEST(NeedDataSizeCalculatorTest, ShouldResetAllQueuedDurations)
+{
+    NeedDataSizeCalculator calculator;
+    calculator.setQueuedDuration(MediaSourceType::AUDIO, kLongQueuedDuration);
+    calculator.setQueuedDuration(MediaSourceType::VIDEO, kLongQueuedDuration);
+    calculator.resetQueuedDuration();
+    EXPECT_FALSE(calculator.getStats(MediaSourceType::AUDIO).queuedDuration.has_value());
+    EXPECT_FALSE(calculator.getStats(MediaSourceType::VIDEO).queuedDuration.has_value());
+}
+
+TEST(NeedDataSizeCalculatorTest, ShouldRecordDecisionInStats)
+{
+    NeedDataSizeCalculator calculator;
+    calculator.onDataReceived(MediaSourceType::VIDEO, 4, 4 * kFrameBytes, kMetadataV3);
+    calculator.setQueuedDuration(MediaSourceType::VIDEO, kShortQueuedDuration);
+    calculator.setPlaybackRate(1.5);
+    const NeedDataSize kSize{calculator.calculateNeedDataSize(MediaSourceType::VIDEO, false, kAvailableBytes)};
+    calculator.calculateNeedDataSize(MediaSourceType::VIDEO, false, kAvailableBytes);
+
+    const NeedDataSizeStats kStats{calculator.getStats(MediaSourceType::VIDEO)};
+    EXPECT_EQ(kStats.frameCount, kSize.frameCount);
+    EXPECT_EQ(kStats.maxMediaBytes, kSize.maxMediaBytes);
+    EXPECT_EQ(kStats.averageFrameBytes, kFrameBytes);
+    EXPECT_EQ(kStats.queuedDuration, kShortQueuedDuration);
+    EXPECT_DOUBLE_EQ(kStats.playbackRate, 1.5);
+    EXPECT_EQ(kStats.numRequests, 2);
+}
@@ -0,0 +1,109 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ActiveRequestsMock.h"
+#include "DataReaderMock.h"
+#include "NeedDataSlots.h"
+#include "ShmUtils.h"
+#include <gtest/gtest.h>
+
+using firebolt::rialto::MediaSourceType;
+using firebolt::rialto::server::getMaxMetadataBytes;
+using firebolt::rialto::server::ActiveRequestsMock;
+using firebolt::rialto::server::DataReaderMock;
+using firebolt::rialto::server::NeedDataSlots;
+using testing::Return;
+using testing::StrictMock;
+
+namespace
+{
+constexpr std::uint32_t kRegionLength{8 * 1024 * 1024};
+constexpr std::uint32_t kSmallRegionLength{getMaxMetadataBytes() + 128 * 1024};
+constexpr std::uint32_t kRequestId1{12};
+constexpr std::uint32_t kRequestId2{13};
+} // namespace
+
+class NeedDataSlotsTest : public testing::Test
+{
+protected:
+    StrictMock<ActiveRequestsMock> m_activeRequestsMock;
+};
+
+TEST_F(NeedDataSlotsTest, ShouldSplitRegionIntoAlignedSlots)
+{
+    NeedDataSlots slots{kRegionLength + 100, 2};
+    ASSERT_EQ(slots.size(), 2u);
+    EXPECT_EQ(slots.getSlot(0).offset, 0u);
+    EXPECT_EQ(slots.getSlot(0).length, kRegionLength / 2);
+    EXPECT_EQ(slots.getSlot(1).offset, kRegionLength / 2);
+    EXPECT_EQ(slots.getSlot(1).length, kRegionLength / 2);
+}
+
+TEST_F(NeedDataSlotsTest, ShouldUseFewerSlotsForSmallRegion)
+{
+    NeedDataSlots slots{kSmallRegionLength, 4};
+    ASSERT_EQ(slots.size(), 1u);
+    EXPECT_EQ(slots.getSlot(0).offset, 0u);
+    EXPECT_EQ(slots.getSlot(0).length, kSmallRegionLength);
+}
+
+TEST_F(NeedDataSlotsTest, ShouldAlwaysReuseSingleSlot)
+{
+    NeedDataSlots slots{kRegionLength, 1};
+    slots.setRequestId(0, kRequestId1);
+    EXPECT_EQ(slots.getFreeSlots(m_activeRequestsMock), std::vector<std::uint32_t>{0});
+}
+
+TEST_F(NeedDataSlotsTest, ShouldNotReturnRequestedSlot)
+{
+    NeedDataSlots slots{kRegionLength, 2};
+    EXPECT_EQ(slots.getFreeSlots(m_activeRequestsMock), (std::vector<std::uint32_t>{0, 1}));
+    slots.setRequestId(0, kRequestId1);
+
+    EXPECT_CALL(m_activeRequestsMock, getType(kRequestId1)).WillRepeatedly(Return(MediaSourceType::VIDEO));
+    EXPECT_EQ(slots.getFreeSlots(m_activeRequestsMock), std::vector<std::uint32_t>{1});
+    EXPECT_TRUE(slots.hasOutstandingRequest(m_activeRequestsMock));
+    EXPECT_EQ(slots.findSlot(kRequestId1), 0u);
+    EXPECT_FALSE(slots.findSlot(kRequestId2).has_value());
+}
+
+TEST_F(NeedDataSlotsTest, ShouldReturnSlotWhenRequestIsInvalidated)
+{
+    NeedDataSlots slots{kRegionLength, 2};
+    slots.setRequestId(0, kRequestId1);
+    slots.setRequestId(1, kRequestId2);
+
+    EXPECT_CALL(m_activeRequestsMock, getType(kRequestId1)).WillRepeatedly(Return(MediaSourceType::UNKNOWN));
+    EXPECT_CALL(m_activeRequestsMock, getType(kRequestId2)).WillRepeatedly(Return(MediaSourceType::VIDEO));
+    EXPECT_EQ(slots.getFreeSlots(m_activeRequestsMock), std::vector<std::uint32_t>{0});
+}
+
+TEST_F(NeedDataSlotsTest, ShouldReturnSlotWhenDataReaderIsReleased)
+{
+    NeedDataSlots slots{kRegionLength, 2};
+    auto dataReader{std::make_shared<StrictMock<DataReaderMock>>()};
+    slots.setRequestId(0, kRequestId1);
+    slots.setDataReader(0, dataReader);
+    EXPECT_FALSE(slots.findSlot(kRequestId1).has_value());
+    EXPECT_FALSE(slots.hasOutstandingRequest(m_activeRequestsMock));
+    EXPECT_EQ(slots.getFreeSlots(m_activeRequestsMock), std::vector<std::uint32_t>{1});
+
+    dataReader.reset();
+    EXPECT_EQ(slots.getFreeSlots(m_activeRequestsMock), (std::vector<std::uint32_t>{0, 1}));
+}
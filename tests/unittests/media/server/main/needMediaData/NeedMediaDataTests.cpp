@@ -36,3 +36,21 @@ TEST_F(NeedMediaDataTests, shouldSendMessageInPrerollingState)
     initialize(firebolt::rialto::PlaybackState::PAUSED);
     needMediaDataWillBeSentBelowPlayingState();
 }
+
+TEST_F(NeedMediaDataTests, shouldHandOutOnlyTheFreePartOfRegionWhenBlocksAreLent)
+{
+    initializeWithLentShmBlock();
+    needMediaDataWillBeSentWithFreeWriteWindow();
+}
+
+TEST_F(NeedMediaDataTests, shouldSendMessageSizedByCalculator)
+{
+    initializeWithSizeCalculator();
+    needMediaDataWillBeSentWithCalculatedSize();
+}
+
+TEST_F(NeedMediaDataTests, shouldSendMessageForSlot)
+{
+    initializeWithSlot();
+    needMediaDataWillBeSentForSlot();
+}
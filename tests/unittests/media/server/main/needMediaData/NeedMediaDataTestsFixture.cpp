@@ -18,6 +18,7 @@
  */
 
 #include "NeedMediaDataTestsFixture.h"
+#include "ShmUtils.h"
 
 using testing::_;
 using testing::Return;
@@ -33,6 +34,11 @@ constexpr int kRequestId{0};
 constexpr int kPrerollingNumFrames{3};
 constexpr int kMaxFrames{24};
 constexpr int kMaxMetadataBytes{2500};
+constexpr std::uint32_t kLentBlockSize{30};
+constexpr std::uint32_t kFrameBytes{1000};
+constexpr std::uint32_t kMetadataVersion{3};
+constexpr std::uint32_t kSlotOffset{1024 * 1024};
+constexpr std::uint32_t kSlotLength{512 * 1024};
 } // namespace
 
 namespace firebolt::rialto
@@ -76,6 +82,51 @@ void NeedMediaDataTests::initializeWithWrongType()
                                                                   kSourceId, firebolt::rialto::PlaybackState::PLAYING);
 }
 
+void NeedMediaDataTests::initializeWithLentShmBlock()
+{
+    ASSERT_TRUE(m_shmBlockTracker.lend(m_mediaData, kLentBlockSize));
+    EXPECT_CALL(shmBufferMock, getMaxDataLen(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                             kSessionId, kValidMediaSourceType))
+        .WillOnce(Return(kBufferLen));
+    EXPECT_CALL(shmBufferMock, getDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                             kSessionId, kValidMediaSourceType))
+        .WillOnce(Return(kMetadataOffset));
+    m_sut = std::make_unique<firebolt::rialto::server::NeedMediaData>(m_clientMock, activeRequestsMock, shmBufferMock,
+                                                                      kSessionId, kValidMediaSourceType, kSourceId,
+                                                                      firebolt::rialto::PlaybackState::PLAYING,
+                                                                      &m_shmBlockTracker);
+}
+
+void NeedMediaDataTests::initializeWithSizeCalculator()
+{
+    m_needDataSizeCalculator.onDataReceived(kValidMediaSourceType, 1, kFrameBytes, kMetadataVersion);
+    EXPECT_CALL(shmBufferMock, getMaxDataLen(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                             kSessionId, kValidMediaSourceType))
+        .WillOnce(Return(kBufferLen));
+    EXPECT_CALL(shmBufferMock, getDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                             kSessionId, kValidMediaSourceType))
+        .WillOnce(Return(kMetadataOffset));
+    m_sut = std::make_unique<firebolt::rialto::server::NeedMediaData>(m_clientMock, activeRequestsMock, shmBufferMock,
+                                                                      kSessionId, kValidMediaSourceType, kSourceId,
+                                                                      firebolt::rialto::PlaybackState::PLAYING,
+                                                                      nullptr, &m_needDataSizeCalculator);
+}
+
+void NeedMediaDataTests::initializeWithSlot()
+{
+    m_slot = firebolt::rialto::server::NeedDataSlots::Slot{kSlotOffset, kSlotLength};
+    EXPECT_CALL(shmBufferMock, getMaxDataLen(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                             kSessionId, kValidMediaSourceType))
+        .WillOnce(Return(kBufferLen));
+    EXPECT_CALL(shmBufferMock, getDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                             kSessionId, kValidMediaSourceType))
+        .WillOnce(Return(kMetadataOffset));
+    m_sut = std::make_unique<firebolt::rialto::server::NeedMediaData>(m_clientMock, activeRequestsMock, shmBufferMock,
+                                                                      kSessionId, kValidMediaSourceType, kSourceId,
+                                                                      firebolt::rialto::PlaybackState::PLAYING,
+                                                                      nullptr, nullptr, &m_slot);
+}
+
 void NeedMediaDataTests::needMediaDataWillBeSentInPlayingState()
 {
     std::shared_ptr<firebolt::rialto::MediaPlayerShmInfo> expectedShmInfo{
@@ -107,3 +158,51 @@ void NeedMediaDataTests::needMediaDataWillNotBeSent()
     ASSERT_TRUE(m_sut);
     EXPECT_FALSE(m_sut->send());
 }
+
+void NeedMediaDataTests::needMediaDataWillBeSentWithFreeWriteWindow()
+{
+    std::shared_ptr<firebolt::rialto::MediaPlayerShmInfo> expectedShmInfo{
+        std::make_shared<firebolt::rialto::MediaPlayerShmInfo>()};
+    expectedShmInfo->maxMetadataBytes = kMaxMetadataBytes;
+    expectedShmInfo->metadataOffset = kMetadataOffset;
+    expectedShmInfo->mediaDataOffset = kMetadataOffset + kMaxMetadataBytes + kLentBlockSize;
+    ASSERT_TRUE(m_sut);
+    EXPECT_CALL(activeRequestsMock, insert(kValidMediaSourceType, sizeof(m_mediaData) - kLentBlockSize, kMaxFrames))
+        .WillOnce(Return(kRequestId));
+    EXPECT_CALL(*m_clientMock, notifyNeedMediaData(kSourceId, kMaxFrames, kRequestId, expectedShmInfo));
+    EXPECT_TRUE(m_sut->send());
+}
+
+void NeedMediaDataTests::needMediaDataWillBeSentWithCalculatedSize()
+{
+    const firebolt::rialto::server::NeedDataSize kExpectedSize{firebolt::rialto::server::kMaxFramesWithInlineMetadata,
+                                                               firebolt::rialto::server::kMaxFramesWithInlineMetadata *
+                                                                   kFrameBytes * 3 / 2};
+    std::shared_ptr<firebolt::rialto::MediaPlayerShmInfo> expectedShmInfo{
+        std::make_shared<firebolt::rialto::MediaPlayerShmInfo>()};
+    expectedShmInfo->maxMetadataBytes = kMaxMetadataBytes;
+    expectedShmInfo->metadataOffset = kMetadataOffset;
+    expectedShmInfo->mediaDataOffset = kMetadataOffset + kMaxMetadataBytes;
+    ASSERT_TRUE(m_sut);
+    EXPECT_CALL(activeRequestsMock,
+                insert(kValidMediaSourceType, kExpectedSize.maxMediaBytes, kExpectedSize.frameCount))
+        .WillOnce(Return(kRequestId));
+    EXPECT_CALL(*m_clientMock, notifyNeedMediaData(kSourceId, kExpectedSize.frameCount, kRequestId, expectedShmInfo));
+    EXPECT_TRUE(m_sut->send());
+}
+
+void NeedMediaDataTests::needMediaDataWillBeSentForSlot()
+{
+    std::shared_ptr<firebolt::rialto::MediaPlayerShmInfo> expectedShmInfo{
+        std::make_shared<firebolt::rialto::MediaPlayerShmInfo>()};
+    expectedShmInfo->maxMetadataBytes = kMaxMetadataBytes;
+    expectedShmInfo->metadataOffset = kMetadataOffset + kSlotOffset;
+    expectedShmInfo->mediaDataOffset = kMetadataOffset + kSlotOffset + kMaxMetadataBytes;
+    ASSERT_TRUE(m_sut);
+    EXPECT_CALL(activeRequestsMock, insert(kValidMediaSourceType, kSlotLength - kMaxMetadataBytes, kMaxFrames))
+        .WillOnce(Return(kRequestId));
+    EXPECT_CALL(*m_clientMock, notifyNeedMediaData(kSourceId, kMaxFrames, kRequestId, expectedShmInfo));
+    std::uint32_t requestId{kRequestId + 1};
+    EXPECT_TRUE(m_sut->send(requestId));
+    EXPECT_EQ(requestId, kRequestId);
+}
@@ -23,8 +23,10 @@
 #include "ActiveRequestsMock.h"
 #include "MediaCommon.h"
 #include "MediaPipelineClientMock.h"
+#include "NeedDataSizeCalculator.h"
 #include "NeedMediaData.h"
 #include "SharedMemoryBufferMock.h"
+#include "ShmBlockTracker.h"
 #include <gtest/gtest.h>
 #include <memory>
 
@@ -38,16 +40,26 @@ public:
 
     void initialize(firebolt::rialto::PlaybackState playbackState);
     void initializeWithWrongType();
+    void initializeWithLentShmBlock();
+    void initializeWithSizeCalculator();
+    void initializeWithSlot();
 
     void needMediaDataWillBeSentInPlayingState();
     void needMediaDataWillNotBeSent();
     void needMediaDataWillBeSentBelowPlayingState();
+    void needMediaDataWillBeSentWithFreeWriteWindow();
+    void needMediaDataWillBeSentWithCalculatedSize();
+    void needMediaDataWillBeSentForSlot();
 
 private:
     std::unique_ptr<firebolt::rialto::server::NeedMediaData> m_sut;
     std::shared_ptr<StrictMock<firebolt::rialto::MediaPipelineClientMock>> m_clientMock;
     StrictMock<firebolt::rialto::server::ActiveRequestsMock> activeRequestsMock;
     StrictMock<firebolt::rialto::server::SharedMemoryBufferMock> shmBufferMock;
+    std::uint8_t m_mediaData[100]{};
+    firebolt::rialto::server::ShmBlockTracker m_shmBlockTracker{m_mediaData, sizeof(m_mediaData)};
+    firebolt::rialto::server::NeedDataSizeCalculator m_needDataSizeCalculator;
+    firebolt::rialto::server::NeedDataSlots::Slot m_slot{};
 };
 
 #endif // NEED_MEDIA_DATA_TESTS_FIXTURE_H_
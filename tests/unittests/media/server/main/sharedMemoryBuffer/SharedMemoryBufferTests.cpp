@@ -18,6 +18,13 @@
  */
 
 #include "SharedMemoryBufferTestsFixture.h"
+#include "ShmCommon.h"
+#include "ShmRing.h"
+#include "ShmUtils.h"
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <sys/eventfd.h>
 
 TEST_F(SharedMemoryBufferTests, shouldMapGenericPlaybackSession)
 {
@@ -220,6 +227,59 @@ TEST_F(SharedMemoryBufferTests, shouldClearVideoDataForGenericPlaybackSession)
     shouldClearVideoData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
 }
 
+TEST_F(SharedMemoryBufferTests, shouldPublishNewGenerationWhenClearingGenericVideoData)
+{
+    constexpr int kSession1{0};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    uint8_t *videoData = shouldGetDataPtr(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                          kSession1, firebolt::rialto::MediaSourceType::VIDEO);
+    ASSERT_NE(nullptr, videoData);
+
+    shouldClearVideoData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    firebolt::rialto::common::ShmRegionHeader firstHeader{};
+    std::memcpy(&firstHeader, videoData + firebolt::rialto::common::SHM_REGION_HEADER_OFFSET, sizeof(firstHeader));
+    EXPECT_EQ(firebolt::rialto::common::SHM_REGION_HEADER_MAGIC, firstHeader.magic);
+    EXPECT_NE(0U, firstHeader.generation);
+    EXPECT_EQ(0U, firstHeader.committedGeneration);
+    EXPECT_EQ(0U, firstHeader.numFrames);
+    EXPECT_EQ(firebolt::rialto::common::SHM_REGION_METADATA_VERSION_TAG | 3U, firstHeader.metadataVersion);
+
+    shouldClearVideoData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    firebolt::rialto::common::ShmRegionHeader secondHeader{};
+    std::memcpy(&secondHeader, videoData + firebolt::rialto::common::SHM_REGION_HEADER_OFFSET, sizeof(secondHeader));
+    EXPECT_EQ(firebolt::rialto::common::SHM_REGION_HEADER_MAGIC, secondHeader.magic);
+    EXPECT_EQ(firstHeader.generation + 1, secondHeader.generation);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldPublishNewGenerationWhenClearingGenericVideoDataAtOffset)
+{
+    constexpr int kSession1{0};
+    constexpr std::uint32_t kOffset{64 * 1024};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    uint8_t *videoData = shouldGetDataPtr(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                          kSession1, firebolt::rialto::MediaSourceType::VIDEO);
+    ASSERT_NE(nullptr, videoData);
+
+    shouldClearVideoDataAtOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1,
+                                 kOffset);
+    firebolt::rialto::common::ShmRegionHeader header{};
+    std::memcpy(&header, videoData + kOffset + firebolt::rialto::common::SHM_REGION_HEADER_OFFSET, sizeof(header));
+    EXPECT_EQ(firebolt::rialto::common::SHM_REGION_HEADER_MAGIC, header.magic);
+    EXPECT_NE(0U, header.generation);
+    EXPECT_EQ(0U, header.numFrames);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldNotClearVideoDataAtOffsetOutsideOfRegion)
+{
+    constexpr int kSession1{0};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    shouldFailToClearVideoDataAtOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                       kSession1, m_videoBufferLen);
+}
+
 TEST_F(SharedMemoryBufferTests, shouldNotClearVideoDataForNotMappedGenericPlaybackSession)
 {
     constexpr int kSession1{0};
@@ -456,3 +516,229 @@ TEST_F(SharedMemoryBufferTests, shouldGetBuffer)
     initialize();
     shouldGetBuffer();
 }
+
+TEST_F(SharedMemoryBufferTests, shouldResizeGenericPartitionInPlace)
+{
+    constexpr int kSession1{0}, kSession2{1};
+    constexpr std::uint32_t kVideoLen{2 * 1024 * 1024}, kAudioLen{256 * 1024};
+    initialize(2);
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession2);
+
+    shouldResizePartition(kSession1, {kVideoLen, kAudioLen, 0});
+    shouldReturnMaxGenericDataLen(kSession1, firebolt::rialto::MediaSourceType::VIDEO, kVideoLen);
+    shouldReturnMaxGenericDataLen(kSession1, firebolt::rialto::MediaSourceType::AUDIO, kAudioLen);
+    shouldReturnMaxGenericDataLen(kSession1, firebolt::rialto::MediaSourceType::SUBTITLE, 0);
+    shouldReturnVideoDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1, 0);
+    shouldReturnAudioDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1,
+                                kVideoLen);
+    shouldReturnVideoDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession2,
+                                m_videoBufferLen + m_audioBufferLen + m_subtitleBufferLen);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldGrowGenericPartitionIntoMemoryFreedByOtherSession)
+{
+    constexpr int kSession1{0}, kSession2{1};
+    constexpr std::uint32_t kSmallVideoLen{2 * 1024 * 1024}, kSmallAudioLen{256 * 1024};
+    constexpr std::uint32_t kBigVideoLen{12 * 1024 * 1024};
+    initialize(2);
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession2);
+    shouldResizePartition(kSession1, {kSmallVideoLen, kSmallAudioLen, 0});
+
+    shouldResizePartition(kSession2, {kBigVideoLen, m_audioBufferLen, m_subtitleBufferLen});
+    shouldReturnMaxGenericDataLen(kSession2, firebolt::rialto::MediaSourceType::VIDEO, kBigVideoLen);
+    shouldReturnVideoDataOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession2,
+                                kSmallVideoLen + kSmallAudioLen);
+    shouldReturnPartitionUsage(kSession2, kBigVideoLen + m_audioBufferLen + m_subtitleBufferLen, 0);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldNotGrowGenericPartitionIntoMemoryReservedForUnmappedSession)
+{
+    constexpr int kSession1{0};
+    constexpr std::uint32_t kBigVideoLen{12 * 1024 * 1024};
+    initialize(2);
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+
+    shouldFailToResizePartition(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1,
+                                {kBigVideoLen, m_audioBufferLen, m_subtitleBufferLen});
+    shouldReturnMaxGenericVideoDataLen(kSession1);
+    shouldReturnMaxGenericAudioDataLen(kSession1);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldRestoreDefaultSizesWhenPartitionIsMappedAgain)
+{
+    constexpr int kSession1{0};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    shouldResizePartition(kSession1, {0, m_audioBufferLen, 0});
+    unmapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    shouldReturnMaxGenericVideoDataLen(kSession1);
+    shouldReturnMaxGenericAudioDataLen(kSession1);
+    shouldReturnMaxSubtitleDataLen(kSession1);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldFailToResizePartition)
+{
+    constexpr int kSession1{0}, kSession2{1};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::WEB_AUDIO, kSession1);
+
+    // Not mapped partition
+    shouldFailToResizePartition(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession2,
+                                {m_videoBufferLen, m_audioBufferLen, 0});
+    // Web audio partition
+    shouldFailToResizePartition(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::WEB_AUDIO, kSession1,
+                                {0, m_webAudioBufferLen, 0});
+    // Region smaller than the metadata
+    shouldFailToResizePartition(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1,
+                                {m_videoBufferLen, firebolt::rialto::server::getMaxMetadataBytes() - 1, 0});
+}
+
+TEST_F(SharedMemoryBufferTests, shouldReportPartitionUsage)
+{
+    constexpr int kSession1{0};
+    constexpr std::uint32_t kValidLength{1000};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    shouldReturnPartitionUsage(kSession1, m_videoBufferLen + m_audioBufferLen + m_subtitleBufferLen, 0);
+
+    uint8_t *videoData = shouldGetDataPtr(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                          kSession1, firebolt::rialto::MediaSourceType::VIDEO);
+    ASSERT_NE(nullptr, videoData);
+
+    shouldClearVideoData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    firebolt::rialto::common::ShmRegionHeader regionHeader{};
+    std::memcpy(&regionHeader, videoData + firebolt::rialto::common::SHM_REGION_HEADER_OFFSET, sizeof(regionHeader));
+    regionHeader.committedGeneration = regionHeader.generation;
+    regionHeader.validLength = kValidLength;
+    std::memcpy(videoData + firebolt::rialto::common::SHM_REGION_HEADER_OFFSET, &regionHeader, sizeof(regionHeader));
+
+    shouldReturnPartitionUsage(kSession1, m_videoBufferLen + m_audioBufferLen + m_subtitleBufferLen,
+                               firebolt::rialto::server::getMaxMetadataBytes() + kValidLength);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldFallBackWhenRequestedBackingIsNotAvailable)
+{
+    constexpr int kSession1{0};
+    setenv("RIALTO_SHM_PAGES", "huge", 1);
+    setenv("RIALTO_SHM_PREFAULT", "lock", 1);
+    initialize();
+    unsetenv("RIALTO_SHM_PAGES");
+    unsetenv("RIALTO_SHM_PREFAULT");
+
+    shouldGetFd();
+    shouldGetBuffer();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    shouldReturnMaxGenericVideoDataLen(kSession1);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldFormatGenericAudioRegionAsRingInStreamingMode)
+{
+    constexpr int kSession1{0};
+    constexpr std::uint32_t kExpectedCapacity{m_audioBufferLen / 2};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+
+    auto ring = shouldEnableStreamingMode(kSession1, firebolt::rialto::MediaSourceType::AUDIO, []() {});
+    EXPECT_EQ(shouldGetDataPtr(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1,
+                               firebolt::rialto::MediaSourceType::AUDIO),
+              getRingRegion(ring));
+    EXPECT_EQ(kExpectedCapacity, ring.capacity);
+
+    firebolt::rialto::ipc::ShmRing producer;
+    ASSERT_TRUE(producer.attach(getRingRegion(ring), ring.capacity));
+    EXPECT_TRUE(producer.write(0, "frame", 5));
+}
+
+TEST_F(SharedMemoryBufferTests, shouldCallDoorbellCallbackWhenClientRingsTheDoorbell)
+{
+    constexpr int kSession1{0};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    std::promise<void> doorbellRung;
+    auto ring = shouldEnableStreamingMode(kSession1, firebolt::rialto::MediaSourceType::VIDEO,
+                                          [&]() { doorbellRung.set_value(); });
+    ASSERT_GE(ring.doorbellFd, 0);
+
+    EXPECT_EQ(0, eventfd_write(ring.doorbellFd, 1));
+    EXPECT_EQ(std::future_status::ready, doorbellRung.get_future().wait_for(std::chrono::seconds{1}));
+    shouldDisableStreamingMode(kSession1, firebolt::rialto::MediaSourceType::VIDEO);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldNotClearRingInStreamingMode)
+{
+    constexpr int kSession1{0};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    auto ring = shouldEnableStreamingMode(kSession1, firebolt::rialto::MediaSourceType::AUDIO, []() {});
+    firebolt::rialto::ipc::ShmRing producer;
+    ASSERT_TRUE(producer.attach(getRingRegion(ring), ring.capacity));
+    ASSERT_TRUE(producer.write(0, "frame", 5));
+
+    shouldClearAudioData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+
+    firebolt::rialto::ipc::ShmRing consumer;
+    ASSERT_TRUE(consumer.attach(getRingRegion(ring), ring.capacity));
+    EXPECT_FALSE(consumer.empty());
+}
+
+TEST_F(SharedMemoryBufferTests, shouldPublishRegionHeaderWhenStreamingModeIsDisabled)
+{
+    constexpr int kSession1{0};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    uint8_t *videoData = shouldGetDataPtr(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                          kSession1, firebolt::rialto::MediaSourceType::VIDEO);
+    ASSERT_NE(nullptr, videoData);
+    auto ring = shouldEnableStreamingMode(kSession1, firebolt::rialto::MediaSourceType::VIDEO, []() {});
+
+    shouldDisableStreamingMode(kSession1, firebolt::rialto::MediaSourceType::VIDEO);
+    shouldFailToDisableStreamingMode(kSession1, firebolt::rialto::MediaSourceType::VIDEO);
+
+    firebolt::rialto::common::ShmRegionHeader header{};
+    std::memcpy(&header, videoData + firebolt::rialto::common::SHM_REGION_HEADER_OFFSET, sizeof(header));
+    EXPECT_EQ(firebolt::rialto::common::SHM_REGION_HEADER_MAGIC, header.magic);
+    firebolt::rialto::ipc::ShmRing producer;
+    EXPECT_FALSE(producer.attach(getRingRegion(ring), ring.capacity));
+}
+
+TEST_F(SharedMemoryBufferTests, shouldFailToEnableStreamingMode)
+{
+    constexpr int kSession1{0};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::WEB_AUDIO, kSession1);
+    shouldFailToEnableStreamingMode(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::WEB_AUDIO,
+                                    kSession1, firebolt::rialto::MediaSourceType::AUDIO);
+    shouldFailToEnableStreamingMode(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                    kSession1, firebolt::rialto::MediaSourceType::AUDIO);
+
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    shouldEnableStreamingMode(kSession1, firebolt::rialto::MediaSourceType::AUDIO, []() {});
+    shouldFailToEnableStreamingMode(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                    kSession1, firebolt::rialto::MediaSourceType::AUDIO);
+}
+
+TEST_F(SharedMemoryBufferTests, shouldNotResizePartitionInStreamingMode)
+{
+    constexpr int kSession1{0};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    shouldEnableStreamingMode(kSession1, firebolt::rialto::MediaSourceType::AUDIO, []() {});
+
+    shouldFailToResizePartition(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1,
+                                {m_videoBufferLen, m_audioBufferLen / 2, 0});
+}
+
+TEST_F(SharedMemoryBufferTests, shouldDisableStreamingModeWhenPartitionIsUnmapped)
+{
+    constexpr int kSession1{0};
+    initialize();
+    mapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    shouldEnableStreamingMode(kSession1, firebolt::rialto::MediaSourceType::AUDIO, []() {});
+    unmapPartitionShouldSucceed(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, kSession1);
+    shouldFailToDisableStreamingMode(kSession1, firebolt::rialto::MediaSourceType::AUDIO);
+}
@@ -18,6 +18,7 @@
  */
 
 #include "SharedMemoryBufferTestsFixture.h"
+#include <algorithm>
 
 void SharedMemoryBufferTests::initialize(int maxPlaybacks, int maxWebAudioPlayers)
 {
@@ -155,6 +156,20 @@ void SharedMemoryBufferTests::shouldFailToClearVideoData(
     EXPECT_FALSE(m_sut->clearData(playbackType, id, firebolt::rialto::MediaSourceType::VIDEO));
 }
 
+void SharedMemoryBufferTests::shouldClearVideoDataAtOffset(
+    firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int id, std::uint32_t offset)
+{
+    ASSERT_TRUE(m_sut);
+    EXPECT_TRUE(m_sut->clearData(playbackType, id, firebolt::rialto::MediaSourceType::VIDEO, offset));
+}
+
+void SharedMemoryBufferTests::shouldFailToClearVideoDataAtOffset(
+    firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int id, std::uint32_t offset)
+{
+    ASSERT_TRUE(m_sut);
+    EXPECT_FALSE(m_sut->clearData(playbackType, id, firebolt::rialto::MediaSourceType::VIDEO, offset));
+}
+
 void SharedMemoryBufferTests::shouldClearSubtitleData(
     firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int id)
 {
@@ -198,6 +213,91 @@ void SharedMemoryBufferTests::shouldGetSize()
               m_sut->getSize()); // Size for one session & one webaudio
 }
 
+void SharedMemoryBufferTests::shouldResizePartition(
+    int id, const firebolt::rialto::server::ISharedMemoryBuffer::PartitionSizes &sizes)
+{
+    ASSERT_TRUE(m_sut);
+    EXPECT_TRUE(m_sut->resizePartition(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                                       sizes));
+}
+
+void SharedMemoryBufferTests::shouldFailToResizePartition(
+    firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int id,
+    const firebolt::rialto::server::ISharedMemoryBuffer::PartitionSizes &sizes)
+{
+    ASSERT_TRUE(m_sut);
+    EXPECT_FALSE(m_sut->resizePartition(playbackType, id, sizes));
+}
+
+void SharedMemoryBufferTests::shouldReturnMaxGenericDataLen(int id,
+                                                            const firebolt::rialto::MediaSourceType &mediaSourceType,
+                                                            std::uint32_t expectedLen)
+{
+    ASSERT_TRUE(m_sut);
+    EXPECT_EQ(m_sut->getMaxDataLen(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                                   mediaSourceType),
+              expectedLen);
+}
+
+firebolt::rialto::server::ISharedMemoryBuffer::StreamingRing
+SharedMemoryBufferTests::shouldEnableStreamingMode(int id, const firebolt::rialto::MediaSourceType &mediaSourceType,
+                                                   std::function<void()> &&doorbellCallback)
+{
+    firebolt::rialto::server::ISharedMemoryBuffer::StreamingRing ring{-1, 0, 0};
+    EXPECT_TRUE(m_sut);
+    if (m_sut)
+    {
+        EXPECT_TRUE(
+            m_sut->enableStreamingMode(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC, id,
+                                       mediaSourceType, std::move(doorbellCallback), ring));
+        EXPECT_GE(ring.doorbellFd, 0);
+    }
+    return ring;
+}
+
+void SharedMemoryBufferTests::shouldFailToEnableStreamingMode(
+    firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int id,
+    const firebolt::rialto::MediaSourceType &mediaSourceType)
+{
+    ASSERT_TRUE(m_sut);
+    firebolt::rialto::server::ISharedMemoryBuffer::StreamingRing ring{-1, 0, 0};
+    EXPECT_FALSE(m_sut->enableStreamingMode(playbackType, id, mediaSourceType, []() {}, ring));
+}
+
+uint8_t *
+SharedMemoryBufferTests::getRingRegion(const firebolt::rialto::server::ISharedMemoryBuffer::StreamingRing &ring)
+{
+    EXPECT_TRUE(m_sut);
+    return m_sut ? m_sut->getBuffer() + ring.offset : nullptr;
+}
+
+void SharedMemoryBufferTests::shouldDisableStreamingMode(int id,
+                                                         const firebolt::rialto::MediaSourceType &mediaSourceType)
+{
+    ASSERT_TRUE(m_sut);
+    EXPECT_TRUE(m_sut->disableStreamingMode(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                            id, mediaSourceType));
+}
+
+void SharedMemoryBufferTests::shouldFailToDisableStreamingMode(int id,
+                                                               const firebolt::rialto::MediaSourceType &mediaSourceType)
+{
+    ASSERT_TRUE(m_sut);
+    EXPECT_FALSE(m_sut->disableStreamingMode(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC,
+                                             id, mediaSourceType));
+}
+
+void SharedMemoryBufferTests::shouldReturnPartitionUsage(int id, std::uint32_t expectedReservedBytes,
+                                                         std::uint32_t expectedUsedBytes)
+{
+    ASSERT_TRUE(m_sut);
+    auto usage = m_sut->getPartitionUsage(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC);
+    auto partitionUsage = std::find_if(usage.begin(), usage.end(), [id](const auto &u) { return u.id == id; });
+    ASSERT_NE(partitionUsage, usage.end());
+    EXPECT_EQ(partitionUsage->reservedBytes, expectedReservedBytes);
+    EXPECT_EQ(partitionUsage->usedBytes, expectedUsedBytes);
+}
+
 void SharedMemoryBufferTests::shouldGetBuffer()
 {
     ASSERT_TRUE(m_sut);
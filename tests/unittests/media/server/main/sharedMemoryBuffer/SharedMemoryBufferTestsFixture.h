@@ -21,6 +21,7 @@
 #define SHARED_MEMORY_BUFFER_TESTS_FIXTURE_H_
 
 #include "SharedMemoryBuffer.h"
+#include <functional>
 #include <gtest/gtest.h>
 #include <memory>
 
@@ -64,6 +65,10 @@ public:
     void shouldClearVideoData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int id);
     void shouldFailToClearVideoData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType,
                                     int id);
+    void shouldClearVideoDataAtOffset(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType,
+                                      int id, std::uint32_t offset);
+    void shouldFailToClearVideoDataAtOffset(
+        firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int id, std::uint32_t offset);
     void shouldClearSubtitleData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int id);
     void shouldFailToClearSubtitleData(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType,
                                        int id);
@@ -71,6 +76,21 @@ public:
                               const firebolt::rialto::MediaSourceType &mediaSourceType);
     void shouldFailToGetDataPtr(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType, int id,
                                 const firebolt::rialto::MediaSourceType &mediaSourceType);
+    void shouldResizePartition(int id, const firebolt::rialto::server::ISharedMemoryBuffer::PartitionSizes &sizes);
+    void shouldFailToResizePartition(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType,
+                                     int id,
+                                     const firebolt::rialto::server::ISharedMemoryBuffer::PartitionSizes &sizes);
+    void shouldReturnMaxGenericDataLen(int id, const firebolt::rialto::MediaSourceType &mediaSourceType,
+                                       std::uint32_t expectedLen);
+    firebolt::rialto::server::ISharedMemoryBuffer::StreamingRing
+    shouldEnableStreamingMode(int id, const firebolt::rialto::MediaSourceType &mediaSourceType,
+                              std::function<void()> &&doorbellCallback);
+    void shouldFailToEnableStreamingMode(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType playbackType,
+                                         int id, const firebolt::rialto::MediaSourceType &mediaSourceType);
+    uint8_t *getRingRegion(const firebolt::rialto::server::ISharedMemoryBuffer::StreamingRing &ring);
+    void shouldDisableStreamingMode(int id, const firebolt::rialto::MediaSourceType &mediaSourceType);
+    void shouldFailToDisableStreamingMode(int id, const firebolt::rialto::MediaSourceType &mediaSourceType);
+    void shouldReturnPartitionUsage(int id, std::uint32_t expectedReservedBytes, std::uint32_t expectedUsedBytes);
     void shouldGetFd();
     void shouldGetSize();
     void shouldGetBuffer();
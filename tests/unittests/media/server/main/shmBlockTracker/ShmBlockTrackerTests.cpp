@@ -0,0 +1,90 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShmBlockTracker.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr std::uint32_t kMediaDataLen{100};
+} // namespace
+
+class ShmBlockTrackerTests : public testing::Test
+{
+protected:
+    std::uint8_t m_mediaData[kMediaDataLen]{};
+    firebolt::rialto::server::ShmBlockTracker m_sut{m_mediaData, kMediaDataLen};
+};
+
+TEST_F(ShmBlockTrackerTests, ShouldReserveWholeAreaWhenNothingIsLent)
+{
+    auto window = m_sut.reserveWriteWindow();
+    EXPECT_EQ(window.offset, 0U);
+    EXPECT_EQ(window.length, kMediaDataLen);
+    EXPECT_EQ(m_sut.getWriteWindow().offset, 0U);
+    EXPECT_EQ(m_sut.getWriteWindow().length, kMediaDataLen);
+}
+
+TEST_F(ShmBlockTrackerTests, ShouldNotLendBlockOutsideOfMediaArea)
+{
+    std::uint8_t otherData[10]{};
+    EXPECT_FALSE(m_sut.lend(otherData, sizeof(otherData)));
+    EXPECT_FALSE(m_sut.lend(m_mediaData + kMediaDataLen - 5, 10));
+    EXPECT_FALSE(m_sut.lend(m_mediaData, 0));
+}
+
+TEST_F(ShmBlockTrackerTests, ShouldReserveLargestFreeWindowWhenBlocksAreLent)
+{
+    EXPECT_TRUE(m_sut.lend(m_mediaData + 10, 20));
+    EXPECT_TRUE(m_sut.lend(m_mediaData + 80, 10));
+    auto window = m_sut.reserveWriteWindow();
+    EXPECT_EQ(window.offset, 30U);
+    EXPECT_EQ(window.length, 50U);
+}
+
+TEST_F(ShmBlockTrackerTests, ShouldReserveWholeAreaWhenAllBlocksAreReleased)
+{
+    EXPECT_FALSE(m_sut.hasLentBlocks());
+    EXPECT_TRUE(m_sut.lend(m_mediaData, 20));
+    EXPECT_TRUE(m_sut.lend(m_mediaData + 20, 20));
+    EXPECT_TRUE(m_sut.hasLentBlocks());
+    EXPECT_EQ(m_sut.reserveWriteWindow().offset, 40U);
+    m_sut.release(m_mediaData);
+    m_sut.release(m_mediaData + 20);
+    EXPECT_FALSE(m_sut.hasLentBlocks());
+    auto window = m_sut.reserveWriteWindow();
+    EXPECT_EQ(window.offset, 0U);
+    EXPECT_EQ(window.length, kMediaDataLen);
+}
+
+TEST_F(ShmBlockTrackerTests, ShouldRefuseToLendWhenAreaIsTooFragmented)
+{
+    EXPECT_TRUE(m_sut.lend(m_mediaData, 30));
+    EXPECT_TRUE(m_sut.lend(m_mediaData + 30, 20));
+    EXPECT_FALSE(m_sut.lend(m_mediaData + 50, 1));
+    m_sut.release(m_mediaData);
+    EXPECT_TRUE(m_sut.lend(m_mediaData + 50, 1));
+}
+
+TEST_F(ShmBlockTrackerTests, ShouldIgnoreReleaseOfUnknownBlock)
+{
+    EXPECT_TRUE(m_sut.lend(m_mediaData, 50));
+    m_sut.release(m_mediaData + 1);
+    EXPECT_EQ(m_sut.reserveWriteWindow().offset, 50U);
+}
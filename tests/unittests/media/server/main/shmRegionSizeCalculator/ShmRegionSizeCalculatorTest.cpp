@@ -0,0 +1,102 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ShmRegionSizeCalculator.h"
+#include <gtest/gtest.h>
+
+using firebolt::rialto::AudioConfig;
+using firebolt::rialto::IMediaPipeline;
+using firebolt::rialto::MediaSourceType;
+using firebolt::rialto::server::ShmRegionSizeCalculator;
+
+namespace
+{
+constexpr std::uint32_t kUhdVideoRegionSize{7 * 1024 * 1024};
+constexpr std::uint32_t kHdVideoRegionSize{4 * 1024 * 1024};
+constexpr std::uint32_t kSdVideoRegionSize{2 * 1024 * 1024};
+constexpr std::uint32_t kMultichannelAudioRegionSize{1 * 1024 * 1024};
+constexpr std::uint32_t kStereoAudioRegionSize{256 * 1024};
+constexpr std::uint32_t kSubtitleRegionSize{256 * 1024};
+} // namespace
+
+TEST(ShmRegionSizeCalculatorTest, ShouldReturnNoRegionsWhenNoSourceIsAttached)
+{
+    ShmRegionSizeCalculator calculator;
+    auto sizes = calculator.getPartitionSizes();
+    EXPECT_EQ(sizes.videoLen, 0U);
+    EXPECT_EQ(sizes.audioLen, 0U);
+    EXPECT_EQ(sizes.subtitleLen, 0U);
+}
+
+TEST(ShmRegionSizeCalculatorTest, ShouldSizeVideoRegionForResolution)
+{
+    ShmRegionSizeCalculator calculator;
+    calculator.addSource(IMediaPipeline::MediaSourceVideo{"video/h264", true, 720, 576});
+    EXPECT_EQ(calculator.getPartitionSizes().videoLen, kSdVideoRegionSize);
+    calculator.addSource(IMediaPipeline::MediaSourceVideo{"video/h264", true, 1920, 1080});
+    EXPECT_EQ(calculator.getPartitionSizes().videoLen, kHdVideoRegionSize);
+    calculator.addSource(IMediaPipeline::MediaSourceVideo{"video/h265", true, 3840, 2160});
+    EXPECT_EQ(calculator.getPartitionSizes().videoLen, kUhdVideoRegionSize);
+}
+
+TEST(ShmRegionSizeCalculatorTest, ShouldUseBiggestVideoRegionWhenResolutionIsUnknown)
+{
+    ShmRegionSizeCalculator calculator;
+    calculator.addSource(IMediaPipeline::MediaSourceVideo{"video/h264"});
+    EXPECT_EQ(calculator.getPartitionSizes().videoLen, kUhdVideoRegionSize);
+}
+
+TEST(ShmRegionSizeCalculatorTest, ShouldOnlyGrowVideoRegionForSegmentResolution)
+{
+    ShmRegionSizeCalculator calculator;
+    calculator.addSource(IMediaPipeline::MediaSourceVideo{"video/h264", true, 720, 576});
+    calculator.addVideoResolution(1920, 1080);
+    EXPECT_EQ(calculator.getPartitionSizes().videoLen, kHdVideoRegionSize);
+    calculator.addVideoResolution(720, 576);
+    EXPECT_EQ(calculator.getPartitionSizes().videoLen, kHdVideoRegionSize);
+}
+
+TEST(ShmRegionSizeCalculatorTest, ShouldIgnoreSegmentResolutionWithoutVideoSource)
+{
+    ShmRegionSizeCalculator calculator;
+    calculator.addVideoResolution(3840, 2160);
+    EXPECT_EQ(calculator.getPartitionSizes().videoLen, 0U);
+}
+
+TEST(ShmRegionSizeCalculatorTest, ShouldSizeAudioRegionForCodecAndChannels)
+{
+    ShmRegionSizeCalculator calculator;
+    calculator.addSource(IMediaPipeline::MediaSourceAudio{"audio/mp4", true, AudioConfig{2, 48000, {}}});
+    EXPECT_EQ(calculator.getPartitionSizes().audioLen, kStereoAudioRegionSize);
+    calculator.addSource(IMediaPipeline::MediaSourceAudio{"audio/mp4", true, AudioConfig{6, 48000, {}}});
+    EXPECT_EQ(calculator.getPartitionSizes().audioLen, kMultichannelAudioRegionSize);
+    calculator.addSource(IMediaPipeline::MediaSourceAudio{"audio/x-eac3", true, AudioConfig{2, 48000, {}}});
+    EXPECT_EQ(calculator.getPartitionSizes().audioLen, kMultichannelAudioRegionSize);
+    calculator.addSource(IMediaPipeline::MediaSourceAudio{"audio/x-opus"});
+    EXPECT_EQ(calculator.getPartitionSizes().audioLen, kMultichannelAudioRegionSize);
+}
+
+TEST(ShmRegionSizeCalculatorTest, ShouldSizeSubtitleRegionAndRemoveSource)
+{
+    ShmRegionSizeCalculator calculator;
+    calculator.addSource(IMediaPipeline::MediaSourceSubtitle{"text/vtt", "id"});
+    EXPECT_EQ(calculator.getPartitionSizes().subtitleLen, kSubtitleRegionSize);
+    calculator.removeSource(MediaSourceType::SUBTITLE);
+    EXPECT_EQ(calculator.getPartitionSizes().subtitleLen, 0U);
+}
@@ -0,0 +1,193 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "ShmRingReader.h"
+#include "MediaFrameWriterV2.h"
+#include "ShmCommon.h"
+#include "ShmRing.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using firebolt::rialto::IMediaPipeline;
+using firebolt::rialto::MediaSourceType;
+using firebolt::rialto::common::MediaFrameWriterV2;
+using firebolt::rialto::common::SHM_RING_END_OF_STREAM_TAG;
+using firebolt::rialto::ipc::ShmRing;
+using firebolt::rialto::server::IShmRingReader;
+using firebolt::rialto::server::MediaSegmentBatch;
+using firebolt::rialto::server::ShmRingReader;
+
+namespace
+{
+constexpr std::uint32_t kCapacity{4096};
+constexpr std::int32_t kSourceId{1};
+constexpr std::int64_t kTimeStamp{1423435};
+constexpr std::int64_t kDuration{12324};
+constexpr std::int32_t kSampleRate{48000};
+constexpr std::int32_t kNumberOfChannels{2};
+const std::vector<std::uint8_t> kMediaData{'T', 'E', 'S', 'T', '_', 'M', 'E', 'D', 'I', 'A'};
+} // namespace
+
+class ShmRingReaderTests : public ::testing::Test
+{
+protected:
+    std::vector<std::uint64_t> m_region = std::vector<std::uint64_t>(ShmRing::regionSize(kCapacity) / sizeof(uint64_t));
+    ShmRing m_producer;
+    std::unique_ptr<ShmRingReader> m_sut;
+    MediaSegmentBatch m_batch;
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_producer.init(m_region.data(), kCapacity));
+        m_sut = std::make_unique<ShmRingReader>(MediaSourceType::AUDIO, getRegion(), kCapacity);
+    }
+
+    std::uint8_t *getRegion() { return reinterpret_cast<std::uint8_t *>(m_region.data()); }
+
+    void writeFrame(std::uint64_t generation, std::int64_t timeStamp = kTimeStamp)
+    {
+        std::unique_ptr<IMediaPipeline::MediaSegment> segment{
+            std::make_unique<IMediaPipeline::MediaSegmentAudio>(kSourceId, timeStamp, kDuration, kSampleRate,
+                                                                kNumberOfChannels)};
+        segment->setData(kMediaData.size(), kMediaData.data());
+        std::vector<std::uint8_t> metadata;
+        ASSERT_TRUE(MediaFrameWriterV2::serializeMetadata(segment, metadata));
+        ASSERT_TRUE(m_producer.write(generation, metadata.data(), metadata.size(), kMediaData.data(),
+                                     kMediaData.size()));
+    }
+
+    void writeEndOfStream(std::uint64_t generation)
+    {
+        ASSERT_TRUE(m_producer.write(generation | SHM_RING_END_OF_STREAM_TAG, nullptr, 0));
+    }
+};
+
+/**
+ * Test that the reader fails to attach to memory that does not hold a ring.
+ */
+TEST_F(ShmRingReaderTests, ShouldFailToCreateWithoutRing)
+{
+    std::vector<std::uint64_t> region(ShmRing::regionSize(kCapacity) / sizeof(uint64_t));
+    EXPECT_THROW(ShmRingReader(MediaSourceType::AUDIO, reinterpret_cast<std::uint8_t *>(region.data()), kCapacity),
+                 std::runtime_error);
+    EXPECT_THROW(ShmRingReader(MediaSourceType::AUDIO, nullptr, kCapacity), std::runtime_error);
+}
+
+/**
+ * Test that the reader returns the type of its source.
+ */
+TEST_F(ShmRingReaderTests, ShouldReturnType)
+{
+    EXPECT_EQ(MediaSourceType::AUDIO, m_sut->getType());
+}
+
+/**
+ * Test that nothing is read from an empty ring.
+ */
+TEST_F(ShmRingReaderTests, ShouldReadNothingFromEmptyRing)
+{
+    EXPECT_EQ(IShmRingReader::Status::EMPTY, m_sut->read(m_batch));
+    EXPECT_TRUE(m_batch.empty());
+}
+
+/**
+ * Test that a frame is read from the ring and stays there until it is consumed.
+ */
+TEST_F(ShmRingReaderTests, ShouldReadFrame)
+{
+    writeFrame(0);
+    ASSERT_EQ(IShmRingReader::Status::FRAME, m_sut->read(m_batch));
+    ASSERT_EQ(1U, m_batch.size());
+    const auto &kView{m_batch.front()};
+    EXPECT_EQ(MediaSourceType::AUDIO, kView.type);
+    EXPECT_EQ(kSourceId, kView.sourceId);
+    EXPECT_EQ(kTimeStamp, kView.timeStamp);
+    EXPECT_EQ(kDuration, kView.duration);
+    EXPECT_EQ(kSampleRate, kView.sampleRate);
+    EXPECT_EQ(kNumberOfChannels, kView.numberOfChannels);
+    EXPECT_EQ(kMediaData, std::vector<std::uint8_t>(kView.data.data, kView.data.data + kView.data.size));
+
+    m_batch.clear();
+    EXPECT_EQ(IShmRingReader::Status::FRAME, m_sut->read(m_batch));
+    m_batch.clear();
+    m_sut->consume();
+    EXPECT_EQ(IShmRingReader::Status::EMPTY, m_sut->read(m_batch));
+}
+
+/**
+ * Test that the end of stream is read, and stays in the ring until it is consumed.
+ */
+TEST_F(ShmRingReaderTests, ShouldReadEndOfStream)
+{
+    writeEndOfStream(0);
+    EXPECT_EQ(IShmRingReader::Status::END_OF_STREAM, m_sut->read(m_batch));
+    EXPECT_EQ(IShmRingReader::Status::END_OF_STREAM, m_sut->read(m_batch));
+    EXPECT_TRUE(m_batch.empty());
+    m_sut->consume();
+    EXPECT_EQ(IShmRingReader::Status::EMPTY, m_sut->read(m_batch));
+}
+
+/**
+ * Test that an invalid record is dropped.
+ */
+TEST_F(ShmRingReaderTests, ShouldDropInvalidRecord)
+{
+    const std::vector<std::uint8_t> kInvalidRecord{0xFF, 0xFF, 0xFF, 0xFF, 0x01};
+    ASSERT_TRUE(m_producer.write(0, kInvalidRecord.data(), kInvalidRecord.size()));
+    writeFrame(0);
+    EXPECT_EQ(IShmRingReader::Status::FRAME, m_sut->read(m_batch));
+    EXPECT_EQ(1U, m_batch.size());
+}
+
+/**
+ * Test that nothing is read during a flush and that the records written before the flush are dropped.
+ */
+TEST_F(ShmRingReaderTests, ShouldDropRecordsWrittenBeforeFlush)
+{
+    constexpr std::int64_t kTimeStampAfterFlush{kTimeStamp + kDuration};
+    writeFrame(0);
+    writeEndOfStream(0);
+    m_sut->setFlushing(true);
+    EXPECT_EQ(IShmRingReader::Status::EMPTY, m_sut->read(m_batch));
+    EXPECT_FALSE(m_sut->waitForDoorbell());
+
+    writeFrame(1, kTimeStampAfterFlush);
+    m_sut->setFlushing(false);
+    ASSERT_EQ(IShmRingReader::Status::FRAME, m_sut->read(m_batch));
+    ASSERT_EQ(1U, m_batch.size());
+    EXPECT_EQ(kTimeStampAfterFlush, m_batch.front().timeStamp);
+}
+
+/**
+ * Test that the reader only waits for the doorbell when the ring is empty.
+ */
+TEST_F(ShmRingReaderTests, ShouldWaitForDoorbell)
+{
+    // A new ring starts with the reader waiting
+    EXPECT_TRUE(m_producer.clearConsumerWaiting());
+
+    EXPECT_FALSE(m_sut->waitForDoorbell());
+    writeFrame(0);
+    EXPECT_TRUE(m_producer.clearConsumerWaiting());
+
+    EXPECT_TRUE(m_sut->waitForDoorbell());
+}
@@ -64,7 +64,16 @@ public:
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createPlay, (IGstGenericPlayerPrivate & player), (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createReadShmDataAndAttachSamples,
                 (GenericPlayerContext & context, IGstGenericPlayerPrivate &player,
-                 const std::shared_ptr<IDataReader> &dataReader),
+                 const std::shared_ptr<IDataReader> &dataReader,
+                 const std::shared_ptr<IShmBlockTracker> &shmBlockTracker),
+                (const, override));
+    MOCK_METHOD(std::unique_ptr<IPlayerTask>, createReadShmDataAndAttachSamples,
+                (GenericPlayerContext & context, IGstGenericPlayerPrivate &player,
+                 const std::vector<IGstGenericPlayer::ShmSamples> &shmSamples),
+                (const, override));
+    MOCK_METHOD(std::unique_ptr<IPlayerTask>, createReadShmRingAndAttachSamples,
+                (GenericPlayerContext & context, IGstGenericPlayerPrivate &player,
+                 const std::shared_ptr<IShmRingReader> &shmRingReader),
                 (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createRemoveSource,
                 (GenericPlayerContext & context, IGstGenericPlayerPrivate &player,
@@ -72,6 +81,8 @@ public:
                 (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createReportPosition,
                 (GenericPlayerContext & context, IGstGenericPlayerPrivate &player), (const, override));
+    MOCK_METHOD(std::unique_ptr<IPlayerTask>, createNotifyPlaybackInfo, (IGstGenericPlayerPrivate & player),
+                (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createCheckAudioUnderflow,
                 (GenericPlayerContext & context, IGstGenericPlayerPrivate &player), (const, override));
     MOCK_METHOD(std::unique_ptr<IPlayerTask>, createSetPlaybackRate, (GenericPlayerContext & context, double rate),
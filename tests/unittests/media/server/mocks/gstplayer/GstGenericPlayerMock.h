@@ -40,7 +40,12 @@ public:
     MOCK_METHOD(void, pause, (), (override));
     MOCK_METHOD(void, stop, (), (override));
     MOCK_METHOD(void, attachSamples, (const IMediaPipeline::MediaSegmentVector &mediaSegments), (override));
-    MOCK_METHOD(void, attachSamples, (const std::shared_ptr<IDataReader> &dataReader), (override));
+    MOCK_METHOD(void, attachSamples,
+                (const std::shared_ptr<IDataReader> &dataReader,
+                 const std::shared_ptr<IShmBlockTracker> &shmBlockTracker),
+                (override));
+    MOCK_METHOD(void, attachSamples, (const std::vector<ShmSamples> &shmSamples), (override));
+    MOCK_METHOD(void, drainShmRing, (const std::shared_ptr<IShmRingReader> &shmRingReader), (override));
     MOCK_METHOD(void, setPosition, (std::int64_t position), (override));
     MOCK_METHOD(bool, getPosition, (std::int64_t & position), (override));
     MOCK_METHOD(bool, getDuration, (std::int64_t & duration), (override));
@@ -49,6 +54,8 @@ public:
     MOCK_METHOD(bool, setReportDecodeErrors, (const MediaSourceType &mediaSourceType, bool reportDecodeErrors),
                 (override));
     MOCK_METHOD(bool, getQueuedFrames, (uint32_t & queuedFrames), (override));
+    MOCK_METHOD(bool, getQueuedDuration, (const MediaSourceType &mediaSourceType, std::int64_t &queuedDuration),
+                (override));
     MOCK_METHOD(bool, getStats,
                 (const MediaSourceType &mediaSourceType, uint64_t &renderedFrames, uint64_t &droppedFrames), (override));
     MOCK_METHOD(void, setVideoGeometry, (int x, int y, int width, int height), (override));
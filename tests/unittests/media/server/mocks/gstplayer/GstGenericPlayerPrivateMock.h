@@ -55,7 +55,9 @@ public:
     MOCK_METHOD(bool, setShowVideoWindow, (), (override));
     MOCK_METHOD(void, notifyNeedMediaData, (const MediaSourceType mediaSource), (override));
     MOCK_METHOD(void, notifyNeedMediaDataWithDelay, (const MediaSourceType mediaSource), (override));
-    MOCK_METHOD(GstBuffer *, createBuffer, (const IMediaPipeline::MediaSegment &mediaSegment), (const, override));
+    MOCK_METHOD(GstBuffer *, createBuffer,
+                (const MediaSegmentView &mediaSegment, const std::shared_ptr<IShmBlockTracker> &shmBlockTracker),
+                (const, override));
     MOCK_METHOD(void, attachData, (const firebolt::rialto::MediaSourceType mediaType), (override));
     MOCK_METHOD(void, updateAudioCaps, (int32_t rate, int32_t channels, const std::shared_ptr<CodecData> &codecData),
                 (override));
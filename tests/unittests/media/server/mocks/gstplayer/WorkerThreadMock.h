@@ -32,6 +32,8 @@ public:
     MOCK_METHOD(void, stop, (), (override));
     MOCK_METHOD(void, join, (), (override));
     MOCK_METHOD(void, enqueueTask, (std::unique_ptr<IPlayerTask> && task), (override));
+    MOCK_METHOD(void, enqueueCoalescedTask, (CoalescingKey key, std::unique_ptr<IPlayerTask> && task), (override));
+    MOCK_METHOD(WorkerThreadStats, getStats, (), (const, override));
 };
 } // namespace firebolt::rialto::server
 
@@ -84,6 +84,16 @@ public:
                 (::google::protobuf::RpcController * controller, const ::firebolt::rialto::HaveDataRequest *request,
                  ::firebolt::rialto::HaveDataResponse *response, ::google::protobuf::Closure *done),
                 (override));
+    MOCK_METHOD(void, haveDataMulti,
+                (::google::protobuf::RpcController * controller,
+                 const ::firebolt::rialto::HaveDataMultiRequest *request,
+                 ::firebolt::rialto::HaveDataMultiResponse *response, ::google::protobuf::Closure *done),
+                (override));
+    MOCK_METHOD(void, enableStreamingMode,
+                (::google::protobuf::RpcController * controller,
+                 const ::firebolt::rialto::EnableStreamingModeRequest *request,
+                 ::firebolt::rialto::EnableStreamingModeResponse *response, ::google::protobuf::Closure *done),
+                (override));
 };
 } // namespace firebolt::rialto::server::ipc
 
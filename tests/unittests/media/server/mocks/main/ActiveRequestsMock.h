@@ -37,6 +37,7 @@ public:
     MOCK_METHOD(void, erase, (std::uint32_t requestId), (override));
     MOCK_METHOD(void, erase, (const MediaSourceType &mediaSourceType), (override));
     MOCK_METHOD(void, clear, (), (override));
+    MOCK_METHOD(bool, isEmpty, (), (const, override));
     MOCK_METHOD(AddSegmentStatus, addSegment,
                 (std::uint32_t requestId, const std::unique_ptr<IMediaPipeline::MediaSegment> &segment), (override));
     MOCK_METHOD(const IMediaPipeline::MediaSegmentVector &, getSegments, (std::uint32_t requestId), (const, override));
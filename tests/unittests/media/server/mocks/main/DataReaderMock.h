@@ -29,7 +29,10 @@ class DataReaderMock : public IDataReader
 {
 public:
     MOCK_METHOD(IMediaPipeline::MediaSegmentVector, readData, (), (const, override));
+    MOCK_METHOD(void, readSegments, (MediaSegmentBatch & batch), (const, override));
     MOCK_METHOD(bool, isBufferFull, (), (const, override));
+    MOCK_METHOD(std::uint32_t, getMetadataVersion, (), (const, override));
+    MOCK_METHOD(std::uint32_t, getDataLength, (), (const, override));
 };
 } // namespace firebolt::rialto::server
 
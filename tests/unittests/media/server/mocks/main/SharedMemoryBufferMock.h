@@ -30,8 +30,20 @@ class SharedMemoryBufferMock : public ISharedMemoryBuffer
 public:
     MOCK_METHOD(bool, mapPartition, (MediaPlaybackType playbackType, int id), (override));
     MOCK_METHOD(bool, unmapPartition, (MediaPlaybackType playbackType, int id), (override));
+    MOCK_METHOD(bool, resizePartition, (MediaPlaybackType playbackType, int id, const PartitionSizes &sizes),
+                (override));
+    MOCK_METHOD(std::vector<PartitionUsage>, getPartitionUsage, (MediaPlaybackType playbackType), (const, override));
     MOCK_METHOD(bool, clearData, (MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType),
                 (const, override));
+    MOCK_METHOD(bool, clearData,
+                (MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType, std::uint32_t offset),
+                (const, override));
+    MOCK_METHOD(bool, enableStreamingMode,
+                (MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType,
+                 std::function<void()> &&doorbellCallback, StreamingRing &ring),
+                (override));
+    MOCK_METHOD(bool, disableStreamingMode,
+                (MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType), (override));
     MOCK_METHOD(std::uint32_t, getDataOffset,
                 (MediaPlaybackType playbackType, int id, const MediaSourceType &mediaSourceType), (const, override));
     MOCK_METHOD(std::uint32_t, getMaxDataLen,
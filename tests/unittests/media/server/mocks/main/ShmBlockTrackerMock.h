@@ -0,0 +1,36 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FIREBOLT_RIALTO_SERVER_SHM_BLOCK_TRACKER_MOCK_H_
+#define FIREBOLT_RIALTO_SERVER_SHM_BLOCK_TRACKER_MOCK_H_
+
+#include "IShmBlockTracker.h"
+#include <gmock/gmock.h>
+
+namespace firebolt::rialto::server
+{
+class ShmBlockTrackerMock : public IShmBlockTracker
+{
+public:
+    MOCK_METHOD(bool, lend, (const std::uint8_t *data, std::uint32_t size), (override));
+    MOCK_METHOD(void, release, (const std::uint8_t *data), (override));
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_SHM_BLOCK_TRACKER_MOCK_H_
@@ -0,0 +1,39 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 Sky UK
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef FIREBOLT_RIALTO_SERVER_SHM_RING_READER_MOCK_H_
+#define FIREBOLT_RIALTO_SERVER_SHM_RING_READER_MOCK_H_
+
+#include "IShmRingReader.h"
+#include <gmock/gmock.h>
+
+namespace firebolt::rialto::server
+{
+class ShmRingReaderMock : public IShmRingReader
+{
+public:
+    MOCK_METHOD(MediaSourceType, getType, (), (const, override));
+    MOCK_METHOD(Status, read, (MediaSegmentBatch & batch), (override));
+    MOCK_METHOD(void, consume, (), (override));
+    MOCK_METHOD(bool, waitForDoorbell, (), (override));
+};
+} // namespace firebolt::rialto::server
+
+#endif // FIREBOLT_RIALTO_SERVER_SHM_RING_READER_MOCK_H_
@@ -53,6 +53,11 @@ public:
                 (override));
     MOCK_METHOD(bool, setVideoWindow, (int, std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t), (override));
     MOCK_METHOD(bool, haveData, (int, MediaSourceStatus, std::uint32_t, std::uint32_t), (override));
+    MOCK_METHOD(bool, haveDataMulti, (int, const std::vector<HaveDataInfo> &, std::vector<bool> &), (override));
+    MOCK_METHOD(bool, enableStreamingMode,
+                (int sessionId, int32_t sourceId, int &doorbellFd, std::uint32_t &ringOffset,
+                 std::uint32_t &ringCapacity),
+                (override));
     MOCK_METHOD(bool, renderFrame, (int), (override));
     MOCK_METHOD(bool, setVolume, (int sessionId, double targetVolume, uint32_t volumeDuration, EaseType easeType),
                 (override));
@@ -368,6 +368,18 @@ TEST_F(CdmServiceTests, shouldDecrypt)
     destroyMediaKeysShouldSucceed();
 }
 
+TEST_F(CdmServiceTests, shouldDecryptWhileSessionIsBeingUpdated)
+{
+    triggerSwitchToActiveSuccess();
+    mediaKeysFactoryWillCreateMediaKeys();
+    createMediaKeysShouldSucceed();
+    mediaKeysWillCreateKeySessionWithStatus(firebolt::rialto::MediaKeyErrorStatus::OK);
+    createKeySessionShouldSucceed();
+    mediaKeysWillUpdateSessionUntilDecrypted();
+    decryptShouldSucceedDuringUpdateSession();
+    destroyMediaKeysShouldSucceed();
+}
+
 TEST_F(CdmServiceTests, shouldFailToDecryptWhenNoMediaKeys)
 {
     triggerSwitchToActiveSuccess();
@@ -18,7 +18,9 @@
  */
 
 #include "CdmServiceTestsFixture.h"
+#include <chrono>
 #include <string>
+#include <thread>
 #include <utility>
 
 using testing::_;
@@ -46,6 +48,7 @@ constexpr uint32_t kInitWithLast15{1};
 constexpr firebolt::rialto::LimitedDurationLicense kLdlState{firebolt::rialto::LimitedDurationLicense::NOT_SPECIFIED};
 constexpr firebolt::rialto::LimitedDurationLicense kLdlStateEnabled{firebolt::rialto::LimitedDurationLicense::ENABLED};
 const std::vector<std::string> kRobustnessLevels{"HW_SECURE_ALL", "SW_SECURE_CRYPTO"};
+constexpr std::chrono::seconds kUpdateSessionTimeout{1};
 } // namespace
 
 CdmServiceTests::CdmServiceTests()
@@ -235,6 +238,32 @@ void CdmServiceTests::mediaKeysWillDecryptWithStatus(firebolt::rialto::MediaKeyE
     EXPECT_CALL(m_mediaKeysMock, decrypt(kKeySessionId, _, _)).WillOnce(Return(status));
 }
 
+void CdmServiceTests::mediaKeysWillUpdateSessionUntilDecrypted()
+{
+    EXPECT_CALL(m_mediaKeysMock, updateSession(kKeySessionId, kResponseData))
+        .WillOnce(Invoke(
+            [this](int32_t, const std::vector<uint8_t> &)
+            {
+                std::unique_lock<std::mutex> lock{m_updateSessionMutex};
+                m_isUpdatingSession = true;
+                m_updateSessionCond.notify_all();
+                if (!m_updateSessionCond.wait_for(lock, kUpdateSessionTimeout, [this]() { return m_isDecrypted; }))
+                {
+                    return firebolt::rialto::MediaKeyErrorStatus::FAIL;
+                }
+                return firebolt::rialto::MediaKeyErrorStatus::OK;
+            }));
+    EXPECT_CALL(m_mediaKeysMock, decrypt(kKeySessionId, _, _))
+        .WillOnce(Invoke(
+            [this](int32_t, GstBuffer *, GstCaps *)
+            {
+                std::unique_lock<std::mutex> lock{m_updateSessionMutex};
+                m_isDecrypted = true;
+                m_updateSessionCond.notify_all();
+                return firebolt::rialto::MediaKeyErrorStatus::OK;
+            }));
+}
+
 void CdmServiceTests::mediaKeysWillSelectKeyIdWithStatus(firebolt::rialto::MediaKeyErrorStatus status)
 {
     EXPECT_CALL(m_mediaKeysMock, selectKeyId(kKeySessionId, keyId)).WillOnce(Return(status));
@@ -329,6 +358,18 @@ void CdmServiceTests::decryptShouldReturnStatus(firebolt::rialto::MediaKeyErrorS
     EXPECT_EQ(status, m_sut.decrypt(kKeySessionId, &encryptedData, &caps));
 }
 
+void CdmServiceTests::decryptShouldSucceedDuringUpdateSession()
+{
+    std::thread updateSessionThread{[this]()
+                                    { updateSessionShouldReturnStatus(firebolt::rialto::MediaKeyErrorStatus::OK); }};
+    {
+        std::unique_lock<std::mutex> lock{m_updateSessionMutex};
+        m_updateSessionCond.wait(lock, [this]() { return m_isUpdatingSession; });
+    }
+    decryptShouldReturnStatus(firebolt::rialto::MediaKeyErrorStatus::OK);
+    updateSessionThread.join();
+}
+
 void CdmServiceTests::selectKeyIdShouldReturnStatus(firebolt::rialto::MediaKeyErrorStatus status)
 {
     EXPECT_EQ(status, m_sut.selectKeyId(kKeySessionId, keyId));
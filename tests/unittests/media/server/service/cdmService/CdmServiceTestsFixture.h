@@ -29,8 +29,10 @@
 #include "MediaKeysServerInternalMock.h"
 #include "SharedMemoryBufferFactoryMock.h"
 #include "SharedMemoryBufferMock.h"
+#include <condition_variable>
 #include <gtest/gtest.h>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 using testing::StrictMock;
@@ -62,6 +64,7 @@ public:
     void mediaKeysWillGetDrmTimeWithStatus(firebolt::rialto::MediaKeyErrorStatus status);
     void mediaKeysWillReleaseKeySessionWithStatus(firebolt::rialto::MediaKeyErrorStatus status);
     void mediaKeysWillDecryptWithStatus(firebolt::rialto::MediaKeyErrorStatus status);
+    void mediaKeysWillUpdateSessionUntilDecrypted();
     void mediaKeysWillSelectKeyIdWithStatus(firebolt::rialto::MediaKeyErrorStatus status);
     void mediaKeysWillPing();
     void mediaKeysWillGetMetricSystemDataWithStatus(firebolt::rialto::MediaKeyErrorStatus status);
@@ -94,6 +97,7 @@ public:
     void removeKeySessionShouldReturnStatus(firebolt::rialto::MediaKeyErrorStatus status);
     void getCdmKeySessionIdShouldReturnStatus(firebolt::rialto::MediaKeyErrorStatus status);
     void decryptShouldReturnStatus(firebolt::rialto::MediaKeyErrorStatus status);
+    void decryptShouldSucceedDuringUpdateSession();
     void selectKeyIdShouldReturnStatus(firebolt::rialto::MediaKeyErrorStatus status);
     void containsKeyShouldReturn(bool result);
     void setDrmHeaderShouldReturnStatus(firebolt::rialto::MediaKeyErrorStatus status);
@@ -131,6 +135,10 @@ private:
     std::shared_ptr<StrictMock<firebolt::rialto::MediaKeysClientMock>> m_mediaKeysClientMock;
     std::shared_ptr<StrictMock<firebolt::rialto::server::HeartbeatProcedureMock>> m_heartbeatProcedureMock;
     firebolt::rialto::server::service::CdmService m_sut;
+    std::mutex m_updateSessionMutex;
+    std::condition_variable m_updateSessionCond;
+    bool m_isUpdatingSession{false};
+    bool m_isDecrypted{false};
 };
 
 #endif // CDM_SERVICE_TESTS_FIXTURE_H_
@@ -302,6 +302,39 @@ TEST_F(MediaPipelineServiceTests, shouldHaveData)
     haveDataShouldSucceed();
 }
 
+TEST_F(MediaPipelineServiceTests, shouldFailToHaveDataMultiForNotExistingSession)
+{
+    createMediaPipelineShouldSuccess();
+    haveDataMultiShouldFail();
+}
+
+TEST_F(MediaPipelineServiceTests, shouldHaveDataMulti)
+{
+    initSession();
+    mediaPipelineWillHaveDataMulti();
+    haveDataMultiShouldSucceed();
+}
+
+TEST_F(MediaPipelineServiceTests, shouldFailToEnableStreamingModeForNotExistingSession)
+{
+    createMediaPipelineShouldSuccess();
+    enableStreamingModeShouldFail();
+}
+
+TEST_F(MediaPipelineServiceTests, shouldFailToEnableStreamingMode)
+{
+    initSession();
+    mediaPipelineWillFailToEnableStreamingRing();
+    enableStreamingModeShouldFail();
+}
+
+TEST_F(MediaPipelineServiceTests, shouldEnableStreamingMode)
+{
+    initSession();
+    mediaPipelineWillEnableStreamingRing();
+    enableStreamingModeShouldSucceed();
+}
+
 TEST_F(MediaPipelineServiceTests, shouldFailToGetPositionForNotExistingSession)
 {
     createMediaPipelineShouldSuccess();
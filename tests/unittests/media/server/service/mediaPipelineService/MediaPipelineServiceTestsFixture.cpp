@@ -31,6 +31,7 @@ using testing::DoAll;
 using testing::Invoke;
 using testing::Return;
 using testing::SetArgReferee;
+using testing::SizeIs;
 using testing::StrEq;
 using testing::Throw;
 
@@ -54,6 +55,7 @@ constexpr std::uint32_t y{7};
 constexpr firebolt::rialto::MediaSourceStatus kStatus{firebolt::rialto::MediaSourceStatus::CODEC_CHANGED};
 constexpr std::uint32_t kNeedDataRequestId{17};
 constexpr std::uint32_t kNumFrames{1};
+constexpr firebolt::rialto::server::ISharedMemoryBuffer::StreamingRing kRing{12, 4096, 8192};
 constexpr double kVolume{0.7};
 constexpr uint32_t kVolumeDuration{1000};
 constexpr firebolt::rialto::EaseType kEaseType{firebolt::rialto::EaseType::EASE_LINEAR};
@@ -208,6 +210,23 @@ void MediaPipelineServiceTests::mediaPipelineWillFailToHaveData()
     EXPECT_CALL(m_mediaPipelineMock, haveData(kStatus, kNumFrames, kNeedDataRequestId)).WillOnce(Return(false));
 }
 
+void MediaPipelineServiceTests::mediaPipelineWillHaveDataMulti()
+{
+    EXPECT_CALL(m_mediaPipelineMock, haveDataMulti(SizeIs(1), _))
+        .WillOnce(DoAll(SetArgReferee<1>(std::vector<bool>{false}), Return(true)));
+}
+
+void MediaPipelineServiceTests::mediaPipelineWillEnableStreamingRing()
+{
+    EXPECT_CALL(m_mediaPipelineMock, enableStreamingRing(kSourceId, _))
+        .WillOnce(DoAll(SetArgReferee<1>(kRing), Return(true)));
+}
+
+void MediaPipelineServiceTests::mediaPipelineWillFailToEnableStreamingRing()
+{
+    EXPECT_CALL(m_mediaPipelineMock, enableStreamingRing(kSourceId, _)).WillOnce(Return(false));
+}
+
 void MediaPipelineServiceTests::mediaPipelineWillGetPosition()
 {
     EXPECT_CALL(m_mediaPipelineMock, getPosition(_))
@@ -732,6 +751,38 @@ void MediaPipelineServiceTests::haveDataShouldFail()
     EXPECT_FALSE(m_sut->haveData(kSessionId, kStatus, kNumFrames, kNeedDataRequestId));
 }
 
+void MediaPipelineServiceTests::haveDataMultiShouldSucceed()
+{
+    std::vector<bool> results;
+    EXPECT_TRUE(m_sut->haveDataMulti(kSessionId, {{kStatus, kNumFrames, kNeedDataRequestId}}, results));
+    EXPECT_EQ(results, std::vector<bool>{false});
+}
+
+void MediaPipelineServiceTests::haveDataMultiShouldFail()
+{
+    std::vector<bool> results;
+    EXPECT_FALSE(m_sut->haveDataMulti(kSessionId, {{kStatus, kNumFrames, kNeedDataRequestId}}, results));
+}
+
+void MediaPipelineServiceTests::enableStreamingModeShouldSucceed()
+{
+    int doorbellFd{-1};
+    std::uint32_t ringOffset{0};
+    std::uint32_t ringCapacity{0};
+    EXPECT_TRUE(m_sut->enableStreamingMode(kSessionId, kSourceId, doorbellFd, ringOffset, ringCapacity));
+    EXPECT_EQ(doorbellFd, kRing.doorbellFd);
+    EXPECT_EQ(ringOffset, kRing.offset);
+    EXPECT_EQ(ringCapacity, kRing.capacity);
+}
+
+void MediaPipelineServiceTests::enableStreamingModeShouldFail()
+{
+    int doorbellFd{-1};
+    std::uint32_t ringOffset{0};
+    std::uint32_t ringCapacity{0};
+    EXPECT_FALSE(m_sut->enableStreamingMode(kSessionId, kSourceId, doorbellFd, ringOffset, ringCapacity));
+}
+
 void MediaPipelineServiceTests::getPositionShouldSucceed()
 {
     std::int64_t targetPosition{};
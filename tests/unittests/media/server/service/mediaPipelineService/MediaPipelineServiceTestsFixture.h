@@ -62,6 +62,9 @@ public:
     void mediaPipelineWillFailToSetVideoWindow();
     void mediaPipelineWillHaveData();
     void mediaPipelineWillFailToHaveData();
+    void mediaPipelineWillHaveDataMulti();
+    void mediaPipelineWillEnableStreamingRing();
+    void mediaPipelineWillFailToEnableStreamingRing();
     void mediaPipelineWillGetPosition();
     void mediaPipelineWillFailToGetPosition();
     void mediaPipelineWillGetDuration();
@@ -160,6 +163,10 @@ public:
     void setVideoWindowShouldFail();
     void haveDataShouldSucceed();
     void haveDataShouldFail();
+    void haveDataMultiShouldSucceed();
+    void haveDataMultiShouldFail();
+    void enableStreamingModeShouldSucceed();
+    void enableStreamingModeShouldFail();
     void getPositionShouldSucceed();
     void getPositionShouldFail();
     void getDurationShouldSucceed();
@@ -64,3 +64,14 @@ TEST_F(PlaybackServiceTests, shouldPing)
     createPlaybackServiceShouldSuccess();
     triggerPing();
 }
+
+TEST_F(PlaybackServiceTests, shouldReportShmPartitionUsageOnPing)
+{
+    createPlaybackServiceShouldSuccess();
+    triggerSetMaxPlaybacks();
+    triggerSetMaxWebAudioPlayers();
+    sharedMemoryBufferWillBeInitialized();
+    triggerSwitchToActive();
+    sharedMemoryBufferWillReturnPartitionUsage();
+    triggerPing();
+}
@@ -35,6 +35,9 @@ constexpr std::int32_t kShmFd{234};
 constexpr std::uint32_t kShmSize{2048};
 constexpr std::int32_t kMaxPlaybacks{2};
 constexpr std::int32_t kMaxWebAudioPlayers{2};
+constexpr int kSessionId{0};
+constexpr std::uint32_t kReservedBytes{1024};
+constexpr std::uint32_t kUsedBytes{512};
 const std::string kClientDisplayName{"westeros-rialto"};
 } // namespace
 
@@ -69,6 +72,14 @@ void PlaybackServiceTests::sharedMemoryBufferWillReturnFdAndSize()
     EXPECT_CALL(m_shmBufferMock, getSize()).WillOnce(Return(kShmSize));
 }
 
+void PlaybackServiceTests::sharedMemoryBufferWillReturnPartitionUsage()
+{
+    EXPECT_CALL(m_shmBufferMock,
+                getPartitionUsage(firebolt::rialto::server::ISharedMemoryBuffer::MediaPlaybackType::GENERIC))
+        .WillOnce(Return(std::vector<firebolt::rialto::server::ISharedMemoryBuffer::PartitionUsage>{
+            {kSessionId, kReservedBytes, kUsedBytes}}));
+}
+
 void PlaybackServiceTests::createPlaybackServiceShouldSuccess()
 {
     EXPECT_CALL(*m_mediaPipelineCapabilitiesFactoryMock, createMediaPipelineCapabilities())
@@ -42,6 +42,7 @@ public:
 
     void sharedMemoryBufferWillBeInitialized();
     void sharedMemoryBufferWillReturnFdAndSize();
+    void sharedMemoryBufferWillReturnPartitionUsage();
 
     void triggerSwitchToActive();
     void triggerSwitchToInactive();
@@ -41,6 +41,10 @@ public:
     MOCK_METHOD(std::optional<unsigned int>, getNumOfPreloadedServers, (), (override));
     MOCK_METHOD(std::optional<rialto::servermanager::service::LoggingLevels>, getLoggingLevels, (), (override));
     MOCK_METHOD(std::optional<unsigned int>, getNumOfPingsBeforeRecovery, (), (override));
+    MOCK_METHOD(std::optional<firebolt::rialto::common::SharedMemoryPages>, getSharedMemoryPages, (), (override));
+    MOCK_METHOD(std::optional<firebolt::rialto::common::SharedMemoryPrefault>, getSharedMemoryPrefault, (), (override));
+    MOCK_METHOD(std::optional<bool>, getSharedMemoryZeroCopy, (), (override));
+    MOCK_METHOD(std::optional<unsigned int>, getNumOfNeedDataSlots, (), (override));
 };
 } // namespace rialto::servermanager::service
 
@@ -23,6 +23,8 @@
 #include <gtest/gtest.h>
 
 using firebolt::rialto::common::ServerManagerConfig;
+using firebolt::rialto::common::SharedMemoryPages;
+using firebolt::rialto::common::SharedMemoryPrefault;
 using firebolt::rialto::common::SocketPermissions;
 using rialto::servermanager::service::ConfigHelper;
 using rialto::servermanager::service::ConfigReaderFactoryMock;
@@ -199,6 +201,10 @@ public:
         EXPECT_CALL(*m_configReaderMock, getNumOfPreloadedServers()).WillOnce(Return(std::nullopt));
         EXPECT_CALL(*m_configReaderMock, getLoggingLevels()).WillOnce(Return(std::nullopt));
         EXPECT_CALL(*m_configReaderMock, getNumOfPingsBeforeRecovery()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getSharedMemoryPages()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getSharedMemoryPrefault()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getSharedMemoryZeroCopy()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getNumOfNeedDataSlots()).WillOnce(Return(std::nullopt));
     }
 
     void jsonConfigReaderWillReturnNewValues(const std::list<std::string> &envVars,
@@ -218,6 +224,32 @@ public:
         EXPECT_CALL(*m_configReaderMock, getLoggingLevels()).WillRepeatedly(Return(kJsonLoggingLevels));
         EXPECT_CALL(*m_configReaderMock, getNumOfPingsBeforeRecovery())
             .WillRepeatedly(Return(kJsonNumOfFailedPingsBeforeRecovery));
+        EXPECT_CALL(*m_configReaderMock, getSharedMemoryPages()).WillRepeatedly(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getSharedMemoryPrefault()).WillRepeatedly(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getSharedMemoryZeroCopy()).WillRepeatedly(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getNumOfNeedDataSlots()).WillRepeatedly(Return(std::nullopt));
+    }
+
+    void jsonConfigReaderWillReturnSharedMemoryConfig(SharedMemoryPages pages, SharedMemoryPrefault prefault,
+                                                      bool zeroCopy, unsigned numOfNeedDataSlots)
+    {
+        EXPECT_CALL(*m_configReaderFactoryMock, createConfigReader(kRialtoConfigPath)).WillOnce(Return(m_configReaderMock));
+        EXPECT_CALL(*m_configReaderMock, read()).WillOnce(Return(true));
+        EXPECT_CALL(*m_configReaderMock, getEnvironmentVariables()).WillOnce(Return(kEmptyEnvVars));
+        EXPECT_CALL(*m_configReaderMock, getExtraEnvVariables()).WillOnce(Return(kEmptyEnvVars));
+        EXPECT_CALL(*m_configReaderMock, getSessionServerPath()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getSessionServerStartupTimeout()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getHealthcheckInterval()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getSocketPermissions()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getSocketOwner()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getSocketGroup()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getNumOfPreloadedServers()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getLoggingLevels()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getNumOfPingsBeforeRecovery()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configReaderMock, getSharedMemoryPages()).WillRepeatedly(Return(pages));
+        EXPECT_CALL(*m_configReaderMock, getSharedMemoryPrefault()).WillRepeatedly(Return(prefault));
+        EXPECT_CALL(*m_configReaderMock, getSharedMemoryZeroCopy()).WillRepeatedly(Return(zeroCopy));
+        EXPECT_CALL(*m_configReaderMock, getNumOfNeedDataSlots()).WillRepeatedly(Return(numOfNeedDataSlots));
     }
 
     void jsonConfigOverridesReaderWillFailToReadFile()
@@ -244,6 +276,10 @@ public:
         EXPECT_CALL(*m_configOverridesReaderMock, getNumOfPreloadedServers()).WillOnce(Return(std::nullopt));
         EXPECT_CALL(*m_configOverridesReaderMock, getLoggingLevels()).WillOnce(Return(std::nullopt));
         EXPECT_CALL(*m_configOverridesReaderMock, getNumOfPingsBeforeRecovery()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configOverridesReaderMock, getSharedMemoryPages()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configOverridesReaderMock, getSharedMemoryPrefault()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configOverridesReaderMock, getSharedMemoryZeroCopy()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configOverridesReaderMock, getNumOfNeedDataSlots()).WillOnce(Return(std::nullopt));
     }
 
     void jsonConfigOverridesReaderWillReturnNewValues(const std::list<std::string> &envVars,
@@ -271,6 +307,10 @@ public:
         EXPECT_CALL(*m_configOverridesReaderMock, getLoggingLevels()).WillRepeatedly(Return(kJsonOverrideLoggingLevels));
         EXPECT_CALL(*m_configOverridesReaderMock, getNumOfPingsBeforeRecovery())
             .WillRepeatedly(Return(kJsonOverrideNumOfFailedPingsBeforeRecovery));
+        EXPECT_CALL(*m_configOverridesReaderMock, getSharedMemoryPages()).WillRepeatedly(Return(std::nullopt));
+        EXPECT_CALL(*m_configOverridesReaderMock, getSharedMemoryPrefault()).WillRepeatedly(Return(std::nullopt));
+        EXPECT_CALL(*m_configOverridesReaderMock, getSharedMemoryZeroCopy()).WillRepeatedly(Return(std::nullopt));
+        EXPECT_CALL(*m_configOverridesReaderMock, getNumOfNeedDataSlots()).WillRepeatedly(Return(std::nullopt));
     }
 
     void jsonConfigSocReaderWillFailToReadFile()
@@ -297,6 +337,10 @@ public:
         EXPECT_CALL(*m_configSocReaderMock, getNumOfPreloadedServers()).WillOnce(Return(std::nullopt));
         EXPECT_CALL(*m_configSocReaderMock, getLoggingLevels()).WillOnce(Return(std::nullopt));
         EXPECT_CALL(*m_configSocReaderMock, getNumOfPingsBeforeRecovery()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configSocReaderMock, getSharedMemoryPages()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configSocReaderMock, getSharedMemoryPrefault()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configSocReaderMock, getSharedMemoryZeroCopy()).WillOnce(Return(std::nullopt));
+        EXPECT_CALL(*m_configSocReaderMock, getNumOfNeedDataSlots()).WillOnce(Return(std::nullopt));
     }
 
     void jsonConfigSocReaderWillReturnNewValues(const std::list<std::string> &envVars,
@@ -317,6 +361,10 @@ public:
         EXPECT_CALL(*m_configSocReaderMock, getLoggingLevels()).WillRepeatedly(Return(kJsonSocLoggingLevels));
         EXPECT_CALL(*m_configSocReaderMock, getNumOfPingsBeforeRecovery())
             .WillRepeatedly(Return(kJsonSocNumOfFailedPingsBeforeRecovery));
+        EXPECT_CALL(*m_configSocReaderMock, getSharedMemoryPages()).WillRepeatedly(Return(std::nullopt));
+        EXPECT_CALL(*m_configSocReaderMock, getSharedMemoryPrefault()).WillRepeatedly(Return(std::nullopt));
+        EXPECT_CALL(*m_configSocReaderMock, getSharedMemoryZeroCopy()).WillRepeatedly(Return(std::nullopt));
+        EXPECT_CALL(*m_configSocReaderMock, getNumOfNeedDataSlots()).WillRepeatedly(Return(std::nullopt));
     }
 
     void initSut(std::unique_ptr<StrictMock<ConfigReaderFactoryMock>> &&configReaderFactory)
@@ -449,3 +497,44 @@ TEST_F(ConfigHelperTests, ShouldOverrideOldValues)
     initSut(std::move(m_configReaderFactoryMock));
     shouldReturnJsonOverrideValues(kEnvVarSet4);
 }
+
+TEST_F(ConfigHelperTests, ShouldPassSharedMemoryConfigFromStructToSessionServer)
+{
+    ServerManagerConfig config{kServerManagerConfig};
+    config.sharedMemoryConfig = {SharedMemoryPages::HUGE_PAGES, SharedMemoryPrefault::LOCK, true};
+    m_sut = std::make_unique<ConfigHelper>(nullptr, config);
+
+    const std::list<std::string> kExpectedEnvVars{"RIALTO_SHM_PAGES=huge", "RIALTO_SHM_PREFAULT=lock",
+                                                  "RIALTO_SHM_ZERO_COPY=true", "env1=var1"};
+    EXPECT_EQ(m_sut->getSessionServerEnvVars(), kExpectedEnvVars);
+    EXPECT_EQ(m_sut->getSharedMemoryConfig().pages, SharedMemoryPages::HUGE_PAGES);
+    EXPECT_EQ(m_sut->getSharedMemoryConfig().prefault, SharedMemoryPrefault::LOCK);
+    EXPECT_TRUE(m_sut->getSharedMemoryConfig().zeroCopy);
+}
+
+TEST_F(ConfigHelperTests, ShouldUseSharedMemoryConfigFromJson)
+{
+    jsonConfigReaderWillReturnSharedMemoryConfig(SharedMemoryPages::DEFAULT, SharedMemoryPrefault::POPULATE, true, 2);
+    jsonConfigSocReaderWillFailToReadFile();
+    jsonConfigOverridesReaderWillFailToReadFile();
+    initSut(std::move(m_configReaderFactoryMock));
+
+    const std::list<std::string> kExpectedEnvVars{"RIALTO_NEED_DATA_SLOTS=2", "RIALTO_SHM_PREFAULT=populate",
+                                                  "RIALTO_SHM_ZERO_COPY=true", "env1=var1"};
+    EXPECT_EQ(m_sut->getSessionServerEnvVars(), kExpectedEnvVars);
+    EXPECT_EQ(m_sut->getSharedMemoryConfig().pages, SharedMemoryPages::DEFAULT);
+    EXPECT_EQ(m_sut->getSharedMemoryConfig().prefault, SharedMemoryPrefault::POPULATE);
+    EXPECT_TRUE(m_sut->getSharedMemoryConfig().zeroCopy);
+    EXPECT_EQ(m_sut->getSharedMemoryConfig().numOfNeedDataSlots, 2);
+}
+
+TEST_F(ConfigHelperTests, ShouldNotOverrideSharedMemoryEnvVariable)
+{
+    ServerManagerConfig config{kServerManagerConfig};
+    config.sessionServerEnvVars = {"RIALTO_SHM_PREFAULT=none"};
+    config.sharedMemoryConfig = {SharedMemoryPages::DEFAULT, SharedMemoryPrefault::LOCK};
+    m_sut = std::make_unique<ConfigHelper>(nullptr, config);
+
+    const std::list<std::string> kExpectedEnvVars{"RIALTO_SHM_PREFAULT=none"};
+    EXPECT_EQ(m_sut->getSessionServerEnvVars(), kExpectedEnvVars);
+}
@@ -74,6 +74,25 @@ public:
         EXPECT_CALL(*m_objectJsonValueMock, asUInt()).WillOnce(Return(expectedValue));
     }
 
+    void expectNotBool(const std::string &key)
+    {
+        EXPECT_CALL(*m_rootJsonValueMock, isMember(key)).WillOnce(Return(true));
+        EXPECT_CALL(*m_rootJsonValueMock, isMember(StrNe(key))).WillRepeatedly(Return(false));
+
+        EXPECT_CALL(*m_rootJsonValueMock, at(key)).WillRepeatedly(Return(m_objectJsonValueMock));
+        EXPECT_CALL(*m_objectJsonValueMock, isBool()).WillOnce(Return(false));
+    }
+
+    void expectReturnBool(const std::string &key, const bool expectedValue)
+    {
+        EXPECT_CALL(*m_rootJsonValueMock, isMember(key)).WillOnce(Return(true));
+        EXPECT_CALL(*m_rootJsonValueMock, isMember(StrNe(key))).WillRepeatedly(Return(false));
+
+        EXPECT_CALL(*m_rootJsonValueMock, at(key)).WillRepeatedly(Return(m_objectJsonValueMock));
+        EXPECT_CALL(*m_objectJsonValueMock, isBool()).WillOnce(Return(true));
+        EXPECT_CALL(*m_objectJsonValueMock, asBool()).WillOnce(Return(expectedValue));
+    }
+
     void expectNotString(const std::string &key)
     {
         EXPECT_CALL(*m_rootJsonValueMock, isMember(key)).WillOnce(Return(true));
@@ -389,6 +408,87 @@ TEST_F(ConfigReaderTests, numOfPingsBeforeRecoveryExists)
     EXPECT_EQ(m_sut->getNumOfPingsBeforeRecovery(), 3);
 }
 
+TEST_F(ConfigReaderTests, sharedMemoryPagesNotString)
+{
+    expectSuccessfulParsing();
+    expectNotString("sharedMemoryPages");
+
+    EXPECT_TRUE(m_sut->read());
+    EXPECT_EQ(m_sut->getSharedMemoryPages().has_value(), false);
+}
+
+TEST_F(ConfigReaderTests, sharedMemoryPagesUnknown)
+{
+    expectSuccessfulParsing();
+    expectReturnString("sharedMemoryPages", "giant");
+
+    EXPECT_TRUE(m_sut->read());
+    EXPECT_EQ(m_sut->getSharedMemoryPages().has_value(), false);
+}
+
+TEST_F(ConfigReaderTests, sharedMemoryPagesExists)
+{
+    expectSuccessfulParsing();
+    expectReturnString("sharedMemoryPages", "huge");
+
+    EXPECT_TRUE(m_sut->read());
+    EXPECT_EQ(m_sut->getSharedMemoryPages(), firebolt::rialto::common::SharedMemoryPages::HUGE_PAGES);
+}
+
+TEST_F(ConfigReaderTests, sharedMemoryPrefaultNotString)
+{
+    expectSuccessfulParsing();
+    expectNotString("sharedMemoryPrefault");
+
+    EXPECT_TRUE(m_sut->read());
+    EXPECT_EQ(m_sut->getSharedMemoryPrefault().has_value(), false);
+}
+
+TEST_F(ConfigReaderTests, sharedMemoryPrefaultExists)
+{
+    expectSuccessfulParsing();
+    expectReturnString("sharedMemoryPrefault", "lock");
+
+    EXPECT_TRUE(m_sut->read());
+    EXPECT_EQ(m_sut->getSharedMemoryPrefault(), firebolt::rialto::common::SharedMemoryPrefault::LOCK);
+}
+
+TEST_F(ConfigReaderTests, sharedMemoryZeroCopyNotBool)
+{
+    expectSuccessfulParsing();
+    expectNotBool("sharedMemoryZeroCopy");
+
+    EXPECT_TRUE(m_sut->read());
+    EXPECT_EQ(m_sut->getSharedMemoryZeroCopy().has_value(), false);
+}
+
+TEST_F(ConfigReaderTests, sharedMemoryZeroCopyExists)
+{
+    expectSuccessfulParsing();
+    expectReturnBool("sharedMemoryZeroCopy", true);
+
+    EXPECT_TRUE(m_sut->read());
+    EXPECT_EQ(m_sut->getSharedMemoryZeroCopy(), true);
+}
+
+TEST_F(ConfigReaderTests, numOfNeedDataSlotsNotUint)
+{
+    expectSuccessfulParsing();
+    expectNotUint("numOfNeedDataSlots");
+
+    EXPECT_TRUE(m_sut->read());
+    EXPECT_EQ(m_sut->getNumOfNeedDataSlots().has_value(), false);
+}
+
+TEST_F(ConfigReaderTests, numOfNeedDataSlotsExists)
+{
+    expectSuccessfulParsing();
+    expectReturnUint("numOfNeedDataSlots", 2);
+
+    EXPECT_TRUE(m_sut->read());
+    EXPECT_EQ(m_sut->getNumOfNeedDataSlots(), 2);
+}
+
 TEST_F(ConfigReaderTests, defaultConfigValuesAreSet)
 {
     // "Real world" constants defined in rialto/CMakeLists.txt
@@ -418,6 +518,10 @@ TEST_F(ConfigReaderTests, defaultConfigValuesAreSet)
     EXPECT_EQ(config.sessionManagementSocketPermissions.groupPermissions, kDefaultPermissions);
     EXPECT_EQ(config.sessionManagementSocketPermissions.otherPermissions, kDefaultPermissions);
     EXPECT_EQ(config.numOfFailedPingsBeforeRecovery, kNumOfFailedPingsBeforeRecovery);
+    EXPECT_EQ(config.sharedMemoryConfig.pages, firebolt::rialto::common::SharedMemoryPages::DEFAULT);
+    EXPECT_EQ(config.sharedMemoryConfig.prefault, firebolt::rialto::common::SharedMemoryPrefault::NONE);
+    EXPECT_FALSE(config.sharedMemoryConfig.zeroCopy);
+    EXPECT_EQ(config.sharedMemoryConfig.numOfNeedDataSlots, 1);
 }
 
 TEST_F(ConfigReaderTests, extraEnvVariablesNotArray)
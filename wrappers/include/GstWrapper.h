@@ -349,6 +349,12 @@ public:
         return gst_buffer_new_wrapped(data, size);
     }
 
+    GstBuffer *gstBufferNewWrappedFull(GstMemoryFlags flags, gpointer data, gsize maxsize, gsize offset, gsize size,
+                                       gpointer userData, GDestroyNotify notify) const override
+    {
+        return gst_buffer_new_wrapped_full(flags, data, maxsize, offset, size, userData, notify);
+    }
+
     GstCaps *gstCodecUtilsOpusCreateCapsFromHeader(gconstpointer data, guint size) const override
     {
 #if (GLIB_CHECK_VERSION(2, 67, 3))
@@ -861,6 +861,23 @@ public:
      */
     virtual GstBuffer *gstBufferNewWrapped(gpointer data, gsize size) const = 0;
 
+    /**
+     * @brief Creates a new buffer that wraps the given memory. The memory is not copied and notify is called with
+     *        userData when the buffer memory is no longer used.
+     *
+     * @param[in] flags     : the GstMemoryFlags of the wrapped memory
+     * @param[in] data      : data to wrap
+     * @param[in] maxsize   : allocated size of data
+     * @param[in] offset    : offset in data
+     * @param[in] size      : size of valid data
+     * @param[in] userData  : user data passed to notify
+     * @param[in] notify    : called with userData when the memory is freed
+     *
+     * @retval a new GstBuffer
+     */
+    virtual GstBuffer *gstBufferNewWrappedFull(GstMemoryFlags flags, gpointer data, gsize maxsize, gsize offset,
+                                               gsize size, gpointer userData, GDestroyNotify notify) const = 0;
+
     /**
      * @brief Creates Opus caps from the given Opus header.
      *